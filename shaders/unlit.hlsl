@@ -41,6 +41,46 @@ cbuffer ObjectConstants : register(b1)
     float4x4 normalMatrix;      // World matrix for normals (inverse transpose)
 };
 
+// Per-instance data for instanced draws (matches engine::InstanceData)
+struct InstanceData
+{
+    float4x4 worldMatrix;
+    float4x4 normalMatrix;
+};
+StructuredBuffer<InstanceData> instanceData : register(t0, space1);
+
+// First instance of the current batch; SV_InstanceID does not include StartInstanceLocation
+cbuffer InstanceConstants : register(b3)
+{
+    uint instanceOffset;
+};
+
+// Decode parameters for primitives stored in a non-standard vertex layout (engine::VertexFormatConstants)
+cbuffer VertexFormatConstants : register(b4)
+{
+    float3 positionOffset;      // Packed positions: offset + snorm * scale
+    uint vertexLayout;          // assets::VertexLayout::getKey()
+    float3 positionScale;
+    uint vertexFormatPadding;
+};
+
+// Vertex layout bits (must match assets::VertexAttribute and kPackedVertexLayoutBit in C++)
+#define VERTEX_LAYOUT_NORMAL    (1u << 1)
+#define VERTEX_LAYOUT_TEXCOORD  (1u << 2)
+#define VERTEX_LAYOUT_TANGENT   (1u << 3)
+#define VERTEX_LAYOUT_COLOR     (1u << 4)
+#define VERTEX_LAYOUT_PACKED    (1u << 8)
+
+// Vertex input for the layout entry points; every attribute widens to float4, absent ones are ignored
+struct LayoutVertexInput
+{
+    float4 position : POSITION;
+    float4 normal : NORMAL;
+    float4 texcoord : TEXCOORD0;
+    float4 tangent : TANGENT;
+    float4 color : COLOR0;
+};
+
 // Material constants (PBR material properties)
 cbuffer MaterialConstants : register(b2)
 {
@@ -71,20 +111,20 @@ cbuffer MaterialConstants : register(b2)
 #define TEXTURE_FLAG_NORMAL            (1u << 2)
 #define TEXTURE_FLAG_EMISSIVE          (1u << 3)
 
-// Vertex Shader
-VertexOutput VSMain(VertexInput input)
+// Shared vertex transform for the per-object and instanced entry points
+VertexOutput transformVertex(VertexInput input, float4x4 world, float4x4 normalWorld)
 {
     VertexOutput output;
     
     // Transform vertex position to world space
-    float4 worldPos = mul(worldMatrix, float4(input.position, 1.0));
+    float4 worldPos = mul(world, float4(input.position, 1.0));
     output.worldPos = worldPos.xyz;
     
     // Transform to clip space
     output.position = mul(viewProjMatrix, worldPos);
     
     // Transform normal to world space (using normal matrix for non-uniform scaling)
-    output.normal = normalize(mul((float3x3)normalMatrix, input.normal));
+    output.normal = normalize(mul((float3x3)normalWorld, input.normal));
     
     // Pass through texture coordinates
     output.texcoord = input.texcoord;
@@ -98,6 +138,72 @@ VertexOutput VSMain(VertexInput input)
     return output;
 }
 
+// Octahedral unit vector from two snorm components (assets::decodeOctahedral)
+float3 octDecode(float2 encoded)
+{
+    float3 direction = float3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    const float fold = saturate(-direction.z);
+    direction.xy += (direction.xy >= 0.0) ? -fold : fold;
+    return normalize(direction);
+}
+
+// Expand a vertex in any layout to the standard input; absent attributes take the assets::Vertex defaults
+VertexInput decodeLayoutVertex(LayoutVertexInput input)
+{
+    const bool packed = (vertexLayout & VERTEX_LAYOUT_PACKED) != 0;
+
+    VertexInput output;
+    output.position = packed ? positionOffset + input.position.xyz * positionScale : input.position.xyz;
+    output.normal = float3(0.0, 1.0, 0.0);
+    output.texcoord = float2(0.0, 0.0);
+    output.tangent = float4(1.0, 0.0, 0.0, 1.0);
+    output.color = float4(1.0, 1.0, 1.0, 1.0);
+
+    if (vertexLayout & VERTEX_LAYOUT_NORMAL)
+    {
+        output.normal = packed ? octDecode(input.normal.xy) : input.normal.xyz;
+    }
+    if (vertexLayout & VERTEX_LAYOUT_TEXCOORD)
+    {
+        output.texcoord = input.texcoord.xy;
+    }
+    if (vertexLayout & VERTEX_LAYOUT_TANGENT)
+    {
+        // Packed tangents keep their handedness in the position's w
+        output.tangent = packed ? float4(octDecode(input.tangent.xy), input.position.w < 0.0 ? -1.0 : 1.0) : input.tangent;
+    }
+    if (vertexLayout & VERTEX_LAYOUT_COLOR)
+    {
+        output.color = input.color;
+    }
+    return output;
+}
+
+// Vertex Shader
+VertexOutput VSMain(VertexInput input)
+{
+    return transformVertex(input, worldMatrix, normalMatrix);
+}
+
+// Instanced Vertex Shader - world matrices come from the per-frame instance buffer
+VertexOutput VSMainInstanced(VertexInput input, uint instanceId : SV_InstanceID)
+{
+    const InstanceData instance = instanceData[instanceOffset + instanceId];
+    return transformVertex(input, instance.worldMatrix, instance.normalMatrix);
+}
+
+// Vertex Shaders for primitives stored in a trimmed or packed vertex layout
+VertexOutput VSMainLayout(LayoutVertexInput input)
+{
+    return transformVertex(decodeLayoutVertex(input), worldMatrix, normalMatrix);
+}
+
+VertexOutput VSMainLayoutInstanced(LayoutVertexInput input, uint instanceId : SV_InstanceID)
+{
+    const InstanceData instance = instanceData[instanceOffset + instanceId];
+    return transformVertex(decodeLayoutVertex(input), instance.worldMatrix, instance.normalMatrix);
+}
+
 // Pixel Shader
 float4 PSMain(VertexOutput input) : SV_TARGET
 {
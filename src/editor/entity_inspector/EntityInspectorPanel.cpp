@@ -406,6 +406,10 @@ void EntityInspectorPanel::renderMeshRendererComponent( ecs::Entity entity )
 		ImGui::SameLine();
 		ImGui::TextDisabled( "%.2f", meshRenderer->lodBias );
 
+		ImGui::Text( "Occluder" );
+		ImGui::SameLine();
+		ImGui::TextDisabled( "%s", meshRenderer->occluder ? "Yes" : "Auto" );
+
 		// Future: Asset selector button will be added here
 		ImGui::Separator();
 		ImGui::TextDisabled( "(Asset selector coming soon)" );
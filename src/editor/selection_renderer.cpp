@@ -306,7 +306,7 @@ void SelectionRenderer::renderEntityOutline( ecs::Entity entity,
 
 			// Draw the primitive geometry
 			const uint32_t indexCount = primitive.getIndexCount();
-			commandList->DrawIndexedInstanced( indexCount, 1, 0, 0, 0 );
+			commandList->DrawIndexedInstanced( indexCount, 1, primitive.getStartIndex(), primitive.getBaseVertex(), 0 );
 		}
 	}
 }
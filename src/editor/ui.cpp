@@ -134,6 +134,10 @@ struct UI::Impl
 	std::string lastError;
 	bool m_sceneModified = false;
 
+	// Input-to-present latency reported by the main loop
+	float inputLatencyMs = 0.0f;
+	float inputLatencyP95Ms = 0.0f;
+
 	// Toast notification system (T8.7)
 	struct Toast
 	{
@@ -732,6 +736,14 @@ void UI::Impl::setupDockspace( ViewportLayout &layout, UI &ui )
 
 			ImGui::Separator();
 
+			// Scene views recorded on the render thread, or serially with occlusion culling and instancing
+			if ( ImGui::MenuItem( "Render Thread", nullptr, viewportManager.isRenderThreadEnabled() ) )
+			{
+				viewportManager.setRenderThreadEnabled( !viewportManager.isRenderThreadEnabled() );
+			}
+
+			ImGui::Separator();
+
 			// Fullscreen toggle
 			if ( ImGui::MenuItem( "Fullscreen", "Alt+Enter", ui.m_impl->window->isFullscreen() ) )
 			{
@@ -1515,6 +1527,13 @@ void UI::Impl::renderStatusBar( UI &ui )
 		ImGui::SeparatorEx( ImGuiSeparatorFlags_Vertical );
 		ImGui::SameLine();
 
+		// Input-to-present latency
+		ImGui::Text( "Latency: %.1f ms (p95 %.1f ms)", inputLatencyMs, inputLatencyP95Ms );
+
+		ImGui::SameLine();
+		ImGui::SeparatorEx( ImGuiSeparatorFlags_Vertical );
+		ImGui::SameLine();
+
 		// Error status
 		if ( !lastError.empty() )
 		{
@@ -1949,6 +1968,12 @@ void UI::updateViewports( const float deltaTime )
 	m_impl->viewportManager.update( deltaTime );
 }
 
+void UI::setInputLatency( float averageMs, float p95Ms )
+{
+	m_impl->inputLatencyMs = averageMs;
+	m_impl->inputLatencyP95Ms = p95Ms;
+}
+
 // Scene Operations Implementation
 // Scene Operations Implementation
 void UI::initializeSceneOperations( ecs::Scene &scene,
@@ -160,6 +160,9 @@ public:
 	void processInputEvents( platform::Win32Window &window );
 	void updateViewports( const float deltaTime );
 
+	// Input-to-present latency shown in the status bar
+	void setInputLatency( float averageMs, float p95Ms );
+
 	// Handle raw KeyPress WindowEvent; returns true if event was handled (consumed)
 	bool handleKeyPress( const platform::WindowEvent &windowEvent, ViewportInputEvent &viewportEvent );
 
@@ -4,7 +4,9 @@
 // Implements viewport instances with cameras, render targets, and input handling
 #include <d3d12.h>
 #include <wrl.h>
+#include <algorithm>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <array>
@@ -16,6 +18,8 @@
 #include "platform/dx12/dx12_device.h"
 #include "platform/pix/pix.h"
 #include "engine/grid/grid.h"
+#include "engine/render_backend/d3d12_command_recorder.h"
+#include "engine/renderer/renderer.h"
 #include "runtime/console.h"
 #include "runtime/systems.h"
 #include "runtime/mesh_rendering_system.h"
@@ -204,6 +208,11 @@ void Viewport::bindFrameConstants( ID3D12GraphicsCommandList *commandList ) cons
 	}
 }
 
+D3D12_GPU_VIRTUAL_ADDRESS Viewport::getFrameConstantsAddress() const noexcept
+{
+	return m_frameConstantBuffer ? m_frameConstantBuffer->GetGPUVirtualAddress() : 0;
+}
+
 void Viewport::update( float deltaTime )
 {
 	if ( !m_controller || !m_camera )
@@ -225,57 +234,121 @@ void Viewport::render( dx12::Device *device )
 	if ( !m_camera || !m_renderTarget || !device )
 		return;
 
-	// PIX marker for the entire viewport render
-	ID3D12GraphicsCommandList *commandList = device->getCommandList();
-	pix::ScopedEvent pixViewportRender( commandList, pix::MarkerColor::Cyan, std::format( "Viewport Render {}x{}", m_size.x, m_size.y ) );
+	// Standalone path without scene content: a graph holding only this viewport's passes
+	engine::frame_graph::FrameGraph graph;
+	engine::frame_graph::D3D12FrameGraphBackend backend( *device );
+	backend.setCommandList( device->getCommandList() );
+	addRenderPasses( graph, backend, device, {} );
+	if ( !graph.compile() )
+	{
+		console::error( "Viewport frame graph: {}", graph.getError() );
+		return;
+	}
+	graph.execute( backend );
+}
+
+void Viewport::addRenderPasses( engine::frame_graph::FrameGraph &graph,
+	engine::frame_graph::D3D12FrameGraphBackend &backend,
+	dx12::Device *device,
+	std::function<void()> sceneContent )
+{
+	using engine::frame_graph::ResourceState;
+
+	ID3D12GraphicsCommandList *commandList = device ? device->getCommandList() : nullptr;
+	if ( !m_camera || !m_renderTarget || !m_renderTarget->getResource() || m_renderTarget->getRtvHandle().ptr == 0 || !commandList )
+		return;
+
+	// ImGui samples the target once the graph has run
+	const auto color = backend.importTexture( graph, "Viewport Color", *m_renderTarget, ResourceState::ShaderResource );
+	const auto bindTarget = [this, commandList] {
+		const auto rtvHandle = m_renderTarget->getRtvHandle();
+		commandList->OMSetRenderTargets( 1, &rtvHandle, FALSE, nullptr );
+	};
+	// Meshes and debug lines depth test against the target's depth buffer, which the Clear pass resets
+	const auto bindTargetWithDepth = [this, commandList] {
+		const auto rtvHandle = m_renderTarget->getRtvHandle();
+		const auto dsvHandle = m_renderTarget->getDsvHandle();
+		commandList->OMSetRenderTargets( 1, &rtvHandle, FALSE, dsvHandle.ptr != 0 ? &dsvHandle : nullptr );
+
+		// Whatever ran last may have left the backbuffer's viewport set
+		const D3D12_VIEWPORT viewport = { 0.0f, 0.0f, static_cast<float>( m_size.x ), static_cast<float>( m_size.y ), 0.0f, 1.0f };
+		const D3D12_RECT scissorRect = { 0, 0, static_cast<LONG>( m_size.x ), static_cast<LONG>( m_size.y ) };
+		commandList->RSSetViewports( 1, &viewport );
+		commandList->RSSetScissorRects( 1, &scissorRect );
+	};
 
 	// Clear the render target with a nice dark gray color
-	const float clearColor[4] = { 0.1f, 0.1f, 0.1f, 1.0f };
-	{
-		pix::ScopedEvent pixClear( commandList, pix::MarkerColor::Red, "Clear Render Target" );
-		if ( !clearRenderTarget( device, clearColor ) )
+	const auto clear = graph.addPass( "Clear", [this, device, commandList] {
+		pix::ScopedEvent pixClear( commandList, pix::MarkerColor::Red, std::format( "Clear Render Target {}x{}", m_size.x, m_size.y ) );
+		const float clearColor[4] = { 0.1f, 0.1f, 0.1f, 1.0f };
+		m_targetCleared = clearRenderTarget( device, clearColor );
+		if ( !m_targetCleared )
 		{
 			pix::SetMarker( commandList, pix::MarkerColor::Yellow, "Clear Failed" );
-			return;
 		}
-	}
+	} );
+	graph.write( clear, color, ResourceState::RenderTarget );
 
 	// Render grid if enabled and available
 	if ( m_showGrid && m_gridRenderer )
 	{
-		pix::ScopedEvent pixGrid( commandList, pix::MarkerColor::Green, "Grid Rendering" );
+		const auto grid = graph.addPass( "Grid", [this, commandList, bindTarget] {
+			if ( !m_targetCleared )
+				return;
 
-		// Get camera matrices with proper aspect ratio
-		const auto viewMatrix = m_camera->getViewMatrix();
-		const auto projMatrix = m_camera->getProjectionMatrix( getAspectRatio() );
+			pix::ScopedEvent pixGrid( commandList, pix::MarkerColor::Green, "Grid Rendering" );
+			bindTarget();
 
-		// Render the grid for this viewport
-		const float viewportWidth = static_cast<float>( m_size.x );
-		const float viewportHeight = static_cast<float>( m_size.y );
+			// Get camera matrices with proper aspect ratio
+			const auto viewMatrix = m_camera->getViewMatrix();
+			const auto projMatrix = m_camera->getProjectionMatrix( getAspectRatio() );
 
-		if ( !m_gridRenderer->render( *m_camera, viewMatrix, projMatrix, viewportWidth, viewportHeight ) )
-		{
-			console::warning( "Grid rendering failed for viewport" );
-			pix::SetMarker( commandList, pix::MarkerColor::Yellow, "Grid Render Failed" );
-		}
-	}
-	else
-	{
-		pix::SetMarker( commandList, pix::MarkerColor::Orange, m_showGrid ? "Grid Renderer Missing" : "Grid Disabled" );
+			// Render the grid for this viewport
+			const float viewportWidth = static_cast<float>( m_size.x );
+			const float viewportHeight = static_cast<float>( m_size.y );
+
+			if ( !m_gridRenderer->render( *m_camera, viewMatrix, projMatrix, viewportWidth, viewportHeight ) )
+			{
+				console::warning( "Grid rendering failed for viewport" );
+				pix::SetMarker( commandList, pix::MarkerColor::Yellow, "Grid Render Failed" );
+			}
+		} );
+		graph.write( grid, color, ResourceState::RenderTarget );
 	}
 
 	// Render selection outlines and highlights if available
 	if ( m_selectionRenderer && m_scene )
 	{
-		pix::ScopedEvent pixSelection( commandList, pix::MarkerColor::Purple, "Selection Rendering" );
-
-		// Get camera matrices
-		const auto viewMatrix = m_camera->getViewMatrix();
-		const auto projMatrix = m_camera->getProjectionMatrix( getAspectRatio() );
-		const math::Vec2<> viewportSize{ static_cast<float>( m_size.x ), static_cast<float>( m_size.y ) };
+		const auto selection = graph.addPass( "Selection", [this, commandList, bindTarget] {
+			if ( !m_targetCleared )
+				return;
+
+			pix::ScopedEvent pixSelection( commandList, pix::MarkerColor::Purple, "Selection Rendering" );
+			bindTarget();
+
+			// Get camera matrices
+			const auto viewMatrix = m_camera->getViewMatrix();
+			const auto projMatrix = m_camera->getProjectionMatrix( getAspectRatio() );
+			const math::Vec2<> viewportSize{ static_cast<float>( m_size.x ), static_cast<float>( m_size.y ) };
+
+			// Render selection visual feedback
+			m_selectionRenderer->render( *m_scene, commandList, viewMatrix, projMatrix, viewportSize );
+		} );
+		graph.write( selection, color, ResourceState::RenderTarget );
+	}
 
-		// Render selection visual feedback
-		m_selectionRenderer->render( *m_scene, commandList, viewMatrix, projMatrix, viewportSize );
+	// Scene content (meshes) on top
+	if ( sceneContent )
+	{
+		const auto scene = graph.addPass( "Scene", [this, commandList, bindTargetWithDepth, sceneContent = std::move( sceneContent )] {
+			if ( !m_targetCleared )
+				return;
+
+			pix::ScopedEvent pixSceneContent( commandList, pix::MarkerColor::Orange, "Scene Content Rendering" );
+			bindTargetWithDepth();
+			sceneContent();
+		} );
+		graph.write( scene, color, ResourceState::RenderTarget );
 	}
 }
 
@@ -813,13 +886,30 @@ bool ViewportManager::initialize( dx12::Device *device, std::shared_ptr<shader_m
 
 	m_device = device;
 	m_shaderManager = shaderManager;
+
+	m_renderThread = std::make_unique<engine::render_thread::RenderThread>( m_snapshots, [this]( const engine::render_thread::RenderSnapshot &snapshot ) {
+		for ( std::size_t i = 0; i < snapshot.views.size(); ++i )
+		{
+			m_viewStreams.record( m_snapshotRenderer, snapshot, i );
+		}
+	} );
+	m_renderThread->start();
 	return true;
 }
 
 void ViewportManager::shutdown()
 {
+	// Let the render thread finish what was published before the viewports it refers to go away
+	if ( m_renderThread )
+	{
+		m_renderThread->stop();
+		m_viewStreams.close();
+	}
+
 	// Destroy all viewports first (this will trigger proper cleanup)
 	destroyAllViewports();
+	m_frameGraph.reset();
+	m_frameGraphBackend.reset();
 	m_device = nullptr;
 	m_shaderManager.reset(); // Properly release the shared_ptr
 }
@@ -988,27 +1078,77 @@ void ViewportManager::render()
 		}
 	}
 
-	// Render all active viewports
+	// Instance buffer space and draw statistics are shared by all viewports rendered this frame, and so is
+	// the scene extract: world matrices, visibility and draw state are gathered once, not once per viewport
+	auto *meshRenderingSystem = m_systemManager ? m_systemManager->getSystem<systems::MeshRenderingSystem>() : nullptr;
+	if ( meshRenderingSystem )
+	{
+		meshRenderingSystem->beginFrame();
+		if ( m_scene )
+		{
+			pix::ScopedEvent pixExtract( commandList, pix::MarkerColor::Green, "Scene Extract" );
+			meshRenderingSystem->extractScene( *m_scene );
+		}
+	}
+
+	// With the render thread, views are culled, queued and recorded there while this thread records the
+	// viewports' other passes; each scene pass then replays its view
+	m_snapshotViewports.clear();
+	if ( m_renderThread && m_renderThreadEnabled && m_scene && meshRenderingSystem )
+	{
+		pix::ScopedEvent pixSnapshot( commandList, pix::MarkerColor::Green, "Publish Render Snapshot" );
+		publishSnapshot( *meshRenderingSystem );
+	}
+
+	// Every active viewport declares its passes on one frame graph, which orders them, computes the
+	// render target transitions (ImGui samples the targets afterwards) and places any transients
+	if ( !m_frameGraphBackend )
+	{
+		m_frameGraphBackend = std::make_unique<engine::frame_graph::D3D12FrameGraphBackend>( *m_device );
+	}
+	m_frameGraph.reset();
+	m_frameGraphBackend->clearImports();
+	m_frameGraphBackend->setCommandList( commandList );
+
 	int activeViewports = 0;
 	for ( auto &viewport : m_viewports )
 	{
 		if ( viewport->isActive() )
 		{
 			activeViewports++;
-			const char *viewportName = ViewportUtils::getViewportTypeName( viewport->getType() );
-			pix::ScopedEvent pixIndividualViewport( commandList, pix::MarkerColor::LightBlue, std::format( "Viewport {} Render", viewportName ) );
-
-			// Render the viewport (clears render target and renders grid)
-			viewport->render( m_device );
 
 			// Render 3D scene content if we have scene and systems
-			if ( m_scene && m_systemManager && viewport->getCamera() )
+			std::function<void()> sceneContent;
+			const auto snapshotView = std::ranges::find( m_snapshotViewports, viewport.get() );
+			if ( snapshotView != m_snapshotViewports.end() )
 			{
-				// Get the MeshRenderingSystem and call its render method
-				if ( auto *meshRenderingSystem = m_systemManager->getSystem<systems::MeshRenderingSystem>() )
-				{
-					pix::ScopedEvent pixSceneContent( commandList, pix::MarkerColor::Orange, "Scene Content Rendering" );
+				const auto viewIndex = static_cast<std::size_t>( snapshotView - m_snapshotViewports.begin() );
+				sceneContent = [this, commandList, meshRenderingSystem, viewIndex] {
+					{
+						pix::ScopedEvent pixRootSig( commandList, pix::MarkerColor::Red, "Root Signature Setup" );
+						meshRenderingSystem->setRootSignature( commandList );
+					}
+
+					const engine::render_thread::ViewCommandStream *stream = nullptr;
+					{
+						pix::ScopedEvent pixWait( commandList, pix::MarkerColor::Yellow, "Wait For Render Thread" );
+						stream = m_viewStreams.wait( viewIndex );
+					}
+					if ( !stream )
+					{
+						return;
+					}
 
+					// Frame constants were written when the snapshot was published and are bound by the stream
+					pix::ScopedEvent pixReplay( commandList, pix::MarkerColor::Blue, std::format( "Replay {} Draws", stream->stats.drawCalls ) );
+					engine::render_backend::D3D12CommandRecorder recorder( commandList );
+					stream->commands.replay( recorder );
+					meshRenderingSystem->requestResidency( stream->visibleObjects );
+				};
+			}
+			else if ( m_scene && meshRenderingSystem && viewport->getCamera() )
+			{
+				sceneContent = [commandList, meshRenderingSystem, target = viewport.get()] {
 					// Set root signature FIRST before binding any parameters
 					{
 						pix::ScopedEvent pixRootSig( commandList, pix::MarkerColor::Red, "Root Signature Setup" );
@@ -1018,19 +1158,93 @@ void ViewportManager::render()
 					// Update and bind frame constants for this viewport
 					{
 						pix::ScopedEvent pixFrameConstants( commandList, pix::MarkerColor::Blue, "Frame Constants" );
-						viewport->updateFrameConstants();
-						viewport->bindFrameConstants( commandList );
+						target->updateFrameConstants();
+						target->bindFrameConstants( commandList );
 					}
 
-					meshRenderingSystem->render( *m_scene, *viewport->getCamera() );
-				}
+					meshRenderingSystem->renderView( *target->getCamera(), target->getAspectRatio() );
+				};
+			}
+
+			// Debug lines go into this view's target with its own view-projection, after its meshes
+			if ( sceneContent && m_debugRenderer )
+			{
+				sceneContent = [commandList, debugRenderer = m_debugRenderer, target = viewport.get(), content = std::move( sceneContent )] {
+					content();
+					pix::ScopedEvent pixDebugDraw( commandList, pix::MarkerColor::Cyan, "Debug Draw" );
+					const auto &camera = *target->getCamera();
+					debugRenderer->drawDebugView( camera.getProjectionMatrix( target->getAspectRatio() ) * camera.getViewMatrix() );
+				};
 			}
+
+			viewport->addRenderPasses( m_frameGraph, *m_frameGraphBackend, m_device, std::move( sceneContent ) );
 		}
 	}
 
+	{
+		pix::ScopedEvent pixFrameGraph( commandList, pix::MarkerColor::LightBlue, "Viewport Frame Graph" );
+		if ( !m_frameGraph.compile() )
+		{
+			console::error( "Viewport frame graph: {}", m_frameGraph.getError() );
+		}
+		else if ( !m_frameGraph.execute( *m_frameGraphBackend ) )
+		{
+			console::error( "Viewport frame graph: failed to allocate {} bytes of transients", m_frameGraph.getStats().heapBytes );
+		}
+	}
+
+	// Scene passes that did not run (failed clear or graph) never waited for their view. The snapshot points
+	// at LOD tables and PSOs that hot reload and residency eviction may change before the next frame.
+	if ( !m_snapshotViewports.empty() )
+	{
+		pix::ScopedEvent pixWait( commandList, pix::MarkerColor::Yellow, "Wait For Render Thread" );
+		m_viewStreams.waitAll();
+	}
+
 	pix::SetMarker( commandList, pix::MarkerColor::White, std::format( "ViewportManager Complete - {} active viewports", activeViewports ) );
 }
 
+void ViewportManager::publishSnapshot( systems::MeshRenderingSystem &meshRenderingSystem )
+{
+	for ( auto &viewport : m_viewports )
+	{
+		if ( viewport->isActive() && viewport->getCamera() )
+		{
+			m_snapshotViewports.push_back( viewport.get() );
+		}
+	}
+
+	// Waits for the render thread to be done with last frame's streams, so the extract may be copied
+	auto *snapshot = m_viewStreams.begin( m_snapshotViewports.size() ) ? m_snapshots.beginWrite() : nullptr;
+	if ( !snapshot )
+	{
+		m_snapshotViewports.clear();
+		return;
+	}
+
+	snapshot->reset();
+	snapshot->frameIndex = ++m_frameIndex;
+	snapshot->scene = meshRenderingSystem.getSceneExtract();
+	for ( std::size_t i = 0; i < m_snapshotViewports.size(); ++i )
+	{
+		Viewport &viewport = *m_snapshotViewports[i];
+		const auto &camera = *viewport.getCamera();
+		const math::Mat4f projection = camera.getProjectionMatrix( viewport.getAspectRatio() );
+
+		// Written now so the GPU sees the camera the render thread culls against
+		viewport.updateFrameConstants();
+
+		engine::render_thread::SnapshotView view;
+		view.viewId = static_cast<std::uint32_t>( i );
+		view.viewProjection = projection * camera.getViewMatrix();
+		view.lod = { meshRenderingSystem.isLodEnabled() ? projection.row1.y : 0.0f, meshRenderingSystem.getLodScreenErrorThreshold() };
+		view.frameConstants = viewport.getFrameConstantsAddress();
+		view.frustumCulling = meshRenderingSystem.isFrustumCullingEnabled();
+		snapshot->views.push_back( view );
+	}
+	m_snapshots.publish();
+}
+
 void ViewportManager::handleGlobalInput( const ViewportInputEvent &event )
 {
 	// Route input to focused viewport
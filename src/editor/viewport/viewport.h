@@ -4,11 +4,18 @@
 // Manages individual viewport instances with cameras, render targets, and input handling
 #include <d3d12.h>
 #include <wrl.h>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <array>
 #include "engine/camera/camera_controller.h"
+#include "engine/frame_graph/d3d12_frame_graph_backend.h"
+#include "engine/frame_graph/frame_graph.h"
 #include "engine/grid/grid.h"
+#include "engine/render_thread/render_snapshot.h"
+#include "engine/render_thread/render_thread.h"
+#include "engine/render_thread/snapshot_queue.h"
+#include "engine/render_thread/view_command_streams.h"
 #include "math/vec.h"
 #include "math/matrix.h"
 
@@ -25,11 +32,16 @@ class Scene;
 namespace systems
 {
 class SystemManager;
+class MeshRenderingSystem;
 }
 namespace picking
 {
 class PickingSystem;
 }
+namespace renderer
+{
+class Renderer;
+}
 namespace editor
 {
 class SelectionManager;
@@ -140,11 +152,19 @@ public:
 	bool createFrameConstantBuffer( dx12::Device *device );
 	void updateFrameConstants();
 	void bindFrameConstants( ID3D12GraphicsCommandList *commandList ) const;
+	D3D12_GPU_VIRTUAL_ADDRESS getFrameConstantsAddress() const noexcept;
 
 	// Frame update and rendering
 	void update( float deltaTime );
 	void render( dx12::Device *device );
 
+	// Declare this viewport's passes on a frame graph: clear, grid, selection feedback and sceneContent
+	// (skipped when empty), all drawing into the viewport's render target, which ImGui samples afterwards
+	void addRenderPasses( engine::frame_graph::FrameGraph &graph,
+		engine::frame_graph::D3D12FrameGraphBackend &backend,
+		dx12::Device *device,
+		std::function<void()> sceneContent );
+
 	// Scene access for object selection
 	void setScene( ecs::Scene *scene ) { m_scene = scene; }
 
@@ -205,6 +225,7 @@ private:
 	bool m_isActive = false;
 	bool m_isFocused = false;
 	bool m_showGrid = true;
+	bool m_targetCleared = false; // Set by this frame's Clear pass; later passes record nothing without it
 	bool m_showGizmos = true;
 	bool m_viewSyncEnabled = false;
 
@@ -274,6 +295,9 @@ public:
 	// Set scene and system manager for 3D content rendering
 	void setSceneAndSystems( ecs::Scene *scene, systems::SystemManager *systemManager, editor::SelectionManager *selectionManager, picking::PickingSystem *pickingSystem, editor::GizmoSystem *gizmoSystem = nullptr );
 
+	// Debug lines batched on renderer are drawn at the end of each viewport's scene pass with its camera
+	void setDebugRenderer( renderer::Renderer *debugRenderer ) noexcept { m_debugRenderer = debugRenderer; }
+
 	// Setup input handlers for all existing viewports (called after setSceneAndSystems)
 	void setupInputHandlersForExistingViewports();
 
@@ -301,6 +325,16 @@ public:
 	// View synchronization across viewports
 	void synchronizeViews( Viewport *sourceViewport );
 
+	// Off by default: viewports render serially on the main thread with occlusion culling and instancing.
+	// When on, scene content is culled, queued and recorded on the render thread from a snapshot of the
+	// frame's extract and replayed by each viewport's scene pass. That path draws per object with frustum
+	// culling only, and the main thread still waits for it within the frame, so it does not yet overlap frames.
+	void setRenderThreadEnabled( bool enabled ) noexcept { m_renderThreadEnabled = enabled; }
+	bool isRenderThreadEnabled() const noexcept { return m_renderThreadEnabled; }
+
+	// Barrier and transient memory statistics of the last frame's viewport graph
+	const engine::frame_graph::FrameGraphStats &getFrameGraphStats() const noexcept { return m_frameGraph.getStats(); }
+
 	// Global viewport operations
 	void frameAllInAllViewports() noexcept;
 	void resetAllViews() noexcept;
@@ -331,6 +365,26 @@ private:
 	// Gizmo system for object manipulation
 	editor::GizmoSystem *m_gizmoSystem = nullptr;
 
+	// Owner of the frame's debug line batch
+	renderer::Renderer *m_debugRenderer = nullptr;
+
+	// All active viewports render through one frame graph per frame
+	engine::frame_graph::FrameGraph m_frameGraph;
+	std::unique_ptr<engine::frame_graph::D3D12FrameGraphBackend> m_frameGraphBackend;
+
+	// Render thread path. The snapshot renderer is only used on the render thread; m_snapshotViewports
+	// lists the viewports of the last published snapshot in view order.
+	bool m_renderThreadEnabled = false;
+	std::uint64_t m_frameIndex = 0;
+	std::vector<Viewport *> m_snapshotViewports;
+	engine::render_thread::SnapshotQueue<engine::render_thread::RenderSnapshot> m_snapshots{ 2 };
+	engine::render_thread::ViewCommandStreams m_viewStreams;
+	engine::render_thread::SnapshotRenderer m_snapshotRenderer;
+	std::unique_ptr<engine::render_thread::RenderThread> m_renderThread;
+
+	// Hand the frame's extract and the active viewports' views to the render thread
+	void publishSnapshot( systems::MeshRenderingSystem &meshRenderingSystem );
+
 	// Find viewport by pointer
 	auto findViewport( Viewport *viewport ) -> decltype( m_viewports.begin() );
 };
@@ -0,0 +1,279 @@
+#include "engine/assets/asset_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace assets
+{
+
+AssetCache::AssetCache( std::size_t budgetBytes )
+	: m_budget( budgetBytes )
+{
+}
+
+AssetCache::Shard &AssetCache::shardFor( const std::string &path )
+{
+	return m_shards[std::hash<std::string>{}( path ) % kShardCount];
+}
+
+const AssetCache::Shard &AssetCache::shardFor( const std::string &path ) const
+{
+	return m_shards[std::hash<std::string>{}( path ) % kShardCount];
+}
+
+std::shared_ptr<Asset> AssetCache::find( const std::string &path )
+{
+	Shard &shard = shardFor( path );
+	std::shared_lock lock( shard.mutex );
+	const auto it = shard.entries.find( path );
+	if ( it == shard.entries.end() )
+	{
+		m_misses.fetch_add( 1, std::memory_order_relaxed );
+		return nullptr;
+	}
+	// Recency is an atomic, so readers only need the shared lock
+	it->second.lastUse.store( tick(), std::memory_order_relaxed );
+	m_hits.fetch_add( 1, std::memory_order_relaxed );
+	return it->second.asset;
+}
+
+bool AssetCache::contains( const std::string &path ) const
+{
+	const Shard &shard = shardFor( path );
+	std::shared_lock lock( shard.mutex );
+	return shard.entries.find( path ) != shard.entries.end();
+}
+
+void AssetCache::insert( const std::string &path, std::shared_ptr<Asset> asset )
+{
+	if ( !asset )
+	{
+		return;
+	}
+	const std::size_t bytes = asset->getMemoryUsage();
+	{
+		Shard &shard = shardFor( path );
+		std::unique_lock lock( shard.mutex );
+		auto [it, inserted] = shard.entries.try_emplace( path );
+		if ( inserted )
+		{
+			m_assetCount.fetch_add( 1, std::memory_order_relaxed );
+		}
+		else
+		{
+			m_residentBytes.fetch_sub( it->second.bytes, std::memory_order_relaxed );
+		}
+		it->second.asset = std::move( asset );
+		it->second.bytes = bytes;
+		it->second.lastUse.store( tick(), std::memory_order_relaxed );
+		addResident( bytes );
+	}
+	trimIfOverBudget();
+}
+
+std::shared_ptr<Asset> AssetCache::insertIfAbsent( const std::string &path, std::shared_ptr<Asset> asset )
+{
+	if ( !asset )
+	{
+		return nullptr;
+	}
+	{
+		Shard &shard = shardFor( path );
+		std::shared_lock lock( shard.mutex );
+		const auto it = shard.entries.find( path );
+		if ( it != shard.entries.end() && it->second.asset->getType() == asset->getType() )
+		{
+			it->second.lastUse.store( tick(), std::memory_order_relaxed );
+			return it->second.asset;
+		}
+	}
+
+	// Measured outside the lock; a racing insert of the same path may still win below
+	const std::size_t bytes = asset->getMemoryUsage();
+	std::shared_ptr<Asset> result;
+	{
+		Shard &shard = shardFor( path );
+		std::unique_lock lock( shard.mutex );
+		auto [it, inserted] = shard.entries.try_emplace( path );
+		if ( !inserted && it->second.asset->getType() == asset->getType() )
+		{
+			it->second.lastUse.store( tick(), std::memory_order_relaxed );
+			return it->second.asset;
+		}
+		if ( inserted )
+		{
+			m_assetCount.fetch_add( 1, std::memory_order_relaxed );
+		}
+		else
+		{
+			m_residentBytes.fetch_sub( it->second.bytes, std::memory_order_relaxed );
+		}
+		it->second.asset = asset;
+		it->second.bytes = bytes;
+		it->second.lastUse.store( tick(), std::memory_order_relaxed );
+		addResident( bytes );
+		result = std::move( asset );
+	}
+	trimIfOverBudget();
+	return result;
+}
+
+bool AssetCache::erase( const std::string &path, bool unreferencedOnly )
+{
+	std::shared_ptr<Asset> released; // Destroyed after the lock is dropped
+	{
+		Shard &shard = shardFor( path );
+		std::unique_lock lock( shard.mutex );
+		const auto it = shard.entries.find( path );
+		if ( it == shard.entries.end() || ( unreferencedOnly && it->second.asset.use_count() != 1 ) )
+		{
+			return false;
+		}
+		m_residentBytes.fetch_sub( it->second.bytes, std::memory_order_relaxed );
+		m_assetCount.fetch_sub( 1, std::memory_order_relaxed );
+		released = std::move( it->second.asset );
+		shard.entries.erase( it );
+	}
+	return true;
+}
+
+void AssetCache::clear()
+{
+	for ( Shard &shard : m_shards )
+	{
+		std::unordered_map<std::string, Entry> released;
+		{
+			std::unique_lock lock( shard.mutex );
+			released.swap( shard.entries );
+		}
+		for ( const auto &[path, entry] : released )
+		{
+			m_residentBytes.fetch_sub( entry.bytes, std::memory_order_relaxed );
+		}
+		m_assetCount.fetch_sub( released.size(), std::memory_order_relaxed );
+	}
+}
+
+void AssetCache::updateSize( const std::string &path )
+{
+	{
+		Shard &shard = shardFor( path );
+		std::unique_lock lock( shard.mutex );
+		const auto it = shard.entries.find( path );
+		if ( it == shard.entries.end() )
+		{
+			return;
+		}
+		m_residentBytes.fetch_sub( it->second.bytes, std::memory_order_relaxed );
+		it->second.bytes = it->second.asset->getMemoryUsage();
+		addResident( it->second.bytes );
+	}
+	trimIfOverBudget();
+}
+
+void AssetCache::setBudget( std::size_t budgetBytes )
+{
+	m_budget.store( budgetBytes, std::memory_order_relaxed );
+	trimIfOverBudget();
+}
+
+std::size_t AssetCache::trim()
+{
+	// One trimmer at a time; others would only race it for the same victims
+	std::lock_guard trimLock( m_trimMutex );
+	if ( m_residentBytes.load( std::memory_order_relaxed ) <= getBudget() )
+	{
+		return 0;
+	}
+
+	struct Candidate
+	{
+		std::uint64_t lastUse;
+		std::size_t shard;
+		std::string path;
+	};
+	std::vector<Candidate> candidates;
+	for ( std::size_t i = 0; i < kShardCount; ++i )
+	{
+		std::shared_lock lock( m_shards[i].mutex );
+		for ( const auto &[path, entry] : m_shards[i].entries )
+		{
+			if ( entry.asset.use_count() == 1 )
+			{
+				candidates.push_back( { entry.lastUse.load( std::memory_order_relaxed ), i, path } );
+			}
+		}
+	}
+	std::sort( candidates.begin(), candidates.end(), []( const Candidate &a, const Candidate &b ) { return a.lastUse < b.lastUse; } );
+
+	std::size_t evicted = 0;
+	for ( const Candidate &candidate : candidates )
+	{
+		if ( m_residentBytes.load( std::memory_order_relaxed ) <= getBudget() )
+		{
+			break;
+		}
+		std::shared_ptr<Asset> released;
+		{
+			Shard &shard = m_shards[candidate.shard];
+			std::unique_lock lock( shard.mutex );
+			const auto it = shard.entries.find( candidate.path );
+			// Skip entries used or referenced since the scan
+			if ( it == shard.entries.end() || it->second.asset.use_count() != 1 ||
+				 it->second.lastUse.load( std::memory_order_relaxed ) != candidate.lastUse )
+			{
+				continue;
+			}
+			m_residentBytes.fetch_sub( it->second.bytes, std::memory_order_relaxed );
+			m_assetCount.fetch_sub( 1, std::memory_order_relaxed );
+			m_evictions.fetch_add( 1, std::memory_order_relaxed );
+			m_evictedBytes.fetch_add( it->second.bytes, std::memory_order_relaxed );
+			released = std::move( it->second.asset );
+			shard.entries.erase( it );
+		}
+		++evicted;
+	}
+	return evicted;
+}
+
+AssetCacheStats AssetCache::getStats() const
+{
+	AssetCacheStats stats;
+	stats.hits = m_hits.load( std::memory_order_relaxed );
+	stats.misses = m_misses.load( std::memory_order_relaxed );
+	stats.evictions = m_evictions.load( std::memory_order_relaxed );
+	stats.evictedBytes = m_evictedBytes.load( std::memory_order_relaxed );
+	stats.residentBytes = m_residentBytes.load( std::memory_order_relaxed );
+	stats.peakResidentBytes = m_peakResidentBytes.load( std::memory_order_relaxed );
+	stats.assetCount = m_assetCount.load( std::memory_order_relaxed );
+	return stats;
+}
+
+void AssetCache::resetStats()
+{
+	m_hits.store( 0, std::memory_order_relaxed );
+	m_misses.store( 0, std::memory_order_relaxed );
+	m_evictions.store( 0, std::memory_order_relaxed );
+	m_evictedBytes.store( 0, std::memory_order_relaxed );
+	m_peakResidentBytes.store( m_residentBytes.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+}
+
+void AssetCache::addResident( std::size_t bytes )
+{
+	const std::size_t resident = m_residentBytes.fetch_add( bytes, std::memory_order_relaxed ) + bytes;
+	std::size_t peak = m_peakResidentBytes.load( std::memory_order_relaxed );
+	while ( resident > peak && !m_peakResidentBytes.compare_exchange_weak( peak, resident, std::memory_order_relaxed ) )
+	{
+	}
+}
+
+void AssetCache::trimIfOverBudget()
+{
+	if ( m_residentBytes.load( std::memory_order_relaxed ) > getBudget() )
+	{
+		trim();
+	}
+}
+
+} // namespace assets
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "engine/assets/assets.h"
+
+namespace assets
+{
+
+// Cumulative AssetCache activity plus its current contents
+struct AssetCacheStats
+{
+	std::uint64_t hits = 0;
+	std::uint64_t misses = 0;
+	std::uint64_t evictions = 0;	 // Assets dropped to stay within the budget
+	std::uint64_t evictedBytes = 0;
+	std::size_t residentBytes = 0;	 // Asset::getMemoryUsage() of everything cached
+	std::size_t peakResidentBytes = 0;
+	std::size_t assetCount = 0;
+};
+
+// Path-keyed asset cache shared by every thread that loads assets. Entries are spread over shards with
+// their own reader-writer lock, so lookups on different paths never contend and lookups on the same path
+// only share a lock. Each entry is charged its Asset::getMemoryUsage(); when the total exceeds the budget
+// the least recently used entries nobody else references are evicted. Referenced assets always stay.
+class AssetCache
+{
+public:
+	static constexpr std::size_t kShardCount = 16;
+	static constexpr std::size_t kUnlimited = std::numeric_limits<std::size_t>::max();
+
+	explicit AssetCache( std::size_t budgetBytes = kUnlimited );
+
+	AssetCache( const AssetCache & ) = delete;
+	AssetCache &operator=( const AssetCache & ) = delete;
+
+	// Cached asset for path, or null; counts a hit or miss and marks the entry as recently used
+	std::shared_ptr<Asset> find( const std::string &path );
+
+	// Presence test that neither counts nor touches the entry
+	bool contains( const std::string &path ) const;
+
+	// Cache asset under path, replacing any entry
+	void insert( const std::string &path, std::shared_ptr<Asset> asset );
+
+	// Cache asset unless path already holds an asset of the same type; returns the cached instance
+	std::shared_ptr<Asset> insertIfAbsent( const std::string &path, std::shared_ptr<Asset> asset );
+
+	// Drop path; with unreferencedOnly, only if the cache holds the last reference
+	bool erase( const std::string &path, bool unreferencedOnly = false );
+	void clear();
+
+	// Charge path its current Asset::getMemoryUsage() after the asset was modified in place
+	void updateSize( const std::string &path );
+
+	void setBudget( std::size_t budgetBytes );
+	std::size_t getBudget() const noexcept { return m_budget.load( std::memory_order_relaxed ); }
+
+	// Evict least recently used unreferenced entries until within budget; returns the number evicted.
+	// Inserts do this automatically; call it after releasing references to reclaim memory sooner.
+	std::size_t trim();
+
+	AssetCacheStats getStats() const;
+	void resetStats();
+
+private:
+	struct Entry
+	{
+		std::shared_ptr<Asset> asset;
+		std::size_t bytes = 0;
+		std::atomic<std::uint64_t> lastUse{ 0 };
+	};
+
+	// Aligned so shards updated by different threads do not share a cache line
+	struct alignas( 64 ) Shard
+	{
+		mutable std::shared_mutex mutex;
+		std::unordered_map<std::string, Entry> entries;
+	};
+
+	std::array<Shard, kShardCount> m_shards;
+	std::atomic<std::size_t> m_budget;
+	std::atomic<std::uint64_t> m_clock{ 0 };
+	std::mutex m_trimMutex;
+
+	std::atomic<std::uint64_t> m_hits{ 0 };
+	std::atomic<std::uint64_t> m_misses{ 0 };
+	std::atomic<std::uint64_t> m_evictions{ 0 };
+	std::atomic<std::uint64_t> m_evictedBytes{ 0 };
+	std::atomic<std::size_t> m_residentBytes{ 0 };
+	std::atomic<std::size_t> m_peakResidentBytes{ 0 };
+	std::atomic<std::size_t> m_assetCount{ 0 };
+
+	Shard &shardFor( const std::string &path );
+	const Shard &shardFor( const std::string &path ) const;
+	std::uint64_t tick() noexcept { return m_clock.fetch_add( 1, std::memory_order_relaxed ) + 1; }
+	// Under the shard lock that charged the bytes, so a racing erase never sees them missing
+	void addResident( std::size_t bytes );
+	void trimIfOverBudget();
+};
+
+} // namespace assets
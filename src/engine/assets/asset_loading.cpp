@@ -0,0 +1,144 @@
+#include "engine/assets/asset_loading.h"
+
+#include <algorithm>
+#include <exception>
+
+#include "runtime/console.h"
+#include "runtime/thread_pool.h"
+
+namespace assets
+{
+
+AsyncLoadQueue::AsyncLoadQueue( runtime::ThreadPool &pool )
+	: m_pool( pool )
+{
+}
+
+void AsyncLoadQueue::enqueue( const std::shared_ptr<LoadRequest> &request, LoadPriority priority )
+{
+	{
+		std::lock_guard lock( m_mutex );
+		request->priority = priority;
+		request->sequence = m_nextSequence++;
+		request->interest = 1;
+		request->status.store( LoadStatus::Queued, std::memory_order_release );
+		m_queued.push_back( request );
+	}
+	m_pool.submit( [self = shared_from_this()] { self->runNext(); } );
+}
+
+bool AsyncLoadQueue::join( const std::shared_ptr<LoadRequest> &request, LoadPriority priority )
+{
+	std::lock_guard lock( m_mutex );
+	if ( request->cancelled.load( std::memory_order_relaxed ) )
+	{
+		return false;
+	}
+	++request->interest;
+	request->priority = std::max( request->priority, priority );
+	return true;
+}
+
+void AsyncLoadQueue::release( const std::shared_ptr<LoadRequest> &request )
+{
+	std::lock_guard lock( m_mutex );
+	if ( request->interest == 0 || --request->interest > 0 )
+	{
+		return;
+	}
+	request->cancelled.store( true, std::memory_order_relaxed );
+
+	// Not started yet: no worker will see it, so it completes now. The pool task queued for it starts
+	// another request or finds nothing to do.
+	const auto it = std::find( m_queued.begin(), m_queued.end(), request );
+	if ( it != m_queued.end() )
+	{
+		m_queued.erase( it );
+		completeLocked( request );
+	}
+}
+
+std::vector<std::shared_ptr<LoadRequest>> AsyncLoadQueue::takeCompleted( std::size_t maxCount )
+{
+	std::lock_guard lock( m_mutex );
+	const std::size_t count = std::min( maxCount, m_completed.size() );
+	std::vector<std::shared_ptr<LoadRequest>> completed( m_completed.begin(), m_completed.begin() + count );
+	m_completed.erase( m_completed.begin(), m_completed.begin() + count );
+	return completed;
+}
+
+void AsyncLoadQueue::waitForCompletion()
+{
+	std::unique_lock lock( m_mutex );
+	m_completedCondition.wait( lock, [this] { return !m_completed.empty() || ( m_queued.empty() && m_running.empty() ); } );
+}
+
+std::size_t AsyncLoadQueue::getPendingCount() const
+{
+	std::lock_guard lock( m_mutex );
+	return m_queued.size() + m_running.size();
+}
+
+void AsyncLoadQueue::shutdown()
+{
+	std::unique_lock lock( m_mutex );
+	for ( const auto &request : m_queued )
+	{
+		request->cancelled.store( true, std::memory_order_relaxed );
+		completeLocked( request );
+	}
+	m_queued.clear();
+	for ( const auto &request : m_running )
+	{
+		request->cancelled.store( true, std::memory_order_relaxed );
+	}
+	m_completedCondition.wait( lock, [this] { return m_running.empty(); } );
+}
+
+void AsyncLoadQueue::runNext()
+{
+	std::shared_ptr<LoadRequest> request;
+	{
+		std::lock_guard lock( m_mutex );
+		if ( m_queued.empty() )
+		{
+			return;
+		}
+		// Most urgent first, oldest first within a priority
+		const auto next = std::min_element( m_queued.begin(), m_queued.end(), []( const auto &a, const auto &b ) {
+			return a->priority != b->priority ? a->priority > b->priority : a->sequence < b->sequence;
+		} );
+		request = *next;
+		m_queued.erase( next );
+		m_running.push_back( request );
+		request->status.store( LoadStatus::Loading, std::memory_order_release );
+	}
+
+	std::shared_ptr<Asset> result;
+	if ( request->load )
+	{
+		try
+		{
+			LoadContext context( *request );
+			result = request->load( context );
+		}
+		catch ( const std::exception &e )
+		{
+			console::error( "AsyncLoadQueue: Loading {} failed: {}", request->path, e.what() );
+		}
+	}
+
+	std::lock_guard lock( m_mutex );
+	request->result = std::move( result );
+	m_running.erase( std::find( m_running.begin(), m_running.end(), request ) );
+	completeLocked( request );
+}
+
+void AsyncLoadQueue::completeLocked( const std::shared_ptr<LoadRequest> &request )
+{
+	request->status.store( LoadStatus::Finalizing, std::memory_order_release );
+	m_completed.push_back( request );
+	m_completedCondition.notify_all();
+}
+
+} // namespace assets
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "engine/assets/assets.h"
+
+namespace runtime
+{
+class ThreadPool;
+}
+
+namespace assets
+{
+
+// Order in which queued background loads are started; equal priorities start in request order
+enum class LoadPriority : std::uint8_t
+{
+	Low,
+	Normal,
+	High
+};
+
+enum class LoadStatus : std::uint8_t
+{
+	Queued,		// Waiting for a worker
+	Loading,	// Running on a worker
+	Finalizing, // Worker done; waiting for AssetManager::processCompletedLoads() on the main thread
+	Ready,
+	Failed,
+	Cancelled
+};
+
+struct LoadRequest;
+class AsyncLoadQueue;
+
+// Worker-side view of a load: lets slow loaders report progress and notice cancellation
+class LoadContext
+{
+public:
+	explicit LoadContext( LoadRequest &request ) noexcept : m_request( request ) {}
+
+	const std::string &getPath() const noexcept;
+
+	// Fraction in [0, 1] of the work done so far
+	void setProgress( float progress ) noexcept;
+
+	// True once every handle for the load was cancelled; the loader may return early (its result is dropped)
+	bool isCancelled() const noexcept;
+
+private:
+	LoadRequest &m_request;
+};
+
+// Runs on a worker thread; returns the loaded asset or null on failure
+using BackgroundLoadFunction = std::function<std::shared_ptr<Asset>( LoadContext & )>;
+// Runs on the main thread once the asset is Ready
+using LoadFinalizer = std::function<void( const std::shared_ptr<Asset> & )>;
+
+// One caller's claim on a load, shared by copies of its LoadHandle
+struct LoadTicket
+{
+	std::shared_ptr<LoadRequest> request;
+	std::weak_ptr<AsyncLoadQueue> queue;
+	LoadFinalizer onReady;
+	bool cancelled = false;
+};
+
+// State of one background load, shared by every handle requested for the same path
+struct LoadRequest
+{
+	std::string path;
+	AssetType type = AssetType::Unknown;
+	BackgroundLoadFunction load;
+	std::vector<std::shared_ptr<LoadTicket>> tickets; // Main thread only; cleared when finalised
+
+	std::atomic<LoadStatus> status{ LoadStatus::Queued };
+	std::atomic<float> progress{ 0.0f };
+	std::atomic<bool> cancelled{ false };
+
+	// Guarded by the queue mutex
+	LoadPriority priority = LoadPriority::Normal;
+	std::uint64_t sequence = 0;
+	std::uint32_t interest = 0; // Handles that have not cancelled
+
+	// Written by the worker before the request is handed back to the main thread
+	std::shared_ptr<Asset> result;
+};
+
+// Priority-ordered background loads run on a runtime::ThreadPool. Each queued request submits one pool task,
+// and each task starts whichever queued request is most urgent when it runs, so priorities hold even though
+// the pool itself is FIFO. Finished requests wait in a completed list until the main thread collects them.
+class AsyncLoadQueue : public std::enable_shared_from_this<AsyncLoadQueue>
+{
+public:
+	explicit AsyncLoadQueue( runtime::ThreadPool &pool );
+
+	AsyncLoadQueue( const AsyncLoadQueue & ) = delete;
+	AsyncLoadQueue &operator=( const AsyncLoadQueue & ) = delete;
+
+	// Queue request with one interested handle. The queue must be owned by a shared_ptr: pool tasks keep it alive.
+	void enqueue( const std::shared_ptr<LoadRequest> &request, LoadPriority priority );
+
+	// Add an interested handle to a request still in flight, raising its priority if needed. False once the
+	// request was cancelled, so the caller starts a fresh load instead.
+	bool join( const std::shared_ptr<LoadRequest> &request, LoadPriority priority );
+
+	// Withdraw one interested handle. The last one cancels the request: a queued request completes as
+	// cancelled right away, a running one is flagged for its loader.
+	void release( const std::shared_ptr<LoadRequest> &request );
+
+	// Finished (or cancelled) requests in completion order, at most maxCount
+	std::vector<std::shared_ptr<LoadRequest>> takeCompleted( std::size_t maxCount = std::numeric_limits<std::size_t>::max() );
+
+	// Block until a completed request is waiting or nothing is pending
+	void waitForCompletion();
+
+	// Requests queued or running
+	std::size_t getPendingCount() const;
+
+	// Cancel everything and wait for running loaders to return
+	void shutdown();
+
+private:
+	runtime::ThreadPool &m_pool;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_completedCondition;
+	std::vector<std::shared_ptr<LoadRequest>> m_queued;
+	std::vector<std::shared_ptr<LoadRequest>> m_completed;
+	std::uint64_t m_nextSequence = 0;
+	std::vector<std::shared_ptr<LoadRequest>> m_running;
+
+	// Pool task: start the most urgent queued request
+	void runNext();
+	void completeLocked( const std::shared_ptr<LoadRequest> &request );
+};
+
+// Caller's view of a background load, returned by AssetManager::loadAsync(). Copies share one claim on the
+// load: cancelling any of them withdraws it once. Query from the main thread; status reaches Ready only after
+// AssetManager::processCompletedLoads() finalised the load.
+template <typename T>
+class LoadHandle
+{
+public:
+	LoadHandle() = default;
+
+	bool isValid() const noexcept { return m_ticket != nullptr; }
+	const std::string &getPath() const noexcept;
+
+	LoadStatus getStatus() const noexcept;
+	float getProgress() const noexcept;
+	// Ready, Failed or Cancelled
+	bool isDone() const noexcept;
+
+	// The asset once Ready, else null
+	std::shared_ptr<T> get() const;
+
+	// Withdraw interest in the load and drop this handle's onReady; the load stops if no other handle wants it
+	void cancel();
+
+private:
+	friend class AssetManager;
+
+	std::shared_ptr<LoadTicket> m_ticket;
+
+	explicit LoadHandle( std::shared_ptr<LoadTicket> ticket ) : m_ticket( std::move( ticket ) ) {}
+};
+
+inline const std::string &LoadContext::getPath() const noexcept
+{
+	return m_request.path;
+}
+
+inline void LoadContext::setProgress( float progress ) noexcept
+{
+	m_request.progress.store( progress < 0.0f ? 0.0f : ( progress > 1.0f ? 1.0f : progress ), std::memory_order_relaxed );
+}
+
+inline bool LoadContext::isCancelled() const noexcept
+{
+	return m_request.cancelled.load( std::memory_order_relaxed );
+}
+
+template <typename T>
+const std::string &LoadHandle<T>::getPath() const noexcept
+{
+	static const std::string kEmpty;
+	return m_ticket ? m_ticket->request->path : kEmpty;
+}
+
+template <typename T>
+LoadStatus LoadHandle<T>::getStatus() const noexcept
+{
+	if ( !m_ticket )
+	{
+		return LoadStatus::Failed;
+	}
+	// A cancelled handle no longer follows a load other handles keep alive
+	if ( m_ticket->cancelled )
+	{
+		return LoadStatus::Cancelled;
+	}
+	return m_ticket->request->status.load( std::memory_order_acquire );
+}
+
+template <typename T>
+float LoadHandle<T>::getProgress() const noexcept
+{
+	return m_ticket ? m_ticket->request->progress.load( std::memory_order_relaxed ) : 0.0f;
+}
+
+template <typename T>
+bool LoadHandle<T>::isDone() const noexcept
+{
+	const LoadStatus status = getStatus();
+	return status == LoadStatus::Ready || status == LoadStatus::Failed || status == LoadStatus::Cancelled;
+}
+
+template <typename T>
+std::shared_ptr<T> LoadHandle<T>::get() const
+{
+	if ( getStatus() != LoadStatus::Ready )
+	{
+		return nullptr;
+	}
+	return std::static_pointer_cast<T>( m_ticket->request->result );
+}
+
+template <typename T>
+void LoadHandle<T>::cancel()
+{
+	if ( !m_ticket || m_ticket->cancelled || isDone() )
+	{
+		return;
+	}
+	m_ticket->cancelled = true;
+	m_ticket->onReady = nullptr;
+	if ( const auto queue = m_ticket->queue.lock() )
+	{
+		queue->release( m_ticket->request );
+	}
+}
+
+} // namespace assets
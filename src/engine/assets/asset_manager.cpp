@@ -1,5 +1,272 @@
 #include "asset_manager.h"
 
+#include <algorithm>
+#include <system_error>
+
+#include "runtime/console.h"
+#include "runtime/thread_pool.h"
+
 // Static member definitions
 assets::AssetManager::ImportSceneCallback assets::AssetManager::s_importSceneCallback = nullptr;
-assets::AssetManager::SceneLoaderCallback assets::AssetManager::s_sceneLoaderCallback = nullptr;
\ No newline at end of file
+assets::AssetManager::SceneLoaderCallback assets::AssetManager::s_sceneLoaderCallback = nullptr;
+assets::AssetManager::AsyncSceneLoaderCallback assets::AssetManager::s_asyncSceneLoaderCallback = nullptr;
+assets::AssetManager::SceneReloaderCallback assets::AssetManager::s_sceneReloaderCallback = nullptr;
+
+namespace assets
+{
+
+AssetManager::~AssetManager()
+{
+	if ( !m_loadQueue )
+	{
+		return;
+	}
+	m_loadQueue->shutdown();
+
+	// Requests and their tickets refer to each other until finalised
+	for ( const auto &request : m_loadQueue->takeCompleted() )
+	{
+		request->tickets.clear();
+	}
+	for ( const auto &request : m_cachedLoads )
+	{
+		request->tickets.clear();
+	}
+	for ( const auto &[path, request] : m_inFlight )
+	{
+		request->tickets.clear();
+	}
+}
+
+std::shared_ptr<LoadTicket> AssetManager::requestLoad( const std::string &path, LoadPriority priority, BackgroundLoad load, LoadFinalizer onReady )
+{
+	if ( !m_loadQueue )
+	{
+		m_loadQueue = std::make_shared<AsyncLoadQueue>( m_loadPool ? *m_loadPool : runtime::ThreadPool::getShared() );
+	}
+
+	auto ticket = std::make_shared<LoadTicket>();
+	ticket->queue = m_loadQueue;
+	ticket->onReady = std::move( onReady );
+
+	// Already in flight: share that load
+	const auto inFlight = m_inFlight.find( path );
+	if ( inFlight != m_inFlight.end() && inFlight->second->type == load.type && m_loadQueue->join( inFlight->second, priority ) )
+	{
+		ticket->request = inFlight->second;
+		inFlight->second->tickets.push_back( ticket );
+		return ticket;
+	}
+
+	auto request = std::make_shared<LoadRequest>();
+	request->path = path;
+	request->type = load.type;
+	request->tickets.push_back( ticket );
+	ticket->request = request;
+
+	// Already cached: nothing to run, but finalise with the other loads so onReady always runs from
+	// processCompletedLoads()
+	if ( auto cached = m_cache.find( path ) )
+	{
+		request->result = std::move( cached );
+		request->interest = 1;
+		request->status.store( LoadStatus::Finalizing, std::memory_order_relaxed );
+		m_cachedLoads.push_back( std::move( request ) );
+		return ticket;
+	}
+
+	request->load = std::move( load.function );
+	m_inFlight[path] = request;
+	m_loadQueue->enqueue( request, priority );
+	return ticket;
+}
+
+std::size_t AssetManager::processCompletedLoads( std::size_t maxCount )
+{
+	const std::size_t cachedCount = std::min( maxCount, m_cachedLoads.size() );
+	std::vector<std::shared_ptr<LoadRequest>> completed( m_cachedLoads.begin(), m_cachedLoads.begin() + cachedCount );
+	m_cachedLoads.erase( m_cachedLoads.begin(), m_cachedLoads.begin() + cachedCount );
+	if ( m_loadQueue && completed.size() < maxCount )
+	{
+		auto loaded = m_loadQueue->takeCompleted( maxCount - completed.size() );
+		completed.insert( completed.end(), loaded.begin(), loaded.end() );
+	}
+
+	for ( const auto &request : completed )
+	{
+		finalizeLoad( request );
+	}
+	return completed.size();
+}
+
+void AssetManager::finalizeLoad( const std::shared_ptr<LoadRequest> &request )
+{
+	const auto inFlight = m_inFlight.find( request->path );
+	if ( inFlight != m_inFlight.end() && inFlight->second == request )
+	{
+		m_inFlight.erase( inFlight );
+	}
+	const auto tickets = std::move( request->tickets );
+	request->tickets.clear();
+
+	if ( request->cancelled.load( std::memory_order_relaxed ) )
+	{
+		request->result.reset();
+		request->status.store( LoadStatus::Cancelled, std::memory_order_release );
+		return;
+	}
+	if ( !request->result || request->result->getType() != request->type )
+	{
+		request->result.reset();
+		request->status.store( LoadStatus::Failed, std::memory_order_release );
+		return;
+	}
+
+	// A synchronous load() of the same path may have finished first; keep one instance per path
+	const auto loaded = request->result;
+	request->result = m_cache.insertIfAbsent( request->path, std::move( request->result ) );
+	if ( request->result == loaded && loaded->getType() == AssetType::Scene )
+	{
+		watchScene( request->path, static_cast<const Scene &>( *loaded ) );
+	}
+	request->progress.store( 1.0f, std::memory_order_relaxed );
+	request->status.store( LoadStatus::Ready, std::memory_order_release );
+
+	for ( const auto &ticket : tickets )
+	{
+		if ( !ticket->cancelled && ticket->onReady )
+		{
+			ticket->onReady( request->result );
+		}
+		ticket->onReady = nullptr;
+	}
+}
+
+void AssetManager::waitForLoads()
+{
+	for ( ;; )
+	{
+		processCompletedLoads();
+		if ( !m_loadQueue || m_loadQueue->getPendingCount() == 0 )
+		{
+			// Loads that completed since the pass above
+			processCompletedLoads();
+			return;
+		}
+		m_loadQueue->waitForCompletion();
+	}
+}
+
+std::size_t AssetManager::getPendingLoadCount() const
+{
+	return m_inFlight.size() + m_cachedLoads.size();
+}
+
+void AssetManager::watchScene( const std::string &path, const Scene &scene )
+{
+	// A missing file records the error value, so its reappearance counts as a change
+	const auto writeTime = []( const std::string &file ) {
+		std::error_code error;
+		const auto time = std::filesystem::last_write_time( file, error );
+		return error ? std::filesystem::file_time_type::min() : time;
+	};
+
+	WatchedFiles files;
+	files.reserve( scene.getSourceFiles().size() + 1 );
+	files.emplace_back( path, writeTime( path ) );
+	for ( const auto &file : scene.getSourceFiles() )
+	{
+		files.emplace_back( file, writeTime( file ) );
+	}
+
+	std::lock_guard lock( m_watchMutex );
+	m_watchedScenes[path] = std::move( files );
+}
+
+std::vector<SceneReload> AssetManager::reloadChangedScenes()
+{
+	const auto now = std::chrono::steady_clock::now();
+	if ( now - m_lastHotReloadPoll < m_hotReloadInterval )
+	{
+		return {};
+	}
+	m_lastHotReloadPoll = now;
+
+	std::vector<std::string> changed;
+	{
+		std::lock_guard lock( m_watchMutex );
+		for ( auto it = m_watchedScenes.begin(); it != m_watchedScenes.end(); )
+		{
+			// Scenes unloaded or evicted since are loaded fresh on their next load()
+			if ( !m_cache.contains( it->first ) )
+			{
+				it = m_watchedScenes.erase( it );
+				continue;
+			}
+			const bool modified = std::any_of( it->second.begin(), it->second.end(), []( const auto &file ) {
+				std::error_code error;
+				const auto time = std::filesystem::last_write_time( file.first, error );
+				return ( error ? std::filesystem::file_time_type::min() : time ) != file.second;
+			} );
+			if ( modified )
+			{
+				changed.push_back( it->first );
+			}
+			++it;
+		}
+	}
+
+	std::vector<SceneReload> reloads;
+	for ( const auto &path : changed )
+	{
+		auto reload = reloadScene( path );
+		if ( reload.scene )
+		{
+			reloads.push_back( std::move( reload ) );
+		}
+	}
+	return reloads;
+}
+
+SceneReload AssetManager::reloadScene( const std::string &path )
+{
+	const auto asset = m_cache.find( path );
+	if ( !asset || asset->getType() != AssetType::Scene )
+	{
+		return {};
+	}
+	const auto scene = std::static_pointer_cast<Scene>( asset );
+
+	const auto start = std::chrono::steady_clock::now();
+	const SceneLoaderCallback importer = [&scene]( const std::string &scenePath ) -> std::shared_ptr<Scene> {
+		if ( s_sceneReloaderCallback )
+		{
+			return s_sceneReloaderCallback( scenePath, *scene );
+		}
+		return s_sceneLoaderCallback ? s_sceneLoaderCallback( scenePath ) : nullptr;
+	};
+	// Not interned: that would hash every mesh of the re-import; patchScene() detaches what the store shares
+	const auto reloaded = loadSceneWith( path, m_sceneCache.get(), nullptr, importer );
+
+	// Recorded even on failure, so a half-written file is retried when it changes again rather than every poll
+	watchScene( path, reloaded ? *reloaded : *scene );
+	if ( !reloaded )
+	{
+		console::warning( "AssetManager: Reloading {} failed, keeping the loaded scene", path );
+		return {};
+	}
+
+	auto reload = patchScene( scene, *reloaded, m_contentStore.get() );
+	const double ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+	if ( reload.structureChanged )
+	{
+		console::warning( "AssetManager: {} changed structure; import it again to pick up the change", path );
+		return reload;
+	}
+	m_cache.updateSize( path );
+	console::info( "AssetManager: Reloaded {} in {:.1f} ms, {} meshes and {} materials changed", path, ms, reload.changedMeshes.size() + reload.detachedMeshes.size(),
+		reload.changedMaterials.size() + reload.detachedMaterials.size() );
+	return reload;
+}
+
+} // namespace assets
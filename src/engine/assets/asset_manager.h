@@ -1,10 +1,21 @@
 ﻿#pragma once
 
+#include <chrono>
+#include <filesystem>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+#include "engine/assets/asset_cache.h"
+#include "engine/assets/asset_loading.h"
 #include "engine/assets/assets.h"
+#include "engine/assets/content_store.h"
+#include "engine/assets/scene_cache.h"
+#include "engine/assets/scene_reload.h"
 
 namespace ecs
 {
@@ -14,11 +25,14 @@ class Scene;
 namespace assets
 {
 
+// load(), get(), store(), isCached(), unload() and clearCache() may be called from any thread; the
+// background-load API (loadAsync() through processCompletedLoads()) and hot reload belong to the main thread
 class AssetManager
 {
 public:
 	AssetManager() = default;
-	~AssetManager() = default;
+	// Cancels background loads and waits for running loaders to return
+	~AssetManager();
 
 	// Prevent copying for now (can implement later if needed)
 	AssetManager( const AssetManager & ) = delete;
@@ -28,6 +42,24 @@ public:
 	template <typename T>
 	std::shared_ptr<T> load( const std::string &path );
 
+	// Background load: the asset is read and parsed on a worker, then cached and handed to onReady on the
+	// main thread by processCompletedLoads(). Requests for a path already in flight join that load.
+	template <typename T>
+	LoadHandle<T> loadAsync( const std::string &path, LoadPriority priority = LoadPriority::Normal, std::function<void( std::shared_ptr<T> )> onReady = {} );
+
+	// Main thread, once per frame: cache finished background loads and run their onReady callbacks (ECS
+	// import, GPU upload). Returns the number of loads finalised.
+	std::size_t processCompletedLoads( std::size_t maxCount = std::numeric_limits<std::size_t>::max() );
+
+	// Block the main thread, finalising loads as they finish, until none are in flight
+	void waitForLoads();
+
+	// Background loads not yet finalised
+	std::size_t getPendingLoadCount() const;
+
+	// Workers for background loads; the shared runtime pool by default. Takes effect before the first loadAsync().
+	void setLoadThreadPool( runtime::ThreadPool *pool ) { m_loadPool = pool; }
+
 	// Get already loaded asset from cache
 	template <typename T>
 	std::shared_ptr<T> get( const std::string &path );
@@ -41,37 +73,116 @@ public:
 	// Clear all cached assets
 	void clearCache();
 
+	// CPU memory the cached assets may use before the least recently used unreferenced ones are evicted
+	void setCacheBudget( std::size_t bytes ) { m_cache.setBudget( bytes ); }
+	std::size_t getCacheBudget() const { return m_cache.getBudget(); }
+	AssetCacheStats getCacheStats() const { return m_cache.getStats(); }
+	AssetCache &getCache() { return m_cache; }
+
+	// Hot reload: scenes loaded through load() or loadAsync() are watched through the timestamps of their
+	// source files. Polls at most once per interval, re-imports the cached scenes whose files changed and
+	// patches their changed meshes and materials in place (patchScene()). Main thread, once per frame.
+	std::vector<SceneReload> reloadChangedScenes();
+
+	// Re-import the cached scene at path now, changed or not; the result's scene is null if it is not
+	// cached or the re-import failed, which leaves the cached scene as it was
+	SceneReload reloadScene( const std::string &path );
+
+	void setHotReloadInterval( std::chrono::milliseconds interval ) { m_hotReloadInterval = interval; }
+	std::chrono::milliseconds getHotReloadInterval() const { return m_hotReloadInterval; }
+
 	// Store already loaded assets (useful for integration with external loaders)
 	template <typename T>
 	void store( const std::string &path, std::shared_ptr<T> asset );
 
+	// Cooked scene cache checked by load<Scene>() before the scene loader callback; scenes the callback
+	// imports are cooked into it. Null (the default) disables it.
+	void setSceneCache( std::shared_ptr<SceneCache> cache ) { m_sceneCache = std::move( cache ); }
+	const std::shared_ptr<SceneCache> &getSceneCache() const { return m_sceneCache; }
+
+	// Content-addressed store every loaded scene is interned into, so identical meshes and materials are
+	// shared across scenes (see ContentStore). Null (the default) disables sharing.
+	void setContentStore( std::shared_ptr<ContentStore> store ) { m_contentStore = std::move( store ); }
+	const std::shared_ptr<ContentStore> &getContentStore() const { return m_contentStore; }
+
 	// ECS import functionality - to be implemented by external integration
 	// This method signature allows external code to provide the implementation
 	// while keeping the AssetManager independent of ECS
 	using ImportSceneCallback = std::function<void( std::shared_ptr<Scene>, ecs::Scene & )>;
 	using SceneLoaderCallback = std::function<std::shared_ptr<Scene>( const std::string & )>;
+	// Scene loader for background loads that reports progress and checks for cancellation; loadAsync<Scene>()
+	// falls back to the SceneLoaderCallback without one
+	using AsyncSceneLoaderCallback = std::function<std::shared_ptr<Scene>( const std::string &, LoadContext & )>;
+	// Scene loader for hot reloads, given the scene being replaced so unchanged meshes can be reused;
+	// reloadScene() falls back to the SceneLoaderCallback without one
+	using SceneReloaderCallback = std::function<std::shared_ptr<Scene>( const std::string &, const Scene &previous )>;
 
 	// Import scene into ECS (requires importSceneCallback to be set)
 	bool importScene( const std::string &path, ecs::Scene &ecsScene );
 
+	// Background load of a scene followed by its ECS import on the main thread. ecsScene must outlive the
+	// load or the handle must be cancelled.
+	LoadHandle<Scene> importSceneAsync( const std::string &path, ecs::Scene &ecsScene, LoadPriority priority = LoadPriority::Normal );
+
 	// Callback management methods
 	static void setSceneLoaderCallback( SceneLoaderCallback callback );
 	static void clearSceneLoaderCallback();
+	static void setAsyncSceneLoaderCallback( AsyncSceneLoaderCallback callback );
+	static void clearAsyncSceneLoaderCallback();
+	static void setSceneReloaderCallback( SceneReloaderCallback callback );
+	static void clearSceneReloaderCallback();
 	static void setImportSceneCallback( ImportSceneCallback callback );
 	static void clearImportSceneCallback();
 
 private:
 	// Cache storage: path -> shared_ptr<Asset>
-	std::unordered_map<std::string, std::shared_ptr<Asset>> m_cache;
+	AssetCache m_cache;
+	std::shared_ptr<SceneCache> m_sceneCache;
+	std::shared_ptr<ContentStore> m_contentStore;
+
+	// Background loading; path -> load not yet finalised
+	runtime::ThreadPool *m_loadPool = nullptr;
+	std::shared_ptr<AsyncLoadQueue> m_loadQueue;
+	std::unordered_map<std::string, std::shared_ptr<LoadRequest>> m_inFlight;
+	std::vector<std::shared_ptr<LoadRequest>> m_cachedLoads; // Served from m_cache, finalised with the rest
+
+	// Hot reload; scene path -> its source files with the write times seen when it was last (re)loaded
+	using WatchedFiles = std::vector<std::pair<std::string, std::filesystem::file_time_type>>;
+	std::mutex m_watchMutex;
+	std::unordered_map<std::string, WatchedFiles> m_watchedScenes;
+	std::chrono::milliseconds m_hotReloadInterval{ 500 };
+	std::chrono::steady_clock::time_point m_lastHotReloadPoll;
 
 	// Static callback storage
 	static ImportSceneCallback s_importSceneCallback;
 	static SceneLoaderCallback s_sceneLoaderCallback;
+	static AsyncSceneLoaderCallback s_asyncSceneLoaderCallback;
+	static SceneReloaderCallback s_sceneReloaderCallback;
+
+	// Record the current write times of scene's source files under path
+	void watchScene( const std::string &path, const Scene &scene );
 
 	// Internal loading functions for different asset types
 	std::shared_ptr<Scene> loadScene( const std::string &path );
-	std::shared_ptr<Material> loadMaterial( const std::string &path );
-	std::shared_ptr<Mesh> loadMesh( const std::string &path );
+	static std::shared_ptr<Material> loadMaterial( const std::string &path );
+	static std::shared_ptr<Mesh> loadMesh( const std::string &path );
+
+	// Cooked cache lookup, else import through importer and cook the result, then intern the scene into
+	// contentStore. Shared by load() and the background loads, so it only touches what it is given.
+	static std::shared_ptr<Scene> loadSceneWith( const std::string &path, SceneCache *sceneCache, ContentStore *contentStore, const SceneLoaderCallback &importer,
+		const LoadContext *context = nullptr );
+
+	// Worker-side load of one asset type, capturing copies of everything it needs
+	struct BackgroundLoad
+	{
+		AssetType type;
+		BackgroundLoadFunction function;
+	};
+	template <typename T>
+	BackgroundLoad makeBackgroundLoad( const std::string &path ) const;
+
+	std::shared_ptr<LoadTicket> requestLoad( const std::string &path, LoadPriority priority, BackgroundLoad load, LoadFinalizer onReady );
+	void finalizeLoad( const std::shared_ptr<LoadRequest> &request );
 };
 
 // Template specializations for supported asset types
@@ -79,18 +190,22 @@ template <>
 inline std::shared_ptr<Scene> AssetManager::load<Scene>( const std::string &path )
 {
 	// Check cache first
-	const auto it = m_cache.find( path );
-	if ( it != m_cache.end() )
+	if ( auto cached = m_cache.find( path ) )
 	{
-		return std::static_pointer_cast<Scene>( it->second );
+		return std::static_pointer_cast<Scene>( cached );
 	}
 
 	// Load new asset
 	auto scene = loadScene( path );
 	if ( scene && scene->isLoaded() )
 	{
-		// Only cache scenes that were successfully loaded
-		m_cache[path] = scene;
+		// Only cache scenes that were successfully loaded; a thread that loaded the same path first wins
+		auto cached = std::static_pointer_cast<Scene>( m_cache.insertIfAbsent( path, scene ) );
+		if ( cached == scene )
+		{
+			watchScene( path, *scene );
+		}
+		return cached;
 	}
 	return scene;
 }
@@ -99,17 +214,16 @@ template <>
 inline std::shared_ptr<Material> AssetManager::load<Material>( const std::string &path )
 {
 	// Check cache first
-	const auto it = m_cache.find( path );
-	if ( it != m_cache.end() )
+	if ( auto cached = m_cache.find( path ) )
 	{
-		return std::static_pointer_cast<Material>( it->second );
+		return std::static_pointer_cast<Material>( cached );
 	}
 
 	// Load new asset
 	auto material = loadMaterial( path );
 	if ( material )
 	{
-		m_cache[path] = material;
+		return std::static_pointer_cast<Material>( m_cache.insertIfAbsent( path, material ) );
 	}
 	return material;
 }
@@ -118,31 +232,64 @@ template <>
 inline std::shared_ptr<Mesh> AssetManager::load<Mesh>( const std::string &path )
 {
 	// Check cache first
-	const auto it = m_cache.find( path );
-	if ( it != m_cache.end() )
+	if ( auto cached = m_cache.find( path ) )
 	{
-		return std::static_pointer_cast<Mesh>( it->second );
+		return std::static_pointer_cast<Mesh>( cached );
 	}
 
 	// Load new asset
 	auto mesh = loadMesh( path );
 	if ( mesh )
 	{
-		m_cache[path] = mesh;
+		return std::static_pointer_cast<Mesh>( m_cache.insertIfAbsent( path, mesh ) );
 	}
 	return mesh;
 }
 
+template <>
+inline AssetManager::BackgroundLoad AssetManager::makeBackgroundLoad<Scene>( const std::string &path ) const
+{
+	// Callbacks are copied: the main thread may replace them while the load runs
+	return { AssetType::Scene, [path, sceneCache = m_sceneCache, contentStore = m_contentStore, asyncLoader = s_asyncSceneLoaderCallback, loader = s_sceneLoaderCallback]( LoadContext &context ) -> std::shared_ptr<Asset> {
+				const SceneLoaderCallback importer = [&]( const std::string &scenePath ) -> std::shared_ptr<Scene> {
+					if ( asyncLoader )
+					{
+						return asyncLoader( scenePath, context );
+					}
+					return loader ? loader( scenePath ) : nullptr;
+				};
+				return loadSceneWith( path, sceneCache.get(), contentStore.get(), importer, &context );
+			} };
+}
+
+template <>
+inline AssetManager::BackgroundLoad AssetManager::makeBackgroundLoad<Material>( const std::string &path ) const
+{
+	return { AssetType::Material, [path]( LoadContext & ) -> std::shared_ptr<Asset> { return loadMaterial( path ); } };
+}
+
+template <>
+inline AssetManager::BackgroundLoad AssetManager::makeBackgroundLoad<Mesh>( const std::string &path ) const
+{
+	return { AssetType::Mesh, [path]( LoadContext & ) -> std::shared_ptr<Asset> { return loadMesh( path ); } };
+}
+
 // Template method implementations
 template <typename T>
-std::shared_ptr<T> AssetManager::get( const std::string &path )
+LoadHandle<T> AssetManager::loadAsync( const std::string &path, LoadPriority priority, std::function<void( std::shared_ptr<T> )> onReady )
 {
-	const auto it = m_cache.find( path );
-	if ( it != m_cache.end() )
+	LoadFinalizer finalizer;
+	if ( onReady )
 	{
-		return std::static_pointer_cast<T>( it->second );
+		finalizer = [onReady = std::move( onReady )]( const std::shared_ptr<Asset> &asset ) { onReady( std::static_pointer_cast<T>( asset ) ); };
 	}
-	return nullptr;
+	return LoadHandle<T>( requestLoad( path, priority, makeBackgroundLoad<T>( path ), std::move( finalizer ) ) );
+}
+
+template <typename T>
+std::shared_ptr<T> AssetManager::get( const std::string &path )
+{
+	return std::static_pointer_cast<T>( m_cache.find( path ) );
 }
 
 template <typename T>
@@ -152,29 +299,20 @@ void AssetManager::store( const std::string &path, std::shared_ptr<T> asset )
 	{
 		asset->setPath( path );
 		asset->setLoaded( true );
-		m_cache[path] = asset;
+		m_cache.insert( path, std::move( asset ) );
 	}
 }
 
 // Implementation of basic methods
 inline bool AssetManager::isCached( const std::string &path ) const
 {
-	return m_cache.find( path ) != m_cache.end();
+	return m_cache.contains( path );
 }
 
 inline bool AssetManager::unload( const std::string &path )
 {
-	const auto it = m_cache.find( path );
-	if ( it != m_cache.end() )
-	{
-		// Only unload if this is the last reference
-		if ( it->second.use_count() == 1 )
-		{
-			m_cache.erase( it );
-			return true;
-		}
-	}
-	return false;
+	// Only unload if this is the last reference
+	return m_cache.erase( path, true );
 }
 
 inline void AssetManager::clearCache()
@@ -202,6 +340,16 @@ inline bool AssetManager::importScene( const std::string &path, ecs::Scene &ecsS
 	return false;
 }
 
+inline LoadHandle<Scene> AssetManager::importSceneAsync( const std::string &path, ecs::Scene &ecsScene, LoadPriority priority )
+{
+	return loadAsync<Scene>( path, priority, [&ecsScene]( std::shared_ptr<Scene> scene ) {
+		if ( s_importSceneCallback )
+		{
+			s_importSceneCallback( std::move( scene ), ecsScene );
+		}
+	} );
+}
+
 inline void AssetManager::setSceneLoaderCallback( SceneLoaderCallback callback )
 {
 	s_sceneLoaderCallback = callback;
@@ -212,6 +360,26 @@ inline void AssetManager::clearSceneLoaderCallback()
 	s_sceneLoaderCallback = nullptr;
 }
 
+inline void AssetManager::setAsyncSceneLoaderCallback( AsyncSceneLoaderCallback callback )
+{
+	s_asyncSceneLoaderCallback = callback;
+}
+
+inline void AssetManager::clearAsyncSceneLoaderCallback()
+{
+	s_asyncSceneLoaderCallback = nullptr;
+}
+
+inline void AssetManager::setSceneReloaderCallback( SceneReloaderCallback callback )
+{
+	s_sceneReloaderCallback = callback;
+}
+
+inline void AssetManager::clearSceneReloaderCallback()
+{
+	s_sceneReloaderCallback = nullptr;
+}
+
 inline void AssetManager::setImportSceneCallback( ImportSceneCallback callback )
 {
 	s_importSceneCallback = callback;
@@ -224,6 +392,12 @@ inline void AssetManager::clearImportSceneCallback()
 
 // Internal loading implementations
 inline std::shared_ptr<Scene> AssetManager::loadScene( const std::string &path )
+{
+	return loadSceneWith( path, m_sceneCache.get(), m_contentStore.get(), s_sceneLoaderCallback );
+}
+
+inline std::shared_ptr<Scene> AssetManager::loadSceneWith( const std::string &path, SceneCache *sceneCache, ContentStore *contentStore, const SceneLoaderCallback &importer,
+	const LoadContext *context )
 {
 	// Basic validation
 	if ( path.empty() )
@@ -231,14 +405,37 @@ inline std::shared_ptr<Scene> AssetManager::loadScene( const std::string &path )
 		return nullptr;
 	}
 
+	if ( sceneCache )
+	{
+		if ( auto scene = sceneCache->load( path ) )
+		{
+			scene->setPath( path );
+			scene->setLoaded( true );
+			if ( contentStore )
+			{
+				contentStore->internScene( *scene );
+			}
+			return scene;
+		}
+	}
+
 	// Use scene loader callback if available (for real glTF loading)
-	if ( s_sceneLoaderCallback )
+	if ( importer )
 	{
-		auto scene = s_sceneLoaderCallback( path );
-		if ( scene )
+		auto scene = importer( path );
+		// A cancelled import may have stopped part way; never cook it
+		if ( scene && !( context && context->isCancelled() ) )
 		{
+			if ( sceneCache )
+			{
+				sceneCache->store( path, *scene );
+			}
 			scene->setPath( path );
 			scene->setLoaded( true );
+			if ( contentStore )
+			{
+				contentStore->internScene( *scene );
+			}
 			return scene;
 		}
 	}
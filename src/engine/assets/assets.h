@@ -1,8 +1,13 @@
 ﻿#pragma once
 
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
+#include "engine/assets/vertex_layout.h"
+#include "engine/assets/vertex_packing.h"
 #include "math/bounding_box_3d.h"
 #include "math/vec.h"
 
@@ -28,6 +33,9 @@ using MaterialHandle = size_t;
 constexpr MeshHandle INVALID_MESH_HANDLE = std::numeric_limits<MeshHandle>::max();
 constexpr MaterialHandle INVALID_MATERIAL_HANDLE = std::numeric_limits<MaterialHandle>::max();
 
+// Largest vertex count a 16-bit index buffer can address
+constexpr std::uint32_t kMaxShortIndexVertexCount = 65536;
+
 // Simple transform structure for scene nodes
 struct Transform
 {
@@ -40,6 +48,12 @@ struct Transform
 		: position( pos ), rotation( rot ), scale( scl ) {}
 };
 
+// Heap bytes behind a string; short strings live inside the object
+inline std::size_t stringHeapBytes( const std::string &text )
+{
+	return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+}
+
 // Base asset interface
 class Asset
 {
@@ -47,6 +61,9 @@ public:
 	virtual ~Asset() = default;
 	virtual AssetType getType() const = 0;
 
+	// CPU bytes held by the asset, for cache budgets; heap blocks are counted at their capacity
+	virtual std::size_t getMemoryUsage() const { return sizeof( Asset ) + stringHeapBytes( m_path ); }
+
 	const std::string &getPath() const { return m_path; }
 	bool isLoaded() const { return m_loaded; }
 
@@ -69,6 +86,120 @@ struct Vertex
 	math::Vec4f color = { 1.0f, 1.0f, 1.0f, 1.0f }; // RGBA vertex color
 };
 
+// Offsets the standard VertexLayout assumes
+static_assert( sizeof( Vertex ) == VertexLayout{}.getStride() );
+static_assert( offsetof( Vertex, normal ) == VertexLayout{}.getOffset( VertexAttribute::Normal ) );
+static_assert( offsetof( Vertex, texCoord ) == VertexLayout{}.getOffset( VertexAttribute::TexCoord ) );
+static_assert( offsetof( Vertex, tangent ) == VertexLayout{}.getOffset( VertexAttribute::Tangent ) );
+static_assert( offsetof( Vertex, color ) == VertexLayout{}.getOffset( VertexAttribute::Color ) );
+
+// Write vertex to out in layout; absent attributes are dropped. out must hold layout.getStride() bytes.
+inline void encodeVertex( const Vertex &vertex, const VertexLayout &layout, const PositionQuantization &quantization, std::byte *out ) noexcept
+{
+	const auto write = [&]( VertexAttribute attribute, const void *data ) {
+		std::memcpy( out + layout.getOffset( attribute ), data, VertexLayout::getAttributeSize( attribute, layout.packed ) );
+	};
+	if ( !layout.packed )
+	{
+		write( VertexAttribute::Position, &vertex.position );
+		if ( layout.has( VertexAttribute::Normal ) )
+			write( VertexAttribute::Normal, &vertex.normal );
+		if ( layout.has( VertexAttribute::TexCoord ) )
+			write( VertexAttribute::TexCoord, &vertex.texCoord );
+		if ( layout.has( VertexAttribute::Tangent ) )
+			write( VertexAttribute::Tangent, &vertex.tangent );
+		if ( layout.has( VertexAttribute::Color ) )
+			write( VertexAttribute::Color, &vertex.color );
+		return;
+	}
+
+	std::int16_t position[4];
+	quantizePosition( vertex.position, quantization, position );
+	position[3] = vertex.tangent.w < 0.0f ? -32767 : 32767;
+	write( VertexAttribute::Position, position );
+	if ( layout.has( VertexAttribute::Normal ) )
+	{
+		std::int16_t normal[2];
+		encodeOctahedral( vertex.normal, normal );
+		write( VertexAttribute::Normal, normal );
+	}
+	if ( layout.has( VertexAttribute::TexCoord ) )
+	{
+		const std::uint16_t texCoord[2] = { floatToHalf( vertex.texCoord.x ), floatToHalf( vertex.texCoord.y ) };
+		write( VertexAttribute::TexCoord, texCoord );
+	}
+	if ( layout.has( VertexAttribute::Tangent ) )
+	{
+		std::int16_t tangent[2];
+		encodeOctahedral( { vertex.tangent.x, vertex.tangent.y, vertex.tangent.z }, tangent );
+		write( VertexAttribute::Tangent, tangent );
+	}
+	if ( layout.has( VertexAttribute::Color ) )
+	{
+		const std::uint8_t color[4] = { encodeUnorm8( vertex.color.x ), encodeUnorm8( vertex.color.y ), encodeUnorm8( vertex.color.z ), encodeUnorm8( vertex.color.w ) };
+		write( VertexAttribute::Color, color );
+	}
+}
+
+// Inverse of encodeVertex(); absent attributes take the Vertex defaults
+inline Vertex decodeVertex( const std::byte *in, const VertexLayout &layout, const PositionQuantization &quantization ) noexcept
+{
+	Vertex vertex;
+	const auto read = [&]( VertexAttribute attribute, void *data ) {
+		std::memcpy( data, in + layout.getOffset( attribute ), VertexLayout::getAttributeSize( attribute, layout.packed ) );
+	};
+	if ( !layout.packed )
+	{
+		read( VertexAttribute::Position, &vertex.position );
+		if ( layout.has( VertexAttribute::Normal ) )
+			read( VertexAttribute::Normal, &vertex.normal );
+		if ( layout.has( VertexAttribute::TexCoord ) )
+			read( VertexAttribute::TexCoord, &vertex.texCoord );
+		if ( layout.has( VertexAttribute::Tangent ) )
+			read( VertexAttribute::Tangent, &vertex.tangent );
+		if ( layout.has( VertexAttribute::Color ) )
+			read( VertexAttribute::Color, &vertex.color );
+		return vertex;
+	}
+
+	std::int16_t position[4];
+	read( VertexAttribute::Position, position );
+	vertex.position = dequantizePosition( position, quantization );
+	if ( layout.has( VertexAttribute::Normal ) )
+	{
+		std::int16_t normal[2];
+		read( VertexAttribute::Normal, normal );
+		vertex.normal = decodeOctahedral( normal );
+	}
+	if ( layout.has( VertexAttribute::TexCoord ) )
+	{
+		std::uint16_t texCoord[2];
+		read( VertexAttribute::TexCoord, texCoord );
+		vertex.texCoord = { halfToFloat( texCoord[0] ), halfToFloat( texCoord[1] ) };
+	}
+	if ( layout.has( VertexAttribute::Tangent ) )
+	{
+		std::int16_t tangent[2];
+		read( VertexAttribute::Tangent, tangent );
+		const auto direction = decodeOctahedral( tangent );
+		vertex.tangent = { direction.x, direction.y, direction.z, position[3] < 0 ? -1.0f : 1.0f };
+	}
+	if ( layout.has( VertexAttribute::Color ) )
+	{
+		std::uint8_t color[4];
+		read( VertexAttribute::Color, color );
+		vertex.color = { decodeUnorm8( color[0] ), decodeUnorm8( color[1] ), decodeUnorm8( color[2] ), decodeUnorm8( color[3] ) };
+	}
+	return vertex;
+}
+
+// Reduced-detail index list sharing the primitive's vertices
+struct PrimitiveLod
+{
+	std::vector<std::uint32_t> indices;
+	float error = 0.0f; // Object-space geometric error relative to the full-detail mesh
+};
+
 // Material representation
 class Material : public Asset
 {
@@ -91,6 +222,12 @@ public:
 	const PBRMaterial &getPBRMaterial() const { return m_pbrMaterial; }
 	PBRMaterial &getPBRMaterial() { return m_pbrMaterial; }
 
+	std::size_t getMemoryUsage() const override
+	{
+		return Asset::getMemoryUsage() + sizeof( Material ) - sizeof( Asset ) + stringHeapBytes( m_name ) + stringHeapBytes( m_pbrMaterial.baseColorTexture ) +
+			stringHeapBytes( m_pbrMaterial.metallicRoughnessTexture ) + stringHeapBytes( m_pbrMaterial.normalTexture ) + stringHeapBytes( m_pbrMaterial.emissiveTexture );
+	}
+
 	// Name functionality
 	const std::string &getName() const { return m_name; }
 	void setName( const std::string &name ) { m_name = name; }
@@ -120,15 +257,21 @@ private:
 class Primitive
 {
 public:
-	// Vertex and index accessors
+	// Vertex and index accessors; getVertices() is empty unless the primitive uses the standard layout
 	const std::vector<Vertex> &getVertices() const { return m_vertices; }
 	const std::vector<std::uint32_t> &getIndices() const { return m_indices; }
 
-	// Vertex count accessors
-	std::uint32_t getVertexCount() const { return static_cast<std::uint32_t>( m_vertices.size() ); }
+	// Vertex count accessors (any layout)
+	std::uint32_t getVertexCount() const
+	{
+		return static_cast<std::uint32_t>( m_layout.isStandard() ? m_vertices.size() : m_vertexData.size() / m_layout.getStride() );
+	}
 	std::uint32_t getIndexCount() const { return static_cast<std::uint32_t>( m_indices.size() ); }
 
-	// Methods for building primitive data
+	// Every vertex is addressable with 16-bit indices
+	bool fitsShortIndices() const { return getVertexCount() <= kMaxShortIndexVertexCount; }
+
+	// Methods for building primitive data; both work on the standard layout
 	void addVertex( const Vertex &vertex )
 	{
 		m_vertices.push_back( vertex );
@@ -137,13 +280,113 @@ public:
 
 	void addIndex( std::uint32_t index ) { m_indices.push_back( index ); }
 
+	// Bulk replacement for importers that assemble the arrays themselves; bounds must cover the vertices
+	void setVertices( std::vector<Vertex> vertices, const math::BoundingBox3Df &bounds )
+	{
+		m_vertices = std::move( vertices );
+		m_vertexData = {};
+		m_layout = {};
+		m_quantization = {};
+		m_lods.clear();
+		m_bounds = bounds;
+	}
+
+	void setIndices( std::vector<std::uint32_t> indices )
+	{
+		m_indices = std::move( indices );
+		m_lods.clear();
+	}
+
+	// Vertex storage. Any layout other than the standard one keeps only the encoded bytes.
+	const VertexLayout &getVertexLayout() const { return m_layout; }
+	const PositionQuantization &getPositionQuantization() const { return m_quantization; }
+	bool hasCompactVertices() const { return !m_layout.isStandard(); }
+
+	// Interleaved vertices in getVertexLayout(), as uploaded to the GPU
+	std::span<const std::byte> getVertexData() const
+	{
+		return m_layout.isStandard() ? std::as_bytes( std::span( m_vertices ) ) : std::span<const std::byte>( m_vertexData );
+	}
+
+	// Re-encode the vertices in place; the order is kept, so indices and LODs stay valid. Packed layouts
+	// quantize positions against the current bounds.
+	void setVertexLayout( const VertexLayout &layout )
+	{
+		if ( layout == m_layout )
+		{
+			return;
+		}
+		auto vertices = decodeVertices();
+		m_layout = layout;
+		if ( layout.isStandard() )
+		{
+			m_vertices = std::move( vertices );
+			m_vertexData = {};
+			m_quantization = {};
+			return;
+		}
+
+		m_quantization = layout.packed ? PositionQuantization::fromBounds( m_bounds ) : PositionQuantization{};
+		const std::uint32_t stride = layout.getStride();
+		m_vertexData.assign( vertices.size() * stride, std::byte{ 0 } );
+		for ( std::size_t i = 0; i < vertices.size(); ++i )
+		{
+			encodeVertex( vertices[i], layout, m_quantization, m_vertexData.data() + i * stride );
+		}
+		m_vertices = {};
+	}
+
+	// Restore vertices already encoded in layout, as returned by getVertexData(); nothing is re-encoded
+	void setVertexData( std::span<const std::byte> data, const VertexLayout &layout, const PositionQuantization &quantization, const math::BoundingBox3Df &bounds )
+	{
+		m_layout = layout;
+		m_quantization = quantization;
+		m_bounds = bounds;
+		m_lods.clear();
+		if ( layout.isStandard() )
+		{
+			m_vertices.resize( data.size() / sizeof( Vertex ) );
+			std::memcpy( m_vertices.data(), data.data(), m_vertices.size() * sizeof( Vertex ) );
+			m_vertexData = {};
+		}
+		else
+		{
+			m_vertexData.assign( data.begin(), data.end() );
+			m_vertices = {};
+		}
+	}
+
+	// Float vertices from any layout, decoded on demand for tools and CPU-side processing
+	std::vector<Vertex> decodeVertices() const
+	{
+		if ( m_layout.isStandard() )
+		{
+			return m_vertices;
+		}
+		const std::uint32_t stride = m_layout.getStride();
+		std::vector<Vertex> vertices( m_vertexData.size() / stride );
+		for ( std::size_t i = 0; i < vertices.size(); ++i )
+		{
+			vertices[i] = decodeVertex( m_vertexData.data() + i * stride, m_layout, m_quantization );
+		}
+		return vertices;
+	}
+
 	void clearVertices()
 	{
 		m_vertices.clear();
+		m_vertexData.clear();
+		m_layout = {};
+		m_quantization = {};
+		m_lods.clear();
 		resetBounds();
 	}
 
-	void clearIndices() { m_indices.clear(); }
+	void clearIndices()
+	{
+		m_indices.clear();
+		m_lods.clear();
+	}
 
 	void reserveVertices( std::size_t count ) { m_vertices.reserve( count ); }
 	void reserveIndices( std::size_t count ) { m_indices.reserve( count ); }
@@ -157,9 +400,31 @@ public:
 	void setMaterialHandle( MaterialHandle handle ) { m_materialHandle = handle; }
 	bool hasMaterial() const { return m_materialHandle != INVALID_MATERIAL_HANDLE; }
 
+	// Simplified levels ordered from finest to coarsest; level 0 is the full-detail index list
+	const std::vector<PrimitiveLod> &getLods() const { return m_lods; }
+	std::uint32_t getLodCount() const { return static_cast<std::uint32_t>( m_lods.size() ) + 1; }
+	void addLod( PrimitiveLod lod ) { m_lods.push_back( std::move( lod ) ); }
+	void clearLods() { m_lods.clear(); }
+
+	// Heap bytes of the vertex, index and LOD arrays
+	std::size_t getMemoryUsage() const
+	{
+		std::size_t bytes = m_vertices.capacity() * sizeof( Vertex ) + m_vertexData.capacity() + m_indices.capacity() * sizeof( std::uint32_t ) +
+			m_lods.capacity() * sizeof( PrimitiveLod );
+		for ( const auto &lod : m_lods )
+		{
+			bytes += lod.indices.capacity() * sizeof( std::uint32_t );
+		}
+		return bytes;
+	}
+
 private:
 	std::vector<Vertex> m_vertices;
+	std::vector<std::byte> m_vertexData; // Encoded vertices when m_layout is not the standard one
+	VertexLayout m_layout;
+	PositionQuantization m_quantization;
 	std::vector<std::uint32_t> m_indices;
+	std::vector<PrimitiveLod> m_lods;
 	MaterialHandle m_materialHandle = INVALID_MATERIAL_HANDLE;
 
 	// Bounding box data
@@ -187,6 +452,16 @@ public:
 
 	std::uint32_t getPrimitiveCount() const { return static_cast<std::uint32_t>( m_primitives.size() ); }
 
+	std::size_t getMemoryUsage() const override
+	{
+		std::size_t bytes = Asset::getMemoryUsage() + sizeof( Mesh ) - sizeof( Asset ) + m_primitives.capacity() * sizeof( Primitive );
+		for ( const auto &primitive : m_primitives )
+		{
+			bytes += primitive.getMemoryUsage();
+		}
+		return bytes;
+	}
+
 	const Primitive &getPrimitive( std::uint32_t index ) const
 	{
 		return m_primitives.at( index );
@@ -226,8 +501,14 @@ public:
 		}
 	}
 
+	// Hash of the source data and import settings the mesh was built from, 0 if unknown. A re-import
+	// reuses the mesh instead of rebuilding it when the hash is unchanged.
+	std::uint64_t getSourceHash() const { return m_sourceHash; }
+	void setSourceHash( std::uint64_t hash ) { m_sourceHash = hash; }
+
 private:
 	std::vector<Primitive> m_primitives;
+	std::uint64_t m_sourceHash = 0;
 
 	// Aggregate bounding box data from all primitives
 	math::BoundingBox3Df m_bounds;
@@ -297,6 +578,18 @@ public:
 		}
 	}
 
+	// Bytes of this node and its subtree
+	std::size_t getMemoryUsage() const
+	{
+		std::size_t bytes = sizeof( SceneNode ) + stringHeapBytes( m_name ) + m_children.capacity() * sizeof( std::unique_ptr<SceneNode> ) +
+			m_meshHandles.capacity() * sizeof( MeshHandle );
+		for ( const auto &child : m_children )
+		{
+			bytes += child->getMemoryUsage();
+		}
+		return bytes;
+	}
+
 	// Transform accessors
 	bool hasTransform() const { return m_hasTransformData; }
 	const Transform &getTransform() const { return m_transform; }
@@ -351,6 +644,19 @@ public:
 		return ( handle < m_meshes.size() ) ? m_meshes[handle] : nullptr;
 	}
 
+	// Swap the resource at handle for another, e.g. an identical instance shared with other scenes
+	void setMaterial( MaterialHandle handle, std::shared_ptr<Material> material )
+	{
+		if ( handle < m_materials.size() && material )
+			m_materials[handle] = std::move( material );
+	}
+
+	void setMesh( MeshHandle handle, std::shared_ptr<Mesh> mesh )
+	{
+		if ( handle < m_meshes.size() && mesh )
+			m_meshes[handle] = std::move( mesh );
+	}
+
 	// Validation
 	bool isValidMaterialHandle( MaterialHandle handle ) const
 	{
@@ -391,6 +697,33 @@ public:
 		return m_rootNodes.size(); // Simplified for now
 	}
 
+	// Includes the materials and meshes the scene references
+	std::size_t getMemoryUsage() const override
+	{
+		std::size_t bytes = Asset::getMemoryUsage() + sizeof( Scene ) - sizeof( Asset );
+		for ( const auto &material : m_materials )
+		{
+			bytes += sizeof( material ) + material->getMemoryUsage();
+		}
+		for ( const auto &mesh : m_meshes )
+		{
+			bytes += sizeof( mesh ) + mesh->getMemoryUsage();
+		}
+		for ( const auto &node : m_rootNodes )
+		{
+			bytes += sizeof( node ) + node->getMemoryUsage();
+		}
+		for ( const auto &file : m_sourceFiles )
+		{
+			bytes += sizeof( file ) + stringHeapBytes( file );
+		}
+		return bytes;
+	}
+
+	// Files besides getPath() the scene was imported from, such as external glTF buffers
+	const std::vector<std::string> &getSourceFiles() const { return m_sourceFiles; }
+	void addSourceFile( const std::string &path ) { m_sourceFiles.push_back( path ); }
+
 private:
 	// Root-level resource collections (matching glTF structure)
 	std::vector<std::shared_ptr<Material>> m_materials;
@@ -398,6 +731,8 @@ private:
 
 	// Scene graph
 	std::vector<std::unique_ptr<SceneNode>> m_rootNodes;
+
+	std::vector<std::string> m_sourceFiles;
 };
 
 } // namespace assets
@@ -0,0 +1,159 @@
+#include "engine/assets/content_hash.h"
+
+#include <bit>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace assets
+{
+
+namespace
+{
+
+// xxHash64 constants and round function
+constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr std::uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+std::uint64_t load64( const std::uint8_t *p ) noexcept
+{
+	std::uint64_t value;
+	std::memcpy( &value, p, sizeof( value ) );
+	return value;
+}
+
+std::uint32_t load32( const std::uint8_t *p ) noexcept
+{
+	std::uint32_t value;
+	std::memcpy( &value, p, sizeof( value ) );
+	return value;
+}
+
+std::uint64_t hashRound( std::uint64_t accumulator, std::uint64_t lane ) noexcept
+{
+	return std::rotl( accumulator + lane * kPrime2, 31 ) * kPrime1;
+}
+
+std::uint64_t hashMerge( std::uint64_t hash, std::uint64_t accumulator ) noexcept
+{
+	return ( hash ^ hashRound( 0, accumulator ) ) * kPrime1 + kPrime4;
+}
+
+// Structured values are hashed as a chain: each part is seeded with the hash of everything before it
+template <typename T>
+std::uint64_t hashValue( const T &value, std::uint64_t seed ) noexcept
+{
+	static_assert( std::is_trivially_copyable_v<T> );
+	return hashContent( { reinterpret_cast<const std::uint8_t *>( &value ), sizeof( T ) }, seed );
+}
+
+template <typename T>
+std::uint64_t hashArray( std::span<const T> values, std::uint64_t seed ) noexcept
+{
+	static_assert( std::is_trivially_copyable_v<T> );
+	// The count comes first, so adjacent arrays cannot trade elements without changing the hash
+	return hashContent( { reinterpret_cast<const std::uint8_t *>( values.data() ), values.size_bytes() }, hashValue( static_cast<std::uint64_t>( values.size() ), seed ) );
+}
+
+std::uint64_t hashString( const std::string &value, std::uint64_t seed ) noexcept
+{
+	return hashArray( std::span<const char>( value ), seed );
+}
+
+} // namespace
+
+std::uint64_t hashContent( std::span<const std::uint8_t> bytes, std::uint64_t seed ) noexcept
+{
+	const std::uint8_t *p = bytes.data();
+	const std::uint8_t *const end = p + bytes.size();
+	std::uint64_t hash;
+	if ( bytes.size() >= 32 )
+	{
+		std::uint64_t lanes[4] = { seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1 };
+		for ( ; p + 32 <= end; p += 32 )
+		{
+			lanes[0] = hashRound( lanes[0], load64( p ) );
+			lanes[1] = hashRound( lanes[1], load64( p + 8 ) );
+			lanes[2] = hashRound( lanes[2], load64( p + 16 ) );
+			lanes[3] = hashRound( lanes[3], load64( p + 24 ) );
+		}
+		hash = std::rotl( lanes[0], 1 ) + std::rotl( lanes[1], 7 ) + std::rotl( lanes[2], 12 ) + std::rotl( lanes[3], 18 );
+		for ( const std::uint64_t lane : lanes )
+		{
+			hash = hashMerge( hash, lane );
+		}
+	}
+	else
+	{
+		hash = seed + kPrime5;
+	}
+
+	hash += bytes.size();
+	for ( ; p + 8 <= end; p += 8 )
+	{
+		hash = std::rotl( hash ^ hashRound( 0, load64( p ) ), 27 ) * kPrime1 + kPrime4;
+	}
+	if ( p + 4 <= end )
+	{
+		hash = std::rotl( hash ^ ( load32( p ) * kPrime1 ), 23 ) * kPrime2 + kPrime3;
+		p += 4;
+	}
+	for ( ; p < end; ++p )
+	{
+		hash = std::rotl( hash ^ ( *p * kPrime5 ), 11 ) * kPrime1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= kPrime2;
+	hash ^= hash >> 29;
+	hash *= kPrime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+std::uint64_t hashPrimitive( const Primitive &primitive, std::uint64_t seed ) noexcept
+{
+	const auto &layout = primitive.getVertexLayout();
+	std::uint64_t hash = hashValue( layout.attributes, seed );
+	hash = hashValue( static_cast<std::uint32_t>( layout.packed ), hash );
+	if ( layout.packed )
+	{
+		hash = hashValue( primitive.getPositionQuantization(), hash );
+	}
+	hash = hashArray( primitive.getVertexData(), hash );
+	hash = hashArray( std::span<const std::uint32_t>( primitive.getIndices() ), hash );
+	for ( const auto &lod : primitive.getLods() )
+	{
+		hash = hashValue( lod.error, hash );
+		hash = hashArray( std::span<const std::uint32_t>( lod.indices ), hash );
+	}
+	return hashValue( static_cast<std::uint64_t>( primitive.getLods().size() ), hash );
+}
+
+std::uint64_t hashMesh( const Mesh &mesh, std::uint64_t seed ) noexcept
+{
+	std::uint64_t hash = hashValue( mesh.getPrimitiveCount(), seed );
+	for ( const auto &primitive : mesh.getPrimitives() )
+	{
+		hash = hashPrimitive( primitive, hashValue( static_cast<std::uint64_t>( primitive.getMaterialHandle() ), hash ) );
+	}
+	return hash;
+}
+
+std::uint64_t hashMaterial( const Material &material ) noexcept
+{
+	const auto &pbr = material.getPBRMaterial();
+	std::uint64_t hash = hashValue( pbr.baseColorFactor, 0 );
+	hash = hashValue( pbr.metallicFactor, hash );
+	hash = hashValue( pbr.roughnessFactor, hash );
+	hash = hashValue( pbr.emissiveFactor, hash );
+	hash = hashString( pbr.baseColorTexture, hash );
+	hash = hashString( pbr.metallicRoughnessTexture, hash );
+	hash = hashString( pbr.normalTexture, hash );
+	return hashString( pbr.emissiveTexture, hash );
+}
+
+} // namespace assets
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "engine/assets/assets.h"
+
+namespace assets
+{
+
+// 64-bit hash of a byte range in four independent lanes, so multi-GB sources hash at memory speed. Not
+// cryptographic; used to key cooked data on content.
+std::uint64_t hashContent( std::span<const std::uint8_t> bytes, std::uint64_t seed = 0 ) noexcept;
+
+// What a primitive uploads: vertex layout and quantization, vertices, indices and LOD chain. The material
+// handle and bounds are left out; bounds follow from the vertices.
+std::uint64_t hashPrimitive( const Primitive &primitive, std::uint64_t seed = 0 ) noexcept;
+
+// Every primitive in order, with its material handle
+std::uint64_t hashMesh( const Mesh &mesh, std::uint64_t seed = 0 ) noexcept;
+
+// PBR factors and texture paths; the name is left out
+std::uint64_t hashMaterial( const Material &material ) noexcept;
+
+} // namespace assets
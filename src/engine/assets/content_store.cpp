@@ -0,0 +1,217 @@
+#include "engine/assets/content_store.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "engine/assets/content_hash.h"
+#include "runtime/console.h"
+
+namespace assets
+{
+
+namespace
+{
+
+constexpr std::size_t kMinPruneThreshold = 1024;
+
+std::uint64_t chainHash( std::uint64_t value, std::uint64_t seed ) noexcept
+{
+	return hashContent( { reinterpret_cast<const std::uint8_t *>( &value ), sizeof( value ) }, seed );
+}
+
+bool sameMaterial( const Material &a, const Material &b )
+{
+	const auto &x = a.getPBRMaterial();
+	const auto &y = b.getPBRMaterial();
+	return x.baseColorFactor == y.baseColorFactor && x.metallicFactor == y.metallicFactor && x.roughnessFactor == y.roughnessFactor &&
+		x.emissiveFactor == y.emissiveFactor && x.baseColorTexture == y.baseColorTexture && x.metallicRoughnessTexture == y.metallicRoughnessTexture &&
+		x.normalTexture == y.normalTexture && x.emissiveTexture == y.emissiveTexture;
+}
+
+bool samePrimitive( const Primitive &a, const Primitive &b )
+{
+	const auto &layoutA = a.getVertexLayout();
+	const auto &layoutB = b.getVertexLayout();
+	if ( layoutA.attributes != layoutB.attributes || layoutA.packed != layoutB.packed || a.getMaterialHandle() != b.getMaterialHandle() ||
+		a.getIndices() != b.getIndices() || a.getLods().size() != b.getLods().size() )
+	{
+		return false;
+	}
+	if ( layoutA.packed && ( a.getPositionQuantization().offset != b.getPositionQuantization().offset || a.getPositionQuantization().scale != b.getPositionQuantization().scale ) )
+	{
+		return false;
+	}
+	const auto verticesA = a.getVertexData();
+	const auto verticesB = b.getVertexData();
+	if ( verticesA.size() != verticesB.size() || std::memcmp( verticesA.data(), verticesB.data(), verticesA.size() ) != 0 )
+	{
+		return false;
+	}
+	for ( std::size_t i = 0; i < a.getLods().size(); ++i )
+	{
+		if ( a.getLods()[i].error != b.getLods()[i].error || a.getLods()[i].indices != b.getLods()[i].indices )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// What MeshGPU uploads for mesh
+std::size_t uploadBytes( const Mesh &mesh )
+{
+	std::size_t bytes = 0;
+	for ( const auto &primitive : mesh.getPrimitives() )
+	{
+		bytes += primitive.getVertexData().size() + primitive.getIndices().size() * sizeof( std::uint32_t );
+		for ( const auto &lod : primitive.getLods() )
+		{
+			bytes += lod.indices.size() * sizeof( std::uint32_t );
+		}
+	}
+	return bytes;
+}
+
+} // namespace
+
+std::size_t ContentStore::internScene( Scene &scene )
+{
+	// Hashed before taking the lock, so concurrent loads only serialise on lookups and on comparing matches
+	std::vector<std::uint64_t> materialHashes( scene.getMaterialCount() );
+	for ( MaterialHandle handle = 0; handle < materialHashes.size(); ++handle )
+	{
+		materialHashes[handle] = hashMaterial( *scene.getMaterial( handle ) );
+	}
+	// Seeded with the content of the materials each primitive uses: a mesh shared between scenes is
+	// configured once against the materials of the first
+	std::vector<std::uint64_t> meshHashes( scene.getMeshCount() );
+	for ( MeshHandle handle = 0; handle < meshHashes.size(); ++handle )
+	{
+		const auto &mesh = *scene.getMesh( handle );
+		std::uint64_t seed = 0;
+		for ( const auto &primitive : mesh.getPrimitives() )
+		{
+			const MaterialHandle material = primitive.getMaterialHandle();
+			seed = chainHash( material < materialHashes.size() ? materialHashes[material] : 0, seed );
+		}
+		meshHashes[handle] = hashMesh( mesh, seed );
+	}
+
+	std::lock_guard lock( m_mutex );
+	const std::uint64_t meshesShared = m_stats.meshesShared;
+	const std::uint64_t materialsShared = m_stats.materialsShared;
+	std::size_t bytesSaved = 0;
+	for ( MaterialHandle handle = 0; handle < materialHashes.size(); ++handle )
+	{
+		scene.setMaterial( handle, internMaterial( materialHashes[handle], scene.getMaterial( handle ), bytesSaved ) );
+	}
+	for ( MeshHandle handle = 0; handle < meshHashes.size(); ++handle )
+	{
+		scene.setMesh( handle, internMesh( meshHashes[handle], scene.getMesh( handle ), scene, bytesSaved ) );
+	}
+	pruneIfGrown();
+
+	if ( bytesSaved > 0 )
+	{
+		console::info( "ContentStore: {} shares {} meshes and {} materials with loaded scenes, {} KiB saved", scene.getPath(), m_stats.meshesShared - meshesShared,
+			m_stats.materialsShared - materialsShared, bytesSaved / 1024 );
+	}
+	return bytesSaved;
+}
+
+std::shared_ptr<Material> ContentStore::internMaterial( std::uint64_t hash, const std::shared_ptr<Material> &material, std::size_t &bytesSaved )
+{
+	auto &entry = m_materials[hash];
+	const auto existing = entry.lock();
+	if ( !existing )
+	{
+		entry = material;
+		return material;
+	}
+	// A hash collision keeps both; the stored one stays the match for later scenes
+	if ( existing == material || !sameMaterial( *existing, *material ) )
+	{
+		return material;
+	}
+	const std::size_t bytes = material->getMemoryUsage();
+	bytesSaved += bytes;
+	m_stats.bytesSaved += bytes;
+	++m_stats.materialsShared;
+	m_shared[existing.get()] = existing;
+	return existing;
+}
+
+std::shared_ptr<Mesh> ContentStore::internMesh( std::uint64_t hash, const std::shared_ptr<Mesh> &mesh, const Scene &scene, std::size_t &bytesSaved )
+{
+	auto &entry = m_meshes[hash];
+	const auto existing = entry.mesh.lock();
+	if ( !existing )
+	{
+		entry.mesh = mesh;
+		entry.materials.clear();
+		for ( const auto &primitive : mesh->getPrimitives() )
+		{
+			entry.materials.push_back( scene.getMaterial( primitive.getMaterialHandle() ) );
+		}
+		return mesh;
+	}
+	if ( existing == mesh || existing->getPrimitiveCount() != mesh->getPrimitiveCount() )
+	{
+		return mesh;
+	}
+	for ( std::uint32_t i = 0; i < mesh->getPrimitiveCount(); ++i )
+	{
+		const auto &primitive = mesh->getPrimitive( i );
+		if ( entry.materials[i].lock() != scene.getMaterial( primitive.getMaterialHandle() ) || !samePrimitive( existing->getPrimitive( i ), primitive ) )
+		{
+			return mesh;
+		}
+	}
+	const std::size_t bytes = mesh->getMemoryUsage();
+	bytesSaved += bytes;
+	m_stats.bytesSaved += bytes;
+	m_stats.uploadBytesSaved += uploadBytes( *mesh );
+	++m_stats.meshesShared;
+	m_shared[existing.get()] = existing;
+	return existing;
+}
+
+void ContentStore::pruneIfGrown()
+{
+	if ( m_meshes.size() + m_materials.size() < m_pruneThreshold )
+	{
+		return;
+	}
+	std::erase_if( m_meshes, []( const auto &entry ) { return entry.second.mesh.expired(); } );
+	std::erase_if( m_materials, []( const auto &entry ) { return entry.second.expired(); } );
+	std::erase_if( m_shared, []( const auto &entry ) { return entry.second.expired(); } );
+	m_pruneThreshold = std::max( kMinPruneThreshold, 2 * ( m_meshes.size() + m_materials.size() ) );
+}
+
+bool ContentStore::isShared( const Asset &asset ) const
+{
+	std::lock_guard lock( m_mutex );
+	const auto it = m_shared.find( &asset );
+	return it != m_shared.end() && !it->second.expired();
+}
+
+ContentStoreStats ContentStore::getStats() const
+{
+	std::lock_guard lock( m_mutex );
+	ContentStoreStats stats = m_stats;
+	stats.meshCount = static_cast<std::size_t>( std::count_if( m_meshes.begin(), m_meshes.end(), []( const auto &entry ) { return !entry.second.mesh.expired(); } ) );
+	stats.materialCount = static_cast<std::size_t>( std::count_if( m_materials.begin(), m_materials.end(), []( const auto &entry ) { return !entry.second.expired(); } ) );
+	return stats;
+}
+
+void ContentStore::clear()
+{
+	std::lock_guard lock( m_mutex );
+	m_meshes.clear();
+	m_materials.clear();
+	m_shared.clear();
+	m_pruneThreshold = 0;
+	m_stats = {};
+}
+
+} // namespace assets
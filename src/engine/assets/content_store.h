@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/assets/assets.h"
+
+namespace assets
+{
+
+// Cumulative ContentStore activity plus its current contents
+struct ContentStoreStats
+{
+	std::uint64_t meshesShared = 0;		// Imported meshes replaced by an identical one already loaded
+	std::uint64_t materialsShared = 0;
+	std::uint64_t bytesSaved = 0;		// Asset::getMemoryUsage() of the replaced duplicates
+	std::uint64_t uploadBytesSaved = 0; // Vertex, index and LOD index bytes the GPU no longer receives twice
+	std::size_t meshCount = 0;			// Distinct live meshes and materials
+	std::size_t materialCount = 0;
+};
+
+// Content-addressed store of the meshes and materials of every loaded scene. internScene() swaps each
+// mesh or material of a newly loaded scene for an identical one another scene already uses, so kits that
+// embed the same props in many files keep one copy in memory; GPUResourceManager caches by asset, so the
+// shared mesh is also uploaded once. Assets are found by content hash and compared in full before being
+// shared. The store only holds weak references: unloading every scene that uses an asset still frees it.
+class ContentStore
+{
+public:
+	ContentStore() = default;
+
+	ContentStore( const ContentStore & ) = delete;
+	ContentStore &operator=( const ContentStore & ) = delete;
+
+	// Replace the scene's materials, then its meshes, with shared instances where identical ones are
+	// already stored, and store the rest. Meshes only match if their primitives use the same material
+	// handles and those resolve to the same shared materials. Returns the bytes saved.
+	std::size_t internScene( Scene &scene );
+
+	// Whether asset was handed to more than one scene, so patching it in place would change them all
+	bool isShared( const Asset &asset ) const;
+
+	ContentStoreStats getStats() const;
+	void clear();
+
+private:
+	struct MeshEntry
+	{
+		std::weak_ptr<Mesh> mesh;
+		std::vector<std::weak_ptr<Material>> materials; // Per primitive, as resolved by the first scene
+	};
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::uint64_t, std::weak_ptr<Material>> m_materials;
+	std::unordered_map<std::uint64_t, MeshEntry> m_meshes;
+	std::unordered_map<const Asset *, std::weak_ptr<const Asset>> m_shared; // Expired entries are stale addresses
+	std::size_t m_pruneThreshold = 0;
+	ContentStoreStats m_stats;
+
+	// Under m_mutex; return the instance scene should use
+	std::shared_ptr<Material> internMaterial( std::uint64_t hash, const std::shared_ptr<Material> &material, std::size_t &bytesSaved );
+	std::shared_ptr<Mesh> internMesh( std::uint64_t hash, const std::shared_ptr<Mesh> &mesh, const Scene &scene, std::size_t &bytesSaved );
+	// Drop entries whose assets were freed once the maps doubled since the last prune; under m_mutex
+	void pruneIfGrown();
+};
+
+} // namespace assets
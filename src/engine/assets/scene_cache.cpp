@@ -0,0 +1,551 @@
+#include "engine/assets/scene_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "runtime/console.h"
+#include "runtime/mapped_file.h"
+
+namespace assets
+{
+
+namespace
+{
+namespace fs = std::filesystem;
+
+// "SCNCOOK" plus a format byte; files are little-endian and only read on the platform that wrote them
+constexpr std::uint64_t kCookedMagic = 0x014B4F4F434E4353ull;
+
+// Vertex, index and LOD arrays start on this boundary so they can be used in place
+constexpr std::size_t kArrayAlignment = 16;
+
+// Node trees deeper than this are treated as malformed rather than risking the stack
+constexpr std::uint32_t kMaxNodeDepth = 1024;
+
+struct CookedHeader
+{
+	std::uint64_t magic = kCookedMagic;
+	std::uint32_t version = SceneCache::kVersion;
+	std::uint32_t headerSize = sizeof( CookedHeader );
+	std::uint64_t sourceKey = 0;
+	std::uint64_t importSettingsHash = 0;
+	std::uint64_t fileSize = 0;
+};
+
+class CookedWriter
+{
+public:
+	template <typename T>
+	void write( const T &value )
+	{
+		static_assert( std::is_trivially_copyable_v<T> );
+		const auto *bytes = reinterpret_cast<const std::byte *>( &value );
+		m_bytes.insert( m_bytes.end(), bytes, bytes + sizeof( T ) );
+	}
+
+	void writeString( const std::string &value )
+	{
+		write( static_cast<std::uint32_t>( value.size() ) );
+		const auto *bytes = reinterpret_cast<const std::byte *>( value.data() );
+		m_bytes.insert( m_bytes.end(), bytes, bytes + value.size() );
+	}
+
+	// Element count, padding to kArrayAlignment, then the elements
+	template <typename T>
+	void writeArray( std::span<const T> values )
+	{
+		static_assert( std::is_trivially_copyable_v<T> );
+		write( static_cast<std::uint64_t>( values.size() ) );
+		m_bytes.resize( ( m_bytes.size() + kArrayAlignment - 1 ) & ~( kArrayAlignment - 1 ), std::byte{ 0 } );
+		const auto bytes = std::as_bytes( values );
+		m_bytes.insert( m_bytes.end(), bytes.begin(), bytes.end() );
+	}
+
+	std::vector<std::byte> &bytes() noexcept { return m_bytes; }
+
+private:
+	std::vector<std::byte> m_bytes;
+};
+
+// Bounds-checked mirror of CookedWriter; after the first failed read every read fails and returns defaults
+class CookedReader
+{
+public:
+	explicit CookedReader( std::span<const std::uint8_t> bytes ) : m_bytes( bytes ) {}
+
+	bool ok() const noexcept { return m_ok; }
+	std::size_t remaining() const noexcept { return m_bytes.size() - m_offset; }
+
+	template <typename T>
+	T read()
+	{
+		static_assert( std::is_trivially_copyable_v<T> );
+		T value{};
+		if ( take( sizeof( T ) ) )
+		{
+			std::memcpy( &value, m_bytes.data() + m_offset - sizeof( T ), sizeof( T ) );
+		}
+		return value;
+	}
+
+	std::string readString()
+	{
+		const auto size = read<std::uint32_t>();
+		if ( !take( size ) )
+		{
+			return {};
+		}
+		return std::string( reinterpret_cast<const char *>( m_bytes.data() + m_offset - size ), size );
+	}
+
+	// The elements of an array written by writeArray(), as raw bytes in the mapped file
+	std::span<const std::byte> readArrayBytes( std::size_t elementSize )
+	{
+		const auto count = read<std::uint64_t>();
+		const std::size_t aligned = ( m_offset + kArrayAlignment - 1 ) & ~( kArrayAlignment - 1 );
+		if ( !m_ok || aligned > m_bytes.size() || count > ( m_bytes.size() - aligned ) / elementSize )
+		{
+			m_ok = false;
+			return {};
+		}
+		m_offset = aligned;
+		const std::size_t size = static_cast<std::size_t>( count ) * elementSize;
+		take( size );
+		return std::as_bytes( m_bytes.subspan( m_offset - size, size ) );
+	}
+
+	template <typename T>
+	std::vector<T> readArray()
+	{
+		static_assert( std::is_trivially_copyable_v<T> );
+		const auto bytes = readArrayBytes( sizeof( T ) );
+		std::vector<T> values( bytes.size() / sizeof( T ) );
+		if ( !bytes.empty() )
+		{
+			std::memcpy( values.data(), bytes.data(), bytes.size() );
+		}
+		return values;
+	}
+
+	// A count of items each taking at least one byte; larger counts cannot be genuine
+	std::uint32_t readCount()
+	{
+		const auto count = read<std::uint32_t>();
+		if ( count > remaining() )
+		{
+			m_ok = false;
+			return 0;
+		}
+		return count;
+	}
+
+	void fail() noexcept { m_ok = false; }
+
+private:
+	std::span<const std::uint8_t> m_bytes;
+	std::size_t m_offset = 0;
+	bool m_ok = true;
+
+	bool take( std::size_t size ) noexcept
+	{
+		if ( !m_ok || size > remaining() )
+		{
+			m_ok = false;
+			return false;
+		}
+		m_offset += size;
+		return true;
+	}
+};
+
+void writeMaterial( CookedWriter &writer, const Material &material )
+{
+	const auto &pbr = material.getPBRMaterial();
+	writer.writeString( material.getName() );
+	writer.write( pbr.baseColorFactor );
+	writer.write( pbr.metallicFactor );
+	writer.write( pbr.roughnessFactor );
+	writer.write( pbr.emissiveFactor );
+	writer.writeString( pbr.baseColorTexture );
+	writer.writeString( pbr.metallicRoughnessTexture );
+	writer.writeString( pbr.normalTexture );
+	writer.writeString( pbr.emissiveTexture );
+}
+
+std::shared_ptr<Material> readMaterial( CookedReader &reader )
+{
+	auto material = std::make_shared<Material>();
+	material->setName( reader.readString() );
+	auto &pbr = material->getPBRMaterial();
+	pbr.baseColorFactor = reader.read<math::Vec4f>();
+	pbr.metallicFactor = reader.read<float>();
+	pbr.roughnessFactor = reader.read<float>();
+	pbr.emissiveFactor = reader.read<math::Vec3f>();
+	pbr.baseColorTexture = reader.readString();
+	pbr.metallicRoughnessTexture = reader.readString();
+	pbr.normalTexture = reader.readString();
+	pbr.emissiveTexture = reader.readString();
+	return material;
+}
+
+void writePrimitive( CookedWriter &writer, const Primitive &primitive )
+{
+	const auto &layout = primitive.getVertexLayout();
+	writer.write( layout.attributes );
+	writer.write( static_cast<std::uint32_t>( layout.packed ) );
+	writer.write( primitive.getPositionQuantization() );
+	writer.write( primitive.getBounds() );
+	writer.write( static_cast<std::uint64_t>( primitive.getMaterialHandle() ) );
+	writer.writeArray( primitive.getVertexData() );
+	writer.writeArray( std::span<const std::uint32_t>( primitive.getIndices() ) );
+	writer.write( static_cast<std::uint32_t>( primitive.getLods().size() ) );
+	for ( const auto &lod : primitive.getLods() )
+	{
+		writer.write( lod.error );
+		writer.writeArray( std::span<const std::uint32_t>( lod.indices ) );
+	}
+}
+
+bool readPrimitive( CookedReader &reader, Primitive &primitive )
+{
+	VertexLayout layout;
+	layout.attributes = reader.read<std::uint32_t>();
+	layout.packed = reader.read<std::uint32_t>() != 0;
+	const auto quantization = reader.read<PositionQuantization>();
+	const auto bounds = reader.read<math::BoundingBox3Df>();
+	const auto materialHandle = reader.read<std::uint64_t>();
+	if ( ( layout.attributes & ~kAllVertexAttributes ) != 0 || !layout.has( VertexAttribute::Position ) )
+	{
+		reader.fail();
+		return false;
+	}
+
+	const auto vertexData = reader.readArrayBytes( 1 );
+	if ( vertexData.size() % layout.getStride() != 0 )
+	{
+		reader.fail();
+		return false;
+	}
+	primitive.setVertexData( vertexData, layout, quantization, bounds );
+	primitive.setMaterialHandle( static_cast<MaterialHandle>( materialHandle ) );
+
+	auto indices = reader.readArray<std::uint32_t>();
+	const std::uint32_t lodCount = reader.readCount();
+	std::vector<PrimitiveLod> lods( lodCount );
+	for ( auto &lod : lods )
+	{
+		lod.error = reader.read<float>();
+		lod.indices = reader.readArray<std::uint32_t>();
+	}
+	if ( !reader.ok() )
+	{
+		return false;
+	}
+
+	// Indices outside the vertex array would reach the GPU unchecked
+	const std::uint32_t vertexCount = primitive.getVertexCount();
+	const auto inRange = [vertexCount]( const std::vector<std::uint32_t> &list ) {
+		return std::all_of( list.begin(), list.end(), [vertexCount]( std::uint32_t index ) { return index < vertexCount; } );
+	};
+	if ( !inRange( indices ) || !std::all_of( lods.begin(), lods.end(), [&]( const PrimitiveLod &lod ) { return inRange( lod.indices ); } ) )
+	{
+		reader.fail();
+		return false;
+	}
+
+	primitive.setIndices( std::move( indices ) );
+	for ( auto &lod : lods )
+	{
+		primitive.addLod( std::move( lod ) );
+	}
+	return true;
+}
+
+void writeNode( CookedWriter &writer, const SceneNode &node )
+{
+	writer.writeString( node.getName() );
+	writer.write( static_cast<std::uint32_t>( node.hasTransform() ) );
+	writer.write( node.getTransform() );
+	writer.write( static_cast<std::uint32_t>( node.meshCount() ) );
+	for ( const MeshHandle handle : node.getMeshHandles() )
+	{
+		writer.write( static_cast<std::uint64_t>( handle ) );
+	}
+	writer.write( static_cast<std::uint32_t>( node.getChildCount() ) );
+	node.foreachChild( [&writer]( const SceneNode &child ) { writeNode( writer, child ); } );
+}
+
+std::unique_ptr<SceneNode> readNode( CookedReader &reader, std::size_t meshCount, std::uint32_t depth )
+{
+	if ( depth > kMaxNodeDepth )
+	{
+		reader.fail();
+		return nullptr;
+	}
+
+	auto node = std::make_unique<SceneNode>( reader.readString() );
+	const bool hasTransform = reader.read<std::uint32_t>() != 0;
+	const auto transform = reader.read<Transform>();
+	if ( hasTransform )
+	{
+		node->setTransform( transform );
+	}
+	const std::uint32_t handleCount = reader.readCount();
+	for ( std::uint32_t i = 0; i < handleCount; ++i )
+	{
+		const auto handle = reader.read<std::uint64_t>();
+		if ( handle >= meshCount )
+		{
+			reader.fail();
+			return nullptr;
+		}
+		node->addMeshHandle( static_cast<MeshHandle>( handle ) );
+	}
+	const std::uint32_t childCount = reader.readCount();
+	for ( std::uint32_t i = 0; i < childCount && reader.ok(); ++i )
+	{
+		node->addChild( readNode( reader, meshCount, depth + 1 ) );
+	}
+	return reader.ok() ? std::move( node ) : nullptr;
+}
+
+// Dependencies are stored relative to the source's directory, so identical sources in different
+// directories check their own neighbouring files
+std::string toStoredPath( const std::string &dependency, const std::string &sourcePath )
+{
+	const fs::path base = fs::path( sourcePath ).parent_path();
+	fs::path stored = base.empty() ? fs::path( dependency ) : fs::path( dependency ).lexically_relative( base );
+	if ( stored.empty() )
+	{
+		stored = dependency;
+	}
+	return stored.generic_string();
+}
+
+std::string resolveStoredPath( const std::string &stored, const std::string &sourcePath )
+{
+	const fs::path base = fs::path( sourcePath ).parent_path();
+	const fs::path path( stored );
+	return ( path.is_absolute() || base.empty() ? path : base / path ).lexically_normal().generic_string();
+}
+
+std::string toHex( std::uint64_t value )
+{
+	constexpr char kDigits[] = "0123456789abcdef";
+	std::string hex( 16, '0' );
+	for ( std::size_t i = 0; i < 16; ++i )
+	{
+		hex[15 - i] = kDigits[( value >> ( i * 4 ) ) & 0xf];
+	}
+	return hex;
+}
+} // namespace
+
+SceneCache::SceneCache( std::string directory, std::uint64_t importSettingsHash )
+	: m_directory( std::move( directory ) ), m_importSettingsHash( importSettingsHash )
+{
+}
+
+bool SceneCache::hashFile( const std::string &path, std::uint64_t &size, std::uint64_t &hash )
+{
+	runtime::MappedFile file;
+	if ( !file.open( path ) )
+	{
+		return false;
+	}
+	size = file.size();
+	hash = hashContent( file.bytes(), m_importSettingsHash );
+	std::lock_guard lock( m_statsMutex );
+	m_stats.sourceBytesHashed += file.size();
+	return true;
+}
+
+std::string SceneCache::cookedPathForKey( std::uint64_t key ) const
+{
+	return ( fs::path( m_directory ) / ( toHex( key ) + ".scene" ) ).generic_string();
+}
+
+std::string SceneCache::getCookedPath( const std::string &sourcePath )
+{
+	std::uint64_t size = 0;
+	std::uint64_t key = 0;
+	return hashFile( sourcePath, size, key ) ? cookedPathForKey( key ) : std::string{};
+}
+
+std::shared_ptr<Scene> SceneCache::load( const std::string &sourcePath )
+{
+	std::uint64_t sourceSize = 0;
+	std::uint64_t key = 0;
+	runtime::MappedFile cooked;
+	if ( !hashFile( sourcePath, sourceSize, key ) || !cooked.open( cookedPathForKey( key ) ) )
+	{
+		std::lock_guard lock( m_statsMutex );
+		++m_stats.misses;
+		return nullptr;
+	}
+
+	const auto reject = [this]() -> std::shared_ptr<Scene> {
+		std::lock_guard lock( m_statsMutex );
+		++m_stats.rejected;
+		++m_stats.misses;
+		return nullptr;
+	};
+
+	CookedReader reader( cooked.bytes() );
+	const auto header = reader.read<CookedHeader>();
+	if ( !reader.ok() || header.magic != kCookedMagic || header.version != kVersion || header.headerSize != sizeof( CookedHeader ) ||
+		header.sourceKey != key || header.importSettingsHash != m_importSettingsHash || header.fileSize != cooked.size() )
+	{
+		return reject();
+	}
+
+	// Every other file the import read must be unchanged
+	auto scene = std::make_shared<Scene>();
+	const std::uint32_t dependencyCount = reader.readCount();
+	for ( std::uint32_t i = 0; i < dependencyCount; ++i )
+	{
+		const auto path = resolveStoredPath( reader.readString(), sourcePath );
+		const auto expectedSize = reader.read<std::uint64_t>();
+		const auto expectedHash = reader.read<std::uint64_t>();
+		std::uint64_t size = 0;
+		std::uint64_t hash = 0;
+		if ( !reader.ok() || !hashFile( path, size, hash ) || size != expectedSize || hash != expectedHash )
+		{
+			return reject();
+		}
+		scene->addSourceFile( path );
+	}
+
+	const std::uint32_t materialCount = reader.readCount();
+	for ( std::uint32_t i = 0; i < materialCount && reader.ok(); ++i )
+	{
+		scene->addMaterial( readMaterial( reader ) );
+	}
+
+	const std::uint32_t meshCount = reader.readCount();
+	for ( std::uint32_t i = 0; i < meshCount && reader.ok(); ++i )
+	{
+		auto mesh = std::make_shared<Mesh>();
+		mesh->setSourceHash( reader.read<std::uint64_t>() );
+		const std::uint32_t primitiveCount = reader.readCount();
+		for ( std::uint32_t j = 0; j < primitiveCount && reader.ok(); ++j )
+		{
+			Primitive primitive;
+			if ( readPrimitive( reader, primitive ) )
+			{
+				mesh->addPrimitive( std::move( primitive ) );
+			}
+		}
+		scene->addMesh( std::move( mesh ) );
+	}
+
+	const std::uint32_t rootCount = reader.readCount();
+	for ( std::uint32_t i = 0; i < rootCount && reader.ok(); ++i )
+	{
+		scene->addRootNode( readNode( reader, meshCount, 0 ) );
+	}
+	if ( !reader.ok() || reader.remaining() != 0 )
+	{
+		return reject();
+	}
+
+	std::lock_guard lock( m_statsMutex );
+	++m_stats.hits;
+	m_stats.bytesRead += cooked.size();
+	return scene;
+}
+
+bool SceneCache::store( const std::string &sourcePath, const Scene &scene )
+{
+	CookedHeader header;
+	std::uint64_t sourceSize = 0;
+	if ( !hashFile( sourcePath, sourceSize, header.sourceKey ) )
+	{
+		console::warning( "SceneCache: Cannot read source {}", sourcePath );
+		return false;
+	}
+	header.importSettingsHash = m_importSettingsHash;
+
+	CookedWriter writer;
+	writer.write( header );
+
+	writer.write( static_cast<std::uint32_t>( scene.getSourceFiles().size() ) );
+	for ( const auto &dependency : scene.getSourceFiles() )
+	{
+		std::uint64_t size = 0;
+		std::uint64_t hash = 0;
+		if ( !hashFile( dependency, size, hash ) )
+		{
+			console::warning( "SceneCache: Cannot read {}, the import of {} is not cached", dependency, sourcePath );
+			return false;
+		}
+		writer.writeString( toStoredPath( dependency, sourcePath ) );
+		writer.write( size );
+		writer.write( hash );
+	}
+
+	writer.write( static_cast<std::uint32_t>( scene.getMaterialCount() ) );
+	for ( const auto &material : scene.getMaterials() )
+	{
+		writeMaterial( writer, *material );
+	}
+
+	writer.write( static_cast<std::uint32_t>( scene.getMeshCount() ) );
+	for ( const auto &mesh : scene.getMeshes() )
+	{
+		writer.write( mesh->getSourceHash() );
+		writer.write( mesh->getPrimitiveCount() );
+		for ( const auto &primitive : mesh->getPrimitives() )
+		{
+			writePrimitive( writer, primitive );
+		}
+	}
+
+	writer.write( static_cast<std::uint32_t>( scene.getRootNodes().size() ) );
+	for ( const auto &node : scene.getRootNodes() )
+	{
+		writeNode( writer, *node );
+	}
+
+	auto &bytes = writer.bytes();
+	header.fileSize = bytes.size();
+	std::memcpy( bytes.data(), &header, sizeof( header ) );
+
+	// Unique per thread, so concurrent stores of the same scene do not write the same temporary file
+	const std::string cookedPath = cookedPathForKey( header.sourceKey );
+	const std::string temporaryPath = cookedPath + "." + toHex( std::hash<std::thread::id>{}( std::this_thread::get_id() ) ) + ".tmp";
+	std::error_code error;
+	fs::create_directories( m_directory, error );
+	{
+		std::ofstream file( temporaryPath, std::ios::binary | std::ios::trunc );
+		file.write( reinterpret_cast<const char *>( bytes.data() ), static_cast<std::streamsize>( bytes.size() ) );
+		if ( !file )
+		{
+			console::warning( "SceneCache: Failed to write {}", temporaryPath );
+			file.close();
+			fs::remove( temporaryPath, error );
+			return false;
+		}
+	}
+	fs::rename( temporaryPath, cookedPath, error );
+	if ( error )
+	{
+		// Typically another process holds the existing file open; it stays valid for this key
+		console::warning( "SceneCache: Failed to replace {}: {}", cookedPath, error.message() );
+		fs::remove( temporaryPath, error );
+		return false;
+	}
+
+	std::lock_guard lock( m_statsMutex );
+	++m_stats.stores;
+	m_stats.bytesWritten += bytes.size();
+	return true;
+}
+
+} // namespace assets
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "engine/assets/assets.h"
+#include "engine/assets/content_hash.h"
+
+namespace assets
+{
+
+// Cumulative SceneCache activity
+struct SceneCacheStats
+{
+	std::uint32_t hits = 0;
+	std::uint32_t misses = 0;		   // Includes rejected files
+	std::uint32_t rejected = 0;		   // Cooked file found but stale, from another version or malformed
+	std::uint32_t stores = 0;
+	std::uint64_t bytesRead = 0;	   // Cooked bytes mapped by hits
+	std::uint64_t bytesWritten = 0;	   // Cooked bytes written by stores
+	std::uint64_t sourceBytesHashed = 0; // Source and dependency bytes hashed to build and check keys
+};
+
+// Cooked binary copies of imported scenes: materials, meshes with their primitives, LODs and bounds, and
+// the node tree. A cooked file is named by a hash of the source file's contents and the import settings,
+// and lists the other files the import read (Scene::getSourceFiles()) with their hashes, so an edit to any
+// of them or a settings change is a miss rather than a stale hit. Hits map the file and copy its aligned
+// arrays straight into the scene; nothing is parsed. Safe to share between loader threads.
+class SceneCache
+{
+public:
+	// Cooked files of other revisions are ignored
+	static constexpr std::uint32_t kVersion = 2;
+
+	// importSettingsHash identifies the importer configuration that produced the cooked scenes
+	explicit SceneCache( std::string directory, std::uint64_t importSettingsHash = 0 );
+
+	SceneCache( const SceneCache & ) = delete;
+	SceneCache &operator=( const SceneCache & ) = delete;
+
+	// The cooked scene for sourcePath as it is now, or null on a miss
+	std::shared_ptr<Scene> load( const std::string &sourcePath );
+
+	// Cook scene as the import of sourcePath. Written to a temporary file and renamed into place, so a
+	// concurrent or interrupted writer never leaves a partial file behind.
+	bool store( const std::string &sourcePath, const Scene &scene );
+
+	// Cooked file for sourcePath in its current state; empty if the source cannot be read
+	std::string getCookedPath( const std::string &sourcePath );
+
+	const std::string &getDirectory() const noexcept { return m_directory; }
+	std::uint64_t getImportSettingsHash() const noexcept { return m_importSettingsHash; }
+
+	SceneCacheStats getStats() const
+	{
+		std::lock_guard lock( m_statsMutex );
+		return m_stats;
+	}
+	void resetStats()
+	{
+		std::lock_guard lock( m_statsMutex );
+		m_stats = {};
+	}
+
+private:
+	std::string m_directory;
+	std::uint64_t m_importSettingsHash;
+	SceneCacheStats m_stats;
+	mutable std::mutex m_statsMutex;
+
+	// Hash of a whole file seeded with the settings; false if it cannot be mapped
+	bool hashFile( const std::string &path, std::uint64_t &size, std::uint64_t &hash );
+	std::string cookedPathForKey( std::uint64_t key ) const;
+};
+
+} // namespace assets
@@ -0,0 +1,144 @@
+#include "engine/assets/scene_reload.h"
+
+#include <algorithm>
+
+#include "engine/assets/content_hash.h"
+#include "engine/assets/content_store.h"
+
+namespace assets
+{
+
+namespace
+{
+
+bool sameTransform( const Transform &a, const Transform &b )
+{
+	return a.position == b.position && a.rotation == b.rotation && a.scale == b.scale;
+}
+
+bool sameNodes( const SceneNode &a, const SceneNode &b )
+{
+	if ( a.getName() != b.getName() || a.hasTransform() != b.hasTransform() || !sameTransform( a.getTransform(), b.getTransform() ) ||
+		a.getMeshHandles() != b.getMeshHandles() || a.getChildCount() != b.getChildCount() )
+	{
+		return false;
+	}
+	for ( std::size_t i = 0; i < a.getChildCount(); ++i )
+	{
+		if ( !sameNodes( a.getChild( i ), b.getChild( i ) ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool sameStructure( const Scene &a, const Scene &b )
+{
+	if ( a.getMeshCount() != b.getMeshCount() || a.getMaterialCount() != b.getMaterialCount() || a.getRootNodes().size() != b.getRootNodes().size() )
+	{
+		return false;
+	}
+	for ( std::size_t i = 0; i < a.getRootNodes().size(); ++i )
+	{
+		if ( !sameNodes( *a.getRootNodes()[i], *b.getRootNodes()[i] ) )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool sameMesh( const Mesh &current, const Mesh &reloaded )
+{
+	if ( &current == &reloaded || ( current.getSourceHash() != 0 && current.getSourceHash() == reloaded.getSourceHash() ) )
+	{
+		return true;
+	}
+	return current.getPrimitiveCount() == reloaded.getPrimitiveCount() && hashMesh( current ) == hashMesh( reloaded );
+}
+
+} // namespace
+
+SceneReload patchScene( const std::shared_ptr<Scene> &scene, const Scene &reloaded, const ContentStore *contentStore )
+{
+	SceneReload result;
+	result.scene = scene;
+	if ( !scene )
+	{
+		return result;
+	}
+	result.path = scene->getPath();
+	if ( !sameStructure( *scene, reloaded ) )
+	{
+		result.structureChanged = true;
+		return result;
+	}
+
+	const auto isShared = [contentStore]( const Asset &asset ) { return contentStore && contentStore->isShared( asset ); };
+
+	// Materials first: meshes bound to a detached material must be rebound to the copy
+	for ( MaterialHandle handle = 0; handle < scene->getMaterialCount(); ++handle )
+	{
+		auto current = scene->getMaterial( handle );
+		const auto source = reloaded.getMaterial( handle );
+		const bool changed = current != source && hashMaterial( *current ) != hashMaterial( *source );
+		if ( changed && isShared( *current ) )
+		{
+			current = std::make_shared<Material>( *current );
+			scene->setMaterial( handle, current );
+			result.detachedMaterials.push_back( handle );
+		}
+		else if ( changed )
+		{
+			result.changedMaterials.push_back( handle );
+		}
+		if ( changed )
+		{
+			current->getPBRMaterial() = source->getPBRMaterial();
+		}
+		// Names are not part of the content; a shared material keeps the one it was first loaded with
+		if ( !isShared( *current ) )
+		{
+			current->setName( source->getName() );
+		}
+	}
+
+	const auto usesDetachedMaterial = [&result]( const Mesh &mesh ) {
+		return std::ranges::any_of( mesh.getPrimitives(), [&result]( const Primitive &primitive ) {
+			return std::ranges::find( result.detachedMaterials, primitive.getMaterialHandle() ) != result.detachedMaterials.end();
+		} );
+	};
+
+	for ( MeshHandle handle = 0; handle < scene->getMeshCount(); ++handle )
+	{
+		auto current = scene->getMesh( handle );
+		const auto source = reloaded.getMesh( handle );
+		const bool changed = !sameMesh( *current, *source );
+		const bool rebind = usesDetachedMaterial( *current );
+		if ( ( changed || rebind ) && isShared( *current ) )
+		{
+			current = std::make_shared<Mesh>( *current );
+			scene->setMesh( handle, current );
+			result.detachedMeshes.push_back( handle );
+		}
+		else if ( changed || rebind )
+		{
+			result.changedMeshes.push_back( handle );
+		}
+		if ( changed )
+		{
+			// Copied, not moved: the reloaded scene may share meshes with this one
+			current->getPrimitives() = source->getPrimitives();
+			current->recalculateBounds();
+		}
+		// Identical content under a new source hash (e.g. the file was only re-saved); keep it for the next reload
+		if ( changed || !isShared( *current ) )
+		{
+			current->setSourceHash( source->getSourceHash() );
+		}
+	}
+	return result;
+}
+
+} // namespace assets
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/assets/assets.h"
+
+namespace assets
+{
+
+class ContentStore;
+
+// Outcome of re-importing a loaded scene after its source files changed. Changed meshes and materials are
+// patched in place, so everything holding them (ECS components, GPU caches, the asset cache) keeps the same
+// objects; only their contents are new.
+struct SceneReload
+{
+	std::string path;
+	std::shared_ptr<Scene> scene; // The loaded scene, now patched; null if the re-import failed
+	std::vector<MeshHandle> changedMeshes;
+	std::vector<MaterialHandle> changedMaterials;
+	// Changed while shared with other scenes through a ContentStore: the scene now holds a private, patched
+	// copy and the shared instance is left to the others. Meshes using a detached material are detached too
+	// when shared, or listed in changedMeshes otherwise, so they can be bound to the copy.
+	std::vector<MeshHandle> detachedMeshes;
+	std::vector<MaterialHandle> detachedMaterials;
+	// Mesh or material count, or the node tree (names, transforms, mesh references) differs. Nothing was
+	// patched, since entities would have to be created or removed; a full re-import picks the change up.
+	bool structureChanged = false;
+};
+
+// Patch scene with the meshes and materials of reloaded, its re-import, whose content differs. Meshes are
+// compared by source hash first and content hash (hashMesh()) only when those differ, so unchanged meshes
+// shared with or cooked from the previous import cost nothing. Meshes and materials contentStore shares with
+// other scenes are copied on write rather than patched, so the other scenes keep what they loaded.
+SceneReload patchScene( const std::shared_ptr<Scene> &scene, const Scene &reloaded, const ContentStore *contentStore = nullptr );
+
+} // namespace assets
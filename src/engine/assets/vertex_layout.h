@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+
+// Describes how a primitive stores its vertices: which attributes are present and whether they use the
+// float or the packed encodings of vertex_packing.h. Header-only so the render core can build input
+// layouts and pipeline keys without linking the engine.
+namespace assets
+{
+
+// Attribute bits in interleaving order; the position is always stored
+enum class VertexAttribute : std::uint32_t
+{
+	Position = 1u << 0,
+	Normal = 1u << 1,
+	TexCoord = 1u << 2,
+	Tangent = 1u << 3,
+	Color = 1u << 4,
+};
+
+inline constexpr std::uint32_t kVertexAttributeCount = 5;
+inline constexpr std::uint32_t kAllVertexAttributes = ( 1u << kVertexAttributeCount ) - 1;
+
+// Set in getKey() for packed layouts; unlit.hlsl tests the same bit
+inline constexpr std::uint32_t kPackedVertexLayoutBit = 1u << 8;
+
+// Present attributes are interleaved in VertexAttribute order. The float encodings match assets::Vertex, so
+// the default layout is byte-compatible with it. Packed encodings (8 + 4 + 4 + 4 + 4 bytes):
+//   position  snorm16x4 against the primitive's PositionQuantization; w carries the tangent sign
+//   normal    octahedral snorm16x2
+//   texCoord  half2
+//   tangent   octahedral snorm16x2
+//   color     unorm8x4
+struct VertexLayout
+{
+	std::uint32_t attributes = kAllVertexAttributes;
+	bool packed = false;
+
+	constexpr bool has( VertexAttribute attribute ) const noexcept { return ( attributes & static_cast<std::uint32_t>( attribute ) ) != 0; }
+
+	// Every attribute in float: the assets::Vertex array itself
+	constexpr bool isStandard() const noexcept { return attributes == kAllVertexAttributes && !packed; }
+
+	static constexpr std::uint32_t getAttributeSize( VertexAttribute attribute, bool packed ) noexcept
+	{
+		switch ( attribute )
+		{
+		case VertexAttribute::Position:
+			return packed ? 8 : 12;
+		case VertexAttribute::Normal:
+			return packed ? 4 : 12;
+		case VertexAttribute::TexCoord:
+			return packed ? 4 : 8;
+		case VertexAttribute::Tangent:
+			return packed ? 4 : 16;
+		case VertexAttribute::Color:
+			return packed ? 4 : 16;
+		}
+		return 0;
+	}
+
+	// Byte offset of an attribute within a vertex; for an absent attribute, where it would start
+	constexpr std::uint32_t getOffset( VertexAttribute attribute ) const noexcept
+	{
+		std::uint32_t offset = 0;
+		for ( std::uint32_t bit = 1; bit < static_cast<std::uint32_t>( attribute ); bit <<= 1 )
+		{
+			if ( attributes & bit )
+			{
+				offset += getAttributeSize( static_cast<VertexAttribute>( bit ), packed );
+			}
+		}
+		return offset;
+	}
+
+	constexpr std::uint32_t getStride() const noexcept { return getOffset( static_cast<VertexAttribute>( 1u << kVertexAttributeCount ) ); }
+
+	// 0 for the standard layout, otherwise the attribute bits plus kPackedVertexLayoutBit; keys pipelines
+	constexpr std::uint32_t getKey() const noexcept
+	{
+		return isStandard() ? 0 : attributes | ( packed ? kPackedVertexLayoutBit : 0 );
+	}
+
+	constexpr bool operator==( const VertexLayout & ) const = default;
+};
+
+static_assert( VertexLayout{}.getStride() == 64 );
+static_assert( VertexLayout{ kAllVertexAttributes, true }.getStride() == 24 );
+
+} // namespace assets
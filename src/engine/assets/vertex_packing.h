@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+#include "math/bounding_box_3d.h"
+#include "math/vec.h"
+
+// Encodings of the compact vertex format: signed 16-bit positions normalised to the primitive's bounds,
+// octahedral unit vectors, half-float texture coordinates and 8-bit colours. All codecs are scalar and
+// header-only so tools and the headless render core can decode without linking the engine.
+namespace assets
+{
+
+// Maps snorm16 positions onto the primitive's bounds: position = offset + ( q / 32767 ) * scale. This is the
+// same decode a GPU performs for an R16G16B16A16_SNORM attribute followed by a multiply-add.
+struct PositionQuantization
+{
+	math::Vec3f offset = { 0.0f, 0.0f, 0.0f };
+	math::Vec3f scale = { 1.0f, 1.0f, 1.0f };
+
+	// Centre and half extent of the bounds; flat axes get scale 1 so they still round-trip
+	static PositionQuantization fromBounds( const math::BoundingBox3Df &bounds ) noexcept
+	{
+		if ( !bounds.isValid() )
+		{
+			return {};
+		}
+		const auto halfExtent = ( bounds.max - bounds.min ) * 0.5f;
+		return { ( bounds.min + bounds.max ) * 0.5f,
+			{ halfExtent.x > 0.0f ? halfExtent.x : 1.0f, halfExtent.y > 0.0f ? halfExtent.y : 1.0f, halfExtent.z > 0.0f ? halfExtent.z : 1.0f } };
+	}
+};
+
+inline std::int16_t encodeSnorm16( float value ) noexcept
+{
+	return static_cast<std::int16_t>( std::lround( std::clamp( value, -1.0f, 1.0f ) * 32767.0f ) );
+}
+
+inline float decodeSnorm16( std::int16_t value ) noexcept
+{
+	return std::max( static_cast<float>( value ) / 32767.0f, -1.0f );
+}
+
+inline std::uint8_t encodeUnorm8( float value ) noexcept
+{
+	return static_cast<std::uint8_t>( std::lround( std::clamp( value, 0.0f, 1.0f ) * 255.0f ) );
+}
+
+inline float decodeUnorm8( std::uint8_t value ) noexcept
+{
+	return static_cast<float>( value ) / 255.0f;
+}
+
+inline void quantizePosition( const math::Vec3f &position, const PositionQuantization &quantization, std::int16_t out[3] ) noexcept
+{
+	out[0] = encodeSnorm16( ( position.x - quantization.offset.x ) / quantization.scale.x );
+	out[1] = encodeSnorm16( ( position.y - quantization.offset.y ) / quantization.scale.y );
+	out[2] = encodeSnorm16( ( position.z - quantization.offset.z ) / quantization.scale.z );
+}
+
+inline math::Vec3f dequantizePosition( const std::int16_t in[3], const PositionQuantization &quantization ) noexcept
+{
+	return { quantization.offset.x + decodeSnorm16( in[0] ) * quantization.scale.x,
+		quantization.offset.y + decodeSnorm16( in[1] ) * quantization.scale.y,
+		quantization.offset.z + decodeSnorm16( in[2] ) * quantization.scale.z };
+}
+
+// Unit vector projected onto the octahedron and unfolded into [-1, 1]^2; a zero vector encodes as +Z
+inline void encodeOctahedral( const math::Vec3f &direction, std::int16_t out[2] ) noexcept
+{
+	const float length = std::abs( direction.x ) + std::abs( direction.y ) + std::abs( direction.z );
+	if ( length == 0.0f )
+	{
+		out[0] = 0;
+		out[1] = 0;
+		return;
+	}
+	float u = direction.x / length;
+	float v = direction.y / length;
+	if ( direction.z < 0.0f )
+	{
+		const float foldedU = ( 1.0f - std::abs( v ) ) * ( u >= 0.0f ? 1.0f : -1.0f );
+		const float foldedV = ( 1.0f - std::abs( u ) ) * ( v >= 0.0f ? 1.0f : -1.0f );
+		u = foldedU;
+		v = foldedV;
+	}
+	out[0] = encodeSnorm16( u );
+	out[1] = encodeSnorm16( v );
+}
+
+inline math::Vec3f decodeOctahedral( const std::int16_t in[2] ) noexcept
+{
+	float u = decodeSnorm16( in[0] );
+	float v = decodeSnorm16( in[1] );
+	const float z = 1.0f - std::abs( u ) - std::abs( v );
+	const float fold = std::max( -z, 0.0f );
+	u += u >= 0.0f ? -fold : fold;
+	v += v >= 0.0f ? -fold : fold;
+	const float length = std::sqrt( u * u + v * v + z * z );
+	return { u / length, v / length, z / length };
+}
+
+// IEEE 754 binary16, round to nearest even; out-of-range values become infinity
+inline std::uint16_t floatToHalf( float value ) noexcept
+{
+	const std::uint32_t bits = std::bit_cast<std::uint32_t>( value );
+	const auto sign = static_cast<std::uint16_t>( ( bits >> 16 ) & 0x8000u );
+	const std::uint32_t magnitude = bits & 0x7fffffffu;
+	if ( magnitude > 0x7f800000u )
+	{
+		return static_cast<std::uint16_t>( sign | 0x7e00u ); // NaN
+	}
+	if ( magnitude >= 0x477ff000u )
+	{
+		return static_cast<std::uint16_t>( sign | 0x7c00u ); // Rounds past 65504
+	}
+	if ( magnitude < 0x38800000u )
+	{
+		// Subnormal: the mantissa counts units of 2^-24, rounded by the FPU
+		return static_cast<std::uint16_t>( sign | static_cast<std::uint16_t>( std::nearbyint( std::bit_cast<float>( magnitude ) * 16777216.0f ) ) );
+	}
+	const std::uint32_t rounded = magnitude + 0xfffu + ( ( magnitude >> 13 ) & 1u );
+	return static_cast<std::uint16_t>( sign | ( ( rounded - 0x38000000u ) >> 13 ) );
+}
+
+inline float halfToFloat( std::uint16_t half ) noexcept
+{
+	const std::uint32_t sign = std::uint32_t( half & 0x8000u ) << 16;
+	const std::uint32_t exponent = ( half >> 10 ) & 0x1fu;
+	const std::uint32_t mantissa = half & 0x3ffu;
+	if ( exponent == 0 )
+	{
+		const float subnormal = static_cast<float>( mantissa ) / 16777216.0f;
+		return sign ? -subnormal : subnormal;
+	}
+	if ( exponent == 31 )
+	{
+		return std::bit_cast<float>( sign | 0x7f800000u | ( mantissa << 13 ) );
+	}
+	return std::bit_cast<float>( sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 ) );
+}
+
+} // namespace assets
@@ -0,0 +1,217 @@
+#include "engine/culling/frustum_culling.h"
+
+#include <cmath>
+#include <limits>
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#define ENGINE_CULLING_SSE 1
+#endif
+
+namespace engine::culling
+{
+
+namespace
+{
+// Per-plane data with the stream selection for the positive vertex (the corner farthest along the normal)
+struct PlaneStreams
+{
+	float nx, ny, nz, d;
+	const float *px;
+	const float *py;
+	const float *pz;
+};
+
+void setupPlaneStreams( const math::Frustum<float> &frustum, const BoundsSoA &bounds, PlaneStreams ( &out )[6] ) noexcept
+{
+	for ( int i = 0; i < 6; ++i )
+	{
+		const auto &plane = frustum.planes[i];
+		out[i].nx = plane.normal.x;
+		out[i].ny = plane.normal.y;
+		out[i].nz = plane.normal.z;
+		out[i].d = plane.distance;
+		out[i].px = plane.normal.x >= 0.0f ? bounds.maxX() : bounds.minX();
+		out[i].py = plane.normal.y >= 0.0f ? bounds.maxY() : bounds.minY();
+		out[i].pz = plane.normal.z >= 0.0f ? bounds.maxZ() : bounds.minZ();
+	}
+}
+
+bool isBoxVisible( const PlaneStreams ( &planes )[6], std::uint32_t index ) noexcept
+{
+	for ( const auto &plane : planes )
+	{
+		const float distance = plane.nx * plane.px[index] + plane.ny * plane.py[index] + plane.nz * plane.pz[index] - plane.d;
+		if ( distance < 0.0f )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void cullScalarRange( const PlaneStreams ( &planes )[6], std::uint32_t begin, std::uint32_t end, std::vector<std::uint32_t> &visibleIndices )
+{
+	for ( std::uint32_t i = begin; i < end; ++i )
+	{
+		if ( isBoxVisible( planes, i ) )
+		{
+			visibleIndices.push_back( i );
+		}
+	}
+}
+
+#if defined( ENGINE_CULLING_SSE )
+// Returns a 4-bit mask of the boxes in [index, index + 4) that are inside or intersecting all planes
+int cullFourSSE( const PlaneStreams ( &planes )[6], std::uint32_t index ) noexcept
+{
+	__m128 inside = _mm_castsi128_ps( _mm_set1_epi32( -1 ) );
+	const __m128 zero = _mm_setzero_ps();
+	for ( const auto &plane : planes )
+	{
+		const __m128 px = _mm_loadu_ps( plane.px + index );
+		const __m128 py = _mm_loadu_ps( plane.py + index );
+		const __m128 pz = _mm_loadu_ps( plane.pz + index );
+
+		__m128 distance = _mm_mul_ps( _mm_set1_ps( plane.nx ), px );
+		distance = _mm_add_ps( distance, _mm_mul_ps( _mm_set1_ps( plane.ny ), py ) );
+		distance = _mm_add_ps( distance, _mm_mul_ps( _mm_set1_ps( plane.nz ), pz ) );
+		distance = _mm_sub_ps( distance, _mm_set1_ps( plane.d ) );
+
+		inside = _mm_and_ps( inside, _mm_cmpge_ps( distance, zero ) );
+	}
+	return _mm_movemask_ps( inside );
+}
+#endif
+} // anonymous namespace
+
+math::BoundingBox3Df transformBounds( const math::BoundingBox3Df &localBounds, const math::Mat4f &worldMatrix ) noexcept
+{
+	if ( !localBounds.isValid() )
+	{
+		return localBounds;
+	}
+
+	// Start from the translation and accumulate the contribution of each basis axis
+	math::BoundingBox3Df result( math::Vec3f{ worldMatrix.row0.w, worldMatrix.row1.w, worldMatrix.row2.w },
+		math::Vec3f{ worldMatrix.row0.w, worldMatrix.row1.w, worldMatrix.row2.w } );
+
+	const math::Vec4f *rows[3] = { &worldMatrix.row0, &worldMatrix.row1, &worldMatrix.row2 };
+	float *resultMin[3] = { &result.min.x, &result.min.y, &result.min.z };
+	float *resultMax[3] = { &result.max.x, &result.max.y, &result.max.z };
+	const float localMin[3] = { localBounds.min.x, localBounds.min.y, localBounds.min.z };
+	const float localMax[3] = { localBounds.max.x, localBounds.max.y, localBounds.max.z };
+
+	for ( int row = 0; row < 3; ++row )
+	{
+		const float *m = rows[row]->data();
+		for ( int col = 0; col < 3; ++col )
+		{
+			const float a = m[col] * localMin[col];
+			const float b = m[col] * localMax[col];
+			*resultMin[row] += a < b ? a : b;
+			*resultMax[row] += a < b ? b : a;
+		}
+	}
+	return result;
+}
+
+math::BoundingBox3Df infiniteBounds() noexcept
+{
+	constexpr float kMax = std::numeric_limits<float>::max();
+	return math::BoundingBox3Df( -kMax, -kMax, -kMax, kMax, kMax, kMax );
+}
+
+void BoundsSoA::clear() noexcept
+{
+	m_minX.clear();
+	m_minY.clear();
+	m_minZ.clear();
+	m_maxX.clear();
+	m_maxY.clear();
+	m_maxZ.clear();
+}
+
+void BoundsSoA::reserve( std::size_t count )
+{
+	m_minX.reserve( count );
+	m_minY.reserve( count );
+	m_minZ.reserve( count );
+	m_maxX.reserve( count );
+	m_maxY.reserve( count );
+	m_maxZ.reserve( count );
+}
+
+std::uint32_t BoundsSoA::add( const math::BoundingBox3Df &bounds )
+{
+	const std::uint32_t index = size();
+	m_minX.push_back( bounds.min.x );
+	m_minY.push_back( bounds.min.y );
+	m_minZ.push_back( bounds.min.z );
+	m_maxX.push_back( bounds.max.x );
+	m_maxY.push_back( bounds.max.y );
+	m_maxZ.push_back( bounds.max.z );
+	return index;
+}
+
+math::BoundingBox3Df BoundsSoA::get( std::uint32_t index ) const noexcept
+{
+	return math::BoundingBox3Df( m_minX[index], m_minY[index], m_minZ[index], m_maxX[index], m_maxY[index], m_maxZ[index] );
+}
+
+CullingStats cullBounds( const math::Frustum<float> &frustum, const BoundsSoA &bounds, std::vector<std::uint32_t> &visibleIndices )
+{
+#if defined( ENGINE_CULLING_SSE )
+	visibleIndices.clear();
+	const std::uint32_t count = bounds.size();
+	if ( count == 0 )
+	{
+		return {};
+	}
+
+	PlaneStreams planes[6];
+	setupPlaneStreams( frustum, bounds, planes );
+
+	// Process full batches of 8 boxes as two SSE lanes of 4
+	const std::uint32_t batchEnd = count - ( count % BoundsSoA::kBatchSize );
+	for ( std::uint32_t base = 0; base < batchEnd; base += BoundsSoA::kBatchSize )
+	{
+		const int mask = cullFourSSE( planes, base ) | ( cullFourSSE( planes, base + 4 ) << 4 );
+		if ( mask == 0 )
+		{
+			continue;
+		}
+		for ( std::uint32_t lane = 0; lane < BoundsSoA::kBatchSize; ++lane )
+		{
+			if ( mask & ( 1 << lane ) )
+			{
+				visibleIndices.push_back( base + lane );
+			}
+		}
+	}
+
+	cullScalarRange( planes, batchEnd, count, visibleIndices );
+
+	return CullingStats{ count, static_cast<std::uint32_t>( visibleIndices.size() ) };
+#else
+	return cullBoundsScalar( frustum, bounds, visibleIndices );
+#endif
+}
+
+CullingStats cullBoundsScalar( const math::Frustum<float> &frustum, const BoundsSoA &bounds, std::vector<std::uint32_t> &visibleIndices )
+{
+	visibleIndices.clear();
+	const std::uint32_t count = bounds.size();
+	if ( count == 0 )
+	{
+		return {};
+	}
+
+	PlaneStreams planes[6];
+	setupPlaneStreams( frustum, bounds, planes );
+	cullScalarRange( planes, 0, count, visibleIndices );
+
+	return CullingStats{ count, static_cast<std::uint32_t>( visibleIndices.size() ) };
+}
+
+} // namespace engine::culling
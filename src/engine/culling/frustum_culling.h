@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "math/bounding_box_3d.h"
+#include "math/frustum.h"
+#include "math/matrix.h"
+
+// Backend-independent visibility culling utilities.
+// Nothing in here touches D3D12 so it can be unit-tested and benchmarked headless.
+namespace engine::culling
+{
+
+// Transform a local-space AABB by an affine world matrix (Arvo's method).
+// Returns the tightest world-space AABB enclosing the transformed box.
+// Invalid (empty) boxes are returned unchanged.
+math::BoundingBox3Df transformBounds( const math::BoundingBox3Df &localBounds, const math::Mat4f &worldMatrix ) noexcept;
+
+// AABB that passes every frustum test, used for renderables without usable bounds
+math::BoundingBox3Df infiniteBounds() noexcept;
+
+// Structure-of-arrays AABB storage laid out for batched SIMD testing.
+// Boxes are tested kBatchSize at a time; the remainder is handled by a scalar tail.
+class BoundsSoA
+{
+public:
+	static constexpr std::uint32_t kBatchSize = 8;
+
+	void clear() noexcept;
+	void reserve( std::size_t count );
+
+	// Append a box and return its index
+	std::uint32_t add( const math::BoundingBox3Df &bounds );
+
+	std::uint32_t size() const noexcept { return static_cast<std::uint32_t>( m_minX.size() ); }
+	bool empty() const noexcept { return m_minX.empty(); }
+
+	// Reassemble a box (tests and debugging)
+	math::BoundingBox3Df get( std::uint32_t index ) const noexcept;
+
+	// Raw component streams
+	const float *minX() const noexcept { return m_minX.data(); }
+	const float *minY() const noexcept { return m_minY.data(); }
+	const float *minZ() const noexcept { return m_minZ.data(); }
+	const float *maxX() const noexcept { return m_maxX.data(); }
+	const float *maxY() const noexcept { return m_maxY.data(); }
+	const float *maxZ() const noexcept { return m_maxZ.data(); }
+
+private:
+	std::vector<float> m_minX, m_minY, m_minZ;
+	std::vector<float> m_maxX, m_maxY, m_maxZ;
+};
+
+// Per-pass culling statistics
+struct CullingStats
+{
+	std::uint32_t tested = 0;
+	std::uint32_t visible = 0;
+
+	std::uint32_t culled() const noexcept { return tested - visible; }
+};
+
+// Test every box against the frustum and write the indices of intersecting boxes to visibleIndices
+// (cleared first, ascending order). Uses SSE when available, falling back to cullBoundsScalar otherwise.
+CullingStats cullBounds( const math::Frustum<float> &frustum, const BoundsSoA &bounds, std::vector<std::uint32_t> &visibleIndices );
+
+// Reference scalar implementation with identical results, used to validate the SIMD path
+CullingStats cullBoundsScalar( const math::Frustum<float> &frustum, const BoundsSoA &bounds, std::vector<std::uint32_t> &visibleIndices );
+
+} // namespace engine::culling
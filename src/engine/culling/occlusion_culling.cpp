@@ -0,0 +1,505 @@
+#include "engine/culling/occlusion_culling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "engine/assets/assets.h"
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#define ENGINE_OCCLUSION_SSE 1
+#endif
+
+namespace engine::culling
+{
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs( Clock::time_point start ) noexcept
+{
+	return std::chrono::duration<double, std::milli>( Clock::now() - start ).count();
+}
+
+math::Vec4f transform( const math::Mat4f &m, const math::Vec3f &p ) noexcept
+{
+	return math::Vec4f{
+		m.row0.x * p.x + m.row0.y * p.y + m.row0.z * p.z + m.row0.w,
+		m.row1.x * p.x + m.row1.y * p.y + m.row1.z * p.z + m.row1.w,
+		m.row2.x * p.x + m.row2.y * p.y + m.row2.z * p.z + m.row2.w,
+		m.row3.x * p.x + m.row3.y * p.y + m.row3.z * p.z + m.row3.w
+	};
+}
+
+// Signed distance to the near plane, matching math::Frustum (row3 + row2)
+float nearDistance( const math::Vec4f &clip ) noexcept
+{
+	return clip.w + clip.z;
+}
+
+math::Vec4f lerp( const math::Vec4f &a, const math::Vec4f &b, float t ) noexcept
+{
+	return math::Vec4f{ a.x + ( b.x - a.x ) * t, a.y + ( b.y - a.y ) * t, a.z + ( b.z - a.z ) * t, a.w + ( b.w - a.w ) * t };
+}
+
+// Vertices this close to w = 0 are treated as behind the camera
+constexpr float kMinW = 1e-6f;
+} // namespace
+
+OccluderMesh buildOccluderMesh( const assets::Mesh &mesh, std::uint32_t maxTrianglesPerPrimitive )
+{
+	OccluderMesh occluder;
+	std::vector<std::uint32_t> remap;
+	constexpr std::uint32_t kUnmapped = ~0u;
+
+	for ( const auto &primitive : mesh.getPrimitives() )
+	{
+		const std::vector<std::uint32_t> *indices = &primitive.getIndices();
+		for ( const auto &lod : primitive.getLods() )
+		{
+			if ( indices->size() / 3 <= maxTrianglesPerPrimitive )
+			{
+				break;
+			}
+			indices = &lod.indices;
+		}
+
+		// Only copy vertices the chosen level references
+		const auto decoded = primitive.hasCompactVertices() ? primitive.decodeVertices() : std::vector<assets::Vertex>{};
+		const auto &vertices = primitive.hasCompactVertices() ? decoded : primitive.getVertices();
+		remap.assign( vertices.size(), kUnmapped );
+		for ( const std::uint32_t index : *indices )
+		{
+			if ( index >= vertices.size() )
+			{
+				continue;
+			}
+			if ( remap[index] == kUnmapped )
+			{
+				remap[index] = static_cast<std::uint32_t>( occluder.positions.size() );
+				occluder.positions.push_back( vertices[index].position );
+			}
+		}
+		for ( std::size_t t = 0; t + 2 < indices->size(); t += 3 )
+		{
+			const std::uint32_t i0 = ( *indices )[t];
+			const std::uint32_t i1 = ( *indices )[t + 1];
+			const std::uint32_t i2 = ( *indices )[t + 2];
+			if ( i0 < vertices.size() && i1 < vertices.size() && i2 < vertices.size() )
+			{
+				occluder.indices.insert( occluder.indices.end(), { remap[i0], remap[i1], remap[i2] } );
+			}
+		}
+	}
+
+	return occluder;
+}
+
+OcclusionBuffer::OcclusionBuffer( std::uint32_t width, std::uint32_t height )
+{
+	resize( width, height );
+}
+
+void OcclusionBuffer::resize( std::uint32_t width, std::uint32_t height )
+{
+	m_tilesX = std::max( 1u, ( width + kTileSize - 1 ) / kTileSize );
+	m_tilesY = std::max( 1u, ( height + kTileSize - 1 ) / kTileSize );
+	m_width = m_tilesX * kTileSize;
+	m_height = m_tilesY * kTileSize;
+	m_depth.assign( static_cast<std::size_t>( m_width ) * m_height, kEmptyDepth );
+	m_tileFarthest.assign( static_cast<std::size_t>( m_tilesX ) * m_tilesY, kEmptyDepth );
+}
+
+void OcclusionBuffer::beginFrame( const math::Mat4f &viewProjection )
+{
+	m_viewProjection = viewProjection;
+	std::fill( m_depth.begin(), m_depth.end(), kEmptyDepth );
+	std::fill( m_tileFarthest.begin(), m_tileFarthest.end(), kEmptyDepth );
+	m_triangles.clear();
+	m_stats = {};
+}
+
+void OcclusionBuffer::addOccluder( const OccluderMesh &mesh, const math::Mat4f &worldMatrix )
+{
+	if ( mesh.empty() )
+	{
+		return;
+	}
+
+	const auto start = Clock::now();
+	const auto worldViewProjection = m_viewProjection * worldMatrix;
+	m_clipPositions.resize( mesh.positions.size() );
+	for ( std::size_t i = 0; i < mesh.positions.size(); ++i )
+	{
+		m_clipPositions[i] = transform( worldViewProjection, mesh.positions[i] );
+	}
+
+	const auto trianglesBefore = m_triangles.size();
+	for ( std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3 )
+	{
+		addClippedTriangle( m_clipPositions[mesh.indices[t]], m_clipPositions[mesh.indices[t + 1]], m_clipPositions[mesh.indices[t + 2]] );
+	}
+
+	++m_stats.occluders;
+	m_stats.occluderTriangles += static_cast<std::uint32_t>( m_triangles.size() - trianglesBefore );
+	m_stats.rasterizeMs += elapsedMs( start );
+}
+
+void OcclusionBuffer::addClippedTriangle( const math::Vec4f &a, const math::Vec4f &b, const math::Vec4f &c )
+{
+	// Trivially reject triangles entirely outside one side of the view volume
+	if ( ( a.x < -a.w && b.x < -b.w && c.x < -c.w ) || ( a.x > a.w && b.x > b.w && c.x > c.w ) ||
+		( a.y < -a.w && b.y < -b.w && c.y < -c.w ) || ( a.y > a.w && b.y > b.w && c.y > c.w ) )
+	{
+		return;
+	}
+
+	const math::Vec4f input[3] = { a, b, c };
+	const float distances[3] = { nearDistance( a ), nearDistance( b ), nearDistance( c ) };
+	const bool inside[3] = { distances[0] >= 0.0f && a.w > kMinW, distances[1] >= 0.0f && b.w > kMinW, distances[2] >= 0.0f && c.w > kMinW };
+	const int insideCount = int( inside[0] ) + int( inside[1] ) + int( inside[2] );
+	if ( insideCount == 3 )
+	{
+		addScreenTriangle( a, b, c );
+		return;
+	}
+	if ( insideCount == 0 )
+	{
+		return;
+	}
+
+	// Sutherland-Hodgman against the near plane; at most four vertices remain
+	math::Vec4f polygon[4];
+	int count = 0;
+	for ( int i = 0; i < 3; ++i )
+	{
+		const int next = ( i + 1 ) % 3;
+		if ( inside[i] )
+		{
+			polygon[count++] = input[i];
+		}
+		if ( inside[i] != inside[next] )
+		{
+			const float t = distances[i] / ( distances[i] - distances[next] );
+			polygon[count++] = lerp( input[i], input[next], t );
+		}
+	}
+	for ( int i = 1; i + 1 < count; ++i )
+	{
+		if ( polygon[0].w > kMinW && polygon[i].w > kMinW && polygon[i + 1].w > kMinW )
+		{
+			addScreenTriangle( polygon[0], polygon[i], polygon[i + 1] );
+		}
+	}
+}
+
+void OcclusionBuffer::addScreenTriangle( const math::Vec4f &a, const math::Vec4f &b, const math::Vec4f &c )
+{
+	const math::Vec4f *vertices[3] = { &a, &b, &c };
+	ScreenTriangle triangle;
+	for ( int i = 0; i < 3; ++i )
+	{
+		const float invW = 1.0f / vertices[i]->w;
+		triangle.x[i] = ( vertices[i]->x * invW * 0.5f + 0.5f ) * static_cast<float>( m_width );
+		triangle.y[i] = ( 0.5f - vertices[i]->y * invW * 0.5f ) * static_cast<float>( m_height );
+		triangle.z[i] = vertices[i]->z * invW;
+	}
+
+	// Both windings are rasterised; normalise to positive area so inside means all edges >= 0
+	const float area = ( triangle.x[1] - triangle.x[0] ) * ( triangle.y[2] - triangle.y[0] ) -
+		( triangle.x[2] - triangle.x[0] ) * ( triangle.y[1] - triangle.y[0] );
+	if ( !( std::abs( area ) > 1e-8f ) )
+	{
+		return;
+	}
+	if ( area < 0.0f )
+	{
+		std::swap( triangle.x[1], triangle.x[2] );
+		std::swap( triangle.y[1], triangle.y[2] );
+		std::swap( triangle.z[1], triangle.z[2] );
+	}
+	m_triangles.push_back( triangle );
+}
+
+void OcclusionBuffer::rasterize()
+{
+	const auto start = Clock::now();
+
+	// Bands of whole tile rows so each thread owns its tiles outright
+	const std::uint32_t bandCount = std::min( m_threadCount, m_tilesY );
+	if ( bandCount <= 1 )
+	{
+		rasterizeBand( 0, m_tilesY );
+	}
+	else
+	{
+		std::vector<std::thread> workers;
+		workers.reserve( bandCount - 1 );
+		for ( std::uint32_t band = 1; band < bandCount; ++band )
+		{
+			const std::uint32_t first = m_tilesY * band / bandCount;
+			const std::uint32_t end = m_tilesY * ( band + 1 ) / bandCount;
+			workers.emplace_back( [this, first, end]() { rasterizeBand( first, end ); } );
+		}
+		rasterizeBand( 0, m_tilesY / bandCount );
+		for ( auto &worker : workers )
+		{
+			worker.join();
+		}
+	}
+
+	m_stats.rasterizeMs += elapsedMs( start );
+}
+
+void OcclusionBuffer::rasterizeBand( std::uint32_t firstTileRow, std::uint32_t endTileRow )
+{
+	const int bandMinY = static_cast<int>( firstTileRow * kTileSize );
+	const int bandMaxY = static_cast<int>( endTileRow * kTileSize ) - 1;
+	for ( const auto &triangle : m_triangles )
+	{
+		rasterizeTriangle( triangle, bandMinY, bandMaxY );
+	}
+
+	// Farthest depth per tile lets box tests skip fully occluded tiles
+	for ( std::uint32_t tileY = firstTileRow; tileY < endTileRow; ++tileY )
+	{
+		for ( std::uint32_t tileX = 0; tileX < m_tilesX; ++tileX )
+		{
+			float farthest = -kEmptyDepth;
+			for ( std::uint32_t y = tileY * kTileSize; y < ( tileY + 1 ) * kTileSize; ++y )
+			{
+				const float *row = &m_depth[y * m_width + tileX * kTileSize];
+				for ( std::uint32_t x = 0; x < kTileSize; ++x )
+				{
+					farthest = std::max( farthest, row[x] );
+				}
+			}
+			m_tileFarthest[tileY * m_tilesX + tileX] = farthest;
+		}
+	}
+}
+
+void OcclusionBuffer::rasterizeTriangle( const ScreenTriangle &triangle, int bandMinY, int bandMaxY )
+{
+	const float minXf = std::min( { triangle.x[0], triangle.x[1], triangle.x[2] } );
+	const float maxXf = std::max( { triangle.x[0], triangle.x[1], triangle.x[2] } );
+	const float minYf = std::min( { triangle.y[0], triangle.y[1], triangle.y[2] } );
+	const float maxYf = std::max( { triangle.y[0], triangle.y[1], triangle.y[2] } );
+
+	const int minY = std::max( bandMinY, static_cast<int>( std::floor( minYf ) ) );
+	const int maxY = std::min( bandMaxY, static_cast<int>( std::ceil( maxYf ) ) );
+	// Start on a 4-pixel boundary for the SIMD loop; the buffer width is a multiple of the tile size
+	const int minX = std::max( 0, static_cast<int>( std::floor( minXf ) ) ) & ~3;
+	const int maxX = std::min( static_cast<int>( m_width ) - 1, static_cast<int>( std::ceil( maxXf ) ) );
+	if ( minY > maxY || minX > maxX )
+	{
+		return;
+	}
+
+	// Edge i runs from vertex i to vertex i + 1: e(x, y) = a * x + b * y + c, inside when every e >= 0
+	float edgeA[3], edgeB[3], edgeC[3];
+	for ( int i = 0; i < 3; ++i )
+	{
+		const int next = ( i + 1 ) % 3;
+		edgeA[i] = -( triangle.y[next] - triangle.y[i] );
+		edgeB[i] = triangle.x[next] - triangle.x[i];
+		edgeC[i] = -( edgeA[i] * triangle.x[i] + edgeB[i] * triangle.y[i] );
+	}
+
+	// Depth plane from barycentrics: vertex 1 weighs edge 2, vertex 2 weighs edge 0
+	const float area = edgeA[0] * triangle.x[2] + edgeB[0] * triangle.y[2] + edgeC[0];
+	const float dz1 = ( triangle.z[1] - triangle.z[0] ) / area;
+	const float dz2 = ( triangle.z[2] - triangle.z[0] ) / area;
+	const float depthA = dz1 * edgeA[2] + dz2 * edgeA[0];
+	const float depthB = dz1 * edgeB[2] + dz2 * edgeB[0];
+	const float depthC = triangle.z[0] + dz1 * edgeC[2] + dz2 * edgeC[0];
+
+	for ( int y = minY; y <= maxY; ++y )
+	{
+		const float py = static_cast<float>( y ) + 0.5f;
+		float *row = &m_depth[static_cast<std::size_t>( y ) * m_width];
+		int x = minX;
+
+#ifdef ENGINE_OCCLUSION_SSE
+		const __m128 laneOffsets = _mm_setr_ps( 0.5f, 1.5f, 2.5f, 3.5f );
+		const __m128 zero = _mm_setzero_ps();
+		__m128 rowE[3], stepE[3];
+		for ( int i = 0; i < 3; ++i )
+		{
+			rowE[i] = _mm_add_ps( _mm_set1_ps( edgeB[i] * py + edgeC[i] ), _mm_mul_ps( _mm_set1_ps( edgeA[i] ), laneOffsets ) );
+			stepE[i] = _mm_set1_ps( edgeA[i] * 4.0f );
+		}
+		__m128 rowDepth = _mm_add_ps( _mm_set1_ps( depthB * py + depthC ), _mm_mul_ps( _mm_set1_ps( depthA ), laneOffsets ) );
+		const __m128 stepDepth = _mm_set1_ps( depthA * 4.0f );
+
+		const __m128 startX = _mm_set1_ps( static_cast<float>( minX ) );
+		for ( int i = 0; i < 3; ++i )
+		{
+			rowE[i] = _mm_add_ps( rowE[i], _mm_mul_ps( _mm_set1_ps( edgeA[i] ), startX ) );
+		}
+		rowDepth = _mm_add_ps( rowDepth, _mm_mul_ps( _mm_set1_ps( depthA ), startX ) );
+
+		for ( ; x <= maxX; x += 4 )
+		{
+			const __m128 inside = _mm_and_ps( _mm_and_ps( _mm_cmpge_ps( rowE[0], zero ), _mm_cmpge_ps( rowE[1], zero ) ), _mm_cmpge_ps( rowE[2], zero ) );
+			if ( _mm_movemask_ps( inside ) != 0 )
+			{
+				const __m128 current = _mm_loadu_ps( row + x );
+				const __m128 nearer = _mm_min_ps( current, rowDepth );
+				_mm_storeu_ps( row + x, _mm_or_ps( _mm_and_ps( inside, nearer ), _mm_andnot_ps( inside, current ) ) );
+			}
+			for ( int i = 0; i < 3; ++i )
+			{
+				rowE[i] = _mm_add_ps( rowE[i], stepE[i] );
+			}
+			rowDepth = _mm_add_ps( rowDepth, stepDepth );
+		}
+#endif
+
+		for ( ; x <= maxX; ++x )
+		{
+			const float px = static_cast<float>( x ) + 0.5f;
+			const float e0 = edgeA[0] * px + edgeB[0] * py + edgeC[0];
+			const float e1 = edgeA[1] * px + edgeB[1] * py + edgeC[1];
+			const float e2 = edgeA[2] * px + edgeB[2] * py + edgeC[2];
+			if ( e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f )
+			{
+				row[x] = std::min( row[x], depthA * px + depthB * py + depthC );
+			}
+		}
+	}
+}
+
+OcclusionBuffer::ScreenRect OcclusionBuffer::projectBounds( const math::BoundingBox3Df &worldBounds ) const noexcept
+{
+	ScreenRect rect{ 0, 0, -1, -1, kEmptyDepth, false };
+	math::Vec4f clipCorners[8];
+	int behindCount = 0;
+	for ( int i = 0; i < 8; ++i )
+	{
+		clipCorners[i] = transform( m_viewProjection, worldBounds.corner( i ) );
+		behindCount += nearDistance( clipCorners[i] ) < 0.0f || clipCorners[i].w <= kMinW ? 1 : 0;
+	}
+	// Entirely behind the camera: an empty rectangle. Partly behind: no usable rectangle.
+	if ( behindCount > 0 )
+	{
+		rect.crossesNear = behindCount < 8;
+		return rect;
+	}
+
+	float minX = kEmptyDepth, minY = kEmptyDepth, maxX = -kEmptyDepth, maxY = -kEmptyDepth;
+	for ( const auto &clip : clipCorners )
+	{
+		const float invW = 1.0f / clip.w;
+		const float x = ( clip.x * invW * 0.5f + 0.5f ) * static_cast<float>( m_width );
+		const float y = ( 0.5f - clip.y * invW * 0.5f ) * static_cast<float>( m_height );
+		minX = std::min( minX, x );
+		maxX = std::max( maxX, x );
+		minY = std::min( minY, y );
+		maxY = std::max( maxY, y );
+		rect.nearestDepth = std::min( rect.nearestDepth, clip.z * invW );
+	}
+
+	// One extra pixel on each side: occluder coverage is sampled at pixel centres only
+	rect.minX = std::max( 0, static_cast<int>( std::floor( minX ) ) - 1 );
+	rect.minY = std::max( 0, static_cast<int>( std::floor( minY ) ) - 1 );
+	rect.maxX = std::min( static_cast<int>( m_width ) - 1, static_cast<int>( std::floor( maxX ) ) + 1 );
+	rect.maxY = std::min( static_cast<int>( m_height ) - 1, static_cast<int>( std::floor( maxY ) ) + 1 );
+	return rect;
+}
+
+bool OcclusionBuffer::isVisible( const math::BoundingBox3Df &worldBounds ) const noexcept
+{
+	if ( !worldBounds.isValid() )
+	{
+		return true;
+	}
+
+	const auto rect = projectBounds( worldBounds );
+	if ( rect.crossesNear || rect.minX > rect.maxX || rect.minY > rect.maxY )
+	{
+		return true;
+	}
+
+	const int tileSize = static_cast<int>( kTileSize );
+	for ( int tileY = rect.minY / tileSize; tileY <= rect.maxY / tileSize; ++tileY )
+	{
+		for ( int tileX = rect.minX / tileSize; tileX <= rect.maxX / tileSize; ++tileX )
+		{
+			if ( m_tileFarthest[tileY * m_tilesX + tileX] < rect.nearestDepth )
+			{
+				continue;
+			}
+
+			const int x0 = std::max( rect.minX, tileX * tileSize );
+			const int x1 = std::min( rect.maxX, tileX * tileSize + tileSize - 1 );
+			const int y0 = std::max( rect.minY, tileY * tileSize );
+			const int y1 = std::min( rect.maxY, tileY * tileSize + tileSize - 1 );
+			if ( x1 - x0 == tileSize - 1 && y1 - y0 == tileSize - 1 )
+			{
+				// The whole tile is covered and something in it is not in front of the box
+				return true;
+			}
+			for ( int y = y0; y <= y1; ++y )
+			{
+				const float *row = &m_depth[static_cast<std::size_t>( y ) * m_width];
+				for ( int x = x0; x <= x1; ++x )
+				{
+					if ( row[x] >= rect.nearestDepth )
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+void OcclusionBuffer::cullOccluded( const BoundsSoA &bounds, std::vector<std::uint32_t> &indices, std::span<const std::uint8_t> alwaysVisible )
+{
+	const auto start = Clock::now();
+
+	std::size_t write = 0;
+	for ( const std::uint32_t index : indices )
+	{
+		const bool exempt = index < alwaysVisible.size() && alwaysVisible[index] != 0;
+		if ( !exempt )
+		{
+			++m_stats.tested;
+			if ( !isVisible( bounds.get( index ) ) )
+			{
+				++m_stats.occluded;
+				continue;
+			}
+		}
+		indices[write++] = index;
+	}
+	indices.resize( write );
+
+	m_stats.testMs += elapsedMs( start );
+}
+
+float OcclusionBuffer::screenCoverage( const math::BoundingBox3Df &worldBounds ) const noexcept
+{
+	if ( !worldBounds.isValid() )
+	{
+		return 0.0f;
+	}
+	const auto rect = projectBounds( worldBounds );
+	if ( rect.crossesNear )
+	{
+		return 1.0f;
+	}
+	if ( rect.minX > rect.maxX || rect.minY > rect.maxY )
+	{
+		return 0.0f;
+	}
+	const float area = static_cast<float>( ( rect.maxX - rect.minX + 1 ) * ( rect.maxY - rect.minY + 1 ) );
+	return area / static_cast<float>( m_width * m_height );
+}
+
+} // namespace engine::culling
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "engine/culling/frustum_culling.h"
+#include "math/bounding_box_3d.h"
+#include "math/matrix.h"
+#include "math/vec.h"
+
+namespace assets
+{
+class Mesh;
+}
+
+// Software occlusion culling: occluder triangles are rasterised on the CPU into a small depth buffer
+// which candidate AABBs are then tested against. Backend-independent and deterministic.
+namespace engine::culling
+{
+
+// Occluder geometry in mesh space (a low-detail copy of a mesh's triangles)
+struct OccluderMesh
+{
+	std::vector<math::Vec3f> positions;
+	std::vector<std::uint32_t> indices;
+
+	bool empty() const noexcept { return indices.empty(); }
+	std::uint32_t triangleCount() const noexcept { return static_cast<std::uint32_t>( indices.size() / 3 ); }
+};
+
+// Collect occluder triangles from every primitive of a mesh, using the finest LOD level with at most
+// maxTrianglesPerPrimitive triangles (the coarsest level when none is small enough)
+OccluderMesh buildOccluderMesh( const assets::Mesh &mesh, std::uint32_t maxTrianglesPerPrimitive = 256 );
+
+// Per-frame occlusion statistics
+struct OcclusionStats
+{
+	std::uint32_t occluders = 0;
+	std::uint32_t occluderTriangles = 0; // Triangles rasterised after near-plane clipping
+	std::uint32_t tested = 0;
+	std::uint32_t occluded = 0;
+	double rasterizeMs = 0.0; // Transforming, clipping and drawing occluders
+	double testMs = 0.0;
+
+	std::uint32_t visible() const noexcept { return tested - occluded; }
+};
+
+// Low-resolution depth buffer storing the NDC depth (z / w) of the nearest occluder per pixel, kEmptyDepth where
+// nothing was drawn. NDC depth is affine in screen space for perspective and orthographic projections alike.
+// Usage per view: beginFrame(), addOccluder() for each occluder, rasterize(), then isVisible()/cullOccluded().
+class OcclusionBuffer
+{
+public:
+	static constexpr std::uint32_t kTileSize = 8;
+	static constexpr std::uint32_t kDefaultWidth = 256;
+	static constexpr std::uint32_t kDefaultHeight = 128;
+	static constexpr float kEmptyDepth = 3.0e38f;
+
+	OcclusionBuffer( std::uint32_t width = kDefaultWidth, std::uint32_t height = kDefaultHeight );
+
+	// Dimensions are rounded up to whole tiles
+	void resize( std::uint32_t width, std::uint32_t height );
+	std::uint32_t getWidth() const noexcept { return m_width; }
+	std::uint32_t getHeight() const noexcept { return m_height; }
+
+	// Rasterisation splits the buffer into horizontal bands, one per thread. Results do not depend on it.
+	void setThreadCount( std::uint32_t count ) noexcept { m_threadCount = count > 0 ? count : 1; }
+	std::uint32_t getThreadCount() const noexcept { return m_threadCount; }
+
+	// Clear the buffer and occluder list for a new view
+	void beginFrame( const math::Mat4f &viewProjection );
+
+	// Transform, near-clip and queue an occluder's triangles. Both windings are drawn.
+	void addOccluder( const OccluderMesh &mesh, const math::Mat4f &worldMatrix );
+
+	// Draw all queued occluders
+	void rasterize();
+
+	// False only when every pixel the box can cover holds an occluder nearer than the box's nearest corner.
+	// Boxes crossing the near plane or behind the camera are reported visible (frustum culling handles those).
+	bool isVisible( const math::BoundingBox3Df &worldBounds ) const noexcept;
+
+	// Remove occluded boxes from indices (order preserved). Entries flagged in alwaysVisible (indexed by
+	// box index) are kept untested, e.g. the occluders themselves.
+	void cullOccluded( const BoundsSoA &bounds, std::vector<std::uint32_t> &indices, std::span<const std::uint8_t> alwaysVisible = {} );
+
+	// Fraction of the screen covered by the box's screen rectangle; 1 when it crosses the near plane,
+	// 0 when it is entirely behind the camera
+	float screenCoverage( const math::BoundingBox3Df &worldBounds ) const noexcept;
+
+	// Stored depth at a pixel (tests and debug views)
+	float getDepth( std::uint32_t x, std::uint32_t y ) const noexcept { return m_depth[y * m_width + x]; }
+
+	const OcclusionStats &getStats() const noexcept { return m_stats; }
+
+private:
+	struct ScreenTriangle
+	{
+		float x[3];
+		float y[3];
+		float z[3];
+	};
+
+	struct ScreenRect
+	{
+		int minX, minY, maxX, maxY; // Inclusive pixel range
+		float nearestDepth;
+		bool crossesNear;
+	};
+
+	std::uint32_t m_width = 0;
+	std::uint32_t m_height = 0;
+	std::uint32_t m_tilesX = 0;
+	std::uint32_t m_tilesY = 0;
+	std::uint32_t m_threadCount = 1;
+	math::Mat4f m_viewProjection;
+
+	std::vector<float> m_depth;
+	std::vector<float> m_tileFarthest; // Largest depth per tile for early-out tests
+	std::vector<ScreenTriangle> m_triangles;
+	std::vector<math::Vec4f> m_clipPositions;
+	OcclusionStats m_stats;
+
+	ScreenRect projectBounds( const math::BoundingBox3Df &worldBounds ) const noexcept;
+	void addClippedTriangle( const math::Vec4f &a, const math::Vec4f &b, const math::Vec4f &c );
+	void addScreenTriangle( const math::Vec4f &a, const math::Vec4f &b, const math::Vec4f &c );
+	void rasterizeBand( std::uint32_t firstTileRow, std::uint32_t endTileRow );
+	void rasterizeTriangle( const ScreenTriangle &triangle, int bandMinY, int bandMaxY );
+};
+
+} // namespace engine::culling
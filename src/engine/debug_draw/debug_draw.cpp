@@ -0,0 +1,275 @@
+#include "engine/debug_draw/debug_draw.h"
+
+#include <cmath>
+#include <numbers>
+
+namespace engine::debug_draw
+{
+
+namespace
+{
+constexpr std::size_t kModeCount = static_cast<std::size_t>( DepthMode::Count );
+
+std::size_t modeIndex( DepthMode mode ) noexcept
+{
+	const auto index = static_cast<std::size_t>( mode );
+	return index < kModeCount ? index : 0;
+}
+
+// Scratch list reused by the batcher's add* helpers so shapes are built outside the lock without allocating
+DebugDrawList &threadScratchList()
+{
+	thread_local DebugDrawList scratch;
+	scratch.clear();
+	return scratch;
+}
+} // namespace
+
+void DebugDrawList::clear() noexcept
+{
+	for ( auto &vertices : m_vertices )
+	{
+		vertices.clear();
+	}
+}
+
+bool DebugDrawList::empty() const noexcept
+{
+	for ( const auto &vertices : m_vertices )
+	{
+		if ( !vertices.empty() )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::uint32_t DebugDrawList::lineCount() const noexcept
+{
+	std::size_t vertexCount = 0;
+	for ( const auto &vertices : m_vertices )
+	{
+		vertexCount += vertices.size();
+	}
+	return static_cast<std::uint32_t>( vertexCount / 2 );
+}
+
+void DebugDrawList::addLine( const math::Vec3f &start, const math::Vec3f &end, const math::Vec4f &color, DepthMode mode )
+{
+	auto &vertices = m_vertices[modeIndex( mode )];
+	vertices.push_back( { start, color } );
+	vertices.push_back( { end, color } );
+}
+
+void DebugDrawList::addBoxCorners( const math::Vec3f ( &corners )[8], const math::Vec4f &color, DepthMode mode )
+{
+	// Corners are indexed by bits (x, y, z); every edge joins two corners differing in one bit
+	auto &vertices = m_vertices[modeIndex( mode )];
+	for ( int i = 0; i < 8; ++i )
+	{
+		for ( int bit = 1; bit < 8; bit <<= 1 )
+		{
+			if ( ( i & bit ) == 0 )
+			{
+				vertices.push_back( { corners[i], color } );
+				vertices.push_back( { corners[i | bit], color } );
+			}
+		}
+	}
+}
+
+void DebugDrawList::addBox( const math::BoundingBox3Df &bounds, const math::Vec4f &color, DepthMode mode )
+{
+	if ( !bounds.isValid() )
+	{
+		return;
+	}
+
+	math::Vec3f corners[8];
+	for ( int i = 0; i < 8; ++i )
+	{
+		corners[i] = bounds.corner( i );
+	}
+	addBoxCorners( corners, color, mode );
+}
+
+void DebugDrawList::addBox( const math::BoundingBox3Df &localBounds, const math::Mat4f &worldMatrix, const math::Vec4f &color, DepthMode mode )
+{
+	if ( !localBounds.isValid() )
+	{
+		return;
+	}
+
+	math::Vec3f corners[8];
+	for ( int i = 0; i < 8; ++i )
+	{
+		corners[i] = worldMatrix.transformPoint( localBounds.corner( i ) );
+	}
+	addBoxCorners( corners, color, mode );
+}
+
+void DebugDrawList::addSphere( const math::Vec3f &center, float radius, const math::Vec4f &color, DepthMode mode, std::uint32_t segments )
+{
+	if ( radius <= 0.0f || segments < 3 )
+	{
+		return;
+	}
+
+	auto &vertices = m_vertices[modeIndex( mode )];
+	vertices.reserve( vertices.size() + segments * 6 );
+
+	const float step = 2.0f * std::numbers::pi_v<float> / static_cast<float>( segments );
+	float pc = radius;
+	float ps = 0.0f;
+	for ( std::uint32_t i = 1; i <= segments; ++i )
+	{
+		// The last segment closes the circle exactly on its first point
+		const float angle = step * static_cast<float>( i % segments );
+		const float c = std::cos( angle ) * radius;
+		const float s = std::sin( angle ) * radius;
+
+		// XY, YZ and ZX circles
+		vertices.push_back( { center + math::Vec3f{ pc, ps, 0.0f }, color } );
+		vertices.push_back( { center + math::Vec3f{ c, s, 0.0f }, color } );
+		vertices.push_back( { center + math::Vec3f{ 0.0f, pc, ps }, color } );
+		vertices.push_back( { center + math::Vec3f{ 0.0f, c, s }, color } );
+		vertices.push_back( { center + math::Vec3f{ ps, 0.0f, pc }, color } );
+		vertices.push_back( { center + math::Vec3f{ s, 0.0f, c }, color } );
+
+		pc = c;
+		ps = s;
+	}
+}
+
+void DebugDrawList::addFrustum( const math::Mat4f &viewProjection, const math::Vec4f &color, DepthMode mode )
+{
+	// inverse() returns the transpose of the actual inverse, so transpose it back
+	const math::Mat4f inverse = viewProjection.inverse().transpose();
+
+	math::Vec3f corners[8];
+	for ( int i = 0; i < 8; ++i )
+	{
+		const math::Vec4f ndc{ ( i & 1 ) ? 1.0f : -1.0f, ( i & 2 ) ? 1.0f : -1.0f, ( i & 4 ) ? 1.0f : -1.0f, 1.0f };
+		const math::Vec4f world = inverse * ndc;
+		if ( world.w == 0.0f )
+		{
+			// Singular view-projection (inverse() returns a zero matrix)
+			return;
+		}
+		corners[i] = math::Vec3f{ world.x, world.y, world.z } * ( 1.0f / world.w );
+	}
+	addBoxCorners( corners, color, mode );
+}
+
+void DebugDrawList::append( const DebugDrawList &other )
+{
+	for ( std::size_t mode = 0; mode < kModeCount; ++mode )
+	{
+		m_vertices[mode].insert( m_vertices[mode].end(), other.m_vertices[mode].begin(), other.m_vertices[mode].end() );
+	}
+}
+
+template <typename Build>
+void DebugDrawBatcher::emit( Build &&build )
+{
+	DebugDrawList &scratch = threadScratchList();
+	build( scratch );
+	submit( scratch );
+}
+
+void DebugDrawBatcher::addLine( const math::Vec3f &start, const math::Vec3f &end, const math::Vec4f &color, DepthMode mode )
+{
+	// Single lines skip the scratch list
+	const std::lock_guard lock( m_mutex );
+	m_list.addLine( start, end, color, mode );
+	++m_submissions;
+}
+
+void DebugDrawBatcher::addBox( const math::BoundingBox3Df &bounds, const math::Vec4f &color, DepthMode mode )
+{
+	emit( [&]( DebugDrawList &list ) { list.addBox( bounds, color, mode ); } );
+}
+
+void DebugDrawBatcher::addBox( const math::BoundingBox3Df &localBounds, const math::Mat4f &worldMatrix, const math::Vec4f &color, DepthMode mode )
+{
+	emit( [&]( DebugDrawList &list ) { list.addBox( localBounds, worldMatrix, color, mode ); } );
+}
+
+void DebugDrawBatcher::addSphere( const math::Vec3f &center, float radius, const math::Vec4f &color, DepthMode mode, std::uint32_t segments )
+{
+	emit( [&]( DebugDrawList &list ) { list.addSphere( center, radius, color, mode, segments ); } );
+}
+
+void DebugDrawBatcher::addFrustum( const math::Mat4f &viewProjection, const math::Vec4f &color, DepthMode mode )
+{
+	emit( [&]( DebugDrawList &list ) { list.addFrustum( viewProjection, color, mode ); } );
+}
+
+void DebugDrawBatcher::submit( const DebugDrawList &list )
+{
+	if ( list.empty() )
+	{
+		return;
+	}
+
+	const std::lock_guard lock( m_mutex );
+	m_list.append( list );
+	++m_submissions;
+}
+
+std::uint32_t DebugDrawBatcher::pendingLineCount() const
+{
+	const std::lock_guard lock( m_mutex );
+	return m_list.lineCount();
+}
+
+void DebugDrawBatcher::flush( std::vector<DebugVertex> &vertices, std::vector<DebugDrawRange> &ranges )
+{
+	vertices.clear();
+	ranges.clear();
+
+	const std::lock_guard lock( m_mutex );
+
+	std::size_t total = 0;
+	for ( std::size_t mode = 0; mode < kModeCount; ++mode )
+	{
+		total += m_list.getVertices( static_cast<DepthMode>( mode ) ).size();
+	}
+	vertices.reserve( total );
+
+	for ( std::size_t mode = 0; mode < kModeCount; ++mode )
+	{
+		const auto &source = m_list.getVertices( static_cast<DepthMode>( mode ) );
+		if ( source.empty() )
+		{
+			continue;
+		}
+
+		DebugDrawRange range;
+		range.mode = static_cast<DepthMode>( mode );
+		range.firstVertex = static_cast<std::uint32_t>( vertices.size() );
+		range.vertexCount = static_cast<std::uint32_t>( source.size() );
+		ranges.push_back( range );
+		vertices.insert( vertices.end(), source.begin(), source.end() );
+	}
+
+	m_lastFlushStats = {};
+	m_lastFlushStats.lines = static_cast<std::uint32_t>( vertices.size() / 2 );
+	m_lastFlushStats.submissions = m_submissions;
+	m_lastFlushStats.draws = static_cast<std::uint32_t>( ranges.size() );
+	m_lastFlushStats.uploadBytes = vertices.size() * sizeof( DebugVertex );
+
+	// Capacity is kept so steady-state frames do not allocate
+	m_list.clear();
+	m_submissions = 0;
+}
+
+void DebugDrawBatcher::clear()
+{
+	const std::lock_guard lock( m_mutex );
+	m_list.clear();
+	m_submissions = 0;
+}
+
+} // namespace engine::debug_draw
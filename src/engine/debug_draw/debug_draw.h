@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "math/bounding_box_3d.h"
+#include "math/matrix.h"
+#include "math/vec.h"
+
+// Batched immediate-mode debug geometry: lines, boxes, spheres and frusta are accumulated into per-frame
+// linear arrays and flushed as one contiguous line list with one draw per depth mode.
+// Backend-independent; the renderer uploads the flushed vertices once per frame.
+namespace engine::debug_draw
+{
+
+// Layout matches renderer::Vertex (float3 position, float4 color)
+struct DebugVertex
+{
+	math::Vec3f position;
+	math::Vec4f color;
+};
+static_assert( sizeof( DebugVertex ) == 28, "DebugVertex must match the immediate-mode vertex layout" );
+
+enum class DepthMode : std::uint8_t
+{
+	Tested,	 // Hidden behind scene geometry, does not write depth
+	Overlay, // Always drawn on top
+	Count
+};
+
+// A contiguous range of the flushed vertex array drawn with one depth mode
+struct DebugDrawRange
+{
+	DepthMode mode = DepthMode::Tested;
+	std::uint32_t firstVertex = 0;
+	std::uint32_t vertexCount = 0;
+};
+
+// Counters for the last flush
+struct DebugDrawStats
+{
+	std::uint32_t lines = 0;
+	std::uint32_t submissions = 0; // Appends to the shared batch (lock acquisitions)
+	std::uint32_t draws = 0;
+	std::uint64_t uploadBytes = 0;
+};
+
+// Unsynchronised line list split by depth mode. Use one per thread for bulk emission and hand it to
+// DebugDrawBatcher::submit, or rely on the batcher's locking add* helpers.
+class DebugDrawList
+{
+public:
+	static constexpr std::uint32_t kDefaultSphereSegments = 24;
+
+	void clear() noexcept;
+	bool empty() const noexcept;
+	std::uint32_t lineCount() const noexcept;
+
+	void addLine( const math::Vec3f &start, const math::Vec3f &end, const math::Vec4f &color, DepthMode mode = DepthMode::Tested );
+	void addBox( const math::BoundingBox3Df &bounds, const math::Vec4f &color, DepthMode mode = DepthMode::Tested );
+	// Oriented box: local bounds transformed by a world matrix
+	void addBox( const math::BoundingBox3Df &localBounds, const math::Mat4f &worldMatrix, const math::Vec4f &color, DepthMode mode = DepthMode::Tested );
+	// Three great circles around the coordinate axes
+	void addSphere( const math::Vec3f &center, float radius, const math::Vec4f &color, DepthMode mode = DepthMode::Tested, std::uint32_t segments = kDefaultSphereSegments );
+	// Frustum edges reconstructed from the inverse view-projection (NDC depth -1..1)
+	void addFrustum( const math::Mat4f &viewProjection, const math::Vec4f &color, DepthMode mode = DepthMode::Tested );
+
+	const std::vector<DebugVertex> &getVertices( DepthMode mode ) const noexcept { return m_vertices[static_cast<std::size_t>( mode )]; }
+
+	// Append another list's lines (used when merging per-thread lists)
+	void append( const DebugDrawList &other );
+
+private:
+	std::vector<DebugVertex> m_vertices[static_cast<std::size_t>( DepthMode::Count )];
+
+	void addBoxCorners( const math::Vec3f ( &corners )[8], const math::Vec4f &color, DepthMode mode );
+};
+
+// Thread-safe per-frame accumulator. add* may be called from any thread; flush is called once per frame
+// by the render thread after all emitters have finished.
+class DebugDrawBatcher
+{
+public:
+	void addLine( const math::Vec3f &start, const math::Vec3f &end, const math::Vec4f &color, DepthMode mode = DepthMode::Tested );
+	void addBox( const math::BoundingBox3Df &bounds, const math::Vec4f &color, DepthMode mode = DepthMode::Tested );
+	void addBox( const math::BoundingBox3Df &localBounds, const math::Mat4f &worldMatrix, const math::Vec4f &color, DepthMode mode = DepthMode::Tested );
+	void addSphere( const math::Vec3f &center, float radius, const math::Vec4f &color, DepthMode mode = DepthMode::Tested, std::uint32_t segments = DebugDrawList::kDefaultSphereSegments );
+	void addFrustum( const math::Mat4f &viewProjection, const math::Vec4f &color, DepthMode mode = DepthMode::Tested );
+
+	// Append a whole list under a single lock
+	void submit( const DebugDrawList &list );
+
+	// Lines accumulated so far this frame
+	std::uint32_t pendingLineCount() const;
+
+	// Move the frame's geometry into one contiguous line-list array (depth-tested lines first) and start a new
+	// frame. Output vectors are cleared and reused; empty modes produce no range.
+	void flush( std::vector<DebugVertex> &vertices, std::vector<DebugDrawRange> &ranges );
+
+	// Discard the frame's geometry without drawing it
+	void clear();
+
+	const DebugDrawStats &getLastFlushStats() const noexcept { return m_lastFlushStats; }
+
+private:
+	mutable std::mutex m_mutex;
+	DebugDrawList m_list;
+	std::uint32_t m_submissions = 0;
+	DebugDrawStats m_lastFlushStats;
+
+	template <typename Build>
+	void emit( Build &&build );
+};
+
+} // namespace engine::debug_draw
@@ -0,0 +1,173 @@
+#include "engine/descriptors/descriptor_allocator.h"
+
+#include <algorithm>
+
+namespace engine::descriptors
+{
+
+DescriptorAllocator::DescriptorAllocator( std::uint32_t persistentCapacity, std::uint32_t frameCapacity, std::uint32_t reserved )
+	: m_reserved( reserved ), m_persistent( persistentCapacity ), m_frameCapacity( frameCapacity )
+{
+}
+
+DescriptorRange DescriptorAllocator::allocate( std::uint32_t count )
+{
+	if ( count == 0 )
+	{
+		return {};
+	}
+
+	const auto allocation = m_persistent.allocate( count );
+	if ( !allocation.isValid() )
+	{
+		++m_stats.persistentFailures;
+		return {};
+	}
+
+	++m_stats.persistentAllocations;
+	m_stats.persistentDescriptors += count;
+	if ( allocation.node >= m_generations.size() )
+	{
+		m_generations.resize( allocation.node + 1, 0 );
+	}
+
+	DescriptorRange range;
+	range.index = m_reserved + allocation.offset;
+	range.count = count;
+	range.node = allocation.node;
+	range.generation = m_generations[allocation.node];
+	return range;
+}
+
+void DescriptorAllocator::free( const DescriptorRange &range, std::uint64_t fenceValue )
+{
+	if ( !m_persistent.isAllocated( range.node ) || m_generations[range.node] != range.generation )
+	{
+		return;
+	}
+
+	if ( fenceValue == 0 )
+	{
+		release( range.node );
+		return;
+	}
+
+	// Freeing twice before the fence completes must not queue the node twice
+	const bool pending = std::any_of( m_pendingFrees.begin(), m_pendingFrees.end(), [&]( const PendingFree &entry ) { return entry.node == range.node; } );
+	if ( !pending )
+	{
+		m_pendingFrees.push_back( PendingFree{ range.node, fenceValue } );
+		m_stats.pendingFrees = static_cast<std::uint32_t>( m_pendingFrees.size() );
+	}
+}
+
+DescriptorRange DescriptorAllocator::allocateFrame( std::uint32_t count )
+{
+	if ( count == 0 )
+	{
+		return {};
+	}
+
+	if ( m_frameUsed == 0 )
+	{
+		// Restart at the beginning so the whole ring is contiguous
+		m_head = 0;
+		m_tail = 0;
+	}
+
+	const bool full = m_frameUsed > 0 && m_head == m_tail;
+	std::uint32_t offset = 0;
+	std::uint32_t consumed = 0;
+	if ( full )
+	{
+		++m_stats.frameFailures;
+		return {};
+	}
+	if ( m_head >= m_tail )
+	{
+		// Free space is [head, capacity) followed by [0, tail)
+		if ( count <= m_frameCapacity - m_head )
+		{
+			offset = m_head;
+			consumed = count;
+		}
+		else if ( count <= m_tail )
+		{
+			// Skip the end of the ring; descriptor tables must be contiguous
+			offset = 0;
+			consumed = ( m_frameCapacity - m_head ) + count;
+		}
+		else
+		{
+			++m_stats.frameFailures;
+			return {};
+		}
+	}
+	else if ( count <= m_tail - m_head )
+	{
+		// Free space is [head, tail)
+		offset = m_head;
+		consumed = count;
+	}
+	else
+	{
+		++m_stats.frameFailures;
+		return {};
+	}
+
+	m_head = offset + count;
+	m_frameUsed += consumed;
+	m_openFrameCount += consumed;
+	++m_stats.frameAllocations;
+	m_stats.frameDescriptors += consumed;
+
+	DescriptorRange range;
+	range.index = getFrameRegionStart() + offset;
+	range.count = count;
+	return range;
+}
+
+void DescriptorAllocator::endFrame( std::uint64_t fenceValue )
+{
+	if ( m_openFrameCount > 0 )
+	{
+		m_inFlight.push_back( FrameRecord{ fenceValue, m_head, m_openFrameCount } );
+	}
+	m_openFrameCount = 0;
+
+	m_lastFrameStats = m_stats;
+	m_stats.frameAllocations = 0;
+	m_stats.frameDescriptors = 0;
+	m_stats.frameFailures = 0;
+}
+
+void DescriptorAllocator::reclaim( std::uint64_t completedFenceValue )
+{
+	while ( !m_inFlight.empty() && m_inFlight.front().fenceValue <= completedFenceValue )
+	{
+		const FrameRecord &frame = m_inFlight.front();
+		m_tail = frame.endHead;
+		m_frameUsed -= frame.count;
+		m_inFlight.pop_front();
+	}
+
+	std::erase_if( m_pendingFrees, [&]( const PendingFree &entry ) {
+		if ( entry.fenceValue > completedFenceValue )
+		{
+			return false;
+		}
+		release( entry.node );
+		return true;
+	} );
+	m_stats.pendingFrees = static_cast<std::uint32_t>( m_pendingFrees.size() );
+}
+
+void DescriptorAllocator::release( geometry_pool::RangeAllocator::NodeIndex node )
+{
+	--m_stats.persistentAllocations;
+	m_stats.persistentDescriptors -= m_persistent.getSize( node );
+	++m_generations[node];
+	m_persistent.free( node );
+}
+
+} // namespace engine::descriptors
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "engine/geometry_pool/range_allocator.h"
+
+// Descriptor index bookkeeping for one descriptor heap, independent of any graphics API. The heap is split
+// into three regions:
+//   [0, reserved)                     fixed slots owned by the caller (e.g. the ImGui font SRV)
+//   [reserved, reserved + persistent) long-lived ranges (texture SRVs, RTVs), allocated and freed at any time
+//   [.., reserved + persistent + frame) a linear ring for per-frame descriptor tables
+// Persistent ranges come from a TLSF range allocator, so allocation and free are O(1) and neighbours merge.
+// Freed ranges and closed frames are tagged with a fence value and only become reusable once the GPU has
+// completed it, because command lists in flight may still read the descriptors.
+namespace engine::descriptors
+{
+
+constexpr std::uint32_t kInvalidDescriptorIndex = ~0u;
+
+// Contiguous run of descriptors; index is relative to the heap start
+struct DescriptorRange
+{
+	std::uint32_t index = kInvalidDescriptorIndex;
+	std::uint32_t count = 0;
+	geometry_pool::RangeAllocator::NodeIndex node = geometry_pool::RangeAllocator::kInvalidNode; // Persistent only
+	std::uint32_t generation = 0; // Tells a stale copy from a later allocation that reused the node
+
+	bool isValid() const noexcept { return index != kInvalidDescriptorIndex; }
+};
+
+struct DescriptorAllocatorStats
+{
+	std::uint32_t persistentAllocations = 0; // Persistent ranges not yet returned, pending frees included
+	std::uint32_t persistentDescriptors = 0; // Descriptors in those ranges
+	std::uint32_t pendingFrees = 0;			 // Freed ranges waiting for their fence
+	std::uint32_t persistentFailures = 0;	 // Persistent requests that found no free range
+	std::uint32_t frameAllocations = 0;		 // Current frame only
+	std::uint32_t frameDescriptors = 0;		 // Current frame, including space skipped at the wrap point
+	std::uint32_t frameFailures = 0;		 // Current frame requests that found the ring full
+};
+
+class DescriptorAllocator
+{
+public:
+	DescriptorAllocator( std::uint32_t persistentCapacity, std::uint32_t frameCapacity, std::uint32_t reserved = 0 );
+
+	// Persistent range of count descriptors; invalid for count 0 or when no free range is large enough
+	DescriptorRange allocate( std::uint32_t count );
+
+	// Return a persistent range once the GPU completes fenceValue (0 = immediately, the range was never used).
+	// Stale copies of a range that was already freed are ignored.
+	void free( const DescriptorRange &range, std::uint64_t fenceValue );
+
+	// Range from the frame ring, valid until the fence passed to the next endFrame() completes. Invalid when the
+	// ring is full; the caller may wait for getOldestFrameFence(), reclaim() and try again.
+	DescriptorRange allocateFrame( std::uint32_t count );
+
+	// Close the frame: its ring space is reclaimed once the GPU completes fenceValue
+	void endFrame( std::uint64_t fenceValue );
+
+	// Release deferred frees and ring space of frames whose fences have completed
+	void reclaim( std::uint64_t completedFenceValue );
+
+	// Fence of the oldest frame still holding ring space, or 0 when none is in flight
+	std::uint64_t getOldestFrameFence() const noexcept { return m_inFlight.empty() ? 0 : m_inFlight.front().fenceValue; }
+
+	std::uint32_t getReservedCount() const noexcept { return m_reserved; }
+	std::uint32_t getPersistentCapacity() const noexcept { return m_persistent.getCapacity(); }
+	std::uint32_t getFrameCapacity() const noexcept { return m_frameCapacity; }
+	std::uint32_t getTotalCapacity() const noexcept { return m_reserved + m_persistent.getCapacity() + m_frameCapacity; }
+	std::uint32_t getFrameRegionStart() const noexcept { return m_reserved + m_persistent.getCapacity(); }
+
+	std::uint32_t getFrameUsed() const noexcept { return m_frameUsed; }
+	std::size_t getInFlightFrameCount() const noexcept { return m_inFlight.size(); }
+	std::uint32_t getLargestFreePersistentRange() const noexcept { return m_persistent.getLargestFreeBlock(); }
+
+	const DescriptorAllocatorStats &getStats() const noexcept { return m_stats; }
+	const DescriptorAllocatorStats &getLastFrameStats() const noexcept { return m_lastFrameStats; }
+
+private:
+	struct PendingFree
+	{
+		geometry_pool::RangeAllocator::NodeIndex node = geometry_pool::RangeAllocator::kInvalidNode;
+		std::uint64_t fenceValue = 0;
+	};
+
+	struct FrameRecord
+	{
+		std::uint64_t fenceValue = 0;
+		std::uint32_t endHead = 0; // Ring head when the frame closed
+		std::uint32_t count = 0;   // Descriptors consumed, including wrap waste
+	};
+
+	std::uint32_t m_reserved = 0;
+	geometry_pool::RangeAllocator m_persistent;
+	std::vector<std::uint32_t> m_generations; // Per range allocator node, bumped on every free
+	std::vector<PendingFree> m_pendingFrees;
+
+	// Used ring region is [tail, head) modulo capacity; m_frameUsed disambiguates empty from full
+	std::uint32_t m_frameCapacity = 0;
+	std::uint32_t m_head = 0;
+	std::uint32_t m_tail = 0;
+	std::uint32_t m_frameUsed = 0;
+	std::uint32_t m_openFrameCount = 0;
+	std::deque<FrameRecord> m_inFlight;
+
+	DescriptorAllocatorStats m_stats;
+	DescriptorAllocatorStats m_lastFrameStats;
+
+	void release( geometry_pool::RangeAllocator::NodeIndex node );
+};
+
+} // namespace engine::descriptors
@@ -0,0 +1,291 @@
+#include "engine/frame_graph/d3d12_frame_graph_backend.h"
+
+#include <algorithm>
+#include <string>
+
+#include "platform/dx12/dx12_device.h"
+#include "runtime/console.h"
+
+namespace engine::frame_graph
+{
+
+namespace
+{
+constexpr std::uint32_t kNoSlot = ~0u;
+
+bool sameTexture( const TextureDesc &a, const TextureDesc &b ) noexcept
+{
+	return a.width == b.width && a.height == b.height && a.format == b.format && a.flags == b.flags;
+}
+
+D3D12_RESOURCE_DESC makeResourceDesc( std::uint32_t width, std::uint32_t height, DXGI_FORMAT format, D3D12_RESOURCE_FLAGS flags )
+{
+	D3D12_RESOURCE_DESC desc = {};
+	desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	desc.Width = width;
+	desc.Height = height;
+	desc.DepthOrArraySize = 1;
+	desc.MipLevels = 1;
+	desc.Format = format;
+	desc.SampleDesc.Count = 1;
+	desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+	desc.Flags = flags;
+	return desc;
+}
+} // namespace
+
+ResourceHandle D3D12FrameGraphBackend::importTexture( FrameGraph &graph, const char *name, dx12::Texture &texture, ResourceState finalState )
+{
+	const ResourceHandle handle = graph.importResource( name, fromD3D12State( texture.getState() ), finalState );
+	m_imports[handle] = &texture;
+	return handle;
+}
+
+TextureDesc D3D12FrameGraphBackend::describeTexture( std::uint32_t width, std::uint32_t height, DXGI_FORMAT format, D3D12_RESOURCE_FLAGS flags ) const
+{
+	TextureDesc desc;
+	desc.width = width;
+	desc.height = height;
+	desc.format = static_cast<std::uint32_t>( format );
+	desc.flags = static_cast<std::uint32_t>( flags );
+	if ( m_device.get() )
+	{
+		const auto resourceDesc = makeResourceDesc( width, height, format, flags );
+		const auto info = m_device->GetResourceAllocationInfo( 0, 1, &resourceDesc );
+		desc.sizeBytes = info.SizeInBytes;
+		desc.alignment = info.Alignment;
+	}
+	return desc;
+}
+
+ID3D12Resource *D3D12FrameGraphBackend::getResource( ResourceHandle resource ) const noexcept
+{
+	if ( const auto it = m_imports.find( resource ); it != m_imports.end() )
+	{
+		return it->second->getResource();
+	}
+	if ( resource < m_transientSlots.size() && m_transientSlots[resource] != kNoSlot )
+	{
+		return m_placed[m_transientSlots[resource]].resource.Get();
+	}
+	return nullptr;
+}
+
+bool D3D12FrameGraphBackend::allocateTransients( const FrameGraph &graph )
+{
+	releaseRetired();
+	m_transientSlots.assign( graph.getResourceCount(), kNoSlot );
+	const auto &stats = graph.getStats();
+	if ( stats.allocatedTransients == 0 )
+	{
+		return true;
+	}
+	if ( !m_device.get() )
+	{
+		return false;
+	}
+
+	// Grow only: placed resources die with their heap, and the GPU may still be using both
+	if ( stats.heapBytes > m_heapSize )
+	{
+		retirePlaced( true );
+		if ( m_heap )
+		{
+			m_retired.push_back( Retired{ std::move( m_heap ), {}, m_device.getCurrentFenceValue() } );
+		}
+		m_heapSize = 0;
+
+		D3D12_HEAP_DESC heapDesc = {};
+		heapDesc.SizeInBytes = ( stats.heapBytes + kDefaultPlacementAlignment - 1 ) / kDefaultPlacementAlignment * kDefaultPlacementAlignment;
+		heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+		heapDesc.Alignment = kDefaultPlacementAlignment;
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+		if ( FAILED( m_device->CreateHeap( &heapDesc, IID_PPV_ARGS( &m_heap ) ) ) )
+		{
+			console::error( "D3D12FrameGraphBackend: failed to create {} byte transient heap", heapDesc.SizeInBytes );
+			m_heap.Reset();
+			return false;
+		}
+		m_heap->SetName( L"Frame Graph Transients" );
+		m_heapSize = heapDesc.SizeInBytes;
+	}
+
+	// Reuse placed resources whose offset and description still match; create the rest
+	for ( auto &placed : m_placed )
+	{
+		placed.used = false;
+	}
+	std::vector<PlacedResource> kept;
+	kept.reserve( stats.allocatedTransients );
+	for ( ResourceHandle handle = 0; handle < graph.getResourceCount(); ++handle )
+	{
+		if ( !graph.isAllocated( handle ) )
+		{
+			continue;
+		}
+		const auto &desc = graph.getDesc( handle );
+		const std::uint64_t offset = graph.getHeapOffset( handle );
+		const auto match = std::find_if( m_placed.begin(), m_placed.end(), [&]( const PlacedResource &placed ) {
+			return !placed.used && placed.offset == offset && sameTexture( placed.desc, desc );
+		} );
+		if ( match != m_placed.end() )
+		{
+			match->used = true;
+			kept.push_back( *match );
+		}
+		else
+		{
+			const auto flags = static_cast<D3D12_RESOURCE_FLAGS>( desc.flags );
+			const auto resourceDesc = makeResourceDesc( desc.width, desc.height, static_cast<DXGI_FORMAT>( desc.format ), flags );
+			PlacedResource placed;
+			placed.offset = offset;
+			placed.desc = desc;
+			placed.used = true;
+			placed.state = ( flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL ) ? D3D12_RESOURCE_STATE_DEPTH_WRITE :
+				( flags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET ) ? D3D12_RESOURCE_STATE_RENDER_TARGET :
+																	  D3D12_RESOURCE_STATE_COMMON;
+			if ( FAILED( m_device->CreatePlacedResource( m_heap.Get(), offset, &resourceDesc, placed.state, nullptr, IID_PPV_ARGS( &placed.resource ) ) ) )
+			{
+				console::error( "D3D12FrameGraphBackend: failed to place transient '{}' at offset {}", graph.getResourceName( handle ), offset );
+				return false;
+			}
+			const auto &name = graph.getResourceName( handle );
+			placed.resource->SetName( std::wstring( name.begin(), name.end() ).c_str() );
+			kept.push_back( std::move( placed ) );
+		}
+		m_transientSlots[handle] = static_cast<std::uint32_t>( kept.size() - 1 );
+	}
+
+	retirePlaced( false );
+	m_placed = std::move( kept );
+	return true;
+}
+
+void D3D12FrameGraphBackend::resourceBarriers( std::span<const Barrier> barriers )
+{
+	if ( !m_commandList )
+	{
+		return;
+	}
+
+	for ( const auto &barrier : barriers )
+	{
+		if ( barrier.type == Barrier::Type::Aliasing )
+		{
+			D3D12_RESOURCE_BARRIER aliasing = {};
+			aliasing.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+			aliasing.Aliasing.pResourceBefore = getResource( barrier.aliasedFrom );
+			aliasing.Aliasing.pResourceAfter = getResource( barrier.resource );
+			m_batch.push_back( aliasing );
+			continue;
+		}
+
+		// Imported textures track their own state; keep it in sync by transitioning through them
+		if ( const auto it = m_imports.find( barrier.resource ); it != m_imports.end() )
+		{
+			flushBatch();
+			it->second->transitionTo( m_commandList, toD3D12State( barrier.after ) );
+			continue;
+		}
+
+		// Transients use the state they were left in, which differs from 'before' on a first use
+		if ( barrier.resource >= m_transientSlots.size() || m_transientSlots[barrier.resource] == kNoSlot )
+		{
+			continue;
+		}
+		auto &placed = m_placed[m_transientSlots[barrier.resource]];
+		const D3D12_RESOURCE_STATES after = toD3D12State( barrier.after );
+		if ( placed.state != after )
+		{
+			D3D12_RESOURCE_BARRIER transition = {};
+			transition.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+			transition.Transition.pResource = placed.resource.Get();
+			transition.Transition.StateBefore = placed.state;
+			transition.Transition.StateAfter = after;
+			transition.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+			m_batch.push_back( transition );
+			placed.state = after;
+		}
+	}
+	flushBatch();
+}
+
+D3D12_RESOURCE_STATES D3D12FrameGraphBackend::toD3D12State( ResourceState state ) noexcept
+{
+	D3D12_RESOURCE_STATES result = D3D12_RESOURCE_STATE_COMMON;
+	if ( hasState( state, ResourceState::RenderTarget ) )
+		result |= D3D12_RESOURCE_STATE_RENDER_TARGET;
+	if ( hasState( state, ResourceState::DepthWrite ) )
+		result |= D3D12_RESOURCE_STATE_DEPTH_WRITE;
+	if ( hasState( state, ResourceState::CopyDest ) )
+		result |= D3D12_RESOURCE_STATE_COPY_DEST;
+	if ( hasState( state, ResourceState::DepthRead ) )
+		result |= D3D12_RESOURCE_STATE_DEPTH_READ;
+	if ( hasState( state, ResourceState::ShaderResource ) )
+		result |= D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+	if ( hasState( state, ResourceState::CopySource ) )
+		result |= D3D12_RESOURCE_STATE_COPY_SOURCE;
+	return result;
+}
+
+ResourceState D3D12FrameGraphBackend::fromD3D12State( D3D12_RESOURCE_STATES state ) noexcept
+{
+	switch ( state )
+	{
+	case D3D12_RESOURCE_STATE_RENDER_TARGET:
+		return ResourceState::RenderTarget;
+	case D3D12_RESOURCE_STATE_DEPTH_WRITE:
+		return ResourceState::DepthWrite;
+	case D3D12_RESOURCE_STATE_COPY_DEST:
+		return ResourceState::CopyDest;
+	default:
+		break;
+	}
+
+	ResourceState result = ResourceState::Undefined;
+	if ( state & D3D12_RESOURCE_STATE_DEPTH_READ )
+		result = result | ResourceState::DepthRead;
+	if ( state & ( D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE ) )
+		result = result | ResourceState::ShaderResource;
+	if ( state & D3D12_RESOURCE_STATE_COPY_SOURCE )
+		result = result | ResourceState::CopySource;
+	return result;
+}
+
+void D3D12FrameGraphBackend::releaseRetired()
+{
+	const std::uint64_t completed = m_device.getCompletedFenceValue();
+	std::erase_if( m_retired, [completed]( const Retired &retired ) { return retired.fenceValue <= completed; } );
+}
+
+void D3D12FrameGraphBackend::retirePlaced( bool includeUsed )
+{
+	Retired retired;
+	retired.fenceValue = m_device.getCurrentFenceValue();
+	for ( auto &placed : m_placed )
+	{
+		if ( includeUsed || !placed.used )
+		{
+			retired.resources.push_back( std::move( placed.resource ) );
+		}
+	}
+	if ( includeUsed )
+	{
+		m_placed.clear();
+	}
+	if ( !retired.resources.empty() )
+	{
+		m_retired.push_back( std::move( retired ) );
+	}
+}
+
+void D3D12FrameGraphBackend::flushBatch()
+{
+	if ( !m_batch.empty() )
+	{
+		m_commandList->ResourceBarrier( static_cast<UINT>( m_batch.size() ), m_batch.data() );
+		m_batch.clear();
+	}
+}
+
+} // namespace engine::frame_graph
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <d3d12.h>
+#include <unordered_map>
+#include <vector>
+#include <wrl.h>
+
+#include "engine/frame_graph/frame_graph.h"
+
+namespace dx12
+{
+class Device;
+class Texture;
+} // namespace dx12
+
+namespace engine::frame_graph
+{
+
+// Executes frame graphs on a D3D12 command list. Imported resources are dx12::Texture objects whose
+// tracked state follows the graph's barriers; transients are placed resources in one default heap that
+// grows to the largest aliased heap a compiled graph asked for. Placed resources are cached by offset
+// and description, so a graph that declares the same transients each frame creates nothing new.
+class D3D12FrameGraphBackend final : public FrameGraphBackend
+{
+public:
+	explicit D3D12FrameGraphBackend( dx12::Device &device ) noexcept : m_device( device ) {}
+	~D3D12FrameGraphBackend() override = default;
+
+	D3D12FrameGraphBackend( const D3D12FrameGraphBackend & ) = delete;
+	D3D12FrameGraphBackend &operator=( const D3D12FrameGraphBackend & ) = delete;
+
+	// Barriers of the next execute() are recorded on this command list
+	void setCommandList( ID3D12GraphicsCommandList *commandList ) noexcept { m_commandList = commandList; }
+
+	// Import a texture in its current state; call clearImports() before declaring the next frame
+	ResourceHandle importTexture( FrameGraph &graph, const char *name, dx12::Texture &texture, ResourceState finalState = ResourceState::Undefined );
+	void clearImports() noexcept { m_imports.clear(); }
+
+	// Transient render target or depth texture description with the device's exact size and alignment
+	TextureDesc describeTexture( std::uint32_t width, std::uint32_t height, DXGI_FORMAT format, D3D12_RESOURCE_FLAGS flags ) const;
+
+	// Resource behind a graph handle during execute(), imported or transient
+	ID3D12Resource *getResource( ResourceHandle resource ) const noexcept;
+
+	bool allocateTransients( const FrameGraph &graph ) override;
+	void resourceBarriers( std::span<const Barrier> barriers ) override;
+
+	std::uint64_t getHeapSize() const noexcept { return m_heapSize; }
+
+	static D3D12_RESOURCE_STATES toD3D12State( ResourceState state ) noexcept;
+	static ResourceState fromD3D12State( D3D12_RESOURCE_STATES state ) noexcept;
+
+private:
+	struct PlacedResource
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		std::uint64_t offset = 0;
+		TextureDesc desc;
+		D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+		bool used = false; // Bound to a transient of the current graph
+	};
+
+	// Objects the GPU may still reference, released once the frame fence passes fenceValue
+	struct Retired
+	{
+		Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> resources;
+		std::uint64_t fenceValue = 0;
+	};
+
+	dx12::Device &m_device;
+	ID3D12GraphicsCommandList *m_commandList = nullptr;
+	Microsoft::WRL::ComPtr<ID3D12Heap> m_heap;
+	std::uint64_t m_heapSize = 0;
+	std::vector<PlacedResource> m_placed;
+	std::vector<std::uint32_t> m_transientSlots; // Graph resource -> m_placed index
+	std::unordered_map<ResourceHandle, dx12::Texture *> m_imports;
+	std::vector<Retired> m_retired;
+	std::vector<D3D12_RESOURCE_BARRIER> m_batch;
+
+	void releaseRetired();
+	void retirePlaced( bool includeUsed );
+	void flushBatch();
+};
+
+} // namespace engine::frame_graph
@@ -0,0 +1,535 @@
+#include "engine/frame_graph/frame_graph.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace engine::frame_graph
+{
+
+namespace
+{
+std::uint64_t alignUp( std::uint64_t value, std::uint64_t alignment ) noexcept
+{
+	return alignment > 1 ? ( value + alignment - 1 ) / alignment * alignment : value;
+}
+} // namespace
+
+void FrameGraph::reset()
+{
+	m_passes.clear();
+	m_resources.clear();
+	m_order.clear();
+	m_barriers.clear();
+	m_finalBarrierStart = 0;
+	m_stats = {};
+	m_error.clear();
+	m_compiled = false;
+}
+
+ResourceHandle FrameGraph::importResource( std::string_view name, ResourceState initialState, ResourceState finalState )
+{
+	Resource resource;
+	resource.name = name;
+	resource.imported = true;
+	resource.initialState = initialState;
+	resource.finalState = finalState;
+	m_resources.push_back( std::move( resource ) );
+	m_compiled = false;
+	return static_cast<ResourceHandle>( m_resources.size() - 1 );
+}
+
+ResourceHandle FrameGraph::createTransient( std::string_view name, const TextureDesc &desc )
+{
+	Resource resource;
+	resource.name = name;
+	resource.desc = desc;
+	m_resources.push_back( std::move( resource ) );
+	m_compiled = false;
+	return static_cast<ResourceHandle>( m_resources.size() - 1 );
+}
+
+PassHandle FrameGraph::addPass( std::string_view name, ExecuteFn execute )
+{
+	Pass pass;
+	pass.name = name;
+	pass.execute = std::move( execute );
+	m_passes.push_back( std::move( pass ) );
+	m_compiled = false;
+	return static_cast<PassHandle>( m_passes.size() - 1 );
+}
+
+void FrameGraph::read( PassHandle pass, ResourceHandle resource, ResourceState state )
+{
+	addAccess( pass, resource, state, false );
+}
+
+void FrameGraph::write( PassHandle pass, ResourceHandle resource, ResourceState state )
+{
+	addAccess( pass, resource, state, true );
+}
+
+void FrameGraph::setSideEffects( PassHandle pass )
+{
+	if ( pass < m_passes.size() )
+	{
+		m_passes[pass].sideEffects = true;
+		m_compiled = false;
+	}
+}
+
+void FrameGraph::addAccess( PassHandle pass, ResourceHandle resource, ResourceState state, bool write )
+{
+	m_compiled = false;
+	if ( pass >= m_passes.size() || resource >= m_resources.size() )
+	{
+		fail( "access to invalid pass " + std::to_string( pass ) + " or resource " + std::to_string( resource ) );
+		return;
+	}
+	auto &passEntry = m_passes[pass];
+	auto &resourceEntry = m_resources[resource];
+	if ( write == isReadOnlyState( state ) || state == ResourceState::Undefined )
+	{
+		fail( "pass '" + passEntry.name + ( write ? "' writes '" : "' reads '" ) + resourceEntry.name + ( write ? "' in a read-only state" : "' in a write state" ) );
+		return;
+	}
+
+	// One access per resource and pass: repeated reads combine, anything else conflicts
+	for ( auto &access : passEntry.accesses )
+	{
+		if ( access.resource != resource )
+		{
+			continue;
+		}
+		if ( !access.write && !write )
+		{
+			access.state = access.state | state;
+		}
+		else if ( access.write != write || access.state != state )
+		{
+			fail( "pass '" + passEntry.name + "' uses '" + resourceEntry.name + "' in conflicting states" );
+		}
+		return;
+	}
+
+	passEntry.accesses.push_back( Access{ resource, state, write } );
+	( write ? resourceEntry.writers : resourceEntry.readers ).push_back( pass );
+}
+
+void FrameGraph::fail( std::string message )
+{
+	if ( m_error.empty() )
+	{
+		m_error = std::move( message );
+	}
+}
+
+bool FrameGraph::compile()
+{
+	m_order.clear();
+	m_barriers.clear();
+	m_finalBarrierStart = 0;
+	m_stats = {};
+	m_compiled = false;
+	if ( !m_error.empty() )
+	{
+		return false;
+	}
+	for ( const auto &resource : m_resources )
+	{
+		if ( !resource.imported && resource.desc.sizeBytes == 0 )
+		{
+			fail( "transient '" + resource.name + "' has no size" );
+			return false;
+		}
+	}
+
+	cullPasses();
+	if ( !sortPasses() )
+	{
+		return false;
+	}
+	placeTransients();
+	computeBarriers();
+
+	m_stats.passes = static_cast<std::uint32_t>( m_passes.size() );
+	m_stats.culledPasses = m_stats.passes - static_cast<std::uint32_t>( m_order.size() );
+	m_stats.resources = static_cast<std::uint32_t>( m_resources.size() );
+	m_compiled = true;
+	return true;
+}
+
+void FrameGraph::cullPasses()
+{
+	// Roots: passes with side effects and passes writing resources owned outside the graph
+	std::vector<PassHandle> worklist;
+	for ( PassHandle pass = 0; pass < m_passes.size(); ++pass )
+	{
+		auto &entry = m_passes[pass];
+		entry.culled = !entry.sideEffects &&
+			std::none_of( entry.accesses.begin(), entry.accesses.end(), [this]( const Access &access ) {
+				return access.write && m_resources[access.resource].imported;
+			} );
+		if ( !entry.culled )
+		{
+			worklist.push_back( pass );
+		}
+	}
+
+	// A live pass keeps every writer of what it reads, and the earlier writers of what it writes
+	const auto keep = [this, &worklist]( PassHandle pass ) {
+		if ( m_passes[pass].culled )
+		{
+			m_passes[pass].culled = false;
+			worklist.push_back( pass );
+		}
+	};
+	while ( !worklist.empty() )
+	{
+		const PassHandle pass = worklist.back();
+		worklist.pop_back();
+		for ( const auto &access : m_passes[pass].accesses )
+		{
+			for ( const PassHandle writer : m_resources[access.resource].writers )
+			{
+				if ( access.write && writer == pass )
+				{
+					break;
+				}
+				keep( writer );
+			}
+		}
+	}
+}
+
+bool FrameGraph::sortPasses()
+{
+	// Edges: writer -> next writer of the same resource, and every writer -> every reader
+	std::vector<std::vector<PassHandle>> successors( m_passes.size() );
+	std::vector<std::uint32_t> predecessorCount( m_passes.size(), 0 );
+	const auto addEdge = [&]( PassHandle from, PassHandle to ) {
+		successors[from].push_back( to );
+		++predecessorCount[to];
+	};
+	for ( const auto &resource : m_resources )
+	{
+		PassHandle previousWriter = kInvalidPass;
+		for ( const PassHandle writer : resource.writers )
+		{
+			if ( m_passes[writer].culled )
+			{
+				continue;
+			}
+			if ( previousWriter != kInvalidPass )
+			{
+				addEdge( previousWriter, writer );
+			}
+			previousWriter = writer;
+			for ( const PassHandle reader : resource.readers )
+			{
+				if ( !m_passes[reader].culled )
+				{
+					addEdge( writer, reader );
+				}
+			}
+		}
+	}
+
+	// Kahn's algorithm; among ready passes the earliest declared runs first, so the order is deterministic
+	std::priority_queue<PassHandle, std::vector<PassHandle>, std::greater<PassHandle>> ready;
+	std::uint32_t aliveCount = 0;
+	for ( PassHandle pass = 0; pass < m_passes.size(); ++pass )
+	{
+		if ( !m_passes[pass].culled )
+		{
+			++aliveCount;
+			if ( predecessorCount[pass] == 0 )
+			{
+				ready.push( pass );
+			}
+		}
+	}
+	while ( !ready.empty() )
+	{
+		const PassHandle pass = ready.top();
+		ready.pop();
+		m_order.push_back( pass );
+		for ( const PassHandle next : successors[pass] )
+		{
+			if ( --predecessorCount[next] == 0 )
+			{
+				ready.push( next );
+			}
+		}
+	}
+
+	if ( m_order.size() != aliveCount )
+	{
+		for ( PassHandle pass = 0; pass < m_passes.size(); ++pass )
+		{
+			if ( !m_passes[pass].culled && predecessorCount[pass] > 0 )
+			{
+				fail( "dependency cycle through pass '" + m_passes[pass].name + "'" );
+				break;
+			}
+		}
+		m_order.clear();
+		return false;
+	}
+	return true;
+}
+
+void FrameGraph::placeTransients()
+{
+	for ( auto &resource : m_resources )
+	{
+		resource.allocated = false;
+		resource.heapOffset = 0;
+	}
+	for ( std::uint32_t position = 0; position < m_order.size(); ++position )
+	{
+		for ( const auto &access : m_passes[m_order[position]].accesses )
+		{
+			auto &resource = m_resources[access.resource];
+			if ( !resource.allocated )
+			{
+				resource.allocated = true;
+				resource.firstUse = position;
+			}
+			resource.lastUse = position;
+		}
+	}
+
+	std::vector<ResourceHandle> transients;
+	for ( ResourceHandle handle = 0; handle < m_resources.size(); ++handle )
+	{
+		auto &resource = m_resources[handle];
+		if ( resource.imported )
+		{
+			resource.allocated = false;
+			continue;
+		}
+		++m_stats.transients;
+		if ( resource.allocated )
+		{
+			transients.push_back( handle );
+			m_stats.transientBytes += resource.desc.sizeBytes;
+		}
+	}
+	m_stats.allocatedTransients = static_cast<std::uint32_t>( transients.size() );
+
+	// Largest first, each at the lowest offset that is free for its whole lifetime
+	std::sort( transients.begin(), transients.end(), [this]( ResourceHandle a, ResourceHandle b ) {
+		const auto &ra = m_resources[a];
+		const auto &rb = m_resources[b];
+		if ( ra.desc.sizeBytes != rb.desc.sizeBytes )
+		{
+			return ra.desc.sizeBytes > rb.desc.sizeBytes;
+		}
+		return ra.firstUse != rb.firstUse ? ra.firstUse < rb.firstUse : a < b;
+	} );
+
+	struct Range
+	{
+		std::uint64_t begin;
+		std::uint64_t end;
+	};
+	std::vector<Range> occupied;
+	for ( std::size_t i = 0; i < transients.size(); ++i )
+	{
+		auto &resource = m_resources[transients[i]];
+		occupied.clear();
+		for ( std::size_t j = 0; j < i; ++j )
+		{
+			const auto &placed = m_resources[transients[j]];
+			if ( placed.firstUse <= resource.lastUse && resource.firstUse <= placed.lastUse )
+			{
+				occupied.push_back( Range{ placed.heapOffset, placed.heapOffset + placed.desc.sizeBytes } );
+			}
+		}
+		std::sort( occupied.begin(), occupied.end(), []( const Range &a, const Range &b ) { return a.begin < b.begin; } );
+
+		std::uint64_t offset = 0;
+		for ( const auto &range : occupied )
+		{
+			if ( offset + resource.desc.sizeBytes <= range.begin )
+			{
+				break;
+			}
+			offset = std::max( offset, alignUp( range.end, resource.desc.alignment ) );
+		}
+		resource.heapOffset = offset;
+		m_stats.heapBytes = std::max( m_stats.heapBytes, offset + resource.desc.sizeBytes );
+	}
+}
+
+void FrameGraph::computeBarriers()
+{
+	struct Usage
+	{
+		std::uint32_t position;
+		ResourceState state;
+		bool write;
+	};
+	std::vector<std::vector<Usage>> usages( m_resources.size() );
+	for ( std::uint32_t position = 0; position < m_order.size(); ++position )
+	{
+		for ( const auto &access : m_passes[m_order[position]].accesses )
+		{
+			usages[access.resource].push_back( Usage{ position, access.state, access.write } );
+		}
+	}
+
+	struct Pending
+	{
+		std::uint32_t position;
+		Barrier barrier;
+	};
+	std::vector<Pending> pending;
+	const std::uint32_t finalPosition = static_cast<std::uint32_t>( m_order.size() );
+	for ( ResourceHandle handle = 0; handle < m_resources.size(); ++handle )
+	{
+		const auto &resource = m_resources[handle];
+		const auto &uses = usages[handle];
+		ResourceState state = resource.imported ? resource.initialState : ResourceState::Undefined;
+
+		// Memory previously used by a transient whose lifetime ended needs an aliasing barrier first
+		if ( resource.allocated )
+		{
+			ResourceHandle previous = kInvalidResource;
+			for ( ResourceHandle other = 0; other < m_resources.size(); ++other )
+			{
+				const auto &candidate = m_resources[other];
+				const bool overlaps = candidate.allocated && candidate.lastUse < resource.firstUse &&
+					candidate.heapOffset < resource.heapOffset + resource.desc.sizeBytes &&
+					resource.heapOffset < candidate.heapOffset + candidate.desc.sizeBytes;
+				if ( overlaps && ( previous == kInvalidResource || candidate.lastUse > m_resources[previous].lastUse ) )
+				{
+					previous = other;
+				}
+			}
+			if ( previous != kInvalidResource )
+			{
+				pending.push_back( Pending{ resource.firstUse, Barrier{ Barrier::Type::Aliasing, handle, ResourceState::Undefined, ResourceState::Undefined, previous } } );
+			}
+		}
+
+		for ( std::size_t i = 0; i < uses.size(); )
+		{
+			// Consecutive reads share one transition to the combined read state
+			ResourceState target = uses[i].state;
+			std::size_t next = i + 1;
+			if ( !uses[i].write )
+			{
+				const bool covered = isReadOnlyState( state ) && hasState( state, target );
+				while ( next < uses.size() && !uses[next].write )
+				{
+					target = target | uses[next].state;
+					++next;
+				}
+				if ( covered && hasState( state, target ) )
+				{
+					target = state;
+				}
+			}
+			if ( state != target )
+			{
+				pending.push_back( Pending{ uses[i].position, Barrier{ Barrier::Type::Transition, handle, state, target } } );
+				state = target;
+			}
+			i = next;
+		}
+
+		if ( resource.imported && resource.finalState != ResourceState::Undefined && state != resource.finalState )
+		{
+			pending.push_back( Pending{ finalPosition, Barrier{ Barrier::Type::Transition, handle, state, resource.finalState } } );
+		}
+	}
+
+	// Aliasing barriers go ahead of the transitions recorded before the same pass
+	std::stable_sort( pending.begin(), pending.end(), []( const Pending &a, const Pending &b ) {
+		if ( a.position != b.position )
+		{
+			return a.position < b.position;
+		}
+		return a.barrier.type == Barrier::Type::Aliasing && b.barrier.type != Barrier::Type::Aliasing;
+	} );
+
+	for ( auto &pass : m_passes )
+	{
+		pass.firstBarrier = 0;
+		pass.barrierCount = 0;
+	}
+	std::size_t cursor = 0;
+	for ( std::uint32_t position = 0; position <= finalPosition; ++position )
+	{
+		const auto first = static_cast<std::uint32_t>( m_barriers.size() );
+		for ( ; cursor < pending.size() && pending[cursor].position == position; ++cursor )
+		{
+			const auto &barrier = pending[cursor].barrier;
+			if ( barrier.type == Barrier::Type::Aliasing )
+			{
+				++m_stats.aliasingBarriers;
+			}
+			else if ( barrier.before == ResourceState::Undefined )
+			{
+				++m_stats.discardBarriers;
+			}
+			else
+			{
+				++m_stats.transitionBarriers;
+			}
+			m_barriers.push_back( barrier );
+		}
+		if ( position < finalPosition )
+		{
+			auto &pass = m_passes[m_order[position]];
+			pass.firstBarrier = first;
+			pass.barrierCount = static_cast<std::uint32_t>( m_barriers.size() ) - first;
+		}
+		else
+		{
+			m_finalBarrierStart = first;
+		}
+	}
+}
+
+std::span<const Barrier> FrameGraph::getBarriers( PassHandle pass ) const noexcept
+{
+	const auto &entry = m_passes[pass];
+	return std::span<const Barrier>( m_barriers ).subspan( entry.firstBarrier, entry.barrierCount );
+}
+
+std::span<const Barrier> FrameGraph::getFinalBarriers() const noexcept
+{
+	return std::span<const Barrier>( m_barriers ).subspan( m_finalBarrierStart );
+}
+
+bool FrameGraph::execute( FrameGraphBackend &backend ) const
+{
+	if ( !m_compiled || !backend.allocateTransients( *this ) )
+	{
+		return false;
+	}
+
+	for ( const PassHandle handle : m_order )
+	{
+		const auto &pass = m_passes[handle];
+		if ( pass.barrierCount > 0 )
+		{
+			backend.resourceBarriers( getBarriers( handle ) );
+		}
+		if ( pass.execute )
+		{
+			pass.execute();
+		}
+	}
+
+	const auto finalBarriers = getFinalBarriers();
+	if ( !finalBarriers.empty() )
+	{
+		backend.resourceBarriers( finalBarriers );
+	}
+	return true;
+}
+
+} // namespace engine::frame_graph
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Frame graph: passes declare which resources they read and write, and compile() turns the declarations
+// into an executable frame. It orders passes by their dependencies, culls passes whose results nobody
+// uses, computes the minimal resource state transitions and places transient resources with
+// non-overlapping lifetimes at the same offset of one shared heap. Compilation is pure CPU; executing
+// the compiled frame goes through FrameGraphBackend, which owns the real GPU resources and barriers.
+//
+// Dependency model: a resource's writers run in declaration order, and its readers run after all of
+// them. Passes may therefore be added in any order. A write loads the existing contents (draw on top),
+// so earlier writers of a resource stay alive while a later one does. For ping-pong, declare a second
+// resource rather than reading and rewriting one.
+namespace engine::frame_graph
+{
+
+using ResourceHandle = std::uint32_t;
+using PassHandle = std::uint32_t;
+constexpr ResourceHandle kInvalidResource = ~0u;
+constexpr PassHandle kInvalidPass = ~0u;
+
+// Resource usage states; read-only states can be combined with |
+enum class ResourceState : std::uint32_t
+{
+	Undefined = 0, // Contents are discarded (a transient before its first use)
+	RenderTarget = 1u << 0,
+	DepthWrite = 1u << 1,
+	CopyDest = 1u << 2,
+	DepthRead = 1u << 3,
+	ShaderResource = 1u << 4,
+	CopySource = 1u << 5
+};
+
+constexpr ResourceState operator|( ResourceState a, ResourceState b ) noexcept
+{
+	return static_cast<ResourceState>( static_cast<std::uint32_t>( a ) | static_cast<std::uint32_t>( b ) );
+}
+
+constexpr bool hasState( ResourceState states, ResourceState state ) noexcept
+{
+	return ( static_cast<std::uint32_t>( states ) & static_cast<std::uint32_t>( state ) ) == static_cast<std::uint32_t>( state );
+}
+
+constexpr bool isReadOnlyState( ResourceState state ) noexcept
+{
+	constexpr std::uint32_t kWriteStates = static_cast<std::uint32_t>( ResourceState::RenderTarget ) |
+		static_cast<std::uint32_t>( ResourceState::DepthWrite ) | static_cast<std::uint32_t>( ResourceState::CopyDest );
+	return state != ResourceState::Undefined && ( static_cast<std::uint32_t>( state ) & kWriteStates ) == 0;
+}
+
+// Placed resources are 64 KB aligned unless the backend reports otherwise
+constexpr std::uint64_t kDefaultPlacementAlignment = 64 * 1024;
+
+// Transient texture description. sizeBytes and alignment come from the backend (e.g.
+// GetResourceAllocationInfo) so placement stays exact while compilation needs no device.
+struct TextureDesc
+{
+	std::uint32_t width = 0;
+	std::uint32_t height = 0;
+	std::uint32_t format = 0; // Backend format value (DXGI_FORMAT)
+	std::uint32_t flags = 0;  // Backend usage flags (D3D12_RESOURCE_FLAGS)
+	std::uint64_t sizeBytes = 0;
+	std::uint64_t alignment = kDefaultPlacementAlignment;
+};
+
+struct Barrier
+{
+	enum class Type : std::uint8_t
+	{
+		Transition, // before == Undefined: first use of a transient, contents discarded
+		Aliasing	// resource takes over heap memory last used by aliasedFrom
+	};
+
+	Type type = Type::Transition;
+	ResourceHandle resource = kInvalidResource;
+	ResourceState before = ResourceState::Undefined;
+	ResourceState after = ResourceState::Undefined;
+	ResourceHandle aliasedFrom = kInvalidResource;
+};
+
+struct FrameGraphStats
+{
+	std::uint32_t passes = 0;
+	std::uint32_t culledPasses = 0;
+	std::uint32_t resources = 0;
+	std::uint32_t transients = 0;
+	std::uint32_t allocatedTransients = 0; // Transients used by a pass that survived culling
+	std::uint32_t transitionBarriers = 0;  // Transitions between known states
+	std::uint32_t discardBarriers = 0;	   // First uses of transients (transition from Undefined)
+	std::uint32_t aliasingBarriers = 0;
+	std::uint64_t transientBytes = 0; // Sum of allocated transient sizes, as if each had its own memory
+	std::uint64_t heapBytes = 0;	  // Heap size after aliasing
+
+	std::uint64_t aliasingSavedBytes() const noexcept { return transientBytes - heapBytes; }
+};
+
+class FrameGraph;
+
+// Backend hook that owns the GPU resources and records barriers
+class FrameGraphBackend
+{
+public:
+	virtual ~FrameGraphBackend() = default;
+
+	// Create or reuse memory for the allocated transients (see FrameGraph::getHeapOffset); false skips the frame
+	virtual bool allocateTransients( const FrameGraph &graph ) = 0;
+
+	// Record a batch of barriers; called before each pass that needs them and once after the last pass
+	virtual void resourceBarriers( std::span<const Barrier> barriers ) = 0;
+};
+
+class FrameGraph
+{
+public:
+	using ExecuteFn = std::function<void()>;
+
+	// Drop all passes and resources; capacity is kept for the next frame's declarations
+	void reset();
+
+	// External resource (e.g. a viewport render target) in initialState. A finalState other than Undefined
+	// is restored after the last pass. Passes writing imported resources are never culled.
+	ResourceHandle importResource( std::string_view name, ResourceState initialState, ResourceState finalState = ResourceState::Undefined );
+
+	// Frame-local resource whose memory may be shared with transients of disjoint lifetime.
+	// Its contents are undefined at the first use, so the first writer must clear or fully overwrite it.
+	ResourceHandle createTransient( std::string_view name, const TextureDesc &desc );
+
+	PassHandle addPass( std::string_view name, ExecuteFn execute );
+	void read( PassHandle pass, ResourceHandle resource, ResourceState state );
+	void write( PassHandle pass, ResourceHandle resource, ResourceState state );
+
+	// Keep the pass even if nothing reads its output (readbacks, queries, presentation)
+	void setSideEffects( PassHandle pass );
+
+	// Order, cull, compute barriers and place transients. Returns false on invalid declarations or
+	// dependency cycles; getError() describes the first problem.
+	bool compile();
+	const std::string &getError() const noexcept { return m_error; }
+	bool isCompiled() const noexcept { return m_compiled; }
+
+	// Run the compiled passes in order with their barriers; false if the graph is not compiled or
+	// the backend could not allocate the transients
+	bool execute( FrameGraphBackend &backend ) const;
+
+	std::uint32_t getPassCount() const noexcept { return static_cast<std::uint32_t>( m_passes.size() ); }
+	std::uint32_t getResourceCount() const noexcept { return static_cast<std::uint32_t>( m_resources.size() ); }
+	const std::string &getPassName( PassHandle pass ) const noexcept { return m_passes[pass].name; }
+	const std::string &getResourceName( ResourceHandle resource ) const noexcept { return m_resources[resource].name; }
+	bool isImported( ResourceHandle resource ) const noexcept { return m_resources[resource].imported; }
+	const TextureDesc &getDesc( ResourceHandle resource ) const noexcept { return m_resources[resource].desc; }
+
+	// Compiled results
+	std::span<const PassHandle> getExecutionOrder() const noexcept { return m_order; }
+	bool isCulled( PassHandle pass ) const noexcept { return m_passes[pass].culled; }
+	std::span<const Barrier> getBarriers( PassHandle pass ) const noexcept;
+	std::span<const Barrier> getFinalBarriers() const noexcept;
+	bool isAllocated( ResourceHandle resource ) const noexcept { return m_resources[resource].allocated; }
+	std::uint64_t getHeapOffset( ResourceHandle resource ) const noexcept { return m_resources[resource].heapOffset; }
+	const FrameGraphStats &getStats() const noexcept { return m_stats; }
+
+private:
+	struct Access
+	{
+		ResourceHandle resource = kInvalidResource;
+		ResourceState state = ResourceState::Undefined;
+		bool write = false;
+	};
+
+	struct Pass
+	{
+		std::string name;
+		ExecuteFn execute;
+		std::vector<Access> accesses;
+		bool sideEffects = false;
+		bool culled = false;
+		std::uint32_t firstBarrier = 0;
+		std::uint32_t barrierCount = 0;
+	};
+
+	struct Resource
+	{
+		std::string name;
+		TextureDesc desc;
+		bool imported = false;
+		ResourceState initialState = ResourceState::Undefined;
+		ResourceState finalState = ResourceState::Undefined;
+		std::vector<PassHandle> writers; // Declaration order
+		std::vector<PassHandle> readers;
+
+		// Compiled
+		bool allocated = false;
+		std::uint32_t firstUse = 0; // Positions in the execution order
+		std::uint32_t lastUse = 0;
+		std::uint64_t heapOffset = 0;
+	};
+
+	std::vector<Pass> m_passes;
+	std::vector<Resource> m_resources;
+	std::vector<PassHandle> m_order;
+	std::vector<Barrier> m_barriers;
+	std::uint32_t m_finalBarrierStart = 0;
+	FrameGraphStats m_stats;
+	std::string m_error;
+	bool m_compiled = false;
+
+	void addAccess( PassHandle pass, ResourceHandle resource, ResourceState state, bool write );
+	void fail( std::string message );
+	bool sortPasses();
+	void cullPasses();
+	void placeTransients();
+	void computeBarriers();
+};
+
+} // namespace engine::frame_graph
@@ -0,0 +1,328 @@
+#include "engine/geometry_pool/geometry_pool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace engine::geometry_pool
+{
+
+namespace
+{
+// Buffer views carry 32-bit sizes
+std::uint32_t maxCapacity( std::uint32_t unitSize ) noexcept
+{
+	return std::numeric_limits<std::uint32_t>::max() / unitSize;
+}
+} // namespace
+
+GeometryPool::GeometryPool( std::shared_ptr<render_backend::UploadBackend> backend,
+	std::uint32_t vertexStride,
+	std::uint32_t initialVertexCapacity,
+	std::uint32_t initialIndexCapacity )
+	: m_backend( std::move( backend ) ), m_vertexStride( std::max<std::uint32_t>( vertexStride, 1 ) )
+{
+	if ( initialVertexCapacity > 0 )
+	{
+		growBuffer( m_vertexRanges, m_vertexBuffer, m_vertexStride, initialVertexCapacity );
+	}
+	if ( initialIndexCapacity > 0 )
+	{
+		growBuffer( m_indexRanges, m_indexBuffer, sizeof( std::uint32_t ), initialIndexCapacity );
+	}
+	// Creating the initial buffers is not growth
+	m_growths = 0;
+	m_bytesMoved = 0;
+}
+
+GeometryPool::~GeometryPool()
+{
+	for ( const auto &retired : m_retiredBuffers )
+	{
+		m_backend->destroyBuffer( retired.buffer );
+	}
+	if ( m_vertexBuffer.isValid() )
+	{
+		m_backend->destroyBuffer( m_vertexBuffer );
+	}
+	if ( m_indexBuffer.isValid() )
+	{
+		m_backend->destroyBuffer( m_indexBuffer );
+	}
+}
+
+GeometryHandle GeometryPool::allocate( const void *vertices, std::uint32_t vertexCount, std::span<const std::uint32_t> indices )
+{
+	if ( !vertices || vertexCount == 0 || indices.size() > maxCapacity( sizeof( std::uint32_t ) ) )
+	{
+		++m_failures;
+		return kInvalidGeometry;
+	}
+
+	const auto vertexRange = allocateRange( m_vertexRanges, m_vertexBuffer, m_vertexStride, vertexCount );
+	if ( !vertexRange.isValid() )
+	{
+		++m_failures;
+		return kInvalidGeometry;
+	}
+
+	RangeAllocator::Allocation indexRange;
+	if ( !indices.empty() )
+	{
+		indexRange = allocateRange( m_indexRanges, m_indexBuffer, sizeof( std::uint32_t ), static_cast<std::uint32_t>( indices.size() ) );
+		if ( !indexRange.isValid() )
+		{
+			m_vertexRanges.free( vertexRange.node );
+			++m_failures;
+			return kInvalidGeometry;
+		}
+	}
+
+	std::memcpy( m_vertexBuffer.cpuAddress + std::uint64_t{ vertexRange.offset } * m_vertexStride, vertices, std::size_t{ vertexCount } * m_vertexStride );
+	if ( indexRange.isValid() )
+	{
+		std::memcpy( m_indexBuffer.cpuAddress + std::uint64_t{ indexRange.offset } * sizeof( std::uint32_t ), indices.data(), indices.size_bytes() );
+	}
+
+	GeometryHandle handle;
+	if ( !m_freeSlots.empty() )
+	{
+		handle = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		handle = static_cast<GeometryHandle>( m_slots.size() );
+		m_slots.emplace_back();
+	}
+	m_slots[handle] = Slot{ vertexRange.node, indexRange.node, true };
+	return handle;
+}
+
+void GeometryPool::free( GeometryHandle handle )
+{
+	if ( !isValid( handle ) )
+	{
+		return;
+	}
+	m_slots[handle].live = false;
+	m_pendingFrees.push_back( PendingFree{ handle } );
+}
+
+bool GeometryPool::isValid( GeometryHandle handle ) const noexcept
+{
+	return handle < m_slots.size() && m_slots[handle].live;
+}
+
+GeometryRange GeometryPool::getRange( GeometryHandle handle ) const noexcept
+{
+	GeometryRange range;
+	if ( !isValid( handle ) )
+	{
+		return range;
+	}
+
+	const Slot &slot = m_slots[handle];
+	range.baseVertex = static_cast<std::int32_t>( m_vertexRanges.getOffset( slot.vertexNode ) );
+	range.vertexCount = m_vertexRanges.getSize( slot.vertexNode );
+	if ( slot.indexNode != RangeAllocator::kInvalidNode )
+	{
+		range.firstIndex = m_indexRanges.getOffset( slot.indexNode );
+		range.indexCount = m_indexRanges.getSize( slot.indexNode );
+	}
+	return range;
+}
+
+render_backend::VertexBufferView GeometryPool::getVertexBufferView() const noexcept
+{
+	return render_backend::VertexBufferView{ m_vertexBuffer.gpuAddress, static_cast<std::uint32_t>( m_vertexBuffer.size ), m_vertexStride };
+}
+
+render_backend::IndexBufferView GeometryPool::getIndexBufferView() const noexcept
+{
+	return render_backend::IndexBufferView{ m_indexBuffer.gpuAddress, static_cast<std::uint32_t>( m_indexBuffer.size ), render_backend::IndexFormat::UInt32 };
+}
+
+void GeometryPool::endFrame( std::uint64_t fenceValue )
+{
+	for ( auto &pending : m_pendingFrees )
+	{
+		if ( pending.awaitingFence )
+		{
+			pending.fenceValue = fenceValue;
+			pending.awaitingFence = false;
+		}
+	}
+	for ( auto &retired : m_retiredBuffers )
+	{
+		if ( retired.awaitingFence )
+		{
+			retired.fenceValue = fenceValue;
+			retired.awaitingFence = false;
+		}
+	}
+
+	const std::uint64_t completed = m_backend->getCompletedFenceValue();
+	std::erase_if( m_pendingFrees, [&]( const PendingFree &pending ) {
+		if ( pending.awaitingFence || pending.fenceValue > completed )
+		{
+			return false;
+		}
+		releaseSlot( pending.handle );
+		return true;
+	} );
+	std::erase_if( m_retiredBuffers, [&]( const RetiredBuffer &retired ) {
+		if ( retired.awaitingFence || retired.fenceValue > completed )
+		{
+			return false;
+		}
+		m_backend->destroyBuffer( retired.buffer );
+		return true;
+	} );
+}
+
+std::uint64_t GeometryPool::defragment()
+{
+	const std::uint64_t moved = compactBuffer( m_vertexRanges, m_vertexBuffer, m_vertexStride ) +
+		compactBuffer( m_indexRanges, m_indexBuffer, sizeof( std::uint32_t ) );
+	if ( moved > 0 )
+	{
+		++m_defragmentations;
+		m_bytesMoved += moved;
+	}
+	return moved;
+}
+
+bool GeometryPool::shouldDefragment( float threshold ) const noexcept
+{
+	return m_vertexRanges.getFragmentation() > threshold || m_indexRanges.getFragmentation() > threshold;
+}
+
+GeometryPoolStats GeometryPool::getStats() const noexcept
+{
+	GeometryPoolStats stats;
+	stats.allocations = static_cast<std::uint32_t>( m_slots.size() - m_freeSlots.size() - m_pendingFrees.size() );
+	stats.pendingFrees = static_cast<std::uint32_t>( m_pendingFrees.size() );
+	stats.vertexBytesUsed = std::uint64_t{ m_vertexRanges.getUsedUnits() } * m_vertexStride;
+	stats.vertexBytesCapacity = m_vertexBuffer.size;
+	stats.indexBytesUsed = std::uint64_t{ m_indexRanges.getUsedUnits() } * sizeof( std::uint32_t );
+	stats.indexBytesCapacity = m_indexBuffer.size;
+	stats.vertexFragmentation = m_vertexRanges.getFragmentation();
+	stats.indexFragmentation = m_indexRanges.getFragmentation();
+	stats.growths = m_growths;
+	stats.defragmentations = m_defragmentations;
+	stats.bytesMoved = m_bytesMoved;
+	stats.failures = m_failures;
+	return stats;
+}
+
+RangeAllocator::Allocation GeometryPool::allocateRange( RangeAllocator &ranges, render_backend::UploadBuffer &buffer, std::uint32_t unitSize, std::uint32_t count )
+{
+	auto allocation = ranges.allocate( count );
+	if ( allocation.isValid() )
+	{
+		return allocation;
+	}
+
+	// The new space extends the free block at the end, so capacity + count always fits
+	const std::uint64_t required = std::uint64_t{ ranges.getCapacity() } + count;
+	if ( required > maxCapacity( unitSize ) || !growBuffer( ranges, buffer, unitSize, static_cast<std::uint32_t>( required ) ) )
+	{
+		return {};
+	}
+	return ranges.allocate( count );
+}
+
+bool GeometryPool::growBuffer( RangeAllocator &ranges, render_backend::UploadBuffer &buffer, std::uint32_t unitSize, std::uint32_t minimumCapacity )
+{
+	const std::uint32_t capacity = ranges.getCapacity();
+	const std::uint32_t newCapacity = static_cast<std::uint32_t>( std::min<std::uint64_t>( std::max<std::uint64_t>( std::uint64_t{ capacity } * 2, minimumCapacity ), maxCapacity( unitSize ) ) );
+	if ( newCapacity < minimumCapacity || newCapacity <= capacity )
+	{
+		return false;
+	}
+
+	const render_backend::UploadBuffer grown = m_backend->createBuffer( std::uint64_t{ newCapacity } * unitSize );
+	if ( !grown.isValid() )
+	{
+		return false;
+	}
+
+	if ( buffer.isValid() )
+	{
+		// Offsets are unchanged, so the old contents copy over as one block.
+		// In-flight frames keep reading the old buffer until it is retired.
+		std::memcpy( grown.cpuAddress, buffer.cpuAddress, static_cast<std::size_t>( buffer.size ) );
+		m_bytesMoved += buffer.size;
+		retireBuffer( buffer );
+	}
+	buffer = grown;
+	ranges.grow( newCapacity );
+	++m_growths;
+	return true;
+}
+
+std::uint64_t GeometryPool::compactBuffer( RangeAllocator &ranges, render_backend::UploadBuffer &buffer, std::uint32_t unitSize )
+{
+	if ( !buffer.isValid() || ranges.getFreeBlockCount() <= 1 )
+	{
+		return 0;
+	}
+
+	// Pack into a fresh buffer instead of moving in place, because in-flight frames still read the old layout
+	const render_backend::UploadBuffer packed = m_backend->createBuffer( buffer.size );
+	if ( !packed.isValid() )
+	{
+		return 0;
+	}
+
+	const bool isVertexPool = &ranges == &m_vertexRanges;
+	std::vector<std::uint32_t> oldOffsets( m_slots.size(), 0 );
+	for ( std::size_t i = 0; i < m_slots.size(); ++i )
+	{
+		const auto node = isVertexPool ? m_slots[i].vertexNode : m_slots[i].indexNode;
+		if ( node != RangeAllocator::kInvalidNode )
+		{
+			oldOffsets[i] = ranges.getOffset( node );
+		}
+	}
+
+	ranges.compact();
+
+	// Slots awaiting their fence still own ranges and are copied too
+	std::uint64_t moved = 0;
+	for ( std::size_t i = 0; i < m_slots.size(); ++i )
+	{
+		const auto node = isVertexPool ? m_slots[i].vertexNode : m_slots[i].indexNode;
+		if ( node == RangeAllocator::kInvalidNode )
+		{
+			continue;
+		}
+		const std::uint64_t bytes = std::uint64_t{ ranges.getSize( node ) } * unitSize;
+		std::memcpy( packed.cpuAddress + std::uint64_t{ ranges.getOffset( node ) } * unitSize, buffer.cpuAddress + std::uint64_t{ oldOffsets[i] } * unitSize, static_cast<std::size_t>( bytes ) );
+		moved += bytes;
+	}
+
+	retireBuffer( buffer );
+	buffer = packed;
+	return moved;
+}
+
+void GeometryPool::retireBuffer( const render_backend::UploadBuffer &buffer )
+{
+	m_retiredBuffers.push_back( RetiredBuffer{ buffer } );
+}
+
+void GeometryPool::releaseSlot( GeometryHandle handle )
+{
+	Slot &slot = m_slots[handle];
+	m_vertexRanges.free( slot.vertexNode );
+	if ( slot.indexNode != RangeAllocator::kInvalidNode )
+	{
+		m_indexRanges.free( slot.indexNode );
+	}
+	slot = Slot{};
+	m_freeSlots.push_back( handle );
+}
+
+} // namespace engine::geometry_pool
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "engine/geometry_pool/range_allocator.h"
+#include "engine/render_backend/command_recorder.h"
+#include "engine/render_backend/upload_ring.h"
+
+// Shared vertex and index buffers for static meshes. Each primitive gets a vertex range and an index range
+// suballocated with RangeAllocator; draws bind the pool buffers once and select a primitive through
+// baseVertex/startIndex, so thousands of primitives cost two resources instead of two each.
+// Buffers come from an UploadBackend, so the pool runs against CpuUploadBackend in tests.
+// Not thread-safe: allocate, free and endFrame are called from the render thread.
+namespace engine::geometry_pool
+{
+
+using GeometryHandle = std::uint32_t;
+constexpr GeometryHandle kInvalidGeometry = ~0u;
+
+// Where a primitive lives inside the pool buffers; valid until the next growth or defragmentation
+struct GeometryRange
+{
+	std::int32_t baseVertex = 0;
+	std::uint32_t vertexCount = 0;
+	std::uint32_t firstIndex = 0;
+	std::uint32_t indexCount = 0; // 0 for non-indexed geometry
+};
+
+struct GeometryPoolStats
+{
+	std::uint32_t allocations = 0;
+	std::uint32_t pendingFrees = 0; // Freed but possibly still read by in-flight frames
+	std::uint64_t vertexBytesUsed = 0;
+	std::uint64_t vertexBytesCapacity = 0;
+	std::uint64_t indexBytesUsed = 0;
+	std::uint64_t indexBytesCapacity = 0;
+	float vertexFragmentation = 0.0f;
+	float indexFragmentation = 0.0f;
+	std::uint32_t growths = 0;
+	std::uint32_t defragmentations = 0;
+	std::uint64_t bytesMoved = 0; // Copied by growth and defragmentation
+	std::uint32_t failures = 0;
+};
+
+class GeometryPool
+{
+public:
+	static constexpr std::uint32_t kDefaultVertexCapacity = 64 * 1024;
+	static constexpr std::uint32_t kDefaultIndexCapacity = 256 * 1024;
+	static constexpr float kDefaultDefragmentThreshold = 0.5f;
+
+	GeometryPool( std::shared_ptr<render_backend::UploadBackend> backend,
+		std::uint32_t vertexStride,
+		std::uint32_t initialVertexCapacity = kDefaultVertexCapacity,
+		std::uint32_t initialIndexCapacity = kDefaultIndexCapacity );
+	// Releases all buffers; the caller must ensure the GPU no longer reads them
+	~GeometryPool();
+
+	GeometryPool( const GeometryPool & ) = delete;
+	GeometryPool &operator=( const GeometryPool & ) = delete;
+
+	// Copy vertexCount vertices of getVertexStride() bytes and the indices into the pool. Indices stay
+	// relative to the primitive's first vertex. Grows the buffers when needed; kInvalidGeometry on failure.
+	GeometryHandle allocate( const void *vertices, std::uint32_t vertexCount, std::span<const std::uint32_t> indices );
+
+	// The ranges are reused once the GPU completes the fence passed to the next endFrame
+	void free( GeometryHandle handle );
+
+	bool isValid( GeometryHandle handle ) const noexcept;
+	GeometryRange getRange( GeometryHandle handle ) const noexcept;
+
+	// Views over the whole pool buffers, shared by every primitive
+	render_backend::VertexBufferView getVertexBufferView() const noexcept;
+	render_backend::IndexBufferView getIndexBufferView() const noexcept;
+	const render_backend::UploadBuffer &getVertexBuffer() const noexcept { return m_vertexBuffer; }
+	const render_backend::UploadBuffer &getIndexBuffer() const noexcept { return m_indexBuffer; }
+	std::uint32_t getVertexStride() const noexcept { return m_vertexStride; }
+
+	// Tag frees and replaced buffers since the last call with fenceValue, then reclaim those whose fence completed
+	void endFrame( std::uint64_t fenceValue );
+
+	// Pack live ranges into fresh buffers; the old buffers are released after the next endFrame's fence.
+	// Returns the number of bytes copied.
+	std::uint64_t defragment();
+	bool shouldDefragment( float threshold = kDefaultDefragmentThreshold ) const noexcept;
+
+	GeometryPoolStats getStats() const noexcept;
+
+private:
+	struct Slot
+	{
+		RangeAllocator::NodeIndex vertexNode = RangeAllocator::kInvalidNode;
+		RangeAllocator::NodeIndex indexNode = RangeAllocator::kInvalidNode;
+		bool live = false;
+	};
+
+	struct PendingFree
+	{
+		GeometryHandle handle = kInvalidGeometry;
+		std::uint64_t fenceValue = 0;
+		bool awaitingFence = true;
+	};
+
+	struct RetiredBuffer
+	{
+		render_backend::UploadBuffer buffer;
+		std::uint64_t fenceValue = 0;
+		bool awaitingFence = true;
+	};
+
+	std::shared_ptr<render_backend::UploadBackend> m_backend;
+	std::uint32_t m_vertexStride = 0;
+
+	render_backend::UploadBuffer m_vertexBuffer;
+	render_backend::UploadBuffer m_indexBuffer;
+	RangeAllocator m_vertexRanges;
+	RangeAllocator m_indexRanges;
+
+	std::vector<Slot> m_slots;
+	std::vector<GeometryHandle> m_freeSlots;
+	std::vector<PendingFree> m_pendingFrees;
+	std::vector<RetiredBuffer> m_retiredBuffers;
+
+	std::uint32_t m_growths = 0;
+	std::uint32_t m_defragmentations = 0;
+	std::uint64_t m_bytesMoved = 0;
+	std::uint32_t m_failures = 0;
+
+	RangeAllocator::Allocation allocateRange( RangeAllocator &ranges, render_backend::UploadBuffer &buffer, std::uint32_t unitSize, std::uint32_t count );
+	bool growBuffer( RangeAllocator &ranges, render_backend::UploadBuffer &buffer, std::uint32_t unitSize, std::uint32_t minimumCapacity );
+	std::uint64_t compactBuffer( RangeAllocator &ranges, render_backend::UploadBuffer &buffer, std::uint32_t unitSize );
+	void retireBuffer( const render_backend::UploadBuffer &buffer );
+	void releaseSlot( GeometryHandle handle );
+};
+
+} // namespace engine::geometry_pool
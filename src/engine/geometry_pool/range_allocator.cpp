@@ -0,0 +1,366 @@
+#include "engine/geometry_pool/range_allocator.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace engine::geometry_pool
+{
+
+RangeAllocator::RangeAllocator( std::uint32_t capacity )
+{
+	m_binHeads.fill( kInvalidNode );
+	grow( capacity );
+}
+
+// Bins follow a tiny float: sizes below kSubBinCount map exactly, larger sizes use the top bit as the
+// exponent and the next kSubBinBits bits as the mantissa, so each power of two is split into 8 classes
+std::uint32_t RangeAllocator::binRoundDown( std::uint32_t size ) noexcept
+{
+	if ( size < kSubBinCount )
+	{
+		return size;
+	}
+	const std::uint32_t exponent = static_cast<std::uint32_t>( std::bit_width( size ) ) - 1;
+	const std::uint32_t mantissa = ( size >> ( exponent - kSubBinBits ) ) & ( kSubBinCount - 1 );
+	return ( ( exponent - kSubBinBits + 1 ) << kSubBinBits ) | mantissa;
+}
+
+std::uint32_t RangeAllocator::binRoundUp( std::uint32_t size ) noexcept
+{
+	// Every block in the rounded-up bin is at least size units, so the search never walks a list
+	const std::uint32_t bin = binRoundDown( size );
+	if ( size < kSubBinCount )
+	{
+		return bin;
+	}
+	const std::uint32_t exponent = static_cast<std::uint32_t>( std::bit_width( size ) ) - 1;
+	const std::uint32_t lowBits = size & ( ( 1u << ( exponent - kSubBinBits ) ) - 1 );
+	return lowBits != 0 ? bin + 1 : bin;
+}
+
+std::uint32_t RangeAllocator::findFreeBin( std::uint32_t minimumBin ) const noexcept
+{
+	if ( minimumBin >= kBinCount )
+	{
+		return kBinCount;
+	}
+
+	const std::uint32_t top = minimumBin >> kSubBinBits;
+	const std::uint32_t sub = minimumBin & ( kSubBinCount - 1 );
+	const std::uint32_t subMask = m_subBinMasks[top] & ( 0xFFu << sub ) & 0xFFu;
+	if ( subMask != 0 )
+	{
+		return ( top << kSubBinBits ) | static_cast<std::uint32_t>( std::countr_zero( subMask ) );
+	}
+
+	const std::uint32_t topMask = top + 1 < kTopBinCount ? m_topBinMask & ( ~0u << ( top + 1 ) ) : 0;
+	if ( topMask == 0 )
+	{
+		return kBinCount;
+	}
+	const std::uint32_t nextTop = static_cast<std::uint32_t>( std::countr_zero( topMask ) );
+	return ( nextTop << kSubBinBits ) | static_cast<std::uint32_t>( std::countr_zero( static_cast<std::uint32_t>( m_subBinMasks[nextTop] ) ) );
+}
+
+RangeAllocator::NodeIndex RangeAllocator::createNode( std::uint32_t offset, std::uint32_t size )
+{
+	NodeIndex index;
+	if ( !m_unusedNodes.empty() )
+	{
+		index = m_unusedNodes.back();
+		m_unusedNodes.pop_back();
+		m_nodes[index] = Node{};
+	}
+	else
+	{
+		index = static_cast<NodeIndex>( m_nodes.size() );
+		m_nodes.emplace_back();
+	}
+	m_nodes[index].offset = offset;
+	m_nodes[index].size = size;
+	return index;
+}
+
+void RangeAllocator::releaseNode( NodeIndex node )
+{
+	m_nodes[node] = Node{};
+	m_unusedNodes.push_back( node );
+}
+
+void RangeAllocator::insertFree( NodeIndex node )
+{
+	Node &entry = m_nodes[node];
+	const std::uint32_t bin = binRoundDown( entry.size );
+	entry.used = false;
+	entry.prevFree = kInvalidNode;
+	entry.nextFree = m_binHeads[bin];
+	if ( entry.nextFree != kInvalidNode )
+	{
+		m_nodes[entry.nextFree].prevFree = node;
+	}
+	m_binHeads[bin] = node;
+
+	m_subBinMasks[bin >> kSubBinBits] |= static_cast<std::uint8_t>( 1u << ( bin & ( kSubBinCount - 1 ) ) );
+	m_topBinMask |= 1u << ( bin >> kSubBinBits );
+	++m_freeBlockCount;
+}
+
+void RangeAllocator::removeFree( NodeIndex node )
+{
+	Node &entry = m_nodes[node];
+	const std::uint32_t bin = binRoundDown( entry.size );
+	if ( entry.prevFree != kInvalidNode )
+	{
+		m_nodes[entry.prevFree].nextFree = entry.nextFree;
+	}
+	else
+	{
+		m_binHeads[bin] = entry.nextFree;
+	}
+	if ( entry.nextFree != kInvalidNode )
+	{
+		m_nodes[entry.nextFree].prevFree = entry.prevFree;
+	}
+	entry.prevFree = kInvalidNode;
+	entry.nextFree = kInvalidNode;
+
+	if ( m_binHeads[bin] == kInvalidNode )
+	{
+		const std::uint32_t top = bin >> kSubBinBits;
+		m_subBinMasks[top] &= static_cast<std::uint8_t>( ~( 1u << ( bin & ( kSubBinCount - 1 ) ) ) );
+		if ( m_subBinMasks[top] == 0 )
+		{
+			m_topBinMask &= ~( 1u << top );
+		}
+	}
+	--m_freeBlockCount;
+}
+
+RangeAllocator::Allocation RangeAllocator::allocate( std::uint32_t size )
+{
+	if ( size == 0 )
+	{
+		return {};
+	}
+
+	NodeIndex node = kInvalidNode;
+	const std::uint32_t bin = findFreeBin( binRoundUp( size ) );
+	if ( bin < kBinCount )
+	{
+		node = m_binHeads[bin];
+	}
+	else
+	{
+		// Blocks in the request's own bin are not all large enough, but one may be (e.g. an exact fit)
+		for ( NodeIndex candidate = m_binHeads[binRoundDown( size )]; candidate != kInvalidNode; candidate = m_nodes[candidate].nextFree )
+		{
+			if ( m_nodes[candidate].size >= size )
+			{
+				node = candidate;
+				break;
+			}
+		}
+		if ( node == kInvalidNode )
+		{
+			return {};
+		}
+	}
+	removeFree( node );
+
+	// Split off the tail as a new free block
+	if ( m_nodes[node].size > size )
+	{
+		const NodeIndex remainder = createNode( m_nodes[node].offset + size, m_nodes[node].size - size );
+		Node &entry = m_nodes[node];
+		entry.size = size;
+		m_nodes[remainder].prevPhysical = node;
+		m_nodes[remainder].nextPhysical = entry.nextPhysical;
+		if ( entry.nextPhysical != kInvalidNode )
+		{
+			m_nodes[entry.nextPhysical].prevPhysical = remainder;
+		}
+		else
+		{
+			m_lastNode = remainder;
+		}
+		entry.nextPhysical = remainder;
+		insertFree( remainder );
+	}
+
+	m_nodes[node].used = true;
+	m_usedUnits += size;
+	++m_allocationCount;
+	return Allocation{ m_nodes[node].offset, size, node };
+}
+
+void RangeAllocator::free( NodeIndex node )
+{
+	if ( !isAllocated( node ) )
+	{
+		return;
+	}
+
+	m_usedUnits -= m_nodes[node].size;
+	--m_allocationCount;
+	m_nodes[node].used = false;
+
+	// Merge with the previous block: it absorbs this one
+	const NodeIndex prev = m_nodes[node].prevPhysical;
+	if ( prev != kInvalidNode && !m_nodes[prev].used )
+	{
+		removeFree( prev );
+		m_nodes[prev].size += m_nodes[node].size;
+		m_nodes[prev].nextPhysical = m_nodes[node].nextPhysical;
+		if ( m_nodes[node].nextPhysical != kInvalidNode )
+		{
+			m_nodes[m_nodes[node].nextPhysical].prevPhysical = prev;
+		}
+		else
+		{
+			m_lastNode = prev;
+		}
+		releaseNode( node );
+		node = prev;
+	}
+
+	// Merge with the next block: this one absorbs it
+	const NodeIndex next = m_nodes[node].nextPhysical;
+	if ( next != kInvalidNode && !m_nodes[next].used )
+	{
+		removeFree( next );
+		m_nodes[node].size += m_nodes[next].size;
+		m_nodes[node].nextPhysical = m_nodes[next].nextPhysical;
+		if ( m_nodes[next].nextPhysical != kInvalidNode )
+		{
+			m_nodes[m_nodes[next].nextPhysical].prevPhysical = node;
+		}
+		else
+		{
+			m_lastNode = node;
+		}
+		releaseNode( next );
+	}
+
+	insertFree( node );
+}
+
+void RangeAllocator::grow( std::uint32_t newCapacity )
+{
+	if ( newCapacity <= m_capacity )
+	{
+		return;
+	}
+
+	const std::uint32_t extra = newCapacity - m_capacity;
+	if ( m_lastNode != kInvalidNode && !m_nodes[m_lastNode].used )
+	{
+		removeFree( m_lastNode );
+		m_nodes[m_lastNode].size += extra;
+		insertFree( m_lastNode );
+	}
+	else
+	{
+		const NodeIndex node = createNode( m_capacity, extra );
+		m_nodes[node].prevPhysical = m_lastNode;
+		if ( m_lastNode != kInvalidNode )
+		{
+			m_nodes[m_lastNode].nextPhysical = node;
+		}
+		else
+		{
+			m_firstNode = node;
+		}
+		m_lastNode = node;
+		insertFree( node );
+	}
+	m_capacity = newCapacity;
+}
+
+std::vector<RangeAllocator::Relocation> RangeAllocator::compact()
+{
+	std::vector<Relocation> relocations;
+
+	// Walk physical order, keep used nodes back to back and drop the free ones
+	std::vector<NodeIndex> usedNodes;
+	usedNodes.reserve( m_allocationCount );
+	for ( NodeIndex node = m_firstNode; node != kInvalidNode; )
+	{
+		const NodeIndex next = m_nodes[node].nextPhysical;
+		if ( m_nodes[node].used )
+		{
+			usedNodes.push_back( node );
+		}
+		else
+		{
+			releaseNode( node );
+		}
+		node = next;
+	}
+
+	m_binHeads.fill( kInvalidNode );
+	m_subBinMasks.fill( 0 );
+	m_topBinMask = 0;
+	m_freeBlockCount = 0;
+	m_firstNode = kInvalidNode;
+	m_lastNode = kInvalidNode;
+
+	std::uint32_t cursor = 0;
+	for ( const NodeIndex node : usedNodes )
+	{
+		Node &entry = m_nodes[node];
+		if ( entry.offset != cursor )
+		{
+			relocations.push_back( Relocation{ node, entry.offset, cursor, entry.size } );
+			entry.offset = cursor;
+		}
+		cursor += entry.size;
+
+		entry.prevPhysical = m_lastNode;
+		entry.nextPhysical = kInvalidNode;
+		if ( m_lastNode != kInvalidNode )
+		{
+			m_nodes[m_lastNode].nextPhysical = node;
+		}
+		else
+		{
+			m_firstNode = node;
+		}
+		m_lastNode = node;
+	}
+
+	// The remaining space becomes a single free block
+	const std::uint32_t capacity = m_capacity;
+	m_capacity = cursor;
+	grow( capacity );
+	return relocations;
+}
+
+std::uint32_t RangeAllocator::getLargestFreeBlock() const noexcept
+{
+	if ( m_topBinMask == 0 )
+	{
+		return 0;
+	}
+
+	// Blocks in a bin span a size range, so scan the highest non-empty bin
+	const std::uint32_t top = 31 - static_cast<std::uint32_t>( std::countl_zero( m_topBinMask ) );
+	const std::uint32_t sub = 31 - static_cast<std::uint32_t>( std::countl_zero( static_cast<std::uint32_t>( m_subBinMasks[top] ) ) );
+	std::uint32_t largest = 0;
+	for ( NodeIndex node = m_binHeads[( top << kSubBinBits ) | sub]; node != kInvalidNode; node = m_nodes[node].nextFree )
+	{
+		largest = std::max( largest, m_nodes[node].size );
+	}
+	return largest;
+}
+
+float RangeAllocator::getFragmentation() const noexcept
+{
+	const std::uint32_t freeUnits = getFreeUnits();
+	if ( freeUnits == 0 )
+	{
+		return 0.0f;
+	}
+	return 1.0f - static_cast<float>( getLargestFreeBlock() ) / static_cast<float>( freeUnits );
+}
+
+} // namespace engine::geometry_pool
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Two-level segregated fit (TLSF) allocator for ranges of a linear address space measured in units
+// (vertices, indices, bytes). It only does bookkeeping; the caller owns the memory. Allocation and free
+// are O(1): free blocks live in size-class bins found through two bitmaps, and freed blocks merge with
+// their physical neighbours immediately. Node indices stay stable across grow() and compact(), so they
+// double as allocation handles.
+namespace engine::geometry_pool
+{
+
+class RangeAllocator
+{
+public:
+	using NodeIndex = std::uint32_t;
+	static constexpr NodeIndex kInvalidNode = ~0u;
+
+	struct Allocation
+	{
+		std::uint32_t offset = 0;
+		std::uint32_t size = 0;
+		NodeIndex node = kInvalidNode;
+
+		bool isValid() const noexcept { return node != kInvalidNode; }
+	};
+
+	// One allocation moved by compact(); ranges are reported in increasing offset order with
+	// newOffset <= oldOffset, so they can also be applied in place front to back
+	struct Relocation
+	{
+		NodeIndex node = kInvalidNode;
+		std::uint32_t oldOffset = 0;
+		std::uint32_t newOffset = 0;
+		std::uint32_t size = 0;
+	};
+
+	explicit RangeAllocator( std::uint32_t capacity = 0 );
+
+	// Returns an invalid allocation for size 0 or when no free block is large enough
+	Allocation allocate( std::uint32_t size );
+	void free( NodeIndex node );
+
+	// Extend the address space to newCapacity units; existing allocations keep their offsets
+	void grow( std::uint32_t newCapacity );
+
+	// Pack all allocations towards offset 0, leaving one free block at the end
+	std::vector<Relocation> compact();
+
+	std::uint32_t getOffset( NodeIndex node ) const noexcept { return m_nodes[node].offset; }
+	std::uint32_t getSize( NodeIndex node ) const noexcept { return m_nodes[node].size; }
+	bool isAllocated( NodeIndex node ) const noexcept { return node < m_nodes.size() && m_nodes[node].used; }
+
+	std::uint32_t getCapacity() const noexcept { return m_capacity; }
+	std::uint32_t getUsedUnits() const noexcept { return m_usedUnits; }
+	std::uint32_t getFreeUnits() const noexcept { return m_capacity - m_usedUnits; }
+	std::uint32_t getAllocationCount() const noexcept { return m_allocationCount; }
+	std::uint32_t getFreeBlockCount() const noexcept { return m_freeBlockCount; }
+	std::uint32_t getLargestFreeBlock() const noexcept;
+
+	// 0 when all free space is one block, approaching 1 as it splinters into small pieces
+	float getFragmentation() const noexcept;
+
+private:
+	static constexpr std::uint32_t kSubBinBits = 3;
+	static constexpr std::uint32_t kSubBinCount = 1u << kSubBinBits;
+	static constexpr std::uint32_t kTopBinCount = 32;
+	static constexpr std::uint32_t kBinCount = kTopBinCount * kSubBinCount;
+
+	struct Node
+	{
+		std::uint32_t offset = 0;
+		std::uint32_t size = 0;
+		NodeIndex prevPhysical = kInvalidNode;
+		NodeIndex nextPhysical = kInvalidNode;
+		NodeIndex prevFree = kInvalidNode;
+		NodeIndex nextFree = kInvalidNode;
+		bool used = false;
+	};
+
+	std::vector<Node> m_nodes;
+	std::vector<NodeIndex> m_unusedNodes;
+	std::array<NodeIndex, kBinCount> m_binHeads;
+	std::array<std::uint8_t, kTopBinCount> m_subBinMasks = {};
+	std::uint32_t m_topBinMask = 0;
+
+	NodeIndex m_firstNode = kInvalidNode;
+	NodeIndex m_lastNode = kInvalidNode;
+	std::uint32_t m_capacity = 0;
+	std::uint32_t m_usedUnits = 0;
+	std::uint32_t m_allocationCount = 0;
+	std::uint32_t m_freeBlockCount = 0;
+
+	static std::uint32_t binRoundDown( std::uint32_t size ) noexcept;
+	static std::uint32_t binRoundUp( std::uint32_t size ) noexcept;
+	std::uint32_t findFreeBin( std::uint32_t minimumBin ) const noexcept;
+
+	NodeIndex createNode( std::uint32_t offset, std::uint32_t size );
+	void releaseNode( NodeIndex node );
+	void insertFree( NodeIndex node );
+	void removeFree( NodeIndex node );
+};
+
+} // namespace engine::geometry_pool
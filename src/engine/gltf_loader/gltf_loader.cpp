@@ -1,8 +1,15 @@
 // GLTF Loader implementation with stub functionality
 #define CGLTF_IMPLEMENTATION
 #include "gltf_loader.h"
+#include "vertex_assembly.h"
 
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <span>
@@ -10,11 +17,14 @@
 
 #include "strings/strings.h"
 #include "engine/assets/assets.h"
+#include "engine/assets/content_hash.h"
 #include "math/math.h"
 #include "math/vec.h"
 #include "math/matrix.h"
 #include "math/quat.h"
 #include "runtime/console.h"
+#include "runtime/mapped_file.h"
+#include "runtime/thread_pool.h"
 
 namespace gltf_loader
 {
@@ -228,12 +238,214 @@ void validateComponentType( ComponentType componentType, AttributeType attribute
 	}
 }
 
+namespace
+{
+
+// Per-load state behind the cgltf callbacks: files mapped for this load and the parser's heap use.
+// Lives until cgltf_free() has released everything that referenced it.
+struct LoadContext
+{
+	std::vector<runtime::MappedFile> files;
+	LoadStats stats;
+	std::uint64_t heapBytes = 0;
+};
+
+// cgltf's free callback gets no size, so each block carries it in front of the returned pointer
+constexpr std::size_t kAllocationHeader = alignof( std::max_align_t );
+
+void *trackedAlloc( void *user, cgltf_size size )
+{
+	auto *context = static_cast<LoadContext *>( user );
+	auto *block = static_cast<std::uint8_t *>( std::malloc( kAllocationHeader + size ) );
+	if ( !block )
+	{
+		return nullptr;
+	}
+	std::memcpy( block, &size, sizeof( size ) );
+	context->heapBytes += size;
+	context->stats.parserPeakHeapBytes = std::max( context->stats.parserPeakHeapBytes, context->heapBytes );
+	return block + kAllocationHeader;
+}
+
+void trackedFree( void *user, void *ptr )
+{
+	if ( !ptr )
+	{
+		return;
+	}
+	auto *block = static_cast<std::uint8_t *>( ptr ) - kAllocationHeader;
+	cgltf_size size = 0;
+	std::memcpy( &size, block, sizeof( size ) );
+	static_cast<LoadContext *>( user )->heapBytes -= size;
+	std::free( block );
+}
+
+// Replaces cgltf's fread into a heap copy. For .glb files the binary chunk then stays in the mapping
+// (cgltf points buffer 0 at it), and external .bin buffers are mapped the same way.
+cgltf_result readMappedFile( const cgltf_memory_options * /*memoryOptions*/, const cgltf_file_options *fileOptions, const char *path, cgltf_size *size, void **data )
+{
+	auto *context = static_cast<LoadContext *>( fileOptions->user_data );
+	runtime::MappedFile file;
+	if ( !file.open( path ) )
+	{
+		return cgltf_result_file_not_found;
+	}
+	// A requested size comes from the buffer declaration; the file must hold at least that much
+	if ( *size > 0 && file.size() < *size )
+	{
+		return cgltf_result_data_too_short;
+	}
+
+	*size = *size > 0 ? *size : file.size();
+	*data = const_cast<std::uint8_t *>( file.data() ); // cgltf only reads through it
+	++context->stats.mappedFiles;
+	context->stats.mappedBytes += file.size();
+	context->files.push_back( std::move( file ) );
+	return cgltf_result_success;
+}
+
+void releaseMappedFile( const cgltf_memory_options * /*memoryOptions*/, const cgltf_file_options *fileOptions, void *data )
+{
+	auto *context = static_cast<LoadContext *>( fileOptions->user_data );
+	std::erase_if( context->files, [data]( const runtime::MappedFile &file ) { return file.data() == data; } );
+}
+
+// Strided view of an accessor's elements, or an empty stream if it has no loaded buffer or its last
+// element would lie outside the buffer
+ComponentType toComponentType( cgltf_component_type componentType )
+{
+	switch ( componentType )
+	{
+	case cgltf_component_type_r_8:
+		return ComponentType::Byte;
+	case cgltf_component_type_r_8u:
+		return ComponentType::UnsignedByte;
+	case cgltf_component_type_r_16:
+		return ComponentType::Short;
+	case cgltf_component_type_r_16u:
+		return ComponentType::UnsignedShort;
+	case cgltf_component_type_r_32u:
+		return ComponentType::UnsignedInt;
+	default:
+		return ComponentType::Float;
+	}
+}
+
+// Formats glTF 2.0 and KHR_mesh_quantization allow per attribute. Unnormalized integer positions and
+// texture coordinates are dequantized by the node and texture transforms, so they decode as plain integers.
+bool isSupportedAttributeFormat( const cgltf_accessor *accessor, cgltf_attribute_type attribute )
+{
+	const cgltf_component_type component = accessor->component_type;
+	const bool isFloat = component == cgltf_component_type_r_32f;
+	const bool isInteger = component == cgltf_component_type_r_8 || component == cgltf_component_type_r_8u || component == cgltf_component_type_r_16 || component == cgltf_component_type_r_16u;
+	const bool isSignedNormalized = accessor->normalized && ( component == cgltf_component_type_r_8 || component == cgltf_component_type_r_16 );
+	const bool isUnsignedNormalized = accessor->normalized && ( component == cgltf_component_type_r_8u || component == cgltf_component_type_r_16u );
+	switch ( attribute )
+	{
+	case cgltf_attribute_type_position:
+		return accessor->type == cgltf_type_vec3 && ( isFloat || isInteger );
+	case cgltf_attribute_type_normal:
+		return accessor->type == cgltf_type_vec3 && ( isFloat || isSignedNormalized );
+	case cgltf_attribute_type_tangent:
+		return accessor->type == cgltf_type_vec4 && ( isFloat || isSignedNormalized );
+	case cgltf_attribute_type_texcoord:
+		return accessor->type == cgltf_type_vec2 && ( isFloat || isInteger );
+	case cgltf_attribute_type_color:
+		return ( accessor->type == cgltf_type_vec3 || accessor->type == cgltf_type_vec4 ) && ( isFloat || isUnsignedNormalized );
+	default:
+		return false;
+	}
+}
+
+// Attributes extractPrimitive() decodes from the file (the last accessor of each type, if supported). The
+// normal is always included because a missing one is replaced by kDefaultImportNormal.
+std::uint32_t importedVertexAttributes( const cgltf_primitive &primitive )
+{
+	const cgltf_accessor *texCoord = nullptr;
+	const cgltf_accessor *tangent = nullptr;
+	const cgltf_accessor *color = nullptr;
+	for ( cgltf_size i = 0; i < primitive.attributes_count; ++i )
+	{
+		const auto &attribute = primitive.attributes[i];
+		if ( attribute.type == cgltf_attribute_type_texcoord )
+			texCoord = attribute.data;
+		else if ( attribute.type == cgltf_attribute_type_tangent )
+			tangent = attribute.data;
+		else if ( attribute.type == cgltf_attribute_type_color )
+			color = attribute.data;
+	}
+
+	std::uint32_t attributes = static_cast<std::uint32_t>( assets::VertexAttribute::Position ) | static_cast<std::uint32_t>( assets::VertexAttribute::Normal );
+	if ( texCoord && isSupportedAttributeFormat( texCoord, cgltf_attribute_type_texcoord ) )
+		attributes |= static_cast<std::uint32_t>( assets::VertexAttribute::TexCoord );
+	if ( tangent && isSupportedAttributeFormat( tangent, cgltf_attribute_type_tangent ) )
+		attributes |= static_cast<std::uint32_t>( assets::VertexAttribute::Tangent );
+	if ( color && isSupportedAttributeFormat( color, cgltf_attribute_type_color ) )
+		attributes |= static_cast<std::uint32_t>( assets::VertexAttribute::Color );
+	return attributes;
+}
+
+AccessorStream makeAccessorStream( const cgltf_accessor *accessor )
+{
+	const cgltf_buffer_view *view = accessor ? accessor->buffer_view : nullptr;
+	if ( !view || !view->buffer || !view->buffer->data || accessor->count == 0 )
+	{
+		return {};
+	}
+
+	const std::size_t elementSize = cgltf_calc_size( accessor->type, accessor->component_type );
+	const std::size_t stride = view->stride > 0 ? view->stride : elementSize;
+	const std::size_t offset = view->offset + accessor->offset;
+	if ( elementSize == 0 || offset + ( accessor->count - 1 ) * stride + elementSize > view->buffer->size )
+	{
+		return {};
+	}
+	return { static_cast<const std::uint8_t *>( view->buffer->data ) + offset, accessor->count, stride, toComponentType( accessor->component_type ), accessor->normalized != 0 };
+}
+
+// Chain an accessor's format and the bytes it reads into hash; false if they cannot be read in place
+bool hashAccessorSource( const cgltf_accessor *accessor, std::uint64_t &hash )
+{
+	const AccessorStream stream = makeAccessorStream( accessor );
+	const std::uint64_t format[] = { accessor != nullptr,
+		accessor ? static_cast<std::uint64_t>( accessor->type ) : 0u,
+		accessor ? static_cast<std::uint64_t>( accessor->component_type ) : 0u,
+		accessor ? static_cast<std::uint64_t>( accessor->normalized ) : 0u,
+		accessor ? static_cast<std::uint64_t>( accessor->count ) : 0u,
+		stream.stride };
+	hash = assets::hashContent( { reinterpret_cast<const std::uint8_t *>( format ), sizeof( format ) }, hash );
+	if ( !accessor || accessor->count == 0 )
+	{
+		return true;
+	}
+	if ( accessor->is_sparse || !stream.isValid() )
+	{
+		return false;
+	}
+	// Interleaved streams also cover the other attributes' bytes, which only makes the hash stricter
+	const std::size_t elementSize = cgltf_calc_size( accessor->type, accessor->component_type );
+	hash = assets::hashContent( { stream.data, ( stream.count - 1 ) * stream.stride + elementSize }, hash );
+	return true;
+}
+
+} // namespace
+
 GLTFLoader::GLTFLoader()
 {
 	// Initialize any needed resources
 }
 
-std::unique_ptr<assets::Scene> GLTFLoader::loadScene( const std::string &filePath ) const
+std::unique_ptr<assets::Scene> GLTFLoader::loadScene( const std::string &filePath, LoadStats *stats ) const
+{
+	return loadSceneFile( filePath, stats, nullptr );
+}
+
+std::unique_ptr<assets::Scene> GLTFLoader::reloadScene( const std::string &filePath, const assets::Scene &previous, LoadStats *stats ) const
+{
+	return loadSceneFile( filePath, stats, &previous );
+}
+
+std::unique_ptr<assets::Scene> GLTFLoader::loadSceneFile( const std::string &filePath, LoadStats *stats, const assets::Scene *previous ) const
 {
 	// Basic validation - throw for clearly invalid input
 	if ( filePath.empty() )
@@ -251,8 +463,18 @@ std::unique_ptr<assets::Scene> GLTFLoader::loadScene( const std::string &filePat
 	}
 
 	// Parse the glTF file using cgltf library
+	LoadContext context;
 	cgltf_data *data = nullptr;
 	cgltf_options options = {};
+	options.memory.alloc_func = trackedAlloc;
+	options.memory.free_func = trackedFree;
+	options.memory.user_data = &context;
+	if ( m_memoryMappingEnabled )
+	{
+		options.file.read = readMappedFile;
+		options.file.release = releaseMappedFile;
+		options.file.user_data = &context;
+	}
 
 	cgltf_result result = cgltf_parse_file( &options, filePath.c_str(), &data );
 
@@ -270,20 +492,64 @@ std::unique_ptr<assets::Scene> GLTFLoader::loadScene( const std::string &filePat
 	result = cgltf_load_buffers( &options, data, filePath.c_str() );
 	if ( result != cgltf_result_success )
 	{
+		// A missing or truncated buffer would leave accessors reading past what was loaded
 		console::error( "glTF Loader Error: Failed to load buffers for glTF file: {}, result: {}", filePath, static_cast<int>( result ) );
-		// Continue anyway - some buffers might have loaded successfully
+		cgltf_free( data );
+		return {};
 	}
 
 	// Extract base filename from path (remove directory and extension)
 	const std::string baseFilename = strings::getBaseFilename( filePath );
 
 	// Process the parsed glTF data into a scene
-	auto scene = processSceneData( data, baseFilename );
+	auto scene = processSceneData( data, baseFilename, &context.stats, previous );
+
+	// External buffers the scene was decoded from, so caches keyed on this file also notice .bin edits
+	for ( cgltf_size i = 0; scene && i < data->buffers_count; ++i )
+	{
+		const char *uri = data->buffers[i].uri;
+		if ( uri && std::strncmp( uri, "data:", 5 ) != 0 )
+		{
+			std::string decoded( uri );
+			decoded.resize( cgltf_decode_uri( decoded.data() ) );
+			scene->addSourceFile( ( std::filesystem::path( filePath ).parent_path() / decoded ).lexically_normal().generic_string() );
+		}
+	}
 
+	// Extraction copied everything it keeps; this unmaps the source files
 	cgltf_free( data );
+	if ( stats )
+	{
+		*stats = context.stats;
+	}
 	return scene;
 }
 
+std::uint64_t GLTFLoader::getImportSettingsHash() const
+{
+	// Bump when an importer change alters the scenes produced from unchanged files
+	constexpr std::uint32_t kImporterRevision = 1;
+
+	const auto &lod = m_lodSettings;
+	const auto &optimize = m_meshOptimizeSettings;
+	const std::uint32_t settings[] = { kImporterRevision,
+		m_lodGenerationEnabled,
+		lod.maxLevels,
+		std::bit_cast<std::uint32_t>( lod.reductionPerLevel ),
+		lod.minTriangles,
+		std::bit_cast<std::uint32_t>( lod.maxRelativeError ),
+		std::bit_cast<std::uint32_t>( lod.minReduction ),
+		m_meshOptimizationEnabled,
+		optimize.weldVertices,
+		optimize.optimizeVertexCache,
+		optimize.optimizeOverdraw,
+		optimize.optimizeVertexFetch,
+		optimize.cacheSize,
+		std::bit_cast<std::uint32_t>( optimize.overdrawThreshold ),
+		static_cast<std::uint32_t>( m_vertexStorage ) };
+	return assets::hashContent( { reinterpret_cast<const std::uint8_t *>( settings ), sizeof( settings ) } );
+}
+
 std::unique_ptr<assets::Scene> GLTFLoader::loadFromString( const std::string &gltfContent ) const
 {
 	// Parse glTF JSON string
@@ -317,7 +583,7 @@ std::unique_ptr<assets::Scene> GLTFLoader::loadFromString( const std::string &gl
 	return scene;
 }
 
-std::unique_ptr<assets::Scene> GLTFLoader::processSceneData( cgltf_data *data, const std::string &baseFilename ) const
+std::unique_ptr<assets::Scene> GLTFLoader::processSceneData( cgltf_data *data, const std::string &baseFilename, LoadStats *stats, const assets::Scene *previous ) const
 {
 	if ( !data )
 	{
@@ -328,15 +594,32 @@ std::unique_ptr<assets::Scene> GLTFLoader::processSceneData( cgltf_data *data, c
 	// Create scene
 	auto scene = std::make_unique<assets::Scene>();
 
+	// Materials and meshes only read the parsed document, so they are extracted independently; handles are
+	// assigned afterwards on this thread in document order, so the result does not depend on scheduling
+	runtime::ThreadPool *pool = m_parallelExtractionEnabled ? ( m_threadPool ? m_threadPool : &runtime::ThreadPool::getShared() ) : nullptr;
+	const auto forEachIndex = [pool]( std::size_t count, std::size_t grainSize, const std::function<void( std::size_t )> &body ) {
+		if ( pool )
+		{
+			pool->parallelFor( count, body, grainSize );
+			return;
+		}
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			body( i );
+		}
+	};
+
 	// 1. Extract ALL materials from root level first and add to scene
+	std::vector<std::shared_ptr<assets::Material>> materials( data->materials_count );
+	forEachIndex( data->materials_count, 16, [&]( std::size_t i ) { materials[i] = extractMaterial( &data->materials[i], data ); } );
+
 	std::vector<assets::MaterialHandle> materialHandles;
 	materialHandles.reserve( data->materials_count );
-	for ( cgltf_size i = 0; i < data->materials_count; ++i )
+	for ( auto &material : materials )
 	{
-		auto material = extractMaterial( &data->materials[i], data );
 		if ( material )
 		{
-			assets::MaterialHandle handle = scene->addMaterial( material );
+			assets::MaterialHandle handle = scene->addMaterial( std::move( material ) );
 			materialHandles.push_back( handle );
 		}
 		else
@@ -346,21 +629,98 @@ std::unique_ptr<assets::Scene> GLTFLoader::processSceneData( cgltf_data *data, c
 		}
 	}
 
-	// 2. Extract ALL meshes from root level and add to scene
-	std::vector<assets::MeshHandle> meshHandles;
-	meshHandles.reserve( data->meshes_count );
+	// Source hash of every mesh. On a reload, meshes whose hash matches one of the previous import are
+	// shared from it and skip extraction, optimisation and LOD generation.
+	const std::uint64_t settingsHash = getImportSettingsHash();
+	std::vector<std::uint64_t> sourceHashes( data->meshes_count );
+	forEachIndex( data->meshes_count, 16, [&]( std::size_t i ) { sourceHashes[i] = hashMeshSource( data->meshes[i], data, materialHandles, settingsHash ); } );
+	std::vector<std::shared_ptr<assets::Mesh>> reusedMeshes( data->meshes_count );
+	if ( previous )
+	{
+		std::unordered_map<std::uint64_t, std::shared_ptr<assets::Mesh>> previousMeshes;
+		for ( const auto &mesh : previous->getMeshes() )
+		{
+			if ( mesh->getSourceHash() != 0 )
+			{
+				previousMeshes.emplace( mesh->getSourceHash(), mesh );
+			}
+		}
+		for ( cgltf_size i = 0; i < data->meshes_count; ++i )
+		{
+			const auto it = sourceHashes[i] != 0 ? previousMeshes.find( sourceHashes[i] ) : previousMeshes.end();
+			if ( it != previousMeshes.end() )
+			{
+				reusedMeshes[i] = it->second;
+			}
+		}
+	}
+
+	// 2. Extract ALL meshes from root level and add to scene. Work is split per primitive, so one large
+	// mesh does not serialise the import; meshes are then assembled in order.
+	std::vector<std::size_t> firstPrimitive( data->meshes_count + 1, 0 );
 	for ( cgltf_size i = 0; i < data->meshes_count; ++i )
 	{
-		auto mesh = extractMesh( &data->meshes[i], data, materialHandles );
-		if ( mesh )
+		firstPrimitive[i + 1] = firstPrimitive[i] + data->meshes[i].primitives_count;
+	}
+	std::vector<std::unique_ptr<assets::Primitive>> primitives( firstPrimitive.back() );
+	std::vector<engine::mesh_optimize::OptimizeReport> reports( stats && m_meshOptimizationEnabled ? primitives.size() : 0 );
+	forEachIndex( primitives.size(), 1, [&]( std::size_t index ) {
+		const auto meshIndex = static_cast<std::size_t>( std::upper_bound( firstPrimitive.begin(), firstPrimitive.end(), index ) - firstPrimitive.begin() ) - 1;
+		if ( reusedMeshes[meshIndex] )
 		{
-			assets::MeshHandle handle = scene->addMesh( mesh );
-			meshHandles.push_back( handle );
+			return;
 		}
-		else
+		const std::size_t primitiveIndex = index - firstPrimitive[meshIndex];
+		primitives[index] = extractMeshPrimitive( &data->meshes[meshIndex].primitives[primitiveIndex], primitiveIndex, data, materialHandles, reports.empty() ? nullptr : &reports[index] );
+	} );
+
+	std::vector<assets::MeshHandle> meshHandles;
+	meshHandles.reserve( data->meshes_count );
+	for ( cgltf_size i = 0; i < data->meshes_count; ++i )
+	{
+		if ( data->meshes[i].primitives_count == 0 )
 		{
+			console::error( "extractMesh: Invalid mesh or no primitives" );
 			// Add invalid handle placeholder to maintain indexing
 			meshHandles.push_back( assets::INVALID_MESH_HANDLE );
+			continue;
+		}
+		if ( reusedMeshes[i] )
+		{
+			meshHandles.push_back( scene->addMesh( reusedMeshes[i] ) );
+			if ( stats )
+			{
+				++stats->meshesReused;
+			}
+			continue;
+		}
+
+		auto mesh = std::make_shared<assets::Mesh>();
+		mesh->setSourceHash( sourceHashes[i] );
+		for ( std::size_t index = firstPrimitive[i]; index < firstPrimitive[i + 1]; ++index )
+		{
+			if ( primitives[index] )
+			{
+				mesh->addPrimitive( std::move( *primitives[index] ) );
+			}
+		}
+		meshHandles.push_back( scene->addMesh( std::move( mesh ) ) );
+
+		if ( !reports.empty() )
+		{
+			MeshOptimizationStats meshStats;
+			meshStats.name = data->meshes[i].name ? data->meshes[i].name : "mesh " + std::to_string( i );
+			for ( std::size_t index = firstPrimitive[i]; index < firstPrimitive[i + 1]; ++index )
+			{
+				if ( !primitives[index] )
+					continue;
+				meshStats.verticesBefore += reports[index].verticesBefore;
+				meshStats.verticesAfter += reports[index].verticesAfter;
+				meshStats.cacheBefore += reports[index].cacheBefore;
+				meshStats.cacheAfter += reports[index].cacheAfter;
+				meshStats.shortIndices = meshStats.shortIndices && reports[index].shortIndices;
+			}
+			stats->meshOptimization.push_back( std::move( meshStats ) );
 		}
 	}
 
@@ -396,6 +756,33 @@ std::unique_ptr<assets::Scene> GLTFLoader::processSceneData( cgltf_data *data, c
 	return scene;
 }
 
+std::uint64_t GLTFLoader::hashMeshSource( const cgltf_mesh &mesh, const cgltf_data *data, const std::vector<assets::MaterialHandle> &materialHandles, std::uint64_t seed ) const
+{
+	std::uint64_t hash = seed;
+	for ( cgltf_size i = 0; i < mesh.primitives_count; ++i )
+	{
+		const cgltf_primitive &primitive = mesh.primitives[i];
+		// The resolved handle, so a mesh is not reused when the materials before its own were added or removed
+		const cgltf_size materialIndex = primitive.material ? static_cast<cgltf_size>( primitive.material - data->materials ) : materialHandles.size();
+		const std::uint64_t header[] = { static_cast<std::uint64_t>( primitive.type ), primitive.attributes_count, materialIndex < materialHandles.size() ? materialHandles[materialIndex] : assets::INVALID_MATERIAL_HANDLE };
+		hash = assets::hashContent( { reinterpret_cast<const std::uint8_t *>( header ), sizeof( header ) }, hash );
+		for ( cgltf_size j = 0; j < primitive.attributes_count; ++j )
+		{
+			const std::uint64_t attribute[] = { static_cast<std::uint64_t>( primitive.attributes[j].type ), static_cast<std::uint64_t>( primitive.attributes[j].index ) };
+			hash = assets::hashContent( { reinterpret_cast<const std::uint8_t *>( attribute ), sizeof( attribute ) }, hash );
+			if ( !hashAccessorSource( primitive.attributes[j].data, hash ) )
+			{
+				return 0;
+			}
+		}
+		if ( !hashAccessorSource( primitive.indices, hash ) )
+		{
+			return 0;
+		}
+	}
+	return hash;
+}
+
 std::unique_ptr<assets::SceneNode> GLTFLoader::processNode(
 	cgltf_node *gltfNode,
 	cgltf_data *data,
@@ -457,53 +844,65 @@ std::unique_ptr<assets::SceneNode> GLTFLoader::processNode(
 	return sceneNode;
 }
 
-std::shared_ptr<assets::Mesh> GLTFLoader::extractMesh( cgltf_mesh *gltfMesh, cgltf_data *data, const std::vector<assets::MaterialHandle> &materialHandles, bool verbose ) const
+std::unique_ptr<assets::Primitive> GLTFLoader::extractMeshPrimitive( cgltf_primitive *gltfPrimitive, cgltf_size primitiveIndex, cgltf_data *data, const std::vector<assets::MaterialHandle> &materialHandles, engine::mesh_optimize::OptimizeReport *report, bool verbose ) const
 {
-	if ( !gltfMesh || gltfMesh->primitives_count == 0 )
+	if ( verbose )
+		console::info( "extractMesh: Processing primitive {} with {} attributes", primitiveIndex, gltfPrimitive->attributes_count );
+
+	// Extract this primitive's data into a Primitive object
+	auto primitive = extractPrimitive( gltfPrimitive, data, materialHandles, verbose );
+	if ( !primitive )
 	{
-		console::error( "extractMesh: Invalid mesh or no primitives" );
+		console::error( "extractMesh: Failed to extract primitive {}", primitiveIndex );
 		return nullptr;
 	}
 
-	if ( verbose )
-		console::info( "extractMesh: Processing mesh with {} primitives", gltfMesh->primitives_count );
-
-	auto mesh = std::make_shared<assets::Mesh>();
-
-	// Process each primitive and create Primitive objects
-	for ( cgltf_size primitiveIndex = 0; primitiveIndex < gltfMesh->primitives_count; ++primitiveIndex )
+	// Before LOD generation, so the simplifier works on welded vertices
+	if ( m_meshOptimizationEnabled )
 	{
-		cgltf_primitive *gltfPrimitive = &gltfMesh->primitives[primitiveIndex];
+		const auto optimized = engine::mesh_optimize::optimizePrimitive( *primitive, m_meshOptimizeSettings );
 		if ( verbose )
-			console::info( "extractMesh: Processing primitive {} with {} attributes", primitiveIndex, gltfPrimitive->attributes_count );
-
-		// Extract this primitive's data into a Primitive object
-		const auto primitive = extractPrimitive( gltfPrimitive, data, materialHandles, verbose );
-		if ( primitive )
 		{
-			mesh->addPrimitive( *primitive );
-			if ( verbose )
-				console::info( "extractMesh: Added primitive {} with {} vertices", primitiveIndex, primitive->getVertexCount() );
+			console::info( "extractMesh: Primitive {} optimised, {} -> {} vertices, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+				primitiveIndex,
+				optimized.verticesBefore,
+				optimized.verticesAfter,
+				optimized.cacheBefore.acmr(),
+				optimized.cacheAfter.acmr(),
+				optimized.cacheBefore.atvr(),
+				optimized.cacheAfter.atvr() );
 		}
-		else
+		if ( report )
 		{
-			console::error( "extractMesh: Failed to extract primitive {}", primitiveIndex );
+			*report = optimized;
 		}
 	}
 
-	if ( verbose )
+	if ( m_lodGenerationEnabled )
 	{
-		std::uint32_t totalVertices = 0;
-		for ( const auto &primitive : mesh->getPrimitives() )
+		const auto lods = engine::mesh_lod::generateLods( *primitive, m_lodSettings );
+		if ( verbose && lods.levelCount() > 1 )
 		{
-			totalVertices += primitive.getVertexCount();
+			console::info( "extractMesh: Primitive {} LOD chain {} -> {} triangles over {} levels (error {:.4f})",
+				primitiveIndex,
+				lods.triangleCounts.front(),
+				lods.triangleCounts.back(),
+				lods.levelCount(),
+				lods.errors.back() );
+		}
+		if ( m_meshOptimizationEnabled && m_meshOptimizeSettings.optimizeVertexCache )
+		{
+			engine::mesh_optimize::optimizeLodVertexCache( *primitive, m_meshOptimizeSettings.cacheSize );
 		}
-		console::info( "extractMesh: Extracted mesh with {} primitives, total {} vertices",
-			mesh->getPrimitiveCount(),
-			totalVertices );
 	}
-
-	return mesh;
+	// After LOD generation, which needs the float positions; re-encoding keeps the vertex order
+	if ( m_vertexStorage != VertexStorage::Standard )
+	{
+		primitive->setVertexLayout( { importedVertexAttributes( *gltfPrimitive ), m_vertexStorage == VertexStorage::Packed } );
+	}
+	if ( verbose )
+		console::info( "extractMesh: Added primitive {} with {} vertices", primitiveIndex, primitive->getVertexCount() );
+	return primitive;
 }
 
 // NEW: Helper function to extract a single primitive
@@ -564,200 +963,77 @@ std::unique_ptr<assets::Primitive> GLTFLoader::extractPrimitive( cgltf_primitive
 	}
 
 	// Extract vertex positions (required attribute)
-	if ( positionAccessor )
+	if ( !positionAccessor )
 	{
-		if ( verbose )
-			console::info( "extractPrimitive: Position accessor has {} vertices", positionAccessor->count );
+		console::error( "extractPrimitive: No POSITION attribute found" );
+		return nullptr;
+	}
+	if ( verbose )
+		console::info( "extractPrimitive: Position accessor has {} vertices", positionAccessor->count );
 
-		if ( positionAccessor->count > 0 && positionAccessor->component_type == cgltf_component_type_r_32f && positionAccessor->type == cgltf_type_vec3 )
+	// Optional attributes in a format we cannot decode are dropped, with a warning rather than silently
+	const auto supportedOrNull = []( cgltf_accessor *accessor, cgltf_attribute_type attribute, const char *name ) -> cgltf_accessor * {
+		if ( accessor && !isSupportedAttributeFormat( accessor, attribute ) )
 		{
-			// Get buffer data through accessor
-			if ( positionAccessor->buffer_view )
-			{
-				cgltf_buffer_view *bufferView = positionAccessor->buffer_view;
-				cgltf_buffer *buffer = bufferView->buffer;
+			console::warning( "extractPrimitive: Ignoring {} attribute with unsupported format (component type {}, normalized {})", name, static_cast<int>( accessor->component_type ), accessor->normalized != 0 );
+			return nullptr;
+		}
+		return accessor;
+	};
+	normalAccessor = supportedOrNull( normalAccessor, cgltf_attribute_type_normal, "NORMAL" );
+	texCoordAccessor = supportedOrNull( texCoordAccessor, cgltf_attribute_type_texcoord, "TEXCOORD" );
+	tangentAccessor = supportedOrNull( tangentAccessor, cgltf_attribute_type_tangent, "TANGENT" );
+	colorAccessor = supportedOrNull( colorAccessor, cgltf_attribute_type_color, "COLOR" );
 
-				if ( buffer && buffer->data )
-				{
-					if ( verbose )
-						console::info( "extractPrimitive: Buffer data available, extracting positions" );
-
-					// Extract positions using corrected buffer offset logic
-					const float *bufferData = reinterpret_cast<const float *>( buffer->data );
-					const auto positions = extractFloat3Positions(
-						bufferData,
-						positionAccessor->count,
-						bufferView->offset + positionAccessor->offset,
-						bufferView->stride );
-
-					std::vector<math::Vec3f> normals;
-					if ( normalAccessor && normalAccessor->component_type == cgltf_component_type_r_32f && normalAccessor->type == cgltf_type_vec3 )
-					{
-						cgltf_buffer_view *normalBufferView = normalAccessor->buffer_view;
-						cgltf_buffer *normalBuffer = normalBufferView->buffer;
-
-						if ( normalBuffer && normalBuffer->data )
-						{
-							const float *normalBufferData = reinterpret_cast<const float *>( normalBuffer->data );
-							normals = extractFloat3Normals(
-								normalBufferData,
-								normalAccessor->count,
-								normalBufferView->offset + normalAccessor->offset,
-								normalBufferView->stride );
-
-							if ( verbose )
-								console::info( "extractPrimitive: Extracted {} normals", normals.size() );
-						}
-					}
-
-					// Extract UVs if available
-					std::vector<math::Vec2f> uvs;
-					if ( texCoordAccessor && texCoordAccessor->component_type == cgltf_component_type_r_32f && texCoordAccessor->type == cgltf_type_vec2 )
-					{
-						cgltf_buffer_view *uvBufferView = texCoordAccessor->buffer_view;
-						cgltf_buffer *uvBuffer = uvBufferView->buffer;
-
-						if ( uvBuffer && uvBuffer->data )
-						{
-							const float *uvBufferData = reinterpret_cast<const float *>( uvBuffer->data );
-							uvs = extractFloat2UVs(
-								uvBufferData,
-								texCoordAccessor->count,
-								uvBufferView->offset + texCoordAccessor->offset,
-								uvBufferView->stride );
-
-							if ( verbose )
-								console::info( "extractPrimitive: Extracted {} UVs", uvs.size() );
-						}
-					}
-
-					// Extract tangents if available
-					std::vector<math::Vec4f> tangents;
-					if ( tangentAccessor && tangentAccessor->component_type == cgltf_component_type_r_32f && tangentAccessor->type == cgltf_type_vec4 )
-					{
-						cgltf_buffer_view *tangentBufferView = tangentAccessor->buffer_view;
-						cgltf_buffer *tangentBuffer = tangentBufferView->buffer;
-
-						if ( tangentBuffer && tangentBuffer->data )
-						{
-							const float *tangentBufferData = reinterpret_cast<const float *>( tangentBuffer->data );
-							tangents = extractFloat4Tangents(
-								tangentBufferData,
-								tangentAccessor->count,
-								tangentBufferView->offset + tangentAccessor->offset,
-								tangentBufferView->stride );
-
-							if ( verbose )
-								console::info( "extractPrimitive: Extracted {} tangents", tangents.size() );
-						}
-					}
-
-					// Extract colors if available
-					std::vector<math::Vec4f> colors;
-					if ( colorAccessor && colorAccessor->component_type == cgltf_component_type_r_32f )
-					{
-						cgltf_buffer_view *colorBufferView = colorAccessor->buffer_view;
-						cgltf_buffer *colorBuffer = colorBufferView->buffer;
-
-						if ( colorBuffer && colorBuffer->data )
-						{
-							const float *colorBufferData = reinterpret_cast<const float *>( colorBuffer->data );
-
-							if ( colorAccessor->type == cgltf_type_vec3 )
-							{
-								colors = extractFloat3ColorsAsVec4(
-									colorBufferData,
-									colorAccessor->count,
-									colorBufferView->offset + colorAccessor->offset,
-									colorBufferView->stride );
-							}
-							else if ( colorAccessor->type == cgltf_type_vec4 )
-							{
-								colors = extractFloat4Colors(
-									colorBufferData,
-									colorAccessor->count,
-									colorBufferView->offset + colorAccessor->offset,
-									colorBufferView->stride );
-							}
-
-							if ( verbose )
-								console::info( "extractPrimitive: Extracted {} colors", colors.size() );
-						}
-					}
-
-					// Create vertices with extracted data
-					for ( size_t i = 0; i < positions.size(); ++i )
-					{
-						assets::Vertex vertex;
-						vertex.position = positions[i];
-
-						// Use extracted normals or default
-						if ( i < normals.size() )
-						{
-							vertex.normal = normals[i];
-						}
-						else
-						{
-							vertex.normal = math::Vec3f{ 0.0f, 0.0f, 1.0f };
-						}
-
-						// Use extracted UVs or default
-						if ( i < uvs.size() )
-						{
-							vertex.texCoord = uvs[i];
-						}
-						else
-						{
-							vertex.texCoord = math::Vec2f{ 0.0f, 0.0f };
-						}
-
-						// Use extracted tangents or default
-						if ( i < tangents.size() )
-						{
-							vertex.tangent = tangents[i];
-						}
-						else
-						{
-							vertex.tangent = math::Vec4f{ 1.0f, 0.0f, 0.0f, 1.0f };
-						}
-
-						// Use extracted colors or default (white)
-						if ( i < colors.size() )
-						{
-							vertex.color = colors[i];
-						}
-						else
-						{
-							vertex.color = math::Vec4f{ 1.0f, 1.0f, 1.0f, 1.0f };
-						}
-
-						primitiveObj->addVertex( vertex );
-					}
-
-					if ( verbose )
-						console::info( "extractPrimitive: Added {} vertices to primitive", primitiveObj->getVertexCount() );
-				}
-				else
-				{
-					console::error( "extractPrimitive: No buffer data available" );
-					return nullptr;
-				}
-			}
-			else
-			{
-				console::error( "extractPrimitive: No buffer view for position accessor" );
-				return nullptr;
-			}
+	if ( positionAccessor->count > 0 && isSupportedAttributeFormat( positionAccessor, cgltf_attribute_type_position ) )
+	{
+		if ( !positionAccessor->buffer_view )
+		{
+			console::error( "extractPrimitive: No buffer view for position accessor" );
+			return nullptr;
 		}
-		else
+		if ( !positionAccessor->buffer_view->buffer || !positionAccessor->buffer_view->buffer->data )
+		{
+			console::error( "extractPrimitive: No buffer data available" );
+			return nullptr;
+		}
+
+		VertexStreams streams;
+		streams.positions = makeAccessorStream( positionAccessor );
+		if ( !streams.positions.isValid() )
 		{
-			console::error( "extractPrimitive: Invalid position accessor format" );
+			console::error( "extractPrimitive: Position accessor exceeds its buffer" );
 			return nullptr;
 		}
+		if ( normalAccessor )
+		{
+			streams.normals = makeAccessorStream( normalAccessor );
+		}
+		if ( texCoordAccessor )
+		{
+			streams.texCoords = makeAccessorStream( texCoordAccessor );
+		}
+		if ( tangentAccessor )
+		{
+			streams.tangents = makeAccessorStream( tangentAccessor );
+		}
+		if ( colorAccessor )
+		{
+			streams.colors = makeAccessorStream( colorAccessor );
+			streams.colorComponents = colorAccessor->type == cgltf_type_vec3 ? 3 : 4;
+		}
+
+		// One strided pass per attribute into the final vertex array, then bounds in bulk
+		auto vertices = assembleVertices( streams );
+		const auto bounds = computePositionBounds( vertices );
+		primitiveObj->setVertices( std::move( vertices ), bounds );
+
+		if ( verbose )
+			console::info( "extractPrimitive: Added {} vertices to primitive", primitiveObj->getVertexCount() );
 	}
 	else
 	{
-		console::error( "extractPrimitive: No POSITION attribute found" );
+		console::error( "extractPrimitive: Invalid position accessor format" );
 		return nullptr;
 	}
 
@@ -766,54 +1042,42 @@ std::unique_ptr<assets::Primitive> GLTFLoader::extractPrimitive( cgltf_primitive
 	{
 		cgltf_accessor *indexAccessor = primitive->indices;
 
-		if ( indexAccessor->count > 0 && indexAccessor->buffer_view )
+		if ( indexAccessor->count > 0 && indexAccessor->buffer_view && indexAccessor->buffer_view->buffer && indexAccessor->buffer_view->buffer->data )
 		{
-			cgltf_buffer_view *bufferView = indexAccessor->buffer_view;
-			cgltf_buffer *buffer = bufferView->buffer;
-
-			if ( buffer && buffer->data )
+			// Convert component type to our enum
+			ComponentType componentType;
+			switch ( indexAccessor->component_type )
 			{
-				// Convert component type to our enum
-				ComponentType componentType;
-				switch ( indexAccessor->component_type )
-				{
-				case cgltf_component_type_r_8u:
-					componentType = ComponentType::UnsignedByte;
-					break;
-				case cgltf_component_type_r_16u:
-					componentType = ComponentType::UnsignedShort;
-					break;
-				case cgltf_component_type_r_32u:
-					componentType = ComponentType::UnsignedInt;
-					break;
-				default:
-					console::error( "extractPrimitive: Unsupported index component type: {}", static_cast<int>( indexAccessor->component_type ) );
-					return primitiveObj; // Return primitive with vertices but no indices
-				}
+			case cgltf_component_type_r_8u:
+				componentType = ComponentType::UnsignedByte;
+				break;
+			case cgltf_component_type_r_16u:
+				componentType = ComponentType::UnsignedShort;
+				break;
+			case cgltf_component_type_r_32u:
+				componentType = ComponentType::UnsignedInt;
+				break;
+			default:
+				console::error( "extractPrimitive: Unsupported index component type: {}", static_cast<int>( indexAccessor->component_type ) );
+				return primitiveObj; // Return primitive with vertices but no indices
+			}
 
-				// Extract indices using the utility function
-				const std::uint8_t *bufferData = reinterpret_cast<const std::uint8_t *>( buffer->data );
-				if ( verbose )
-				{
-					console::info( "extractPrimitive: Index buffer size: {}, byteOffset: {}, accessor offset: {}", buffer->size, bufferView->offset, indexAccessor->offset );
-					console::info( "extractPrimitive: Index component type: {}, count: {}", static_cast<int>( indexAccessor->component_type ), indexAccessor->count );
-				}
-				const auto indices = extractIndicesAsUint32(
-					bufferData,
-					indexAccessor->count,
-					componentType,
-					bufferView->offset + indexAccessor->offset,
-					bufferView->stride );
-
-				// Add extracted indices to primitive
-				for ( const auto index : indices )
-				{
-					primitiveObj->addIndex( index );
-				}
+			if ( verbose )
+			{
+				console::info( "extractPrimitive: Index buffer size: {}, byteOffset: {}, accessor offset: {}", indexAccessor->buffer_view->buffer->size, indexAccessor->buffer_view->offset, indexAccessor->offset );
+				console::info( "extractPrimitive: Index component type: {}, count: {}", static_cast<int>( indexAccessor->component_type ), indexAccessor->count );
+			}
 
-				if ( verbose )
-					console::info( "extractPrimitive: Added {} indices to primitive", primitiveObj->getIndexCount() );
+			const auto stream = makeAccessorStream( indexAccessor );
+			if ( !stream.isValid() )
+			{
+				console::error( "extractPrimitive: Index accessor exceeds its buffer" );
+				return primitiveObj;
 			}
+			primitiveObj->setIndices( assembleIndices( stream, componentType ) );
+
+			if ( verbose )
+				console::info( "extractPrimitive: Added {} indices to primitive", primitiveObj->getIndexCount() );
 		}
 	}
 
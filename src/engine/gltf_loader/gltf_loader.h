@@ -9,6 +9,8 @@
 #include "math/matrix.h"
 #include "math/quat.h"
 #include "../assets/assets.h"
+#include "../mesh_lod/mesh_lod.h"
+#include "../mesh_optimize/mesh_optimize.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -25,6 +27,11 @@ struct cgltf_primitive;
 struct cgltf_texture_view;
 struct cgltf_accessor;
 
+namespace runtime
+{
+class ThreadPool;
+}
+
 namespace gltf_loader
 {
 
@@ -59,20 +66,101 @@ std::vector<math::Vec4f> extractFloat3ColorsAsVec4( const float *buffer, size_t
 std::vector<uint32_t> extractIndicesAsUint32( const std::uint8_t *buffer, size_t count, ComponentType componentType, size_t byteOffset, size_t byteStride );
 void validateComponentType( ComponentType componentType, AttributeType attributeType );
 
+// Mesh optimisation results for one imported mesh, summed over its primitives
+struct MeshOptimizationStats
+{
+	std::string name; // glTF mesh name, or "mesh <index>"
+	std::uint32_t verticesBefore = 0;
+	std::uint32_t verticesAfter = 0;
+	engine::mesh_optimize::VertexCacheStats cacheBefore;
+	engine::mesh_optimize::VertexCacheStats cacheAfter;
+	bool shortIndices = true; // Every primitive fits 16-bit indices
+};
+
+// What one loadScene() call cost, for profiling large imports
+struct LoadStats
+{
+	std::uint32_t mappedFiles = 0; // .gltf/.glb and external buffers decoded in place
+	std::uint64_t mappedBytes = 0;
+	std::uint64_t parserPeakHeapBytes = 0; // Peak cgltf heap use: JSON structures, plus file contents when not mapped
+	std::vector<MeshOptimizationStats> meshOptimization; // One entry per extracted mesh when optimisation is enabled
+	std::uint32_t meshesReused = 0;						 // Meshes reloadScene() kept from the previous import
+};
+
+// How imported primitives store their vertices (assets::VertexLayout)
+enum class VertexStorage
+{
+	Standard, // assets::Vertex with every attribute
+	Trimmed,  // Float attributes, only those the file provides
+	Packed	  // Trimmed, with quantized positions, octahedral normals/tangents, half UVs and 8-bit colour
+};
+
 class GLTFLoader
 {
 public:
 	GLTFLoader();
 
-	// Main entry point for loading glTF scenes
-	std::unique_ptr<assets::Scene> loadScene( const std::string &filePath ) const;
+	// Main entry point for loading glTF scenes; null if the file or any of its buffers fails to load
+	std::unique_ptr<assets::Scene> loadScene( const std::string &filePath, LoadStats *stats = nullptr ) const;
+
+	// Re-import of a file previously imported as previous. Meshes whose source data, material and import
+	// settings hash the same as one of previous's (assets::Mesh::getSourceHash()) are that mesh, shared rather
+	// than extracted again, so re-exporting one mesh of a large file only rebuilds that mesh.
+	std::unique_ptr<assets::Scene> reloadScene( const std::string &filePath, const assets::Scene &previous, LoadStats *stats = nullptr ) const;
 
 	// For testing: load from string content
 	std::unique_ptr<assets::Scene> loadFromString( const std::string &gltfContent ) const;
 
+	// LOD chains are generated for every imported primitive; disable to import full detail only
+	void setLodGenerationEnabled( bool enabled ) noexcept { m_lodGenerationEnabled = enabled; }
+	bool isLodGenerationEnabled() const noexcept { return m_lodGenerationEnabled; }
+	void setLodSettings( const engine::mesh_lod::LodSettings &settings ) noexcept { m_lodSettings = settings; }
+	const engine::mesh_lod::LodSettings &getLodSettings() const noexcept { return m_lodSettings; }
+
+	// Source files are memory-mapped and attributes decoded straight from the mapped pages, which are
+	// unmapped once extraction finishes; disable to read them into heap memory instead
+	void setMemoryMappingEnabled( bool enabled ) noexcept { m_memoryMappingEnabled = enabled; }
+	bool isMemoryMappingEnabled() const noexcept { return m_memoryMappingEnabled; }
+
+	// Materials and meshes are extracted in parallel and added to the scene in document order; disable to
+	// extract on the calling thread. A null pool means the process-wide shared pool.
+	void setParallelExtractionEnabled( bool enabled ) noexcept { m_parallelExtractionEnabled = enabled; }
+	bool isParallelExtractionEnabled() const noexcept { return m_parallelExtractionEnabled; }
+	void setThreadPool( runtime::ThreadPool *pool ) noexcept { m_threadPool = pool; }
+
+	// Vertex storage of imported primitives. The normal is always kept, since a missing one is synthesized
+	// on import. Standard by default.
+	void setVertexStorage( VertexStorage storage ) noexcept { m_vertexStorage = storage; }
+	VertexStorage getVertexStorage() const noexcept { return m_vertexStorage; }
+
+	// Imported primitives are welded and reordered for the vertex cache, overdraw and vertex fetch before
+	// LOD generation; disable to keep the file's vertex and triangle order
+	void setMeshOptimizationEnabled( bool enabled ) noexcept { m_meshOptimizationEnabled = enabled; }
+	bool isMeshOptimizationEnabled() const noexcept { return m_meshOptimizationEnabled; }
+	void setMeshOptimizeSettings( const engine::mesh_optimize::OptimizeSettings &settings ) noexcept { m_meshOptimizeSettings = settings; }
+	const engine::mesh_optimize::OptimizeSettings &getMeshOptimizeSettings() const noexcept { return m_meshOptimizeSettings; }
+
+	// Hash of every setting that changes the imported scene, plus an importer revision; keys cooked
+	// scenes (assets::SceneCache) so a settings or importer change does not reuse them
+	std::uint64_t getImportSettingsHash() const;
+
 private:
+	bool m_lodGenerationEnabled = true;
+	bool m_meshOptimizationEnabled = true;
+	bool m_memoryMappingEnabled = true;
+	bool m_parallelExtractionEnabled = true;
+	VertexStorage m_vertexStorage = VertexStorage::Standard;
+	runtime::ThreadPool *m_threadPool = nullptr;
+	engine::mesh_lod::LodSettings m_lodSettings;
+	engine::mesh_optimize::OptimizeSettings m_meshOptimizeSettings;
+
 	// Helper methods for glTF processing (use void* to avoid forward declaration issues)
-	std::unique_ptr<assets::Scene> processSceneData( cgltf_data *data, const std::string &baseFilename ) const;
+	std::unique_ptr<assets::Scene> loadSceneFile( const std::string &filePath, LoadStats *stats, const assets::Scene *previous ) const;
+	std::unique_ptr<assets::Scene> processSceneData( cgltf_data *data, const std::string &baseFilename, LoadStats *stats = nullptr, const assets::Scene *previous = nullptr ) const;
+
+	// Hash of everything a mesh is extracted from, seeded with the import settings; 0 if it reads data
+	// that cannot be hashed in place (sparse accessors, missing buffers), so it is never reused
+	std::uint64_t hashMeshSource( const cgltf_mesh &mesh, const cgltf_data *data, const std::vector<assets::MaterialHandle> &materialHandles, std::uint64_t seed ) const;
 
 	std::unique_ptr<assets::SceneNode> processNode(
 		cgltf_node *gltfNode,
@@ -81,8 +169,9 @@ private:
 		const std::vector<assets::MaterialHandle> &materialHandles,
 		const std::string &rootNodeName = "" ) const;
 
-	// Mesh extraction helpers
-	std::shared_ptr<assets::Mesh> extractMesh( cgltf_mesh *gltfMesh, cgltf_data *data, const std::vector<assets::MaterialHandle> &materialHandles, bool verbose = false ) const;
+	// Mesh extraction helpers; one primitive with its LOD chain, independent of every other primitive.
+	// report receives the optimisation results when optimisation is enabled.
+	std::unique_ptr<assets::Primitive> extractMeshPrimitive( cgltf_primitive *gltfPrimitive, cgltf_size primitiveIndex, cgltf_data *data, const std::vector<assets::MaterialHandle> &materialHandles, engine::mesh_optimize::OptimizeReport *report = nullptr, bool verbose = false ) const;
 	std::unique_ptr<assets::Primitive> extractPrimitive( cgltf_primitive *gltfPrimitive, cgltf_data *data, const std::vector<assets::MaterialHandle> &materialHandles, bool verbose = false ) const;
 
 	// Material extraction helpers
@@ -0,0 +1,146 @@
+#include "engine/gltf_loader/vertex_assembly.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#define ENGINE_VERTEX_ASSEMBLY_SSE 1
+#endif
+
+namespace gltf_loader
+{
+
+namespace
+{
+// Vertices per block: all attribute passes over one block run while it is still in L1/L2 (72 KB)
+constexpr std::size_t kAssemblyBlock = 1024;
+
+AccessorStream sliceStream( const AccessorStream &stream, std::size_t begin, std::size_t count ) noexcept
+{
+	if ( !stream.isValid() || begin >= stream.count )
+	{
+		return {};
+	}
+	return { stream.data + begin * stream.stride, std::min( count, stream.count - begin ), stream.stride, stream.componentType, stream.normalized };
+}
+} // namespace
+
+std::vector<assets::Vertex> assembleVertices( const VertexStreams &streams )
+{
+	if ( !streams.positions.isValid() )
+	{
+		return {};
+	}
+
+	const std::size_t vertexCount = streams.positions.count;
+	std::vector<assets::Vertex> vertices;
+	vertices.reserve( vertexCount );
+	for ( std::size_t begin = 0; begin < vertexCount; begin += kAssemblyBlock )
+	{
+		// Growing within the reserved capacity default-constructs just this block, so that pass stays in cache too
+		const std::size_t count = std::min( kAssemblyBlock, vertexCount - begin );
+		vertices.resize( begin + count );
+		const std::span<assets::Vertex> block( vertices.data() + begin, count );
+
+		writeAttribute<3>( block, sliceStream( streams.positions, begin, count ), &assets::Vertex::position );
+
+		const auto normals = sliceStream( streams.normals, begin, count );
+		writeAttribute<3>( block, normals, &assets::Vertex::normal );
+		for ( std::size_t i = normals.count; i < count; ++i )
+		{
+			block[i].normal = kDefaultImportNormal;
+		}
+
+		writeAttribute<2>( block, sliceStream( streams.texCoords, begin, count ), &assets::Vertex::texCoord );
+		writeAttribute<4>( block, sliceStream( streams.tangents, begin, count ), &assets::Vertex::tangent );
+
+		// RGB colours keep the default alpha of 1
+		const auto colors = sliceStream( streams.colors, begin, count );
+		if ( streams.colorComponents == 3 )
+		{
+			writeAttribute<3>( block, colors, &assets::Vertex::color );
+		}
+		else
+		{
+			writeAttribute<4>( block, colors, &assets::Vertex::color );
+		}
+	}
+	return vertices;
+}
+
+math::BoundingBox3Df computePositionBounds( std::span<const assets::Vertex> vertices ) noexcept
+{
+	math::BoundingBox3Df bounds;
+	if ( vertices.empty() )
+	{
+		return bounds;
+	}
+
+#if defined( ENGINE_VERTEX_ASSEMBLY_SSE )
+	// The normal follows the position in Vertex, so a 4-float load per vertex stays inside the array;
+	// the fourth lane is ignored. Two accumulators hide the min/max latency.
+	static_assert( offsetof( assets::Vertex, normal ) == offsetof( assets::Vertex, position ) + 3 * sizeof( float ) );
+	const float *first = &vertices[0].position.x;
+	__m128 min0 = _mm_loadu_ps( first );
+	__m128 max0 = min0;
+	__m128 min1 = min0;
+	__m128 max1 = min0;
+	std::size_t i = 1;
+	for ( ; i + 1 < vertices.size(); i += 2 )
+	{
+		const __m128 a = _mm_loadu_ps( &vertices[i].position.x );
+		const __m128 b = _mm_loadu_ps( &vertices[i + 1].position.x );
+		min0 = _mm_min_ps( min0, a );
+		max0 = _mm_max_ps( max0, a );
+		min1 = _mm_min_ps( min1, b );
+		max1 = _mm_max_ps( max1, b );
+	}
+	if ( i < vertices.size() )
+	{
+		const __m128 a = _mm_loadu_ps( &vertices[i].position.x );
+		min0 = _mm_min_ps( min0, a );
+		max0 = _mm_max_ps( max0, a );
+	}
+
+	alignas( 16 ) float minLanes[4];
+	alignas( 16 ) float maxLanes[4];
+	_mm_store_ps( minLanes, _mm_min_ps( min0, min1 ) );
+	_mm_store_ps( maxLanes, _mm_max_ps( max0, max1 ) );
+	bounds.min = { minLanes[0], minLanes[1], minLanes[2] };
+	bounds.max = { maxLanes[0], maxLanes[1], maxLanes[2] };
+#else
+	for ( const auto &vertex : vertices )
+	{
+		bounds.expand( vertex.position );
+	}
+#endif
+	return bounds;
+}
+
+std::vector<std::uint32_t> assembleIndices( const AccessorStream &stream, ComponentType componentType )
+{
+	if ( !stream.isValid() )
+	{
+		return {};
+	}
+
+	std::vector<std::uint32_t> indices( stream.count );
+	switch ( componentType )
+	{
+	case ComponentType::UnsignedByte:
+		widenIndices<std::uint8_t>( stream, indices.data() );
+		break;
+	case ComponentType::UnsignedShort:
+		widenIndices<std::uint16_t>( stream, indices.data() );
+		break;
+	case ComponentType::UnsignedInt:
+		widenIndices<std::uint32_t>( stream, indices.data() );
+		break;
+	default:
+		return {};
+	}
+	return indices;
+}
+
+} // namespace gltf_loader
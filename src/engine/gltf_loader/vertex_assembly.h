@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/gltf_loader/gltf_loader.h"
+#include "math/bounding_box_3d.h"
+
+// Accessor-to-vertex assembly for the glTF loader: attributes are written straight from their (possibly
+// interleaved, possibly memory-mapped) buffers into a pre-sized vertex array, one strided pass each,
+// without per-attribute temporaries or per-vertex push_back/bounds updates. Integer and normalized
+// components (core glTF and KHR_mesh_quantization) are converted in the same pass.
+namespace gltf_loader
+{
+
+// Strided view of one accessor's elements inside its buffer
+struct AccessorStream
+{
+	const std::uint8_t *data = nullptr; // First element
+	std::size_t count = 0;
+	std::size_t stride = 0; // Bytes between elements; never 0
+	ComponentType componentType = ComponentType::Float;
+	bool normalized = false; // Integer components map to [0, 1] or [-1, 1]
+
+	bool isValid() const noexcept { return data != nullptr && count > 0; }
+};
+
+struct VertexStreams
+{
+	AccessorStream positions; // float3; defines the vertex count
+	AccessorStream normals;	  // float3
+	AccessorStream texCoords; // float2
+	AccessorStream tangents;  // float4
+	AccessorStream colors;	  // float3 or float4
+	std::uint32_t colorComponents = 4;
+};
+
+// Normal written where the primitive has none (the Vertex default points along +Y, glTF imports use +Z)
+inline constexpr math::Vec3f kDefaultImportNormal{ 0.0f, 0.0f, 1.0f };
+
+// Copy Components floats of each element into the given member, for the first min( count, vertices ) vertices
+template <std::size_t Components, typename Member>
+void writeFloatAttribute( std::span<assets::Vertex> vertices, const AccessorStream &stream, Member assets::Vertex::*member ) noexcept
+{
+	static_assert( Components * sizeof( float ) <= sizeof( Member ) );
+	const std::size_t count = stream.count < vertices.size() ? stream.count : vertices.size();
+	const std::uint8_t *source = stream.data;
+	for ( std::size_t i = 0; i < count; ++i, source += stream.stride )
+	{
+		std::memcpy( static_cast<void *>( &( vertices[i].*member ) ), source, Components * sizeof( float ) );
+	}
+}
+
+// Integer variant of writeFloatAttribute: each component is converted, and normalized to [0, 1] / [-1, 1]
+// when the stream says so (signed values clamp at -1, as glTF specifies)
+template <typename Component, std::size_t Components, typename Member>
+void decodeAttribute( std::span<assets::Vertex> vertices, const AccessorStream &stream, Member assets::Vertex::*member ) noexcept
+{
+	static_assert( Components * sizeof( float ) <= sizeof( Member ) );
+	const float scale = stream.normalized ? 1.0f / static_cast<float>( std::numeric_limits<Component>::max() ) : 1.0f;
+	const std::size_t count = stream.count < vertices.size() ? stream.count : vertices.size();
+	const std::uint8_t *source = stream.data;
+	for ( std::size_t i = 0; i < count; ++i, source += stream.stride )
+	{
+		float values[Components];
+		for ( std::size_t c = 0; c < Components; ++c )
+		{
+			Component component;
+			std::memcpy( &component, source + c * sizeof( Component ), sizeof( Component ) );
+			values[c] = static_cast<float>( component ) * scale;
+			if constexpr ( std::is_signed_v<Component> )
+			{
+				values[c] = stream.normalized && values[c] < -1.0f ? -1.0f : values[c];
+			}
+		}
+		std::memcpy( static_cast<void *>( &( vertices[i].*member ) ), values, sizeof( values ) );
+	}
+}
+
+// Dispatch on the stream's component type; unsigned int streams are not valid attributes and are skipped
+template <std::size_t Components, typename Member>
+void writeAttribute( std::span<assets::Vertex> vertices, const AccessorStream &stream, Member assets::Vertex::*member ) noexcept
+{
+	switch ( stream.componentType )
+	{
+	case ComponentType::Float:
+		writeFloatAttribute<Components>( vertices, stream, member );
+		break;
+	case ComponentType::Byte:
+		decodeAttribute<std::int8_t, Components>( vertices, stream, member );
+		break;
+	case ComponentType::UnsignedByte:
+		decodeAttribute<std::uint8_t, Components>( vertices, stream, member );
+		break;
+	case ComponentType::Short:
+		decodeAttribute<std::int16_t, Components>( vertices, stream, member );
+		break;
+	case ComponentType::UnsignedShort:
+		decodeAttribute<std::uint16_t, Components>( vertices, stream, member );
+		break;
+	default:
+		break;
+	}
+}
+
+// Vertex array for the streams; attributes that are missing or shorter than the positions keep the loader defaults
+std::vector<assets::Vertex> assembleVertices( const VertexStreams &streams );
+
+// Bounds of all vertex positions
+math::BoundingBox3Df computePositionBounds( std::span<const assets::Vertex> vertices ) noexcept;
+
+// Widen count indices of type Index to 32 bits
+template <typename Index>
+void widenIndices( const AccessorStream &stream, std::uint32_t *out ) noexcept
+{
+	if ( stream.stride == sizeof( Index ) )
+	{
+		if constexpr ( sizeof( Index ) == sizeof( std::uint32_t ) )
+		{
+			std::memcpy( out, stream.data, stream.count * sizeof( Index ) );
+		}
+		else
+		{
+			// Tightly packed: a plain widening loop the compiler vectorises
+			for ( std::size_t i = 0; i < stream.count; ++i )
+			{
+				Index value;
+				std::memcpy( &value, stream.data + i * sizeof( Index ), sizeof( Index ) );
+				out[i] = value;
+			}
+		}
+		return;
+	}
+
+	const std::uint8_t *source = stream.data;
+	for ( std::size_t i = 0; i < stream.count; ++i, source += stream.stride )
+	{
+		Index value;
+		std::memcpy( &value, source, sizeof( Index ) );
+		out[i] = value;
+	}
+}
+
+// 32-bit index list for an index accessor of unsigned byte, short or int components; empty for other types
+std::vector<std::uint32_t> assembleIndices( const AccessorStream &stream, ComponentType componentType );
+
+} // namespace gltf_loader
@@ -1,7 +1,11 @@
 #include "gpu_resource_manager.h"
 
+#include <algorithm>
+
 #include "engine/assets/assets.h"
 #include "engine/gpu/material_gpu.h"
+#include "engine/render_backend/d3d12_upload_backend.h"
+#include "platform/dx12/dx12_device.h"
 #include "runtime/console.h"
 
 namespace engine
@@ -17,6 +21,10 @@ GPUResourceManager::GPUResourceManager( dx12::Device &device )
 		return;
 	}
 
+	m_geometryPool = std::make_shared<engine::geometry_pool::GeometryPool>(
+		std::make_shared<engine::render_backend::D3D12UploadBackend>( device, L"Geometry Pool" ),
+		static_cast<std::uint32_t>( sizeof( assets::Vertex ) ) );
+
 	console::info( "GPUResourceManager initialized successfully" );
 }
 
@@ -32,30 +40,139 @@ std::shared_ptr<engine::gpu::MeshGPU> GPUResourceManager::getMeshGPU( std::share
 	const auto it = m_meshCache.find( mesh.get() );
 	if ( it != m_meshCache.end() )
 	{
-		if ( const auto cached = it->second.lock() )
+		const auto cached = it->second.gpuMesh.lock();
+		if ( cached && it->second.sourceMesh.lock() == mesh )
 		{
 			++m_statistics.cacheHits;
+			// Bring evicted geometry back for the caller
+			m_residency.request( it->second.residencyId );
 			return cached;
 		}
-		// Weak pointer expired, remove from cache
-		m_meshCache.erase( it );
+		// Weak pointer expired or the address now belongs to another mesh, remove from cache
+		eraseMeshEntry( it );
 	}
 
 	// Cache miss - create new GPU buffers
 	++m_statistics.cacheMisses;
-	const auto gpuBuffers = std::make_shared<engine::gpu::MeshGPU>( *m_device, *mesh );
+	const auto gpuBuffers = std::make_shared<engine::gpu::MeshGPU>( *m_device, *mesh, m_geometryPool );
 	if ( !gpuBuffers->isValid() )
 	{
 		console::error( "GPUResourceManager: failed to create GPU buffers for mesh" );
 		return nullptr;
 	}
 
-	// Cache the new resource
-	m_meshCache[mesh.get()] = gpuBuffers;
+	// Cache the new resource and start tracking its residency
+	const residency::ResourceId residencyId = m_nextResidencyId++;
+	gpuBuffers->setResidencyId( residencyId );
+	m_meshCache[mesh.get()] = MeshCacheEntry{ gpuBuffers, mesh, residencyId };
+	m_meshesByResidencyId[residencyId] = mesh.get();
+	m_residency.add( residencyId, gpuBuffers->getGpuMemoryBytes() );
 
 	return gpuBuffers;
 }
 
+std::shared_ptr<engine::gpu::MeshGPU> GPUResourceManager::reloadMeshGPU( const std::shared_ptr<assets::Mesh> &mesh )
+{
+	const auto it = mesh ? m_meshCache.find( mesh.get() ) : m_meshCache.end();
+	if ( it == m_meshCache.end() || it->second.sourceMesh.lock() != mesh )
+	{
+		return nullptr;
+	}
+	const auto gpuMesh = it->second.gpuMesh.lock();
+	if ( !gpuMesh )
+	{
+		return nullptr;
+	}
+
+	for ( auto &primitive : gpuMesh->reload( *mesh ) )
+	{
+		m_pendingPrimitiveDeletions.push_back( std::move( primitive ) );
+	}
+
+	// The rebuilt geometry is resident whatever the old state was
+	const residency::ResourceId residencyId = it->second.residencyId;
+	if ( residencyId != residency::kInvalidResource )
+	{
+		if ( m_residency.isResident( residencyId ) )
+		{
+			m_residency.updateSize( residencyId, gpuMesh->getGpuMemoryBytes() );
+		}
+		else
+		{
+			m_residency.remove( residencyId );
+			m_residency.add( residencyId, gpuMesh->getGpuMemoryBytes() );
+		}
+	}
+	return gpuMesh;
+}
+
+std::shared_ptr<engine::gpu::MaterialGPU> GPUResourceManager::reloadMaterialGPU( const std::shared_ptr<assets::Material> &material )
+{
+	const auto it = material ? m_materialCache.find( material.get() ) : m_materialCache.end();
+	const auto materialGPU = it != m_materialCache.end() ? it->second.lock() : nullptr;
+	if ( !materialGPU || materialGPU->getSourceMaterial() != material )
+	{
+		return nullptr;
+	}
+	if ( auto previous = materialGPU->refresh() )
+	{
+		m_pendingResourceDeletions.push_back( std::move( previous ) );
+	}
+	return materialGPU;
+}
+
+bool GPUResourceManager::requestResident( const engine::gpu::MeshGPU &mesh )
+{
+	if ( !m_residency.isRegistered( mesh.getResidencyId() ) )
+	{
+		// Not created by this manager or no longer tracked, so it is never evicted
+		return mesh.isValid();
+	}
+	return m_residency.request( mesh.getResidencyId() );
+}
+
+std::uint64_t GPUResourceManager::MeshUploader::upload( residency::ResourceId id )
+{
+	const auto idIt = m_owner.m_meshesByResidencyId.find( id );
+	if ( idIt == m_owner.m_meshesByResidencyId.end() )
+	{
+		return 0;
+	}
+	const auto &entry = m_owner.m_meshCache.at( idIt->second );
+	const auto gpuMesh = entry.gpuMesh.lock();
+	const auto sourceMesh = entry.sourceMesh.lock();
+	if ( !gpuMesh || !sourceMesh )
+	{
+		console::warning( "GPUResourceManager: cannot re-upload mesh geometry, the source mesh was unloaded" );
+		return 0;
+	}
+	if ( !gpuMesh->restoreGeometry( *sourceMesh ) )
+	{
+		return 0;
+	}
+	return gpuMesh->getGpuMemoryBytes();
+}
+
+void GPUResourceManager::MeshUploader::evict( residency::ResourceId id )
+{
+	const auto idIt = m_owner.m_meshesByResidencyId.find( id );
+	if ( idIt == m_owner.m_meshesByResidencyId.end() )
+	{
+		return;
+	}
+	if ( const auto gpuMesh = m_owner.m_meshCache.at( idIt->second ).gpuMesh.lock() )
+	{
+		gpuMesh->evictGeometry();
+	}
+}
+
+void GPUResourceManager::eraseMeshEntry( std::unordered_map<assets::Mesh *, MeshCacheEntry>::iterator it )
+{
+	m_residency.remove( it->second.residencyId );
+	m_meshesByResidencyId.erase( it->second.residencyId );
+	m_meshCache.erase( it );
+}
+
 
 std::shared_ptr<engine::gpu::MaterialGPU> GPUResourceManager::getMaterialGPU( std::shared_ptr<assets::Material> material )
 {
@@ -121,13 +238,20 @@ std::shared_ptr<engine::gpu::MaterialGPU> GPUResourceManager::getDefaultMaterial
 void GPUResourceManager::clearCache()
 {
 	console::info( "GPUResourceManager: Clearing all caches" );
+	for ( const auto &[id, mesh] : m_meshesByResidencyId )
+	{
+		m_residency.remove( id );
+	}
+	m_meshesByResidencyId.clear();
 	m_meshCache.clear();
 	m_materialCache.clear();
 
 	// Reset cache sizes in statistics but preserve hit/miss counts
 	m_statistics.meshCacheSize = 0;
 	m_statistics.materialCacheSize = 0;
-	m_statistics.estimatedMemoryUsage = 0;
+	m_statistics.meshMemoryBytes = 0;
+	m_statistics.materialMemoryBytes = 0;
+	m_statistics.memoryUsage = 0;
 }
 
 void GPUResourceManager::unloadUnusedResources()
@@ -138,17 +262,23 @@ void GPUResourceManager::unloadUnusedResources()
 
 void GPUResourceManager::cleanupExpiredReferences()
 {
-	// Clean up expired weak_ptr references from mesh cache
+	// Clean up expired weak_ptr references from mesh cache; their geometry no longer counts against the budget
 	for ( auto it = m_meshCache.begin(); it != m_meshCache.end(); )
 	{
-		if ( it->second.expired() )
+		if ( it->second.gpuMesh.expired() )
 		{
-			it = m_meshCache.erase( it );
+			const auto expired = it++;
+			eraseMeshEntry( expired );
+			continue;
 		}
-		else
+		if ( it->second.sourceMesh.expired() && it->second.residencyId != residency::kInvalidResource )
 		{
-			++it;
+			// Without its source the geometry cannot be rebuilt, so it stays resident until the MeshGPU dies
+			m_residency.remove( it->second.residencyId );
+			m_meshesByResidencyId.erase( it->second.residencyId );
+			it->second.residencyId = residency::kInvalidResource;
 		}
+		++it;
 	}
 
 	// Clean up expired weak_ptr references from material cache
@@ -168,16 +298,23 @@ void GPUResourceManager::cleanupExpiredReferences()
 void GPUResourceManager::resetStatistics()
 {
 	m_statistics = Statistics{};
+	m_residency.resetCounters();
 	updateStatistics();
 }
 
+const GPUResourceManager::Statistics &GPUResourceManager::getStatistics() const
+{
+	updateStatistics();
+	return m_statistics;
+}
+
 void GPUResourceManager::updateStatistics() const
 {
 	// Count active cache entries (non-expired)
 	m_statistics.meshCacheSize = 0;
 	for ( const auto &pair : m_meshCache )
 	{
-		if ( !pair.second.expired() )
+		if ( !pair.second.gpuMesh.expired() )
 		{
 			++m_statistics.meshCacheSize;
 		}
@@ -192,11 +329,27 @@ void GPUResourceManager::updateStatistics() const
 		}
 	}
 
-	// Rough memory estimation (this is a simplified calculation)
-	// In a real implementation, you'd want more accurate memory tracking
-	m_statistics.estimatedMemoryUsage =
-		( m_statistics.meshCacheSize * 1024 * 1024 ) + // Assume 1MB per mesh on average
-		( m_statistics.materialCacheSize * 1024 );	   // Assume 1KB per material on average
+	// Exact sizes recorded when resources were created or re-uploaded
+	const auto &residencyStats = m_residency.getStats();
+	m_statistics.meshMemoryBytes = residencyStats.residentBytes;
+	m_statistics.materialMemoryBytes = getMaterialMemoryBytes();
+	m_statistics.memoryUsage = m_statistics.meshMemoryBytes + m_statistics.materialMemoryBytes;
+	m_statistics.residencyHits = residencyStats.hits;
+	m_statistics.residencyMisses = residencyStats.misses;
+	m_statistics.evictions = residencyStats.evictions;
+}
+
+std::uint64_t GPUResourceManager::getMaterialMemoryBytes() const
+{
+	std::uint64_t bytes = m_defaultMaterialGPU ? m_defaultMaterialGPU->getGpuMemoryBytes() : 0;
+	for ( const auto &pair : m_materialCache )
+	{
+		if ( const auto material = pair.second.lock() )
+		{
+			bytes += material->getGpuMemoryBytes();
+		}
+	}
+	return bytes;
 }
 
 void GPUResourceManager::processPendingDeletes()
@@ -204,6 +357,32 @@ void GPUResourceManager::processPendingDeletes()
 	// Clear pending deletions now that the command list has been executed
 	m_pendingMeshDeletions.clear();
 	m_pendingMaterialDeletions.clear();
+	m_pendingPrimitiveDeletions.clear();
+	m_pendingResourceDeletions.clear();
+
+	if ( !m_geometryPool )
+	{
+		return;
+	}
+
+	// Materials are small and shared by many meshes, so they stay resident and only shrink the mesh budget
+	cleanupExpiredReferences();
+	const std::uint64_t materialBytes = getMaterialMemoryBytes();
+	m_residency.setBudget( m_memoryBudget == residency::kUnlimitedBudget ? residency::kUnlimitedBudget
+																		  : m_memoryBudget - std::min( m_memoryBudget, materialBytes ) );
+	m_residency.enforceBudget();
+	m_residency.advanceFrame();
+
+	// Ranges freed this frame become reusable once the GPU passes the next fence signal
+	m_geometryPool->endFrame( m_device->getCurrentFenceValue() );
+	if ( m_geometryPool->shouldDefragment() )
+	{
+		const auto moved = m_geometryPool->defragment();
+		if ( moved > 0 )
+		{
+			console::info( "GPUResourceManager: defragmented geometry pool, moved {} bytes", moved );
+		}
+	}
 }
 
 void GPUResourceManager::queueForDeletion( std::shared_ptr<engine::gpu::MeshGPU> meshGPU )
@@ -4,13 +4,16 @@
 #include <unordered_map>
 #include <vector>
 #include <wrl.h>
+#include "engine/geometry_pool/geometry_pool.h"
 #include "engine/gpu/mesh_gpu.h"
+#include "engine/residency/residency_manager.h"
 
 namespace engine
 {
 
-// GPU resource manager with caching support
-class GPUResourceManager : public gpu::MaterialProvider
+// GPU resource manager with caching support. Mesh geometry is kept within a memory budget: meshes
+// outside the visible set are evicted least recently used first and re-uploaded when requested again.
+class GPUResourceManager : public gpu::MaterialProvider, public gpu::ResidencyProvider
 {
 public:
 	// Constructor
@@ -25,19 +28,37 @@ public:
 	GPUResourceManager( GPUResourceManager && ) = delete;
 	GPUResourceManager &operator=( GPUResourceManager && ) = delete;
 
-	// Mesh resource caching
+	// Mesh resource caching; primitives suballocate from the shared geometry pool
 	std::shared_ptr<engine::gpu::MeshGPU> getMeshGPU( std::shared_ptr<assets::Mesh> mesh );
 
+	// Shared vertex/index buffers for all cached meshes
+	const engine::geometry_pool::GeometryPool &getGeometryPool() const noexcept { return *m_geometryPool; }
+
 	// Material resource caching
 	std::shared_ptr<engine::gpu::MaterialGPU> getMaterialGPU( std::shared_ptr<assets::Material> material ) override;
 	std::shared_ptr<engine::gpu::MaterialGPU> getDefaultMaterialGPU() override;
 
+	// Hot reload of a mesh or material changed in place: the cached MeshGPU is rebuilt, or the MaterialGPU
+	// re-reads its constants, keeping the object everything already holds. The replaced GPU buffers are
+	// released by processPendingDeletes(). Null if nothing is cached for it.
+	std::shared_ptr<engine::gpu::MeshGPU> reloadMeshGPU( const std::shared_ptr<assets::Mesh> &mesh );
+	std::shared_ptr<engine::gpu::MaterialGPU> reloadMaterialGPU( const std::shared_ptr<assets::Material> &material );
+
+	// Visible meshes call this every frame; evicted geometry is re-uploaded from its source mesh
+	bool requestResident( const engine::gpu::MeshGPU &mesh ) override;
+
+	// Budget for mesh geometry plus material buffers in bytes; enforced by processPendingDeletes
+	void setMemoryBudget( std::uint64_t bytes ) noexcept { m_memoryBudget = bytes; }
+	std::uint64_t getMemoryBudget() const noexcept { return m_memoryBudget; }
+	const residency::ResidencyStats &getResidencyStats() const noexcept { return m_residency.getStats(); }
+
 	// Cache management
 	void clearCache();
 	void unloadUnusedResources();
 	void cleanupExpiredReferences();
 
-	// Frame management for deferred resource cleanup
+	// Frame management for deferred resource cleanup; evicts meshes not used this frame while over
+	// budget, recycles freed geometry pool ranges and defragments the pool when its free space has splintered
 	void processPendingDeletes();
 
 	// Queue resources for deferred deletion
@@ -51,10 +72,15 @@ public:
 		std::size_t materialCacheSize = 0;
 		std::uint64_t cacheHits = 0;
 		std::uint64_t cacheMisses = 0;
-		std::size_t estimatedMemoryUsage = 0; // Bytes
+		std::uint64_t meshMemoryBytes = 0;	   // Exact bytes of resident mesh geometry
+		std::uint64_t materialMemoryBytes = 0; // Exact bytes of material buffers
+		std::uint64_t memoryUsage = 0;		   // Sum of the two, compared against the budget
+		std::uint64_t residencyHits = 0;	   // Visible meshes that were already resident
+		std::uint64_t residencyMisses = 0;	   // Visible meshes re-uploaded on demand
+		std::uint64_t evictions = 0;
 	};
 
-	const Statistics &getStatistics() const { return m_statistics; }
+	const Statistics &getStatistics() const;
 	void resetStatistics();
 
 	// Validation
@@ -66,19 +92,52 @@ private:
 	// Default material for primitives without materials
 	std::shared_ptr<engine::gpu::MaterialGPU> m_defaultMaterialGPU;
 
+	// Shared with every pooled PrimitiveGPU, which may outlive the manager
+	std::shared_ptr<engine::geometry_pool::GeometryPool> m_geometryPool;
+
+	// Source mesh is kept weakly so evicted geometry can be rebuilt, and a reused address is not mistaken for a hit
+	struct MeshCacheEntry
+	{
+		std::weak_ptr<engine::gpu::MeshGPU> gpuMesh;
+		std::weak_ptr<assets::Mesh> sourceMesh;
+		residency::ResourceId residencyId = residency::kInvalidResource;
+	};
+
+	// Uploads and evicts mesh geometry on behalf of the residency policy
+	class MeshUploader : public residency::ResidencyUploader
+	{
+	public:
+		explicit MeshUploader( GPUResourceManager &owner ) : m_owner( owner ) {}
+		std::uint64_t upload( residency::ResourceId id ) override;
+		void evict( residency::ResourceId id ) override;
+
+	private:
+		GPUResourceManager &m_owner;
+	};
+
 	// Cache maps using weak_ptr for automatic cleanup
-	std::unordered_map<assets::Mesh *, std::weak_ptr<engine::gpu::MeshGPU>> m_meshCache;
+	std::unordered_map<assets::Mesh *, MeshCacheEntry> m_meshCache;
 	std::unordered_map<assets::Material *, std::weak_ptr<engine::gpu::MaterialGPU>> m_materialCache;
 
+	MeshUploader m_meshUploader{ *this };
+	residency::ResidencyManager m_residency{ m_meshUploader };
+	std::unordered_map<residency::ResourceId, assets::Mesh *> m_meshesByResidencyId;
+	residency::ResourceId m_nextResidencyId = 1;
+	std::uint64_t m_memoryBudget = residency::kUnlimitedBudget;
+
 	// Statistics tracking
 	mutable Statistics m_statistics;
 
 	// Deferred deletion queues
 	std::vector<std::shared_ptr<engine::gpu::MeshGPU>> m_pendingMeshDeletions;
 	std::vector<std::shared_ptr<engine::gpu::MaterialGPU>> m_pendingMaterialDeletions;
+	std::vector<std::unique_ptr<engine::gpu::PrimitiveGPU>> m_pendingPrimitiveDeletions; // Replaced by hot reloads
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> m_pendingResourceDeletions;
 
 	// Helper methods for statistics
 	void updateStatistics() const;
+	std::uint64_t getMaterialMemoryBytes() const;
+	void eraseMeshEntry( std::unordered_map<assets::Mesh *, MeshCacheEntry>::iterator it );
 };
 
 } // namespace engine
@@ -77,6 +77,11 @@ MaterialGPU &MaterialGPU::operator=( MaterialGPU &&other ) noexcept
 
 MaterialGPU::~MaterialGPU() = default;
 
+D3D12_GPU_VIRTUAL_ADDRESS MaterialGPU::getConstantBufferAddress() const
+{
+	return ( m_device && m_constantBuffer ) ? m_constantBuffer->GetGPUVirtualAddress() : 0;
+}
+
 void MaterialGPU::bindToCommandList( ID3D12GraphicsCommandList *commandList ) const
 {
 	if ( !isValid() || !commandList )
@@ -102,6 +107,30 @@ void MaterialGPU::bindToCommandList( ID3D12GraphicsCommandList *commandList ) co
 	// This would involve setting descriptor tables or root descriptors for textures
 }
 
+std::uint64_t MaterialGPU::getGpuMemoryBytes() const
+{
+	if ( !m_constantBuffer || !m_device )
+	{
+		return 0;
+	}
+
+	// A committed resource takes a whole allocation, not just the 256-byte aligned constants
+	const D3D12_RESOURCE_DESC desc = m_constantBuffer->GetDesc();
+	return m_device->get()->GetResourceAllocationInfo( 0, 1, &desc ).SizeInBytes;
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> MaterialGPU::refresh()
+{
+	auto previous = std::move( m_constantBuffer );
+	m_constantBuffer.Reset();
+	updateMaterialConstants();
+	if ( m_device )
+	{
+		createConstantBuffer();
+	}
+	return previous;
+}
+
 void MaterialGPU::createConstantBuffer()
 {
 	if ( !m_device )
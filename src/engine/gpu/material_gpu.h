@@ -69,15 +69,25 @@ public:
 	// Bind all GPU resources to command list for rendering
 	void bindToCommandList( ID3D12GraphicsCommandList *commandList ) const;
 
+	// GPU address of the material constant buffer (b2), 0 when no GPU resources were created
+	D3D12_GPU_VIRTUAL_ADDRESS getConstantBufferAddress() const;
+
 	// Resource accessor methods
 	const MaterialConstants &getMaterialConstants() const { return m_materialConstants; }
 
+	// Bytes the GPU resources occupy, including allocation alignment; 0 without GPU resources
+	std::uint64_t getGpuMemoryBytes() const;
+
 	// Validation methods
 	bool isValid() const { return m_isValid; }
 
 	// Material source access
 	std::shared_ptr<assets::Material> getSourceMaterial() const { return m_material; }
 
+	// Hot reload: re-read the source material after it changed in place. The constants go to a new buffer,
+	// since frames in flight may still read the old one; returns the old buffer for deferred release.
+	Microsoft::WRL::ComPtr<ID3D12Resource> refresh();
+
 private:
 	std::shared_ptr<assets::Material> m_material;
 	MaterialConstants m_materialConstants;
@@ -10,11 +10,29 @@
 namespace engine::gpu
 {
 
-PrimitiveGPU::PrimitiveGPU( dx12::Device &device, const assets::Primitive &primitive )
-	: m_device( device ), m_vertexCount( primitive.getVertexCount() ), m_indexCount( primitive.getIndexCount() ), m_material( nullptr )
+PrimitiveGPU::PrimitiveGPU( dx12::Device &device, const assets::Primitive &primitive, std::shared_ptr<geometry_pool::GeometryPool> geometryPool )
+	: m_vertexCount( primitive.getVertexCount() ), m_indexCount( primitive.getIndexCount() ), m_vertexLayout( primitive.getVertexLayout() ), m_positionQuantization( primitive.getPositionQuantization() ), m_device( device ), m_material( nullptr ), m_geometryPool( std::move( geometryPool ) )
+{
+	createGeometry( primitive );
+}
+
+PrimitiveGPU::~PrimitiveGPU()
+{
+	// The pool keeps the ranges until the GPU has finished the frames that may still draw them
+	if ( isPooled() )
+	{
+		m_geometryPool->free( m_geometry );
+	}
+}
+
+void PrimitiveGPU::createGeometry( const assets::Primitive &primitive )
 {
 	try
 	{
+		if ( m_geometryPool && createPooledGeometry( primitive ) )
+		{
+			return;
+		}
 		createVertexBuffer( primitive );
 		createIndexBuffer( primitive );
 	}
@@ -24,28 +42,151 @@ PrimitiveGPU::PrimitiveGPU( dx12::Device &device, const assets::Primitive &primi
 	}
 }
 
+void PrimitiveGPU::releaseGeometry()
+{
+	// Pool ranges wait for the frame fence; dedicated buffers are released after present like other deferred deletes
+	if ( isPooled() )
+	{
+		m_geometryPool->free( m_geometry );
+		m_geometry = geometry_pool::kInvalidGeometry;
+	}
+	m_vertexBuffer.Reset();
+	m_indexBuffer.Reset();
+	m_vertexBufferView = {};
+	m_indexBufferView = {};
+	m_shortIndices = false;
+}
+
+bool PrimitiveGPU::restoreGeometry( const assets::Primitive &primitive )
+{
+	if ( isValid() )
+	{
+		return true;
+	}
+
+	m_vertexCount = primitive.getVertexCount();
+	m_indexCount = primitive.getIndexCount();
+	m_vertexLayout = primitive.getVertexLayout();
+	m_positionQuantization = primitive.getPositionQuantization();
+	createGeometry( primitive );
+	return isValid();
+}
+
+std::uint64_t PrimitiveGPU::getGpuMemoryBytes() const noexcept
+{
+	if ( isPooled() )
+	{
+		const auto range = m_geometryPool->getRange( m_geometry );
+		return std::uint64_t{ range.vertexCount } * m_geometryPool->getVertexStride() + std::uint64_t{ range.indexCount } * sizeof( std::uint32_t );
+	}
+
+	// Committed buffers take whole allocations, so measure those instead of the view sizes
+	std::uint64_t bytes = 0;
+	for ( ID3D12Resource *buffer : { m_vertexBuffer.Get(), m_indexBuffer.Get() } )
+	{
+		if ( buffer )
+		{
+			const D3D12_RESOURCE_DESC desc = buffer->GetDesc();
+			bytes += m_device->GetResourceAllocationInfo( 0, 1, &desc ).SizeInBytes;
+		}
+	}
+	return bytes;
+}
+
+bool PrimitiveGPU::createPooledGeometry( const assets::Primitive &primitive )
+{
+	const auto vertexData = primitive.getVertexData();
+	if ( vertexData.empty() || primitive.getIndices().empty() )
+	{
+		// Let the dedicated path report the error
+		return false;
+	}
+	if ( !m_vertexLayout.isStandard() )
+	{
+		// The pool buffers have a single stride; other layouts get dedicated buffers
+		return false;
+	}
+	if ( m_geometryPool->getVertexStride() != sizeof( assets::Vertex ) )
+	{
+		console::error( "Geometry pool stride {} does not match the vertex size {}", m_geometryPool->getVertexStride(), sizeof( assets::Vertex ) );
+		return false;
+	}
+
+	std::vector<std::uint32_t> packedIndices;
+	const auto indexData = packLodIndices( primitive, packedIndices );
+	m_geometry = m_geometryPool->allocate( vertexData.data(), m_vertexCount, indexData );
+	if ( !isPooled() )
+	{
+		console::warning( "Geometry pool allocation failed, using dedicated buffers for primitive" );
+		return false;
+	}
+	return true;
+}
+
+D3D12_VERTEX_BUFFER_VIEW PrimitiveGPU::getVertexBufferView() const noexcept
+{
+	if ( !isPooled() )
+	{
+		return m_vertexBufferView;
+	}
+
+	// Resolved on every call because growth and defragmentation replace the pool buffers
+	const auto view = m_geometryPool->getVertexBufferView();
+	D3D12_VERTEX_BUFFER_VIEW d3dView = {};
+	d3dView.BufferLocation = view.gpuAddress;
+	d3dView.SizeInBytes = view.sizeInBytes;
+	d3dView.StrideInBytes = view.strideInBytes;
+	return d3dView;
+}
+
+D3D12_INDEX_BUFFER_VIEW PrimitiveGPU::getIndexBufferView() const noexcept
+{
+	if ( !isPooled() )
+	{
+		return m_indexBufferView;
+	}
+
+	const auto view = m_geometryPool->getIndexBufferView();
+	D3D12_INDEX_BUFFER_VIEW d3dView = {};
+	d3dView.BufferLocation = view.gpuAddress;
+	d3dView.SizeInBytes = view.sizeInBytes;
+	d3dView.Format = DXGI_FORMAT_R32_UINT;
+	return d3dView;
+}
+
+int32_t PrimitiveGPU::getBaseVertex() const noexcept
+{
+	return isPooled() ? m_geometryPool->getRange( m_geometry ).baseVertex : 0;
+}
+
+uint32_t PrimitiveGPU::getStartIndex() const noexcept
+{
+	return isPooled() ? m_geometryPool->getRange( m_geometry ).firstIndex : 0;
+}
+
 
 void PrimitiveGPU::createVertexBuffer( const assets::Primitive &primitive )
 {
-	const auto &vertices = primitive.getVertices();
-	if ( vertices.empty() )
+	// Uploaded as stored; the layout pipelines decode packed attributes in the vertex shader
+	const auto vertexData = primitive.getVertexData();
+	if ( vertexData.empty() )
 	{
 		console::error( "Cannot create vertex buffer for empty primitive" );
 		// Leave m_vertexBuffer as null to indicate failure
 		return;
 	}
 
-	const std::size_t bufferSize = vertices.size() * sizeof( assets::Vertex );
+	const std::size_t bufferSize = vertexData.size();
 
 	// Create upload heap buffer with vertex data
-	m_vertexBuffer = createUploadBuffer( bufferSize, vertices.data() );
+	m_vertexBuffer = createUploadBuffer( bufferSize, vertexData.data() );
 
 	if ( m_vertexBuffer )
 	{
 		// Setup vertex buffer view
 		m_vertexBufferView.BufferLocation = m_vertexBuffer->GetGPUVirtualAddress();
 		m_vertexBufferView.SizeInBytes = static_cast<UINT>( bufferSize );
-		m_vertexBufferView.StrideInBytes = sizeof( assets::Vertex );
+		m_vertexBufferView.StrideInBytes = m_vertexLayout.getStride();
 	}
 	else
 	{
@@ -63,17 +204,28 @@ void PrimitiveGPU::createIndexBuffer( const assets::Primitive &primitive )
 		return;
 	}
 
-	const std::size_t bufferSize = indices.size() * sizeof( std::uint32_t );
+	std::vector<std::uint32_t> packedIndices;
+	const auto indexData = packLodIndices( primitive, packedIndices );
+
+	// Halve the buffer when every vertex fits in 16 bits; the pool shares one 32-bit buffer, so only here
+	std::vector<std::uint16_t> shortIndices;
+	m_shortIndices = primitive.fitsShortIndices();
+	if ( m_shortIndices )
+	{
+		shortIndices.assign( indexData.begin(), indexData.end() );
+	}
+
+	const std::size_t bufferSize = m_shortIndices ? shortIndices.size() * sizeof( std::uint16_t ) : indexData.size_bytes();
 
 	// Create upload heap buffer with index data
-	m_indexBuffer = createUploadBuffer( bufferSize, indices.data() );
+	m_indexBuffer = createUploadBuffer( bufferSize, m_shortIndices ? static_cast<const void *>( shortIndices.data() ) : indexData.data() );
 
 	if ( m_indexBuffer )
 	{
 		// Setup index buffer view
 		m_indexBufferView.BufferLocation = m_indexBuffer->GetGPUVirtualAddress();
 		m_indexBufferView.SizeInBytes = static_cast<UINT>( bufferSize );
-		m_indexBufferView.Format = DXGI_FORMAT_R32_UINT; // 32-bit indices
+		m_indexBufferView.Format = m_shortIndices ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
 	}
 	else
 	{
@@ -81,6 +233,36 @@ void PrimitiveGPU::createIndexBuffer( const assets::Primitive &primitive )
 	}
 }
 
+std::span<const std::uint32_t> PrimitiveGPU::packLodIndices( const assets::Primitive &primitive, std::vector<std::uint32_t> &storage )
+{
+	// Full-detail indices followed by each simplified level
+	const auto &indices = primitive.getIndices();
+	const auto &lods = primitive.getLods();
+	m_lodRanges.assign( 1, LodRange{ 0, static_cast<uint32_t>( indices.size() ) } );
+	m_lodErrors.assign( 1, 0.0f );
+	std::size_t totalIndices = indices.size();
+	for ( const auto &lod : lods )
+	{
+		m_lodRanges.push_back( LodRange{ static_cast<uint32_t>( totalIndices ), static_cast<uint32_t>( lod.indices.size() ) } );
+		m_lodErrors.push_back( lod.error );
+		totalIndices += lod.indices.size();
+	}
+
+	if ( lods.empty() )
+	{
+		return indices;
+	}
+
+	storage.clear();
+	storage.reserve( totalIndices );
+	storage.insert( storage.end(), indices.begin(), indices.end() );
+	for ( const auto &lod : lods )
+	{
+		storage.insert( storage.end(), lod.indices.begin(), lod.indices.end() );
+	}
+	return storage;
+}
+
 Microsoft::WRL::ComPtr<ID3D12Resource> PrimitiveGPU::createUploadBuffer( std::size_t bufferSize, const void *data )
 {
 	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
@@ -148,13 +330,7 @@ void PrimitiveGPU::bindForRendering( ID3D12GraphicsCommandList *commandList ) co
 		return;
 	}
 
-	// Bind geometry buffers
-	commandList->IASetVertexBuffers( 0, 1, &m_vertexBufferView );
-
-	if ( hasIndexBuffer() )
-	{
-		commandList->IASetIndexBuffer( &m_indexBufferView );
-	}
+	bindGeometry( commandList );
 
 	// Bind material resources if material is available
 	if ( m_material && m_material->isValid() )
@@ -163,8 +339,30 @@ void PrimitiveGPU::bindForRendering( ID3D12GraphicsCommandList *commandList ) co
 	}
 }
 
-MeshGPU::MeshGPU( dx12::Device &device, const assets::Mesh &mesh )
-	: m_device( device )
+void PrimitiveGPU::bindGeometry( ID3D12GraphicsCommandList *commandList ) const
+{
+	if ( !commandList || !isValid() )
+	{
+		return;
+	}
+
+	const auto vertexBufferView = getVertexBufferView();
+	commandList->IASetVertexBuffers( 0, 1, &vertexBufferView );
+
+	if ( hasIndexBuffer() )
+	{
+		const auto indexBufferView = getIndexBufferView();
+		commandList->IASetIndexBuffer( &indexBufferView );
+	}
+}
+
+MeshGPU::MeshGPU( dx12::Device &device, const assets::Mesh &mesh, std::shared_ptr<geometry_pool::GeometryPool> geometryPool )
+	: m_occluderMesh( engine::culling::buildOccluderMesh( mesh ) ), m_device( device ), m_geometryPool( std::move( geometryPool ) )
+{
+	createPrimitives( mesh );
+}
+
+void MeshGPU::createPrimitives( const assets::Mesh &mesh )
 {
 	// Create GPU buffers for each primitive in the mesh
 	const auto &primitives = mesh.getPrimitives();
@@ -173,7 +371,7 @@ MeshGPU::MeshGPU( dx12::Device &device, const assets::Mesh &mesh )
 	for ( const auto &srcPrimitive : primitives )
 	{
 		// For now, create without material - this will be enhanced when GPU resource manager is integrated
-		auto primitive = std::make_unique<PrimitiveGPU>( device, srcPrimitive );
+		auto primitive = std::make_unique<PrimitiveGPU>( m_device, srcPrimitive, m_geometryPool );
 		if ( primitive->isValid() )
 		{
 			m_primitives.push_back( std::move( primitive ) );
@@ -283,4 +481,56 @@ bool MeshGPU::isValid() const noexcept
 		std::all_of( m_primitives.begin(), m_primitives.end(), []( const auto &buffer ) { return buffer && buffer->isValid(); } );
 }
 
+void MeshGPU::evictGeometry()
+{
+	for ( auto &primitive : m_primitives )
+	{
+		primitive->releaseGeometry();
+	}
+	m_evicted = true;
+}
+
+bool MeshGPU::restoreGeometry( const assets::Mesh &mesh )
+{
+	const auto &primitives = mesh.getPrimitives();
+	if ( primitives.size() != m_primitives.size() )
+	{
+		console::error( "Cannot restore mesh geometry - mesh has {} primitives but MeshGPU has {} primitive buffers",
+			primitives.size(),
+			m_primitives.size() );
+		return false;
+	}
+
+	for ( std::size_t i = 0; i < primitives.size(); ++i )
+	{
+		if ( !m_primitives[i]->restoreGeometry( primitives[i] ) )
+		{
+			console::error( "Failed to restore GPU buffers for primitive {}", i );
+			return false;
+		}
+	}
+	m_evicted = false;
+	return true;
+}
+
+std::vector<std::unique_ptr<PrimitiveGPU>> MeshGPU::reload( const assets::Mesh &mesh )
+{
+	auto previous = std::move( m_primitives );
+	m_primitives.clear();
+	createPrimitives( mesh );
+	m_occluderMesh = engine::culling::buildOccluderMesh( mesh );
+	m_evicted = false;
+	return previous;
+}
+
+std::uint64_t MeshGPU::getGpuMemoryBytes() const noexcept
+{
+	std::uint64_t bytes = 0;
+	for ( const auto &primitive : m_primitives )
+	{
+		bytes += primitive->getGpuMemoryBytes();
+	}
+	return bytes;
+}
+
 } // namespace engine::gpu
\ No newline at end of file
@@ -2,8 +2,14 @@
 
 #include <d3d12.h>
 #include <memory>
+#include <span>
 #include <vector>
 #include <wrl.h>
+#include "engine/assets/vertex_layout.h"
+#include "engine/assets/vertex_packing.h"
+#include "engine/culling/occlusion_culling.h"
+#include "engine/geometry_pool/geometry_pool.h"
+#include "engine/residency/residency_manager.h"
 
 namespace dx12
 {
@@ -19,6 +25,7 @@ class Scene;
 namespace engine::gpu
 {
 class MaterialGPU;
+class MeshGPU;
 }
 
 namespace engine::gpu
@@ -33,26 +40,70 @@ public:
 	virtual std::shared_ptr<MaterialGPU> getDefaultMaterialGPU() = 0;
 };
 
-// Individual primitive GPU buffer management
+// Interface for keeping the meshes of the visible set in GPU memory
+class ResidencyProvider
+{
+public:
+	virtual ~ResidencyProvider() = default;
+	// Called once per frame for each visible mesh; re-uploads evicted geometry. False if it cannot be drawn.
+	virtual bool requestResident( const MeshGPU &mesh ) = 0;
+};
+
+// Slice of a primitive's index buffer holding one level of detail
+struct LodRange
+{
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+};
+
+// Individual primitive GPU buffer management. With a geometry pool the primitive suballocates its
+// vertices and indices from the pool's shared buffers and draws with getBaseVertex()/getStartIndex();
+// without one (or if the pool cannot allocate) it owns dedicated buffers and both offsets are 0.
+// Vertices are uploaded in the source primitive's layout; only standard-layout primitives are pooled.
 class PrimitiveGPU
 {
 public:
-	PrimitiveGPU( dx12::Device &device, const assets::Primitive &primitive );
-	~PrimitiveGPU() = default;
+	PrimitiveGPU( dx12::Device &device, const assets::Primitive &primitive, std::shared_ptr<geometry_pool::GeometryPool> geometryPool = nullptr );
+	~PrimitiveGPU();
 
 	// No copy/move for now to keep resource management simple
 	PrimitiveGPU( const PrimitiveGPU & ) = delete;
 	PrimitiveGPU &operator=( const PrimitiveGPU & ) = delete;
 
-	// Buffer view accessors for rendering
-	D3D12_VERTEX_BUFFER_VIEW getVertexBufferView() const noexcept { return m_vertexBufferView; }
-	D3D12_INDEX_BUFFER_VIEW getIndexBufferView() const noexcept { return m_indexBufferView; }
+	// Residency: release the vertex/index data and recreate it later from the same source primitive.
+	// Counts, LOD ranges and the material survive eviction; isValid() is false while evicted.
+	void releaseGeometry();
+	bool restoreGeometry( const assets::Primitive &primitive );
+
+	// Bytes the geometry occupies: the pool ranges, or the dedicated buffers' allocations
+	std::uint64_t getGpuMemoryBytes() const noexcept;
+
+	// Buffer view accessors for rendering; pooled primitives return views over the whole pool
+	D3D12_VERTEX_BUFFER_VIEW getVertexBufferView() const noexcept;
+	D3D12_INDEX_BUFFER_VIEW getIndexBufferView() const noexcept;
+
+	// Draw offsets into the bound buffers (add getLodRange().firstIndex for a level of detail)
+	int32_t getBaseVertex() const noexcept;
+	uint32_t getStartIndex() const noexcept;
+	bool isPooled() const noexcept { return m_geometry != geometry_pool::kInvalidGeometry; }
+
+	// Dedicated index buffers use 16-bit indices when the vertex count allows; pooled ones are always 32-bit
+	bool usesShortIndices() const noexcept { return m_shortIndices; }
+
+	// Layout of the uploaded vertices and, for packed layouts, how to dequantize positions
+	const assets::VertexLayout &getVertexLayout() const noexcept { return m_vertexLayout; }
+	const assets::PositionQuantization &getPositionQuantization() const noexcept { return m_positionQuantization; }
 
 	// Resource count accessors
 	uint32_t getVertexCount() const noexcept { return m_vertexCount; }
 	uint32_t getIndexCount() const noexcept { return m_indexCount; }
 
-	// Direct resource access for advanced usage
+	// Level of detail: all levels live in the index buffer, level 0 first; getIndexCount() is level 0's count
+	uint32_t getLodCount() const noexcept { return static_cast<uint32_t>( m_lodRanges.size() ); }
+	const LodRange &getLodRange( uint32_t level ) const noexcept { return m_lodRanges[level < m_lodRanges.size() ? level : m_lodRanges.size() - 1]; }
+	const std::vector<float> &getLodErrors() const noexcept { return m_lodErrors; }
+
+	// Direct resource access for advanced usage (null for pooled primitives)
 	ID3D12Resource *getVertexResource() const noexcept { return m_vertexBuffer.Get(); }
 	ID3D12Resource *getIndexResource() const noexcept { return m_indexBuffer.Get(); }
 
@@ -64,9 +115,12 @@ public:
 	// Complete resource binding for rendering (geometry + material)
 	void bindForRendering( ID3D12GraphicsCommandList *commandList ) const;
 
+	// Bind only vertex/index buffers (material bound separately, e.g. by a sorted render queue)
+	void bindGeometry( ID3D12GraphicsCommandList *commandList ) const;
+
 	// Check if buffers were created successfully
-	bool isValid() const noexcept { return m_vertexBuffer && m_indexBuffer; }
-	bool hasIndexBuffer() const noexcept { return static_cast<bool>( m_indexBuffer ); }
+	bool isValid() const noexcept { return isPooled() || ( m_vertexBuffer && m_indexBuffer ); }
+	bool hasIndexBuffer() const noexcept { return isPooled() || static_cast<bool>( m_indexBuffer ); }
 
 private:
 	Microsoft::WRL::ComPtr<ID3D12Resource> m_vertexBuffer;
@@ -77,13 +131,26 @@ private:
 
 	uint32_t m_vertexCount = 0;
 	uint32_t m_indexCount = 0;
+	bool m_shortIndices = false;
+	assets::VertexLayout m_vertexLayout;
+	assets::PositionQuantization m_positionQuantization;
+	std::vector<LodRange> m_lodRanges{ LodRange{} };
+	std::vector<float> m_lodErrors{ 0.0f };
 
 	dx12::Device &m_device;
 	std::shared_ptr<MaterialGPU> m_material;
 
+	std::shared_ptr<geometry_pool::GeometryPool> m_geometryPool;
+	geometry_pool::GeometryHandle m_geometry = geometry_pool::kInvalidGeometry;
+
 	// Helper methods for buffer creation
+	void createGeometry( const assets::Primitive &primitive );
 	void createVertexBuffer( const assets::Primitive &primitive );
 	void createIndexBuffer( const assets::Primitive &primitive );
+	bool createPooledGeometry( const assets::Primitive &primitive );
+
+	// Level 0 indices followed by each simplified level; fills the LOD ranges. Uses storage only when there are LODs.
+	std::span<const std::uint32_t> packLodIndices( const assets::Primitive &primitive, std::vector<std::uint32_t> &storage );
 
 	// Helper method to create upload heap buffers
 	Microsoft::WRL::ComPtr<ID3D12Resource> createUploadBuffer( std::size_t bufferSize, const void *data );
@@ -93,7 +160,7 @@ private:
 class MeshGPU
 {
 public:
-	MeshGPU( dx12::Device &device, const assets::Mesh &mesh );
+	MeshGPU( dx12::Device &device, const assets::Mesh &mesh, std::shared_ptr<geometry_pool::GeometryPool> geometryPool = nullptr );
 
 	~MeshGPU() = default;
 
@@ -110,13 +177,39 @@ public:
 	// Check if all primitive buffers are valid
 	bool isValid() const noexcept;
 
+	// Residency: drop all primitive geometry, and rebuild it from the mesh the MeshGPU was created from
+	void evictGeometry();
+	bool restoreGeometry( const assets::Mesh &mesh );
+	bool isEvicted() const noexcept { return m_evicted; }
+
+	// Hot reload: rebuild every primitive and the occluder from mesh after it changed in place, in any
+	// primitive count or layout. The new primitives have no material until configureMaterials() runs.
+	// Returns the old primitives, which must outlive the frames in flight that may still draw them.
+	std::vector<std::unique_ptr<PrimitiveGPU>> reload( const assets::Mesh &mesh );
+
+	// Exact GPU bytes of the resident geometry
+	std::uint64_t getGpuMemoryBytes() const noexcept;
+
+	// Handle assigned by the GPUResourceManager that tracks this mesh; kInvalidResource when unmanaged
+	residency::ResourceId getResidencyId() const noexcept { return m_residencyId; }
+	void setResidencyId( residency::ResourceId id ) noexcept { m_residencyId = id; }
+
+	// Low-detail CPU copy of the triangles for software occlusion culling
+	const engine::culling::OccluderMesh &getOccluderMesh() const noexcept { return m_occluderMesh; }
+
 	// Configure materials for primitives using GPUResourceManager and Scene
 	// Material configuration using dependency injection
 	void configureMaterials( MaterialProvider &materialProvider, const assets::Scene &scene, const assets::Mesh &mesh );
 
 private:
 	std::vector<std::unique_ptr<PrimitiveGPU>> m_primitives;
+	engine::culling::OccluderMesh m_occluderMesh;
 	dx12::Device &m_device;
+	std::shared_ptr<geometry_pool::GeometryPool> m_geometryPool;
+	residency::ResourceId m_residencyId = residency::kInvalidResource;
+	bool m_evicted = false;
+
+	void createPrimitives( const assets::Mesh &mesh );
 };
 
 } // namespace engine::gpu
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "engine/assets/scene_cache.h"
 #include "engine/gltf_loader/gltf_loader.h"
 
 namespace engine::integration
@@ -34,6 +35,20 @@ void initializeAssetGLTFIntegration()
 			}
 			return nullptr;
 		} );
+
+	// Hot reloads keep the meshes whose source data did not change
+	assets::AssetManager::setSceneReloaderCallback(
+		[]( const std::string &path, const assets::Scene &previous ) -> std::shared_ptr<assets::Scene> {
+			static auto loader = std::make_shared<gltf_loader::GLTFLoader>();
+			return loader->reloadScene( path, previous );
+		} );
+}
+
+// Cooked scene cache in directory for scenes the integration's GLTFLoader imports; pass it to
+// AssetManager::setSceneCache()
+inline std::shared_ptr<assets::SceneCache> createGLTFSceneCache( const std::string &directory )
+{
+	return std::make_shared<assets::SceneCache>( directory, gltf_loader::GLTFLoader().getImportSettingsHash() );
 }
 
 } // namespace engine::integration
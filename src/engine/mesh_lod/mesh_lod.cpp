@@ -0,0 +1,461 @@
+#include "engine/mesh_lod/mesh_lod.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#include "engine/assets/assets.h"
+
+namespace engine::mesh_lod
+{
+
+namespace
+{
+struct Position
+{
+	double x, y, z;
+};
+
+Position loadPosition( const float *positions, std::size_t stride, std::uint32_t index ) noexcept
+{
+	float xyz[3];
+	std::memcpy( xyz, reinterpret_cast<const std::byte *>( positions ) + index * stride, sizeof( xyz ) );
+	return Position{ xyz[0], xyz[1], xyz[2] };
+}
+
+Position cross( const Position &a, const Position &b ) noexcept
+{
+	return Position{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+Position subtract( const Position &a, const Position &b ) noexcept
+{
+	return Position{ a.x - b.x, a.y - b.y, a.z - b.z };
+}
+
+double dot( const Position &a, const Position &b ) noexcept
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Symmetric 4x4 error quadric (Garland-Heckbert) summing squared distances to planes
+struct Quadric
+{
+	double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+
+	void addPlane( double a, double b, double c, double d ) noexcept
+	{
+		a2 += a * a;
+		ab += a * b;
+		ac += a * c;
+		ad += a * d;
+		b2 += b * b;
+		bc += b * c;
+		bd += b * d;
+		c2 += c * c;
+		cd += c * d;
+		d2 += d * d;
+	}
+
+	void add( const Quadric &other ) noexcept
+	{
+		a2 += other.a2;
+		ab += other.ab;
+		ac += other.ac;
+		ad += other.ad;
+		b2 += other.b2;
+		bc += other.bc;
+		bd += other.bd;
+		c2 += other.c2;
+		cd += other.cd;
+		d2 += other.d2;
+	}
+
+	double evaluate( const Position &p ) const noexcept
+	{
+		const double error = a2 * p.x * p.x + b2 * p.y * p.y + c2 * p.z * p.z +
+			2.0 * ( ab * p.x * p.y + ac * p.x * p.z + bc * p.y * p.z ) +
+			2.0 * ( ad * p.x + bd * p.y + cd * p.z ) + d2;
+		return error > 0.0 ? error : 0.0;
+	}
+};
+
+struct PositionKey
+{
+	std::uint32_t x, y, z;
+	bool operator==( const PositionKey & ) const = default;
+};
+
+struct PositionKeyHash
+{
+	std::size_t operator()( const PositionKey &key ) const noexcept
+	{
+		return ( key.x * 73856093u ) ^ ( key.y * 19349663u ) ^ ( key.z * 83492791u );
+	}
+};
+
+std::uint32_t floatKey( double value ) noexcept
+{
+	// Treat -0 and +0 as the same position
+	const float f = static_cast<float>( value ) + 0.0f;
+	return std::bit_cast<std::uint32_t>( f );
+}
+
+std::uint64_t edgeKey( std::uint32_t a, std::uint32_t b ) noexcept
+{
+	return a < b ? ( std::uint64_t{ a } << 32 ) | b : ( std::uint64_t{ b } << 32 ) | a;
+}
+
+struct Candidate
+{
+	double cost;
+	std::uint32_t from;
+	std::uint32_t to;
+};
+} // namespace
+
+SimplifyResult simplify( std::span<const std::uint32_t> indices,
+	const float *positions,
+	std::size_t vertexCount,
+	std::size_t positionStride,
+	std::size_t targetIndexCount,
+	float maxError )
+{
+	SimplifyResult result;
+	result.indices.assign( indices.begin(), indices.end() );
+	if ( indices.size() % 3 != 0 || indices.size() <= targetIndexCount || !positions || vertexCount == 0 )
+	{
+		return result;
+	}
+	for ( const std::uint32_t index : indices )
+	{
+		if ( index >= vertexCount )
+		{
+			return result;
+		}
+	}
+
+	std::vector<Position> points( vertexCount );
+	for ( std::uint32_t i = 0; i < vertexCount; ++i )
+	{
+		points[i] = loadPosition( positions, positionStride, i );
+	}
+
+	// Vertices sharing a position map to the first such vertex
+	std::vector<std::uint32_t> canonical( vertexCount );
+	{
+		std::unordered_map<PositionKey, std::uint32_t, PositionKeyHash> firstAtPosition;
+		firstAtPosition.reserve( vertexCount );
+		for ( std::uint32_t i = 0; i < vertexCount; ++i )
+		{
+			const PositionKey key{ floatKey( points[i].x ), floatKey( points[i].y ), floatKey( points[i].z ) };
+			canonical[i] = firstAtPosition.try_emplace( key, i ).first->second;
+		}
+	}
+
+	// Lock attribute seams: several referenced vertices at one position
+	std::vector<std::uint8_t> lockedPosition( vertexCount, 0 );
+	{
+		constexpr std::uint32_t kUnused = ~0u;
+		std::vector<std::uint32_t> firstUser( vertexCount, kUnused );
+		for ( const std::uint32_t index : indices )
+		{
+			auto &user = firstUser[canonical[index]];
+			if ( user == kUnused )
+			{
+				user = index;
+			}
+			else if ( user != index )
+			{
+				lockedPosition[canonical[index]] = 1;
+			}
+		}
+	}
+
+	// Lock open and non-manifold borders: position edges not shared by exactly two triangles
+	{
+		std::unordered_map<std::uint64_t, std::uint32_t> edgeUse;
+		edgeUse.reserve( indices.size() );
+		for ( std::size_t t = 0; t < indices.size(); t += 3 )
+		{
+			for ( int e = 0; e < 3; ++e )
+			{
+				const std::uint32_t a = canonical[indices[t + e]];
+				const std::uint32_t b = canonical[indices[t + ( e + 1 ) % 3]];
+				if ( a != b )
+				{
+					++edgeUse[edgeKey( a, b )];
+				}
+			}
+		}
+		for ( const auto &[key, count] : edgeUse )
+		{
+			if ( count != 2 )
+			{
+				lockedPosition[static_cast<std::uint32_t>( key >> 32 )] = 1;
+				lockedPosition[static_cast<std::uint32_t>( key & 0xFFFFFFFFu )] = 1;
+			}
+		}
+	}
+
+	// Plane quadrics accumulated per position
+	std::vector<Quadric> quadrics( vertexCount );
+	for ( std::size_t t = 0; t < indices.size(); t += 3 )
+	{
+		const Position &p0 = points[indices[t]];
+		const Position normal = cross( subtract( points[indices[t + 1]], p0 ), subtract( points[indices[t + 2]], p0 ) );
+		const double length = std::sqrt( dot( normal, normal ) );
+		if ( length <= 0.0 )
+		{
+			continue;
+		}
+		const Position n{ normal.x / length, normal.y / length, normal.z / length };
+		const double d = -dot( n, p0 );
+		for ( int corner = 0; corner < 3; ++corner )
+		{
+			quadrics[canonical[indices[t + corner]]].addPlane( n.x, n.y, n.z, d );
+		}
+	}
+
+	const double maxCost = static_cast<double>( maxError ) * static_cast<double>( maxError );
+	const std::size_t targetTriangles = targetIndexCount / 3;
+	double worstCost = 0.0;
+
+	std::vector<std::uint32_t> collapseTarget( vertexCount );
+	std::vector<std::uint32_t> triangleOffsets( vertexCount + 1 );
+	std::vector<std::uint32_t> vertexTriangles;
+	std::vector<Candidate> candidates;
+	std::vector<std::uint8_t> touched( vertexCount );
+	std::vector<std::uint32_t> &current = result.indices;
+
+	while ( current.size() / 3 > targetTriangles )
+	{
+		const std::size_t triangleCount = current.size() / 3;
+
+		// Vertex to triangle adjacency
+		std::fill( triangleOffsets.begin(), triangleOffsets.end(), 0u );
+		for ( const std::uint32_t index : current )
+		{
+			++triangleOffsets[index + 1];
+		}
+		std::partial_sum( triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin() );
+		vertexTriangles.resize( current.size() );
+		{
+			std::vector<std::uint32_t> cursor( triangleOffsets.begin(), triangleOffsets.end() - 1 );
+			for ( std::size_t i = 0; i < current.size(); ++i )
+			{
+				vertexTriangles[cursor[current[i]]++] = static_cast<std::uint32_t>( i / 3 );
+			}
+		}
+
+		// Every directed edge whose source may move, ordered by cost with index tie-breaks for determinism
+		candidates.clear();
+		for ( std::size_t t = 0; t < current.size(); t += 3 )
+		{
+			for ( int e = 0; e < 3; ++e )
+			{
+				const std::uint32_t a = current[t + e];
+				const std::uint32_t b = current[t + ( e + 1 ) % 3];
+				if ( canonical[a] == canonical[b] )
+				{
+					continue;
+				}
+				if ( !lockedPosition[canonical[a]] )
+				{
+					candidates.push_back( { quadrics[canonical[a]].evaluate( points[b] ), a, b } );
+				}
+				if ( !lockedPosition[canonical[b]] )
+				{
+					candidates.push_back( { quadrics[canonical[b]].evaluate( points[a] ), b, a } );
+				}
+			}
+		}
+		std::sort( candidates.begin(), candidates.end(), []( const Candidate &lhs, const Candidate &rhs ) {
+			if ( lhs.cost != rhs.cost )
+				return lhs.cost < rhs.cost;
+			if ( lhs.from != rhs.from )
+				return lhs.from < rhs.from;
+			return lhs.to < rhs.to;
+		} );
+
+		std::iota( collapseTarget.begin(), collapseTarget.end(), 0u );
+		std::fill( touched.begin(), touched.end(), std::uint8_t{ 0 } );
+
+		std::size_t remainingTriangles = triangleCount;
+		std::size_t collapses = 0;
+		for ( const auto &candidate : candidates )
+		{
+			if ( candidate.cost > maxCost || remainingTriangles <= targetTriangles )
+			{
+				break;
+			}
+			const std::uint32_t from = candidate.from;
+			const std::uint32_t to = candidate.to;
+			if ( touched[from] || touched[to] )
+			{
+				continue;
+			}
+
+			// Reject collapses that flip or degenerate a surviving triangle
+			bool flips = false;
+			std::size_t removed = 0;
+			for ( std::uint32_t i = triangleOffsets[from]; i < triangleOffsets[from + 1] && !flips; ++i )
+			{
+				const std::uint32_t *triangle = &current[vertexTriangles[i] * 3];
+				if ( canonical[triangle[0]] == canonical[to] || canonical[triangle[1]] == canonical[to] || canonical[triangle[2]] == canonical[to] )
+				{
+					++removed;
+					continue;
+				}
+				Position before[3];
+				Position after[3];
+				for ( int corner = 0; corner < 3; ++corner )
+				{
+					before[corner] = points[triangle[corner]];
+					after[corner] = triangle[corner] == from ? points[to] : before[corner];
+				}
+				const Position normalBefore = cross( subtract( before[1], before[0] ), subtract( before[2], before[0] ) );
+				const Position normalAfter = cross( subtract( after[1], after[0] ), subtract( after[2], after[0] ) );
+				flips = dot( normalBefore, normalAfter ) <= 0.0;
+			}
+			if ( flips )
+			{
+				continue;
+			}
+
+			collapseTarget[from] = to;
+			quadrics[canonical[to]].add( quadrics[canonical[from]] );
+			worstCost = std::max( worstCost, candidate.cost );
+
+			// Freeze the neighbourhood so flip checks in this pass see final positions
+			for ( std::uint32_t i = triangleOffsets[from]; i < triangleOffsets[from + 1]; ++i )
+			{
+				const std::uint32_t *triangle = &current[vertexTriangles[i] * 3];
+				touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+			}
+			touched[to] = 1;
+
+			remainingTriangles -= std::min( removed, remainingTriangles );
+			++collapses;
+		}
+
+		if ( collapses == 0 )
+		{
+			break;
+		}
+
+		// Apply collapses and drop triangles that became degenerate
+		std::size_t write = 0;
+		for ( std::size_t t = 0; t < current.size(); t += 3 )
+		{
+			const std::uint32_t i0 = collapseTarget[current[t]];
+			const std::uint32_t i1 = collapseTarget[current[t + 1]];
+			const std::uint32_t i2 = collapseTarget[current[t + 2]];
+			if ( canonical[i0] == canonical[i1] || canonical[i1] == canonical[i2] || canonical[i0] == canonical[i2] )
+			{
+				continue;
+			}
+			current[write++] = i0;
+			current[write++] = i1;
+			current[write++] = i2;
+		}
+		current.resize( write );
+	}
+
+	result.error = static_cast<float>( std::sqrt( worstCost ) );
+	return result;
+}
+
+LodReport generateLods( assets::Primitive &primitive, const LodSettings &settings )
+{
+	primitive.clearLods();
+
+	const auto &indices = primitive.getIndices();
+	const auto decoded = primitive.hasCompactVertices() ? primitive.decodeVertices() : std::vector<assets::Vertex>{};
+	const auto &vertices = primitive.hasCompactVertices() ? decoded : primitive.getVertices();
+
+	LodReport report;
+	report.triangleCounts.push_back( static_cast<std::uint32_t>( indices.size() / 3 ) );
+	report.errors.push_back( 0.0f );
+
+	if ( vertices.empty() || indices.size() / 3 < settings.minTriangles )
+	{
+		return report;
+	}
+
+	const auto &bounds = primitive.getBounds();
+	const auto extent = bounds.max - bounds.min;
+	const float diagonal = std::sqrt( extent.x * extent.x + extent.y * extent.y + extent.z * extent.z );
+	const float maxError = settings.maxRelativeError * diagonal;
+
+	std::size_t previousIndexCount = indices.size();
+	float previousError = 0.0f;
+	for ( std::uint32_t level = 1; level <= settings.maxLevels; ++level )
+	{
+		const std::size_t previousTriangles = previousIndexCount / 3;
+		if ( previousTriangles <= settings.minTriangles )
+		{
+			break;
+		}
+		const auto targetTriangles = std::max<std::size_t>( static_cast<std::size_t>( previousTriangles * settings.reductionPerLevel ), settings.minTriangles );
+
+		auto simplified = simplify( indices, &vertices[0].position.x, vertices.size(), sizeof( assets::Vertex ), targetTriangles * 3, maxError );
+
+		// Locked seams/borders or the error limit stalled the reduction
+		if ( simplified.indices.empty() || static_cast<float>( simplified.indices.size() ) > static_cast<float>( previousIndexCount ) * settings.minReduction )
+		{
+			break;
+		}
+
+		const float error = std::max( simplified.error, previousError );
+		previousIndexCount = simplified.indices.size();
+		previousError = error;
+
+		report.triangleCounts.push_back( static_cast<std::uint32_t>( simplified.indices.size() / 3 ) );
+		report.errors.push_back( error );
+		primitive.addLod( assets::PrimitiveLod{ std::move( simplified.indices ), error } );
+	}
+
+	return report;
+}
+
+float projectedError( float objectError, float worldScale, float viewDepth, float projectionScale ) noexcept
+{
+	if ( !( viewDepth > 0.0f ) )
+	{
+		return std::numeric_limits<float>::max();
+	}
+	// Clip space spans 2 units over the screen height
+	return objectError * worldScale * projectionScale * 0.5f / viewDepth;
+}
+
+std::uint32_t selectLod( std::span<const float> levelErrors,
+	float worldScale,
+	float viewDepth,
+	float projectionScale,
+	float screenErrorThreshold,
+	float lodBias ) noexcept
+{
+	if ( levelErrors.size() <= 1 || !( viewDepth > 0.0f ) )
+	{
+		return 0;
+	}
+
+	const float threshold = screenErrorThreshold * std::exp2( lodBias );
+	std::uint32_t selected = 0;
+	for ( std::uint32_t level = 1; level < levelErrors.size(); ++level )
+	{
+		if ( projectedError( levelErrors[level], worldScale, viewDepth, projectionScale ) > threshold )
+		{
+			break;
+		}
+		selected = level;
+	}
+	return selected;
+}
+
+} // namespace engine::mesh_lod
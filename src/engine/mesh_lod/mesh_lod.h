@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace assets
+{
+class Primitive;
+}
+
+// Mesh level of detail: quadric-error simplification of index buffers (LOD levels share the
+// primitive's vertices) and screen-space error based level selection. Pure CPU and deterministic.
+namespace engine::mesh_lod
+{
+
+struct SimplifyResult
+{
+	std::vector<std::uint32_t> indices;
+	float error = 0.0f; // Largest collapse error, in the units of the input positions
+};
+
+// Simplify a triangle list towards targetIndexCount using half-edge collapses ordered by quadric error.
+// Vertices are never moved or created, so attributes stay exact. Vertices on attribute seams (several
+// vertices at one position) and on open or non-manifold borders are locked. Stops early when the next
+// collapse would exceed maxError. positions points at vertexCount xyz floats spaced positionStride bytes.
+SimplifyResult simplify( std::span<const std::uint32_t> indices,
+	const float *positions,
+	std::size_t vertexCount,
+	std::size_t positionStride,
+	std::size_t targetIndexCount,
+	float maxError );
+
+struct LodSettings
+{
+	std::uint32_t maxLevels = 4;		// Levels generated in addition to the full-detail mesh
+	float reductionPerLevel = 0.5f;		// Target triangle ratio relative to the previous level
+	std::uint32_t minTriangles = 64;	// Primitives or levels below this are not simplified further
+	float maxRelativeError = 0.05f;		// Error limit as a fraction of the primitive's bounds diagonal
+	float minReduction = 0.85f;			// A level must keep at most this ratio of the previous triangles
+};
+
+// Triangle count and error per level; index 0 is the full-detail mesh
+struct LodReport
+{
+	std::vector<std::uint32_t> triangleCounts;
+	std::vector<float> errors;
+
+	std::uint32_t levelCount() const noexcept { return static_cast<std::uint32_t>( triangleCounts.size() ); }
+};
+
+// Replace the primitive's LOD chain with newly generated levels. Each level is simplified from the
+// full-detail indices so its error is relative to the original surface; errors are non-decreasing.
+LodReport generateLods( assets::Primitive &primitive, const LodSettings &settings = {} );
+
+// Fraction of the screen height covered by an object-space error at the given clip-space w.
+// projectionScale is projection.row1.y (cot(fovY / 2) for perspective, 2 / height for orthographic).
+float projectedError( float objectError, float worldScale, float viewDepth, float projectionScale ) noexcept;
+
+// Coarsest level whose projected error stays within screenErrorThreshold (fraction of screen height).
+// levelErrors[0] is the full-detail mesh. lodBias scales the threshold by 2^lodBias: positive values
+// switch to coarser levels sooner, negative values keep detail longer.
+std::uint32_t selectLod( std::span<const float> levelErrors,
+	float worldScale,
+	float viewDepth,
+	float projectionScale,
+	float screenErrorThreshold,
+	float lodBias ) noexcept;
+
+} // namespace engine::mesh_lod
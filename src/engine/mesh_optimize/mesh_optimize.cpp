@@ -0,0 +1,516 @@
+#include "engine/mesh_optimize/mesh_optimize.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "engine/assets/assets.h"
+
+namespace engine::mesh_optimize
+{
+
+namespace
+{
+// FIFO post-transform cache. A vertex is resident while fewer than cacheSize misses happened since it was
+// inserted, so eviction needs no queue; advancing the clock by cacheSize + 1 empties the cache.
+class FifoCache
+{
+public:
+	FifoCache( std::size_t vertexCount, std::uint32_t cacheSize )
+		: m_timestamps( vertexCount, 0 ), m_cacheSize( cacheSize ), m_time( cacheSize + 1 )
+	{
+	}
+
+	bool isResident( std::uint32_t vertex ) const noexcept { return m_time - m_timestamps[vertex] <= m_cacheSize; }
+
+	// Age of a resident vertex in misses; larger than cacheSize once evicted
+	std::uint32_t age( std::uint32_t vertex ) const noexcept { return m_time - m_timestamps[vertex]; }
+
+	// True on a miss
+	bool touch( std::uint32_t vertex ) noexcept
+	{
+		if ( isResident( vertex ) )
+		{
+			return false;
+		}
+		m_timestamps[vertex] = m_time++;
+		return true;
+	}
+
+	std::uint32_t touchTriangle( const std::uint32_t *triangle ) noexcept
+	{
+		return static_cast<std::uint32_t>( touch( triangle[0] ) ) + touch( triangle[1] ) + touch( triangle[2] );
+	}
+
+	void flush() noexcept { m_time += m_cacheSize + 1; }
+
+private:
+	std::vector<std::uint32_t> m_timestamps;
+	std::uint32_t m_cacheSize;
+	std::uint32_t m_time;
+};
+
+struct Position
+{
+	double x, y, z;
+};
+
+Position loadPosition( const float *positions, std::size_t stride, std::uint32_t index ) noexcept
+{
+	float xyz[3];
+	std::memcpy( xyz, reinterpret_cast<const std::byte *>( positions ) + index * stride, sizeof( xyz ) );
+	return Position{ xyz[0], xyz[1], xyz[2] };
+}
+
+// Bitwise hash of a whole vertex; welding compares bytes too, so -0 and +0 stay distinct
+std::uint32_t hashVertex( const assets::Vertex &vertex ) noexcept
+{
+	std::uint32_t words[sizeof( assets::Vertex ) / 4];
+	std::memcpy( words, &vertex, sizeof( words ) );
+	std::uint32_t hash = 2166136261u;
+	for ( const std::uint32_t word : words )
+	{
+		hash = ( hash ^ word ) * 16777619u;
+		hash ^= hash >> 15;
+	}
+	return hash;
+}
+
+bool isTriangleList( std::span<const std::uint32_t> indices, std::size_t vertexCount ) noexcept
+{
+	return !indices.empty() && indices.size() % 3 == 0 &&
+		std::all_of( indices.begin(), indices.end(), [vertexCount]( std::uint32_t index ) { return index < vertexCount; } );
+}
+
+void remapIndices( std::vector<std::uint32_t> &indices, const std::vector<std::uint32_t> &remap )
+{
+	for ( auto &index : indices )
+	{
+		index = remap[index];
+	}
+}
+
+// Move every vertex to remap[i], dropping those mapped to kUnusedVertex; several may share a target
+void remapVertices( std::vector<assets::Vertex> &vertices, const std::vector<std::uint32_t> &remap, std::uint32_t newCount )
+{
+	std::vector<assets::Vertex> remapped( newCount );
+	for ( std::size_t i = 0; i < vertices.size(); ++i )
+	{
+		if ( remap[i] != kUnusedVertex )
+		{
+			remapped[remap[i]] = vertices[i];
+		}
+	}
+	vertices = std::move( remapped );
+}
+} // namespace
+
+VertexCacheStats simulateVertexCache( std::span<const std::uint32_t> indices, std::size_t vertexCount, std::uint32_t cacheSize )
+{
+	VertexCacheStats stats;
+	stats.triangleCount = static_cast<std::uint32_t>( indices.size() / 3 );
+
+	FifoCache cache( vertexCount, cacheSize );
+	std::vector<std::uint8_t> referenced( vertexCount, 0 );
+	for ( std::size_t i = 0; i < stats.triangleCount * 3; ++i )
+	{
+		const std::uint32_t vertex = indices[i];
+		stats.vertexTransforms += cache.touch( vertex );
+		stats.vertexCount += referenced[vertex] == 0;
+		referenced[vertex] = 1;
+	}
+	return stats;
+}
+
+std::uint32_t generateWeldRemap( std::span<const assets::Vertex> vertices, std::vector<std::uint32_t> &remap )
+{
+	remap.assign( vertices.size(), 0 );
+
+	// Open addressing over first occurrences, at most half full
+	const std::size_t tableSize = std::bit_ceil( std::max<std::size_t>( vertices.size() * 2, 16 ) );
+	std::vector<std::uint32_t> table( tableSize, kUnusedVertex );
+	std::uint32_t uniqueCount = 0;
+	for ( std::uint32_t i = 0; i < vertices.size(); ++i )
+	{
+		std::size_t slot = hashVertex( vertices[i] ) & ( tableSize - 1 );
+		for ( ;; slot = ( slot + 1 ) & ( tableSize - 1 ) )
+		{
+			const std::uint32_t first = table[slot];
+			if ( first == kUnusedVertex )
+			{
+				table[slot] = i;
+				remap[i] = uniqueCount++;
+				break;
+			}
+			if ( std::memcmp( &vertices[first], &vertices[i], sizeof( assets::Vertex ) ) == 0 )
+			{
+				remap[i] = remap[first];
+				break;
+			}
+		}
+	}
+	return uniqueCount;
+}
+
+std::vector<std::uint32_t> optimizeVertexCache( std::span<const std::uint32_t> indices, std::size_t vertexCount, std::uint32_t cacheSize )
+{
+	const std::size_t triangleCount = indices.size() / 3;
+	std::vector<std::uint32_t> result;
+	result.reserve( triangleCount * 3 );
+
+	// Triangles around each vertex, and how many of them are still to be emitted
+	std::vector<std::uint32_t> liveTriangles( vertexCount, 0 );
+	for ( std::size_t i = 0; i < triangleCount * 3; ++i )
+	{
+		++liveTriangles[indices[i]];
+	}
+	std::vector<std::uint32_t> adjacencyOffsets( vertexCount + 1, 0 );
+	std::inclusive_scan( liveTriangles.begin(), liveTriangles.end(), adjacencyOffsets.begin() + 1 );
+	std::vector<std::uint32_t> adjacency( triangleCount * 3 );
+	{
+		std::vector<std::uint32_t> cursor( adjacencyOffsets.begin(), adjacencyOffsets.end() - 1 );
+		for ( std::size_t i = 0; i < triangleCount * 3; ++i )
+		{
+			adjacency[cursor[indices[i]]++] = static_cast<std::uint32_t>( i / 3 );
+		}
+	}
+
+	FifoCache cache( vertexCount, cacheSize );
+	std::vector<std::uint8_t> emitted( triangleCount, 0 );
+	std::vector<std::uint32_t> deadEnds;
+	std::vector<std::uint32_t> candidates;
+	std::size_t inputCursor = 0;
+
+	// Most recent dead end that still has triangles, else the next such vertex in input order
+	const auto skipDeadEnd = [&]() -> std::uint32_t {
+		while ( !deadEnds.empty() )
+		{
+			const std::uint32_t vertex = deadEnds.back();
+			deadEnds.pop_back();
+			if ( liveTriangles[vertex] > 0 )
+			{
+				return vertex;
+			}
+		}
+		for ( ; inputCursor < vertexCount; ++inputCursor )
+		{
+			if ( liveTriangles[inputCursor] > 0 )
+			{
+				return static_cast<std::uint32_t>( inputCursor );
+			}
+		}
+		return kUnusedVertex;
+	};
+
+	std::uint32_t fan = skipDeadEnd();
+	while ( fan != kUnusedVertex )
+	{
+		candidates.clear();
+		for ( std::uint32_t k = adjacencyOffsets[fan]; k < adjacencyOffsets[fan + 1]; ++k )
+		{
+			const std::uint32_t triangle = adjacency[k];
+			if ( emitted[triangle] )
+			{
+				continue;
+			}
+			emitted[triangle] = 1;
+			for ( std::uint32_t corner = 0; corner < 3; ++corner )
+			{
+				const std::uint32_t vertex = indices[triangle * 3 + corner];
+				result.push_back( vertex );
+				deadEnds.push_back( vertex );
+				candidates.push_back( vertex );
+				--liveTriangles[vertex];
+				cache.touch( vertex );
+			}
+		}
+
+		// Next fan: the oldest candidate that stays resident while its remaining triangles are emitted
+		std::uint32_t next = kUnusedVertex;
+		std::int64_t bestPriority = -1;
+		for ( const std::uint32_t vertex : candidates )
+		{
+			if ( liveTriangles[vertex] == 0 )
+			{
+				continue;
+			}
+			std::int64_t priority = 0;
+			if ( static_cast<std::uint64_t>( cache.age( vertex ) ) + 2ull * liveTriangles[vertex] <= cacheSize )
+			{
+				priority = cache.age( vertex );
+			}
+			if ( priority > bestPriority )
+			{
+				bestPriority = priority;
+				next = vertex;
+			}
+		}
+		fan = next != kUnusedVertex ? next : skipDeadEnd();
+	}
+	return result;
+}
+
+std::vector<std::uint32_t> optimizeOverdraw( std::span<const std::uint32_t> indices,
+	const float *positions,
+	std::size_t vertexCount,
+	std::size_t positionStride,
+	float threshold,
+	std::uint32_t cacheSize )
+{
+	const std::size_t triangleCount = indices.size() / 3;
+	std::vector<std::uint32_t> result( indices.begin(), indices.begin() + triangleCount * 3 );
+	if ( triangleCount < 2 )
+	{
+		return result;
+	}
+
+	// Hard boundaries: triangles missing on all three vertices, where the cache optimizer restarted
+	FifoCache cache( vertexCount, cacheSize );
+	std::vector<std::uint32_t> hardStarts;
+	for ( std::size_t triangle = 0; triangle < triangleCount; ++triangle )
+	{
+		if ( cache.touchTriangle( &indices[triangle * 3] ) == 3 || triangle == 0 )
+		{
+			hardStarts.push_back( static_cast<std::uint32_t>( triangle ) );
+		}
+	}
+	hardStarts.push_back( static_cast<std::uint32_t>( triangleCount ) );
+
+	// Soft boundaries: within each run, start a new cluster as soon as the current one, measured from a
+	// cold cache, is within threshold of the run's miss ratio. The last cluster is merged into its
+	// predecessor when it falls short, since a flushed tail costs the most.
+	std::vector<std::uint32_t> clusterStarts;
+	for ( std::size_t run = 0; run + 1 < hardStarts.size(); ++run )
+	{
+		const std::uint32_t begin = hardStarts[run];
+		const std::uint32_t end = hardStarts[run + 1];
+
+		cache.flush();
+		std::uint32_t runMisses = 0;
+		for ( std::uint32_t triangle = begin; triangle < end; ++triangle )
+		{
+			runMisses += cache.touchTriangle( &indices[triangle * 3] );
+		}
+		const double target = threshold * static_cast<double>( runMisses ) / static_cast<double>( end - begin );
+
+		const std::size_t firstCluster = clusterStarts.size();
+		clusterStarts.push_back( begin );
+		cache.flush();
+		std::uint32_t misses = 0;
+		std::uint32_t triangles = 0;
+		for ( std::uint32_t triangle = begin; triangle < end; ++triangle )
+		{
+			misses += cache.touchTriangle( &indices[triangle * 3] );
+			++triangles;
+			if ( triangle + 1 < end && static_cast<double>( misses ) <= target * triangles )
+			{
+				clusterStarts.push_back( triangle + 1 );
+				cache.flush();
+				misses = 0;
+				triangles = 0;
+			}
+		}
+		if ( clusterStarts.size() - firstCluster > 1 && static_cast<double>( misses ) > target * triangles )
+		{
+			clusterStarts.pop_back();
+		}
+	}
+	clusterStarts.push_back( static_cast<std::uint32_t>( triangleCount ) );
+	const std::size_t clusterCount = clusterStarts.size() - 1;
+
+	// Area-weighted centroid and normal per cluster, and the mesh centroid
+	std::vector<Position> clusterCentroids( clusterCount, Position{ 0, 0, 0 } );
+	std::vector<Position> clusterNormals( clusterCount, Position{ 0, 0, 0 } );
+	std::vector<double> clusterAreas( clusterCount, 0.0 );
+	Position meshCentroid{ 0, 0, 0 };
+	double meshArea = 0.0;
+	for ( std::size_t cluster = 0; cluster < clusterCount; ++cluster )
+	{
+		for ( std::uint32_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; ++triangle )
+		{
+			const auto a = loadPosition( positions, positionStride, indices[triangle * 3] );
+			const auto b = loadPosition( positions, positionStride, indices[triangle * 3 + 1] );
+			const auto c = loadPosition( positions, positionStride, indices[triangle * 3 + 2] );
+			const Position ab{ b.x - a.x, b.y - a.y, b.z - a.z };
+			const Position ac{ c.x - a.x, c.y - a.y, c.z - a.z };
+			const Position normal{ ab.y * ac.z - ab.z * ac.y, ab.z * ac.x - ab.x * ac.z, ab.x * ac.y - ab.y * ac.x };
+			const double area = std::sqrt( normal.x * normal.x + normal.y * normal.y + normal.z * normal.z );
+
+			auto &centroid = clusterCentroids[cluster];
+			centroid.x += ( a.x + b.x + c.x ) / 3.0 * area;
+			centroid.y += ( a.y + b.y + c.y ) / 3.0 * area;
+			centroid.z += ( a.z + b.z + c.z ) / 3.0 * area;
+			clusterNormals[cluster].x += normal.x;
+			clusterNormals[cluster].y += normal.y;
+			clusterNormals[cluster].z += normal.z;
+			clusterAreas[cluster] += area;
+		}
+		meshCentroid.x += clusterCentroids[cluster].x;
+		meshCentroid.y += clusterCentroids[cluster].y;
+		meshCentroid.z += clusterCentroids[cluster].z;
+		meshArea += clusterAreas[cluster];
+	}
+	if ( meshArea > 0.0 )
+	{
+		meshCentroid = { meshCentroid.x / meshArea, meshCentroid.y / meshArea, meshCentroid.z / meshArea };
+	}
+
+	// How far a cluster faces away from the centre; outermost clusters first
+	std::vector<double> facing( clusterCount, 0.0 );
+	for ( std::size_t cluster = 0; cluster < clusterCount; ++cluster )
+	{
+		const double area = clusterAreas[cluster];
+		const auto &normal = clusterNormals[cluster];
+		const double length = std::sqrt( normal.x * normal.x + normal.y * normal.y + normal.z * normal.z );
+		if ( area <= 0.0 || length <= 0.0 )
+		{
+			continue;
+		}
+		const auto &centroid = clusterCentroids[cluster];
+		const Position offset{ centroid.x / area - meshCentroid.x, centroid.y / area - meshCentroid.y, centroid.z / area - meshCentroid.z };
+		facing[cluster] = ( offset.x * normal.x + offset.y * normal.y + offset.z * normal.z ) / length;
+	}
+
+	std::vector<std::uint32_t> order( clusterCount );
+	std::iota( order.begin(), order.end(), 0u );
+	std::stable_sort( order.begin(), order.end(), [&facing]( std::uint32_t a, std::uint32_t b ) { return facing[a] > facing[b]; } );
+
+	std::size_t write = 0;
+	for ( const std::uint32_t cluster : order )
+	{
+		const std::size_t begin = std::size_t{ clusterStarts[cluster] } * 3;
+		const std::size_t end = std::size_t{ clusterStarts[cluster + 1] } * 3;
+		std::copy( indices.begin() + begin, indices.begin() + end, result.begin() + write );
+		write += end - begin;
+	}
+	return result;
+}
+
+std::uint32_t generateFetchRemap( std::span<const std::uint32_t> indices, std::size_t vertexCount, std::vector<std::uint32_t> &remap )
+{
+	remap.assign( vertexCount, kUnusedVertex );
+	std::uint32_t next = 0;
+	for ( const std::uint32_t index : indices )
+	{
+		if ( remap[index] == kUnusedVertex )
+		{
+			remap[index] = next++;
+		}
+	}
+	return next;
+}
+
+OptimizeReport optimizePrimitive( assets::Primitive &primitive, const OptimizeSettings &settings )
+{
+	OptimizeReport report;
+	report.verticesBefore = primitive.getVertexCount();
+	report.verticesAfter = report.verticesBefore;
+	report.shortIndices = primitive.fitsShortIndices();
+
+	const std::size_t vertexCount = primitive.getVertexCount();
+	if ( !isTriangleList( primitive.getIndices(), vertexCount ) )
+	{
+		report.cacheBefore = simulateVertexCache( primitive.getIndices(), vertexCount, settings.cacheSize );
+		report.cacheAfter = report.cacheBefore;
+		return report;
+	}
+	for ( const auto &lod : primitive.getLods() )
+	{
+		if ( !isTriangleList( lod.indices, vertexCount ) )
+		{
+			report.cacheBefore = simulateVertexCache( primitive.getIndices(), vertexCount, settings.cacheSize );
+			report.cacheAfter = report.cacheBefore;
+			return report;
+		}
+	}
+
+	const auto layout = primitive.getVertexLayout();
+	const auto bounds = primitive.getBounds();
+	auto vertices = primitive.decodeVertices();
+	auto indices = primitive.getIndices();
+	auto lods = primitive.getLods();
+	report.cacheBefore = simulateVertexCache( indices, vertices.size(), settings.cacheSize );
+
+	std::vector<std::uint32_t> remap;
+	if ( settings.weldVertices )
+	{
+		const std::uint32_t uniqueCount = generateWeldRemap( vertices, remap );
+		if ( uniqueCount < vertices.size() )
+		{
+			remapVertices( vertices, remap, uniqueCount );
+			remapIndices( indices, remap );
+			for ( auto &lod : lods )
+			{
+				remapIndices( lod.indices, remap );
+			}
+		}
+	}
+
+	if ( settings.optimizeVertexCache )
+	{
+		indices = optimizeVertexCache( indices, vertices.size(), settings.cacheSize );
+		for ( auto &lod : lods )
+		{
+			lod.indices = optimizeVertexCache( lod.indices, vertices.size(), settings.cacheSize );
+		}
+	}
+
+	if ( settings.optimizeOverdraw )
+	{
+		indices = optimizeOverdraw( indices, &vertices[0].position.x, vertices.size(), sizeof( assets::Vertex ), settings.overdrawThreshold, settings.cacheSize );
+	}
+
+	// Last, so vertices are laid out in the order the final triangle list reads them; LOD lists only use
+	// full-detail vertices and are appended so nothing they reference is dropped
+	if ( settings.optimizeVertexFetch )
+	{
+		std::vector<std::uint32_t> allIndices = indices;
+		for ( const auto &lod : lods )
+		{
+			allIndices.insert( allIndices.end(), lod.indices.begin(), lod.indices.end() );
+		}
+		const std::uint32_t referencedCount = generateFetchRemap( allIndices, vertices.size(), remap );
+		remapVertices( vertices, remap, referencedCount );
+		remapIndices( indices, remap );
+		for ( auto &lod : lods )
+		{
+			remapIndices( lod.indices, remap );
+		}
+	}
+
+	report.cacheAfter = simulateVertexCache( indices, vertices.size(), settings.cacheSize );
+
+	primitive.setVertices( std::move( vertices ), bounds );
+	primitive.setIndices( std::move( indices ) );
+	for ( auto &lod : lods )
+	{
+		primitive.addLod( std::move( lod ) );
+	}
+	primitive.setVertexLayout( layout );
+
+	report.verticesAfter = primitive.getVertexCount();
+	report.shortIndices = primitive.fitsShortIndices();
+	return report;
+}
+
+void optimizeLodVertexCache( assets::Primitive &primitive, std::uint32_t cacheSize )
+{
+	const std::size_t vertexCount = primitive.getVertexCount();
+	auto lods = primitive.getLods();
+	for ( auto &lod : lods )
+	{
+		if ( isTriangleList( lod.indices, vertexCount ) )
+		{
+			lod.indices = optimizeVertexCache( lod.indices, vertexCount, cacheSize );
+		}
+	}
+	primitive.clearLods();
+	for ( auto &lod : lods )
+	{
+		primitive.addLod( std::move( lod ) );
+	}
+}
+
+} // namespace engine::mesh_optimize
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace assets
+{
+class Primitive;
+struct Vertex;
+}
+
+// Import-time mesh optimisation: vertex welding, triangle order for the post-transform vertex cache
+// (Tipsify), overdraw-aware cluster order and vertex-fetch order, plus a FIFO cache simulator for
+// ACMR/ATVR metrics. Pure CPU and deterministic: the same input always gives the same output.
+namespace engine::mesh_optimize
+{
+
+// Post-transform cache entries assumed by the optimizer and the simulator
+inline constexpr std::uint32_t kDefaultCacheSize = 16;
+
+// Marks vertices no index refers to in a fetch remap
+inline constexpr std::uint32_t kUnusedVertex = ~0u;
+
+// Cache behaviour of a triangle list as measured by simulateVertexCache()
+struct VertexCacheStats
+{
+	std::uint32_t triangleCount = 0;
+	std::uint32_t vertexCount = 0;		// Distinct vertices referenced
+	std::uint32_t vertexTransforms = 0; // Cache misses
+
+	// Average cache miss ratio: transforms per triangle, 3 at worst and about 0.5 for large regular grids
+	float acmr() const noexcept { return triangleCount ? static_cast<float>( vertexTransforms ) / static_cast<float>( triangleCount ) : 0.0f; }
+	// Average transform to vertex ratio: 1 means every vertex is shaded exactly once
+	float atvr() const noexcept { return vertexCount ? static_cast<float>( vertexTransforms ) / static_cast<float>( vertexCount ) : 0.0f; }
+
+	VertexCacheStats &operator+=( const VertexCacheStats &other ) noexcept
+	{
+		triangleCount += other.triangleCount;
+		vertexCount += other.vertexCount;
+		vertexTransforms += other.vertexTransforms;
+		return *this;
+	}
+};
+
+// Replay a triangle list through a FIFO cache of cacheSize entries, as fixed-function hardware does
+VertexCacheStats simulateVertexCache( std::span<const std::uint32_t> indices, std::size_t vertexCount, std::uint32_t cacheSize = kDefaultCacheSize );
+
+// Map every vertex onto the first bitwise-identical one. Unique vertices are numbered in order of first
+// occurrence, so remap[i] <= i. Returns the unique vertex count.
+std::uint32_t generateWeldRemap( std::span<const assets::Vertex> vertices, std::vector<std::uint32_t> &remap );
+
+// Tipsify (Sander, Nehab and Barczak 2007): fan around recently shaded vertices, preferring those still in
+// a cache of cacheSize entries, and restart from the most recent dead end. Linear in the triangle count.
+std::vector<std::uint32_t> optimizeVertexCache( std::span<const std::uint32_t> indices, std::size_t vertexCount, std::uint32_t cacheSize = kDefaultCacheSize );
+
+// Reorder a cache-optimized triangle list to reduce overdraw. The list is split into clusters at cache
+// restarts and wherever a cluster's miss ratio is within threshold of its whole run; clusters facing away
+// from the mesh centre are drawn first so they occlude the rest. threshold 1.05 keeps the ACMR within
+// about 5% of the input. positions points at vertexCount xyz floats spaced positionStride bytes.
+std::vector<std::uint32_t> optimizeOverdraw( std::span<const std::uint32_t> indices,
+	const float *positions,
+	std::size_t vertexCount,
+	std::size_t positionStride,
+	float threshold,
+	std::uint32_t cacheSize = kDefaultCacheSize );
+
+// Number vertices in the order indices first reference them; unreferenced vertices map to kUnusedVertex.
+// Returns the referenced vertex count.
+std::uint32_t generateFetchRemap( std::span<const std::uint32_t> indices, std::size_t vertexCount, std::vector<std::uint32_t> &remap );
+
+struct OptimizeSettings
+{
+	bool weldVertices = true;
+	bool optimizeVertexCache = true;
+	bool optimizeOverdraw = true;
+	bool optimizeVertexFetch = true;
+	std::uint32_t cacheSize = kDefaultCacheSize;
+	float overdrawThreshold = 1.05f; // ACMR growth accepted in exchange for overdraw ordering
+};
+
+// What optimizePrimitive() did to one primitive; cache statistics are for the full-detail indices
+struct OptimizeReport
+{
+	std::uint32_t verticesBefore = 0;
+	std::uint32_t verticesAfter = 0;
+	VertexCacheStats cacheBefore;
+	VertexCacheStats cacheAfter;
+	bool shortIndices = false; // Every vertex is addressable with 16-bit indices
+};
+
+// Run the enabled passes on an indexed triangle list in place. Existing LOD index lists are remapped and
+// cache-ordered with the full-detail list; the vertex layout is kept. Primitives without a valid triangle
+// list are only measured.
+OptimizeReport optimizePrimitive( assets::Primitive &primitive, const OptimizeSettings &settings = {} );
+
+// Cache-order every LOD index list, for LOD chains generated after optimizePrimitive()
+void optimizeLodVertexCache( assets::Primitive &primitive, std::uint32_t cacheSize = kDefaultCacheSize );
+
+} // namespace engine::mesh_optimize
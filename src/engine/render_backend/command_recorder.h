@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Backend-neutral command recording interface. Render code records through CommandRecorder so the
+// same submission path can target D3D12 or the null RecordingCommandRecorder used for headless
+// profiling and tests. Buffers are referred to by GPU virtual address, pipelines by opaque handle.
+namespace engine::render_backend
+{
+
+using PipelineHandle = const void *;
+using GpuAddress = std::uint64_t;
+
+struct VertexBufferView
+{
+	GpuAddress gpuAddress = 0;
+	std::uint32_t sizeInBytes = 0;
+	std::uint32_t strideInBytes = 0;
+};
+
+enum class IndexFormat : std::uint8_t
+{
+	UInt16,
+	UInt32
+};
+
+struct IndexBufferView
+{
+	GpuAddress gpuAddress = 0;
+	std::uint32_t sizeInBytes = 0;
+	IndexFormat format = IndexFormat::UInt32;
+};
+
+class CommandRecorder
+{
+public:
+	virtual ~CommandRecorder() = default;
+
+	virtual void setPipelineState( PipelineHandle pipeline ) = 0;
+	virtual void setVertexBuffer( const VertexBufferView &view ) = 0;
+	virtual void setIndexBuffer( const IndexBufferView &view ) = 0;
+
+	// Root signature bindings (graphics)
+	virtual void setRootConstants( std::uint32_t rootParameter, std::uint32_t num32BitValues, const void *data ) = 0;
+	virtual void setRootConstantBuffer( std::uint32_t rootParameter, GpuAddress gpuAddress ) = 0;
+	virtual void setRootShaderResource( std::uint32_t rootParameter, GpuAddress gpuAddress ) = 0;
+
+	virtual void drawIndexed( std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t startIndex, std::int32_t baseVertex, std::uint32_t startInstance ) = 0;
+	virtual void draw( std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startVertex, std::uint32_t startInstance ) = 0;
+
+	// CPU writes into mapped upload memory made on behalf of this command stream (not a GPU command)
+	virtual void notifyUpload( std::size_t /*bytes*/ ) {}
+};
+
+} // namespace engine::render_backend
@@ -0,0 +1,65 @@
+#include "engine/render_backend/d3d12_command_recorder.h"
+
+namespace engine::render_backend
+{
+
+void D3D12CommandRecorder::setPipelineState( PipelineHandle pipeline )
+{
+	// Pipeline handles recorded for D3D12 are ID3D12PipelineState pointers
+	m_commandList->SetPipelineState( static_cast<ID3D12PipelineState *>( const_cast<void *>( pipeline ) ) );
+}
+
+void D3D12CommandRecorder::setVertexBuffer( const VertexBufferView &view )
+{
+	D3D12_VERTEX_BUFFER_VIEW d3dView = {};
+	d3dView.BufferLocation = view.gpuAddress;
+	d3dView.SizeInBytes = view.sizeInBytes;
+	d3dView.StrideInBytes = view.strideInBytes;
+	m_commandList->IASetVertexBuffers( 0, 1, &d3dView );
+}
+
+void D3D12CommandRecorder::setIndexBuffer( const IndexBufferView &view )
+{
+	D3D12_INDEX_BUFFER_VIEW d3dView = {};
+	d3dView.BufferLocation = view.gpuAddress;
+	d3dView.SizeInBytes = view.sizeInBytes;
+	d3dView.Format = view.format == IndexFormat::UInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	m_commandList->IASetIndexBuffer( &d3dView );
+}
+
+void D3D12CommandRecorder::setRootConstants( std::uint32_t rootParameter, std::uint32_t num32BitValues, const void *data )
+{
+	m_commandList->SetGraphicsRoot32BitConstants( rootParameter, num32BitValues, data, 0 );
+}
+
+void D3D12CommandRecorder::setRootConstantBuffer( std::uint32_t rootParameter, GpuAddress gpuAddress )
+{
+	m_commandList->SetGraphicsRootConstantBufferView( rootParameter, gpuAddress );
+}
+
+void D3D12CommandRecorder::setRootShaderResource( std::uint32_t rootParameter, GpuAddress gpuAddress )
+{
+	m_commandList->SetGraphicsRootShaderResourceView( rootParameter, gpuAddress );
+}
+
+void D3D12CommandRecorder::drawIndexed( std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t startIndex, std::int32_t baseVertex, std::uint32_t startInstance )
+{
+	m_commandList->DrawIndexedInstanced( indexCount, instanceCount, startIndex, baseVertex, startInstance );
+}
+
+void D3D12CommandRecorder::draw( std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startVertex, std::uint32_t startInstance )
+{
+	m_commandList->DrawInstanced( vertexCount, instanceCount, startVertex, startInstance );
+}
+
+VertexBufferView D3D12CommandRecorder::toVertexBufferView( const D3D12_VERTEX_BUFFER_VIEW &view ) noexcept
+{
+	return VertexBufferView{ view.BufferLocation, view.SizeInBytes, view.StrideInBytes };
+}
+
+IndexBufferView D3D12CommandRecorder::toIndexBufferView( const D3D12_INDEX_BUFFER_VIEW &view ) noexcept
+{
+	return IndexBufferView{ view.BufferLocation, view.SizeInBytes, view.Format == DXGI_FORMAT_R16_UINT ? IndexFormat::UInt16 : IndexFormat::UInt32 };
+}
+
+} // namespace engine::render_backend
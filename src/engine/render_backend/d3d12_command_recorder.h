@@ -0,0 +1,38 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include "engine/render_backend/command_recorder.h"
+
+namespace engine::render_backend
+{
+
+// Records straight into a D3D12 graphics command list
+class D3D12CommandRecorder final : public CommandRecorder
+{
+public:
+	explicit D3D12CommandRecorder( ID3D12GraphicsCommandList *commandList ) noexcept
+		: m_commandList( commandList ) {}
+
+	ID3D12GraphicsCommandList *getCommandList() const noexcept { return m_commandList; }
+
+	void setPipelineState( PipelineHandle pipeline ) override;
+	void setVertexBuffer( const VertexBufferView &view ) override;
+	void setIndexBuffer( const IndexBufferView &view ) override;
+
+	void setRootConstants( std::uint32_t rootParameter, std::uint32_t num32BitValues, const void *data ) override;
+	void setRootConstantBuffer( std::uint32_t rootParameter, GpuAddress gpuAddress ) override;
+	void setRootShaderResource( std::uint32_t rootParameter, GpuAddress gpuAddress ) override;
+
+	void drawIndexed( std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t startIndex, std::int32_t baseVertex, std::uint32_t startInstance ) override;
+	void draw( std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startVertex, std::uint32_t startInstance ) override;
+
+	// Conversions between D3D12 views and backend-neutral views
+	static VertexBufferView toVertexBufferView( const D3D12_VERTEX_BUFFER_VIEW &view ) noexcept;
+	static IndexBufferView toIndexBufferView( const D3D12_INDEX_BUFFER_VIEW &view ) noexcept;
+
+private:
+	ID3D12GraphicsCommandList *m_commandList = nullptr;
+};
+
+} // namespace engine::render_backend
@@ -0,0 +1,100 @@
+#include "engine/render_backend/d3d12_upload_backend.h"
+
+#include "platform/dx12/dx12_device.h"
+#include "runtime/console.h"
+
+namespace engine::render_backend
+{
+
+D3D12UploadBackend::~D3D12UploadBackend()
+{
+	for ( auto &[handle, resource] : m_resources )
+	{
+		resource->Unmap( 0, nullptr );
+	}
+}
+
+UploadBuffer D3D12UploadBackend::createBuffer( std::uint64_t size )
+{
+	if ( !m_device.get() )
+	{
+		return {};
+	}
+
+	D3D12_HEAP_PROPERTIES heapProps = {};
+	heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+	heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+	heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+	D3D12_RESOURCE_DESC resourceDesc = {};
+	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	resourceDesc.Width = size;
+	resourceDesc.Height = 1;
+	resourceDesc.DepthOrArraySize = 1;
+	resourceDesc.MipLevels = 1;
+	resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+	resourceDesc.SampleDesc.Count = 1;
+	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	HRESULT hr = m_device->CreateCommittedResource(
+		&heapProps,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS( &resource ) );
+	if ( FAILED( hr ) )
+	{
+		console::error( "D3D12UploadBackend: failed to create {} byte upload buffer", size );
+		return {};
+	}
+
+	// Upload heaps stay mapped for the buffer's lifetime; the CPU never reads them
+	void *mappedData = nullptr;
+	const D3D12_RANGE readRange = { 0, 0 };
+	hr = resource->Map( 0, &readRange, &mappedData );
+	if ( FAILED( hr ) )
+	{
+		console::error( "D3D12UploadBackend: failed to map upload buffer" );
+		return {};
+	}
+	resource->SetName( m_debugName );
+
+	UploadBuffer buffer;
+	buffer.handle = reinterpret_cast<std::uint64_t>( resource.Get() );
+	buffer.cpuAddress = static_cast<std::uint8_t *>( mappedData );
+	buffer.gpuAddress = resource->GetGPUVirtualAddress();
+	buffer.size = size;
+	m_resources.emplace( buffer.handle, std::move( resource ) );
+	return buffer;
+}
+
+void D3D12UploadBackend::destroyBuffer( const UploadBuffer &buffer )
+{
+	const auto it = m_resources.find( buffer.handle );
+	if ( it == m_resources.end() )
+	{
+		return;
+	}
+	it->second->Unmap( 0, nullptr );
+	m_resources.erase( it );
+}
+
+std::uint64_t D3D12UploadBackend::getCompletedFenceValue() const
+{
+	return m_device.getCompletedFenceValue();
+}
+
+void D3D12UploadBackend::waitForFenceValue( std::uint64_t value )
+{
+	m_device.waitForFenceValue( value );
+}
+
+ID3D12Resource *D3D12UploadBackend::getResource( std::uint64_t handle ) const noexcept
+{
+	const auto it = m_resources.find( handle );
+	return it != m_resources.end() ? it->second.Get() : nullptr;
+}
+
+} // namespace engine::render_backend
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <d3d12.h>
+#include <unordered_map>
+#include <wrl.h>
+
+#include "engine/render_backend/upload_ring.h"
+
+namespace dx12
+{
+class Device;
+}
+
+namespace engine::render_backend
+{
+
+// Upload-heap committed buffers, persistently mapped, with the device's frame fence for retirement
+class D3D12UploadBackend final : public UploadBackend
+{
+public:
+	// debugName labels every created buffer in PIX and the debug layer
+	explicit D3D12UploadBackend( dx12::Device &device, const wchar_t *debugName = L"Upload Ring" ) noexcept
+		: m_device( device ), m_debugName( debugName ) {}
+	~D3D12UploadBackend() override;
+
+	UploadBuffer createBuffer( std::uint64_t size ) override;
+	void destroyBuffer( const UploadBuffer &buffer ) override;
+
+	std::uint64_t getCompletedFenceValue() const override;
+	void waitForFenceValue( std::uint64_t value ) override;
+
+	// Resource behind an allocation's buffer handle (debug names, tests)
+	ID3D12Resource *getResource( std::uint64_t handle ) const noexcept;
+
+private:
+	dx12::Device &m_device;
+	const wchar_t *m_debugName;
+	std::unordered_map<std::uint64_t, Microsoft::WRL::ComPtr<ID3D12Resource>> m_resources;
+};
+
+} // namespace engine::render_backend
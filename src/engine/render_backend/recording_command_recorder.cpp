@@ -0,0 +1,198 @@
+#include "engine/render_backend/recording_command_recorder.h"
+
+#include <cstring>
+#include <ostream>
+
+namespace engine::render_backend
+{
+
+const char *toString( CommandType type ) noexcept
+{
+	switch ( type )
+	{
+	case CommandType::SetPipelineState:
+		return "SetPipelineState";
+	case CommandType::SetVertexBuffer:
+		return "SetVertexBuffer";
+	case CommandType::SetIndexBuffer:
+		return "SetIndexBuffer";
+	case CommandType::SetRootConstants:
+		return "SetRootConstants";
+	case CommandType::SetRootConstantBuffer:
+		return "SetRootConstantBuffer";
+	case CommandType::SetRootShaderResource:
+		return "SetRootShaderResource";
+	case CommandType::DrawIndexed:
+		return "DrawIndexed";
+	case CommandType::Draw:
+		return "Draw";
+	case CommandType::Upload:
+		return "Upload";
+	}
+	return "Unknown";
+}
+
+void RecordingCommandRecorder::reset() noexcept
+{
+	m_stats = {};
+	m_capture.clear();
+	m_rootConstantData.clear();
+}
+
+void RecordingCommandRecorder::capture( CommandType type, std::uint64_t address, std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d, std::uint32_t e )
+{
+	if ( m_captureEnabled )
+	{
+		m_capture.push_back( RecordedCommand{ type, address, { a, b, c, d, e } } );
+	}
+}
+
+void RecordingCommandRecorder::setPipelineState( PipelineHandle pipeline )
+{
+	++m_stats.pipelineChanges;
+	capture( CommandType::SetPipelineState, reinterpret_cast<std::uintptr_t>( pipeline ) );
+}
+
+void RecordingCommandRecorder::setVertexBuffer( const VertexBufferView &view )
+{
+	++m_stats.vertexBufferBinds;
+	capture( CommandType::SetVertexBuffer, view.gpuAddress, view.sizeInBytes, view.strideInBytes );
+}
+
+void RecordingCommandRecorder::setIndexBuffer( const IndexBufferView &view )
+{
+	++m_stats.indexBufferBinds;
+	capture( CommandType::SetIndexBuffer, view.gpuAddress, view.sizeInBytes, view.format == IndexFormat::UInt16 ? 16u : 32u );
+}
+
+void RecordingCommandRecorder::setRootConstants( std::uint32_t rootParameter, std::uint32_t num32BitValues, const void *data )
+{
+	++m_stats.rootConstantUploads;
+	m_stats.rootConstantBytes += static_cast<std::uint64_t>( num32BitValues ) * 4;
+	if ( m_captureEnabled )
+	{
+		const std::size_t offset = m_rootConstantData.size();
+		m_rootConstantData.resize( offset + num32BitValues );
+		std::memcpy( m_rootConstantData.data() + offset, data, static_cast<std::size_t>( num32BitValues ) * 4 );
+		capture( CommandType::SetRootConstants, offset, rootParameter, num32BitValues );
+	}
+}
+
+void RecordingCommandRecorder::setRootConstantBuffer( std::uint32_t rootParameter, GpuAddress gpuAddress )
+{
+	++m_stats.constantBufferBinds;
+	capture( CommandType::SetRootConstantBuffer, gpuAddress, rootParameter );
+}
+
+void RecordingCommandRecorder::setRootShaderResource( std::uint32_t rootParameter, GpuAddress gpuAddress )
+{
+	++m_stats.shaderResourceBinds;
+	capture( CommandType::SetRootShaderResource, gpuAddress, rootParameter );
+}
+
+void RecordingCommandRecorder::drawIndexed( std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t startIndex, std::int32_t baseVertex, std::uint32_t startInstance )
+{
+	++m_stats.drawCalls;
+	++m_stats.indexedDrawCalls;
+	m_stats.instances += instanceCount;
+	m_stats.indices += static_cast<std::uint64_t>( indexCount ) * instanceCount;
+	capture( CommandType::DrawIndexed, 0, indexCount, instanceCount, startIndex, static_cast<std::uint32_t>( baseVertex ), startInstance );
+}
+
+void RecordingCommandRecorder::draw( std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startVertex, std::uint32_t startInstance )
+{
+	++m_stats.drawCalls;
+	m_stats.instances += instanceCount;
+	m_stats.indices += static_cast<std::uint64_t>( vertexCount ) * instanceCount;
+	capture( CommandType::Draw, 0, vertexCount, instanceCount, startVertex, startInstance );
+}
+
+void RecordingCommandRecorder::notifyUpload( std::size_t bytes )
+{
+	m_stats.uploadBytes += bytes;
+	capture( CommandType::Upload, bytes );
+}
+
+void RecordingCommandRecorder::replay( CommandRecorder &target ) const
+{
+	for ( const auto &command : m_capture )
+	{
+		const auto *args = command.args;
+		switch ( command.type )
+		{
+		case CommandType::SetPipelineState:
+			target.setPipelineState( reinterpret_cast<PipelineHandle>( static_cast<std::uintptr_t>( command.address ) ) );
+			break;
+		case CommandType::SetVertexBuffer:
+			target.setVertexBuffer( { command.address, args[0], args[1] } );
+			break;
+		case CommandType::SetIndexBuffer:
+			target.setIndexBuffer( { command.address, args[0], args[1] == 16 ? IndexFormat::UInt16 : IndexFormat::UInt32 } );
+			break;
+		case CommandType::SetRootConstants:
+			target.setRootConstants( args[0], args[1], m_rootConstantData.data() + command.address );
+			break;
+		case CommandType::SetRootConstantBuffer:
+			target.setRootConstantBuffer( args[0], command.address );
+			break;
+		case CommandType::SetRootShaderResource:
+			target.setRootShaderResource( args[0], command.address );
+			break;
+		case CommandType::DrawIndexed:
+			target.drawIndexed( args[0], args[1], args[2], static_cast<std::int32_t>( args[3] ), args[4] );
+			break;
+		case CommandType::Draw:
+			target.draw( args[0], args[1], args[2], args[3] );
+			break;
+		case CommandType::Upload:
+			target.notifyUpload( static_cast<std::size_t>( command.address ) );
+			break;
+		}
+	}
+}
+
+void RecordingCommandRecorder::writeCapture( std::ostream &out ) const
+{
+	out << "# Frame capture: " << m_capture.size() << " commands\n";
+	for ( std::size_t i = 0; i < m_capture.size(); ++i )
+	{
+		const auto &command = m_capture[i];
+		const auto *args = command.args;
+		out << std::dec << i << ' ' << toString( command.type );
+		switch ( command.type )
+		{
+		case CommandType::SetPipelineState:
+			out << " pipeline=0x" << std::hex << command.address;
+			break;
+		case CommandType::SetVertexBuffer:
+			out << " address=0x" << std::hex << command.address << std::dec << " size=" << args[0] << " stride=" << args[1];
+			break;
+		case CommandType::SetIndexBuffer:
+			out << " address=0x" << std::hex << command.address << std::dec << " size=" << args[0] << " bits=" << args[1];
+			break;
+		case CommandType::SetRootConstants:
+			out << " param=" << args[0] << " dwords=" << args[1];
+			break;
+		case CommandType::SetRootConstantBuffer:
+		case CommandType::SetRootShaderResource:
+			out << " param=" << args[0] << " address=0x" << std::hex << command.address;
+			break;
+		case CommandType::DrawIndexed:
+			out << " indices=" << args[0] << " instances=" << args[1] << " startIndex=" << args[2] << " baseVertex=" << static_cast<std::int32_t>( args[3] )
+				<< " startInstance=" << args[4];
+			break;
+		case CommandType::Draw:
+			out << " vertices=" << args[0] << " instances=" << args[1] << " startVertex=" << args[2] << " startInstance=" << args[3];
+			break;
+		case CommandType::Upload:
+			out << " bytes=" << command.address;
+			break;
+		}
+		out << std::dec << '\n';
+	}
+
+	out << "# draws=" << m_stats.drawCalls << " instances=" << m_stats.instances << " stateChanges=" << m_stats.stateChanges()
+		<< " pipelines=" << m_stats.pipelineChanges << " rootConstants=" << m_stats.rootConstantUploads << " bytes=" << m_stats.totalBytes() << '\n';
+}
+
+} // namespace engine::render_backend
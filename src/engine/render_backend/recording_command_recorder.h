@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "engine/render_backend/command_recorder.h"
+
+namespace engine::render_backend
+{
+
+// Counters accumulated by RecordingCommandRecorder
+struct CommandStats
+{
+	std::uint32_t drawCalls = 0;
+	std::uint32_t indexedDrawCalls = 0;
+	std::uint64_t instances = 0;
+	std::uint64_t indices = 0;	// Indices (or vertices for non-indexed draws) times instances
+	std::uint32_t pipelineChanges = 0;
+	std::uint32_t vertexBufferBinds = 0;
+	std::uint32_t indexBufferBinds = 0;
+	std::uint32_t rootConstantUploads = 0;
+	std::uint32_t constantBufferBinds = 0;
+	std::uint32_t shaderResourceBinds = 0;
+	std::uint64_t rootConstantBytes = 0;
+	std::uint64_t uploadBytes = 0;
+
+	std::uint32_t stateChanges() const noexcept
+	{
+		return pipelineChanges + vertexBufferBinds + indexBufferBinds + rootConstantUploads + constantBufferBinds + shaderResourceBinds;
+	}
+	std::uint64_t totalBytes() const noexcept { return rootConstantBytes + uploadBytes; }
+};
+
+enum class CommandType : std::uint8_t
+{
+	SetPipelineState,
+	SetVertexBuffer,
+	SetIndexBuffer,
+	SetRootConstants,
+	SetRootConstantBuffer,
+	SetRootShaderResource,
+	DrawIndexed,
+	Draw,
+	Upload
+};
+
+const char *toString( CommandType type ) noexcept;
+
+// One captured command; argument meaning depends on type (see writeCapture for the labels)
+struct RecordedCommand
+{
+	CommandType type = CommandType::Draw;
+	std::uint64_t address = 0; // GPU address, pipeline handle, byte count or root constant data offset
+	std::uint32_t args[5] = {};
+};
+
+// Null backend: issues nothing, counts everything and optionally keeps a frame capture.
+// Lets the render submission path run and be profiled without a GPU. A capture keeps root constant
+// data too, so it can be replayed into another recorder (e.g. from the render thread into the D3D12 list).
+class RecordingCommandRecorder final : public CommandRecorder
+{
+public:
+	explicit RecordingCommandRecorder( bool captureEnabled = false ) noexcept
+		: m_captureEnabled( captureEnabled ) {}
+
+	// Clear statistics and capture, e.g. at the start of a frame
+	void reset() noexcept;
+
+	const CommandStats &getStats() const noexcept { return m_stats; }
+
+	void setCaptureEnabled( bool enabled ) noexcept { m_captureEnabled = enabled; }
+	bool isCaptureEnabled() const noexcept { return m_captureEnabled; }
+	const std::vector<RecordedCommand> &getCapture() const noexcept { return m_capture; }
+
+	// Issue the captured commands to target in order; uploads are reported through notifyUpload()
+	void replay( CommandRecorder &target ) const;
+
+	// Human readable dump of the captured commands followed by the statistics
+	void writeCapture( std::ostream &out ) const;
+
+	void setPipelineState( PipelineHandle pipeline ) override;
+	void setVertexBuffer( const VertexBufferView &view ) override;
+	void setIndexBuffer( const IndexBufferView &view ) override;
+
+	void setRootConstants( std::uint32_t rootParameter, std::uint32_t num32BitValues, const void *data ) override;
+	void setRootConstantBuffer( std::uint32_t rootParameter, GpuAddress gpuAddress ) override;
+	void setRootShaderResource( std::uint32_t rootParameter, GpuAddress gpuAddress ) override;
+
+	void drawIndexed( std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t startIndex, std::int32_t baseVertex, std::uint32_t startInstance ) override;
+	void draw( std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t startVertex, std::uint32_t startInstance ) override;
+
+	void notifyUpload( std::size_t bytes ) override;
+
+private:
+	void capture( CommandType type, std::uint64_t address, std::uint32_t a = 0, std::uint32_t b = 0, std::uint32_t c = 0, std::uint32_t d = 0, std::uint32_t e = 0 );
+
+	CommandStats m_stats;
+	std::vector<RecordedCommand> m_capture;
+	std::vector<std::uint32_t> m_rootConstantData; // Payloads of captured SetRootConstants, by dword offset
+	bool m_captureEnabled = false;
+};
+
+} // namespace engine::render_backend
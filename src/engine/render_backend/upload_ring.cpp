@@ -0,0 +1,272 @@
+#include "engine/render_backend/upload_ring.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace engine::render_backend
+{
+
+namespace
+{
+std::uint64_t alignUp( std::uint64_t value, std::uint64_t alignment ) noexcept
+{
+	return ( value + alignment - 1 ) & ~( alignment - 1 );
+}
+} // namespace
+
+UploadBuffer CpuUploadBackend::createBuffer( std::uint64_t size )
+{
+	UploadBuffer buffer;
+	buffer.handle = m_nextHandle++;
+	buffer.size = size;
+	buffer.gpuAddress = m_nextGpuAddress;
+
+	auto storage = std::make_unique<std::uint8_t[]>( static_cast<std::size_t>( size ) );
+	buffer.cpuAddress = storage.get();
+	m_buffers.emplace( buffer.handle, std::move( storage ) );
+
+	// Keep synthetic address ranges disjoint and 64 KB aligned like placed D3D12 buffers
+	m_nextGpuAddress += alignUp( size, 65536 );
+	++m_createdBuffers;
+	return buffer;
+}
+
+void CpuUploadBackend::destroyBuffer( const UploadBuffer &buffer )
+{
+	m_buffers.erase( buffer.handle );
+}
+
+void CpuUploadBackend::waitForFenceValue( std::uint64_t value )
+{
+	++m_waits;
+	completeFenceValue( value );
+}
+
+void CpuUploadBackend::completeFenceValue( std::uint64_t value ) noexcept
+{
+	m_completedFenceValue = std::max( m_completedFenceValue, value );
+}
+
+UploadRingAllocator::UploadRingAllocator( UploadBackend &backend, std::uint64_t initialCapacity )
+	: m_backend( backend )
+{
+	if ( initialCapacity > 0 )
+	{
+		m_buffer = m_backend.createBuffer( initialCapacity );
+	}
+}
+
+UploadRingAllocator::~UploadRingAllocator()
+{
+	for ( const auto &retired : m_retiredBuffers )
+	{
+		m_backend.destroyBuffer( retired.buffer );
+	}
+	if ( m_buffer.isValid() )
+	{
+		m_backend.destroyBuffer( m_buffer );
+	}
+}
+
+void UploadRingAllocator::beginFrame()
+{
+	retireCompleted();
+}
+
+bool UploadRingAllocator::tryAllocate( std::uint64_t size, std::uint64_t alignment, std::uint64_t &offset ) noexcept
+{
+	if ( m_used == 0 )
+	{
+		// Restart at the beginning so the whole buffer is contiguous
+		m_head = 0;
+		m_tail = 0;
+	}
+
+	const std::uint64_t capacity = m_buffer.size;
+	const bool full = m_used > 0 && m_head == m_tail;
+	if ( full )
+	{
+		return false;
+	}
+
+	std::uint64_t consumed = 0;
+	if ( m_head >= m_tail )
+	{
+		// Free space is [head, capacity) followed by [0, tail)
+		const std::uint64_t aligned = alignUp( m_head, alignment );
+		if ( aligned + size <= capacity )
+		{
+			offset = aligned;
+			consumed = aligned + size - m_head;
+		}
+		else if ( size <= m_tail )
+		{
+			// Skip the end of the buffer and wrap to offset 0
+			offset = 0;
+			consumed = ( capacity - m_head ) + size;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	else
+	{
+		// Free space is [head, tail)
+		const std::uint64_t aligned = alignUp( m_head, alignment );
+		if ( aligned + size > m_tail )
+		{
+			return false;
+		}
+		offset = aligned;
+		consumed = aligned + size - m_head;
+	}
+
+	m_head = offset + size;
+	m_used += consumed;
+	m_openFrameBytes += consumed;
+	m_frameStats.bytesConsumed += consumed;
+	return true;
+}
+
+UploadAllocation UploadRingAllocator::allocate( std::uint64_t size, std::uint64_t alignment )
+{
+	if ( size == 0 )
+	{
+		return {};
+	}
+	alignment = std::bit_ceil( std::max<std::uint64_t>( alignment, 1 ) );
+
+	std::uint64_t offset = 0;
+	bool allocated = m_buffer.isValid() && tryAllocate( size, alignment, offset );
+	if ( !allocated && m_buffer.isValid() )
+	{
+		retireCompleted();
+		allocated = tryAllocate( size, alignment, offset );
+	}
+
+	while ( !allocated )
+	{
+		// Prefer growing over waiting on the GPU; the old buffer is released once its frames complete
+		if ( grow( size + alignment ) )
+		{
+			allocated = tryAllocate( size, alignment, offset );
+			continue;
+		}
+
+		if ( m_inFlight.empty() )
+		{
+			++m_frameStats.failures;
+			return {};
+		}
+
+		// Out of room: wait for the oldest in-flight frame
+		m_backend.waitForFenceValue( m_inFlight.front().fenceValue );
+		++m_frameStats.stalls;
+		retireOldest();
+		allocated = tryAllocate( size, alignment, offset );
+	}
+
+	++m_frameStats.allocations;
+	m_frameStats.bytesRequested += size;
+
+	UploadAllocation allocation;
+	allocation.cpuAddress = m_buffer.cpuAddress + offset;
+	allocation.gpuAddress = m_buffer.gpuAddress + offset;
+	allocation.offset = offset;
+	allocation.size = size;
+	return allocation;
+}
+
+UploadAllocation UploadRingAllocator::upload( const void *data, std::uint64_t size, std::uint64_t alignment )
+{
+	const UploadAllocation allocation = allocate( size, alignment );
+	if ( allocation.isValid() && data )
+	{
+		std::memcpy( allocation.cpuAddress, data, static_cast<std::size_t>( size ) );
+	}
+	return allocation;
+}
+
+void UploadRingAllocator::endFrame( std::uint64_t fenceValue )
+{
+	if ( m_openFrameBytes > 0 )
+	{
+		m_inFlight.push_back( FrameRecord{ fenceValue, m_head, m_openFrameBytes } );
+	}
+	for ( auto &retired : m_retiredBuffers )
+	{
+		if ( retired.awaitingFence )
+		{
+			retired.fenceValue = fenceValue;
+			retired.awaitingFence = false;
+		}
+	}
+
+	m_peakFrameBytes = std::max( m_peakFrameBytes, m_frameStats.bytesConsumed );
+	m_openFrameBytes = 0;
+	m_lastFrameStats = m_frameStats;
+	m_frameStats = {};
+}
+
+void UploadRingAllocator::retireCompleted()
+{
+	const std::uint64_t completed = m_backend.getCompletedFenceValue();
+	while ( !m_inFlight.empty() && m_inFlight.front().fenceValue <= completed )
+	{
+		retireOldest();
+	}
+
+	std::erase_if( m_retiredBuffers, [&]( const RetiredBuffer &retired ) {
+		if ( retired.awaitingFence || retired.fenceValue > completed )
+		{
+			return false;
+		}
+		m_backend.destroyBuffer( retired.buffer );
+		return true;
+	} );
+}
+
+void UploadRingAllocator::retireOldest()
+{
+	const FrameRecord &frame = m_inFlight.front();
+	m_tail = frame.endHead;
+	m_used -= frame.bytes;
+	m_inFlight.pop_front();
+}
+
+bool UploadRingAllocator::grow( std::uint64_t minimumSize )
+{
+	std::uint64_t capacity = std::max( m_buffer.size * 2, std::bit_ceil( minimumSize ) );
+	if ( m_maxCapacity != 0 )
+	{
+		capacity = std::min( capacity, m_maxCapacity );
+	}
+	if ( capacity <= m_buffer.size || capacity < minimumSize )
+	{
+		return false;
+	}
+
+	const UploadBuffer buffer = m_backend.createBuffer( capacity );
+	if ( !buffer.isValid() )
+	{
+		return false;
+	}
+
+	if ( m_buffer.isValid() )
+	{
+		// In-flight frames and the open frame still read the old buffer; release it after the open frame's fence
+		m_retiredBuffers.push_back( RetiredBuffer{ m_buffer, 0, true } );
+	}
+	m_buffer = buffer;
+	m_inFlight.clear();
+	m_head = 0;
+	m_tail = 0;
+	m_used = 0;
+	m_openFrameBytes = 0;
+	++m_frameStats.growths;
+	return true;
+}
+
+} // namespace engine::render_backend
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/render_backend/command_recorder.h"
+
+// Per-frame linear ring allocator for transient upload data (dynamic vertices, indices, constants).
+// Allocations are suballocated from one persistently mapped buffer; each frame's range is tagged with the
+// fence value the GPU signals when it has consumed it and is reclaimed once that value completes.
+// Buffer creation and fence queries go through UploadBackend, so the allocator runs on the CPU in tests.
+namespace engine::render_backend
+{
+
+// A CPU-visible, GPU-readable buffer owned by the backend
+struct UploadBuffer
+{
+	std::uint64_t handle = 0; // Backend-defined identity (e.g. ID3D12Resource pointer)
+	std::uint8_t *cpuAddress = nullptr;
+	GpuAddress gpuAddress = 0;
+	std::uint64_t size = 0;
+
+	bool isValid() const noexcept { return cpuAddress != nullptr; }
+};
+
+class UploadBackend
+{
+public:
+	virtual ~UploadBackend() = default;
+
+	// Create and persistently map an upload buffer; an invalid buffer signals failure
+	virtual UploadBuffer createBuffer( std::uint64_t size ) = 0;
+	virtual void destroyBuffer( const UploadBuffer &buffer ) = 0;
+
+	// Highest fence value the GPU has completed
+	virtual std::uint64_t getCompletedFenceValue() const = 0;
+	// Block until the GPU completes the given fence value
+	virtual void waitForFenceValue( std::uint64_t value ) = 0;
+};
+
+// Null backend: buffers live in CPU memory with synthetic GPU addresses and the "GPU" completes a fence
+// when told to (or immediately when waited on). Used for headless runs and tests.
+class CpuUploadBackend final : public UploadBackend
+{
+public:
+	UploadBuffer createBuffer( std::uint64_t size ) override;
+	void destroyBuffer( const UploadBuffer &buffer ) override;
+
+	std::uint64_t getCompletedFenceValue() const override { return m_completedFenceValue; }
+	void waitForFenceValue( std::uint64_t value ) override;
+
+	// Simulate GPU progress
+	void completeFenceValue( std::uint64_t value ) noexcept;
+
+	std::size_t getLiveBufferCount() const noexcept { return m_buffers.size(); }
+	std::uint32_t getCreatedBufferCount() const noexcept { return m_createdBuffers; }
+	std::uint32_t getWaitCount() const noexcept { return m_waits; }
+
+private:
+	std::unordered_map<std::uint64_t, std::unique_ptr<std::uint8_t[]>> m_buffers;
+	std::uint64_t m_nextHandle = 1;
+	GpuAddress m_nextGpuAddress = 0x10000;
+	std::uint64_t m_completedFenceValue = 0;
+	std::uint32_t m_createdBuffers = 0;
+	std::uint32_t m_waits = 0;
+};
+
+// One suballocation; cpuAddress is write-only mapped memory valid until the frame's fence completes
+struct UploadAllocation
+{
+	std::uint8_t *cpuAddress = nullptr;
+	GpuAddress gpuAddress = 0;
+	std::uint64_t offset = 0;
+	std::uint64_t size = 0;
+
+	bool isValid() const noexcept { return cpuAddress != nullptr; }
+};
+
+struct UploadRingStats
+{
+	std::uint32_t allocations = 0;
+	std::uint64_t bytesRequested = 0; // Payload bytes
+	std::uint64_t bytesConsumed = 0;  // Including alignment padding and space skipped at the wrap point
+	std::uint32_t stalls = 0;		  // Waits on an in-flight frame's fence to free space
+	std::uint32_t growths = 0;		  // Ring buffer reallocations
+	std::uint32_t failures = 0;		  // Requests that could not be served
+};
+
+class UploadRingAllocator
+{
+public:
+	static constexpr std::uint64_t kDefaultCapacity = 4ull * 1024 * 1024;
+	static constexpr std::uint64_t kDefaultAlignment = 16;
+	static constexpr std::uint64_t kConstantBufferAlignment = 256;
+
+	explicit UploadRingAllocator( UploadBackend &backend, std::uint64_t initialCapacity = kDefaultCapacity );
+	// Releases all buffers; the caller must ensure the GPU no longer reads them
+	~UploadRingAllocator();
+
+	UploadRingAllocator( const UploadRingAllocator & ) = delete;
+	UploadRingAllocator &operator=( const UploadRingAllocator & ) = delete;
+
+	// Upper bound for growth (0 = unlimited). Without room to grow, allocation waits for older frames instead.
+	void setMaxCapacity( std::uint64_t maxCapacity ) noexcept { m_maxCapacity = maxCapacity; }
+
+	// Reclaim frames and retired buffers whose fences have completed
+	void beginFrame();
+
+	// Suballocate size bytes at a power-of-two alignment. When the ring is full, completed frames are retired
+	// first, then the ring doubles (up to the max capacity), and only then does it wait on in-flight frames
+	// (a stall). No resource is created per call in steady state. Returns an invalid allocation on failure.
+	UploadAllocation allocate( std::uint64_t size, std::uint64_t alignment = kDefaultAlignment );
+
+	// Allocate and copy
+	UploadAllocation upload( const void *data, std::uint64_t size, std::uint64_t alignment = kDefaultAlignment );
+	template <typename T>
+	UploadAllocation upload( std::span<const T> data, std::uint64_t alignment = alignof( T ) > kDefaultAlignment ? alignof( T ) : kDefaultAlignment )
+	{
+		return upload( data.data(), data.size_bytes(), alignment );
+	}
+
+	// Close the frame: its allocations are reclaimed once the GPU completes fenceValue. Frame stats roll over here.
+	void endFrame( std::uint64_t fenceValue );
+
+	std::uint64_t getCapacity() const noexcept { return m_buffer.size; }
+	std::uint64_t getUsedBytes() const noexcept { return m_used; }
+	std::size_t getInFlightFrameCount() const noexcept { return m_inFlight.size(); }
+	const UploadBuffer &getBuffer() const noexcept { return m_buffer; }
+
+	const UploadRingStats &getFrameStats() const noexcept { return m_frameStats; }
+	const UploadRingStats &getLastFrameStats() const noexcept { return m_lastFrameStats; }
+	std::uint64_t getPeakFrameBytes() const noexcept { return m_peakFrameBytes; }
+
+private:
+	struct FrameRecord
+	{
+		std::uint64_t fenceValue = 0;
+		std::uint64_t endHead = 0; // Ring head when the frame closed
+		std::uint64_t bytes = 0;   // Bytes consumed, including padding and wrap waste
+	};
+
+	struct RetiredBuffer
+	{
+		UploadBuffer buffer;
+		std::uint64_t fenceValue = 0;
+		bool awaitingFence = true; // Still used by the open frame; fence assigned at endFrame
+	};
+
+	UploadBackend &m_backend;
+	UploadBuffer m_buffer;
+	std::uint64_t m_maxCapacity = 0;
+
+	// Used region is [tail, head) modulo capacity; m_used disambiguates empty from full
+	std::uint64_t m_head = 0;
+	std::uint64_t m_tail = 0;
+	std::uint64_t m_used = 0;
+	std::uint64_t m_openFrameBytes = 0;
+
+	std::deque<FrameRecord> m_inFlight;
+	std::vector<RetiredBuffer> m_retiredBuffers;
+
+	UploadRingStats m_frameStats;
+	UploadRingStats m_lastFrameStats;
+	std::uint64_t m_peakFrameBytes = 0;
+
+	bool tryAllocate( std::uint64_t size, std::uint64_t alignment, std::uint64_t &offset ) noexcept;
+	void retireCompleted();
+	void retireOldest();
+	bool grow( std::uint64_t minimumSize );
+};
+
+} // namespace engine::render_backend
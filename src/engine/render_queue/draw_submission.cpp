@@ -0,0 +1,139 @@
+#include "engine/render_queue/draw_submission.h"
+
+namespace engine
+{
+
+namespace
+{
+bool sameVertexBuffer( const render_backend::VertexBufferView &a, const render_backend::VertexBufferView &b ) noexcept
+{
+	return a.gpuAddress == b.gpuAddress && a.sizeInBytes == b.sizeInBytes && a.strideInBytes == b.strideInBytes;
+}
+
+bool sameIndexBuffer( const render_backend::IndexBufferView &a, const render_backend::IndexBufferView &b ) noexcept
+{
+	return a.gpuAddress == b.gpuAddress && a.sizeInBytes == b.sizeInBytes && a.format == b.format;
+}
+
+// State callbacks shared by per-object and instanced submission
+struct StateBinder
+{
+	const DrawStateTables &tables;
+	render_backend::CommandRecorder &recorder;
+	// The pipeline variant this submission's draws were built for
+	const std::vector<render_backend::PipelineHandle> &pipelines;
+	// Geometry from a shared pool differs only in draw offsets, so its buffers are bound once
+	const GeometryBinding *boundGeometry = nullptr;
+	// Format constants last uploaded; the defaults stand for "nothing uploaded", which standard geometry needs
+	VertexFormatConstants boundVertexFormat;
+
+	void setPipeline( std::uint32_t id ) { recorder.setPipelineState( pipelines[id] ); }
+
+	void setMaterial( std::uint32_t id )
+	{
+		const auto address = tables.materialConstants[id];
+		if ( address != 0 )
+		{
+			recorder.setRootConstantBuffer( mesh_root_parameter::kMaterialConstants, address );
+		}
+	}
+
+	void setGeometry( std::uint32_t id )
+	{
+		const auto &geometry = tables.geometries[id];
+		if ( !boundGeometry || !sameVertexBuffer( boundGeometry->vertexBuffer, geometry.vertexBuffer ) )
+		{
+			recorder.setVertexBuffer( geometry.vertexBuffer );
+		}
+		if ( geometry.indexCount > 0 && ( !boundGeometry || boundGeometry->indexCount == 0 || !sameIndexBuffer( boundGeometry->indexBuffer, geometry.indexBuffer ) ) )
+		{
+			recorder.setIndexBuffer( geometry.indexBuffer );
+		}
+		if ( geometry.vertexFormat.layoutKey != 0 && geometry.vertexFormat != boundVertexFormat )
+		{
+			recorder.setRootConstants( mesh_root_parameter::kVertexFormat, sizeof( VertexFormatConstants ) / 4, &geometry.vertexFormat );
+			boundVertexFormat = geometry.vertexFormat;
+		}
+		boundGeometry = &geometry;
+	}
+
+	void drawGeometry( std::uint32_t geometryId, std::uint32_t instanceCount )
+	{
+		const auto &geometry = tables.geometries[geometryId];
+		if ( geometry.indexCount > 0 )
+		{
+			recorder.drawIndexed( geometry.indexCount, instanceCount, geometry.firstIndex, geometry.baseVertex, 0 );
+		}
+		else
+		{
+			recorder.draw( geometry.vertexCount, instanceCount, static_cast<std::uint32_t>( geometry.baseVertex ), 0 );
+		}
+	}
+};
+
+struct ObjectSubmitter : StateBinder
+{
+	std::span<const math::Mat4f> worldMatrices;
+
+	void setObject( std::uint32_t index )
+	{
+		// HLSL expects column-major matrices, our C++ matrices are row-major
+		InstanceData constants;
+		constants.worldMatrix = worldMatrices[index].transpose();
+		constants.normalMatrix = constants.worldMatrix;
+		recorder.setRootConstants( mesh_root_parameter::kObjectConstants, sizeof( InstanceData ) / 4, &constants );
+	}
+
+	void draw( const DrawCommand &command ) { drawGeometry( command.geometryId, 1 ); }
+};
+
+struct InstancedSubmitter : StateBinder
+{
+	std::uint32_t baseInstance = 0;
+
+	void drawInstanced( const InstanceBatch &batch )
+	{
+		// SV_InstanceID starts at zero for every draw, so the batch offset goes through a root constant
+		const std::uint32_t instanceOffset = baseInstance + batch.firstInstance;
+		recorder.setRootConstants( mesh_root_parameter::kInstanceOffset, 1, &instanceOffset );
+		drawGeometry( batch.geometryId, batch.instanceCount );
+	}
+};
+} // namespace
+
+void DrawStateTables::clear() noexcept
+{
+	pipelines.clear();
+	instancedPipelines.clear();
+	materialConstants.clear();
+	geometries.clear();
+}
+
+RenderQueueStats submitRenderQueue( const RenderQueue &queue,
+	const DrawStateTables &tables,
+	std::span<const math::Mat4f> objectWorldMatrices,
+	render_backend::CommandRecorder &recorder )
+{
+	ObjectSubmitter submitter{ { tables, recorder, tables.pipelines, nullptr, {} }, objectWorldMatrices };
+	return queue.submit( submitter );
+}
+
+RenderQueueStats submitInstanceBatches( const InstanceBatcher &batcher,
+	const DrawStateTables &tables,
+	render_backend::GpuAddress instanceBufferAddress,
+	std::uint32_t baseInstance,
+	render_backend::CommandRecorder &recorder )
+{
+	if ( batcher.getBatches().empty() )
+	{
+		return {};
+	}
+
+	recorder.notifyUpload( batcher.getInstances().size() * sizeof( InstanceData ) );
+	recorder.setRootShaderResource( mesh_root_parameter::kInstanceData, instanceBufferAddress );
+
+	InstancedSubmitter submitter{ { tables, recorder, tables.instancedPipelines, nullptr, {} }, baseInstance };
+	return batcher.submit( submitter );
+}
+
+} // namespace engine
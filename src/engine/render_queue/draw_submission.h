@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "engine/render_backend/command_recorder.h"
+#include "engine/render_queue/instance_batcher.h"
+#include "engine/render_queue/render_queue.h"
+#include "math/matrix.h"
+#include "math/vec.h"
+
+// Backend-neutral submission of mesh draws. Queue ids index into DrawStateTables, commands are
+// recorded through a CommandRecorder, so the same code drives D3D12 and the headless recorder.
+namespace engine
+{
+
+// Root parameter slots of the mesh root signature (MeshRenderingSystem::createRootSignature, unlit.hlsl)
+namespace mesh_root_parameter
+{
+constexpr std::uint32_t kFrameConstants = 0;	// b0 CBV
+constexpr std::uint32_t kObjectConstants = 1;	// b1 root constants (world + normal matrix)
+constexpr std::uint32_t kMaterialConstants = 2; // b2 CBV
+constexpr std::uint32_t kInstanceData = 3;		// t0, space1 root SRV
+constexpr std::uint32_t kInstanceOffset = 4;	// b3 single root constant
+constexpr std::uint32_t kVertexFormat = 5;		// b4 root constants (VertexFormatConstants)
+} // namespace mesh_root_parameter
+
+// How the layout pipelines decode a geometry's vertices (unlit.hlsl VSMainLayout). Standard-layout geometry
+// keeps the defaults; its pipelines never read them.
+struct VertexFormatConstants
+{
+	math::Vec3f positionOffset = { 0.0f, 0.0f, 0.0f }; // Packed positions: offset + snorm * scale
+	std::uint32_t layoutKey = 0;						 // assets::VertexLayout::getKey()
+	math::Vec3f positionScale = { 1.0f, 1.0f, 1.0f };
+	std::uint32_t padding = 0;
+
+	bool operator==( const VertexFormatConstants & ) const = default;
+};
+
+// Buffers and counts bound for one geometry id
+struct GeometryBinding
+{
+	render_backend::VertexBufferView vertexBuffer;
+	render_backend::IndexBufferView indexBuffer;
+	std::uint32_t vertexCount = 0;
+	std::uint32_t indexCount = 0; // 0 for non-indexed geometry
+	std::uint32_t firstIndex = 0; // Start of the drawn range, e.g. a level of detail
+	std::int32_t baseVertex = 0;  // First vertex of the geometry in a shared (pooled) vertex buffer
+	VertexFormatConstants vertexFormat;
+};
+
+// State referenced by render queue ids; entry i describes id i
+struct DrawStateTables
+{
+	// Per pipeline id, the per-object variant bound by submitRenderQueue and the variant reading the
+	// instance buffer bound by submitInstanceBatches
+	std::vector<render_backend::PipelineHandle> pipelines;
+	std::vector<render_backend::PipelineHandle> instancedPipelines;
+	std::vector<render_backend::GpuAddress> materialConstants; // 0 means nothing to bind
+	std::vector<GeometryBinding> geometries;
+
+	void clear() noexcept;
+};
+
+// One draw per queue entry with the world matrix uploaded as root constants on object change
+RenderQueueStats submitRenderQueue( const RenderQueue &queue,
+	const DrawStateTables &tables,
+	std::span<const math::Mat4f> objectWorldMatrices,
+	render_backend::CommandRecorder &recorder );
+
+// One instanced draw per batch. The caller has copied batcher.getInstances() to instanceBufferAddress
+// starting at baseInstance; the copy is reported to the recorder as an upload.
+RenderQueueStats submitInstanceBatches( const InstanceBatcher &batcher,
+	const DrawStateTables &tables,
+	render_backend::GpuAddress instanceBufferAddress,
+	std::uint32_t baseInstance,
+	render_backend::CommandRecorder &recorder );
+
+} // namespace engine
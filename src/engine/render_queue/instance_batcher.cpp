@@ -0,0 +1,51 @@
+#include "engine/render_queue/instance_batcher.h"
+
+namespace engine
+{
+
+void InstanceBatcher::clear() noexcept
+{
+	m_batches.clear();
+	m_instances.clear();
+}
+
+void InstanceBatcher::build( const RenderQueue &queue, std::span<const math::Mat4f> objectWorldMatrices )
+{
+	clear();
+	m_instances.reserve( queue.size() );
+
+	for ( std::size_t i = 0; i < queue.size(); ++i )
+	{
+		const DrawCommand &command = queue.getCommand( i );
+		if ( command.objectIndex >= objectWorldMatrices.size() )
+		{
+			continue;
+		}
+
+		const bool batchFull = !m_batches.empty() && m_maxInstancesPerBatch != 0 &&
+			m_batches.back().instanceCount >= m_maxInstancesPerBatch;
+		const bool sameState = !m_batches.empty() &&
+			m_batches.back().pipelineId == command.pipelineId &&
+			m_batches.back().materialId == command.materialId &&
+			m_batches.back().geometryId == command.geometryId;
+
+		if ( !sameState || batchFull )
+		{
+			InstanceBatch batch;
+			batch.pipelineId = command.pipelineId;
+			batch.materialId = command.materialId;
+			batch.geometryId = command.geometryId;
+			batch.firstInstance = static_cast<std::uint32_t>( m_instances.size() );
+			m_batches.push_back( batch );
+		}
+
+		// Normal matrix equals the world matrix until non-uniform scale is handled (see ObjectConstants)
+		InstanceData instance;
+		instance.worldMatrix = objectWorldMatrices[command.objectIndex].transpose();
+		instance.normalMatrix = instance.worldMatrix;
+		m_instances.push_back( instance );
+		++m_batches.back().instanceCount;
+	}
+}
+
+} // namespace engine
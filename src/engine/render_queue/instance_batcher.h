@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "engine/render_queue/render_queue.h"
+#include "math/matrix.h"
+
+// Backend-independent instancing: runs of queued draws sharing pipeline, material and geometry
+// collapse into one instanced draw whose per-instance data is packed into a contiguous array
+// ready to be copied into a GPU buffer.
+namespace engine
+{
+
+// GPU layout of one instance (matches InstanceData in unlit.hlsl).
+// Matrices are stored transposed because HLSL reads them column-major.
+struct InstanceData
+{
+	math::Mat4f worldMatrix;
+	math::Mat4f normalMatrix;
+};
+static_assert( sizeof( InstanceData ) == 128, "InstanceData must match the shader structured buffer stride" );
+
+// One instanced draw: shared state ids plus a range of the packed instance array
+struct InstanceBatch
+{
+	std::uint32_t pipelineId = 0;
+	std::uint32_t materialId = 0;
+	std::uint32_t geometryId = 0;
+	std::uint32_t firstInstance = 0;
+	std::uint32_t instanceCount = 0;
+};
+
+// Concept for batch submission visitors; state callbacks are only invoked on change
+template <typename V>
+concept InstanceBatchVisitor = requires( V &visitor, const InstanceBatch &batch, std::uint32_t id ) {
+	visitor.setPipeline( id );
+	visitor.setMaterial( id );
+	visitor.setGeometry( id );
+	visitor.drawInstanced( batch );
+};
+
+class InstanceBatcher
+{
+public:
+	void clear() noexcept;
+
+	// Group consecutive queue entries with identical pipeline, material and geometry.
+	// objectWorldMatrices is indexed by DrawCommand::objectIndex. A sorted queue gives the fewest batches;
+	// instance order within a batch follows queue order (front to back).
+	void build( const RenderQueue &queue, std::span<const math::Mat4f> objectWorldMatrices );
+
+	// Upper bound on instances per batch (0 = unlimited); larger runs are split
+	void setMaxInstancesPerBatch( std::uint32_t maxInstances ) noexcept { m_maxInstancesPerBatch = maxInstances; }
+	std::uint32_t getMaxInstancesPerBatch() const noexcept { return m_maxInstancesPerBatch; }
+
+	const std::vector<InstanceBatch> &getBatches() const noexcept { return m_batches; }
+	const std::vector<InstanceData> &getInstances() const noexcept { return m_instances; }
+
+	// One draw call per batch
+	std::uint32_t getDrawCallCount() const noexcept { return static_cast<std::uint32_t>( m_batches.size() ); }
+	std::uint32_t getInstanceCount() const noexcept { return static_cast<std::uint32_t>( m_instances.size() ); }
+
+	// Walk batches in order with redundant state elided. objectConstantUploads counts the
+	// per-batch instance offset upload.
+	template <InstanceBatchVisitor V>
+	RenderQueueStats submit( V &visitor ) const
+	{
+		RenderQueueStats stats;
+		const InstanceBatch *previous = nullptr;
+		for ( const auto &batch : m_batches )
+		{
+			if ( !previous || batch.pipelineId != previous->pipelineId )
+			{
+				visitor.setPipeline( batch.pipelineId );
+				++stats.pipelineChanges;
+			}
+			if ( !previous || batch.materialId != previous->materialId )
+			{
+				visitor.setMaterial( batch.materialId );
+				++stats.materialChanges;
+			}
+			if ( !previous || batch.geometryId != previous->geometryId )
+			{
+				visitor.setGeometry( batch.geometryId );
+				++stats.geometryChanges;
+			}
+			visitor.drawInstanced( batch );
+			++stats.objectConstantUploads;
+			++stats.drawCount;
+			previous = &batch;
+		}
+		return stats;
+	}
+
+private:
+	std::vector<InstanceBatch> m_batches;
+	std::vector<InstanceData> m_instances;
+	std::uint32_t m_maxInstancesPerBatch = 0;
+};
+
+} // namespace engine
@@ -0,0 +1,192 @@
+#include "engine/render_queue/render_queue.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <tuple>
+
+namespace engine
+{
+
+namespace sort_key
+{
+namespace
+{
+constexpr std::uint64_t fieldMask( std::uint32_t bits ) noexcept
+{
+	return ( std::uint64_t{ 1 } << bits ) - 1;
+}
+
+constexpr std::uint64_t packField( std::uint32_t value, std::uint32_t bits, std::uint32_t shift ) noexcept
+{
+	const std::uint64_t clamped = std::min<std::uint64_t>( value, fieldMask( bits ) );
+	return clamped << shift;
+}
+
+constexpr std::uint32_t unpackField( std::uint64_t key, std::uint32_t bits, std::uint32_t shift ) noexcept
+{
+	return static_cast<std::uint32_t>( ( key >> shift ) & fieldMask( bits ) );
+}
+} // namespace
+
+std::uint16_t quantizeDepth( float viewDepth ) noexcept
+{
+	// Positive IEEE floats order like their bit patterns; also rejects NaN and negatives
+	if ( !( viewDepth > 0.0f ) )
+	{
+		return 0;
+	}
+	return static_cast<std::uint16_t>( std::bit_cast<std::uint32_t>( viewDepth ) >> 16 );
+}
+
+std::uint64_t make( RenderPass pass, std::uint32_t pipelineId, std::uint32_t materialId, std::uint32_t geometryId, std::uint16_t depth ) noexcept
+{
+	return packField( static_cast<std::uint32_t>( pass ), kPassBits, kPassShift ) |
+		packField( pipelineId, kPipelineBits, kPipelineShift ) |
+		packField( materialId, kMaterialBits, kMaterialShift ) |
+		packField( geometryId, kGeometryBits, kGeometryShift ) |
+		packField( depth, kDepthBits, kDepthShift );
+}
+
+RenderPass pass( std::uint64_t key ) noexcept
+{
+	return static_cast<RenderPass>( unpackField( key, kPassBits, kPassShift ) );
+}
+
+std::uint32_t pipeline( std::uint64_t key ) noexcept
+{
+	return unpackField( key, kPipelineBits, kPipelineShift );
+}
+
+std::uint32_t material( std::uint64_t key ) noexcept
+{
+	return unpackField( key, kMaterialBits, kMaterialShift );
+}
+
+std::uint32_t geometry( std::uint64_t key ) noexcept
+{
+	return unpackField( key, kGeometryBits, kGeometryShift );
+}
+
+std::uint16_t depth( std::uint64_t key ) noexcept
+{
+	return static_cast<std::uint16_t>( unpackField( key, kDepthBits, kDepthShift ) );
+}
+} // namespace sort_key
+
+void radixSort( std::vector<SortEntry> &entries, std::vector<SortEntry> &scratch )
+{
+	const std::size_t count = entries.size();
+	if ( count < 2 )
+	{
+		return;
+	}
+
+	// Build all 8 digit histograms in a single pass over the keys
+	constexpr std::size_t kDigits = 8;
+	std::array<std::array<std::uint32_t, 256>, kDigits> histograms{};
+	for ( const auto &entry : entries )
+	{
+		for ( std::size_t digit = 0; digit < kDigits; ++digit )
+		{
+			++histograms[digit][( entry.key >> ( digit * 8 ) ) & 0xFF];
+		}
+	}
+
+	scratch.resize( count );
+	std::vector<SortEntry> *source = &entries;
+	std::vector<SortEntry> *destination = &scratch;
+
+	for ( std::size_t digit = 0; digit < kDigits; ++digit )
+	{
+		auto &histogram = histograms[digit];
+
+		// All keys share this digit: the pass would be an identity permutation
+		const std::uint32_t firstBucket = static_cast<std::uint32_t>( ( ( *source )[0].key >> ( digit * 8 ) ) & 0xFF );
+		if ( histogram[firstBucket] == count )
+		{
+			continue;
+		}
+
+		// Exclusive prefix sum to bucket offsets
+		std::uint32_t offset = 0;
+		for ( auto &bucket : histogram )
+		{
+			const std::uint32_t bucketCount = bucket;
+			bucket = offset;
+			offset += bucketCount;
+		}
+
+		for ( const auto &entry : *source )
+		{
+			( *destination )[histogram[( entry.key >> ( digit * 8 ) ) & 0xFF]++] = entry;
+		}
+		std::swap( source, destination );
+	}
+
+	if ( source != &entries )
+	{
+		entries.swap( scratch );
+	}
+}
+
+std::uint32_t StateIdMap::getId( const void *state )
+{
+	const auto [it, inserted] = m_ids.try_emplace( state, static_cast<std::uint32_t>( m_states.size() ) );
+	if ( inserted )
+	{
+		m_states.push_back( state );
+	}
+	return it->second;
+}
+
+void StateIdMap::reset() noexcept
+{
+	m_ids.clear();
+	m_states.clear();
+}
+
+void RenderQueue::clear() noexcept
+{
+	m_commands.clear();
+	m_order.clear();
+	m_saturatedDraws = 0;
+}
+
+void RenderQueue::reserve( std::size_t count )
+{
+	m_commands.reserve( count );
+	m_order.reserve( count );
+	m_scratch.reserve( count );
+}
+
+void RenderQueue::push( RenderPass pass, const DrawCommand &command, float viewDepth )
+{
+	const std::uint64_t key = sort_key::make( pass, command.pipelineId, command.materialId, command.geometryId, sort_key::quantizeDepth( viewDepth ) );
+	if ( command.pipelineId >= ( 1u << sort_key::kPipelineBits ) || command.materialId >= ( 1u << sort_key::kMaterialBits ) ||
+		command.geometryId >= ( 1u << sort_key::kGeometryBits ) )
+	{
+		++m_saturatedDraws;
+	}
+	m_order.push_back( SortEntry{ key, static_cast<std::uint32_t>( m_commands.size() ) } );
+	m_commands.push_back( command );
+}
+
+void RenderQueue::sort()
+{
+	radixSort( m_order, m_scratch );
+	if ( m_saturatedDraws == 0 )
+	{
+		return;
+	}
+
+	// The key already orders by pass and (coarsely) by state, so this pass only reorders within saturated buckets
+	std::stable_sort( m_order.begin(), m_order.end(), [this]( const SortEntry &a, const SortEntry &b ) {
+		const DrawCommand &x = m_commands[a.index];
+		const DrawCommand &y = m_commands[b.index];
+		return std::tuple( sort_key::pass( a.key ), x.pipelineId, x.materialId, x.geometryId, sort_key::depth( a.key ) ) <
+			std::tuple( sort_key::pass( b.key ), y.pipelineId, y.materialId, y.geometryId, sort_key::depth( b.key ) );
+	} );
+}
+
+} // namespace engine
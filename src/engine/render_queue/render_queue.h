@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+// Backend-independent render queue: draws are tagged with a 64-bit sort key, radix-sorted,
+// and walked with redundant state changes elided. No D3D12 types are involved so queue
+// building, sorting and submission ordering can be unit-tested and benchmarked headless.
+namespace engine
+{
+
+// Render pass a draw belongs to; lower values submit first
+enum class RenderPass : std::uint8_t
+{
+	Opaque = 0,
+	Transparent = 1,
+	Overlay = 2
+};
+
+// 64-bit sort key layout, most significant first:
+// [63..60] pass | [59..48] pipeline | [47..32] material | [31..16] geometry | [15..0] depth
+// Ids wider than their field saturate in the key. RenderQueue counts such draws and then sorts on the
+// full ids instead, so distinct states never interleave; geometry ids count every LOD level of a primitive.
+namespace sort_key
+{
+constexpr std::uint32_t kPassBits = 4;
+constexpr std::uint32_t kPipelineBits = 12;
+constexpr std::uint32_t kMaterialBits = 16;
+constexpr std::uint32_t kGeometryBits = 16;
+constexpr std::uint32_t kDepthBits = 16;
+
+constexpr std::uint32_t kDepthShift = 0;
+constexpr std::uint32_t kGeometryShift = kDepthShift + kDepthBits;
+constexpr std::uint32_t kMaterialShift = kGeometryShift + kGeometryBits;
+constexpr std::uint32_t kPipelineShift = kMaterialShift + kMaterialBits;
+constexpr std::uint32_t kPassShift = kPipelineShift + kPipelineBits;
+
+static_assert( kPassShift + kPassBits == 64, "Sort key fields must fill 64 bits" );
+
+// Monotonic 16-bit quantization of a non-negative view depth (upper bits of the IEEE representation).
+// Scale independent, so no near/far range is needed. Negative depths clamp to zero.
+std::uint16_t quantizeDepth( float viewDepth ) noexcept;
+
+std::uint64_t make( RenderPass pass, std::uint32_t pipelineId, std::uint32_t materialId, std::uint32_t geometryId, std::uint16_t depth ) noexcept;
+
+RenderPass pass( std::uint64_t key ) noexcept;
+std::uint32_t pipeline( std::uint64_t key ) noexcept;
+std::uint32_t material( std::uint64_t key ) noexcept;
+std::uint32_t geometry( std::uint64_t key ) noexcept;
+std::uint16_t depth( std::uint64_t key ) noexcept;
+} // namespace sort_key
+
+// Sort a key/value array by key with a stable LSD radix sort (8-bit digits).
+// Digits that are identical across all keys are skipped. scratch is resized as needed.
+struct SortEntry
+{
+	std::uint64_t key;
+	std::uint32_t index;
+};
+void radixSort( std::vector<SortEntry> &entries, std::vector<SortEntry> &scratch );
+
+// Assigns small dense ids to state objects (pipelines, materials, geometry) for sort keys.
+// Ids are stable until reset(); callers typically reset once per frame.
+class StateIdMap
+{
+public:
+	std::uint32_t getId( const void *state );
+	std::uint32_t size() const noexcept { return static_cast<std::uint32_t>( m_states.size() ); }
+	const void *getState( std::uint32_t id ) const noexcept { return id < m_states.size() ? m_states[id] : nullptr; }
+	void reset() noexcept;
+
+private:
+	std::unordered_map<const void *, std::uint32_t> m_ids;
+	std::vector<const void *> m_states;
+};
+
+// A single draw as seen by the queue. Ids refer to caller-side tables.
+struct DrawCommand
+{
+	std::uint32_t pipelineId = 0;
+	std::uint32_t materialId = 0;
+	std::uint32_t geometryId = 0;
+	std::uint32_t objectIndex = 0; // Per-object data (e.g. world matrix) index
+};
+
+// Number of state changes actually issued during submission
+struct RenderQueueStats
+{
+	std::uint32_t drawCount = 0;
+	std::uint32_t pipelineChanges = 0;
+	std::uint32_t materialChanges = 0;
+	std::uint32_t geometryChanges = 0;
+	std::uint32_t objectConstantUploads = 0;
+
+	std::uint32_t totalStateChanges() const noexcept { return pipelineChanges + materialChanges + geometryChanges + objectConstantUploads; }
+};
+
+// Concept for submission visitors; each callback is only invoked when the state actually changes
+template <typename V>
+concept RenderQueueVisitor = requires( V &visitor, const DrawCommand &command, std::uint32_t id ) {
+	visitor.setPipeline( id );
+	visitor.setMaterial( id );
+	visitor.setGeometry( id );
+	visitor.setObject( id );
+	visitor.draw( command );
+};
+
+class RenderQueue
+{
+public:
+	void clear() noexcept;
+	void reserve( std::size_t count );
+
+	// Queue a draw; viewDepth is the distance along the view direction (front-to-back within a state bucket)
+	void push( RenderPass pass, const DrawCommand &command, float viewDepth );
+
+	// Radix sort queued draws by key; with saturated draws queued, a stable comparison sort on the full
+	// ids (then depth) follows, so buckets sharing a saturated key field stay grouped
+	void sort();
+
+	// Draws queued since clear() whose pipeline, material or geometry id did not fit its key field
+	std::uint32_t getSaturatedDrawCount() const noexcept { return m_saturatedDraws; }
+
+	std::size_t size() const noexcept { return m_commands.size(); }
+	bool empty() const noexcept { return m_commands.empty(); }
+
+	// Draws in submission order (after sort(), otherwise insertion order)
+	const DrawCommand &getCommand( std::size_t orderIndex ) const noexcept { return m_commands[m_order[orderIndex].index]; }
+	std::uint64_t getKey( std::size_t orderIndex ) const noexcept { return m_order[orderIndex].key; }
+
+	// Walk the queue in order, invoking visitor callbacks only on state changes
+	template <RenderQueueVisitor V>
+	RenderQueueStats submit( V &visitor ) const
+	{
+		RenderQueueStats stats;
+		bool first = true;
+		DrawCommand current;
+		for ( const auto &entry : m_order )
+		{
+			const DrawCommand &command = m_commands[entry.index];
+			if ( first || command.pipelineId != current.pipelineId )
+			{
+				visitor.setPipeline( command.pipelineId );
+				++stats.pipelineChanges;
+			}
+			if ( first || command.materialId != current.materialId )
+			{
+				visitor.setMaterial( command.materialId );
+				++stats.materialChanges;
+			}
+			if ( first || command.geometryId != current.geometryId )
+			{
+				visitor.setGeometry( command.geometryId );
+				++stats.geometryChanges;
+			}
+			if ( first || command.objectIndex != current.objectIndex )
+			{
+				visitor.setObject( command.objectIndex );
+				++stats.objectConstantUploads;
+			}
+			visitor.draw( command );
+			++stats.drawCount;
+			current = command;
+			first = false;
+		}
+		return stats;
+	}
+
+private:
+	std::vector<DrawCommand> m_commands;
+	std::vector<SortEntry> m_order;
+	std::vector<SortEntry> m_scratch;
+	std::uint32_t m_saturatedDraws = 0;
+};
+
+} // namespace engine
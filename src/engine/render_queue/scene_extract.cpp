@@ -0,0 +1,151 @@
+#include "engine/render_queue/scene_extract.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "engine/mesh_lod/mesh_lod.h"
+
+namespace engine
+{
+
+void SceneExtract::clear()
+{
+	m_objects.clear();
+	m_draws.clear();
+	m_worldMatrices.clear();
+	m_bounds.clear();
+	m_tables.clear();
+	m_pipelineIds.clear();
+	m_materialIds.clear();
+	m_geometryIds.clear();
+	m_drawTarget = ~0u;
+}
+
+void SceneExtract::reserve( std::size_t objectCount )
+{
+	m_objects.reserve( objectCount );
+	m_worldMatrices.reserve( objectCount );
+	m_bounds.reserve( objectCount );
+}
+
+std::uint32_t SceneExtract::addObject( const math::Mat4f &worldMatrix, const math::BoundingBox3Df &worldBounds, float lodBias )
+{
+	ExtractedObject object;
+	object.firstDraw = static_cast<std::uint32_t>( m_draws.size() );
+	object.lodBias = lodBias;
+
+	// Largest basis vector length; columns hold the basis in the row-major world matrix
+	const math::Vec3f basis[3] = {
+		{ worldMatrix.row0.x, worldMatrix.row1.x, worldMatrix.row2.x },
+		{ worldMatrix.row0.y, worldMatrix.row1.y, worldMatrix.row2.y },
+		{ worldMatrix.row0.z, worldMatrix.row1.z, worldMatrix.row2.z }
+	};
+	object.worldScale = 0.0f;
+	for ( const auto &axis : basis )
+	{
+		object.worldScale = std::max( object.worldScale, std::sqrt( axis.x * axis.x + axis.y * axis.y + axis.z * axis.z ) );
+	}
+	const auto extent = worldBounds.max - worldBounds.min;
+	object.boundingRadius = 0.5f * std::sqrt( extent.x * extent.x + extent.y * extent.y + extent.z * extent.z );
+
+	m_drawTarget = static_cast<std::uint32_t>( m_objects.size() );
+	m_objects.push_back( object );
+	m_worldMatrices.push_back( worldMatrix );
+	m_bounds.add( worldBounds );
+	return m_drawTarget;
+}
+
+void SceneExtract::restartDraws( std::uint32_t object )
+{
+	m_objects[object].firstDraw = static_cast<std::uint32_t>( m_draws.size() );
+	m_objects[object].drawCount = 0;
+	m_drawTarget = object;
+}
+
+void SceneExtract::addDraw( const ExtractedDraw &draw )
+{
+	m_draws.push_back( draw );
+	++m_objects[m_drawTarget].drawCount;
+}
+
+std::uint32_t SceneExtract::resolvePipeline( render_backend::PipelineHandle pipeline, render_backend::PipelineHandle instancedPipeline )
+{
+	const auto [it, inserted] = m_pipelineIds.try_emplace( pipeline, static_cast<std::uint32_t>( m_tables.pipelines.size() ) );
+	if ( inserted )
+	{
+		m_tables.pipelines.push_back( pipeline );
+		m_tables.instancedPipelines.push_back( instancedPipeline );
+	}
+	return it->second;
+}
+
+std::uint32_t SceneExtract::resolveMaterial( const void *material, render_backend::GpuAddress constants )
+{
+	const auto [it, inserted] = m_materialIds.try_emplace( material, static_cast<std::uint32_t>( m_tables.materialConstants.size() ) );
+	if ( inserted )
+	{
+		m_tables.materialConstants.push_back( constants );
+	}
+	return it->second;
+}
+
+std::span<const ExtractedDraw> SceneExtract::getDraws( std::uint32_t object ) const noexcept
+{
+	const auto &entry = m_objects[object];
+	return std::span<const ExtractedDraw>( m_draws ).subspan( entry.firstDraw, entry.drawCount );
+}
+
+ViewQueueStats buildViewQueue( const SceneExtract &extract,
+	std::span<const std::uint32_t> visibleObjects,
+	const math::Mat4f &viewProjection,
+	const ViewLodParams &lod,
+	RenderQueue &queue )
+{
+	ViewQueueStats stats;
+	queue.clear();
+
+	const auto &bounds = extract.getBounds();
+	const auto &geometries = extract.getTables().geometries;
+	for ( const std::uint32_t index : visibleObjects )
+	{
+		const auto &object = extract.getObject( index );
+		if ( object.drawCount == 0 )
+		{
+			continue;
+		}
+
+		// Clip-space w of the bounds center is the view depth for perspective projections
+		const auto center = bounds.get( index ).center();
+		const float viewDepth = viewProjection.row3.x * center.x + viewProjection.row3.y * center.y +
+			viewProjection.row3.z * center.z + viewProjection.row3.w;
+
+		// LOD errors are in mesh space; measure them at the nearest point of the bounds
+		const float lodDepth = viewDepth - object.boundingRadius;
+
+		for ( const auto &draw : extract.getDraws( index ) )
+		{
+			std::uint32_t level = 0;
+			if ( lod.projectionScale > 0.0f && draw.lodCount > 1 )
+			{
+				level = mesh_lod::selectLod( draw.lodErrors, object.worldScale, lodDepth, lod.projectionScale, lod.screenErrorThreshold, object.lodBias );
+			}
+
+			// Each level is its own geometry so instancing only merges draws at the same level
+			const DrawCommand command{ draw.pipelineId, draw.materialId, draw.geometryId + level, index };
+			const auto &drawn = geometries[command.geometryId];
+			const auto &fullDetail = geometries[draw.geometryId];
+			++stats.queuedDraws;
+			stats.reducedDraws += level > 0 ? 1 : 0;
+			stats.submittedTriangles += ( drawn.indexCount > 0 ? drawn.indexCount : drawn.vertexCount ) / 3;
+			stats.fullDetailTriangles += ( fullDetail.indexCount > 0 ? fullDetail.indexCount : fullDetail.vertexCount ) / 3;
+
+			// The unlit pipeline has no blending, so every mesh draw is opaque
+			queue.push( RenderPass::Opaque, command, viewDepth );
+		}
+	}
+
+	queue.sort();
+	return stats;
+}
+
+} // namespace engine
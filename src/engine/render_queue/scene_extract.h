@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/culling/frustum_culling.h"
+#include "engine/render_queue/draw_submission.h"
+#include "engine/render_queue/render_queue.h"
+#include "math/matrix.h"
+
+// Frame work split into a scene extract and per-view stages. The extract runs once per frame and holds
+// everything that does not depend on the camera: world matrices, world bounds, LOD scale and each
+// draw's resolved pipeline/material/geometry ids with the state tables they index. Every view then
+// culls the extracted bounds and builds and sorts its own queue from the shared draws, so extra
+// viewports of the same scene only pay for cull, sort and submit.
+namespace engine
+{
+
+// One drawable primitive of an extracted object, with its state already resolved to table ids
+struct ExtractedDraw
+{
+	std::uint32_t pipelineId = 0;
+	std::uint32_t materialId = 0;
+	std::uint32_t geometryId = 0;	  // Level 0; level L uses geometryId + L
+	std::uint32_t lodCount = 1;
+	std::span<const float> lodErrors; // Mesh-space error per level; must outlive the extract
+};
+
+struct ExtractedObject
+{
+	std::uint32_t firstDraw = 0;
+	std::uint32_t drawCount = 0;
+	float lodBias = 0.0f;
+	float worldScale = 1.0f;	 // Largest basis vector length of the world matrix
+	float boundingRadius = 0.0f; // Half the diagonal of the world bounds
+};
+
+// LOD selection inputs of one view; a zero projectionScale draws level 0 everywhere
+struct ViewLodParams
+{
+	float projectionScale = 0.0f; // projection.row1.y
+	float screenErrorThreshold = 1.0f / 1080.0f;
+};
+
+struct ViewQueueStats
+{
+	std::uint32_t queuedDraws = 0;
+	std::uint32_t reducedDraws = 0; // Draws using a level coarser than full detail
+	std::uint64_t submittedTriangles = 0;
+	std::uint64_t fullDetailTriangles = 0; // Triangles had every draw used level 0
+};
+
+class SceneExtract
+{
+public:
+	// Start a new frame; ids and tables are rebuilt from scratch
+	void clear();
+	void reserve( std::size_t objectCount );
+
+	// Add a renderable and return its object index. Draws added next belong to it.
+	std::uint32_t addObject( const math::Mat4f &worldMatrix, const math::BoundingBox3Df &worldBounds, float lodBias );
+
+	// Start a fresh, empty draw range for an existing object (e.g. its geometry became resident after extraction).
+	// Draws added next belong to it; the previous range is abandoned.
+	void restartDraws( std::uint32_t object );
+	void addDraw( const ExtractedDraw &draw );
+
+	// Dense table ids; a state seen for the first time appends its table entry. A pipeline id stands for
+	// both variants of the state: per-object draws bind pipeline, instanced draws bind instancedPipeline.
+	std::uint32_t resolvePipeline( render_backend::PipelineHandle pipeline, render_backend::PipelineHandle instancedPipeline );
+	std::uint32_t resolveMaterial( const void *material, render_backend::GpuAddress constants );
+
+	// Id of the first of levelCount consecutive geometry entries keyed by geometry;
+	// makeBinding( level ) is only called the first time the key is seen this frame
+	template <typename MakeBinding>
+	std::uint32_t resolveGeometry( const void *geometry, std::uint32_t levelCount, MakeBinding &&makeBinding )
+	{
+		const auto [it, inserted] = m_geometryIds.try_emplace( geometry, static_cast<std::uint32_t>( m_tables.geometries.size() ) );
+		if ( inserted )
+		{
+			for ( std::uint32_t level = 0; level < levelCount; ++level )
+			{
+				m_tables.geometries.push_back( makeBinding( level ) );
+			}
+		}
+		return it->second;
+	}
+
+	std::uint32_t getObjectCount() const noexcept { return static_cast<std::uint32_t>( m_objects.size() ); }
+	std::uint32_t getDrawCount() const noexcept { return static_cast<std::uint32_t>( m_draws.size() ); }
+	const ExtractedObject &getObject( std::uint32_t index ) const noexcept { return m_objects[index]; }
+	std::span<const ExtractedDraw> getDraws( std::uint32_t object ) const noexcept;
+
+	const std::vector<math::Mat4f> &getWorldMatrices() const noexcept { return m_worldMatrices; }
+	const culling::BoundsSoA &getBounds() const noexcept { return m_bounds; }
+	const DrawStateTables &getTables() const noexcept { return m_tables; }
+
+private:
+	std::vector<ExtractedObject> m_objects;
+	std::vector<ExtractedDraw> m_draws;
+	std::vector<math::Mat4f> m_worldMatrices;
+	culling::BoundsSoA m_bounds;
+
+	DrawStateTables m_tables;
+	std::unordered_map<const void *, std::uint32_t> m_pipelineIds;
+	std::unordered_map<const void *, std::uint32_t> m_materialIds;
+	std::unordered_map<const void *, std::uint32_t> m_geometryIds;
+	std::uint32_t m_drawTarget = ~0u;
+};
+
+// Per-view stage: queue the draws of the visible objects with this view's depth and level of detail,
+// then sort. The queue is cleared first; object indices in the queue refer to the extract.
+ViewQueueStats buildViewQueue( const SceneExtract &extract,
+	std::span<const std::uint32_t> visibleObjects,
+	const math::Mat4f &viewProjection,
+	const ViewLodParams &lod,
+	RenderQueue &queue );
+
+} // namespace engine
@@ -0,0 +1,63 @@
+#include "engine/render_thread/render_snapshot.h"
+
+#include "engine/culling/frustum_culling.h"
+#include "engine/render_queue/draw_submission.h"
+
+namespace engine::render_thread
+{
+
+void RenderSnapshot::reset()
+{
+	frameIndex = 0;
+	scene.clear();
+	views.clear();
+}
+
+SnapshotRenderStats SnapshotRenderer::render( const RenderSnapshot &snapshot, render_backend::CommandRecorder &recorder )
+{
+	SnapshotRenderStats total;
+	for ( const auto &view : snapshot.views )
+	{
+		const auto stats = renderView( snapshot, view, recorder );
+		++total.views;
+		total.visibleObjects += stats.visibleObjects;
+		total.drawCalls += stats.drawCalls;
+		total.stateChanges += stats.stateChanges;
+	}
+	return total;
+}
+
+SnapshotRenderStats SnapshotRenderer::renderView( const RenderSnapshot &snapshot, const SnapshotView &view, render_backend::CommandRecorder &recorder )
+{
+	const auto &scene = snapshot.scene;
+	if ( view.frustumCulling )
+	{
+		const auto frustum = math::Frustum<float>::fromViewProjection( view.viewProjection );
+		culling::cullBounds( frustum, scene.getBounds(), m_visibleObjects );
+	}
+	else
+	{
+		m_visibleObjects.resize( scene.getObjectCount() );
+		for ( std::uint32_t i = 0; i < m_visibleObjects.size(); ++i )
+		{
+			m_visibleObjects[i] = i;
+		}
+	}
+
+	buildViewQueue( scene, m_visibleObjects, view.viewProjection, view.lod, m_queue );
+
+	if ( view.frameConstants != 0 )
+	{
+		recorder.setRootConstantBuffer( mesh_root_parameter::kFrameConstants, view.frameConstants );
+	}
+	const auto queueStats = submitRenderQueue( m_queue, scene.getTables(), scene.getWorldMatrices(), recorder );
+
+	SnapshotRenderStats stats;
+	stats.views = 1;
+	stats.visibleObjects = static_cast<std::uint32_t>( m_visibleObjects.size() );
+	stats.drawCalls = queueStats.drawCount;
+	stats.stateChanges = queueStats.totalStateChanges();
+	return stats;
+}
+
+} // namespace engine::render_thread
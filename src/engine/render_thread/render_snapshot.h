@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "engine/render_backend/command_recorder.h"
+#include "engine/render_queue/render_queue.h"
+#include "engine/render_queue/scene_extract.h"
+#include "math/matrix.h"
+
+// Immutable per-frame input of the render thread. The main thread fills a snapshot with the scene extract
+// (world matrices, bounds and draws with resolved pipeline/material/geometry state) and one entry per view,
+// then publishes it; the render thread culls, queues and submits each view without touching the ECS.
+// GPU objects referenced by a snapshot (buffers, pipelines, material constants, LOD error tables) must stay
+// alive and unchanged until the render thread is done with it; the editor waits for every view of a
+// snapshot before its frame ends, ahead of hot reload and residency eviction.
+namespace engine::render_thread
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct SnapshotView
+{
+	std::uint32_t viewId = 0; // Caller-defined, e.g. the viewport index
+	math::Mat4f viewProjection = math::Mat4f::identity();
+	ViewLodParams lod;
+	render_backend::GpuAddress frameConstants = 0; // Bound to the frame constant slot before the view's draws; 0 skips
+	bool frustumCulling = true;
+};
+
+struct RenderSnapshot
+{
+	std::uint64_t frameIndex = 0;
+	SceneExtract scene;
+	std::vector<SnapshotView> views;
+
+	// Drop the previous frame's contents while keeping buffer capacity
+	void reset();
+};
+
+struct SnapshotRenderStats
+{
+	std::uint32_t views = 0;
+	std::uint32_t visibleObjects = 0;
+	std::uint32_t drawCalls = 0;
+	std::uint32_t stateChanges = 0;
+};
+
+// Render-thread side of a snapshot. Owns the per-view scratch (visible lists, render queue), so one
+// instance belongs to one thread and keeps its capacity from frame to frame.
+class SnapshotRenderer
+{
+public:
+	// Cull, queue and submit every view of the snapshot, in order
+	SnapshotRenderStats render( const RenderSnapshot &snapshot, render_backend::CommandRecorder &recorder );
+
+	// Cull, queue and submit one view
+	SnapshotRenderStats renderView( const RenderSnapshot &snapshot, const SnapshotView &view, render_backend::CommandRecorder &recorder );
+
+	// Extract object indices that survived culling in the last view rendered
+	std::span<const std::uint32_t> getVisibleObjects() const noexcept { return m_visibleObjects; }
+
+private:
+	std::vector<std::uint32_t> m_visibleObjects;
+	RenderQueue m_queue;
+};
+
+} // namespace engine::render_thread
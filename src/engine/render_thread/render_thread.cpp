@@ -0,0 +1,102 @@
+#include "engine/render_thread/render_thread.h"
+
+#include <algorithm>
+
+namespace engine::render_thread
+{
+
+LatencyTracker::LatencyTracker( std::size_t windowSize ) : m_windowSize( std::max<std::size_t>( windowSize, 1 ) )
+{
+	m_window.reserve( m_windowSize );
+}
+
+void LatencyTracker::record( Clock::duration latency )
+{
+	const double ms = std::chrono::duration<double, std::milli>( latency ).count();
+	if ( m_window.size() < m_windowSize )
+	{
+		m_window.push_back( ms );
+	}
+	else
+	{
+		m_window[m_next] = ms;
+	}
+	m_next = ( m_next + 1 ) % m_windowSize;
+	m_lastMs = ms;
+	++m_samples;
+}
+
+void LatencyTracker::reset()
+{
+	m_window.clear();
+	m_next = 0;
+	m_samples = 0;
+	m_lastMs = 0.0;
+}
+
+LatencyStats LatencyTracker::getStats() const
+{
+	LatencyStats stats;
+	stats.samples = m_samples;
+	stats.lastMs = m_lastMs;
+	if ( m_window.empty() )
+	{
+		return stats;
+	}
+
+	double sum = 0.0;
+	for ( const double ms : m_window )
+	{
+		sum += ms;
+		stats.maxMs = std::max( stats.maxMs, ms );
+	}
+	stats.averageMs = sum / static_cast<double>( m_window.size() );
+
+	auto sorted = m_window;
+	const std::size_t rank = ( sorted.size() * 95 + 99 ) / 100 - 1; // Nearest-rank percentile
+	std::nth_element( sorted.begin(), sorted.begin() + rank, sorted.end() );
+	stats.p95Ms = sorted[rank];
+	return stats;
+}
+
+RenderThread::RenderThread( SnapshotQueue<RenderSnapshot> &queue, RenderFunction render )
+	: m_queue( queue ), m_render( std::move( render ) )
+{
+}
+
+RenderThread::~RenderThread()
+{
+	stop();
+}
+
+void RenderThread::start()
+{
+	if ( !m_thread.joinable() )
+	{
+		m_thread = std::thread( [this] { run(); } );
+	}
+}
+
+void RenderThread::stop()
+{
+	m_queue.close();
+	if ( m_thread.joinable() )
+	{
+		m_thread.join();
+	}
+}
+
+void RenderThread::run()
+{
+	while ( const RenderSnapshot *snapshot = m_queue.acquire() )
+	{
+		if ( m_render )
+		{
+			m_render( *snapshot );
+		}
+		m_queue.release();
+		m_framesRendered.fetch_add( 1, std::memory_order_relaxed );
+	}
+}
+
+} // namespace engine::render_thread
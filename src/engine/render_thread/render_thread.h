@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "engine/render_thread/render_snapshot.h"
+#include "engine/render_thread/snapshot_queue.h"
+
+// Dedicated render thread: consumes published RenderSnapshots in order and runs a render function on each
+// (record, submit, present), while the main thread already builds the next snapshot.
+namespace engine::render_thread
+{
+
+struct LatencyStats
+{
+	std::uint64_t samples = 0; // Total recorded, not just the window
+	double lastMs = 0.0;
+	double averageMs = 0.0; // Over the window
+	double maxMs = 0.0;		// Over the window
+	double p95Ms = 0.0;		// Over the window
+};
+
+// Rolling latency statistics over the most recent samples, e.g. input to present. Not thread-safe.
+class LatencyTracker
+{
+public:
+	explicit LatencyTracker( std::size_t windowSize = 120 );
+
+	void record( Clock::duration latency );
+	void record( Clock::time_point start, Clock::time_point end ) { record( end - start ); }
+	void reset();
+
+	LatencyStats getStats() const;
+
+private:
+	std::vector<double> m_window; // Milliseconds, ring of the last windowSize samples
+	std::size_t m_windowSize = 0;
+	std::size_t m_next = 0;
+	std::uint64_t m_samples = 0;
+	double m_lastMs = 0.0;
+};
+
+class RenderThread
+{
+public:
+	using RenderFunction = std::function<void( const RenderSnapshot & )>;
+
+	RenderThread( SnapshotQueue<RenderSnapshot> &queue, RenderFunction render );
+	// Stops the thread if it is still running
+	~RenderThread();
+
+	RenderThread( const RenderThread & ) = delete;
+	RenderThread &operator=( const RenderThread & ) = delete;
+
+	void start();
+	// Close the queue, let the thread finish the snapshots already published and join it
+	void stop();
+	bool isRunning() const noexcept { return m_thread.joinable(); }
+
+	std::uint64_t getFramesRendered() const noexcept { return m_framesRendered.load( std::memory_order_relaxed ); }
+
+private:
+	SnapshotQueue<RenderSnapshot> &m_queue;
+	RenderFunction m_render;
+	std::thread m_thread;
+	std::atomic<std::uint64_t> m_framesRendered = 0;
+
+	void run();
+};
+
+} // namespace engine::render_thread
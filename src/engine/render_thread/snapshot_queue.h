@@ -0,0 +1,185 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Hand-off of per-frame snapshots from the main thread (producer) to the render thread (consumer) through a
+// fixed set of reusable buffers, so neither side allocates per frame and a buffer is never written while it
+// is read. With two buffers the producer fills one while the consumer reads the other; a third lets a
+// finished snapshot wait while both threads are busy.
+namespace engine::render_thread
+{
+
+enum class SnapshotPolicy : std::uint8_t
+{
+	Queue, // Every snapshot is consumed in order; the producer waits when all buffers are in use
+	Latest // The producer never waits; a snapshot still waiting when a newer one needs its buffer is dropped
+};
+
+struct SnapshotQueueStats
+{
+	std::uint64_t published = 0;
+	std::uint64_t consumed = 0;
+	std::uint64_t dropped = 0;		 // Latest policy only
+	std::uint64_t producerWaits = 0; // beginWrite() blocked on the consumer
+	std::uint64_t consumerWaits = 0; // acquire() blocked on the producer
+};
+
+template <typename T>
+class SnapshotQueue
+{
+public:
+	explicit SnapshotQueue( std::uint32_t bufferCount = 3, SnapshotPolicy policy = SnapshotPolicy::Queue )
+		: m_buffers( bufferCount < 2 ? 2 : bufferCount ), m_policy( policy )
+	{
+		for ( std::uint32_t i = 0; i < m_buffers.size(); ++i )
+		{
+			m_free.push_back( i );
+		}
+	}
+
+	SnapshotQueue( const SnapshotQueue & ) = delete;
+	SnapshotQueue &operator=( const SnapshotQueue & ) = delete;
+
+	// Producer: buffer to fill for the next frame, holding whatever an earlier frame left in it (reuse its
+	// capacity, reset its contents). Null once the queue is closed. Call publish() before the next beginWrite().
+	T *beginWrite()
+	{
+		std::unique_lock lock( m_mutex );
+		if ( m_free.empty() && m_policy == SnapshotPolicy::Latest && !m_ready.empty() )
+		{
+			m_free.push_back( m_ready.front() );
+			m_ready.pop_front();
+			++m_stats.dropped;
+		}
+		if ( m_free.empty() && !m_closed )
+		{
+			++m_stats.producerWaits;
+			m_producerCondition.wait( lock, [this] { return !m_free.empty() || m_closed; } );
+		}
+		if ( m_closed )
+		{
+			return nullptr;
+		}
+		m_writing = m_free.front();
+		m_free.pop_front();
+		return &m_buffers[m_writing];
+	}
+
+	// Producer: hand the written buffer to the consumer
+	void publish()
+	{
+		{
+			std::lock_guard lock( m_mutex );
+			if ( m_writing == kNone )
+			{
+				return;
+			}
+			m_ready.push_back( m_writing );
+			m_writing = kNone;
+			++m_stats.published;
+		}
+		m_consumerCondition.notify_one();
+	}
+
+	// Consumer: oldest published snapshot, waiting for one if necessary. Null once the queue is closed and
+	// drained. The snapshot stays valid until release().
+	const T *acquire()
+	{
+		std::unique_lock lock( m_mutex );
+		if ( m_ready.empty() && !m_closed )
+		{
+			++m_stats.consumerWaits;
+			m_consumerCondition.wait( lock, [this] { return !m_ready.empty() || m_closed; } );
+		}
+		return takeReady();
+	}
+
+	// Consumer: like acquire() but returns null instead of waiting
+	const T *tryAcquire()
+	{
+		std::lock_guard lock( m_mutex );
+		return takeReady();
+	}
+
+	// Consumer: done with the acquired snapshot; its buffer goes back to the producer
+	void release()
+	{
+		{
+			std::lock_guard lock( m_mutex );
+			if ( m_reading == kNone )
+			{
+				return;
+			}
+			m_free.push_back( m_reading );
+			m_reading = kNone;
+			++m_stats.consumed;
+		}
+		m_producerCondition.notify_one();
+	}
+
+	// Wake both sides; beginWrite() returns null from now on, acquire() once the published snapshots are consumed
+	void close()
+	{
+		{
+			std::lock_guard lock( m_mutex );
+			m_closed = true;
+		}
+		m_producerCondition.notify_all();
+		m_consumerCondition.notify_all();
+	}
+
+	bool isClosed() const
+	{
+		std::lock_guard lock( m_mutex );
+		return m_closed;
+	}
+
+	std::uint32_t getBufferCount() const noexcept { return static_cast<std::uint32_t>( m_buffers.size() ); }
+	SnapshotPolicy getPolicy() const noexcept { return m_policy; }
+
+	// Published snapshots not yet acquired
+	std::size_t getPendingCount() const
+	{
+		std::lock_guard lock( m_mutex );
+		return m_ready.size();
+	}
+
+	SnapshotQueueStats getStats() const
+	{
+		std::lock_guard lock( m_mutex );
+		return m_stats;
+	}
+
+private:
+	static constexpr std::uint32_t kNone = ~0u;
+
+	std::vector<T> m_buffers;
+	SnapshotPolicy m_policy;
+	std::deque<std::uint32_t> m_free;
+	std::deque<std::uint32_t> m_ready; // Oldest first
+	std::uint32_t m_writing = kNone;
+	std::uint32_t m_reading = kNone;
+	bool m_closed = false;
+	SnapshotQueueStats m_stats;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_producerCondition;
+	std::condition_variable m_consumerCondition;
+
+	const T *takeReady()
+	{
+		if ( m_ready.empty() || m_reading != kNone )
+		{
+			return nullptr;
+		}
+		m_reading = m_ready.front();
+		m_ready.pop_front();
+		return &m_buffers[m_reading];
+	}
+};
+
+} // namespace engine::render_thread
@@ -0,0 +1,81 @@
+#include "engine/render_thread/view_command_streams.h"
+
+#include <algorithm>
+
+namespace engine::render_thread
+{
+
+bool ViewCommandStreams::begin( std::size_t viewCount )
+{
+	std::unique_lock lock( m_mutex );
+	m_condition.wait( lock, [this] { return m_closed || std::ranges::find( m_states, State::Pending ) == m_states.end(); } );
+	if ( m_closed )
+	{
+		return false;
+	}
+	if ( m_streams.size() < viewCount )
+	{
+		m_streams.resize( viewCount );
+	}
+	m_states.assign( m_streams.size(), State::Idle );
+	for ( std::size_t i = 0; i < viewCount; ++i )
+	{
+		m_streams[i].commands.reset();
+		m_streams[i].visibleObjects.clear();
+		m_streams[i].stats = {};
+		m_states[i] = State::Pending;
+	}
+	return true;
+}
+
+void ViewCommandStreams::record( SnapshotRenderer &renderer, const RenderSnapshot &snapshot, std::size_t index )
+{
+	// Only the render thread touches a pending stream, and begin() does not resize while any is pending
+	ViewCommandStream *stream = nullptr;
+	{
+		std::lock_guard lock( m_mutex );
+		if ( index >= m_states.size() || m_states[index] != State::Pending )
+		{
+			return;
+		}
+		stream = &m_streams[index];
+	}
+
+	stream->stats = renderer.renderView( snapshot, snapshot.views[index], stream->commands );
+	const auto visible = renderer.getVisibleObjects();
+	stream->visibleObjects.assign( visible.begin(), visible.end() );
+
+	{
+		std::lock_guard lock( m_mutex );
+		m_states[index] = State::Recorded;
+	}
+	m_condition.notify_all();
+}
+
+const ViewCommandStream *ViewCommandStreams::wait( std::size_t index )
+{
+	std::unique_lock lock( m_mutex );
+	m_condition.wait( lock, [this, index] { return m_closed || index >= m_states.size() || m_states[index] != State::Pending; } );
+	if ( index >= m_states.size() || m_states[index] != State::Recorded )
+	{
+		return nullptr;
+	}
+	return &m_streams[index];
+}
+
+void ViewCommandStreams::waitAll()
+{
+	std::unique_lock lock( m_mutex );
+	m_condition.wait( lock, [this] { return m_closed || std::ranges::find( m_states, State::Pending ) == m_states.end(); } );
+}
+
+void ViewCommandStreams::close()
+{
+	{
+		std::lock_guard lock( m_mutex );
+		m_closed = true;
+	}
+	m_condition.notify_all();
+}
+
+} // namespace engine::render_thread
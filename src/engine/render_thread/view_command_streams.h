@@ -0,0 +1,66 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "engine/render_backend/recording_command_recorder.h"
+#include "engine/render_thread/render_snapshot.h"
+
+// Hand-back of recorded views from the render thread to the main thread. The render thread culls, queues and
+// submits each view of a snapshot into a capturing RecordingCommandRecorder; the main thread, which owns the
+// frame's command list, waits for a view's stream where that view's pass runs and replays it there. Views
+// are handed back one at a time, so the main thread replays view 0 while view 1 is still being recorded.
+namespace engine::render_thread
+{
+
+struct ViewCommandStream
+{
+	render_backend::RecordingCommandRecorder commands{ true };
+	std::vector<std::uint32_t> visibleObjects; // Extract object indices that survived culling
+	SnapshotRenderStats stats;
+};
+
+class ViewCommandStreams
+{
+public:
+	ViewCommandStreams() = default;
+
+	ViewCommandStreams( const ViewCommandStreams & ) = delete;
+	ViewCommandStreams &operator=( const ViewCommandStreams & ) = delete;
+
+	// Main thread, before publishing a snapshot of viewCount views: waits until the render thread is done
+	// with the previous snapshot's streams, then empties the first viewCount for recording. False once closed.
+	bool begin( std::size_t viewCount );
+
+	// Render thread: record view index of the snapshot into its stream, then hand it back
+	void record( SnapshotRenderer &renderer, const RenderSnapshot &snapshot, std::size_t index );
+
+	// Main thread: block until view index is recorded; null if it never will be (closed, or not begun)
+	const ViewCommandStream *wait( std::size_t index );
+
+	// Main thread: block until the render thread is done with every begun view, replayed or not
+	void waitAll();
+
+	// Wake every waiter for good; streams still pending are reported as never recorded
+	void close();
+
+private:
+	enum class State : std::uint8_t
+	{
+		Idle,
+		Pending,
+		Recorded
+	};
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<ViewCommandStream> m_streams; // Deque: growing never moves a stream the render thread is recording
+	std::vector<State> m_states;
+	bool m_closed = false;
+};
+
+} // namespace engine::render_thread
@@ -7,6 +7,8 @@
 
 #include "runtime/console.h"
 
+using engine::render_backend::UploadRingAllocator;
+
 namespace renderer
 {
 
@@ -409,21 +411,16 @@ void IndexBuffer::update( const std::vector<uint16_t> &indices )
 
 // Renderer implementation
 Renderer::Renderer( dx12::Device &device )
-	: m_device( device )
+	: m_device( device ), m_uploadBackend( device ), m_uploadRing( m_uploadBackend, kUploadRingCapacity )
 {
 	createRootSignature();
 	compileDefaultShaders();
-	createConstantBuffer();
 }
 
 Renderer::~Renderer()
 {
+	// The upload ring releases its buffers after this
 	waitForGPU();
-
-	if ( m_constantBuffer && m_constantBufferData )
-	{
-		m_constantBuffer->Unmap( 0, nullptr );
-	}
 }
 
 void Renderer::createRootSignature()
@@ -545,37 +542,6 @@ void Renderer::ensurePipelineForCurrentState( D3D12_PRIMITIVE_TOPOLOGY_TYPE topo
 	m_activePipelineState = it->second;
 }
 
-void Renderer::createConstantBuffer()
-{
-	const UINT constantBufferSize = ( sizeof( math::Mat4<> ) + 255 ) & ~255; // Align to 256 bytes
-
-	D3D12_HEAP_PROPERTIES heapProps = {};
-	heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-
-	D3D12_RESOURCE_DESC resourceDesc = {};
-	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-	resourceDesc.Width = constantBufferSize;
-	resourceDesc.Height = 1;
-	resourceDesc.DepthOrArraySize = 1;
-	resourceDesc.MipLevels = 1;
-	resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
-	resourceDesc.SampleDesc.Count = 1;
-	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-	dx12::throwIfFailed( m_device->CreateCommittedResource(
-		&heapProps,
-		D3D12_HEAP_FLAG_NONE,
-		&resourceDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS( &m_constantBuffer ) ) );
-
-	// Map the constant buffer
-	D3D12_RANGE readRange = { 0, 0 };
-	dx12::throwIfFailed( m_constantBuffer->Map( 0, &readRange, &m_constantBufferData ) );
-}
-
-
 void Renderer::beginFrame()
 {
 	// Validate that beginFrame hasn't already been called
@@ -605,9 +571,11 @@ void Renderer::beginFrame()
 	// Mark that we're now in a frame
 	m_inFrame = true;
 
-	// Now it's safe to delete any pending buffers since the command list has been executed
-	m_pendingVertexBufferDeletions.clear();
-	m_pendingIndexBufferDeletions.clear();
+	// Reclaim upload ring space from frames the GPU has finished
+	m_uploadRing.beginFrame();
+	m_frameConstantsAddress = 0;
+	m_debugBatchTaken = false;
+	m_debugVertexBuffer = {};
 
 	// Use actual SwapChain dimensions instead of hardcoded values
 	D3D12_VIEWPORT viewport = {};
@@ -652,6 +620,13 @@ void Renderer::endFrame()
 		return;
 	}
 
+	// Views normally draw the debug batch from their scene pass; this only catches frames where none did
+	flushDebugDraw();
+
+	// Transient uploads from this frame are reclaimed once the GPU passes the frame fence
+	m_uploadRing.endFrame( m_device.getCurrentFenceValue() );
+	m_frameConstantsAddress = 0;
+
 	// Reset renderer state (Device::endFrame should be called by caller)
 	m_currentContext = nullptr;
 	m_currentSwapChain = nullptr;
@@ -682,15 +657,43 @@ void Renderer::clearDepth( float depth ) noexcept
 void Renderer::setViewProjectionMatrix( const math::Mat4<> &viewProj ) noexcept
 {
 	m_viewProjectionMatrix = viewProj;
-	updateConstantBuffer();
+	// Earlier draws keep their own copy; the next draw uploads the new matrix
+	m_frameConstantsAddress = 0;
 }
 
-void Renderer::updateConstantBuffer()
+D3D12_GPU_VIRTUAL_ADDRESS Renderer::getFrameConstantsAddress()
 {
-	if ( m_constantBufferData )
+	if ( m_frameConstantsAddress == 0 )
 	{
-		memcpy( m_constantBufferData, &m_viewProjectionMatrix, sizeof( math::Mat4<> ) );
+		m_frameConstantsAddress = uploadViewProjection( m_viewProjectionMatrix );
 	}
+	return m_frameConstantsAddress;
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS Renderer::uploadViewProjection( const math::Mat4<> &viewProjection )
+{
+	const auto allocation = m_uploadRing.allocate( UploadRingAllocator::kConstantBufferAlignment, UploadRingAllocator::kConstantBufferAlignment );
+	if ( !allocation.isValid() )
+	{
+		return 0;
+	}
+	memcpy( allocation.cpuAddress, &viewProjection, sizeof( math::Mat4<> ) );
+	return allocation.gpuAddress;
+}
+
+D3D12_VERTEX_BUFFER_VIEW Renderer::uploadVertices( const std::vector<Vertex> &vertices )
+{
+	D3D12_VERTEX_BUFFER_VIEW view = {};
+	const auto allocation = m_uploadRing.upload( std::span<const Vertex>( vertices ) );
+	if ( !allocation.isValid() )
+	{
+		console::error( "Renderer: upload ring could not allocate {} vertices", vertices.size() );
+		return view;
+	}
+	view.BufferLocation = allocation.gpuAddress;
+	view.SizeInBytes = static_cast<UINT>( allocation.size );
+	view.StrideInBytes = sizeof( Vertex );
+	return view;
 }
 
 
@@ -706,26 +709,14 @@ void Renderer::drawVertices( const std::vector<Vertex> &vertices, D3D_PRIMITIVE_
 	if ( vertices.empty() )
 		return;
 
-	// In headless mode (no swap chain), skip actual drawing but still update buffers for testing
+	// In headless mode (no swap chain), skip actual drawing but still upload for testing
 	const bool isHeadless = !m_currentSwapChain;
 
-	// Update or create dynamic vertex buffer
-	if ( !m_dynamicVertexBuffer || m_dynamicVertexBuffer->getVertexCount() < vertices.size() )
-	{
-		// If we have an existing buffer, defer its deletion until frame end
-		if ( m_dynamicVertexBuffer )
-		{
-			m_pendingVertexBufferDeletions.push_back( std::move( m_dynamicVertexBuffer ) );
-		}
-		m_dynamicVertexBuffer = std::make_unique<VertexBuffer>( m_device, vertices );
-	}
-	else
-	{
-		m_dynamicVertexBuffer->update( vertices );
-	}
+	const D3D12_VERTEX_BUFFER_VIEW vbv = uploadVertices( vertices );
+	const D3D12_GPU_VIRTUAL_ADDRESS constants = getFrameConstantsAddress();
 
 	// Skip drawing in headless mode (no render targets available)
-	if ( isHeadless )
+	if ( isHeadless || vbv.BufferLocation == 0 || constants == 0 )
 	{
 		return;
 	}
@@ -734,13 +725,12 @@ void Renderer::drawVertices( const std::vector<Vertex> &vertices, D3D_PRIMITIVE_
 	ensurePipelineForCurrentState( topologyToTopologyType( topology ) );
 	( *m_currentContext )->SetPipelineState( m_activePipelineState.Get() );
 	( *m_currentContext )->SetGraphicsRootSignature( m_rootSignature.Get() );
-	( *m_currentContext )->SetGraphicsRootConstantBufferView( 0, m_constantBuffer->GetGPUVirtualAddress() );
+	( *m_currentContext )->SetGraphicsRootConstantBufferView( 0, constants );
 
 	// Set primitive topology
 	( *m_currentContext )->IASetPrimitiveTopology( topology );
 
 	// Set vertex buffer and draw
-	const D3D12_VERTEX_BUFFER_VIEW vbv = m_dynamicVertexBuffer->getView();
 	( *m_currentContext )->IASetVertexBuffers( 0, 1, &vbv );
 	( *m_currentContext )->DrawInstanced( static_cast<UINT>( vertices.size() ), 1, 0, 0 );
 }
@@ -750,40 +740,22 @@ void Renderer::drawIndexed( const std::vector<Vertex> &vertices, const std::vect
 	if ( vertices.empty() || indices.empty() )
 		return;
 
-	// In headless mode (no swap chain), skip actual drawing but still update buffers for testing
+	// In headless mode (no swap chain), skip actual drawing but still upload for testing
 	const bool isHeadless = !m_currentSwapChain;
 
-	// Update buffers
-	if ( !m_dynamicVertexBuffer || m_dynamicVertexBuffer->getVertexCount() < vertices.size() )
-	{
-		// If we have an existing buffer, defer its deletion until frame end
-		if ( m_dynamicVertexBuffer )
-		{
-			m_pendingVertexBufferDeletions.push_back( std::move( m_dynamicVertexBuffer ) );
-		}
-		m_dynamicVertexBuffer = std::make_unique<VertexBuffer>( m_device, vertices );
-	}
-	else
+	const D3D12_VERTEX_BUFFER_VIEW vbv = uploadVertices( vertices );
+	D3D12_INDEX_BUFFER_VIEW ibv = {};
+	const auto indexAllocation = m_uploadRing.upload( std::span<const uint16_t>( indices ) );
+	if ( indexAllocation.isValid() )
 	{
-		m_dynamicVertexBuffer->update( vertices );
-	}
-
-	if ( !m_dynamicIndexBuffer || m_dynamicIndexBuffer->getIndexCount() < indices.size() )
-	{
-		// If we have an existing buffer, defer its deletion until frame end
-		if ( m_dynamicIndexBuffer )
-		{
-			m_pendingIndexBufferDeletions.push_back( std::move( m_dynamicIndexBuffer ) );
-		}
-		m_dynamicIndexBuffer = std::make_unique<IndexBuffer>( m_device, indices );
-	}
-	else
-	{
-		m_dynamicIndexBuffer->update( indices );
+		ibv.BufferLocation = indexAllocation.gpuAddress;
+		ibv.SizeInBytes = static_cast<UINT>( indexAllocation.size );
+		ibv.Format = DXGI_FORMAT_R16_UINT;
 	}
+	const D3D12_GPU_VIRTUAL_ADDRESS constants = getFrameConstantsAddress();
 
 	// Skip drawing in headless mode (no render targets available)
-	if ( isHeadless )
+	if ( isHeadless || vbv.BufferLocation == 0 || ibv.BufferLocation == 0 || constants == 0 )
 	{
 		return;
 	}
@@ -792,12 +764,10 @@ void Renderer::drawIndexed( const std::vector<Vertex> &vertices, const std::vect
 	ensurePipelineForCurrentState( topologyToTopologyType( topology ) );
 	( *m_currentContext )->SetPipelineState( m_activePipelineState.Get() );
 	( *m_currentContext )->SetGraphicsRootSignature( m_rootSignature.Get() );
-	( *m_currentContext )->SetGraphicsRootConstantBufferView( 0, m_constantBuffer->GetGPUVirtualAddress() );
+	( *m_currentContext )->SetGraphicsRootConstantBufferView( 0, constants );
 	( *m_currentContext )->IASetPrimitiveTopology( topology );
 
 	// Set buffers and draw
-	const D3D12_VERTEX_BUFFER_VIEW vbv = m_dynamicVertexBuffer->getView();
-	const D3D12_INDEX_BUFFER_VIEW ibv = m_dynamicIndexBuffer->getView();
 	( *m_currentContext )->IASetVertexBuffers( 0, 1, &vbv );
 	( *m_currentContext )->IASetIndexBuffer( &ibv );
 	( *m_currentContext )->DrawIndexedInstanced( static_cast<UINT>( indices.size() ), 1, 0, 0, 0 );
@@ -805,52 +775,89 @@ void Renderer::drawIndexed( const std::vector<Vertex> &vertices, const std::vect
 
 void Renderer::drawLine( const math::Vec3<> &start, const math::Vec3<> &end, const Color &color ) noexcept
 {
-	const std::vector<Vertex> vertices = {
-		{ start, color },
-		{ end, color }
-	};
-	drawVertices( vertices, D3D_PRIMITIVE_TOPOLOGY_LINELIST );
+	m_debugDraw.addLine( start, end, math::Vec4f{ color.r, color.g, color.b, color.a } );
 }
 
 
 void Renderer::drawWireframeCube( const math::Vec3<> &center, const math::Vec3<> &size, const Color &color ) noexcept
 {
 	const math::Vec3<> halfSize = size * 0.5f;
+	m_debugDraw.addBox( math::BoundingBox3Df( center - halfSize, center + halfSize ), math::Vec4f{ color.r, color.g, color.b, color.a } );
+}
 
-	// 8 vertices of the cube
-	const std::vector<Vertex> vertices = {
-		// Bottom face
-		{ center + math::Vec3<>{ -halfSize.x, -halfSize.y, -halfSize.z }, color },
-		{ center + math::Vec3<>{ halfSize.x, -halfSize.y, -halfSize.z }, color },
-		{ center + math::Vec3<>{ halfSize.x, halfSize.y, -halfSize.z }, color },
-		{ center + math::Vec3<>{ -halfSize.x, halfSize.y, -halfSize.z }, color },
-		// Top face
-		{ center + math::Vec3<>{ -halfSize.x, -halfSize.y, halfSize.z }, color },
-		{ center + math::Vec3<>{ halfSize.x, -halfSize.y, halfSize.z }, color },
-		{ center + math::Vec3<>{ halfSize.x, halfSize.y, halfSize.z }, color },
-		{ center + math::Vec3<>{ -halfSize.x, halfSize.y, halfSize.z }, color }
-	};
+void Renderer::drawDebugView( const math::Mat4<> &viewProjection ) noexcept
+{
+	takeDebugBatch();
+	if ( m_debugVertexBuffer.BufferLocation == 0 )
+		return;
 
-	// 12 edges of the cube
-	// clang-format off
-    const std::vector<uint16_t> indices = {
-        // Bottom face
-        0, 1,  1, 2,  2, 3,  3, 0,
-        // Top face  
-        4, 5,  5, 6,  6, 7,  7, 4,
-        // Vertical edges
-        0, 4,  1, 5,  2, 6,  3, 7
-    };
-	// clang-format on
+	drawDebugLines( uploadViewProjection( viewProjection ) );
+}
 
-	drawIndexed( vertices, indices, D3D_PRIMITIVE_TOPOLOGY_LINELIST );
+void Renderer::flushDebugDraw() noexcept
+{
+	if ( m_debugBatchTaken )
+		return;
+
+	takeDebugBatch();
+	if ( m_debugVertexBuffer.BufferLocation == 0 )
+		return;
+
+	drawDebugLines( getFrameConstantsAddress() );
+}
+
+void Renderer::takeDebugBatch()
+{
+	if ( m_debugBatchTaken )
+		return;
+	m_debugBatchTaken = true;
+	m_debugVertexBuffer = {};
+
+	m_debugDraw.flush( m_debugVertices, m_debugRanges );
+	if ( m_debugVertices.empty() )
+		return;
+
+	// One upload for every depth mode and view; DebugVertex and Vertex share the position/color layout
+	m_debugUploadVertices.resize( m_debugVertices.size() );
+	for ( size_t i = 0; i < m_debugVertices.size(); ++i )
+	{
+		const auto &source = m_debugVertices[i];
+		m_debugUploadVertices[i] = Vertex{ source.position, Color{ source.color.x, source.color.y, source.color.z, source.color.w } };
+	}
+	m_debugVertexBuffer = uploadVertices( m_debugUploadVertices );
+}
+
+void Renderer::drawDebugLines( D3D12_GPU_VIRTUAL_ADDRESS constants ) noexcept
+{
+	// Skip drawing in headless mode (no render targets available)
+	if ( !m_currentSwapChain || !m_currentContext || constants == 0 )
+		return;
+
+	( *m_currentContext )->SetGraphicsRootSignature( m_rootSignature.Get() );
+	( *m_currentContext )->SetGraphicsRootConstantBufferView( 0, constants );
+	( *m_currentContext )->IASetPrimitiveTopology( D3D_PRIMITIVE_TOPOLOGY_LINELIST );
+	( *m_currentContext )->IASetVertexBuffers( 0, 1, &m_debugVertexBuffer );
+
+	// Debug lines never write depth; overlay lines also skip the depth test
+	const RenderState savedState = m_currentRenderState;
+	for ( const auto &range : m_debugRanges )
+	{
+		RenderState state = savedState;
+		state.setDepthTest( range.mode == engine::debug_draw::DepthMode::Tested );
+		state.setDepthWrite( false );
+		setRenderState( state );
+		ensurePipelineForCurrentState( D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE );
+		( *m_currentContext )->SetPipelineState( m_activePipelineState.Get() );
+		( *m_currentContext )->DrawInstanced( range.vertexCount, 1, range.firstVertex, 0 );
+	}
+	setRenderState( savedState );
 }
 
 
 void Renderer::waitForGPU() noexcept
 {
-	// This would typically use a fence to wait for GPU completion
-	// For now, this is a placeholder - actual implementation would need fence synchronization
+	// Signals the queue if needed and blocks until all submitted work has completed
+	m_device.waitForFenceValue( m_device.getCurrentFenceValue() );
 }
 
 } // namespace renderer
@@ -11,6 +11,9 @@
 #include "math/matrix.h"
 #include "math/color.h"
 #include "platform/dx12/dx12_device.h"
+#include "engine/debug_draw/debug_draw.h"
+#include "engine/render_backend/d3d12_upload_backend.h"
+#include "engine/render_backend/upload_ring.h"
 
 namespace renderer
 {
@@ -196,11 +199,9 @@ public:
 	// Accessor (test instrumentation) for verifying setViewProjectionMatrix updates
 	const math::Mat4f &getViewProjectionMatrix() const noexcept { return m_viewProjectionMatrix; }
 
-	// Test instrumentation: expose dynamic buffer capacities
-	UINT getDynamicVertexCapacity() const noexcept { return m_dynamicVertexBuffer ? m_dynamicVertexBuffer->getVertexCount() : 0; }
-	UINT getDynamicIndexCapacity() const noexcept { return m_dynamicIndexBuffer ? m_dynamicIndexBuffer->getIndexCount() : 0; }
-	ID3D12Resource *getDynamicVertexResource() const noexcept { return m_dynamicVertexBuffer ? m_dynamicVertexBuffer->getResource() : nullptr; }
-	ID3D12Resource *getDynamicIndexResource() const noexcept { return m_dynamicIndexBuffer ? m_dynamicIndexBuffer->getResource() : nullptr; }
+	// Transient vertices, indices and constants are suballocated from this ring (stats, test instrumentation)
+	const engine::render_backend::UploadRingAllocator &getUploadRing() const noexcept { return m_uploadRing; }
+	ID3D12Resource *getUploadRingResource() const noexcept { return m_uploadBackend.getResource( m_uploadRing.getBuffer().handle ); }
 
 	// Access to command context for external rendering systems
 	dx12::CommandContext *getCommandContext() const noexcept { return m_currentContext; }
@@ -223,10 +224,22 @@ public:
 	void drawVertices( const std::vector<Vertex> &vertices, D3D_PRIMITIVE_TOPOLOGY topology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST ) noexcept;
 	void drawIndexed( const std::vector<Vertex> &vertices, const std::vector<uint16_t> &indices, D3D_PRIMITIVE_TOPOLOGY topology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST ) noexcept;
 
-	// Convenience drawing methods
+	// Convenience drawing methods. These are batched into the debug draw list and drawn by drawDebugView/flushDebugDraw.
 	void drawLine( const math::Vec3<> &start, const math::Vec3<> &end, const Color &color = Color::white() ) noexcept;
 	void drawWireframeCube( const math::Vec3<> &center, const math::Vec3<> &size, const Color &color = Color::white() ) noexcept;
 
+	// Thread-safe debug geometry accumulator (lines, boxes, spheres, frusta)
+	engine::debug_draw::DebugDrawBatcher &getDebugDraw() noexcept { return m_debugDraw; }
+
+	// Draw the frame's batched debug lines into the bound render target with this view's matrix, one draw per
+	// depth mode; called from each view's scene pass. The first call of a frame takes the batch and uploads it
+	// once, later views reuse that upload, and lines added after it are drawn the next frame.
+	void drawDebugView( const math::Mat4<> &viewProjection ) noexcept;
+
+	// Safety flush called by endFrame: when no view drew debug lines this frame, upload the batch and draw it
+	// with the renderer's own view-projection into whatever is bound
+	void flushDebugDraw() noexcept;
+
 	// Resource management
 	void waitForGPU() noexcept;
 
@@ -275,21 +288,24 @@ private:
 
 	// NOTE: Render targets are managed by Device, no duplication needed
 
-	// Constant buffer for view-projection matrix
-	Microsoft::WRL::ComPtr<ID3D12Resource> m_constantBuffer;
-	void *m_constantBufferData = nullptr;
-
 	// Current render state
 	RenderState m_currentRenderState;
 	math::Mat4<> m_viewProjectionMatrix = math::Mat4<>::identity();
 
-	// Dynamic vertex/index buffers for immediate mode
-	std::unique_ptr<VertexBuffer> m_dynamicVertexBuffer;
-	std::unique_ptr<IndexBuffer> m_dynamicIndexBuffer;
-
-	// Pending deletion queue to defer destruction until frame end
-	std::vector<std::unique_ptr<VertexBuffer>> m_pendingVertexBufferDeletions;
-	std::vector<std::unique_ptr<IndexBuffer>> m_pendingIndexBufferDeletions;
+	// Per-frame ring for immediate-mode vertices, indices and the view-projection constants.
+	// The backend must outlive the ring, which releases its buffers on destruction.
+	static constexpr std::uint64_t kUploadRingCapacity = 1024 * 1024;
+	engine::render_backend::D3D12UploadBackend m_uploadBackend;
+	engine::render_backend::UploadRingAllocator m_uploadRing;
+	D3D12_GPU_VIRTUAL_ADDRESS m_frameConstantsAddress = 0; // 0 until the current matrix is uploaded this frame
+
+	// Batched debug geometry and reused per-frame staging arrays
+	engine::debug_draw::DebugDrawBatcher m_debugDraw;
+	std::vector<engine::debug_draw::DebugVertex> m_debugVertices;
+	std::vector<engine::debug_draw::DebugDrawRange> m_debugRanges;
+	std::vector<Vertex> m_debugUploadVertices;
+	bool m_debugBatchTaken = false; // The frame's batch was taken by drawDebugView or flushDebugDraw
+	D3D12_VERTEX_BUFFER_VIEW m_debugVertexBuffer = {};
 
 	// Frame state tracking
 	bool m_inFrame = false;
@@ -299,10 +315,13 @@ private:
 	void compileDefaultShaders();
 	void createPipelineStateForKey( const PipelineStateKey &key );
 
-	void createConstantBuffer();
-
 	// Helper methods
-	void updateConstantBuffer();
+	D3D12_GPU_VIRTUAL_ADDRESS getFrameConstantsAddress();
+	D3D12_GPU_VIRTUAL_ADDRESS uploadViewProjection( const math::Mat4<> &viewProjection );
+	// Take the frame's debug batch and upload it, once per frame
+	void takeDebugBatch();
+	void drawDebugLines( D3D12_GPU_VIRTUAL_ADDRESS constants ) noexcept;
+	D3D12_VERTEX_BUFFER_VIEW uploadVertices( const std::vector<Vertex> &vertices );
 
 	PipelineStateKey makeKeyFromState( const RenderState &state, D3D12_PRIMITIVE_TOPOLOGY_TYPE topology ) const noexcept;
 	void ensurePipelineForCurrentState( D3D12_PRIMITIVE_TOPOLOGY_TYPE topology );
@@ -0,0 +1,201 @@
+#include "engine/residency/residency_manager.h"
+
+#include <algorithm>
+
+namespace engine::residency
+{
+
+ResidencyManager::ResidencyManager( ResidencyUploader &uploader, std::uint64_t budgetBytes )
+	: m_uploader( uploader ), m_budget( budgetBytes )
+{
+}
+
+void ResidencyManager::add( ResourceId id, std::uint64_t bytes )
+{
+	if ( id == kInvalidResource )
+	{
+		return;
+	}
+
+	auto [it, inserted] = m_entries.try_emplace( id );
+	Entry &entry = it->second;
+	if ( inserted )
+	{
+		++m_stats.registeredCount;
+	}
+	if ( entry.resident )
+	{
+		setResidentBytes( m_stats.residentBytes - entry.bytes );
+	}
+	else
+	{
+		++m_stats.residentCount;
+	}
+	entry.bytes = bytes;
+	entry.resident = true;
+	setResidentBytes( m_stats.residentBytes + bytes );
+	touch( entry );
+}
+
+void ResidencyManager::remove( ResourceId id )
+{
+	const auto it = m_entries.find( id );
+	if ( it == m_entries.end() )
+	{
+		return;
+	}
+	if ( it->second.resident )
+	{
+		setResidentBytes( m_stats.residentBytes - it->second.bytes );
+		--m_stats.residentCount;
+	}
+	--m_stats.registeredCount;
+	m_entries.erase( it );
+}
+
+bool ResidencyManager::request( ResourceId id )
+{
+	const auto it = m_entries.find( id );
+	if ( it == m_entries.end() )
+	{
+		return false;
+	}
+
+	Entry &entry = it->second;
+	if ( entry.resident )
+	{
+		++m_stats.hits;
+		touch( entry );
+		return true;
+	}
+
+	++m_stats.misses;
+	const std::uint64_t bytes = m_uploader.upload( id );
+	if ( bytes == 0 )
+	{
+		++m_stats.uploadFailures;
+		return false;
+	}
+	if ( entry.evictedBefore )
+	{
+		++m_stats.reuploads;
+	}
+	entry.bytes = bytes;
+	entry.resident = true;
+	++m_stats.residentCount;
+	m_stats.bytesUploaded += bytes;
+	setResidentBytes( m_stats.residentBytes + bytes );
+	touch( entry );
+	return true;
+}
+
+void ResidencyManager::updateSize( ResourceId id, std::uint64_t bytes )
+{
+	const auto it = m_entries.find( id );
+	if ( it == m_entries.end() )
+	{
+		return;
+	}
+	if ( it->second.resident )
+	{
+		setResidentBytes( m_stats.residentBytes - it->second.bytes + bytes );
+	}
+	it->second.bytes = bytes;
+}
+
+bool ResidencyManager::isResident( ResourceId id ) const noexcept
+{
+	const auto it = m_entries.find( id );
+	return it != m_entries.end() && it->second.resident;
+}
+
+std::uint64_t ResidencyManager::getSize( ResourceId id ) const noexcept
+{
+	const auto it = m_entries.find( id );
+	return it != m_entries.end() ? it->second.bytes : 0;
+}
+
+std::uint32_t ResidencyManager::enforceBudget()
+{
+	if ( m_stats.residentBytes <= m_budget )
+	{
+		return 0;
+	}
+
+	// Resources used this frame belong to the visible set and are never candidates
+	m_candidates.clear();
+	for ( const auto &[id, entry] : m_entries )
+	{
+		if ( entry.resident && entry.lastUsedFrame < m_frame )
+		{
+			m_candidates.push_back( Candidate{ entry.lastUsedFrame, entry.useCount, id } );
+		}
+	}
+
+	// Oldest first; a resource used in many frames outlives one seen once in the same frame.
+	// The id breaks ties so eviction order does not depend on hash map iteration. A heap is enough
+	// because a frame usually evicts only the few resources that just left view.
+	const auto evictFirst = []( const Candidate &a, const Candidate &b ) {
+		if ( a.lastUsedFrame != b.lastUsedFrame )
+		{
+			return a.lastUsedFrame > b.lastUsedFrame;
+		}
+		if ( a.useCount != b.useCount )
+		{
+			return a.useCount > b.useCount;
+		}
+		return a.id > b.id;
+	};
+	std::make_heap( m_candidates.begin(), m_candidates.end(), evictFirst );
+
+	std::uint32_t evicted = 0;
+	while ( m_stats.residentBytes > m_budget && !m_candidates.empty() )
+	{
+		std::pop_heap( m_candidates.begin(), m_candidates.end(), evictFirst );
+		const ResourceId id = m_candidates.back().id;
+		m_candidates.pop_back();
+
+		Entry &entry = m_entries.at( id );
+		m_uploader.evict( id );
+		entry.resident = false;
+		entry.evictedBefore = true;
+		--m_stats.residentCount;
+		++m_stats.evictions;
+		m_stats.bytesEvicted += entry.bytes;
+		setResidentBytes( m_stats.residentBytes - entry.bytes );
+		++evicted;
+	}
+
+	if ( m_stats.residentBytes > m_budget )
+	{
+		++m_stats.overBudgetFrames;
+	}
+	return evicted;
+}
+
+void ResidencyManager::resetCounters() noexcept
+{
+	const ResidencyStats current = m_stats;
+	m_stats = ResidencyStats{};
+	m_stats.residentBytes = current.residentBytes;
+	m_stats.peakResidentBytes = current.residentBytes;
+	m_stats.residentCount = current.residentCount;
+	m_stats.registeredCount = current.registeredCount;
+}
+
+void ResidencyManager::touch( Entry &entry ) noexcept
+{
+	if ( entry.lastUsedFrame != m_frame )
+	{
+		entry.lastUsedFrame = m_frame;
+		++entry.useCount;
+	}
+}
+
+void ResidencyManager::setResidentBytes( std::uint64_t bytes ) noexcept
+{
+	m_stats.residentBytes = bytes;
+	m_stats.peakResidentBytes = std::max( m_stats.peakResidentBytes, bytes );
+}
+
+} // namespace engine::residency
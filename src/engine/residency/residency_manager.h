@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+// Memory-budgeted residency policy for GPU resources that can be dropped and rebuilt from their CPU
+// source. Every resource has an exact byte size and the frame it was last used in; when resident bytes
+// exceed the budget, resources not used in the current frame are evicted, least recently used first and
+// least frequently used among those last seen in the same frame. A later request re-uploads on demand.
+// The actual upload and release go through ResidencyUploader, so the policy runs without a GPU in tests.
+// Not thread-safe: called from the render thread.
+namespace engine::residency
+{
+
+using ResourceId = std::uint64_t;
+constexpr ResourceId kInvalidResource = 0;
+constexpr std::uint64_t kUnlimitedBudget = std::numeric_limits<std::uint64_t>::max();
+
+// Backend hook that moves resources in and out of GPU memory
+class ResidencyUploader
+{
+public:
+	virtual ~ResidencyUploader() = default;
+
+	// Recreate the GPU copy; returns its size in bytes, or 0 on failure
+	virtual std::uint64_t upload( ResourceId id ) = 0;
+
+	// Release the GPU copy; the resource stays registered and can be uploaded again
+	virtual void evict( ResourceId id ) = 0;
+};
+
+struct ResidencyStats
+{
+	std::uint64_t hits = 0;		   // Requests for resident resources
+	std::uint64_t misses = 0;	   // Requests that had to upload
+	std::uint64_t evictions = 0;
+	std::uint64_t reuploads = 0;   // Misses on resources that had been evicted before
+	std::uint64_t uploadFailures = 0;
+	std::uint64_t bytesUploaded = 0;
+	std::uint64_t bytesEvicted = 0;
+	std::uint64_t residentBytes = 0;
+	std::uint64_t peakResidentBytes = 0;
+	std::uint32_t residentCount = 0;
+	std::uint32_t registeredCount = 0;
+	std::uint32_t overBudgetFrames = 0; // Frames whose in-use set alone exceeded the budget
+};
+
+class ResidencyManager
+{
+public:
+	explicit ResidencyManager( ResidencyUploader &uploader, std::uint64_t budgetBytes = kUnlimitedBudget );
+
+	ResidencyManager( const ResidencyManager & ) = delete;
+	ResidencyManager &operator=( const ResidencyManager & ) = delete;
+
+	void setBudget( std::uint64_t budgetBytes ) noexcept { m_budget = budgetBytes; }
+	std::uint64_t getBudget() const noexcept { return m_budget; }
+
+	// Register a resource that is already resident (just created); counts as used this frame
+	void add( ResourceId id, std::uint64_t bytes );
+
+	// Forget a destroyed resource without calling the uploader
+	void remove( ResourceId id );
+
+	// Mark the resource as used this frame, uploading it first if it was evicted.
+	// Returns false for unknown resources and failed uploads.
+	bool request( ResourceId id );
+
+	// Correct the recorded size after the resource changed on the GPU
+	void updateSize( ResourceId id, std::uint64_t bytes );
+
+	bool isRegistered( ResourceId id ) const noexcept { return m_entries.contains( id ); }
+	bool isResident( ResourceId id ) const noexcept;
+	std::uint64_t getSize( ResourceId id ) const noexcept;
+
+	// Evict resources not used this frame until resident bytes fit the budget; returns the number evicted
+	std::uint32_t enforceBudget();
+
+	// Start the next frame: resources requested from now on are protected from eviction until the next call
+	void advanceFrame() noexcept { ++m_frame; }
+	std::uint64_t getFrame() const noexcept { return m_frame; }
+
+	const ResidencyStats &getStats() const noexcept { return m_stats; }
+	void resetCounters() noexcept;
+
+private:
+	struct Entry
+	{
+		std::uint64_t bytes = 0;
+		std::uint64_t lastUsedFrame = 0;
+		std::uint32_t useCount = 0; // Frames the resource was used in
+		bool resident = false;
+		bool evictedBefore = false;
+	};
+
+	struct Candidate
+	{
+		std::uint64_t lastUsedFrame = 0;
+		std::uint32_t useCount = 0;
+		ResourceId id = kInvalidResource;
+	};
+
+	ResidencyUploader &m_uploader;
+	std::uint64_t m_budget = kUnlimitedBudget;
+	std::uint64_t m_frame = 1;
+	std::unordered_map<ResourceId, Entry> m_entries;
+	std::vector<Candidate> m_candidates;
+	ResidencyStats m_stats;
+
+	void touch( Entry &entry ) noexcept;
+	void setResidentBytes( std::uint64_t bytes ) noexcept;
+};
+
+} // namespace engine::residency
@@ -6,6 +6,7 @@
 #include "engine/integration/asset_gltf_integration.h"
 #include "engine/picking.h"
 #include "engine/renderer/renderer.h"
+#include "engine/render_thread/render_thread.h"
 #include "engine/shader_manager/shader_manager.h"
 #include "platform/dx12/dx12_device.h"
 #include "platform/pix/pix.h"
@@ -14,6 +15,7 @@
 #include "runtime/console.h"
 #include "runtime/ecs.h"
 #include "runtime/mesh_rendering_system.h"
+#include "runtime/scene_importer.h"
 #include "runtime/systems.h"
 
 #include <iostream>
@@ -111,6 +113,13 @@ int main()
 	// This enables AssetManager::loadScene to delegate to GLTFLoader for glTF files
 	engine::integration::initializeAssetGLTFIntegration();
 
+	// Reopened scenes come from cooked copies instead of being imported again
+	assetManager.setSceneCache( engine::integration::createGLTFSceneCache( "cache/scenes" ) );
+	// Props and materials repeated across a kit's files are kept and uploaded once
+	assetManager.setContentStore( std::make_shared<assets::ContentStore>() );
+	// Imported scenes nothing references any more stay cached up to this much CPU memory
+	assetManager.setCacheBudget( std::size_t{ 2 } << 30 );
+
 	// Create GPU resource manager for GPU resource creation and management
 	engine::GPUResourceManager gpuResourceManager( device );
 
@@ -124,7 +133,8 @@ int main()
 	systemManager.addSystem<systems::TransformSystem>();
 
 	// Add MeshRenderingSystem to handle 3D mesh rendering with hierarchy support
-	systemManager.addSystem<systems::MeshRenderingSystem>( renderer, shaderManager, &systemManager );
+	auto *meshRenderingSystem = systemManager.addSystem<systems::MeshRenderingSystem>( renderer, shaderManager, &systemManager );
+	meshRenderingSystem->setResidencyProvider( &gpuResourceManager );
 
 	// Initialize all systems with the scene
 	systemManager.initialize( scene );
@@ -151,6 +161,7 @@ int main()
 
 	// Connect scene and systems to viewport manager for 3D rendering
 	ui.getViewportManager().setSceneAndSystems( &scene, &systemManager, &selectionManager, &pickingSystem, ui.getGizmoSystem() );
+	ui.getViewportManager().setDebugRenderer( &renderer );
 
 	// Setup input handlers for existing viewports now that systems are available
 	ui.getViewportManager().setupInputHandlersForExistingViewports();
@@ -167,11 +178,14 @@ int main()
 		// Calculate deltaTime (rough approximation - you might want to improve this)
 		auto lastTime = std::chrono::high_resolution_clock::now();
 		float deltaTime = 0.0f;
+		// Input-to-present latency: from sampling input to the return of Present()
+		engine::render_thread::LatencyTracker inputLatency;
 		while ( window.poll() && !ui.shouldExit() )
 		{
 			frameCount++;
 
 			ui.processInputEvents( window );
+			const auto inputTime = engine::render_thread::Clock::now();
 
 			// Begin D3D12 frame - this opens the command list
 			device.beginFrame();
@@ -191,6 +205,18 @@ int main()
 					shaderManager->update();
 				}
 
+				// Finalise background asset loads: cache them and run their ECS imports
+				{
+					pix::ScopedEvent pixAssetLoads( commandList, pix::MarkerColor::Yellow, "Asset Loads" );
+					assetManager.processCompletedLoads();
+
+					// Re-exported source files patch the meshes and materials they changed into the existing entities
+					for ( const auto &reload : assetManager.reloadChangedScenes() )
+					{
+						runtime::SceneImporter::applySceneReload( reload, scene, gpuResourceManager );
+					}
+				}
+
 				// Update systems (including MeshRenderingSystem)
 				{
 					pix::ScopedEvent pixSystemUpdate( commandList, pix::MarkerColor::Orange, "System Update" );
@@ -232,6 +258,9 @@ int main()
 
 			// Present D3D12 frame - command list is closed at this point
 			device.present();
+			inputLatency.record( inputTime, engine::render_thread::Clock::now() );
+			const auto latency = inputLatency.getStats();
+			ui.setInputLatency( static_cast<float>( latency.averageMs ), static_cast<float>( latency.p95Ms ) );
 
 			// End GPU resource manager frame - this cleans up deferred deletions
 			gpuResourceManager.processPendingDeletes();
@@ -1,5 +1,10 @@
 ﻿#pragma once
 
+#include "plane.h"
+#include "bounding_box_3d.h"
+#include "bounding_sphere.h"
+#include "matrix.h"
+
 namespace math
 {
 
@@ -14,6 +19,32 @@ struct Frustum
 
 	constexpr Frustum() noexcept = default;
 
+	// Extract frustum planes from a combined view-projection matrix (Gribb/Hartmann method).
+	// Expects our row-major convention (clip = viewProj * point) with clip-space z in [-w, w].
+	// Plane normals point towards the inside of the frustum and are normalized.
+	static Frustum fromViewProjection( const Mat4<T> &viewProj ) noexcept
+	{
+		const Vec4<T> rows[6] = {
+			viewProj.row3 + viewProj.row0, // Left
+			viewProj.row3 - viewProj.row0, // Right
+			viewProj.row3 - viewProj.row1, // Top
+			viewProj.row3 + viewProj.row1, // Bottom
+			viewProj.row3 + viewProj.row2, // Near
+			viewProj.row3 - viewProj.row2  // Far
+		};
+
+		Frustum frustum;
+		for ( int i = 0; i < 6; ++i )
+		{
+			const Vec3<T> normal = rows[i].xyz();
+			const T len = length( normal );
+			const T invLength = len > T( 0 ) ? T( 1 ) / len : T( 0 );
+			frustum.planes[i].normal = normal * invLength;
+			frustum.planes[i].distance = -rows[i].w * invLength;
+		}
+		return frustum;
+	}
+
 	// Point containment test
 	constexpr bool contains( const Vec3<T> &point ) const noexcept
 	{
@@ -0,0 +1,160 @@
+#include "dx12_descriptor_heap.h"
+
+#include "dx12_device.h"
+#include "runtime/console.h"
+
+namespace dx12
+{
+
+bool DescriptorHeap::initialize( Device *device,
+	D3D12_DESCRIPTOR_HEAP_TYPE type,
+	UINT persistentCount,
+	UINT frameCount,
+	UINT reservedCount,
+	bool shaderVisible,
+	const wchar_t *debugName )
+{
+	if ( !device || !device->get() )
+	{
+		console::error( "DescriptorHeap::initialize: Invalid device" );
+		return false;
+	}
+	if ( frameCount > 0 && !shaderVisible )
+	{
+		console::error( "DescriptorHeap::initialize: Per-frame descriptors need a shader-visible heap" );
+		return false;
+	}
+
+	shutdown();
+
+	D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+	desc.Type = type;
+	desc.NumDescriptors = reservedCount + persistentCount + frameCount;
+	desc.Flags = shaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	if ( FAILED( device->get()->CreateDescriptorHeap( &desc, IID_PPV_ARGS( &m_heap ) ) ) )
+	{
+		console::error( "DescriptorHeap::initialize: Failed to create heap with {} descriptors", desc.NumDescriptors );
+		m_heap.Reset();
+		return false;
+	}
+	if ( debugName )
+	{
+		m_heap->SetName( debugName );
+	}
+
+	m_device = device;
+	m_shaderVisible = shaderVisible;
+	m_descriptorSize = device->get()->GetDescriptorHandleIncrementSize( type );
+	m_cpuStart = m_heap->GetCPUDescriptorHandleForHeapStart();
+	m_gpuStart = shaderVisible ? m_heap->GetGPUDescriptorHandleForHeapStart() : D3D12_GPU_DESCRIPTOR_HANDLE{};
+	m_allocator = std::make_unique<engine::descriptors::DescriptorAllocator>( persistentCount, frameCount, reservedCount );
+	m_frameStalls = 0;
+	return true;
+}
+
+void DescriptorHeap::shutdown()
+{
+	m_allocator.reset();
+	m_heap.Reset();
+	m_device = nullptr;
+	m_cpuStart = {};
+	m_gpuStart = {};
+	m_descriptorSize = 0;
+}
+
+Descriptor DescriptorHeap::allocate( UINT count )
+{
+	if ( !m_allocator )
+	{
+		return {};
+	}
+
+	auto range = m_allocator->allocate( count );
+	if ( !range.isValid() && m_allocator->getStats().pendingFrees > 0 )
+	{
+		// Freed ranges may have completed since the last beginFrame()
+		m_allocator->reclaim( m_device->getCompletedFenceValue() );
+		range = m_allocator->allocate( count );
+	}
+	return makeDescriptor( range );
+}
+
+void DescriptorHeap::free( Descriptor &descriptor )
+{
+	if ( m_allocator && descriptor.isValid() )
+	{
+		m_allocator->free( descriptor.range, m_device->getCurrentFenceValue() );
+	}
+	descriptor = {};
+}
+
+Descriptor DescriptorHeap::allocateFrame( UINT count )
+{
+	if ( !m_allocator )
+	{
+		return {};
+	}
+
+	auto range = m_allocator->allocateFrame( count );
+	while ( !range.isValid() && count <= m_allocator->getFrameCapacity() && m_allocator->getOldestFrameFence() != 0 )
+	{
+		// Ring full: wait for the oldest frame still holding descriptors
+		const UINT64 fenceValue = m_allocator->getOldestFrameFence();
+		if ( m_device->getCompletedFenceValue() < fenceValue )
+		{
+			m_device->waitForFenceValue( fenceValue );
+			++m_frameStalls;
+		}
+		m_allocator->reclaim( m_device->getCompletedFenceValue() );
+		range = m_allocator->allocateFrame( count );
+	}
+	return makeDescriptor( range );
+}
+
+void DescriptorHeap::beginFrame()
+{
+	if ( m_allocator )
+	{
+		m_allocator->reclaim( m_device->getCompletedFenceValue() );
+	}
+}
+
+void DescriptorHeap::endFrame( UINT64 fenceValue )
+{
+	if ( m_allocator )
+	{
+		m_allocator->endFrame( fenceValue );
+	}
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeap::getCpuHandle( UINT index ) const noexcept
+{
+	D3D12_CPU_DESCRIPTOR_HANDLE handle = m_cpuStart;
+	handle.ptr += static_cast<SIZE_T>( index ) * m_descriptorSize;
+	return handle;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorHeap::getGpuHandle( UINT index ) const noexcept
+{
+	if ( !m_shaderVisible )
+	{
+		return {};
+	}
+	D3D12_GPU_DESCRIPTOR_HANDLE handle = m_gpuStart;
+	handle.ptr += static_cast<UINT64>( index ) * m_descriptorSize;
+	return handle;
+}
+
+Descriptor DescriptorHeap::makeDescriptor( const engine::descriptors::DescriptorRange &range ) const noexcept
+{
+	Descriptor descriptor;
+	if ( range.isValid() )
+	{
+		descriptor.range = range;
+		descriptor.cpuHandle = getCpuHandle( range.index );
+		descriptor.gpuHandle = getGpuHandle( range.index );
+	}
+	return descriptor;
+}
+
+} // namespace dx12
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <d3d12.h>
+#include <memory>
+#include <wrl.h>
+
+#include "engine/descriptors/descriptor_allocator.h"
+
+namespace dx12
+{
+
+class Device;
+
+// Handles of a descriptor range allocated from a DescriptorHeap
+struct Descriptor
+{
+	engine::descriptors::DescriptorRange range;
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = {};
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = {}; // Zero unless the heap is shader visible
+
+	bool isValid() const noexcept { return range.isValid(); }
+};
+
+// D3D12 descriptor heap whose index allocation is done by engine::descriptors::DescriptorAllocator.
+// Persistent ranges are freed against the device's frame fence; shader-visible heaps can also hand out
+// per-frame ranges that recycle once the frame's fence completes.
+class DescriptorHeap
+{
+public:
+	DescriptorHeap() = default;
+	~DescriptorHeap() = default;
+
+	DescriptorHeap( const DescriptorHeap & ) = delete;
+	DescriptorHeap &operator=( const DescriptorHeap & ) = delete;
+
+	// Create the heap with reservedCount fixed slots at the start, then persistentCount allocatable slots,
+	// then frameCount per-frame slots. Heaps with per-frame slots must be shader visible.
+	bool initialize( Device *device,
+		D3D12_DESCRIPTOR_HEAP_TYPE type,
+		UINT persistentCount,
+		UINT frameCount = 0,
+		UINT reservedCount = 0,
+		bool shaderVisible = false,
+		const wchar_t *debugName = nullptr );
+	// Releases the heap; the caller must ensure the GPU no longer reads it
+	void shutdown();
+	bool isValid() const noexcept { return m_heap != nullptr; }
+
+	// Persistent range of count descriptors; invalid when the heap is full
+	Descriptor allocate( UINT count = 1 );
+	// Return the range once the GPU finishes the frame being recorded; resets descriptor
+	void free( Descriptor &descriptor );
+
+	// Range valid for the current frame only. Waits for the oldest in-flight frame when the ring is full.
+	Descriptor allocateFrame( UINT count );
+
+	// Reclaim ranges and frames whose fences have completed
+	void beginFrame();
+	// Close the frame; its per-frame ranges recycle once fenceValue completes
+	void endFrame( UINT64 fenceValue );
+
+	D3D12_CPU_DESCRIPTOR_HANDLE getCpuHandle( UINT index ) const noexcept;
+	D3D12_GPU_DESCRIPTOR_HANDLE getGpuHandle( UINT index ) const noexcept;
+
+	ID3D12DescriptorHeap *get() const noexcept { return m_heap.Get(); }
+	UINT getDescriptorSize() const noexcept { return m_descriptorSize; }
+	const engine::descriptors::DescriptorAllocator *getAllocator() const noexcept { return m_allocator.get(); }
+	UINT getFrameStalls() const noexcept { return m_frameStalls; }
+
+private:
+	Device *m_device = nullptr;
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_heap;
+	std::unique_ptr<engine::descriptors::DescriptorAllocator> m_allocator;
+	D3D12_CPU_DESCRIPTOR_HANDLE m_cpuStart = {};
+	D3D12_GPU_DESCRIPTOR_HANDLE m_gpuStart = {};
+	UINT m_descriptorSize = 0;
+	UINT m_frameStalls = 0;
+	bool m_shaderVisible = false;
+
+	Descriptor makeDescriptor( const engine::descriptors::DescriptorRange &range ) const noexcept;
+};
+
+} // namespace dx12
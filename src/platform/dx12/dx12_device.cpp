@@ -139,7 +139,8 @@ void Device::shutdown()
 
 	// Release COM resources explicitly (safe if already null)
 	m_rtvHeap.Reset();
-	m_imguiDescriptorHeap.Reset();
+	m_dsvHeap.Reset();
+	m_srvHeap.shutdown();
 	m_fence.Reset();
 	m_device.Reset();
 	m_adapter.Reset();
@@ -169,6 +170,10 @@ void Device::beginFrame()
 	// Mark that we're now in a frame
 	m_inFrame = true;
 
+	// Descriptors freed or used per frame in completed frames become available again
+	m_srvHeap.beginFrame();
+	m_textureManager.beginFrame();
+
 	// Reset command context for new frame
 	m_commandContext->reset();
 
@@ -211,7 +216,7 @@ void Device::beginFrame()
 	}
 
 	// Set descriptor heaps for ImGui
-	ID3D12DescriptorHeap *const ppHeaps[] = { m_imguiDescriptorHeap.Get() };
+	ID3D12DescriptorHeap *const ppHeaps[] = { m_srvHeap.get() };
 	m_commandContext->get()->SetDescriptorHeaps( _countof( ppHeaps ), ppHeaps );
 }
 
@@ -232,6 +237,9 @@ void Device::endFrame()
 		return;
 	}
 
+	// Per-frame descriptors recorded this frame recycle once the next signalled fence value completes
+	m_srvHeap.endFrame( m_fenceValue );
+
 	// For headless mode, just close the command context and execute
 	if ( !m_swapChain )
 	{
@@ -295,7 +303,7 @@ void Device::setBackbufferRenderTarget()
 	m_commandContext->get()->OMSetRenderTargets( 1, &rtvHandle, FALSE, nullptr );
 
 	// Set descriptor heap for ImGui (should already be set, but ensure consistency)
-	ID3D12DescriptorHeap *const ppHeaps[] = { m_imguiDescriptorHeap.Get() };
+	ID3D12DescriptorHeap *const ppHeaps[] = { m_srvHeap.get() };
 	m_commandContext->get()->SetDescriptorHeaps( _countof( ppHeaps ), ppHeaps );
 }
 
@@ -483,13 +491,18 @@ void Device::createDescriptorHeaps()
 
 	m_dsvDescriptorSize = m_device->GetDescriptorHandleIncrementSize( D3D12_DESCRIPTOR_HEAP_TYPE_DSV );
 
-	// Create ImGui descriptor heap - reserve indices 16+ for viewport textures
-	// ImGui uses index 0 for font texture, we reserve 16-79 for 64 viewport textures
-	D3D12_DESCRIPTOR_HEAP_DESC imguiDesc = {};
-	imguiDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	imguiDesc.NumDescriptors = 80; // 16 reserved for ImGui + 64 for viewport textures
-	imguiDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	throwIfFailed( m_device->CreateDescriptorHeap( &imguiDesc, IID_PPV_ARGS( &m_imguiDescriptorHeap ) ) );
+	// Create the shader-visible heap shared with ImGui. ImGui uses index 0 for its font texture; the first
+	// kReservedSrvDescriptors slots stay outside the allocator, followed by persistent and per-frame regions.
+	if ( !m_srvHeap.initialize( this,
+			 D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+			 kPersistentSrvDescriptors,
+			 kFrameSrvDescriptors,
+			 kReservedSrvDescriptors,
+			 true,
+			 L"Shader Visible Descriptors" ) )
+	{
+		throwIfFailed( E_FAIL, m_device.Get() );
+	}
 }
 
 void Device::createDepthBuffer( UINT width, UINT height )
@@ -570,6 +583,31 @@ void Device::waitForPreviousFrame()
 	}
 }
 
+UINT64 Device::getCompletedFenceValue() const
+{
+	return m_fence ? m_fence->GetCompletedValue() : 0;
+}
+
+void Device::waitForFenceValue( UINT64 value )
+{
+	if ( !m_fence || !m_commandQueue )
+	{
+		return;
+	}
+
+	// Values up to the current one may not have been signalled yet (headless frames never present)
+	while ( m_fence->GetCompletedValue() < value )
+	{
+		if ( value >= m_fenceValue )
+		{
+			waitForPreviousFrame();
+			continue;
+		}
+		throwIfFailed( m_fence->SetEventOnCompletion( value, m_fenceEvent ) );
+		WaitForSingleObject( m_fenceEvent, INFINITE );
+	}
+}
+
 // CommandQueue implementation
 CommandQueue::CommandQueue( Device &device, D3D12_COMMAND_LIST_TYPE type )
 {
@@ -3,8 +3,11 @@
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <memory>
+#include <vector>
 #include <wrl.h>
 
+#include "dx12_descriptor_heap.h"
+
 namespace dx12
 {
 
@@ -40,12 +43,16 @@ public:
 	// Resize the texture (recreates the resource)
 	bool resize( Device *device, UINT width, UINT height );
 
-	// Clear the render target texture with a solid color
+	// Depth buffer paired with the render target (D32_FLOAT, always in DEPTH_WRITE); recreated on resize
+	bool createDepthBuffer( Device *device );
+
+	// Clear the render target texture with a solid color, and its depth buffer (if any) to the far plane
 	bool clearRenderTarget( Device *device, const float clearColor[4] );
 
 	// Resource access
 	ID3D12Resource *getResource() const { return m_resource.Get(); }
 	D3D12_CPU_DESCRIPTOR_HANDLE getRtvHandle() const { return m_rtvHandle; }
+	D3D12_CPU_DESCRIPTOR_HANDLE getDsvHandle() const { return m_dsvHandle; } // Null without a depth buffer
 	D3D12_GPU_DESCRIPTOR_HANDLE getSrvGpuHandle() const { return m_srvGpuHandle; }
 	void *getImGuiTextureId() const { return (void *)m_srvGpuHandle.ptr; }
 
@@ -56,6 +63,7 @@ public:
 
 	// Resource state management
 	void transitionTo( ID3D12GraphicsCommandList *commandList, D3D12_RESOURCE_STATES newState );
+	D3D12_RESOURCE_STATES getState() const { return m_currentState; }
 
 	// Allow TextureManager to access private members for GPU handle management
 	friend class TextureManager;
@@ -65,6 +73,13 @@ private:
 	D3D12_CPU_DESCRIPTOR_HANDLE m_rtvHandle = {};
 	D3D12_CPU_DESCRIPTOR_HANDLE m_srvCpuHandle = {};
 	D3D12_GPU_DESCRIPTOR_HANDLE m_srvGpuHandle = {};
+	Descriptor m_rtvDescriptor; // Owned when created by TextureManager
+	Descriptor m_srvDescriptor;
+
+	// Depth buffer with its own single-entry DSV heap
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_depthResource;
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_dsvHeap;
+	D3D12_CPU_DESCRIPTOR_HANDLE m_dsvHandle = {};
 
 	UINT m_width = 0;
 	UINT m_height = 0;
@@ -74,7 +89,8 @@ private:
 	Device *m_device = nullptr;
 };
 
-// Texture manager for viewport render targets
+// Texture manager for viewport render targets. RTVs come from the manager's own heap and SRVs from the
+// device's shader-visible heap; both are returned when the last reference to a texture goes away.
 class TextureManager
 {
 public:
@@ -85,25 +101,25 @@ public:
 	bool initialize( Device *device );
 	void shutdown();
 
+	// Reclaim descriptors of textures released in completed frames
+	void beginFrame();
+
 	// Create a new viewport render target
 	std::shared_ptr<Texture> createViewportRenderTarget( UINT width, UINT height );
 
-	// Get next available SRV descriptor handle
+	// Allocate an SRV descriptor in the shader-visible heap, owned by the manager until shutdown
 	D3D12_CPU_DESCRIPTOR_HANDLE getNextSrvHandle();
 
 	// Constants
-	static const UINT kMaxTextures = 64;	// Support up to 64 viewport render targets
-	static const UINT kSrvIndexOffset = 16; // Start our textures at index 16 to avoid ImGui conflicts
+	static const UINT kMaxTextures = 4096;	// Render target views available to viewport textures
+	static const UINT kSrvIndexOffset = 16; // Shader-visible slots before this index are reserved for ImGui
 
 private:
 	Device *m_device = nullptr;
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_rtvHeap;
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_srvHeap;
+	DescriptorHeap m_rtvHeap;
+	std::vector<Descriptor> m_looseSrvDescriptors; // Handed out by getNextSrvHandle()
 
-	UINT m_rtvDescriptorSize = 0;
-	UINT m_srvDescriptorSize = 0;
-	UINT m_currentRtvIndex = 0;
-	UINT m_currentSrvIndex = 0;
+	void releaseDescriptors( Texture &texture );
 };
 
 // D3D12 Device wrapper
@@ -133,6 +149,12 @@ public:
 	// Frame state query
 	bool isInFrame() const noexcept { return m_inFrame; }
 
+	// Frame fence: work recorded in the current frame completes when the fence reaches getCurrentFenceValue()
+	UINT64 getCurrentFenceValue() const noexcept { return m_fenceValue; }
+	UINT64 getCompletedFenceValue() const;
+	// Block until the fence reaches value, signalling the queue first if that value has not been signalled yet
+	void waitForFenceValue( UINT64 value );
+
 	// Debug layer integration - process accumulated debug messages
 	void processDebugMessages();
 
@@ -145,9 +167,16 @@ public:
 	ID3D12Device *get() const { return m_device.Get(); }
 	ID3D12Device *operator->() const { return m_device.Get(); }
 
-	// ImGui integration
+	// ImGui integration; ImGui's font SRV lives in the reserved slots of the shader-visible heap
 	ID3D12Device *getDevice() const { return m_device.Get(); }
-	ID3D12DescriptorHeap *getImguiDescriptorHeap() const { return m_imguiDescriptorHeap.Get(); }
+	ID3D12DescriptorHeap *getImguiDescriptorHeap() const { return m_srvHeap.get(); }
+
+	// Shader-visible CBV/SRV/UAV heap: persistent descriptors (textures) plus a per-frame ring
+	DescriptorHeap &getSrvHeap() { return m_srvHeap; }
+
+	static constexpr UINT kReservedSrvDescriptors = TextureManager::kSrvIndexOffset;
+	static constexpr UINT kPersistentSrvDescriptors = 16384;
+	static constexpr UINT kFrameSrvDescriptors = 4096;
 
 	// Command list for ImGui rendering
 	ID3D12GraphicsCommandList *getCommandList() const;
@@ -187,8 +216,8 @@ private:
 	Microsoft::WRL::ComPtr<ID3D12Resource> m_depthBuffer;
 	UINT m_dsvDescriptorSize = 0;
 
-	// ImGui descriptor heap
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_imguiDescriptorHeap;
+	// Shader-visible descriptor heap, shared with ImGui
+	DescriptorHeap m_srvHeap;
 
 	// Synchronization
 	Microsoft::WRL::ComPtr<ID3D12Fence> m_fence;
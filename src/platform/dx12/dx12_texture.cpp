@@ -127,6 +127,13 @@ bool Texture::resize( Device *device, UINT width, UINT height )
 		device->get()->CreateRenderTargetView( m_resource.Get(), nullptr, m_rtvHandle );
 	}
 
+	// The depth buffer follows the colour target's size
+	if ( m_depthResource && !createDepthBuffer( device ) )
+	{
+		console::error( "Texture::resize: Failed to recreate depth buffer!" );
+		return false;
+	}
+
 	// Update the SRV to point to the new resource
 	assert( m_srvCpuHandle.ptr != 0 );
 	if ( m_srvCpuHandle.ptr != 0 )
@@ -188,56 +195,115 @@ bool Texture::clearRenderTarget( Device *device, const float clearColor[4] )
 	pix::SetMarker( commandList, pix::MarkerColor::LightRed, "Clear RTV" );
 	commandList->ClearRenderTargetView( m_rtvHandle, clearColor, 0, nullptr );
 
+	if ( m_dsvHandle.ptr != 0 )
+	{
+		pix::SetMarker( commandList, pix::MarkerColor::LightRed, "Clear DSV" );
+		commandList->ClearDepthStencilView( m_dsvHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr );
+	}
+
 	return true;
 }
 
-// TextureManager implementation
-bool TextureManager::initialize( Device *device )
+bool Texture::createDepthBuffer( Device *device )
 {
-	if ( !device )
-	{
-		console::error( "TextureManager::initialize: Invalid device (device == nullptr)" );
+	if ( !device || m_width == 0 || m_height == 0 )
 		return false;
-	}
 
-	m_device = device;
+	m_depthResource.Reset();
+
+	D3D12_HEAP_PROPERTIES depthHeapProps = {};
+	depthHeapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
 
-	// Create RTV descriptor heap for render targets
-	D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-	rtvHeapDesc.NumDescriptors = kMaxTextures;
-	rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-	rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	D3D12_RESOURCE_DESC depthDesc = {};
+	depthDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	depthDesc.Width = m_width;
+	depthDesc.Height = m_height;
+	depthDesc.DepthOrArraySize = 1;
+	depthDesc.MipLevels = 1;
+	depthDesc.Format = DXGI_FORMAT_D32_FLOAT;
+	depthDesc.SampleDesc.Count = 1;
+	depthDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+	D3D12_CLEAR_VALUE depthClearValue = {};
+	depthClearValue.Format = DXGI_FORMAT_D32_FLOAT;
+	depthClearValue.DepthStencil.Depth = 1.0f;
 
 	try
 	{
-		throwIfFailed( device->get()->CreateDescriptorHeap( &rtvHeapDesc, IID_PPV_ARGS( &m_rtvHeap ) ) );
-		m_rtvDescriptorSize = device->get()->GetDescriptorHandleIncrementSize( D3D12_DESCRIPTOR_HEAP_TYPE_RTV );
+		if ( !m_dsvHeap )
+		{
+			D3D12_DESCRIPTOR_HEAP_DESC dsvHeapDesc = {};
+			dsvHeapDesc.NumDescriptors = 1;
+			dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
+			dsvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+			throwIfFailed( device->get()->CreateDescriptorHeap( &dsvHeapDesc, IID_PPV_ARGS( &m_dsvHeap ) ) );
+		}
 
-		// Use ImGui's descriptor heap but reserve indices safely
-		// ImGui typically uses index 0 for font texture, we'll start from index 16 for safety
-		m_srvHeap = device->getImguiDescriptorHeap();
-		m_srvDescriptorSize = device->get()->GetDescriptorHandleIncrementSize( D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV );
+		throwIfFailed( device->get()->CreateCommittedResource(
+			&depthHeapProps,
+			D3D12_HEAP_FLAG_NONE,
+			&depthDesc,
+			D3D12_RESOURCE_STATE_DEPTH_WRITE,
+			&depthClearValue,
+			IID_PPV_ARGS( &m_depthResource ) ) );
+	}
+	catch ( const std::exception & )
+	{
+		m_dsvHandle = {};
+		return false;
+	}
 
-		m_currentRtvIndex = 0;
-		m_currentSrvIndex = 0;
+	D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+	dsvDesc.Format = DXGI_FORMAT_D32_FLOAT;
+	dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+	m_dsvHandle = m_dsvHeap->GetCPUDescriptorHandleForHeapStart();
+	device->get()->CreateDepthStencilView( m_depthResource.Get(), &dsvDesc, m_dsvHandle );
+	return true;
+}
 
-		return true;
+// TextureManager implementation
+bool TextureManager::initialize( Device *device )
+{
+	if ( !device )
+	{
+		console::error( "TextureManager::initialize: Invalid device (device == nullptr)" );
+		return false;
 	}
-	catch ( const std::exception &e )
+
+	if ( m_device == device && m_rtvHeap.isValid() )
+	{
+		return true; // Already initialized by the device
+	}
+	shutdown();
+
+	// RTVs for viewport render targets; SRVs come from the device's shader-visible heap
+	if ( !m_rtvHeap.initialize( device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, kMaxTextures, 0, 0, false, L"Viewport RTVs" ) )
 	{
-		console::error( "TextureManager::initialize: Failed to create RTV heap ({})", e.what() );
+		console::error( "TextureManager::initialize: Failed to create RTV heap" );
 		return false;
 	}
+
+	m_device = device;
+	return true;
 }
 
 void TextureManager::shutdown()
 {
-	// Don't reset m_srvHeap since we don't own it (it's ImGui's heap)
-	m_srvHeap = nullptr;
-	m_rtvHeap.Reset();
+	if ( m_device )
+	{
+		for ( auto &descriptor : m_looseSrvDescriptors )
+		{
+			m_device->getSrvHeap().free( descriptor );
+		}
+	}
+	m_looseSrvDescriptors.clear();
+	m_rtvHeap.shutdown();
 	m_device = nullptr;
-	m_currentRtvIndex = 0;
-	m_currentSrvIndex = 0;
+}
+
+void TextureManager::beginFrame()
+{
+	m_rtvHeap.beginFrame();
 }
 
 std::shared_ptr<Texture> TextureManager::createViewportRenderTarget( UINT width, UINT height )
@@ -255,24 +321,33 @@ std::shared_ptr<Texture> TextureManager::createViewportRenderTarget( UINT width,
 		return std::shared_ptr<Texture>();
 	}
 
-	if ( !m_srvHeap )
+	DescriptorHeap &srvHeap = m_device->getSrvHeap();
+	if ( !srvHeap.isValid() )
 	{
 		console::error( "TextureManager::createViewportRenderTarget: SRV heap is null" );
 		return std::shared_ptr<Texture>();
 	}
 
-	if ( m_currentRtvIndex >= TextureManager::kMaxTextures || m_currentSrvIndex >= TextureManager::kMaxTextures )
+	// Descriptors go back to their heaps when the last reference to the texture is released
+	std::shared_ptr<Texture> texture( new Texture(), [this]( Texture *released ) {
+		releaseDescriptors( *released );
+		delete released;
+	} );
+
+	texture->m_rtvDescriptor = m_rtvHeap.allocate();
+	texture->m_srvDescriptor = srvHeap.allocate();
+	if ( !texture->m_rtvDescriptor.isValid() || !texture->m_srvDescriptor.isValid() )
 	{
+		const auto *rtvAllocator = m_rtvHeap.getAllocator();
+		const auto *srvAllocator = srvHeap.getAllocator();
 		console::error( "TextureManager::createViewportRenderTarget: Descriptor heap full (RTV: {}/{}, SRV: {}/{})",
-			m_currentRtvIndex,
-			TextureManager::kMaxTextures,
-			m_currentSrvIndex,
-			TextureManager::kMaxTextures );
+			rtvAllocator ? rtvAllocator->getStats().persistentDescriptors : 0,
+			rtvAllocator ? rtvAllocator->getPersistentCapacity() : 0,
+			srvAllocator ? srvAllocator->getStats().persistentDescriptors : 0,
+			srvAllocator ? srvAllocator->getPersistentCapacity() : 0 );
 		return std::shared_ptr<Texture>();
 	}
 
-	auto texture = std::make_shared<Texture>();
-
 	// Create the render target
 	if ( !texture->createRenderTarget( m_device, width, height ) )
 	{
@@ -280,48 +355,49 @@ std::shared_ptr<Texture> TextureManager::createViewportRenderTarget( UINT width,
 		return std::shared_ptr<Texture>();
 	}
 
-	// Get RTV handle
-	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
-	rtvHandle.ptr += m_currentRtvIndex * m_rtvDescriptorSize;
-
 	// Create render target view
-	m_device->get()->CreateRenderTargetView( texture->getResource(), nullptr, rtvHandle );
-	texture->m_rtvHandle = rtvHandle;
-
-	// Get SRV handle and create shader resource view
-	D3D12_CPU_DESCRIPTOR_HANDLE srvCpuHandle = m_srvHeap->GetCPUDescriptorHandleForHeapStart();
-	srvCpuHandle.ptr += ( TextureManager::kSrvIndexOffset + m_currentSrvIndex ) * m_srvDescriptorSize;
+	m_device->get()->CreateRenderTargetView( texture->getResource(), nullptr, texture->m_rtvDescriptor.cpuHandle );
+	texture->m_rtvHandle = texture->m_rtvDescriptor.cpuHandle;
 
-	if ( !texture->createShaderResourceView( m_device, srvCpuHandle ) )
+	// Scene content depth tests against the viewport's own depth buffer
+	if ( !texture->createDepthBuffer( m_device ) )
+	{
+		console::error( "TextureManager::createViewportRenderTarget: Failed to create depth buffer {}x{}", width, height );
 		return std::shared_ptr<Texture>();
+	}
 
-	// Store the SRV CPU handle for future updates during resize
-	texture->m_srvCpuHandle = srvCpuHandle;
-
-	// Calculate GPU handle for ImGui using ImGui's heap
-	const D3D12_GPU_DESCRIPTOR_HANDLE gpuHandleStart = m_srvHeap->GetGPUDescriptorHandleForHeapStart();
-	const D3D12_CPU_DESCRIPTOR_HANDLE cpuHandleStart = m_srvHeap->GetCPUDescriptorHandleForHeapStart();
-	const UINT64 offset = srvCpuHandle.ptr - cpuHandleStart.ptr;
-	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle;
-	gpuHandle.ptr = gpuHandleStart.ptr + offset;
-
-	// Store the GPU handle in the texture (need to add this to the texture class)
-	texture->m_srvGpuHandle = gpuHandle;
+	// Create shader resource view in the shader-visible heap so ImGui can sample it
+	if ( !texture->createShaderResourceView( m_device, texture->m_srvDescriptor.cpuHandle ) )
+		return std::shared_ptr<Texture>();
 
-	++m_currentRtvIndex;
-	++m_currentSrvIndex;
+	// Store the SRV handles for future updates during resize and for ImGui
+	texture->m_srvCpuHandle = texture->m_srvDescriptor.cpuHandle;
+	texture->m_srvGpuHandle = texture->m_srvDescriptor.gpuHandle;
 
 	return texture;
 }
 
 D3D12_CPU_DESCRIPTOR_HANDLE TextureManager::getNextSrvHandle()
 {
-	if ( !m_srvHeap || m_currentSrvIndex >= TextureManager::kMaxTextures )
+	if ( !m_device )
 		return {};
 
-	D3D12_CPU_DESCRIPTOR_HANDLE handle = m_srvHeap->GetCPUDescriptorHandleForHeapStart();
-	handle.ptr += ( TextureManager::kSrvIndexOffset + m_currentSrvIndex ) * m_srvDescriptorSize;
-	return handle;
+	Descriptor descriptor = m_device->getSrvHeap().allocate();
+	if ( !descriptor.isValid() )
+		return {};
+
+	m_looseSrvDescriptors.push_back( descriptor );
+	return descriptor.cpuHandle;
+}
+
+void TextureManager::releaseDescriptors( Texture &texture )
+{
+	// After shutdown the heaps are gone along with every descriptor in them
+	if ( !m_device )
+		return;
+
+	m_rtvHeap.free( texture.m_rtvDescriptor );
+	m_device->getSrvHeap().free( texture.m_srvDescriptor );
 }
 
 } // namespace dx12
@@ -83,9 +83,11 @@ struct Visible
 struct MeshRenderer
 {
 	assets::MeshHandle meshHandle = 0; // Handle to the source mesh asset
+	std::weak_ptr<assets::Scene> sourceScene; // Asset scene meshHandle refers to; empty if not imported
 	std::shared_ptr<engine::gpu::MeshGPU> gpuMesh;
 	math::BoundingBox3Df bounds; // Local space bounding box
-	float lodBias = 0.0f;		 // Level of detail bias for rendering
+	float lodBias = 0.0f;		 // LOD selection bias: +1 doubles the tolerated screen error (coarser), -1 halves it
+	bool occluder = false;		 // Always rasterised as an occluder when visible (large meshes are picked automatically)
 
 	MeshRenderer() = default;
 	MeshRenderer( assets::MeshHandle handle ) : meshHandle( handle ) {}
@@ -1,6 +1,7 @@
 #include "runtime/console.h"
 
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <cstdlib>
 #include <stdexcept>
@@ -26,6 +27,13 @@ constexpr const char *YELLOW = "\033[33m";
 constexpr const char *GRAY = "\033[90m";
 constexpr const char *BLUE = "\033[34m";
 
+// Held for a whole line, so messages logged from worker threads do not interleave
+std::mutex &outputMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
 // Windows console color attributes
 #ifdef _WIN32
 constexpr WORD WIN_RED = FOREGROUND_RED | FOREGROUND_INTENSITY;
@@ -75,18 +83,22 @@ void printWithColor( const std::string &message, [[maybe_unused]] const char *an
 
 void fatal( const std::string &message )
 {
-	std::cout << "[FATAL] ";
+	{
+		std::lock_guard lock( outputMutex() );
+		std::cout << "[FATAL] ";
 #ifdef _WIN32
-	printWithColor( message, RED, WIN_RED );
+		printWithColor( message, RED, WIN_RED );
 #else
-	printWithColor( message, RED, 0 );
+		printWithColor( message, RED, 0 );
 #endif
-	std::cout << std::endl;
+		std::cout << std::endl;
+	}
 	std::exit( 1 );
 }
 
 void error( const std::string &message )
 {
+	std::lock_guard lock( outputMutex() );
 	std::cout << "[ERROR] ";
 #ifdef _WIN32
 	printWithColor( message, RED, WIN_RED );
@@ -98,6 +110,7 @@ void error( const std::string &message )
 
 void errorAndThrow( const std::string &message )
 {
+	std::lock_guard lock( outputMutex() );
 	std::cout << "[ERROR] ";
 #ifdef _WIN32
 	printWithColor( message, RED, WIN_RED );
@@ -110,6 +123,7 @@ void errorAndThrow( const std::string &message )
 
 void warning( const std::string &message )
 {
+	std::lock_guard lock( outputMutex() );
 	std::cout << "[WARNING] ";
 #ifdef _WIN32
 	printWithColor( message, YELLOW, WIN_YELLOW );
@@ -121,6 +135,7 @@ void warning( const std::string &message )
 
 void info( const std::string &message )
 {
+	std::lock_guard lock( outputMutex() );
 	std::cout << "[INFO] ";
 #ifdef _WIN32
 	printWithColor( message, GRAY, WIN_GRAY );
@@ -132,6 +147,7 @@ void info( const std::string &message )
 
 void debug( const std::string &message )
 {
+	std::lock_guard lock( outputMutex() );
 	std::cout << "[DEBUG] ";
 #ifdef _WIN32
 	printWithColor( message, BLUE, WIN_BLUE );
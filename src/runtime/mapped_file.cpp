@@ -0,0 +1,146 @@
+#include "runtime/mapped_file.h"
+
+#include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace runtime
+{
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+MappedFile::MappedFile( MappedFile &&other ) noexcept
+	: m_data( std::exchange( other.m_data, nullptr ) ), m_size( std::exchange( other.m_size, 0 ) )
+#ifdef _WIN32
+	  ,
+	  m_mapping( std::exchange( other.m_mapping, nullptr ) )
+#endif
+{
+}
+
+MappedFile &MappedFile::operator=( MappedFile &&other ) noexcept
+{
+	if ( this != &other )
+	{
+		close();
+		m_data = std::exchange( other.m_data, nullptr );
+		m_size = std::exchange( other.m_size, 0 );
+#ifdef _WIN32
+		m_mapping = std::exchange( other.m_mapping, nullptr );
+#endif
+	}
+	return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open( const std::string &path )
+{
+	close();
+
+	const std::filesystem::path filePath( path );
+	HANDLE file = CreateFileW( filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+	if ( file == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize{};
+	if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart <= 0 )
+	{
+		CloseHandle( file );
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	CloseHandle( file ); // The mapping keeps the file open
+	if ( !mapping )
+	{
+		return false;
+	}
+
+	void *view = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	if ( !view )
+	{
+		CloseHandle( mapping );
+		return false;
+	}
+
+	m_mapping = mapping;
+	m_data = static_cast<const std::uint8_t *>( view );
+	m_size = static_cast<std::size_t>( fileSize.QuadPart );
+	return true;
+}
+
+void MappedFile::close() noexcept
+{
+	if ( m_data )
+	{
+		UnmapViewOfFile( m_data );
+	}
+	if ( m_mapping )
+	{
+		CloseHandle( m_mapping );
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_mapping = nullptr;
+}
+
+#else
+
+bool MappedFile::open( const std::string &path )
+{
+	close();
+
+	const int file = ::open( path.c_str(), O_RDONLY );
+	if ( file < 0 )
+	{
+		return false;
+	}
+
+	struct stat status{};
+	if ( fstat( file, &status ) != 0 || status.st_size <= 0 )
+	{
+		::close( file );
+		return false;
+	}
+
+	const auto size = static_cast<std::size_t>( status.st_size );
+	void *view = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, file, 0 );
+	::close( file ); // The mapping keeps the file open
+	if ( view == MAP_FAILED )
+	{
+		return false;
+	}
+	madvise( view, size, MADV_SEQUENTIAL );
+
+	m_data = static_cast<const std::uint8_t *>( view );
+	m_size = size;
+	return true;
+}
+
+void MappedFile::close() noexcept
+{
+	if ( m_data )
+	{
+		munmap( const_cast<std::uint8_t *>( m_data ), m_size );
+	}
+	m_data = nullptr;
+	m_size = 0;
+}
+
+#endif
+
+} // namespace runtime
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace runtime
+{
+
+// Read-only memory mapping of a whole file. Pages are faulted in from the file cache on first access and
+// never copied to the heap, so multi-GB assets cost address space rather than committed memory.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile( const MappedFile & ) = delete;
+	MappedFile &operator=( const MappedFile & ) = delete;
+	MappedFile( MappedFile &&other ) noexcept;
+	MappedFile &operator=( MappedFile &&other ) noexcept;
+
+	// Map the file at path, unmapping any previous file first. Fails for missing and empty files.
+	bool open( const std::string &path );
+	void close() noexcept;
+
+	bool isOpen() const noexcept { return m_data != nullptr; }
+	const std::uint8_t *data() const noexcept { return m_data; }
+	std::size_t size() const noexcept { return m_size; }
+	std::span<const std::uint8_t> bytes() const noexcept { return { m_data, m_size }; }
+
+private:
+	const std::uint8_t *m_data = nullptr;
+	std::size_t m_size = 0;
+#ifdef _WIN32
+	void *m_mapping = nullptr; // File mapping object; the file handle is closed once the view exists
+#endif
+};
+
+} // namespace runtime
@@ -7,10 +7,14 @@
 #include "engine/camera/camera.h"
 #include "engine/gpu/mesh_gpu.h"
 #include "engine/assets/assets.h"
+#include "engine/render_backend/d3d12_command_recorder.h"
+#include "engine/render_queue/draw_submission.h"
 
 #include <d3d12.h>
 #include <wrl.h>
+#include <algorithm>
 #include <cstring>
+#include <thread>
 
 namespace
 {
@@ -36,16 +40,65 @@ bool isEffectivelyVisible( const ecs::Scene &scene, ecs::Entity entity )
 	}
 	return true;
 }
+
+// Decode parameters the layout vertex shaders need for a primitive's vertex buffer
+engine::VertexFormatConstants getVertexFormat( const engine::gpu::PrimitiveGPU &primitive )
+{
+	engine::VertexFormatConstants format;
+	format.layoutKey = primitive.getVertexLayout().getKey();
+	if ( primitive.getVertexLayout().packed )
+	{
+		format.positionOffset = primitive.getPositionQuantization().offset;
+		format.positionScale = primitive.getPositionQuantization().scale;
+	}
+	return format;
+}
+
+// Input elements for a vertex layout. Every semantic is declared so one shader serves all layouts; absent
+// attributes read the first bytes of the vertex and the layout shaders replace them with defaults.
+std::vector<D3D12_INPUT_ELEMENT_DESC> buildInputLayout( const assets::VertexLayout &layout )
+{
+	struct Element
+	{
+		const char *semantic;
+		assets::VertexAttribute attribute;
+		DXGI_FORMAT floatFormat;
+		DXGI_FORMAT packedFormat;
+	};
+	static constexpr Element kElements[] = {
+		{ "POSITION", assets::VertexAttribute::Position, DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R16G16B16A16_SNORM },
+		{ "NORMAL", assets::VertexAttribute::Normal, DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R16G16_SNORM },
+		{ "TEXCOORD", assets::VertexAttribute::TexCoord, DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R16G16_FLOAT },
+		{ "TANGENT", assets::VertexAttribute::Tangent, DXGI_FORMAT_R32G32B32A32_FLOAT, DXGI_FORMAT_R16G16_SNORM },
+		{ "COLOR", assets::VertexAttribute::Color, DXGI_FORMAT_R32G32B32A32_FLOAT, DXGI_FORMAT_R8G8B8A8_UNORM },
+	};
+
+	std::vector<D3D12_INPUT_ELEMENT_DESC> elements;
+	for ( const auto &element : kElements )
+	{
+		const bool present = layout.has( element.attribute );
+		const DXGI_FORMAT format = !present ? DXGI_FORMAT_R8G8B8A8_UNORM : layout.packed ? element.packedFormat : element.floatFormat;
+		const UINT offset = present ? layout.getOffset( element.attribute ) : 0;
+		elements.push_back( { element.semantic, 0, format, 0, offset, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 } );
+	}
+	return elements;
+}
 } // anonymous namespace
 
 namespace systems
 {
 
+// Per-object root constants are uploaded straight from engine::InstanceData
+static_assert( sizeof( ObjectConstants ) == sizeof( engine::InstanceData ), "ObjectConstants must match the instance layout" );
+
 MeshRenderingSystem::MeshRenderingSystem( renderer::Renderer &renderer, std::shared_ptr<shader_manager::ShaderManager> shaderManager, systems::SystemManager *systemManager )
 	: m_renderer( renderer ), m_shaderManager( shaderManager ), m_systemManager( systemManager )
 {
 	createRootSignature();
 
+	// A few bands are enough for the low-resolution occlusion buffer
+	m_occlusionBuffer.setThreadCount( std::clamp( std::thread::hardware_concurrency(), 1u, 4u ) );
+
 	if ( !registerShaders() )
 	{
 		console::error( "MeshRenderingSystem: Failed to register shaders" );
@@ -84,6 +137,19 @@ bool MeshRenderingSystem::registerShaders()
 		return false;
 	}
 
+	// Register instanced vertex shader (world matrices from the instance buffer)
+	m_instancedVertexShaderHandle = m_shaderManager->registerShader(
+		"shaders/unlit.hlsl",
+		"VSMainInstanced",
+		"vs_5_0",
+		shader_manager::ShaderType::Vertex );
+
+	if ( m_instancedVertexShaderHandle == shader_manager::INVALID_SHADER_HANDLE )
+	{
+		console::error( "MeshRenderingSystem: Failed to register instanced vertex shader" );
+		return false;
+	}
+
 	// Register pixel shader
 	m_pixelShaderHandle = m_shaderManager->registerShader(
 		"shaders/unlit.hlsl",
@@ -97,14 +163,33 @@ bool MeshRenderingSystem::registerShaders()
 		return false;
 	}
 
+	// Register the vertex shaders for primitives stored in a non-standard assets::VertexLayout
+	m_layoutVertexShaderHandle = m_shaderManager->registerShader(
+		"shaders/unlit.hlsl",
+		"VSMainLayout",
+		"vs_5_0",
+		shader_manager::ShaderType::Vertex );
+	m_layoutInstancedVertexShaderHandle = m_shaderManager->registerShader(
+		"shaders/unlit.hlsl",
+		"VSMainLayoutInstanced",
+		"vs_5_0",
+		shader_manager::ShaderType::Vertex );
+
+	if ( m_layoutVertexShaderHandle == shader_manager::INVALID_SHADER_HANDLE || m_layoutInstancedVertexShaderHandle == shader_manager::INVALID_SHADER_HANDLE )
+	{
+		console::error( "MeshRenderingSystem: Failed to register vertex layout shaders" );
+		return false;
+	}
+
 	// Set up reload callback for shader hot reloading
 	m_callbackHandle = m_shaderManager->registerReloadCallback(
 		[this]( shader_manager::ShaderHandle handle, const renderer::ShaderBlob &newShader ) {
 			// When shaders are reloaded, invalidate pipeline state cache
-			if ( handle == m_vertexShaderHandle || handle == m_pixelShaderHandle )
+			if ( handle == m_vertexShaderHandle || handle == m_pixelShaderHandle || handle == m_instancedVertexShaderHandle ||
+				handle == m_layoutVertexShaderHandle || handle == m_layoutInstancedVertexShaderHandle )
 			{
 				console::info( "MeshRenderingSystem: Shader reloaded, clearing pipeline state cache" );
-				m_pipelineStateCache.clear();
+				retirePipelineStates();
 			}
 		} );
 
@@ -116,7 +201,19 @@ bool MeshRenderingSystem::registerShaders()
 	return true;
 }
 
-void MeshRenderingSystem::render( ecs::Scene &scene, const camera::Camera &camera )
+void MeshRenderingSystem::render( ecs::Scene &scene, const camera::Camera &camera, float aspectRatio )
+{
+	extractScene( scene );
+	renderView( camera, aspectRatio );
+}
+
+void MeshRenderingSystem::render( ecs::Scene &scene, const camera::Camera &camera, float aspectRatio, engine::render_backend::CommandRecorder &recorder )
+{
+	extractScene( scene );
+	renderView( camera, aspectRatio, recorder );
+}
+
+void MeshRenderingSystem::renderView( const camera::Camera &camera, float aspectRatio )
 {
 	// Get command context for binding
 	auto *commandContext = m_renderer.getCommandContext();
@@ -131,7 +228,188 @@ void MeshRenderingSystem::render( ecs::Scene &scene, const camera::Camera &camer
 		return;
 	}
 
-	// Iterate through all entities to find those with both MeshRenderer and Transform components
+	engine::render_backend::D3D12CommandRecorder recorder( commandList );
+	renderView( camera, aspectRatio, recorder );
+}
+
+void MeshRenderingSystem::renderView( const camera::Camera &camera, float aspectRatio, engine::render_backend::CommandRecorder &recorder )
+{
+	// Cull against the same view-projection the viewport uploads in its frame constants
+	const math::Mat4f projection = camera.getProjectionMatrix( aspectRatio );
+	const math::Mat4f viewProjection = projection * camera.getViewMatrix();
+	cullView( viewProjection );
+
+	buildRenderQueue( viewProjection, m_lodEnabled ? projection.row1.y : 0.0f );
+
+	const auto &tables = m_extract.getTables();
+	const auto &worldMatrices = m_extract.getWorldMatrices();
+	if ( !m_instancingEnabled )
+	{
+		// Submit sorted draws; the queue only calls back when pipeline, material, geometry or object changes
+		m_renderQueueStats = engine::submitRenderQueue( m_renderQueue, tables, worldMatrices, recorder );
+		m_frameStats.drawCalls += m_renderQueueStats.drawCount;
+		m_frameStats.instances += m_renderQueueStats.drawCount;
+		return;
+	}
+
+	// Collapse runs of identical state into instanced draws and upload their world matrices
+	m_instanceBatcher.build( m_renderQueue, worldMatrices );
+	const auto &instances = m_instanceBatcher.getInstances();
+	if ( instances.empty() )
+	{
+		m_renderQueueStats = {};
+		return;
+	}
+	if ( !reserveInstanceSpace( static_cast<std::uint32_t>( instances.size() ) ) )
+	{
+		return;
+	}
+
+	std::memcpy( m_instanceBufferData + m_instanceBufferCursor, instances.data(), instances.size() * sizeof( engine::InstanceData ) );
+	m_renderQueueStats = engine::submitInstanceBatches( m_instanceBatcher, tables, m_instanceBuffer->GetGPUVirtualAddress(), m_instanceBufferCursor, recorder );
+	m_instanceBufferCursor += static_cast<std::uint32_t>( instances.size() );
+
+	m_frameStats.drawCalls += m_renderQueueStats.drawCount;
+	m_frameStats.instancedDrawCalls += m_renderQueueStats.drawCount;
+	m_frameStats.instances += static_cast<std::uint32_t>( instances.size() );
+}
+
+void MeshRenderingSystem::beginFrame()
+{
+	// The device waits for the previous frame after present, so the whole buffer is free again
+	m_instanceBufferCursor = 0;
+	m_retiredInstanceBuffers.clear();
+	m_retiredPipelineStates.clear();
+	m_frameStats = {};
+}
+
+void MeshRenderingSystem::retirePipelineStates()
+{
+	for ( auto *cache : { &m_pipelineStateCache, &m_instancedPipelineStateCache } )
+	{
+		for ( auto &[key, pipelineState] : *cache )
+		{
+			m_retiredPipelineStates.push_back( std::move( pipelineState ) );
+		}
+		cache->clear();
+	}
+
+	// The frame lookups and the extract's pipeline table point into the caches; the next extractScene() rebuilds them
+	m_framePipelines.clear();
+	m_candidates.clear();
+	m_extract.clear();
+}
+
+bool MeshRenderingSystem::reserveInstanceSpace( std::uint32_t count )
+{
+	if ( m_instanceBuffer && m_instanceBufferCursor + count <= m_instanceBufferCapacity )
+	{
+		return true;
+	}
+
+	// Earlier draws this frame may still reference the current buffer; keep it alive until beginFrame()
+	if ( m_instanceBuffer )
+	{
+		m_instanceBuffer->Unmap( 0, nullptr );
+		m_retiredInstanceBuffers.push_back( m_instanceBuffer );
+		m_instanceBuffer.Reset();
+		m_instanceBufferData = nullptr;
+	}
+
+	constexpr std::uint32_t kMinInstanceCapacity = 1024;
+	const std::uint32_t capacity = std::max( { count, m_instanceBufferCapacity * 2, kMinInstanceCapacity } );
+
+	D3D12_HEAP_PROPERTIES heapProps = {};
+	heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+	D3D12_RESOURCE_DESC resourceDesc = {};
+	resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	resourceDesc.Width = static_cast<UINT64>( capacity ) * sizeof( engine::InstanceData );
+	resourceDesc.Height = 1;
+	resourceDesc.DepthOrArraySize = 1;
+	resourceDesc.MipLevels = 1;
+	resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+	resourceDesc.SampleDesc.Count = 1;
+	resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	auto &device = m_renderer.getDevice();
+	HRESULT hr = device->CreateCommittedResource( &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS( &m_instanceBuffer ) );
+	if ( FAILED( hr ) )
+	{
+		console::error( "MeshRenderingSystem: Failed to create instance buffer" );
+		m_instanceBufferCapacity = 0;
+		return false;
+	}
+
+	// Persistently mapped; the CPU never reads it back
+	const D3D12_RANGE readRange = { 0, 0 };
+	hr = m_instanceBuffer->Map( 0, &readRange, reinterpret_cast<void **>( &m_instanceBufferData ) );
+	if ( FAILED( hr ) )
+	{
+		console::error( "MeshRenderingSystem: Failed to map instance buffer" );
+		m_instanceBuffer.Reset();
+		m_instanceBufferCapacity = 0;
+		return false;
+	}
+
+	m_instanceBufferCapacity = capacity;
+	m_instanceBufferCursor = 0;
+	return true;
+}
+
+void MeshRenderingSystem::buildRenderQueue( const math::Mat4f &viewProjection, float lodProjectionScale )
+{
+	// Residency is requested per view, so meshes evicted at extract time get their draws resolved here
+	m_viewObjects.clear();
+	for ( const std::uint32_t index : m_visibleIndices )
+	{
+		const auto &candidate = m_candidates[index];
+		if ( m_residencyProvider && !m_residencyProvider->requestResident( *candidate.gpuMesh ) )
+		{
+			continue;
+		}
+		if ( !candidate.drawsExtracted )
+		{
+			extractDraws( index );
+			if ( !candidate.drawsExtracted )
+			{
+				continue;
+			}
+		}
+		m_viewObjects.push_back( index );
+	}
+
+	m_lodStats = engine::buildViewQueue( m_extract, m_viewObjects, viewProjection, engine::ViewLodParams{ lodProjectionScale, m_lodScreenErrorThreshold }, m_renderQueue );
+	if ( m_renderQueue.getSaturatedDrawCount() > 0 && !m_sortKeySaturationReported )
+	{
+		console::warning( "MeshRenderingSystem: {} draws have state ids wider than the render queue sort key; sorting on full ids",
+			m_renderQueue.getSaturatedDrawCount() );
+		m_sortKeySaturationReported = true;
+	}
+}
+
+void MeshRenderingSystem::requestResidency( std::span<const std::uint32_t> objects )
+{
+	if ( !m_residencyProvider )
+	{
+		return;
+	}
+	for ( const std::uint32_t index : objects )
+	{
+		if ( index < m_candidates.size() )
+		{
+			m_residencyProvider->requestResident( *m_candidates[index].gpuMesh );
+		}
+	}
+}
+
+void MeshRenderingSystem::extractScene( ecs::Scene &scene )
+{
+	m_candidates.clear();
+	m_extract.clear();
+	m_framePipelines.clear();
+
+	// Gather entities with both MeshRenderer and Transform components that can actually be drawn
 	const auto allEntities = scene.getAllEntities();
 	for ( const auto entity : allEntities )
 	{
@@ -140,25 +418,176 @@ void MeshRenderingSystem::render( ecs::Scene &scene, const camera::Camera &camer
 			continue;
 		}
 
-		// Check if entity has both required components
 		const auto *transform = scene.getComponent<components::Transform>( entity );
 		const auto *meshRenderer = scene.getComponent<components::MeshRenderer>( entity );
+		if ( !transform || !meshRenderer || !meshRenderer->gpuMesh )
+		{
+			continue;
+		}
 
-		if ( transform && meshRenderer )
+		// Check hierarchical visibility - skip rendering if entity or any ancestor is invisible
+		if ( !isEffectivelyVisible( scene, entity ) )
 		{
-			// Check hierarchical visibility - skip rendering if entity or any ancestor is invisible
-			if ( !isEffectivelyVisible( scene, entity ) )
+			continue;
+		}
+
+		const math::Mat4f worldMatrix = getEntityWorldMatrix( scene, entity );
+
+		// Entities without valid local bounds are never culled
+		const auto worldBounds = meshRenderer->bounds.isValid() ?
+			engine::culling::transformBounds( meshRenderer->bounds, worldMatrix ) :
+			engine::culling::infiniteBounds();
+
+		const auto index = m_extract.addObject( worldMatrix, worldBounds, meshRenderer->lodBias );
+		m_candidates.push_back( RenderCandidate{ entity, meshRenderer->gpuMesh.get(), meshRenderer->occluder } );
+		extractDraws( index );
+	}
+}
+
+void MeshRenderingSystem::extractDraws( std::uint32_t index )
+{
+	auto &candidate = m_candidates[index];
+	const auto &gpuMesh = *candidate.gpuMesh;
+	m_extract.restartDraws( index );
+
+	// Evicted meshes are resolved later, once a view has requested them
+	candidate.drawsExtracted = gpuMesh.isValid();
+	if ( !candidate.drawsExtracted )
+	{
+		return;
+	}
+
+	for ( std::uint32_t i = 0; i < gpuMesh.getPrimitiveCount(); ++i )
+	{
+		const auto &primitive = gpuMesh.getPrimitive( i );
+		if ( !primitive.isValid() || !primitive.hasMaterial() )
+		{
+			continue;
+		}
+
+		const auto *material = primitive.getMaterial().get();
+		auto [it, inserted] = m_framePipelines.try_emplace( { material, primitive.getVertexLayout().getKey() } );
+		if ( inserted )
+		{
+			// Both variants, since views submit either per object or instanced (the render thread always per object)
+			it->second = { getMaterialPipelineState( *material, false, primitive.getVertexLayout() ),
+				getMaterialPipelineState( *material, true, primitive.getVertexLayout() ) };
+		}
+		const auto [pipelineState, instancedPipelineState] = it->second;
+		if ( !pipelineState || !instancedPipelineState )
+		{
+			continue;
+		}
+
+		engine::ExtractedDraw draw;
+		draw.pipelineId = m_extract.resolvePipeline( pipelineState, instancedPipelineState );
+		draw.materialId = m_extract.resolveMaterial( material, material->isValid() ? material->getConstantBufferAddress() : 0 );
+		draw.lodCount = primitive.getLodCount();
+		draw.lodErrors = primitive.getLodErrors();
+		draw.geometryId = m_extract.resolveGeometry( &primitive, draw.lodCount, [&primitive]( std::uint32_t level ) {
+			const auto &lodRange = primitive.getLodRange( level );
+			engine::GeometryBinding geometry;
+			geometry.vertexBuffer = engine::render_backend::D3D12CommandRecorder::toVertexBufferView( primitive.getVertexBufferView() );
+			geometry.vertexCount = primitive.getVertexCount();
+			geometry.baseVertex = primitive.getBaseVertex();
+			geometry.vertexFormat = getVertexFormat( primitive );
+			if ( primitive.hasIndexBuffer() )
 			{
-				// Entity or one of its ancestors is marked as invisible, skip rendering
-				continue;
+				geometry.indexBuffer = engine::render_backend::D3D12CommandRecorder::toIndexBufferView( primitive.getIndexBufferView() );
+				geometry.indexCount = lodRange.indexCount;
+				geometry.firstIndex = primitive.getStartIndex() + lodRange.firstIndex;
 			}
+			return geometry;
+		} );
+		m_extract.addDraw( draw );
+	}
+}
+
+void MeshRenderingSystem::buildVisibleList( ecs::Scene &scene, const math::Mat4f &viewProjection )
+{
+	extractScene( scene );
+	cullView( viewProjection );
+}
 
-			// Use the new hierarchy-aware renderEntity method
-			renderEntity( scene, entity, camera );
+void MeshRenderingSystem::cullView( const math::Mat4f &viewProjection )
+{
+	if ( m_frustumCullingEnabled )
+	{
+		const auto frustum = math::Frustum<float>::fromViewProjection( viewProjection );
+		m_cullingStats = engine::culling::cullBounds( frustum, m_extract.getBounds(), m_visibleIndices );
+	}
+	else
+	{
+		m_visibleIndices.resize( m_candidates.size() );
+		for ( std::uint32_t i = 0; i < m_visibleIndices.size(); ++i )
+		{
+			m_visibleIndices[i] = i;
 		}
+		const auto count = static_cast<std::uint32_t>( m_candidates.size() );
+		m_cullingStats = engine::culling::CullingStats{ count, count };
+	}
+
+	// beginFrame() also resets the occlusion statistics when the stage is skipped
+	m_occlusionBuffer.beginFrame( viewProjection );
+	if ( m_occlusionCullingEnabled )
+	{
+		cullOccludedCandidates();
 	}
 }
 
+void MeshRenderingSystem::cullOccludedCandidates()
+{
+	// Flagged occluders first, then the largest on screen
+	m_occluderCandidates.clear();
+	for ( const std::uint32_t index : m_visibleIndices )
+	{
+		const auto &candidate = m_candidates[index];
+		if ( candidate.gpuMesh->getOccluderMesh().empty() )
+		{
+			continue;
+		}
+		const float coverage = m_occlusionBuffer.screenCoverage( m_extract.getBounds().get( index ) );
+		if ( candidate.occluder || coverage >= m_autoOccluderMinCoverage )
+		{
+			m_occluderCandidates.emplace_back( candidate.occluder ? coverage + 2.0f : coverage, index );
+		}
+	}
+	if ( m_occluderCandidates.empty() )
+	{
+		return;
+	}
+
+	std::sort( m_occluderCandidates.begin(), m_occluderCandidates.end(), []( const auto &lhs, const auto &rhs ) {
+		return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+	} );
+	if ( m_occluderCandidates.size() > m_maxOccluders )
+	{
+		m_occluderCandidates.resize( m_maxOccluders );
+	}
+
+	m_isOccluder.assign( m_candidates.size(), 0 );
+	for ( const auto &[score, index] : m_occluderCandidates )
+	{
+		m_occlusionBuffer.addOccluder( m_candidates[index].gpuMesh->getOccluderMesh(), m_extract.getWorldMatrices()[index] );
+		m_isOccluder[index] = 1;
+	}
+	m_occlusionBuffer.rasterize();
+
+	// Occluders stay visible; their own bounds would otherwise test against their own depth
+	m_occlusionBuffer.cullOccluded( m_extract.getBounds(), m_visibleIndices, m_isOccluder );
+}
+
+std::vector<ecs::Entity> MeshRenderingSystem::getVisibleEntities() const
+{
+	std::vector<ecs::Entity> entities;
+	entities.reserve( m_visibleIndices.size() );
+	for ( const std::uint32_t index : m_visibleIndices )
+	{
+		entities.push_back( m_candidates[index].entity );
+	}
+	return entities;
+}
+
 void MeshRenderingSystem::renderEntity( ecs::Scene &scene, ecs::Entity entity, const camera::Camera &camera )
 {
 	// Get components
@@ -189,30 +618,28 @@ void MeshRenderingSystem::renderEntity( ecs::Scene &scene, ecs::Entity entity, c
 		return;
 	}
 
-	// Calculate world matrix using TransformSystem if available, otherwise use local transform
-	math::Mat4<> worldMatrix;
+	drawMesh( commandList, *meshRenderer, getEntityWorldMatrix( scene, entity ) );
+}
+
+math::Mat4f MeshRenderingSystem::getEntityWorldMatrix( ecs::Scene &scene, ecs::Entity entity )
+{
 	if ( m_systemManager )
 	{
 		auto *transformSystem = m_systemManager->getSystem<systems::TransformSystem>();
 		if ( transformSystem )
 		{
 			// Use world transform from TransformSystem (supports parent-child hierarchy)
-			worldMatrix = transformSystem->getWorldTransform( scene, entity );
-		}
-		else
-		{
-			// Fallback to local transform if TransformSystem not available
-			const auto *transform = scene.getComponent<components::Transform>( entity );
-			worldMatrix = transform ? transform->getLocalMatrix() : math::Mat4<>::identity();
+			return transformSystem->getWorldTransform( scene, entity );
 		}
 	}
-	else
-	{
-		// Fallback to local transform if SystemManager not available
-		const auto *transform = scene.getComponent<components::Transform>( entity );
-		worldMatrix = transform ? transform->getLocalMatrix() : math::Mat4<>::identity();
-	}
 
+	// Fallback to local transform if SystemManager or TransformSystem not available
+	const auto *transform = scene.getComponent<components::Transform>( entity );
+	return transform ? transform->getLocalMatrix() : math::Mat4<>::identity();
+}
+
+void MeshRenderingSystem::drawMesh( ID3D12GraphicsCommandList *commandList, const components::MeshRenderer &meshRenderer, const math::Mat4f &worldMatrix )
+{
 	// Calculate object constants for this entity
 	ObjectConstants objectConstants;
 	// HLSL expects column-major matrices when using mul(matrix, vector)
@@ -226,7 +653,7 @@ void MeshRenderingSystem::renderEntity( ecs::Scene &scene, ecs::Entity entity, c
 	// Bind object constants to register b1 using root constants
 	commandList->SetGraphicsRoot32BitConstants( 1, sizeof( ObjectConstants ) / 4, &objectConstants, 0 );
 
-	const auto &gpuMesh = *meshRenderer->gpuMesh;
+	const auto &gpuMesh = *meshRenderer.gpuMesh;
 	if ( !gpuMesh.isValid() )
 	{
 		return;
@@ -247,20 +674,25 @@ void MeshRenderingSystem::renderEntity( ecs::Scene &scene, ecs::Entity entity, c
 		// Get and set the appropriate pipeline state for the material
 		if ( primitive.hasMaterial() )
 		{
-			auto *pipelineState = getMaterialPipelineState( *primitive.getMaterial() );
+			auto *pipelineState = getMaterialPipelineState( *primitive.getMaterial(), false, primitive.getVertexLayout() );
 			if ( pipelineState )
 			{
 				commandList->SetPipelineState( pipelineState );
+				if ( !primitive.getVertexLayout().isStandard() )
+				{
+					const auto vertexFormat = getVertexFormat( primitive );
+					commandList->SetGraphicsRoot32BitConstants( engine::mesh_root_parameter::kVertexFormat, sizeof( vertexFormat ) / 4, &vertexFormat, 0 );
+				}
 				// Issue the draw call
 				if ( primitive.hasIndexBuffer() )
 				{
 					// Indexed drawing
-					commandList->DrawIndexedInstanced( primitive.getIndexCount(), 1, 0, 0, 0 );
+					commandList->DrawIndexedInstanced( primitive.getIndexCount(), 1, primitive.getStartIndex(), primitive.getBaseVertex(), 0 );
 				}
 				else
 				{
 					// Non-indexed drawing
-					commandList->DrawInstanced( primitive.getVertexCount(), 1, 0, 0 );
+					commandList->DrawInstanced( primitive.getVertexCount(), 1, static_cast<UINT>( primitive.getBaseVertex() ), 0 );
 				}
 			}
 		}
@@ -293,7 +725,10 @@ void MeshRenderingSystem::createRootSignature()
 	// b0 - Frame constants (view/projection matrices) - using CBV (too large for root constants)
 	// b1 - Object constants (world matrix) - using root constants for better performance
 	// b2 - Material constants (base color, etc.) - using CBV
-	D3D12_ROOT_PARAMETER rootParams[3] = {};
+	// t0 (space1) - Instance data for instanced draws - root SRV
+	// b3 - Instance offset for instanced draws - single root constant
+	// b4 - Vertex format for packed and trimmed vertex layouts - root constants
+	D3D12_ROOT_PARAMETER rootParams[6] = {};
 
 	// Frame constants (b0) - using CBV since it's too large for root constants (68 DWORDs > 64 limit)
 	rootParams[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
@@ -314,8 +749,28 @@ void MeshRenderingSystem::createRootSignature()
 	rootParams[2].Descriptor.RegisterSpace = 0;
 	rootParams[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
+	// Instance data (t0, space1) - root SRV so the per-frame buffer needs no descriptor heap
+	rootParams[3].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	rootParams[3].Descriptor.ShaderRegister = 0; // t0
+	rootParams[3].Descriptor.RegisterSpace = 1;
+	rootParams[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+	// Instance offset (b3)
+	rootParams[4].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+	rootParams[4].Constants.ShaderRegister = 3; // b3
+	rootParams[4].Constants.RegisterSpace = 0;
+	rootParams[4].Constants.Num32BitValues = 1;
+	rootParams[4].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+	// Vertex format (b4)
+	rootParams[5].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+	rootParams[5].Constants.ShaderRegister = 4; // b4
+	rootParams[5].Constants.RegisterSpace = 0;
+	rootParams[5].Constants.Num32BitValues = sizeof( engine::VertexFormatConstants ) / 4;
+	rootParams[5].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
 	D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {};
-	rootSigDesc.NumParameters = 3;
+	rootSigDesc.NumParameters = _countof( rootParams );
 	rootSigDesc.pParameters = rootParams;
 	rootSigDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
@@ -328,7 +783,7 @@ void MeshRenderingSystem::createRootSignature()
 	}
 }
 
-ID3D12PipelineState *MeshRenderingSystem::getMaterialPipelineState( const engine::gpu::MaterialGPU &material )
+ID3D12PipelineState *MeshRenderingSystem::getMaterialPipelineState( const engine::gpu::MaterialGPU &material, bool instanced, const assets::VertexLayout &layout )
 {
 	// Generate cache key based on material properties
 	auto *sourceMaterial = material.getSourceMaterial().get();
@@ -337,27 +792,32 @@ ID3D12PipelineState *MeshRenderingSystem::getMaterialPipelineState( const engine
 		return nullptr;
 	}
 
-	const std::string cacheKey = sourceMaterial->getPath();
+	std::string cacheKey = sourceMaterial->getPath();
+	if ( !layout.isStandard() )
+	{
+		cacheKey += "#layout" + std::to_string( layout.getKey() );
+	}
 
 	// Check if pipeline state is already cached
-	auto it = m_pipelineStateCache.find( cacheKey );
-	if ( it != m_pipelineStateCache.end() )
+	auto &cache = instanced ? m_instancedPipelineStateCache : m_pipelineStateCache;
+	auto it = cache.find( cacheKey );
+	if ( it != cache.end() )
 	{
 		return it->second.Get();
 	}
 
 	// Create new pipeline state for this material
-	auto pipelineState = createMaterialPipelineState( material );
+	auto pipelineState = createMaterialPipelineState( material, instanced, layout );
 	if ( pipelineState )
 	{
-		m_pipelineStateCache[cacheKey] = pipelineState;
+		cache[cacheKey] = pipelineState;
 		return pipelineState.Get();
 	}
 
 	return nullptr;
 }
 
-Microsoft::WRL::ComPtr<ID3D12PipelineState> MeshRenderingSystem::createMaterialPipelineState( const engine::gpu::MaterialGPU &material )
+Microsoft::WRL::ComPtr<ID3D12PipelineState> MeshRenderingSystem::createMaterialPipelineState( const engine::gpu::MaterialGPU &material, bool instanced, const assets::VertexLayout &layout )
 {
 	// Get device from renderer
 	auto &device = m_renderer.getDevice();
@@ -369,7 +829,9 @@ Microsoft::WRL::ComPtr<ID3D12PipelineState> MeshRenderingSystem::createMaterialP
 	if ( m_shaderManager )
 	{
 		// Get current shader blobs from shader manager
-		const renderer::ShaderBlob *vertexShader = m_shaderManager->getShaderBlob( m_vertexShaderHandle );
+		const auto vertexShaderHandle = layout.isStandard() ? ( instanced ? m_instancedVertexShaderHandle : m_vertexShaderHandle ) :
+															   ( instanced ? m_layoutInstancedVertexShaderHandle : m_layoutVertexShaderHandle );
+		const renderer::ShaderBlob *vertexShader = m_shaderManager->getShaderBlob( vertexShaderHandle );
 		const renderer::ShaderBlob *pixelShader = m_shaderManager->getShaderBlob( m_pixelShaderHandle );
 
 		if ( !vertexShader || !pixelShader || !vertexShader->isValid() || !pixelShader->isValid() )
@@ -387,17 +849,11 @@ Microsoft::WRL::ComPtr<ID3D12PipelineState> MeshRenderingSystem::createMaterialP
 		return nullptr;
 	}
 
-	// Create pipeline state
-	const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-		{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-		{ "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-		{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-		{ "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-		{ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 48, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
-	};
+	// Create pipeline state; the standard layout yields the assets::Vertex float elements
+	const auto inputLayout = buildInputLayout( layout );
 
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
-	psoDesc.InputLayout = { inputLayout, _countof( inputLayout ) };
+	psoDesc.InputLayout = { inputLayout.data(), static_cast<UINT>( inputLayout.size() ) };
 	psoDesc.pRootSignature = m_rootSignature.Get(); // Use our managed root signature
 	psoDesc.VS = { vsBlob->GetBufferPointer(), vsBlob->GetBufferSize() };
 	psoDesc.PS = { psBlob->GetBufferPointer(), psBlob->GetBufferSize() };
@@ -409,10 +865,11 @@ Microsoft::WRL::ComPtr<ID3D12PipelineState> MeshRenderingSystem::createMaterialP
 	psoDesc.NumRenderTargets = 1;
 	psoDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
 	psoDesc.SampleDesc.Count = 1;
-	// Depth stencil state (disable depth testing for viewport rendering)
-	psoDesc.DepthStencilState.DepthEnable = FALSE; // Disable depth testing
-	psoDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
-	psoDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_ALWAYS;
+	// Opaque pass: depth tested and written, so the queue's front-to-back order rejects hidden pixels early
+	psoDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	psoDesc.DepthStencilState.DepthEnable = TRUE;
+	psoDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+	psoDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
 	psoDesc.DepthStencilState.StencilEnable = FALSE;
 
 	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
@@ -2,11 +2,23 @@
 
 #include <d3d12.h>
 #include <wrl.h>
+#include <map>
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "math/math.h"
 #include "math/matrix.h"
+#include "engine/assets/vertex_layout.h"
+#include "engine/culling/frustum_culling.h"
+#include "engine/culling/occlusion_culling.h"
+#include "engine/render_backend/command_recorder.h"
+#include "engine/render_queue/draw_submission.h"
+#include "engine/render_queue/instance_batcher.h"
+#include "engine/render_queue/render_queue.h"
+#include "engine/render_queue/scene_extract.h"
 #include "engine/shader_manager/shader_manager.h"
 #include "systems.h"
 
@@ -17,6 +29,9 @@ class Camera;
 namespace engine::gpu
 {
 class MaterialGPU;
+class MeshGPU;
+class PrimitiveGPU;
+class ResidencyProvider;
 }
 
 namespace systems
@@ -31,6 +46,17 @@ struct ObjectConstants
 	ObjectConstants() = default;
 };
 
+// Draw statistics accumulated across all render() calls since beginFrame()
+struct MeshRenderingFrameStats
+{
+	std::uint32_t drawCalls = 0;
+	std::uint32_t instancedDrawCalls = 0;
+	std::uint32_t instances = 0;
+};
+
+// Level of detail chosen by the last buildRenderQueue()
+using MeshLodStats = engine::ViewQueueStats;
+
 class MeshRenderingSystem : public System
 {
 public:
@@ -40,7 +66,87 @@ public:
 		std::shared_ptr<shader_manager::ShaderManager> shaderManager,
 		systems::SystemManager *systemManager );
 	void update( ecs::Scene &scene, float deltaTime ) override;
-	void render( ecs::Scene &scene, const camera::Camera &camera );
+	// Single view: extractScene() followed by renderView()
+	void render( ecs::Scene &scene, const camera::Camera &camera, float aspectRatio = kDefaultAspectRatio );
+
+	// Same render path recorded through any backend (e.g. RecordingCommandRecorder for headless profiling)
+	void render( ecs::Scene &scene, const camera::Camera &camera, float aspectRatio, engine::render_backend::CommandRecorder &recorder );
+
+	// Extract stage, once per frame: gathers drawable entities with their world matrices, bounds and
+	// effective visibility, and resolves every primitive's pipeline, material and geometry ids.
+	// Several viewports of the same scene then call renderView() against this one extract.
+	void extractScene( ecs::Scene &scene );
+	const engine::SceneExtract &getSceneExtract() const noexcept { return m_extract; }
+
+	// Per-view stage over the current extract: cull, build and sort the queue, batch and submit
+	void renderView( const camera::Camera &camera, float aspectRatio );
+	void renderView( const camera::Camera &camera, float aspectRatio, engine::render_backend::CommandRecorder &recorder );
+
+	// Start a new frame: recycles the instance buffer and resets frame statistics.
+	// Call once per frame before the first render() (several viewports may render per frame).
+	void beginFrame();
+	const MeshRenderingFrameStats &getFrameStats() const noexcept { return m_frameStats; }
+
+	// Visibility stage: gathers renderable entities, computes their world bounds and frustum-culls them
+	// against viewProjection. The resulting visible list is what render() draws.
+	void buildVisibleList( ecs::Scene &scene, const math::Mat4f &viewProjection );
+
+	// Cull the current extract for one view (frustum, then occlusion)
+	void cullView( const math::Mat4f &viewProjection );
+
+	// Entities that survived the last visibility stage, in submission order
+	std::vector<ecs::Entity> getVisibleEntities() const;
+	const engine::culling::CullingStats &getCullingStats() const noexcept { return m_cullingStats; }
+
+	// Frustum culling can be disabled for debugging; all gathered entities are then visible
+	void setFrustumCullingEnabled( bool enabled ) noexcept { m_frustumCullingEnabled = enabled; }
+	bool isFrustumCullingEnabled() const noexcept { return m_frustumCullingEnabled; }
+
+	// Occlusion culling runs after frustum culling: occluders (MeshRenderer::occluder, or meshes whose screen
+	// rectangle covers at least the auto-occluder fraction of the view) are rasterised on the CPU and
+	// the remaining visible bounds are tested against them. Occluders are treated as double-sided.
+	void setOcclusionCullingEnabled( bool enabled ) noexcept { m_occlusionCullingEnabled = enabled; }
+	bool isOcclusionCullingEnabled() const noexcept { return m_occlusionCullingEnabled; }
+	void setMaxOccluders( std::uint32_t count ) noexcept { m_maxOccluders = count; }
+	std::uint32_t getMaxOccluders() const noexcept { return m_maxOccluders; }
+	void setAutoOccluderMinCoverage( float coverage ) noexcept { m_autoOccluderMinCoverage = coverage; }
+	float getAutoOccluderMinCoverage() const noexcept { return m_autoOccluderMinCoverage; }
+	const engine::culling::OcclusionStats &getOcclusionStats() const noexcept { return m_occlusionBuffer.getStats(); }
+	const engine::culling::OcclusionBuffer &getOcclusionBuffer() const noexcept { return m_occlusionBuffer; }
+
+	// Queue stage: turns every primitive of the visible list into a keyed draw and sorts by
+	// pass, pipeline, material, geometry, then front-to-back depth. render() submits this queue.
+	// A non-zero lodProjectionScale (projection.row1.y) selects each primitive's level of detail.
+	void buildRenderQueue( const math::Mat4f &viewProjection, float lodProjectionScale = 0.0f );
+	const engine::RenderQueue &getRenderQueue() const noexcept { return m_renderQueue; }
+
+	// State changes actually issued by the last render() (redundant binds are elided)
+	const engine::RenderQueueStats &getRenderQueueStats() const noexcept { return m_renderQueueStats; }
+
+	// Instancing: queued draws sharing primitive and material are drawn with one instanced call,
+	// world matrices coming from a per-frame instance buffer. Disable to fall back to per-object draws.
+	void setInstancingEnabled( bool enabled ) noexcept { m_instancingEnabled = enabled; }
+	bool isInstancingEnabled() const noexcept { return m_instancingEnabled; }
+	const engine::InstanceBatcher &getInstanceBatcher() const noexcept { return m_instanceBatcher; }
+
+	// Level of detail: the coarsest level whose error projects below the threshold (fraction of the
+	// viewport height) is drawn; MeshRenderer::lodBias scales the threshold by 2^lodBias.
+	void setLodEnabled( bool enabled ) noexcept { m_lodEnabled = enabled; }
+	bool isLodEnabled() const noexcept { return m_lodEnabled; }
+	void setLodScreenErrorThreshold( float threshold ) noexcept { m_lodScreenErrorThreshold = threshold; }
+	float getLodScreenErrorThreshold() const noexcept { return m_lodScreenErrorThreshold; }
+	const MeshLodStats &getLodStats() const noexcept { return m_lodStats; }
+
+	// About one pixel on a 1080 pixel high viewport
+	static constexpr float kDefaultLodScreenErrorThreshold = 1.0f / 1080.0f;
+
+	// Residency: every visible mesh is requested from the provider while building the render queue, which
+	// re-uploads evicted geometry and keeps the visible set out of eviction. Null draws whatever is resident.
+	void setResidencyProvider( engine::gpu::ResidencyProvider *provider ) noexcept { m_residencyProvider = provider; }
+
+	// Residency for extract objects culled outside renderView() (e.g. by the render thread): requests their
+	// meshes, so an object evicted at extract time is drawn again from the next extract on
+	void requestResidency( std::span<const std::uint32_t> objects );
 
 	// Public for testing
 	math::Mat4f calculateMVPMatrix(
@@ -50,13 +156,25 @@ public:
 	// Render entity using world transform from TransformSystem (supports hierarchy)
 	void renderEntity( ecs::Scene &scene, ecs::Entity entity, const camera::Camera &camera );
 
-	// Pipeline state management for materials
-	ID3D12PipelineState *getMaterialPipelineState( const engine::gpu::MaterialGPU &material );
+	// Pipeline state management for materials; non-standard vertex layouts use the VSMainLayout entry points
+	ID3D12PipelineState *getMaterialPipelineState( const engine::gpu::MaterialGPU &material, bool instanced = false, const assets::VertexLayout &layout = {} );
 
 	// Root signature management - must be called before binding any parameters
 	void setRootSignature( ID3D12GraphicsCommandList *commandList );
 
+	// Aspect ratio used when the caller does not provide one (matches calculateMVPMatrix)
+	static constexpr float kDefaultAspectRatio = 16.0f / 9.0f;
+
 private:
+	// Renderable gathered by the extract stage; index i matches object i of m_extract
+	struct RenderCandidate
+	{
+		ecs::Entity entity;
+		const engine::gpu::MeshGPU *gpuMesh = nullptr;
+		bool occluder = false;
+		bool drawsExtracted = false; // False while the mesh was evicted during extraction
+	};
+
 	renderer::Renderer &m_renderer;
 	std::shared_ptr<shader_manager::ShaderManager> m_shaderManager;
 	systems::SystemManager *m_systemManager = nullptr;
@@ -64,18 +182,80 @@ private:
 	// Shader handles for the unlit shader
 	shader_manager::ShaderHandle m_vertexShaderHandle = shader_manager::INVALID_SHADER_HANDLE;
 	shader_manager::ShaderHandle m_pixelShaderHandle = shader_manager::INVALID_SHADER_HANDLE;
+	shader_manager::ShaderHandle m_instancedVertexShaderHandle = shader_manager::INVALID_SHADER_HANDLE;
+	shader_manager::ShaderHandle m_layoutVertexShaderHandle = shader_manager::INVALID_SHADER_HANDLE;
+	shader_manager::ShaderHandle m_layoutInstancedVertexShaderHandle = shader_manager::INVALID_SHADER_HANDLE;
 	shader_manager::CallbackHandle m_callbackHandle = shader_manager::INVALID_CALLBACK_HANDLE;
 
 	// Root signature for mesh rendering (shared by all materials)
 	Microsoft::WRL::ComPtr<ID3D12RootSignature> m_rootSignature;
 
-	// Pipeline state cache for materials
+	// Pipeline state cache for materials, keyed by material path and vertex layout
 	std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3D12PipelineState>> m_pipelineStateCache;
+	std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3D12PipelineState>> m_instancedPipelineStateCache;
+
+	// Visibility stage storage, reused across frames to avoid reallocations
+	std::vector<RenderCandidate> m_candidates;
+	engine::SceneExtract m_extract;
+	std::vector<std::uint32_t> m_visibleIndices;
+	std::vector<std::uint32_t> m_viewObjects; // Visible and drawable, fed to the queue stage
+	engine::culling::CullingStats m_cullingStats;
+	bool m_frustumCullingEnabled = true;
+
+	// Occlusion stage storage; m_isOccluder is indexed by candidate
+	bool m_occlusionCullingEnabled = true;
+	std::uint32_t m_maxOccluders = 16;
+	float m_autoOccluderMinCoverage = 0.1f;
+	engine::culling::OcclusionBuffer m_occlusionBuffer;
+	std::vector<std::pair<float, std::uint32_t>> m_occluderCandidates;
+	std::vector<std::uint8_t> m_isOccluder;
+
+	// Queue stage storage; state ids and tables live in the extract and are rebuilt every frame so ids stay dense
+	engine::RenderQueue m_renderQueue;
+	engine::RenderQueueStats m_renderQueueStats;
+	bool m_lodEnabled = true;
+	float m_lodScreenErrorThreshold = kDefaultLodScreenErrorThreshold;
+	MeshLodStats m_lodStats;
+	engine::gpu::ResidencyProvider *m_residencyProvider = nullptr;
+	bool m_sortKeySaturationReported = false; // Warned once that state ids outgrew the sort key fields
+	// Per-frame (material, layout key) -> per-object and instanced pipelines, so the path-keyed caches are hit once per pair, not per primitive
+	std::map<std::pair<const engine::gpu::MaterialGPU *, std::uint32_t>, std::pair<ID3D12PipelineState *, ID3D12PipelineState *>> m_framePipelines;
+
+	// Instancing storage. The upload buffer is persistently mapped and filled front to back during a frame;
+	// buffers outgrown mid-frame are retired and kept alive until the next beginFrame().
+	bool m_instancingEnabled = true;
+	engine::InstanceBatcher m_instanceBatcher;
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_instanceBuffer;
+	engine::InstanceData *m_instanceBufferData = nullptr;
+	std::uint32_t m_instanceBufferCapacity = 0;
+	std::uint32_t m_instanceBufferCursor = 0;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> m_retiredInstanceBuffers;
+	// PSOs dropped by a shader reload; command lists of the frame in flight may still use them until beginFrame()
+	std::vector<Microsoft::WRL::ComPtr<ID3D12PipelineState>> m_retiredPipelineStates;
+	MeshRenderingFrameStats m_frameStats;
+
+	// Rasterise the selected occluders and drop occluded entries from m_visibleIndices
+	void cullOccludedCandidates();
+
+	// Resolve the draws of extract object index from its mesh; leaves them empty while the mesh is evicted
+	void extractDraws( std::uint32_t index );
+
+	// Make room for count instances in the instance buffer, growing it if needed
+	bool reserveInstanceSpace( std::uint32_t count );
+
+	// Empty both PSO caches after a shader reload, dropping every raw pointer taken from them
+	void retirePipelineStates();
+
+	// World matrix from TransformSystem when available, local transform otherwise
+	math::Mat4f getEntityWorldMatrix( ecs::Scene &scene, ecs::Entity entity );
+
+	// Record draws for all primitives of a mesh with the given world matrix
+	void drawMesh( ID3D12GraphicsCommandList *commandList, const components::MeshRenderer &meshRenderer, const math::Mat4f &worldMatrix );
 
 	// Helper methods for root signature and pipeline state management
 	void createRootSignature();
 	bool registerShaders();
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> createMaterialPipelineState( const engine::gpu::MaterialGPU &material );
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> createMaterialPipelineState( const engine::gpu::MaterialGPU &material, bool instanced, const assets::VertexLayout &layout );
 };
 
 } // namespace systems
@@ -6,6 +6,8 @@
 #include "engine/gpu/mesh_gpu.h"
 #include "engine/gpu/gpu_resource_manager.h"
 
+#include <unordered_map>
+
 using namespace runtime;
 using namespace ecs;
 
@@ -59,6 +61,72 @@ bool SceneImporter::createGPUResources( std::shared_ptr<assets::Scene> assetScen
 	return true;
 }
 
+bool SceneImporter::applySceneReload( const assets::SceneReload &reload, ecs::Scene &targetScene, engine::GPUResourceManager &gpuResourceManager )
+{
+	if ( !reload.scene || reload.structureChanged )
+	{
+		return false;
+	}
+
+	// MaterialGPU objects are shared by primitives across meshes, so they are refreshed rather than replaced
+	for ( const assets::MaterialHandle handle : reload.changedMaterials )
+	{
+		gpuResourceManager.reloadMaterialGPU( reload.scene->getMaterial( handle ) );
+	}
+
+	std::unordered_map<const engine::gpu::MeshGPU *, std::shared_ptr<assets::Mesh>> reloadedMeshes;
+	for ( const assets::MeshHandle handle : reload.changedMeshes )
+	{
+		const auto mesh = reload.scene->getMesh( handle );
+		if ( const auto gpuMesh = gpuResourceManager.reloadMeshGPU( mesh ) )
+		{
+			gpuMesh->configureMaterials( gpuResourceManager, *reload.scene, *mesh );
+			reloadedMeshes.emplace( gpuMesh.get(), mesh );
+		}
+	}
+
+	// Detached meshes are new objects; the shared MeshGPU stays with the other scenes using it
+	std::unordered_map<assets::MeshHandle, std::shared_ptr<engine::gpu::MeshGPU>> detachedMeshes;
+	for ( const assets::MeshHandle handle : reload.detachedMeshes )
+	{
+		const auto mesh = reload.scene->getMesh( handle );
+		if ( auto gpuMesh = gpuResourceManager.getMeshGPU( mesh ) )
+		{
+			gpuMesh->configureMaterials( gpuResourceManager, *reload.scene, *mesh );
+			detachedMeshes.emplace( handle, std::move( gpuMesh ) );
+		}
+	}
+	if ( reloadedMeshes.empty() && detachedMeshes.empty() )
+	{
+		return true;
+	}
+
+	// Entities, and with them selection and command history, stay as they are. Renderers of patched meshes
+	// already hold the rebuilt MeshGPU and only their copy of the bounds is refreshed; renderers of detached
+	// meshes imported from this scene are pointed at the copy's MeshGPU.
+	for ( const Entity entity : targetScene.getAllEntities() )
+	{
+		auto *meshRenderer = entity.isValid() ? targetScene.getComponent<components::MeshRenderer>( entity ) : nullptr;
+		if ( !meshRenderer || !meshRenderer->gpuMesh )
+			continue;
+
+		const auto detached = detachedMeshes.find( meshRenderer->meshHandle );
+		if ( detached != detachedMeshes.end() && meshRenderer->sourceScene.lock() == reload.scene )
+		{
+			meshRenderer->gpuMesh = detached->second;
+			meshRenderer->bounds = reload.scene->getMesh( meshRenderer->meshHandle )->getBounds();
+			continue;
+		}
+
+		const auto it = reloadedMeshes.find( meshRenderer->gpuMesh.get() );
+		if ( it != reloadedMeshes.end() )
+		{
+			meshRenderer->bounds = it->second->getBounds();
+		}
+	}
+	return true;
+}
+
 ecs::Entity SceneImporter::importNode( std::shared_ptr<assets::Scene> assetScene, const assets::SceneNode &node, ecs::Scene &targetScene, ecs::Entity parent )
 {
 	// Create entity with node name
@@ -139,6 +207,7 @@ void SceneImporter::setupMeshRenderer( assets::MeshHandle meshHandle, ecs::Entit
 	{
 		components::MeshRenderer renderer( meshHandle );
 
+		renderer.sourceScene = assetScene;
 		renderer.bounds = mesh->getBounds();
 		targetScene.addComponent( entity, renderer );
 	}
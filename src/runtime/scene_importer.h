@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "engine/assets/assets.h"
+#include "engine/assets/scene_reload.h"
 #include "runtime/entity.h"
 
 namespace ecs
@@ -34,6 +35,13 @@ public:
 	/// @return true if GPU resource creation was successful
 	static bool createGPUResources( std::shared_ptr<assets::Scene> assetScene, ecs::Scene &targetScene, engine::GPUResourceManager &gpuResourceManager );
 
+	/// @brief Apply a hot reload to already-imported entities without recreating them
+	/// @param reload The reload returned by AssetManager, whose meshes and materials were patched in place or detached
+	/// @param targetScene The ECS scene holding the scene's entities
+	/// @param gpuResourceManager GPU resource manager whose cached MeshGPU and MaterialGPU objects are rebuilt
+	/// @return false if the reload failed or changed structure, which needs a full re-import
+	static bool applySceneReload( const assets::SceneReload &reload, ecs::Scene &targetScene, engine::GPUResourceManager &gpuResourceManager );
+
 private:
 	/// @brief Recursively import a scene node and its children
 	/// @param assetScene The asset scene containing meshes and other data
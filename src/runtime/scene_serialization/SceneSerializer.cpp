@@ -52,6 +52,7 @@ void serializeMeshRenderer( json &componentJson, const components::MeshRenderer
 	// For now, just serialize the handle
 	componentJson["meshHandle"] = meshRenderer.meshHandle;
 	componentJson["lodBias"] = meshRenderer.lodBias;
+	componentJson["occluder"] = meshRenderer.occluder;
 }
 
 void deserializeTransform( const json &componentJson, components::Transform &transform )
@@ -113,6 +114,11 @@ void deserializeMeshRenderer( const json &componentJson, components::MeshRendere
 	{
 		meshRenderer.lodBias = componentJson["lodBias"];
 	}
+
+	if ( componentJson.contains( "occluder" ) )
+	{
+		meshRenderer.occluder = componentJson["occluder"];
+	}
 }
 
 } // anonymous namespace
@@ -0,0 +1,151 @@
+#include "runtime/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace runtime
+{
+
+ThreadPool::ThreadPool( std::uint32_t threadCount )
+{
+	if ( threadCount == 0 )
+	{
+		const std::uint32_t hardware = std::thread::hardware_concurrency();
+		threadCount = hardware > 1 ? hardware - 1 : 1;
+	}
+
+	m_workers.reserve( threadCount );
+	for ( std::uint32_t i = 0; i < threadCount; ++i )
+	{
+		m_workers.emplace_back( [this] { workerLoop(); } );
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock( m_mutex );
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for ( auto &worker : m_workers )
+	{
+		worker.join();
+	}
+}
+
+ThreadPool &ThreadPool::getShared()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::enqueue( std::function<void()> task )
+{
+	{
+		std::lock_guard lock( m_mutex );
+		m_tasks.push_back( std::move( task ) );
+	}
+	m_condition.notify_one();
+}
+
+void ThreadPool::workerLoop()
+{
+	for ( ;; )
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock lock( m_mutex );
+			m_condition.wait( lock, [this] { return m_stopping || !m_tasks.empty(); } );
+			if ( m_tasks.empty() )
+			{
+				return; // Stopping and drained
+			}
+			task = std::move( m_tasks.front() );
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
+
+void ThreadPool::parallelFor( std::size_t count, const std::function<void( std::size_t )> &body, std::size_t grainSize )
+{
+	grainSize = std::max<std::size_t>( grainSize, 1 );
+	const std::size_t chunkCount = ( count + grainSize - 1 ) / grainSize;
+	if ( chunkCount <= 1 || m_workers.empty() )
+	{
+		for ( std::size_t i = 0; i < count; ++i )
+		{
+			body( i );
+		}
+		return;
+	}
+
+	// Shared with the helper tasks, which may start after this call returned; they then find no work left
+	// and never touch body
+	struct Job
+	{
+		const std::function<void( std::size_t )> *body = nullptr;
+		std::size_t count = 0;
+		std::size_t grainSize = 1;
+		std::atomic<std::size_t> next = 0;
+		std::atomic<std::size_t> remaining = 0; // Indices not finished yet
+		std::mutex mutex;
+		std::condition_variable done;
+		std::exception_ptr error;
+	};
+	auto job = std::make_shared<Job>();
+	job->body = &body;
+	job->count = count;
+	job->grainSize = grainSize;
+	job->remaining = count;
+
+	const auto run = []( Job &state ) {
+		for ( ;; )
+		{
+			const std::size_t begin = state.next.fetch_add( state.grainSize );
+			if ( begin >= state.count )
+			{
+				return;
+			}
+			const std::size_t end = std::min( begin + state.grainSize, state.count );
+			try
+			{
+				for ( std::size_t i = begin; i < end; ++i )
+				{
+					( *state.body )( i );
+				}
+			}
+			catch ( ... )
+			{
+				std::lock_guard lock( state.mutex );
+				if ( !state.error )
+				{
+					state.error = std::current_exception();
+				}
+			}
+			if ( state.remaining.fetch_sub( end - begin ) == end - begin )
+			{
+				std::lock_guard lock( state.mutex );
+				state.done.notify_all();
+			}
+		}
+	};
+
+	const std::size_t helpers = std::min<std::size_t>( m_workers.size(), chunkCount - 1 );
+	for ( std::size_t i = 0; i < helpers; ++i )
+	{
+		enqueue( [job, run] { run( *job ); } );
+	}
+	run( *job );
+
+	std::unique_lock lock( job->mutex );
+	job->done.wait( lock, [&] { return job->remaining.load() == 0; } );
+	if ( job->error )
+	{
+		std::rethrow_exception( job->error );
+	}
+}
+
+} // namespace runtime
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace runtime
+{
+
+// Fixed set of worker threads draining a FIFO task queue. parallelFor() also runs work on the calling
+// thread, so it makes progress even when every worker is busy (including nested calls from a task).
+class ThreadPool
+{
+public:
+	// threadCount 0 picks one worker per hardware thread, minus the caller's
+	explicit ThreadPool( std::uint32_t threadCount = 0 );
+	// Runs the tasks already queued, then joins the workers
+	~ThreadPool();
+
+	ThreadPool( const ThreadPool & ) = delete;
+	ThreadPool &operator=( const ThreadPool & ) = delete;
+
+	// Process-wide pool, created on first use
+	static ThreadPool &getShared();
+
+	std::uint32_t getThreadCount() const noexcept { return static_cast<std::uint32_t>( m_workers.size() ); }
+
+	// Queue a task; the future carries its result or exception
+	template <typename Function>
+	auto submit( Function &&function ) -> std::future<std::invoke_result_t<Function>>
+	{
+		using Result = std::invoke_result_t<Function>;
+		auto task = std::make_shared<std::packaged_task<Result()>>( std::forward<Function>( function ) );
+		auto future = task->get_future();
+		enqueue( [task] { ( *task )(); } );
+		return future;
+	}
+
+	// Call body( i ) for every i in [0, count), handing out grainSize indices at a time to the workers and
+	// the calling thread. Returns once all calls finished; the first exception thrown is rethrown here.
+	void parallelFor( std::size_t count, const std::function<void( std::size_t )> &body, std::size_t grainSize = 1 );
+
+private:
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping = false;
+
+	void enqueue( std::function<void()> task );
+	void workerLoop();
+};
+
+} // namespace runtime
@@ -0,0 +1,211 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine/assets/asset_cache.h"
+#include "engine/assets/asset_manager.h"
+
+using assets::AssetCache;
+
+namespace
+{
+
+// Mesh with one primitive of vertexCount vertices and as many indices
+std::shared_ptr<assets::Mesh> makeMesh( std::uint32_t vertexCount )
+{
+	assets::Primitive primitive;
+	std::vector<assets::Vertex> vertices( vertexCount );
+	std::vector<std::uint32_t> indices( vertexCount );
+	for ( std::uint32_t i = 0; i < vertexCount; ++i )
+	{
+		indices[i] = i;
+	}
+	primitive.setVertices( std::move( vertices ), math::BoundingBox3Df{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } } );
+	primitive.setIndices( std::move( indices ) );
+
+	auto mesh = std::make_shared<assets::Mesh>();
+	mesh->addPrimitive( std::move( primitive ) );
+	return mesh;
+}
+
+} // namespace
+
+TEST_CASE( "Assets report the CPU memory they hold", "[AssetCache][unit]" )
+{
+	const auto mesh = makeMesh( 1000 );
+	const std::size_t geometryBytes = 1000 * ( sizeof( assets::Vertex ) + sizeof( std::uint32_t ) );
+	REQUIRE( mesh->getMemoryUsage() >= geometryBytes );
+	REQUIRE( mesh->getMemoryUsage() < geometryBytes + 1024 );
+
+	auto material = std::make_shared<assets::Material>();
+	const std::size_t plainMaterial = material->getMemoryUsage();
+	material->getPBRMaterial().baseColorTexture = std::string( 256, 'x' );
+	REQUIRE( material->getMemoryUsage() >= plainMaterial + 256 );
+
+	assets::Scene scene;
+	scene.addMesh( mesh );
+	scene.addMaterial( material );
+	auto node = std::make_unique<assets::SceneNode>( "root" );
+	node->addChild( std::make_unique<assets::SceneNode>( "child" ) );
+	scene.addRootNode( std::move( node ) );
+	REQUIRE( scene.getMemoryUsage() >= mesh->getMemoryUsage() + material->getMemoryUsage() + 2 * sizeof( assets::SceneNode ) );
+}
+
+TEST_CASE( "AssetCache lookups, replacement and statistics", "[AssetCache][unit]" )
+{
+	AssetCache cache;
+	const auto mesh = makeMesh( 100 );
+
+	REQUIRE( cache.find( "a" ) == nullptr );
+	cache.insert( "a", mesh );
+	REQUIRE( cache.contains( "a" ) );
+	REQUIRE( cache.find( "a" ) == mesh );
+
+	auto stats = cache.getStats();
+	REQUIRE( stats.hits == 1 );
+	REQUIRE( stats.misses == 1 );
+	REQUIRE( stats.assetCount == 1 );
+	REQUIRE( stats.residentBytes == mesh->getMemoryUsage() );
+
+	// insertIfAbsent keeps the cached instance of the same type
+	REQUIRE( cache.insertIfAbsent( "a", makeMesh( 10 ) ) == mesh );
+	// but replaces an asset of another type
+	const auto material = std::make_shared<assets::Material>();
+	REQUIRE( cache.insertIfAbsent( "a", material ) == material );
+	REQUIRE( cache.getStats().residentBytes == material->getMemoryUsage() );
+
+	// Resizing an asset in place is picked up on request
+	cache.insert( "b", makeMesh( 10 ) );
+	const auto grown = std::static_pointer_cast<assets::Mesh>( cache.find( "b" ) );
+	grown->addPrimitive( makeMesh( 500 )->getPrimitive( 0 ) );
+	cache.updateSize( "b" );
+	REQUIRE( cache.getStats().residentBytes == material->getMemoryUsage() + grown->getMemoryUsage() );
+
+	// Referenced assets are not unloaded
+	REQUIRE_FALSE( cache.erase( "b", true ) );
+	REQUIRE( cache.erase( "b" ) );
+	cache.clear();
+	stats = cache.getStats();
+	REQUIRE( stats.assetCount == 0 );
+	REQUIRE( stats.residentBytes == 0 );
+	REQUIRE( stats.peakResidentBytes >= material->getMemoryUsage() + grown->getMemoryUsage() );
+}
+
+TEST_CASE( "AssetCache evicts least recently used unreferenced assets over budget", "[AssetCache][unit]" )
+{
+	const std::size_t meshBytes = makeMesh( 1000 )->getMemoryUsage();
+	AssetCache cache( 3 * meshBytes );
+
+	cache.insert( "0", makeMesh( 1000 ) );
+	cache.insert( "1", makeMesh( 1000 ) );
+	cache.insert( "2", makeMesh( 1000 ) );
+	REQUIRE( cache.getStats().evictions == 0 );
+
+	// "0" becomes the most recently used, so "1" is the victim
+	REQUIRE( cache.find( "0" ) );
+	cache.insert( "3", makeMesh( 1000 ) );
+	REQUIRE( cache.contains( "0" ) );
+	REQUIRE_FALSE( cache.contains( "1" ) );
+	REQUIRE( cache.contains( "2" ) );
+	REQUIRE( cache.contains( "3" ) );
+	REQUIRE( cache.getStats().evictions == 1 );
+	REQUIRE( cache.getStats().evictedBytes == meshBytes );
+	REQUIRE( cache.getStats().residentBytes <= cache.getBudget() );
+
+	// Referenced assets stay even when that leaves the cache over budget
+	auto held0 = cache.find( "0" );
+	auto held2 = cache.find( "2" );
+	const auto held3 = cache.find( "3" );
+	cache.setBudget( meshBytes );
+	REQUIRE( cache.getStats().assetCount == 3 );
+	REQUIRE( cache.getStats().residentBytes > cache.getBudget() );
+	REQUIRE( cache.trim() == 0 );
+
+	// Released references become evictable on the next trim, oldest first
+	held2.reset();
+	held0.reset();
+	REQUIRE( cache.trim() == 2 );
+	REQUIRE( cache.contains( "3" ) );
+	REQUIRE( cache.getStats().residentBytes == meshBytes );
+}
+
+TEST_CASE( "AssetCache stays consistent under concurrent use", "[AssetCache][unit]" )
+{
+	const std::size_t meshBytes = makeMesh( 64 )->getMemoryUsage();
+	AssetCache cache( 20 * meshBytes );
+
+	constexpr int kThreads = 8;
+	constexpr int kOperations = 4000;
+	std::atomic<std::uint64_t> lookups = 0;
+	std::atomic<int> wrongTypes = 0;
+	std::vector<std::thread> threads;
+	for ( int t = 0; t < kThreads; ++t )
+	{
+		threads.emplace_back( [&, t] {
+			for ( int i = 0; i < kOperations; ++i )
+			{
+				const std::string path = std::to_string( ( i * 7 + t ) % 64 );
+				if ( const auto asset = cache.find( path ) )
+				{
+					wrongTypes += asset->getType() != assets::AssetType::Mesh;
+				}
+				else
+				{
+					cache.insertIfAbsent( path, makeMesh( 64 ) );
+				}
+				++lookups;
+				if ( i % 97 == 0 )
+				{
+					cache.erase( path, true );
+				}
+			}
+		} );
+	}
+	for ( auto &thread : threads )
+	{
+		thread.join();
+	}
+
+	// Trims during the run may have found assets still held by other threads
+	cache.trim();
+	const auto stats = cache.getStats();
+	REQUIRE( wrongTypes == 0 );
+	REQUIRE( stats.hits + stats.misses == lookups );
+	REQUIRE( stats.evictions > 0 );
+	REQUIRE( stats.residentBytes == stats.assetCount * meshBytes );
+	REQUIRE( stats.residentBytes <= cache.getBudget() );
+
+	cache.clear();
+	REQUIRE( cache.getStats().residentBytes == 0 );
+}
+
+TEST_CASE( "AssetManager cache budget evicts unreferenced scenes", "[AssetCache][AssetManager][unit]" )
+{
+	assets::AssetManager::setSceneLoaderCallback( []( const std::string & ) {
+		auto scene = std::make_shared<assets::Scene>();
+		scene->addMesh( makeMesh( 1000 ) );
+		return scene;
+	} );
+
+	assets::AssetManager manager;
+	auto kept = manager.load<assets::Scene>( "kept.gltf" );
+	manager.load<assets::Scene>( "dropped_a.gltf" );
+	manager.load<assets::Scene>( "dropped_b.gltf" );
+	REQUIRE( manager.getCacheStats().assetCount == 3 );
+
+	manager.setCacheBudget( kept->getMemoryUsage() );
+	REQUIRE( manager.isCached( "kept.gltf" ) );
+	REQUIRE_FALSE( manager.isCached( "dropped_a.gltf" ) );
+	REQUIRE_FALSE( manager.isCached( "dropped_b.gltf" ) );
+	REQUIRE( manager.getCacheStats().evictions == 2 );
+
+	// Evicted scenes load again on demand
+	REQUIRE( manager.load<assets::Scene>( "dropped_a.gltf" ) );
+	REQUIRE( manager.get<assets::Scene>( "kept.gltf" ) == kept );
+
+	assets::AssetManager::clearSceneLoaderCallback();
+}
@@ -0,0 +1,420 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "engine/assets/asset_manager.h"
+#include "engine/assets/assets.h"
+#include "engine/assets/content_hash.h"
+#include "engine/assets/content_store.h"
+#include "engine/assets/scene_reload.h"
+#include "engine/gltf_loader/gltf_loader.h"
+
+namespace
+{
+namespace fs = std::filesystem;
+
+struct TempDirectory
+{
+	fs::path path = fs::temp_directory_path() / "asset_hot_reload_tests";
+	TempDirectory()
+	{
+		std::error_code error;
+		fs::remove_all( path, error );
+		fs::create_directories( path );
+	}
+	~TempDirectory()
+	{
+		std::error_code error;
+		fs::remove_all( path, error );
+	}
+};
+
+template <typename T>
+void append( std::vector<std::uint8_t> &out, const T &value )
+{
+	const auto *bytes = reinterpret_cast<const std::uint8_t *>( &value );
+	out.insert( out.end(), bytes, bytes + sizeof( T ) );
+}
+
+void writeFile( const fs::path &path, const void *data, std::size_t size )
+{
+	std::ofstream file( path, std::ios::binary | std::ios::trunc );
+	file.write( static_cast<const char *>( data ), static_cast<std::streamsize>( size ) );
+}
+
+// Writes name.gltf and name.bin: a "Kit" root node with one child per mesh, each mesh a single triangle
+// raised to heights[i], all using one material. With extraNode the root gains a mesh-less child, a structural
+// change.
+fs::path writeKit( const fs::path &directory, const std::string &name, const std::vector<float> &heights, bool extraNode = false, float metallic = 1.0f )
+{
+	std::vector<std::uint8_t> bin;
+	std::string nodes = R"({ "name": "Kit", "children": [)";
+	std::string meshes;
+	std::string accessors;
+	std::string views;
+	for ( std::size_t i = 0; i < heights.size(); ++i )
+	{
+		const std::size_t offset = bin.size();
+		const float h = heights[i];
+		for ( const float value : { 0.0f, h, 0.0f, 1.0f, h, 0.0f, 0.0f, h, 1.0f } )
+		{
+			append( bin, value );
+		}
+		for ( const std::uint32_t index : { 0u, 1u, 2u } )
+		{
+			append( bin, index );
+		}
+		const std::string separator = i == 0 ? "" : ",";
+		const std::string height = std::to_string( h );
+		nodes += separator + std::to_string( i + 1 );
+		meshes += separator + R"({ "primitives": [{ "attributes": { "POSITION": )" + std::to_string( 2 * i ) + R"( }, "indices": )" + std::to_string( 2 * i + 1 ) + R"(, "material": 0 }] })";
+		accessors += separator + R"({ "bufferView": )" + std::to_string( 2 * i ) + R"(, "componentType": 5126, "count": 3, "type": "VEC3", "min": [0, )" + height + R"(, 0], "max": [1, )" + height + R"(, 1] },)" +
+			R"({ "bufferView": )" + std::to_string( 2 * i + 1 ) + R"(, "componentType": 5125, "count": 3, "type": "SCALAR" })";
+		views += separator + R"({ "buffer": 0, "byteOffset": )" + std::to_string( offset ) + R"(, "byteLength": 36 },)" +
+			R"({ "buffer": 0, "byteOffset": )" + std::to_string( offset + 36 ) + R"(, "byteLength": 12 })";
+	}
+	if ( extraNode )
+	{
+		nodes += "," + std::to_string( heights.size() + 1 );
+	}
+	nodes += "] }";
+	for ( std::size_t i = 0; i < heights.size(); ++i )
+	{
+		nodes += R"(, { "name": "Prop)" + std::to_string( i ) + R"(", "mesh": )" + std::to_string( i ) + " }";
+	}
+	if ( extraNode )
+	{
+		nodes += R"(, { "name": "Marker" })";
+	}
+	writeFile( directory / ( name + ".bin" ), bin.data(), bin.size() );
+
+	const std::string json = std::string( R"({ "asset": { "version": "2.0" }, "scene": 0, "scenes": [{ "nodes": [0] }],)" ) +
+		R"("nodes": [)" + nodes + "]," +
+		R"("materials": [{ "name": "Metal", "pbrMetallicRoughness": { "metallicFactor": )" + std::to_string( metallic ) + " } }]," +
+		R"("meshes": [)" + meshes + "]," +
+		R"("accessors": [)" + accessors + "]," +
+		R"("bufferViews": [)" + views + "]," +
+		R"("buffers": [{ "byteLength": )" + std::to_string( bin.size() ) + R"(, "uri": ")" + name + R"(.bin" }] })";
+	const fs::path path = directory / ( name + ".gltf" );
+	writeFile( path, json.data(), json.size() );
+	return path;
+}
+
+// Rewritten files may keep their timestamp on coarse clocks; move it on so the change is seen
+void touch( const fs::path &path )
+{
+	fs::last_write_time( path, fs::last_write_time( path ) + std::chrono::seconds( 2 ) );
+}
+
+std::shared_ptr<assets::Mesh> makeMesh( float height, assets::MaterialHandle material = 0 )
+{
+	assets::Primitive primitive;
+	std::vector<assets::Vertex> vertices( 3 );
+	vertices[0].position = { 0.0f, height, 0.0f };
+	vertices[1].position = { 1.0f, height, 0.0f };
+	vertices[2].position = { 0.0f, height, 1.0f };
+	primitive.setVertices( std::move( vertices ), math::BoundingBox3Df{ { 0.0f, height, 0.0f }, { 1.0f, height, 1.0f } } );
+	primitive.setIndices( { 0, 1, 2 } );
+	primitive.setMaterialHandle( material );
+
+	auto mesh = std::make_shared<assets::Mesh>();
+	mesh->addPrimitive( std::move( primitive ) );
+	return mesh;
+}
+
+std::shared_ptr<assets::Scene> makeScene( const std::vector<float> &heights, float metallic )
+{
+	auto scene = std::make_shared<assets::Scene>();
+	auto material = std::make_shared<assets::Material>();
+	material->setMetallicFactor( metallic );
+	scene->addMaterial( material );
+	auto root = std::make_unique<assets::SceneNode>( "Kit" );
+	for ( const float height : heights )
+	{
+		auto node = std::make_unique<assets::SceneNode>( "Prop" );
+		node->addMeshHandle( scene->addMesh( makeMesh( height ) ) );
+		root->addChild( std::move( node ) );
+	}
+	scene->addRootNode( std::move( root ) );
+	return scene;
+}
+
+} // namespace
+
+TEST_CASE( "Content hashes cover what is uploaded and nothing else", "[assets][hot_reload][unit]" )
+{
+	const auto mesh = makeMesh( 1.0f );
+	const auto &primitive = mesh->getPrimitive( 0 );
+	REQUIRE( assets::hashPrimitive( primitive ) == assets::hashPrimitive( makeMesh( 1.0f )->getPrimitive( 0 ) ) );
+	REQUIRE( assets::hashPrimitive( primitive ) != assets::hashPrimitive( makeMesh( 2.0f )->getPrimitive( 0 ) ) );
+	REQUIRE( assets::hashPrimitive( primitive, 1 ) != assets::hashPrimitive( primitive ) );
+
+	// Material handles are part of the mesh, not of the primitive's data
+	const auto rebound = makeMesh( 1.0f, 3 );
+	REQUIRE( assets::hashPrimitive( rebound->getPrimitive( 0 ) ) == assets::hashPrimitive( primitive ) );
+	REQUIRE( assets::hashMesh( *rebound ) != assets::hashMesh( *mesh ) );
+
+	// Indices and LODs count, not only vertices
+	auto reordered = makeMesh( 1.0f );
+	reordered->getPrimitive( 0 ).setIndices( { 0, 2, 1 } );
+	REQUIRE( assets::hashMesh( *reordered ) != assets::hashMesh( *mesh ) );
+	auto withLod = makeMesh( 1.0f );
+	withLod->getPrimitive( 0 ).addLod( { { 0, 1, 2 }, 0.5f } );
+	REQUIRE( assets::hashMesh( *withLod ) != assets::hashMesh( *mesh ) );
+
+	assets::Material a;
+	assets::Material b;
+	b.setName( "Renamed" );
+	REQUIRE( assets::hashMaterial( a ) == assets::hashMaterial( b ) );
+	b.setRoughnessFactor( 0.5f );
+	REQUIRE( assets::hashMaterial( a ) != assets::hashMaterial( b ) );
+	b = a;
+	b.getPBRMaterial().normalTexture = "normal.png";
+	REQUIRE( assets::hashMaterial( a ) != assets::hashMaterial( b ) );
+}
+
+TEST_CASE( "patchScene patches changed meshes and materials in place", "[assets][hot_reload][unit]" )
+{
+	const auto scene = makeScene( { 0.0f, 1.0f, 2.0f }, 1.0f );
+	const auto meshes = scene->getMeshes();
+	const auto material = scene->getMaterial( 0 );
+
+	SECTION( "Unchanged content patches nothing" )
+	{
+		const auto reload = assets::patchScene( scene, *makeScene( { 0.0f, 1.0f, 2.0f }, 1.0f ) );
+		REQUIRE( reload.scene == scene );
+		REQUIRE_FALSE( reload.structureChanged );
+		REQUIRE( reload.changedMeshes.empty() );
+		REQUIRE( reload.changedMaterials.empty() );
+	}
+
+	SECTION( "Only the changed mesh and material are replaced, keeping their objects" )
+	{
+		const auto reload = assets::patchScene( scene, *makeScene( { 0.0f, 5.0f, 2.0f }, 0.25f ) );
+		REQUIRE_FALSE( reload.structureChanged );
+		REQUIRE( reload.changedMeshes == std::vector<assets::MeshHandle>{ 1 } );
+		REQUIRE( reload.changedMaterials == std::vector<assets::MaterialHandle>{ 0 } );
+		REQUIRE( scene->getMeshes() == meshes );
+		REQUIRE( scene->getMaterial( 0 ) == material );
+		REQUIRE( meshes[1]->getBounds().min.y == 5.0f );
+		REQUIRE( material->getPBRMaterial().metallicFactor == 0.25f );
+	}
+
+	SECTION( "Meshes shared with the reloaded scene are recognised without hashing" )
+	{
+		auto reloaded = std::make_shared<assets::Scene>();
+		reloaded->addMaterial( material );
+		auto root = std::make_unique<assets::SceneNode>( "Kit" );
+		for ( const auto &mesh : meshes )
+		{
+			auto node = std::make_unique<assets::SceneNode>( "Prop" );
+			node->addMeshHandle( reloaded->addMesh( mesh ) );
+			root->addChild( std::move( node ) );
+		}
+		reloaded->addRootNode( std::move( root ) );
+		REQUIRE( assets::patchScene( scene, *reloaded ).changedMeshes.empty() );
+	}
+
+	SECTION( "Structural changes are reported and leave the scene alone" )
+	{
+		const auto reload = assets::patchScene( scene, *makeScene( { 0.0f, 5.0f, 2.0f, 3.0f }, 0.25f ) );
+		REQUIRE( reload.structureChanged );
+		REQUIRE( reload.changedMeshes.empty() );
+		REQUIRE( meshes[1]->getBounds().min.y == 1.0f );
+		REQUIRE( material->getPBRMaterial().metallicFactor == 1.0f );
+
+		auto moved = makeScene( { 0.0f, 1.0f, 2.0f }, 1.0f );
+		moved->getRootNodes()[0]->setTransform( assets::Transform( { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } ) );
+		REQUIRE( assets::patchScene( scene, *moved ).structureChanged );
+	}
+}
+
+TEST_CASE( "GLTFLoader reload extracts only meshes whose source changed", "[assets][hot_reload][gltf][unit]" )
+{
+	TempDirectory temp;
+	const auto path = writeKit( temp.path, "kit", { 0.0f, 1.0f, 2.0f, 3.0f } ).generic_string();
+
+	gltf_loader::GLTFLoader loader;
+	const auto original = loader.loadScene( path );
+	REQUIRE( original );
+	REQUIRE( original->getMeshCount() == 4 );
+	for ( const auto &mesh : original->getMeshes() )
+	{
+		REQUIRE( mesh->getSourceHash() != 0 );
+	}
+
+	// Unchanged file: every mesh is shared
+	gltf_loader::LoadStats stats;
+	auto reloaded = loader.reloadScene( path, *original, &stats );
+	REQUIRE( reloaded );
+	REQUIRE( stats.meshesReused == 4 );
+	REQUIRE( reloaded->getMeshes() == original->getMeshes() );
+
+	// One re-exported prop: only it is extracted again
+	writeKit( temp.path, "kit", { 0.0f, 1.0f, 7.0f, 3.0f } );
+	stats = {};
+	reloaded = loader.reloadScene( path, *original, &stats );
+	REQUIRE( reloaded );
+	REQUIRE( stats.meshesReused == 3 );
+	REQUIRE( reloaded->getMesh( 0 ) == original->getMesh( 0 ) );
+	REQUIRE( reloaded->getMesh( 2 ) != original->getMesh( 2 ) );
+	REQUIRE( reloaded->getMesh( 2 )->getBounds().min.y == 7.0f );
+	REQUIRE( reloaded->getMesh( 3 ) == original->getMesh( 3 ) );
+
+	// Other import settings never reuse meshes built with the previous ones
+	gltf_loader::GLTFLoader otherSettings;
+	otherSettings.setLodGenerationEnabled( false );
+	stats = {};
+	REQUIRE( otherSettings.reloadScene( path, *original, &stats ) );
+	REQUIRE( stats.meshesReused == 0 );
+}
+
+TEST_CASE( "AssetManager hot reload patches re-exported scenes in place", "[assets][hot_reload][AssetManager][unit]" )
+{
+	TempDirectory temp;
+	const auto path = writeKit( temp.path, "kit", { 0.0f, 1.0f, 2.0f } ).generic_string();
+
+	gltf_loader::GLTFLoader loader;
+	assets::AssetManager::setSceneLoaderCallback( [&loader]( const std::string &scenePath ) -> std::shared_ptr<assets::Scene> { return loader.loadScene( scenePath ); } );
+	assets::AssetManager::setSceneReloaderCallback( [&loader]( const std::string &scenePath, const assets::Scene &previous ) -> std::shared_ptr<assets::Scene> {
+		return loader.reloadScene( scenePath, previous );
+	} );
+
+	assets::AssetManager manager;
+	manager.setHotReloadInterval( std::chrono::milliseconds( 0 ) );
+	const auto scene = manager.load<assets::Scene>( path );
+	REQUIRE( scene );
+	const auto meshes = scene->getMeshes();
+	REQUIRE( manager.reloadChangedScenes().empty() );
+
+	// Re-export with one prop moved; only its mesh changes, in place
+	writeKit( temp.path, "kit", { 0.0f, 4.0f, 2.0f } );
+	touch( temp.path / "kit.bin" );
+	auto reloads = manager.reloadChangedScenes();
+	REQUIRE( reloads.size() == 1 );
+	REQUIRE( reloads[0].path == path );
+	REQUIRE( reloads[0].scene == scene );
+	REQUIRE_FALSE( reloads[0].structureChanged );
+	REQUIRE( reloads[0].changedMeshes == std::vector<assets::MeshHandle>{ 1 } );
+	REQUIRE( reloads[0].changedMaterials.empty() );
+	REQUIRE( scene->getMeshes() == meshes );
+	REQUIRE( meshes[1]->getBounds().min.y == 4.0f );
+	REQUIRE( manager.get<assets::Scene>( path ) == scene );
+	REQUIRE( manager.getCacheStats().residentBytes == scene->getMemoryUsage() );
+
+	// Seen once only
+	REQUIRE( manager.reloadChangedScenes().empty() );
+
+	// A structural change is reported without touching the scene
+	writeKit( temp.path, "kit", { 0.0f, 9.0f, 2.0f }, true );
+	touch( temp.path / "kit.gltf" );
+	reloads = manager.reloadChangedScenes();
+	REQUIRE( reloads.size() == 1 );
+	REQUIRE( reloads[0].structureChanged );
+	REQUIRE( meshes[1]->getBounds().min.y == 4.0f );
+
+	// Unloaded scenes are no longer watched
+	reloads.clear();
+	REQUIRE( manager.unload( path ) == false ); // Still referenced by scene
+	manager.clearCache();
+	touch( temp.path / "kit.gltf" );
+	REQUIRE( manager.reloadChangedScenes().empty() );
+
+	assets::AssetManager::clearSceneReloaderCallback();
+	assets::AssetManager::clearSceneLoaderCallback();
+}
+
+TEST_CASE( "patchScene copies meshes and materials shared with other scenes before patching", "[assets][hot_reload][content_store][unit]" )
+{
+	assets::ContentStore store;
+	const auto scene = makeScene( { 0.0f, 1.0f }, 1.0f );
+	const auto other = makeScene( { 0.0f, 1.0f }, 1.0f );
+	store.internScene( *scene );
+	store.internScene( *other );
+	REQUIRE( other->getMeshes() == scene->getMeshes() );
+	const auto meshes = scene->getMeshes();
+	const auto material = scene->getMaterial( 0 );
+
+	SECTION( "A changed mesh is detached" )
+	{
+		const auto reload = assets::patchScene( scene, *makeScene( { 0.0f, 5.0f }, 1.0f ), &store );
+		REQUIRE( reload.changedMeshes.empty() );
+		REQUIRE( reload.detachedMeshes == std::vector<assets::MeshHandle>{ 1 } );
+		REQUIRE( reload.detachedMaterials.empty() );
+		REQUIRE( scene->getMesh( 0 ) == meshes[0] );
+		REQUIRE( scene->getMesh( 1 ) != meshes[1] );
+		REQUIRE( scene->getMesh( 1 )->getBounds().min.y == 5.0f );
+		REQUIRE( other->getMesh( 1 ) == meshes[1] );
+		REQUIRE( meshes[1]->getBounds().min.y == 1.0f );
+	}
+
+	SECTION( "A changed material is detached along with the shared meshes using it" )
+	{
+		const auto reload = assets::patchScene( scene, *makeScene( { 0.0f, 1.0f }, 0.25f ), &store );
+		REQUIRE( reload.detachedMaterials == std::vector<assets::MaterialHandle>{ 0 } );
+		REQUIRE( reload.detachedMeshes == std::vector<assets::MeshHandle>{ 0, 1 } );
+		REQUIRE( scene->getMaterial( 0 )->getPBRMaterial().metallicFactor == 0.25f );
+		REQUIRE( material->getPBRMaterial().metallicFactor == 1.0f );
+		REQUIRE( other->getMaterial( 0 ) == material );
+		REQUIRE( other->getMeshes() == meshes );
+	}
+
+	SECTION( "Without the store the shared instances are patched in place" )
+	{
+		const auto reload = assets::patchScene( scene, *makeScene( { 0.0f, 5.0f }, 1.0f ) );
+		REQUIRE( reload.changedMeshes == std::vector<assets::MeshHandle>{ 1 } );
+		REQUIRE( reload.detachedMeshes.empty() );
+		REQUIRE( other->getMesh( 1 )->getBounds().min.y == 5.0f );
+	}
+}
+
+TEST_CASE( "Reloading one of two files sharing a mesh leaves the other unchanged", "[assets][hot_reload][content_store][AssetManager][unit]" )
+{
+	TempDirectory temp;
+	const auto pathA = writeKit( temp.path, "kit_a", { 0.0f, 1.0f, 2.0f } ).generic_string();
+	const auto pathB = writeKit( temp.path, "kit_b", { 0.0f, 1.0f, 2.0f } ).generic_string();
+
+	gltf_loader::GLTFLoader loader;
+	assets::AssetManager::setSceneLoaderCallback( [&loader]( const std::string &scenePath ) -> std::shared_ptr<assets::Scene> { return loader.loadScene( scenePath ); } );
+	assets::AssetManager::setSceneReloaderCallback( [&loader]( const std::string &scenePath, const assets::Scene &previous ) -> std::shared_ptr<assets::Scene> {
+		return loader.reloadScene( scenePath, previous );
+	} );
+
+	assets::AssetManager manager;
+	manager.setContentStore( std::make_shared<assets::ContentStore>() );
+	const auto a = manager.load<assets::Scene>( pathA );
+	const auto b = manager.load<assets::Scene>( pathB );
+	REQUIRE( a );
+	REQUIRE( b );
+	REQUIRE( b->getMeshes() == a->getMeshes() );
+	REQUIRE( b->getMaterial( 0 ) == a->getMaterial( 0 ) );
+	const auto shared = b->getMeshes();
+	const auto sharedMaterial = b->getMaterial( 0 );
+
+	// Re-export one prop of file A
+	writeKit( temp.path, "kit_a", { 0.0f, 4.0f, 2.0f } );
+	auto reload = manager.reloadScene( pathA );
+	REQUIRE( reload.scene == a );
+	REQUIRE( reload.detachedMeshes == std::vector<assets::MeshHandle>{ 1 } );
+	REQUIRE( a->getMesh( 1 )->getBounds().min.y == 4.0f );
+	REQUIRE( a->getMesh( 0 ) == shared[0] );
+	REQUIRE( b->getMeshes() == shared );
+	REQUIRE( b->getMesh( 1 )->getBounds().min.y == 1.0f );
+
+	// Re-export file A with another material: B keeps its material and meshes
+	writeKit( temp.path, "kit_a", { 0.0f, 4.0f, 2.0f }, false, 0.5f );
+	reload = manager.reloadScene( pathA );
+	REQUIRE( reload.detachedMaterials == std::vector<assets::MaterialHandle>{ 0 } );
+	REQUIRE( a->getMaterial( 0 )->getPBRMaterial().metallicFactor == 0.5f );
+	REQUIRE( b->getMaterial( 0 ) == sharedMaterial );
+	REQUIRE( sharedMaterial->getPBRMaterial().metallicFactor == 1.0f );
+	REQUIRE( b->getMeshes() == shared );
+
+	assets::AssetManager::clearSceneReloaderCallback();
+	assets::AssetManager::clearSceneLoaderCallback();
+}
@@ -0,0 +1,339 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine/assets/asset_manager.h"
+#include "runtime/thread_pool.h"
+
+using assets::AssetManager;
+using assets::LoadPriority;
+using assets::LoadStatus;
+
+namespace
+{
+
+// Holds synthetic loaders until the test lets them finish
+class Gate
+{
+public:
+	void open()
+	{
+		{
+			std::lock_guard lock( m_mutex );
+			m_open = true;
+		}
+		m_condition.notify_all();
+	}
+
+	// Bounded so a failing test cannot leave a loader, and the manager waiting on it, blocked forever
+	void wait()
+	{
+		std::unique_lock lock( m_mutex );
+		m_condition.wait_for( lock, std::chrono::seconds( 10 ), [this] { return m_open; } );
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_open = false;
+};
+
+template <typename Predicate>
+bool waitUntil( Predicate predicate )
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 10 );
+	while ( !predicate() )
+	{
+		if ( std::chrono::steady_clock::now() > deadline )
+		{
+			return false;
+		}
+		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+	}
+	return true;
+}
+
+// Clears the static loader callbacks a test installed
+struct LoaderCallbackScope
+{
+	~LoaderCallbackScope()
+	{
+		AssetManager::clearAsyncSceneLoaderCallback();
+		AssetManager::clearSceneLoaderCallback();
+	}
+};
+
+} // namespace
+
+TEST_CASE( "AssetManager loadAsync loads on a worker and finalises on the main thread", "[AssetManager][async][unit]" )
+{
+	runtime::ThreadPool pool( 2 );
+	LoaderCallbackScope scope;
+
+	Gate gate;
+	std::atomic<std::thread::id> loaderThread;
+	AssetManager::setAsyncSceneLoaderCallback( [&]( const std::string &, assets::LoadContext &context ) {
+		loaderThread = std::this_thread::get_id();
+		context.setProgress( 0.5f );
+		gate.wait();
+		return std::make_shared<assets::Scene>();
+	} );
+
+	AssetManager manager;
+	manager.setLoadThreadPool( &pool );
+
+	bool readyCalled = false;
+	auto handle = manager.loadAsync<assets::Scene>( "slow.gltf", LoadPriority::Normal, [&]( std::shared_ptr<assets::Scene> scene ) {
+		REQUIRE( scene );
+		readyCalled = true;
+	} );
+	REQUIRE( handle.isValid() );
+	REQUIRE( handle.getPath() == "slow.gltf" );
+
+	// The loader reports progress while it runs
+	REQUIRE( waitUntil( [&] { return handle.getProgress() == 0.5f; } ) );
+	REQUIRE( handle.getStatus() == LoadStatus::Loading );
+	REQUIRE( loaderThread.load() != std::this_thread::get_id() );
+	REQUIRE( manager.getPendingLoadCount() == 1 );
+
+	// Finished loads wait for the main thread
+	gate.open();
+	REQUIRE( waitUntil( [&] { return handle.getStatus() == LoadStatus::Finalizing; } ) );
+	REQUIRE_FALSE( readyCalled );
+	REQUIRE_FALSE( manager.isCached( "slow.gltf" ) );
+	REQUIRE( handle.get() == nullptr );
+
+	REQUIRE( manager.processCompletedLoads() == 1 );
+	REQUIRE( readyCalled );
+	REQUIRE( handle.getStatus() == LoadStatus::Ready );
+	REQUIRE( handle.getProgress() == 1.0f );
+	REQUIRE( handle.get() );
+	REQUIRE( handle.get()->isLoaded() );
+	REQUIRE( handle.get() == manager.get<assets::Scene>( "slow.gltf" ) );
+	REQUIRE( manager.getPendingLoadCount() == 0 );
+
+	// Later requests are served from the cache, still finalised on the main thread
+	int cachedReady = 0;
+	auto again = manager.loadAsync<assets::Scene>( "slow.gltf", LoadPriority::Normal, [&]( std::shared_ptr<assets::Scene> ) { ++cachedReady; } );
+	REQUIRE( again.getStatus() == LoadStatus::Finalizing );
+	manager.processCompletedLoads();
+	REQUIRE( cachedReady == 1 );
+	REQUIRE( again.get() == handle.get() );
+
+	// A cached asset of another type fails rather than being cast
+	auto wrongType = manager.loadAsync<assets::Material>( "slow.gltf" );
+	manager.processCompletedLoads();
+	REQUIRE( wrongType.getStatus() == LoadStatus::Failed );
+	REQUIRE( wrongType.get() == nullptr );
+}
+
+TEST_CASE( "AssetManager loadAsync shares one load between requests for the same path", "[AssetManager][async][unit]" )
+{
+	runtime::ThreadPool pool( 4 );
+	LoaderCallbackScope scope;
+
+	Gate gate;
+	std::atomic<int> loaderCalls = 0;
+	AssetManager::setSceneLoaderCallback( [&]( const std::string & ) {
+		++loaderCalls;
+		gate.wait();
+		return std::make_shared<assets::Scene>();
+	} );
+
+	AssetManager manager;
+	manager.setLoadThreadPool( &pool );
+
+	int readyCalls = 0;
+	std::vector<assets::LoadHandle<assets::Scene>> handles;
+	for ( int i = 0; i < 8; ++i )
+	{
+		handles.push_back( manager.loadAsync<assets::Scene>( "shared.gltf", LoadPriority::Normal, [&]( std::shared_ptr<assets::Scene> ) { ++readyCalls; } ) );
+	}
+	REQUIRE( manager.getPendingLoadCount() == 1 );
+
+	gate.open();
+	manager.waitForLoads();
+
+	REQUIRE( loaderCalls == 1 );
+	REQUIRE( readyCalls == 8 );
+	for ( const auto &handle : handles )
+	{
+		REQUIRE( handle.getStatus() == LoadStatus::Ready );
+		REQUIRE( handle.get() == handles.front().get() );
+	}
+}
+
+TEST_CASE( "AssetManager loadAsync starts higher priority loads first", "[AssetManager][async][unit]" )
+{
+	runtime::ThreadPool pool( 1 );
+	LoaderCallbackScope scope;
+
+	Gate gate;
+	std::mutex orderMutex;
+	std::vector<std::string> order;
+	AssetManager::setSceneLoaderCallback( [&]( const std::string &path ) {
+		if ( path == "blocker.gltf" )
+		{
+			gate.wait();
+		}
+		std::lock_guard lock( orderMutex );
+		order.push_back( path );
+		return std::make_shared<assets::Scene>();
+	} );
+
+	AssetManager manager;
+	manager.setLoadThreadPool( &pool );
+
+	// Occupy the only worker so the rest queue up
+	auto blocker = manager.loadAsync<assets::Scene>( "blocker.gltf" );
+	REQUIRE( waitUntil( [&] { return blocker.getStatus() == LoadStatus::Loading; } ) );
+
+	auto low = manager.loadAsync<assets::Scene>( "low.gltf", LoadPriority::Low );
+	auto normalA = manager.loadAsync<assets::Scene>( "normal_a.gltf", LoadPriority::Normal );
+	auto high = manager.loadAsync<assets::Scene>( "high.gltf", LoadPriority::High );
+	auto normalB = manager.loadAsync<assets::Scene>( "normal_b.gltf", LoadPriority::Normal );
+	// Joining a queued load with a higher priority promotes it; it keeps its place among equal priorities
+	auto promoted = manager.loadAsync<assets::Scene>( "low.gltf", LoadPriority::High );
+	REQUIRE( low.getStatus() == LoadStatus::Queued );
+
+	gate.open();
+	manager.waitForLoads();
+
+	const std::vector<std::string> expected = { "blocker.gltf", "low.gltf", "high.gltf", "normal_a.gltf", "normal_b.gltf" };
+	REQUIRE( order == expected );
+	REQUIRE( promoted.get() == low.get() );
+}
+
+TEST_CASE( "AssetManager loadAsync cancellation", "[AssetManager][async][unit]" )
+{
+	runtime::ThreadPool pool( 1 );
+	LoaderCallbackScope scope;
+
+	Gate gate;
+	std::atomic<int> loaderCalls = 0;
+	std::atomic<bool> sawCancel = false;
+	AssetManager::setAsyncSceneLoaderCallback( [&]( const std::string &path, assets::LoadContext &context ) -> std::shared_ptr<assets::Scene> {
+		++loaderCalls;
+		if ( path == "running.gltf" )
+		{
+			// Cooperative cancellation: poll between chunks of work
+			while ( !context.isCancelled() )
+			{
+				std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+			}
+			sawCancel = true;
+			return std::make_shared<assets::Scene>(); // Partial result, must be dropped
+		}
+		gate.wait();
+		return std::make_shared<assets::Scene>();
+	} );
+
+	AssetManager manager;
+	manager.setLoadThreadPool( &pool );
+
+	SECTION( "Queued loads are cancelled without running" )
+	{
+		auto blocker = manager.loadAsync<assets::Scene>( "blocker.gltf" );
+		REQUIRE( waitUntil( [&] { return blocker.getStatus() == LoadStatus::Loading; } ) );
+
+		bool readyCalled = false;
+		auto queued = manager.loadAsync<assets::Scene>( "queued.gltf", LoadPriority::Normal, [&]( std::shared_ptr<assets::Scene> ) { readyCalled = true; } );
+		queued.cancel();
+		REQUIRE( queued.getStatus() == LoadStatus::Cancelled );
+		REQUIRE( queued.isDone() );
+
+		gate.open();
+		manager.waitForLoads();
+		REQUIRE( loaderCalls == 1 );
+		REQUIRE_FALSE( readyCalled );
+		REQUIRE_FALSE( manager.isCached( "queued.gltf" ) );
+		REQUIRE( blocker.getStatus() == LoadStatus::Ready );
+	}
+
+	SECTION( "Running loads see the cancellation and their result is dropped" )
+	{
+		auto running = manager.loadAsync<assets::Scene>( "running.gltf" );
+		REQUIRE( waitUntil( [&] { return running.getStatus() == LoadStatus::Loading; } ) );
+		running.cancel();
+
+		manager.waitForLoads();
+		REQUIRE( sawCancel );
+		REQUIRE( running.getStatus() == LoadStatus::Cancelled );
+		REQUIRE( running.get() == nullptr );
+		REQUIRE_FALSE( manager.isCached( "running.gltf" ) );
+
+		// A new request after a cancellation starts a fresh load
+		gate.open();
+		AssetManager::setAsyncSceneLoaderCallback( []( const std::string &, assets::LoadContext & ) { return std::make_shared<assets::Scene>(); } );
+		auto retry = manager.loadAsync<assets::Scene>( "running.gltf" );
+		manager.waitForLoads();
+		REQUIRE( retry.getStatus() == LoadStatus::Ready );
+	}
+
+	SECTION( "Cancelling one of several handles leaves the load to the others" )
+	{
+		int firstReady = 0;
+		int secondReady = 0;
+		auto first = manager.loadAsync<assets::Scene>( "shared.gltf", LoadPriority::Normal, [&]( std::shared_ptr<assets::Scene> ) { ++firstReady; } );
+		auto second = manager.loadAsync<assets::Scene>( "shared.gltf", LoadPriority::Normal, [&]( std::shared_ptr<assets::Scene> ) { ++secondReady; } );
+		auto firstCopy = first;
+		first.cancel();
+		firstCopy.cancel(); // Copies share one claim
+
+		gate.open();
+		manager.waitForLoads();
+		REQUIRE( first.getStatus() == LoadStatus::Cancelled );
+		REQUIRE( second.getStatus() == LoadStatus::Ready );
+		REQUIRE( second.get() );
+		REQUIRE( firstReady == 0 );
+		REQUIRE( secondReady == 1 );
+	}
+}
+
+TEST_CASE( "AssetManager loadAsync reports failed loads and survives destruction mid-load", "[AssetManager][async][unit]" )
+{
+	runtime::ThreadPool pool( 2 );
+	LoaderCallbackScope scope;
+
+	SECTION( "A loader returning null fails the load" )
+	{
+		AssetManager manager;
+		manager.setLoadThreadPool( &pool );
+		AssetManager::setSceneLoaderCallback( []( const std::string & ) { return std::shared_ptr<assets::Scene>(); } );
+
+		auto handle = manager.loadAsync<assets::Scene>( "missing.gltf" );
+		manager.waitForLoads();
+		REQUIRE( handle.getStatus() == LoadStatus::Failed );
+		REQUIRE_FALSE( manager.isCached( "missing.gltf" ) );
+	}
+
+	SECTION( "Destroying the manager cancels and waits for its loads" )
+	{
+		std::atomic<bool> loaderReturned = false;
+		AssetManager::setAsyncSceneLoaderCallback( [&]( const std::string &, assets::LoadContext &context ) {
+			while ( !context.isCancelled() )
+			{
+				std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+			}
+			loaderReturned = true;
+			return std::shared_ptr<assets::Scene>();
+		} );
+
+		assets::LoadHandle<assets::Scene> handle;
+		{
+			AssetManager manager;
+			manager.setLoadThreadPool( &pool );
+			handle = manager.loadAsync<assets::Scene>( "endless.gltf" );
+			REQUIRE( waitUntil( [&] { return handle.getStatus() == LoadStatus::Loading; } ) );
+		}
+		REQUIRE( loaderReturned );
+		REQUIRE_FALSE( handle.isDone() );
+		handle.cancel(); // Harmless once the manager is gone
+	}
+}
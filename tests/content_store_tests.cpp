@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine/assets/asset_manager.h"
+#include "engine/assets/assets.h"
+#include "engine/assets/content_store.h"
+
+namespace
+{
+
+std::shared_ptr<assets::Mesh> makeMesh( float height, assets::MaterialHandle material = 0 )
+{
+	assets::Primitive primitive;
+	std::vector<assets::Vertex> vertices( 3 );
+	vertices[0].position = { 0.0f, height, 0.0f };
+	vertices[1].position = { 1.0f, height, 0.0f };
+	vertices[2].position = { 0.0f, height, 1.0f };
+	primitive.setVertices( std::move( vertices ), math::BoundingBox3Df{ { 0.0f, height, 0.0f }, { 1.0f, height, 1.0f } } );
+	primitive.setIndices( { 0, 1, 2 } );
+	primitive.setMaterialHandle( material );
+
+	auto mesh = std::make_shared<assets::Mesh>();
+	mesh->addPrimitive( std::move( primitive ) );
+	return mesh;
+}
+
+std::shared_ptr<assets::Material> makeMaterial( float metallic, const std::string &name = "Metal" )
+{
+	auto material = std::make_shared<assets::Material>();
+	material->setName( name );
+	material->setMetallicFactor( metallic );
+	return material;
+}
+
+// One material per entry of metallic, then one single-triangle mesh per height using material 0
+std::shared_ptr<assets::Scene> makeKit( const std::vector<float> &heights, const std::vector<float> &metallic = { 1.0f } )
+{
+	auto scene = std::make_shared<assets::Scene>();
+	for ( const float value : metallic )
+	{
+		scene->addMaterial( makeMaterial( value ) );
+	}
+	for ( const float height : heights )
+	{
+		scene->addMesh( makeMesh( height ) );
+	}
+	return scene;
+}
+
+} // namespace
+
+TEST_CASE( "ContentStore shares identical meshes and materials between scenes", "[assets][content_store][unit]" )
+{
+	assets::ContentStore store;
+	const auto first = makeKit( { 0.0f, 1.0f, 2.0f } );
+	REQUIRE( store.internScene( *first ) == 0 );
+
+	// Two props of the first kit plus one of its own; the material is renamed by the exporter
+	const auto second = makeKit( { 2.0f, 5.0f, 0.0f } );
+	second->getMaterial( 0 )->setName( "Metal.001" );
+	const auto duplicateMesh = second->getMesh( 0 );
+	const auto duplicateMaterial = second->getMaterial( 0 );
+	const std::size_t saved = store.internScene( *second );
+
+	REQUIRE( second->getMaterial( 0 ) == first->getMaterial( 0 ) );
+	REQUIRE( second->getMesh( 0 ) == first->getMesh( 2 ) );
+	REQUIRE( second->getMesh( 1 ) != first->getMesh( 1 ) );
+	REQUIRE( second->getMesh( 2 ) == first->getMesh( 0 ) );
+	REQUIRE( saved == 2 * duplicateMesh->getMemoryUsage() + duplicateMaterial->getMemoryUsage() );
+
+	const auto stats = store.getStats();
+	REQUIRE( stats.meshesShared == 2 );
+	REQUIRE( stats.materialsShared == 1 );
+	REQUIRE( stats.bytesSaved == saved );
+	REQUIRE( stats.uploadBytesSaved == 2 * ( duplicateMesh->getPrimitive( 0 ).getVertexData().size() + 3 * sizeof( std::uint32_t ) ) );
+	REQUIRE( stats.meshCount == 4 );
+	REQUIRE( stats.materialCount == 1 );
+
+	// Interning again is a no-op
+	REQUIRE( store.internScene( *second ) == 0 );
+	REQUIRE( store.getStats().meshesShared == 2 );
+}
+
+TEST_CASE( "ContentStore only shares meshes whose materials match", "[assets][content_store][unit]" )
+{
+	assets::ContentStore store;
+	const auto first = makeKit( { 0.0f, 1.0f } );
+	store.internScene( *first );
+
+	SECTION( "Same geometry over a different material" )
+	{
+		const auto other = makeKit( { 0.0f, 1.0f }, { 0.5f } );
+		REQUIRE( store.internScene( *other ) == 0 );
+		REQUIRE( other->getMesh( 0 ) != first->getMesh( 0 ) );
+		REQUIRE( other->getMaterial( 0 ) != first->getMaterial( 0 ) );
+	}
+
+	SECTION( "Same geometry and material under another handle" )
+	{
+		const auto other = makeKit( {}, { 0.5f, 1.0f } );
+		other->addMesh( makeMesh( 0.0f, 1 ) );
+		store.internScene( *other );
+		REQUIRE( other->getMaterial( 1 ) == first->getMaterial( 0 ) );
+		REQUIRE( other->getMesh( 0 ) != first->getMesh( 0 ) );
+	}
+
+	SECTION( "Different indices or LODs" )
+	{
+		const auto other = makeKit( { 0.0f, 1.0f } );
+		other->getMesh( 0 )->getPrimitive( 0 ).setIndices( { 0, 2, 1 } );
+		other->getMesh( 1 )->getPrimitive( 0 ).addLod( { { 0, 1, 2 }, 0.5f } );
+		store.internScene( *other );
+		REQUIRE( other->getMesh( 0 ) != first->getMesh( 0 ) );
+		REQUIRE( other->getMesh( 1 ) != first->getMesh( 1 ) );
+		REQUIRE( other->getMaterial( 0 ) == first->getMaterial( 0 ) );
+	}
+}
+
+TEST_CASE( "ContentStore does not keep assets alive", "[assets][content_store][unit]" )
+{
+	assets::ContentStore store;
+	auto first = makeKit( { 0.0f, 1.0f } );
+	store.internScene( *first );
+	std::weak_ptr<assets::Mesh> mesh = first->getMesh( 0 );
+	first.reset();
+	REQUIRE( mesh.expired() );
+	REQUIRE( store.getStats().meshCount == 0 );
+	REQUIRE( store.getStats().materialCount == 0 );
+
+	// The next import with the same content is stored afresh
+	const auto second = makeKit( { 0.0f, 1.0f } );
+	REQUIRE( store.internScene( *second ) == 0 );
+	REQUIRE( store.getStats().meshCount == 2 );
+
+	store.clear();
+	REQUIRE( store.getStats().meshCount == 0 );
+	REQUIRE( store.internScene( *makeKit( { 0.0f, 1.0f } ) ) == 0 );
+}
+
+TEST_CASE( "ContentStore interns concurrent loads consistently", "[assets][content_store][unit]" )
+{
+	assets::ContentStore store;
+	constexpr int kThreads = 8;
+	std::vector<std::shared_ptr<assets::Scene>> scenes( kThreads );
+	std::vector<std::thread> threads;
+	for ( int i = 0; i < kThreads; ++i )
+	{
+		threads.emplace_back( [&store, &scenes, i] {
+			scenes[i] = makeKit( { 0.0f, 1.0f, 2.0f, 3.0f } );
+			store.internScene( *scenes[i] );
+		} );
+	}
+	for ( auto &thread : threads )
+	{
+		thread.join();
+	}
+
+	for ( const auto &scene : scenes )
+	{
+		REQUIRE( scene->getMeshes() == scenes[0]->getMeshes() );
+		REQUIRE( scene->getMaterial( 0 ) == scenes[0]->getMaterial( 0 ) );
+	}
+	const auto stats = store.getStats();
+	REQUIRE( stats.meshesShared == 4 * ( kThreads - 1 ) );
+	REQUIRE( stats.materialsShared == kThreads - 1 );
+	REQUIRE( stats.meshCount == 4 );
+}
+
+TEST_CASE( "AssetManager interns loaded scenes into its content store", "[assets][content_store][AssetManager][unit]" )
+{
+	assets::AssetManager::setSceneLoaderCallback( []( const std::string &path ) -> std::shared_ptr<assets::Scene> {
+		return path == "kit_b.gltf" ? makeKit( { 3.0f, 1.0f } ) : makeKit( { 1.0f, 2.0f } );
+	} );
+
+	assets::AssetManager manager;
+	const auto store = std::make_shared<assets::ContentStore>();
+	manager.setContentStore( store );
+	REQUIRE( manager.getContentStore() == store );
+
+	const auto a = manager.load<assets::Scene>( "kit_a.gltf" );
+	const auto b = manager.load<assets::Scene>( "kit_b.gltf" );
+	REQUIRE( a );
+	REQUIRE( b );
+	REQUIRE( b->getMesh( 1 ) == a->getMesh( 0 ) );
+	REQUIRE( b->getMaterial( 0 ) == a->getMaterial( 0 ) );
+	REQUIRE( store->getStats().meshesShared == 1 );
+
+	// Without a store nothing is shared
+	assets::AssetManager plain;
+	const auto c = plain.load<assets::Scene>( "kit_a.gltf" );
+	REQUIRE( c->getMesh( 0 ) != a->getMesh( 0 ) );
+
+	assets::AssetManager::clearSceneLoaderCallback();
+}
@@ -0,0 +1,219 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "engine/debug_draw/debug_draw.h"
+#include "math/math.h"
+#include "math/matrix.h"
+
+using Catch::Approx;
+using engine::debug_draw::DebugDrawBatcher;
+using engine::debug_draw::DebugDrawList;
+using engine::debug_draw::DebugDrawRange;
+using engine::debug_draw::DebugVertex;
+using engine::debug_draw::DepthMode;
+
+namespace
+{
+const math::Vec4f kRed{ 1.0f, 0.0f, 0.0f, 1.0f };
+const math::Vec4f kGreen{ 0.0f, 1.0f, 0.0f, 1.0f };
+
+math::BoundingBox3Df unitBox()
+{
+	return math::BoundingBox3Df( math::Vec3f{ -1.0f, -1.0f, -1.0f }, math::Vec3f{ 1.0f, 1.0f, 1.0f } );
+}
+} // namespace
+
+TEST_CASE( "Debug shapes emit the expected line lists", "[debug_draw][unit]" )
+{
+	DebugDrawList list;
+	list.addLine( { 0.0f, 0.0f, 0.0f }, { 1.0f, 2.0f, 3.0f }, kRed );
+	REQUIRE( list.lineCount() == 1 );
+	REQUIRE( list.getVertices( DepthMode::Tested )[1].position.z == 3.0f );
+	REQUIRE( list.getVertices( DepthMode::Tested )[1].color.x == 1.0f );
+
+	list.clear();
+	list.addBox( unitBox(), kRed );
+	REQUIRE( list.lineCount() == 12 );
+	// Every box edge is axis-aligned with length 2
+	const auto &boxVertices = list.getVertices( DepthMode::Tested );
+	for ( std::size_t i = 0; i < boxVertices.size(); i += 2 )
+	{
+		REQUIRE( math::length( boxVertices[i + 1].position - boxVertices[i].position ) == Approx( 2.0f ) );
+	}
+
+	// Invalid bounds draw nothing
+	list.clear();
+	list.addBox( math::BoundingBox3Df(), kRed );
+	REQUIRE( list.empty() );
+
+	list.addBox( unitBox(), math::Mat4f::translation( 10.0f, 0.0f, 0.0f ), kRed, DepthMode::Overlay );
+	REQUIRE( list.getVertices( DepthMode::Overlay ).size() == 24 );
+	REQUIRE( list.getVertices( DepthMode::Overlay )[0].position.x == Approx( 9.0f ) );
+
+	list.clear();
+	list.addSphere( { 0.0f, 0.0f, 5.0f }, 2.0f, kGreen, DepthMode::Tested, 16 );
+	REQUIRE( list.lineCount() == 48 );
+	for ( const DebugVertex &vertex : list.getVertices( DepthMode::Tested ) )
+	{
+		REQUIRE( math::length( vertex.position - math::Vec3f{ 0.0f, 0.0f, 5.0f } ) == Approx( 2.0f ) );
+	}
+}
+
+TEST_CASE( "Frustum corners are reconstructed from the view-projection", "[debug_draw][unit]" )
+{
+	const auto view = math::Mat4f::lookAt( { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } );
+	const auto projection = math::Mat4f::perspective( math::radians( 90.0f ), 1.0f, 1.0f, 10.0f );
+
+	DebugDrawList list;
+	list.addFrustum( projection * view, kRed );
+	REQUIRE( list.lineCount() == 12 );
+
+	// Corners lie on the near (y = 1) and far (y = 10) planes at +-depth in x and z for a 90 degree FOV
+	for ( const DebugVertex &vertex : list.getVertices( DepthMode::Tested ) )
+	{
+		const float depth = vertex.position.y;
+		const bool onNear = depth == Approx( 1.0f ).margin( 1e-3f );
+		const bool onFar = depth == Approx( 10.0f ).margin( 1e-2f );
+		REQUIRE( ( onNear || onFar ) );
+		REQUIRE( std::abs( vertex.position.x ) == Approx( depth ).margin( 1e-2f ) );
+		REQUIRE( std::abs( vertex.position.z ) == Approx( depth ).margin( 1e-2f ) );
+	}
+
+	// A singular matrix draws nothing
+	list.clear();
+	list.addFrustum( math::Mat4f{}, kRed );
+	REQUIRE( list.empty() );
+}
+
+TEST_CASE( "Flush packs depth modes into one contiguous array and resets the frame", "[debug_draw][unit]" )
+{
+	DebugDrawBatcher batcher;
+	batcher.addLine( { 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, kRed, DepthMode::Overlay );
+	batcher.addBox( unitBox(), kGreen );
+	batcher.addLine( { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, kRed, DepthMode::Overlay );
+	REQUIRE( batcher.pendingLineCount() == 14 );
+
+	std::vector<DebugVertex> vertices;
+	std::vector<DebugDrawRange> ranges;
+	batcher.flush( vertices, ranges );
+
+	REQUIRE( vertices.size() == 28 );
+	REQUIRE( ranges.size() == 2 );
+	REQUIRE( ranges[0].mode == DepthMode::Tested );
+	REQUIRE( ranges[0].firstVertex == 0 );
+	REQUIRE( ranges[0].vertexCount == 24 );
+	REQUIRE( ranges[1].mode == DepthMode::Overlay );
+	REQUIRE( ranges[1].firstVertex == 24 );
+	REQUIRE( ranges[1].vertexCount == 4 );
+	REQUIRE( vertices[25].position.x == 1.0f );
+
+	const auto &stats = batcher.getLastFlushStats();
+	REQUIRE( stats.lines == 14 );
+	REQUIRE( stats.draws == 2 );
+	REQUIRE( stats.submissions == 3 );
+	REQUIRE( stats.uploadBytes == 28 * sizeof( DebugVertex ) );
+
+	// The next frame starts empty and an empty flush produces no draws
+	REQUIRE( batcher.pendingLineCount() == 0 );
+	batcher.flush( vertices, ranges );
+	REQUIRE( vertices.empty() );
+	REQUIRE( ranges.empty() );
+	REQUIRE( batcher.getLastFlushStats().draws == 0 );
+
+	batcher.addSphere( { 0.0f, 0.0f, 0.0f }, 1.0f, kRed );
+	batcher.clear();
+	REQUIRE( batcher.pendingLineCount() == 0 );
+}
+
+TEST_CASE( "Debug geometry can be emitted from worker threads", "[debug_draw][unit]" )
+{
+	constexpr std::uint32_t kThreads = 8;
+	constexpr std::uint32_t kBoxesPerThread = 500;
+
+	DebugDrawBatcher batcher;
+	std::vector<std::thread> workers;
+	for ( std::uint32_t t = 0; t < kThreads; ++t )
+	{
+		workers.emplace_back( [&batcher, t]() {
+			// Half the threads use the locking helpers, half build a local list and submit it once
+			DebugDrawList local;
+			for ( std::uint32_t i = 0; i < kBoxesPerThread; ++i )
+			{
+				const math::Vec3f center{ static_cast<float>( t ), static_cast<float>( i ), 0.0f };
+				const math::BoundingBox3Df bounds( center - math::Vec3f{ 0.5f, 0.5f, 0.5f }, center + math::Vec3f{ 0.5f, 0.5f, 0.5f } );
+				if ( t % 2 == 0 )
+				{
+					batcher.addBox( bounds, kRed );
+					batcher.addLine( center, center + math::Vec3f{ 0.0f, 0.0f, 1.0f }, kGreen, DepthMode::Overlay );
+				}
+				else
+				{
+					local.addBox( bounds, kRed );
+					local.addLine( center, center + math::Vec3f{ 0.0f, 0.0f, 1.0f }, kGreen, DepthMode::Overlay );
+				}
+			}
+			batcher.submit( local );
+		} );
+	}
+	for ( auto &worker : workers )
+	{
+		worker.join();
+	}
+
+	std::vector<DebugVertex> vertices;
+	std::vector<DebugDrawRange> ranges;
+	batcher.flush( vertices, ranges );
+
+	REQUIRE( batcher.getLastFlushStats().lines == kThreads * kBoxesPerThread * 13 );
+	REQUIRE( ranges.size() == 2 );
+	REQUIRE( ranges[0].vertexCount == kThreads * kBoxesPerThread * 24 );
+	REQUIRE( ranges[1].vertexCount == kThreads * kBoxesPerThread * 2 );
+	REQUIRE( batcher.getLastFlushStats().submissions == ( kThreads / 2 ) * kBoxesPerThread * 2 + kThreads / 2 );
+
+	// Lines are never torn: each pair keeps the colour of its shape
+	for ( const DebugDrawRange &range : ranges )
+	{
+		const math::Vec4f expected = range.mode == DepthMode::Tested ? kRed : kGreen;
+		for ( std::uint32_t i = range.firstVertex; i < range.firstVertex + range.vertexCount; ++i )
+		{
+			REQUIRE( vertices[i].color.x == expected.x );
+			REQUIRE( vertices[i].color.y == expected.y );
+		}
+	}
+}
+
+TEST_CASE( "Debug draw batching performance for 10k bounds", "[debug_draw][performance]" )
+{
+	constexpr std::uint32_t kBoxes = 10000;
+
+	DebugDrawBatcher batcher;
+	std::vector<DebugVertex> vertices;
+	std::vector<DebugDrawRange> ranges;
+
+	// Warm-up frame sizes the arrays; the measured frame should not allocate
+	double elapsed = 0.0;
+	for ( int frame = 0; frame < 2; ++frame )
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		for ( std::uint32_t i = 0; i < kBoxes; ++i )
+		{
+			const math::Vec3f center{ static_cast<float>( i % 100 ), static_cast<float>( i / 100 ), 0.0f };
+			batcher.addBox( math::BoundingBox3Df( center, center + math::Vec3f{ 0.8f, 0.8f, 0.8f } ), kRed );
+		}
+		batcher.flush( vertices, ranges );
+		elapsed = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+	}
+
+	INFO( "10k boxes: " << elapsed << " ms, " << batcher.getLastFlushStats().uploadBytes << " bytes in " << ranges.size() << " draw" );
+	REQUIRE( ranges.size() == 1 );
+	REQUIRE( batcher.getLastFlushStats().lines == kBoxes * 12 );
+	// The budget is advisory; scheduler stalls would otherwise fail the run
+	if ( elapsed >= 100.0 )
+	{
+		WARN( "10k boxes took " << elapsed << " ms, over the 100 ms budget" );
+	}
+}
@@ -0,0 +1,313 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "engine/descriptors/descriptor_allocator.h"
+
+using engine::descriptors::DescriptorAllocator;
+using engine::descriptors::DescriptorRange;
+
+namespace
+{
+// Owner of every descriptor slot, to prove live ranges never overlap
+class SlotMap
+{
+public:
+	explicit SlotMap( std::uint32_t capacity ) : m_owners( capacity, 0 ) {}
+
+	bool claim( const DescriptorRange &range, std::uint32_t owner )
+	{
+		for ( std::uint32_t i = range.index; i < range.index + range.count; ++i )
+		{
+			if ( m_owners[i] != 0 )
+			{
+				return false;
+			}
+			m_owners[i] = owner;
+		}
+		return true;
+	}
+
+	void release( const DescriptorRange &range )
+	{
+		for ( std::uint32_t i = range.index; i < range.index + range.count; ++i )
+		{
+			m_owners[i] = 0;
+		}
+	}
+
+private:
+	std::vector<std::uint32_t> m_owners;
+};
+} // namespace
+
+TEST_CASE( "Descriptor allocator keeps reserved, persistent and frame regions apart", "[descriptors][unit]" )
+{
+	DescriptorAllocator allocator( 64, 32, 16 );
+	REQUIRE( allocator.getTotalCapacity() == 112 );
+	REQUIRE( allocator.getFrameRegionStart() == 80 );
+
+	const auto texture = allocator.allocate( 1 );
+	const auto table = allocator.allocate( 8 );
+	REQUIRE( texture.isValid() );
+	REQUIRE( table.isValid() );
+	REQUIRE( texture.index >= 16 );
+	REQUIRE( table.index >= 16 );
+	REQUIRE( table.index + table.count <= 80 );
+	REQUIRE( ( texture.index + 1 <= table.index || table.index + table.count <= texture.index ) );
+
+	const auto frame = allocator.allocateFrame( 4 );
+	REQUIRE( frame.isValid() );
+	REQUIRE( frame.index >= 80 );
+	REQUIRE( frame.index + frame.count <= 112 );
+
+	REQUIRE_FALSE( allocator.allocate( 0 ).isValid() );
+	REQUIRE_FALSE( allocator.allocateFrame( 0 ).isValid() );
+	REQUIRE_FALSE( allocator.allocate( 65 ).isValid() );
+	REQUIRE( allocator.getStats().persistentFailures == 1 );
+	REQUIRE( allocator.getStats().persistentAllocations == 2 );
+	REQUIRE( allocator.getStats().persistentDescriptors == 9 );
+}
+
+TEST_CASE( "Freed descriptors are reused only after their fence completes", "[descriptors][unit]" )
+{
+	DescriptorAllocator allocator( 4, 0 );
+	std::vector<DescriptorRange> ranges;
+	for ( int i = 0; i < 4; ++i )
+	{
+		ranges.push_back( allocator.allocate( 1 ) );
+	}
+	REQUIRE_FALSE( allocator.allocate( 1 ).isValid() );
+
+	// The GPU may still read the descriptor until fence 5 completes
+	allocator.free( ranges[2], 5 );
+	allocator.free( ranges[2], 5 ); // Double free before the fence is ignored
+	REQUIRE( allocator.getStats().pendingFrees == 1 );
+	REQUIRE_FALSE( allocator.allocate( 1 ).isValid() );
+
+	allocator.reclaim( 4 );
+	REQUIRE_FALSE( allocator.allocate( 1 ).isValid() );
+
+	allocator.reclaim( 5 );
+	REQUIRE( allocator.getStats().pendingFrees == 0 );
+	const auto reused = allocator.allocate( 1 );
+	REQUIRE( reused.isValid() );
+	REQUIRE( reused.index == ranges[2].index );
+
+	// Fence 0 means the range was never used by the GPU
+	allocator.free( ranges[0], 0 );
+	REQUIRE( allocator.allocate( 1 ).index == ranges[0].index );
+
+	// Freeing a range that is no longer allocated is a no-op
+	allocator.free( ranges[0], 0 );
+	allocator.free( ranges[0], 0 );
+	REQUIRE( allocator.getStats().persistentAllocations == 4 );
+}
+
+TEST_CASE( "Frame ring recycles by fence and keeps tables contiguous across the wrap", "[descriptors][unit]" )
+{
+	DescriptorAllocator allocator( 0, 16 );
+
+	// Frame 1 uses 10 of 16 descriptors
+	const auto first = allocator.allocateFrame( 10 );
+	REQUIRE( first.index == 0 );
+	allocator.endFrame( 1 );
+	REQUIRE( allocator.getLastFrameStats().frameDescriptors == 10 );
+
+	// Frame 2: 6 at the end would fit, 8 must not split across the wrap and the front is still in flight
+	REQUIRE_FALSE( allocator.allocateFrame( 8 ).isValid() );
+	REQUIRE( allocator.getStats().frameFailures == 1 );
+	REQUIRE( allocator.getOldestFrameFence() == 1 );
+
+	allocator.reclaim( 1 );
+	REQUIRE( allocator.getInFlightFrameCount() == 0 );
+	const auto wrapped = allocator.allocateFrame( 8 );
+	REQUIRE( wrapped.isValid() );
+	REQUIRE( wrapped.index == 0 ); // Ring was empty, so it restarted at the front
+	const auto tail = allocator.allocateFrame( 8 );
+	REQUIRE( tail.index == 8 );
+	REQUIRE_FALSE( allocator.allocateFrame( 1 ).isValid() );
+	allocator.endFrame( 2 );
+
+	// Frame 3 may not reuse frame 2's descriptors before fence 2
+	REQUIRE( allocator.getFrameUsed() == 16 );
+	REQUIRE_FALSE( allocator.allocateFrame( 1 ).isValid() );
+	allocator.reclaim( 2 );
+	REQUIRE( allocator.getFrameUsed() == 0 );
+	REQUIRE( allocator.allocateFrame( 16 ).isValid() );
+	REQUIRE_FALSE( allocator.allocateFrame( 17 ).isValid() );
+}
+
+TEST_CASE( "Frame ring skips the end of the ring when a table does not fit", "[descriptors][unit]" )
+{
+	DescriptorAllocator allocator( 0, 16 );
+	allocator.allocateFrame( 6 );
+	allocator.endFrame( 1 );
+	allocator.allocateFrame( 6 );
+	allocator.endFrame( 2 );
+	allocator.reclaim( 1 );
+
+	// Head is at 12 and tail at 6: a table of 5 skips [12, 16) and lands at the front
+	const auto wrapped = allocator.allocateFrame( 5 );
+	REQUIRE( wrapped.index == 0 );
+	REQUIRE( allocator.getFrameUsed() == 6 + 4 + 5 );
+	REQUIRE_FALSE( allocator.allocateFrame( 2 ).isValid() );
+	REQUIRE( allocator.allocateFrame( 1 ).index == 5 );
+	allocator.endFrame( 3 );
+
+	allocator.reclaim( 3 );
+	REQUIRE( allocator.getFrameUsed() == 0 );
+	REQUIRE( allocator.getInFlightFrameCount() == 0 );
+}
+
+TEST_CASE( "Randomised descriptor traffic never hands out a slot twice", "[descriptors][unit]" )
+{
+	constexpr std::uint32_t kReserved = 16;
+	constexpr std::uint32_t kPersistent = 2048;
+	constexpr std::uint32_t kFrame = 512;
+	constexpr int kFramesInFlight = 3;
+	DescriptorAllocator allocator( kPersistent, kFrame, kReserved );
+	SlotMap slots( allocator.getTotalCapacity() );
+
+	std::mt19937 rng( 38 );
+	std::vector<DescriptorRange> live;
+	std::deque<std::vector<DescriptorRange>> retiring; // Freed ranges per in-flight frame, still owned
+	std::deque<std::vector<DescriptorRange>> frameRanges;
+	std::uint32_t owner = 1;
+	std::uint64_t fence = 0;
+
+	for ( int frame = 0; frame < 600; ++frame )
+	{
+		// The GPU completes frames kFramesInFlight behind the CPU
+		++fence;
+		const std::uint64_t completed = fence > kFramesInFlight ? fence - kFramesInFlight : 0;
+		allocator.reclaim( completed );
+		while ( retiring.size() > fence - completed - 1 )
+		{
+			for ( const auto &range : retiring.front() )
+			{
+				slots.release( range );
+			}
+			retiring.pop_front();
+			for ( const auto &range : frameRanges.front() )
+			{
+				slots.release( range );
+			}
+			frameRanges.pop_front();
+		}
+
+		std::vector<DescriptorRange> freed;
+		std::vector<DescriptorRange> transient;
+		const int operations = 1 + static_cast<int>( rng() % 64 );
+		for ( int op = 0; op < operations; ++op )
+		{
+			switch ( rng() % 4 )
+			{
+			case 0:
+			case 1:
+			{
+				const auto range = allocator.allocate( 1 + rng() % ( rng() % 8 == 0 ? 64 : 4 ) );
+				if ( range.isValid() )
+				{
+					REQUIRE( range.index >= kReserved );
+					REQUIRE( range.index + range.count <= kReserved + kPersistent );
+					REQUIRE( slots.claim( range, owner++ ) );
+					live.push_back( range );
+				}
+				break;
+			}
+			case 2:
+				if ( !live.empty() )
+				{
+					const std::size_t pick = rng() % live.size();
+					allocator.free( live[pick], fence );
+					freed.push_back( live[pick] );
+					live[pick] = live.back();
+					live.pop_back();
+				}
+				break;
+			default:
+			{
+				const auto range = allocator.allocateFrame( 1 + rng() % 32 );
+				if ( range.isValid() )
+				{
+					REQUIRE( range.index >= allocator.getFrameRegionStart() );
+					REQUIRE( range.index + range.count <= allocator.getTotalCapacity() );
+					REQUIRE( slots.claim( range, owner++ ) );
+					transient.push_back( range );
+				}
+				break;
+			}
+			}
+		}
+		allocator.endFrame( fence );
+		retiring.push_back( std::move( freed ) );
+		frameRanges.push_back( std::move( transient ) );
+	}
+
+	// Drain: everything comes back as one free persistent block and an empty ring
+	for ( const auto &range : live )
+	{
+		allocator.free( range, fence );
+	}
+	allocator.reclaim( fence );
+	REQUIRE( allocator.getStats().persistentAllocations == 0 );
+	REQUIRE( allocator.getStats().persistentDescriptors == 0 );
+	REQUIRE( allocator.getStats().pendingFrees == 0 );
+	REQUIRE( allocator.getLargestFreePersistentRange() == kPersistent );
+	REQUIRE( allocator.getFrameUsed() == 0 );
+}
+
+TEST_CASE( "Descriptor allocator serves thousands of textures with per-frame tables", "[descriptors][performance]" )
+{
+	// Heap shaped like the device's shader-visible heap: ImGui slots, 16K persistent, 4K per-frame
+	constexpr std::uint32_t kTextures = 10000;
+	constexpr std::uint32_t kTablesPerFrame = 300;
+	constexpr std::uint32_t kTableSize = 4;
+	constexpr int kFrames = 100;
+	constexpr int kFramesInFlight = 2;
+	DescriptorAllocator allocator( 16384, 4096, 16 );
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	std::vector<DescriptorRange> textures;
+	textures.reserve( kTextures );
+	for ( std::uint32_t i = 0; i < kTextures; ++i )
+	{
+		textures.push_back( allocator.allocate( 1 ) );
+		REQUIRE( textures.back().isValid() );
+	}
+
+	std::mt19937 rng( 7 );
+	std::uint32_t frameFailures = 0;
+	for ( int frame = 1; frame <= kFrames; ++frame )
+	{
+		allocator.reclaim( frame > kFramesInFlight ? frame - kFramesInFlight : 0 );
+
+		// Streaming churn: replace 1% of the textures each frame
+		for ( std::uint32_t i = 0; i < kTextures / 100; ++i )
+		{
+			auto &texture = textures[rng() % kTextures];
+			allocator.free( texture, frame );
+			texture = allocator.allocate( 1 );
+			REQUIRE( texture.isValid() );
+		}
+		for ( std::uint32_t i = 0; i < kTablesPerFrame; ++i )
+		{
+			frameFailures += allocator.allocateFrame( kTableSize ).isValid() ? 0 : 1;
+		}
+		allocator.endFrame( frame );
+	}
+	const double elapsedMs = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+
+	INFO( kTextures << " textures, " << kTablesPerFrame << " tables per frame: " << elapsedMs / kFrames << " ms per frame, "
+		<< allocator.getStats().pendingFrees << " pending frees, largest free range " << allocator.getLargestFreePersistentRange() );
+	REQUIRE( frameFailures == 0 );
+	REQUIRE( allocator.getStats().persistentAllocations == kTextures + allocator.getStats().pendingFrees );
+	// Deferred frees stay bounded by the frames in flight
+	REQUIRE( allocator.getStats().pendingFrees <= ( kFramesInFlight + 1 ) * ( kTextures / 100 ) );
+	// Generous budget (debug builds included)
+	REQUIRE( elapsedMs / kFrames < 2.0 );
+}
@@ -0,0 +1,367 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "engine/frame_graph/frame_graph.h"
+
+using engine::frame_graph::Barrier;
+using engine::frame_graph::FrameGraph;
+using engine::frame_graph::FrameGraphBackend;
+using engine::frame_graph::ResourceHandle;
+using engine::frame_graph::ResourceState;
+using engine::frame_graph::TextureDesc;
+
+namespace
+{
+// Records allocation and barrier calls in the order the graph makes them
+class MockBackend : public FrameGraphBackend
+{
+public:
+	std::vector<std::string> log;
+	std::vector<Barrier> barriers;
+	std::uint64_t heapBytes = 0;
+	bool failAllocation = false;
+
+	bool allocateTransients( const FrameGraph &graph ) override
+	{
+		log.push_back( "allocate" );
+		heapBytes = graph.getStats().heapBytes;
+		return !failAllocation;
+	}
+
+	void resourceBarriers( std::span<const Barrier> batch ) override
+	{
+		log.push_back( "barriers " + std::to_string( batch.size() ) );
+		barriers.insert( barriers.end(), batch.begin(), batch.end() );
+	}
+};
+
+TextureDesc makeDesc( std::uint64_t sizeBytes )
+{
+	TextureDesc desc;
+	desc.width = 1280;
+	desc.height = 720;
+	desc.sizeBytes = sizeBytes;
+	return desc;
+}
+
+std::vector<std::string> executionOrder( const FrameGraph &graph )
+{
+	std::vector<std::string> names;
+	for ( const auto pass : graph.getExecutionOrder() )
+	{
+		names.push_back( graph.getPassName( pass ) );
+	}
+	return names;
+}
+} // namespace
+
+TEST_CASE( "Frame graph orders passes by their resource dependencies", "[frame_graph][unit]" )
+{
+	FrameGraph graph;
+	const auto color = graph.importResource( "Color", ResourceState::RenderTarget );
+	const auto depth = graph.createTransient( "Depth", makeDesc( 1024 ) );
+
+	// Declared backwards: the composite reads what the scene writes, the scene reads the depth prepass
+	const auto composite = graph.addPass( "Composite", {} );
+	graph.read( composite, depth, ResourceState::ShaderResource );
+	graph.write( composite, color, ResourceState::RenderTarget );
+	const auto scene = graph.addPass( "Scene", {} );
+	graph.read( scene, depth, ResourceState::DepthRead );
+	graph.write( scene, color, ResourceState::RenderTarget );
+	const auto prepass = graph.addPass( "Depth Prepass", {} );
+	graph.write( prepass, depth, ResourceState::DepthWrite );
+
+	REQUIRE( graph.compile() );
+	// Writers of Color keep declaration order; both run after the only writer of Depth
+	REQUIRE( executionOrder( graph ) == std::vector<std::string>{ "Depth Prepass", "Composite", "Scene" } );
+	REQUIRE( graph.getStats().culledPasses == 0 );
+}
+
+TEST_CASE( "Frame graph culls passes whose output is never used", "[frame_graph][unit]" )
+{
+	FrameGraph graph;
+	const auto color = graph.importResource( "Color", ResourceState::RenderTarget );
+	const auto unusedTarget = graph.createTransient( "Unused", makeDesc( 4096 ) );
+	const auto chainTarget = graph.createTransient( "Chain", makeDesc( 4096 ) );
+
+	const auto main = graph.addPass( "Main", {} );
+	graph.write( main, color, ResourceState::RenderTarget );
+	const auto orphan = graph.addPass( "Orphan", {} );
+	graph.write( orphan, unusedTarget, ResourceState::RenderTarget );
+	const auto chainHead = graph.addPass( "Chain Head", {} );
+	graph.write( chainHead, chainTarget, ResourceState::RenderTarget );
+	const auto chainTail = graph.addPass( "Chain Tail", {} );
+	graph.read( chainTail, chainTarget, ResourceState::ShaderResource );
+	graph.write( chainTail, unusedTarget, ResourceState::RenderTarget );
+
+	REQUIRE( graph.compile() );
+	REQUIRE( executionOrder( graph ) == std::vector<std::string>{ "Main" } );
+	REQUIRE( graph.isCulled( orphan ) );
+	REQUIRE( graph.isCulled( chainHead ) );
+	REQUIRE( graph.isCulled( chainTail ) );
+	REQUIRE( graph.getStats().culledPasses == 3 );
+	REQUIRE( graph.getStats().allocatedTransients == 0 );
+	REQUIRE( graph.getStats().heapBytes == 0 );
+
+	// A side effect keeps the pass and everything it depends on
+	graph.setSideEffects( chainTail );
+	REQUIRE( graph.compile() );
+	REQUIRE( graph.getStats().culledPasses == 0 );
+	REQUIRE( graph.getStats().allocatedTransients == 2 );
+}
+
+TEST_CASE( "Frame graph emits only the transitions a state change needs", "[frame_graph][unit]" )
+{
+	// The editor viewport: four passes draw on one imported target that ImGui samples afterwards
+	FrameGraph graph;
+	const auto color = graph.importResource( "Viewport Color", ResourceState::ShaderResource, ResourceState::ShaderResource );
+	for ( const char *name : { "Clear", "Grid", "Selection", "Scene" } )
+	{
+		graph.write( graph.addPass( name, {} ), color, ResourceState::RenderTarget );
+	}
+
+	REQUIRE( graph.compile() );
+	REQUIRE( graph.getStats().transitionBarriers == 2 );
+	const auto first = graph.getBarriers( graph.getExecutionOrder()[0] );
+	REQUIRE( first.size() == 1 );
+	REQUIRE( first[0].before == ResourceState::ShaderResource );
+	REQUIRE( first[0].after == ResourceState::RenderTarget );
+	for ( std::size_t i = 1; i < 4; ++i )
+	{
+		REQUIRE( graph.getBarriers( graph.getExecutionOrder()[i] ).empty() );
+	}
+	REQUIRE( graph.getFinalBarriers().size() == 1 );
+	REQUIRE( graph.getFinalBarriers()[0].after == ResourceState::ShaderResource );
+
+	// Consecutive reads in different read states share one transition to the combined state
+	FrameGraph reads;
+	const auto target = reads.importResource( "Target", ResourceState::RenderTarget );
+	const auto depth = reads.createTransient( "Depth", makeDesc( 1024 ) );
+	const auto prepass = reads.addPass( "Prepass", {} );
+	reads.write( prepass, depth, ResourceState::DepthWrite );
+	const auto opaque = reads.addPass( "Opaque", {} );
+	reads.read( opaque, depth, ResourceState::DepthRead );
+	reads.write( opaque, target, ResourceState::RenderTarget );
+	const auto fog = reads.addPass( "Fog", {} );
+	reads.read( fog, depth, ResourceState::ShaderResource );
+	reads.write( fog, target, ResourceState::RenderTarget );
+
+	REQUIRE( reads.compile() );
+	REQUIRE( reads.getStats().discardBarriers == 1 );
+	REQUIRE( reads.getStats().transitionBarriers == 1 );
+	const auto opaqueBarriers = reads.getBarriers( opaque );
+	REQUIRE( opaqueBarriers.size() == 1 );
+	REQUIRE( opaqueBarriers[0].after == ( ResourceState::DepthRead | ResourceState::ShaderResource ) );
+	REQUIRE( reads.getBarriers( fog ).empty() );
+}
+
+TEST_CASE( "Frame graph aliases transients with disjoint lifetimes", "[frame_graph][unit]" )
+{
+	// Post chain: each pass reads the previous intermediate and writes the next one
+	constexpr std::uint64_t kSize = 8 * 1024 * 1024;
+	FrameGraph graph;
+	const auto color = graph.importResource( "Color", ResourceState::RenderTarget );
+	const ResourceHandle intermediates[3] = { graph.createTransient( "A", makeDesc( kSize ) ),
+		graph.createTransient( "B", makeDesc( kSize ) ),
+		graph.createTransient( "C", makeDesc( kSize ) ) };
+
+	graph.write( graph.addPass( "Produce A", {} ), intermediates[0], ResourceState::RenderTarget );
+	for ( int i = 1; i < 3; ++i )
+	{
+		const auto pass = graph.addPass( "Step", {} );
+		graph.read( pass, intermediates[i - 1], ResourceState::ShaderResource );
+		graph.write( pass, intermediates[i], ResourceState::RenderTarget );
+	}
+	const auto resolve = graph.addPass( "Resolve", {} );
+	graph.read( resolve, intermediates[2], ResourceState::ShaderResource );
+	graph.write( resolve, color, ResourceState::RenderTarget );
+
+	REQUIRE( graph.compile() );
+	const auto &stats = graph.getStats();
+	REQUIRE( stats.allocatedTransients == 3 );
+	REQUIRE( stats.transientBytes == 3 * kSize );
+	REQUIRE( stats.heapBytes == 2 * kSize );
+	REQUIRE( stats.aliasingSavedBytes() == kSize );
+
+	// A and C never live at the same time and share memory; B overlaps both
+	REQUIRE( graph.getHeapOffset( intermediates[0] ) == graph.getHeapOffset( intermediates[2] ) );
+	REQUIRE( graph.getHeapOffset( intermediates[1] ) != graph.getHeapOffset( intermediates[0] ) );
+	REQUIRE( stats.aliasingBarriers == 1 );
+	const auto stepC = graph.getExecutionOrder()[2];
+	const auto barriers = graph.getBarriers( stepC );
+	REQUIRE( barriers[0].type == Barrier::Type::Aliasing );
+	REQUIRE( barriers[0].resource == intermediates[2] );
+	REQUIRE( barriers[0].aliasedFrom == intermediates[0] );
+}
+
+TEST_CASE( "Frame graph placement respects alignment", "[frame_graph][unit]" )
+{
+	FrameGraph graph;
+	const auto color = graph.importResource( "Color", ResourceState::RenderTarget );
+	TextureDesc small = makeDesc( 1000 );
+	small.alignment = 4096;
+	const auto first = graph.createTransient( "First", small );
+	const auto second = graph.createTransient( "Second", small );
+
+	const auto pass = graph.addPass( "Both", {} );
+	graph.read( pass, first, ResourceState::ShaderResource );
+	graph.read( pass, second, ResourceState::ShaderResource );
+	graph.write( pass, color, ResourceState::RenderTarget );
+
+	REQUIRE( graph.compile() );
+	REQUIRE( graph.getHeapOffset( first ) == 0 );
+	REQUIRE( graph.getHeapOffset( second ) == 4096 );
+	REQUIRE( graph.getStats().heapBytes == 4096 + 1000 );
+}
+
+TEST_CASE( "Frame graph rejects invalid declarations", "[frame_graph][unit]" )
+{
+	SECTION( "Dependency cycle" )
+	{
+		FrameGraph graph;
+		const auto a = graph.createTransient( "A", makeDesc( 64 ) );
+		const auto b = graph.createTransient( "B", makeDesc( 64 ) );
+		const auto first = graph.addPass( "First", {} );
+		graph.read( first, a, ResourceState::ShaderResource );
+		graph.write( first, b, ResourceState::RenderTarget );
+		const auto second = graph.addPass( "Second", {} );
+		graph.read( second, b, ResourceState::ShaderResource );
+		graph.write( second, a, ResourceState::RenderTarget );
+		graph.setSideEffects( second );
+
+		REQUIRE_FALSE( graph.compile() );
+		REQUIRE( graph.getError().find( "cycle" ) != std::string::npos );
+		MockBackend backend;
+		REQUIRE_FALSE( graph.execute( backend ) );
+	}
+
+	SECTION( "Read and write of one resource in the same pass" )
+	{
+		FrameGraph graph;
+		const auto color = graph.importResource( "Color", ResourceState::RenderTarget );
+		const auto pass = graph.addPass( "Feedback", {} );
+		graph.read( pass, color, ResourceState::ShaderResource );
+		graph.write( pass, color, ResourceState::RenderTarget );
+		REQUIRE_FALSE( graph.compile() );
+		REQUIRE( graph.getError().find( "conflicting" ) != std::string::npos );
+	}
+
+	SECTION( "Write in a read-only state" )
+	{
+		FrameGraph graph;
+		const auto color = graph.importResource( "Color", ResourceState::RenderTarget );
+		graph.write( graph.addPass( "Bad", {} ), color, ResourceState::ShaderResource );
+		REQUIRE_FALSE( graph.compile() );
+	}
+
+	SECTION( "Transient without a size" )
+	{
+		FrameGraph graph;
+		const auto target = graph.createTransient( "Unsized", TextureDesc{} );
+		const auto pass = graph.addPass( "Pass", {} );
+		graph.write( pass, target, ResourceState::RenderTarget );
+		graph.setSideEffects( pass );
+		REQUIRE_FALSE( graph.compile() );
+		REQUIRE( graph.getError().find( "Unsized" ) != std::string::npos );
+	}
+
+	SECTION( "Reset clears the error" )
+	{
+		FrameGraph graph;
+		graph.read( 0, 0, ResourceState::ShaderResource );
+		REQUIRE_FALSE( graph.compile() );
+		graph.reset();
+		REQUIRE( graph.compile() );
+		REQUIRE( graph.getError().empty() );
+	}
+}
+
+TEST_CASE( "Frame graph executes passes in order with their barriers", "[frame_graph][unit]" )
+{
+	FrameGraph graph;
+	MockBackend backend;
+	const auto color = graph.importResource( "Color", ResourceState::ShaderResource, ResourceState::ShaderResource );
+	const auto scratch = graph.createTransient( "Scratch", makeDesc( 2048 ) );
+
+	const auto draw = graph.addPass( "Draw", [&backend] { backend.log.push_back( "Draw" ); } );
+	graph.read( draw, scratch, ResourceState::ShaderResource );
+	graph.write( draw, color, ResourceState::RenderTarget );
+	const auto produce = graph.addPass( "Produce", [&backend] { backend.log.push_back( "Produce" ); } );
+	graph.write( produce, scratch, ResourceState::RenderTarget );
+
+	// Not compiled yet
+	REQUIRE_FALSE( graph.execute( backend ) );
+	REQUIRE( backend.log.empty() );
+
+	REQUIRE( graph.compile() );
+	REQUIRE( graph.execute( backend ) );
+	REQUIRE( backend.log == std::vector<std::string>{ "allocate", "barriers 1", "Produce", "barriers 2", "Draw", "barriers 1" } );
+	REQUIRE( backend.heapBytes == 2048 );
+	REQUIRE( backend.barriers.size() == 4 );
+
+	// Redeclaring invalidates the compiled frame
+	graph.addPass( "Late", {} );
+	REQUIRE_FALSE( graph.isCompiled() );
+
+	backend.log.clear();
+	backend.failAllocation = true;
+	REQUIRE( graph.compile() );
+	REQUIRE_FALSE( graph.execute( backend ) );
+	REQUIRE( backend.log == std::vector<std::string>{ "allocate" } );
+}
+
+TEST_CASE( "Frame graph: per-viewport post chains share transient memory", "[frame_graph][performance]" )
+{
+	// Four viewports, each with an outline mask, an outline and a three-step post chain at 1080p RGBA8
+	constexpr std::uint64_t kTarget = 1920ull * 1080ull * 4ull;
+	constexpr std::uint64_t kAlignedTarget = ( kTarget + engine::frame_graph::kDefaultPlacementAlignment - 1 ) / engine::frame_graph::kDefaultPlacementAlignment * engine::frame_graph::kDefaultPlacementAlignment;
+	constexpr int kViewports = 4;
+	constexpr int kFrames = 200;
+
+	FrameGraph graph;
+	const auto start = std::chrono::high_resolution_clock::now();
+	for ( int frame = 0; frame < kFrames; ++frame )
+	{
+		graph.reset();
+		for ( int viewport = 0; viewport < kViewports; ++viewport )
+		{
+			const auto color = graph.importResource( "Viewport Color", ResourceState::ShaderResource, ResourceState::ShaderResource );
+			const auto sceneColor = graph.createTransient( "Scene Color", makeDesc( kTarget ) );
+			const auto mask = graph.createTransient( "Outline Mask", makeDesc( kTarget ) );
+			const auto post = { graph.createTransient( "Post A", makeDesc( kTarget ) ), graph.createTransient( "Post B", makeDesc( kTarget ) ) };
+
+			graph.write( graph.addPass( "Scene", {} ), sceneColor, ResourceState::RenderTarget );
+			graph.write( graph.addPass( "Outline Mask", {} ), mask, ResourceState::RenderTarget );
+			const auto outline = graph.addPass( "Outline", {} );
+			graph.read( outline, mask, ResourceState::ShaderResource );
+			graph.write( outline, sceneColor, ResourceState::RenderTarget );
+
+			ResourceHandle input = sceneColor;
+			for ( const auto output : post )
+			{
+				const auto step = graph.addPass( "Post", {} );
+				graph.read( step, input, ResourceState::ShaderResource );
+				graph.write( step, output, ResourceState::RenderTarget );
+				input = output;
+			}
+			const auto composite = graph.addPass( "Composite", {} );
+			graph.read( composite, input, ResourceState::ShaderResource );
+			graph.write( composite, color, ResourceState::RenderTarget );
+		}
+		REQUIRE( graph.compile() );
+	}
+	const double elapsedMs = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+
+	const auto &stats = graph.getStats();
+	INFO( kViewports << " viewports: " << stats.transientBytes / ( 1024 * 1024 ) << " MB of transients in a " << stats.heapBytes / ( 1024 * 1024 ) << " MB heap, "
+		<< stats.transitionBarriers << " transitions, " << stats.aliasingBarriers << " aliasing barriers, " << elapsedMs / kFrames << " ms per compile" );
+	REQUIRE( stats.allocatedTransients == 4 * kViewports );
+	// Viewports run one after another, so all of them fit in the memory of two targets
+	REQUIRE( stats.heapBytes == kAlignedTarget + kTarget );
+	REQUIRE( stats.transientBytes == 4 * kViewports * kTarget );
+	// Generous budget (debug builds included)
+	REQUIRE( elapsedMs / kFrames < 5.0 );
+}
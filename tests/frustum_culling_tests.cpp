@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "engine/culling/frustum_culling.h"
+#include "math/matrix.h"
+#include "math/math.h"
+
+using Catch::Approx;
+
+namespace
+{
+// Camera at origin looking down +Y with Z up, matching the editor's coordinate system
+math::Frustum<float> makeTestFrustum()
+{
+	const auto view = math::Mat4f::lookAt( { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } );
+	const auto projection = math::Mat4f::perspective( math::radians( 60.0f ), 1.0f, 0.1f, 100.0f );
+	return math::Frustum<float>::fromViewProjection( projection * view );
+}
+
+math::BoundingBox3Df boxAt( const math::Vec3f &center, float halfExtent )
+{
+	const math::Vec3f extent{ halfExtent, halfExtent, halfExtent };
+	return math::BoundingBox3Df( center - extent, center + extent );
+}
+} // namespace
+
+TEST_CASE( "transformBounds translates and scales a local AABB", "[culling][unit]" )
+{
+	const math::BoundingBox3Df local( -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f );
+	const auto world = math::Mat4f::translation( 10.0f, 0.0f, 5.0f ) * math::Mat4f::scale( 2.0f, 1.0f, 3.0f );
+
+	const auto result = engine::culling::transformBounds( local, world );
+
+	REQUIRE( result.min.x == Approx( 8.0f ) );
+	REQUIRE( result.max.x == Approx( 12.0f ) );
+	REQUIRE( result.min.y == Approx( -1.0f ) );
+	REQUIRE( result.max.y == Approx( 1.0f ) );
+	REQUIRE( result.min.z == Approx( 2.0f ) );
+	REQUIRE( result.max.z == Approx( 8.0f ) );
+}
+
+TEST_CASE( "transformBounds encloses all corners of a rotated box", "[culling][unit]" )
+{
+	const math::BoundingBox3Df local( -1.0f, -2.0f, -0.5f, 1.0f, 2.0f, 0.5f );
+	const auto world = math::Mat4f::translation( 1.0f, 2.0f, 3.0f ) * math::Mat4f::rotationZ( math::radians( 30.0f ) );
+
+	auto result = engine::culling::transformBounds( local, world );
+	// Corners lie exactly on the result's faces, allow for rounding
+	result.expand( result.max + math::Vec3f{ 1e-4f, 1e-4f, 1e-4f } );
+	result.expand( result.min - math::Vec3f{ 1e-4f, 1e-4f, 1e-4f } );
+
+	for ( int i = 0; i < 8; ++i )
+	{
+		const auto corner = world.transformPoint( local.corner( i ) );
+		CHECK( result.contains( corner ) );
+	}
+	// Rotating by 90 degrees should swap the X and Y extents exactly
+	const auto swapped = engine::culling::transformBounds( local, math::Mat4f::rotationZ( math::radians( 90.0f ) ) );
+	REQUIRE( swapped.max.x == Approx( 2.0f ) );
+	REQUIRE( swapped.max.y == Approx( 1.0f ) );
+}
+
+TEST_CASE( "transformBounds leaves invalid bounds untouched", "[culling][unit]" )
+{
+	const math::BoundingBox3Df empty;
+	const auto result = engine::culling::transformBounds( empty, math::Mat4f::translation( 1.0f, 2.0f, 3.0f ) );
+	REQUIRE_FALSE( result.isValid() );
+}
+
+TEST_CASE( "BoundsSoA stores boxes as component streams", "[culling][unit]" )
+{
+	engine::culling::BoundsSoA bounds;
+	REQUIRE( bounds.empty() );
+
+	const auto first = bounds.add( math::BoundingBox3Df( 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f ) );
+	const auto second = bounds.add( math::BoundingBox3Df( -1.0f, -2.0f, -3.0f, 0.0f, 0.0f, 0.0f ) );
+
+	REQUIRE( first == 0 );
+	REQUIRE( second == 1 );
+	REQUIRE( bounds.size() == 2 );
+	REQUIRE( bounds.minY()[0] == 2.0f );
+	REQUIRE( bounds.maxZ()[1] == 0.0f );
+
+	const auto roundTrip = bounds.get( 0 );
+	REQUIRE( roundTrip.min.x == 1.0f );
+	REQUIRE( roundTrip.max.z == 6.0f );
+
+	bounds.clear();
+	REQUIRE( bounds.empty() );
+}
+
+TEST_CASE( "cullBounds keeps boxes inside the frustum and rejects boxes outside", "[culling][unit]" )
+{
+	const auto frustum = makeTestFrustum();
+
+	engine::culling::BoundsSoA bounds;
+	bounds.add( boxAt( { 0.0f, 10.0f, 0.0f }, 1.0f ) );	 // 0: straight ahead
+	bounds.add( boxAt( { 0.0f, -10.0f, 0.0f }, 1.0f ) ); // 1: behind the camera
+	bounds.add( boxAt( { 50.0f, 10.0f, 0.0f }, 1.0f ) ); // 2: far to the right
+	bounds.add( boxAt( { 0.0f, 200.0f, 0.0f }, 1.0f ) ); // 3: beyond the far plane
+	bounds.add( boxAt( { 6.0f, 10.0f, 0.0f }, 1.0f ) );	 // 4: straddling the right plane
+	bounds.add( engine::culling::infiniteBounds() );	 // 5: unbounded, never culled
+
+	std::vector<std::uint32_t> visible;
+	const auto stats = engine::culling::cullBounds( frustum, bounds, visible );
+
+	REQUIRE( stats.tested == 6 );
+	REQUIRE( stats.visible == 3 );
+	REQUIRE( stats.culled() == 3 );
+	REQUIRE( visible == std::vector<std::uint32_t>{ 0, 4, 5 } );
+}
+
+TEST_CASE( "cullBounds handles empty input", "[culling][unit]" )
+{
+	engine::culling::BoundsSoA bounds;
+	std::vector<std::uint32_t> visible{ 42 };
+
+	const auto stats = engine::culling::cullBounds( makeTestFrustum(), bounds, visible );
+
+	REQUIRE( stats.tested == 0 );
+	REQUIRE( visible.empty() );
+}
+
+TEST_CASE( "cullBounds SIMD path matches the scalar reference", "[culling][unit]" )
+{
+	const auto frustum = makeTestFrustum();
+
+	// Odd count to exercise both full 8-wide batches and the scalar tail
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution<float> position( -150.0f, 150.0f );
+	std::uniform_real_distribution<float> extent( 0.1f, 5.0f );
+
+	engine::culling::BoundsSoA bounds;
+	for ( int i = 0; i < 1003; ++i )
+	{
+		bounds.add( boxAt( { position( rng ), position( rng ), position( rng ) }, extent( rng ) ) );
+	}
+
+	std::vector<std::uint32_t> simdVisible;
+	std::vector<std::uint32_t> scalarVisible;
+	const auto simdStats = engine::culling::cullBounds( frustum, bounds, simdVisible );
+	const auto scalarStats = engine::culling::cullBoundsScalar( frustum, bounds, scalarVisible );
+
+	REQUIRE( simdStats.visible == scalarStats.visible );
+	REQUIRE( simdVisible == scalarVisible );
+
+	// Cross-check against the generic frustum test
+	for ( std::uint32_t i = 0; i < bounds.size(); ++i )
+	{
+		const bool expected = frustum.intersects( bounds.get( i ) );
+		const bool actual = std::find( simdVisible.begin(), simdVisible.end(), i ) != simdVisible.end();
+		CHECK( expected == actual );
+	}
+}
+
+TEST_CASE( "cullBounds processes 100k boxes quickly", "[culling][performance]" )
+{
+	const auto frustum = makeTestFrustum();
+
+	std::mt19937 rng( 42 );
+	std::uniform_real_distribution<float> position( -500.0f, 500.0f );
+
+	constexpr int kBoxCount = 100000;
+	engine::culling::BoundsSoA bounds;
+	bounds.reserve( kBoxCount );
+	for ( int i = 0; i < kBoxCount; ++i )
+	{
+		bounds.add( boxAt( { position( rng ), position( rng ), position( rng ) }, 1.0f ) );
+	}
+
+	std::vector<std::uint32_t> visible;
+	visible.reserve( kBoxCount );
+
+	constexpr int kIterations = 10;
+	const auto start = std::chrono::high_resolution_clock::now();
+	std::uint32_t totalVisible = 0;
+	for ( int i = 0; i < kIterations; ++i )
+	{
+		totalVisible += engine::culling::cullBounds( frustum, bounds, visible ).visible;
+	}
+	const auto end = std::chrono::high_resolution_clock::now();
+	const auto averageMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count() / kIterations;
+
+	// Most boxes are off-screen, mirroring a typical level
+	REQUIRE( totalVisible > 0 );
+	REQUIRE( totalVisible < kBoxCount * kIterations / 2 );
+	// Generous budget (debug builds included): 100k boxes in under 20ms
+	REQUIRE( averageMicroseconds < 20000 );
+}
@@ -0,0 +1,438 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "engine/geometry_pool/geometry_pool.h"
+#include "engine/geometry_pool/range_allocator.h"
+#include "engine/render_backend/recording_command_recorder.h"
+#include "engine/render_queue/draw_submission.h"
+
+using engine::geometry_pool::GeometryHandle;
+using engine::geometry_pool::GeometryPool;
+using engine::geometry_pool::RangeAllocator;
+using engine::render_backend::CpuUploadBackend;
+
+namespace
+{
+struct TestVertex
+{
+	float position[3];
+	std::uint32_t id;
+};
+
+std::vector<TestVertex> makeVertices( std::uint32_t count, std::uint32_t id )
+{
+	std::vector<TestVertex> vertices( count );
+	for ( std::uint32_t i = 0; i < count; ++i )
+	{
+		vertices[i] = TestVertex{ { static_cast<float>( i ), 0.0f, 0.0f }, id };
+	}
+	return vertices;
+}
+
+// Every vertex of the handle's range still carries its id and every index is in range
+bool contentsIntact( const GeometryPool &pool, GeometryHandle handle, std::uint32_t id )
+{
+	const auto range = pool.getRange( handle );
+	const auto *vertices = reinterpret_cast<const TestVertex *>( pool.getVertexBuffer().cpuAddress ) + range.baseVertex;
+	const auto *indices = reinterpret_cast<const std::uint32_t *>( pool.getIndexBuffer().cpuAddress ) + range.firstIndex;
+	for ( std::uint32_t i = 0; i < range.vertexCount; ++i )
+	{
+		if ( vertices[i].id != id || vertices[i].position[0] != static_cast<float>( i ) )
+		{
+			return false;
+		}
+	}
+	for ( std::uint32_t i = 0; i < range.indexCount; ++i )
+	{
+		if ( indices[i] != i % range.vertexCount )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+GeometryHandle addPrimitive( GeometryPool &pool, std::uint32_t vertexCount, std::uint32_t indexCount, std::uint32_t id )
+{
+	const auto vertices = makeVertices( vertexCount, id );
+	std::vector<std::uint32_t> indices( indexCount );
+	for ( std::uint32_t i = 0; i < indexCount; ++i )
+	{
+		indices[i] = i % vertexCount;
+	}
+	return pool.allocate( vertices.data(), vertexCount, indices );
+}
+} // namespace
+
+TEST_CASE( "Range allocator splits, reuses and coalesces free blocks", "[geometry_pool][unit]" )
+{
+	RangeAllocator allocator( 1000 );
+	REQUIRE( allocator.getFreeBlockCount() == 1 );
+	REQUIRE( allocator.getLargestFreeBlock() == 1000 );
+
+	const auto a = allocator.allocate( 100 );
+	const auto b = allocator.allocate( 200 );
+	const auto c = allocator.allocate( 300 );
+	REQUIRE( a.offset == 0 );
+	REQUIRE( b.offset == 100 );
+	REQUIRE( c.offset == 300 );
+	REQUIRE( allocator.getUsedUnits() == 600 );
+	REQUIRE( allocator.getAllocationCount() == 3 );
+	REQUIRE_FALSE( allocator.allocate( 0 ).isValid() );
+	REQUIRE_FALSE( allocator.allocate( 401 ).isValid() );
+
+	// A hole in the middle: two free blocks, fragmentation reflects the smaller piece
+	allocator.free( b.node );
+	REQUIRE( allocator.getFreeBlockCount() == 2 );
+	REQUIRE( allocator.getLargestFreeBlock() == 400 );
+	REQUIRE( allocator.getFragmentation() > 0.3f );
+
+	// The hole is reused for a request that fits it
+	const auto d = allocator.allocate( 150 );
+	REQUIRE( d.offset == 100 );
+	allocator.free( d.node );
+
+	// Freeing the neighbours merges everything back into one block
+	allocator.free( a.node );
+	allocator.free( c.node );
+	allocator.free( c.node ); // Double free is ignored
+	REQUIRE( allocator.getFreeBlockCount() == 1 );
+	REQUIRE( allocator.getLargestFreeBlock() == 1000 );
+	REQUIRE( allocator.getFragmentation() == 0.0f );
+	REQUIRE( allocator.getAllocationCount() == 0 );
+
+	// Growth extends the trailing free block, or appends one after a used tail
+	const auto full = allocator.allocate( 1000 );
+	REQUIRE( full.isValid() );
+	allocator.grow( 1500 );
+	REQUIRE( allocator.allocate( 500 ).offset == 1000 );
+	REQUIRE( allocator.getOffset( full.node ) == 0 );
+}
+
+TEST_CASE( "Range allocator compaction reports relocations and leaves one free block", "[geometry_pool][unit]" )
+{
+	RangeAllocator allocator( 100 );
+	std::vector<RangeAllocator::Allocation> allocations;
+	for ( int i = 0; i < 10; ++i )
+	{
+		allocations.push_back( allocator.allocate( 10 ) );
+	}
+	for ( int i = 0; i < 10; i += 2 )
+	{
+		allocator.free( allocations[i].node );
+	}
+	REQUIRE( allocator.getFreeBlockCount() == 5 );
+
+	const auto relocations = allocator.compact();
+	REQUIRE( relocations.size() == 5 );
+	for ( std::size_t i = 0; i < relocations.size(); ++i )
+	{
+		REQUIRE( relocations[i].node == allocations[i * 2 + 1].node );
+		REQUIRE( relocations[i].oldOffset == allocations[i * 2 + 1].offset );
+		REQUIRE( relocations[i].newOffset == i * 10 );
+		REQUIRE( relocations[i].newOffset <= relocations[i].oldOffset );
+	}
+	REQUIRE( allocator.getFreeBlockCount() == 1 );
+	REQUIRE( allocator.getLargestFreeBlock() == 50 );
+	REQUIRE( allocator.getAllocationCount() == 5 );
+	REQUIRE( allocator.allocate( 50 ).offset == 50 );
+
+	// Handles survive compaction and can still be freed
+	allocator.free( allocations[1].node );
+	REQUIRE( allocator.getUsedUnits() == 90 );
+}
+
+TEST_CASE( "Randomised range allocations never overlap and free back to one block", "[geometry_pool][unit]" )
+{
+	constexpr std::uint32_t kCapacity = 1u << 20;
+	RangeAllocator allocator( kCapacity );
+
+	std::mt19937 rng( 1234 );
+	std::uniform_int_distribution<std::uint32_t> size( 1, 5000 );
+	std::vector<RangeAllocator::Allocation> live;
+	std::uint64_t liveUnits = 0;
+
+	for ( int step = 0; step < 20000; ++step )
+	{
+		const bool doFree = !live.empty() && ( rng() % 3 == 0 || allocator.getFreeUnits() < 5000 );
+		if ( doFree )
+		{
+			const std::size_t pick = rng() % live.size();
+			allocator.free( live[pick].node );
+			liveUnits -= live[pick].size;
+			live[pick] = live.back();
+			live.pop_back();
+		}
+		else
+		{
+			const auto allocation = allocator.allocate( size( rng ) );
+			if ( allocation.isValid() )
+			{
+				REQUIRE( allocation.offset + allocation.size <= kCapacity );
+				live.push_back( allocation );
+				liveUnits += allocation.size;
+			}
+		}
+		REQUIRE( allocator.getUsedUnits() == liveUnits );
+
+		if ( step % 4000 == 3999 )
+		{
+			auto sorted = live;
+			std::sort( sorted.begin(), sorted.end(), []( const auto &a, const auto &b ) { return a.offset < b.offset; } );
+			for ( std::size_t i = 1; i < sorted.size(); ++i )
+			{
+				REQUIRE( sorted[i - 1].offset + sorted[i - 1].size <= sorted[i].offset );
+			}
+		}
+	}
+
+	for ( const auto &allocation : live )
+	{
+		allocator.free( allocation.node );
+	}
+	REQUIRE( allocator.getFreeBlockCount() == 1 );
+	REQUIRE( allocator.getLargestFreeBlock() == kCapacity );
+}
+
+TEST_CASE( "Geometry pool suballocates primitives from two shared buffers", "[geometry_pool][unit]" )
+{
+	auto backend = std::make_shared<CpuUploadBackend>();
+	GeometryPool pool( backend, sizeof( TestVertex ), 1024, 4096 );
+	REQUIRE( backend->getLiveBufferCount() == 2 );
+
+	const GeometryHandle a = addPrimitive( pool, 24, 36, 1 );
+	const GeometryHandle b = addPrimitive( pool, 3, 0, 2 ); // Non-indexed
+	const GeometryHandle c = addPrimitive( pool, 100, 300, 3 );
+	REQUIRE( pool.isValid( a ) );
+	REQUIRE( pool.isValid( b ) );
+	REQUIRE( pool.isValid( c ) );
+
+	const auto rangeA = pool.getRange( a );
+	const auto rangeB = pool.getRange( b );
+	const auto rangeC = pool.getRange( c );
+	REQUIRE( rangeA.baseVertex == 0 );
+	REQUIRE( rangeA.indexCount == 36 );
+	REQUIRE( rangeB.baseVertex == 24 );
+	REQUIRE( rangeB.indexCount == 0 );
+	REQUIRE( rangeC.baseVertex == 27 );
+	REQUIRE( rangeC.firstIndex == 36 );
+	REQUIRE( contentsIntact( pool, a, 1 ) );
+	REQUIRE( contentsIntact( pool, c, 3 ) );
+
+	// Still two resources, and the views cover the whole pool
+	REQUIRE( backend->getLiveBufferCount() == 2 );
+	REQUIRE( pool.getVertexBufferView().gpuAddress == pool.getVertexBuffer().gpuAddress );
+	REQUIRE( pool.getVertexBufferView().strideInBytes == sizeof( TestVertex ) );
+	REQUIRE( pool.getIndexBufferView().sizeInBytes == 4096 * sizeof( std::uint32_t ) );
+
+	const auto stats = pool.getStats();
+	REQUIRE( stats.allocations == 3 );
+	REQUIRE( stats.vertexBytesUsed == 127 * sizeof( TestVertex ) );
+	REQUIRE( stats.indexBytesUsed == 336 * sizeof( std::uint32_t ) );
+	REQUIRE( stats.growths == 0 );
+
+	// Empty vertex data is rejected
+	REQUIRE( pool.allocate( nullptr, 0, {} ) == engine::geometry_pool::kInvalidGeometry );
+	REQUIRE( pool.getStats().failures == 1 );
+}
+
+TEST_CASE( "Freed geometry is reused only after its fence completes", "[geometry_pool][unit]" )
+{
+	auto backend = std::make_shared<CpuUploadBackend>();
+	GeometryPool pool( backend, sizeof( TestVertex ), 200, 600 );
+
+	const GeometryHandle a = addPrimitive( pool, 100, 300, 1 );
+	addPrimitive( pool, 100, 300, 2 );
+	pool.free( a );
+	REQUIRE_FALSE( pool.isValid( a ) );
+	REQUIRE( pool.getStats().pendingFrees == 1 );
+
+	// The GPU may still read frame 5: the full pool grows rather than reusing the range
+	pool.endFrame( 5 );
+	const GeometryHandle c = addPrimitive( pool, 100, 300, 3 );
+	REQUIRE( pool.getRange( c ).baseVertex == 200 );
+	REQUIRE( pool.getStats().growths == 2 );
+	REQUIRE( pool.getStats().pendingFrees == 1 );
+
+	backend->completeFenceValue( 5 );
+	pool.endFrame( 6 );
+	REQUIRE( pool.getStats().pendingFrees == 0 );
+	const GeometryHandle d = addPrimitive( pool, 100, 300, 4 );
+	REQUIRE( pool.getRange( d ).baseVertex == 0 );
+	REQUIRE( pool.getRange( d ).firstIndex == 0 );
+	REQUIRE( contentsIntact( pool, d, 4 ) );
+	REQUIRE( contentsIntact( pool, c, 3 ) );
+}
+
+TEST_CASE( "Geometry pool growth keeps offsets and retires the old buffer after its fence", "[geometry_pool][unit]" )
+{
+	auto backend = std::make_shared<CpuUploadBackend>();
+	GeometryPool pool( backend, sizeof( TestVertex ), 64, 128 );
+
+	const GeometryHandle a = addPrimitive( pool, 40, 120, 1 );
+	const auto before = pool.getRange( a );
+	const GeometryHandle b = addPrimitive( pool, 40, 120, 2 );
+	REQUIRE( pool.isValid( b ) );
+	REQUIRE( pool.getStats().growths == 2 );
+	REQUIRE( pool.getVertexBuffer().size == 128 * sizeof( TestVertex ) );
+
+	// Offsets are stable across growth and the data was carried over
+	REQUIRE( pool.getRange( a ).baseVertex == before.baseVertex );
+	REQUIRE( pool.getRange( a ).firstIndex == before.firstIndex );
+	REQUIRE( contentsIntact( pool, a, 1 ) );
+	REQUIRE( contentsIntact( pool, b, 2 ) );
+
+	// Old buffers stay alive for frames recorded against them
+	REQUIRE( backend->getLiveBufferCount() == 4 );
+	pool.endFrame( 3 );
+	REQUIRE( backend->getLiveBufferCount() == 4 );
+	backend->completeFenceValue( 3 );
+	pool.endFrame( 4 );
+	REQUIRE( backend->getLiveBufferCount() == 2 );
+}
+
+TEST_CASE( "Defragmentation packs live primitives and preserves their data", "[geometry_pool][unit]" )
+{
+	auto backend = std::make_shared<CpuUploadBackend>();
+	GeometryPool pool( backend, sizeof( TestVertex ), 32 * 64, 32 * 192 );
+
+	std::vector<GeometryHandle> handles;
+	for ( std::uint32_t i = 0; i < 32; ++i )
+	{
+		handles.push_back( addPrimitive( pool, 64, 192, i ) );
+	}
+	for ( std::uint32_t i = 0; i < 32; i += 2 )
+	{
+		pool.free( handles[i] );
+	}
+	backend->completeFenceValue( 1 );
+	pool.endFrame( 1 );
+	REQUIRE( pool.shouldDefragment() );
+
+	const auto oldVertexBuffer = pool.getVertexBuffer().handle;
+	const std::uint64_t moved = pool.defragment();
+	REQUIRE( moved == 16 * ( 64 * sizeof( TestVertex ) + 192 * sizeof( std::uint32_t ) ) );
+	REQUIRE( pool.getVertexBuffer().handle != oldVertexBuffer );
+	REQUIRE_FALSE( pool.shouldDefragment() );
+
+	const auto stats = pool.getStats();
+	REQUIRE( stats.defragmentations == 1 );
+	REQUIRE( stats.vertexFragmentation == 0.0f );
+	REQUIRE( stats.indexFragmentation == 0.0f );
+	for ( std::uint32_t i = 1; i < 32; i += 2 )
+	{
+		REQUIRE( pool.getRange( handles[i] ).baseVertex == static_cast<std::int32_t>( ( i / 2 ) * 64 ) );
+		REQUIRE( contentsIntact( pool, handles[i], i ) );
+	}
+
+	// Nothing to do on an already packed pool
+	REQUIRE( pool.defragment() == 0 );
+}
+
+TEST_CASE( "Pooled geometry binds buffers once and draws with base vertex offsets", "[geometry_pool][unit]" )
+{
+	auto backend = std::make_shared<CpuUploadBackend>();
+	GeometryPool pool( backend, sizeof( TestVertex ), 1024, 4096 );
+
+	static const int pipeline = 0;
+	engine::DrawStateTables tables;
+	tables.pipelines = { &pipeline };
+	tables.materialConstants = { 0 };
+	for ( std::uint32_t i = 0; i < 3; ++i )
+	{
+		const auto range = pool.getRange( addPrimitive( pool, 8 + i, 12, i ) );
+		engine::GeometryBinding geometry;
+		geometry.vertexBuffer = pool.getVertexBufferView();
+		geometry.indexBuffer = pool.getIndexBufferView();
+		geometry.vertexCount = range.vertexCount;
+		geometry.indexCount = range.indexCount;
+		geometry.firstIndex = range.firstIndex;
+		geometry.baseVertex = range.baseVertex;
+		tables.geometries.push_back( geometry );
+	}
+
+	engine::RenderQueue queue;
+	for ( std::uint32_t i = 0; i < 3; ++i )
+	{
+		queue.push( engine::RenderPass::Opaque, { 0, 0, i, i }, 1.0f );
+	}
+	queue.sort();
+
+	const std::vector<math::Mat4f> worldMatrices( 3, math::Mat4f::identity() );
+	engine::render_backend::RecordingCommandRecorder recorder( true );
+	engine::submitRenderQueue( queue, tables, worldMatrices, recorder );
+
+	REQUIRE( recorder.getStats().drawCalls == 3 );
+	REQUIRE( recorder.getStats().vertexBufferBinds == 1 );
+	REQUIRE( recorder.getStats().indexBufferBinds == 1 );
+
+	std::vector<std::uint32_t> baseVertices;
+	for ( const auto &command : recorder.getCapture() )
+	{
+		if ( command.type == engine::render_backend::CommandType::DrawIndexed )
+		{
+			baseVertices.push_back( command.args[3] );
+		}
+	}
+	REQUIRE( baseVertices == std::vector<std::uint32_t>{ 0, 8, 17 } );
+}
+
+TEST_CASE( "Geometry pool fragmentation under import and unload churn", "[geometry_pool][performance]" )
+{
+	constexpr std::uint32_t kPrimitives = 20000;
+
+	auto backend = std::make_shared<CpuUploadBackend>();
+	GeometryPool pool( backend, sizeof( TestVertex ), 1u << 20, 1u << 22 );
+
+	std::mt19937 rng( 7 );
+	std::uniform_int_distribution<std::uint32_t> vertexCount( 4, 200 );
+	std::vector<TestVertex> vertices( 200 );
+	std::vector<std::uint32_t> indices( 600 );
+
+	// Import, then repeatedly unload a random third and import replacements of different sizes
+	std::vector<GeometryHandle> handles;
+	handles.reserve( kPrimitives );
+	const auto start = std::chrono::high_resolution_clock::now();
+	for ( std::uint32_t i = 0; i < kPrimitives; ++i )
+	{
+		const std::uint32_t count = vertexCount( rng );
+		handles.push_back( pool.allocate( vertices.data(), count, std::span( indices.data(), count * 3 ) ) );
+	}
+	std::uint64_t fence = 1;
+	for ( int round = 0; round < 5; ++round )
+	{
+		for ( std::uint32_t i = 0; i < kPrimitives / 3; ++i )
+		{
+			const std::size_t pick = rng() % handles.size();
+			pool.free( handles[pick] );
+			const std::uint32_t count = vertexCount( rng );
+			handles[pick] = pool.allocate( vertices.data(), count, std::span( indices.data(), count * 3 ) );
+		}
+		backend->completeFenceValue( fence );
+		pool.endFrame( fence++ );
+	}
+	const double churnMs = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+
+	const auto fragmented = pool.getStats();
+	const auto defragStart = std::chrono::high_resolution_clock::now();
+	const std::uint64_t moved = pool.defragment();
+	const double defragMs = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - defragStart ).count();
+	const auto packed = pool.getStats();
+
+	INFO( kPrimitives << " primitives, " << ( kPrimitives + 5 * ( kPrimitives / 3 ) ) << " allocations + " << 5 * ( kPrimitives / 3 ) << " frees: " << churnMs << " ms" );
+	INFO( "Vertex fragmentation " << fragmented.vertexFragmentation << " -> " << packed.vertexFragmentation << ", index " << fragmented.indexFragmentation << " -> " << packed.indexFragmentation );
+	INFO( "Defragmentation moved " << moved << " bytes in " << defragMs << " ms; growths " << packed.growths );
+	REQUIRE( packed.allocations == kPrimitives );
+	REQUIRE( packed.failures == 0 );
+	REQUIRE( packed.vertexFragmentation == 0.0f );
+	REQUIRE( packed.indexFragmentation == 0.0f );
+	// Two resources (plus buffers retired by growth/defrag until the next fence) instead of two per primitive
+	REQUIRE( backend->getLiveBufferCount() <= 4 );
+	REQUIRE( churnMs < 1000.0 );
+}
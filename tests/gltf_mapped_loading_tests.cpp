@@ -0,0 +1,265 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/gltf_loader/gltf_loader.h"
+#include "runtime/mapped_file.h"
+
+namespace
+{
+namespace fs = std::filesystem;
+
+// Synthetic city tile: a gridSize x gridSize vertex grid (positions, normals, 32-bit indices) followed by
+// imageCount embedded images of imageBytes each, the part of a tile the loader never decodes
+struct TileLayout
+{
+	std::uint32_t gridSize = 16;
+	std::uint32_t imageCount = 0;
+	std::uint32_t imageBytes = 0;
+};
+
+struct Tile
+{
+	std::string json;
+	std::vector<std::uint8_t> binary;
+};
+
+template <typename T>
+void append( std::vector<std::uint8_t> &out, const T &value )
+{
+	const auto *bytes = reinterpret_cast<const std::uint8_t *>( &value );
+	out.insert( out.end(), bytes, bytes + sizeof( T ) );
+}
+
+Tile makeTile( const TileLayout &layout, const std::string &bufferUri = {} )
+{
+	const std::uint32_t n = layout.gridSize;
+	const std::uint32_t vertexCount = n * n;
+	const std::uint32_t indexCount = ( n - 1 ) * ( n - 1 ) * 6;
+
+	Tile tile;
+	auto &bin = tile.binary;
+	for ( std::uint32_t y = 0; y < n; ++y )
+	{
+		for ( std::uint32_t x = 0; x < n; ++x )
+		{
+			append( bin, static_cast<float>( x ) );
+			append( bin, static_cast<float>( y ) );
+			append( bin, static_cast<float>( ( x * 7 + y * 3 ) % 5 ) * 0.25f );
+		}
+	}
+	for ( std::uint32_t i = 0; i < vertexCount; ++i )
+	{
+		append( bin, 0.0f );
+		append( bin, 0.0f );
+		append( bin, 1.0f );
+	}
+	for ( std::uint32_t y = 0; y + 1 < n; ++y )
+	{
+		for ( std::uint32_t x = 0; x + 1 < n; ++x )
+		{
+			const std::uint32_t i = y * n + x;
+			for ( const std::uint32_t index : { i, i + 1, i + n, i + 1, i + n + 1, i + n } )
+			{
+				append( bin, index );
+			}
+		}
+	}
+	const std::size_t geometryBytes = bin.size();
+	bin.resize( geometryBytes + std::size_t( layout.imageCount ) * layout.imageBytes, 0x5a );
+
+	const std::size_t positionBytes = std::size_t( vertexCount ) * 12;
+	std::string views = "{ \"buffer\": 0, \"byteOffset\": 0, \"byteLength\": " + std::to_string( positionBytes ) + " },"
+		+ "{ \"buffer\": 0, \"byteOffset\": " + std::to_string( positionBytes ) + ", \"byteLength\": " + std::to_string( positionBytes ) + " },"
+		+ "{ \"buffer\": 0, \"byteOffset\": " + std::to_string( positionBytes * 2 ) + ", \"byteLength\": " + std::to_string( std::size_t( indexCount ) * 4 ) + " }";
+	std::string images;
+	for ( std::uint32_t i = 0; i < layout.imageCount; ++i )
+	{
+		views += ", { \"buffer\": 0, \"byteOffset\": " + std::to_string( geometryBytes + std::size_t( i ) * layout.imageBytes ) + ", \"byteLength\": " + std::to_string( layout.imageBytes ) + " }";
+		images += std::string( i ? "," : "" ) + "{ \"bufferView\": " + std::to_string( 3 + i ) + ", \"mimeType\": \"image/png\" }";
+	}
+
+	const std::string buffer = bufferUri.empty()
+		? "{ \"byteLength\": " + std::to_string( bin.size() ) + " }"
+		: "{ \"byteLength\": " + std::to_string( bin.size() ) + ", \"uri\": \"" + bufferUri + "\" }";
+	tile.json = std::string( R"({ "asset": { "version": "2.0" }, "scene": 0, "scenes": [{ "nodes": [0] }],)" )
+		+ R"("nodes": [{ "mesh": 0, "name": "Tile" }],)"
+		+ R"("meshes": [{ "primitives": [{ "attributes": { "POSITION": 0, "NORMAL": 1 }, "indices": 2 }] }],)"
+		+ R"("accessors": [)"
+		+ "{ \"bufferView\": 0, \"componentType\": 5126, \"count\": " + std::to_string( vertexCount ) + ", \"type\": \"VEC3\", \"min\": [0, 0, 0], \"max\": [" + std::to_string( n - 1 ) + ", " + std::to_string( n - 1 ) + ", 1] },"
+		+ "{ \"bufferView\": 1, \"componentType\": 5126, \"count\": " + std::to_string( vertexCount ) + ", \"type\": \"VEC3\" },"
+		+ "{ \"bufferView\": 2, \"componentType\": 5125, \"count\": " + std::to_string( indexCount ) + ", \"type\": \"SCALAR\" }],"
+		+ "\"bufferViews\": [" + views + "],"
+		+ ( images.empty() ? "" : "\"images\": [" + images + "]," )
+		+ "\"buffers\": [" + buffer + "] }";
+	return tile;
+}
+
+void writeGlb( const fs::path &path, const Tile &tile )
+{
+	std::string json = tile.json;
+	json.resize( ( json.size() + 3 ) & ~std::size_t( 3 ), ' ' );
+	const std::size_t binLength = ( tile.binary.size() + 3 ) & ~std::size_t( 3 );
+	const auto totalLength = static_cast<std::uint32_t>( 12 + 8 + json.size() + 8 + binLength );
+
+	std::vector<std::uint8_t> header;
+	append( header, 0x46546C67u ); // "glTF"
+	append( header, 2u );
+	append( header, totalLength );
+	append( header, static_cast<std::uint32_t>( json.size() ) );
+	append( header, 0x4E4F534Au ); // "JSON"
+
+	std::ofstream file( path, std::ios::binary );
+	file.write( reinterpret_cast<const char *>( header.data() ), static_cast<std::streamsize>( header.size() ) );
+	file.write( json.data(), static_cast<std::streamsize>( json.size() ) );
+	std::vector<std::uint8_t> binHeader;
+	append( binHeader, static_cast<std::uint32_t>( binLength ) );
+	append( binHeader, 0x004E4942u ); // "BIN"
+	file.write( reinterpret_cast<const char *>( binHeader.data() ), static_cast<std::streamsize>( binHeader.size() ) );
+	file.write( reinterpret_cast<const char *>( tile.binary.data() ), static_cast<std::streamsize>( tile.binary.size() ) );
+	const char padding[3] = {};
+	file.write( padding, static_cast<std::streamsize>( binLength - tile.binary.size() ) );
+}
+
+void writeFile( const fs::path &path, const void *data, std::size_t size )
+{
+	std::ofstream file( path, std::ios::binary );
+	file.write( static_cast<const char *>( data ), static_cast<std::streamsize>( size ) );
+}
+
+const assets::Primitive &firstPrimitive( const assets::Scene &scene )
+{
+	const auto &node = scene.getRootNodes().at( 0 );
+	return scene.getMesh( node->getMeshHandle( 0 ) )->getPrimitive( 0 );
+}
+
+// Temporary directory removed at scope exit; removal also proves the loader unmapped its files
+struct TempDirectory
+{
+	fs::path path = fs::temp_directory_path() / "gltf_mapped_loading_tests";
+	TempDirectory() { fs::create_directories( path ); }
+	~TempDirectory()
+	{
+		std::error_code error;
+		fs::remove_all( path, error );
+	}
+};
+} // namespace
+
+TEST_CASE( "MappedFile exposes the file contents read-only", "[gltf][loader][mapped]" )
+{
+	TempDirectory directory;
+	const std::string text = "mapped file contents";
+	writeFile( directory.path / "text.bin", text.data(), text.size() );
+	writeFile( directory.path / "empty.bin", nullptr, 0 );
+
+	runtime::MappedFile file;
+	REQUIRE( file.open( ( directory.path / "text.bin" ).string() ) );
+	REQUIRE( file.isOpen() );
+	REQUIRE( file.size() == text.size() );
+	REQUIRE( std::memcmp( file.data(), text.data(), text.size() ) == 0 );
+
+	// Moving transfers the mapping
+	runtime::MappedFile moved( std::move( file ) );
+	REQUIRE_FALSE( file.isOpen() );
+	REQUIRE( moved.bytes().size() == text.size() );
+	moved.close();
+	REQUIRE_FALSE( moved.isOpen() );
+
+	REQUIRE_FALSE( file.open( ( directory.path / "missing.bin" ).string() ) );
+	REQUIRE_FALSE( file.open( ( directory.path / "empty.bin" ).string() ) );
+}
+
+TEST_CASE( "Mapped GLB loading decodes the same geometry as heap reads", "[gltf][loader][mapped]" )
+{
+	TempDirectory directory;
+	const fs::path path = directory.path / "tile.glb";
+	writeGlb( path, makeTile( { 16, 2, 4096 } ) );
+	const auto fileSize = fs::file_size( path );
+
+	gltf_loader::GLTFLoader loader;
+	loader.setLodGenerationEnabled( false );
+	REQUIRE( loader.isMemoryMappingEnabled() );
+
+	gltf_loader::LoadStats mappedStats;
+	const auto mapped = loader.loadScene( path.string(), &mappedStats );
+	loader.setMemoryMappingEnabled( false );
+	gltf_loader::LoadStats readStats;
+	const auto read = loader.loadScene( path.string(), &readStats );
+	REQUIRE( mapped );
+	REQUIRE( read );
+
+	const auto &mappedPrimitive = firstPrimitive( *mapped );
+	const auto &readPrimitive = firstPrimitive( *read );
+	REQUIRE( mappedPrimitive.getVertexCount() == 256 );
+	REQUIRE( mappedPrimitive.getIndices() == readPrimitive.getIndices() );
+	for ( std::uint32_t i = 0; i < mappedPrimitive.getVertexCount(); ++i )
+	{
+		REQUIRE( mappedPrimitive.getVertices()[i].position == readPrimitive.getVertices()[i].position );
+		REQUIRE( mappedPrimitive.getVertices()[i].normal == readPrimitive.getVertices()[i].normal );
+	}
+
+	// The whole file is mapped once and never copied to the parser's heap
+	REQUIRE( mappedStats.mappedFiles == 1 );
+	REQUIRE( mappedStats.mappedBytes == fileSize );
+	REQUIRE( mappedStats.parserPeakHeapBytes < fileSize );
+	REQUIRE( readStats.mappedFiles == 0 );
+	REQUIRE( readStats.parserPeakHeapBytes >= fileSize );
+}
+
+TEST_CASE( "Mapped glTF loading maps external buffers too", "[gltf][loader][mapped]" )
+{
+	TempDirectory directory;
+	const auto tile = makeTile( { 8, 0, 0 }, "tile.bin" );
+	writeFile( directory.path / "tile.gltf", tile.json.data(), tile.json.size() );
+	writeFile( directory.path / "tile.bin", tile.binary.data(), tile.binary.size() );
+
+	const gltf_loader::GLTFLoader loader;
+	gltf_loader::LoadStats stats;
+	const auto scene = loader.loadScene( ( directory.path / "tile.gltf" ).string(), &stats );
+	REQUIRE( scene );
+	REQUIRE( firstPrimitive( *scene ).getVertexCount() == 64 );
+	REQUIRE( stats.mappedFiles == 2 );
+	REQUIRE( stats.mappedBytes == tile.json.size() + tile.binary.size() );
+
+	// A buffer shorter than declared is rejected like the heap path does
+	writeFile( directory.path / "tile.bin", tile.binary.data(), tile.binary.size() / 2 );
+	const auto truncated = loader.loadScene( ( directory.path / "tile.gltf" ).string() );
+	REQUIRE( truncated == nullptr );
+}
+
+TEST_CASE( "Mapped loading of a texture-heavy GLB keeps the parser heap small", "[gltf][loader][mapped][performance]" )
+{
+	TempDirectory directory;
+	const fs::path path = directory.path / "city_tile.glb";
+	writeGlb( path, makeTile( { 512, 8, 16u << 20 } ) ); // ~9 MB geometry, 128 MB images
+	const auto fileSize = fs::file_size( path );
+
+	gltf_loader::GLTFLoader loader;
+	loader.setLodGenerationEnabled( false );
+	const auto timeLoad = [&]( bool mapped, gltf_loader::LoadStats &stats ) {
+		loader.setMemoryMappingEnabled( mapped );
+		const auto start = std::chrono::steady_clock::now();
+		const auto scene = loader.loadScene( path.string(), &stats );
+		const double ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+		REQUIRE( scene );
+		REQUIRE( firstPrimitive( *scene ).getVertexCount() == 512 * 512 );
+		return ms;
+	};
+
+	gltf_loader::LoadStats readStats;
+	gltf_loader::LoadStats mappedStats;
+	const double readMs = timeLoad( false, readStats );
+	const double mappedMs = timeLoad( true, mappedStats );
+	INFO( "File " << fileSize / ( 1024 * 1024 ) << " MB: heap read " << readMs << " ms, peak parser heap " << readStats.parserPeakHeapBytes / 1024
+				  << " KB; mapped " << mappedMs << " ms, peak parser heap " << mappedStats.parserPeakHeapBytes / 1024 << " KB" );
+
+	REQUIRE( readStats.parserPeakHeapBytes >= fileSize );
+	REQUIRE( mappedStats.parserPeakHeapBytes < fileSize / 100 );
+}
@@ -0,0 +1,270 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/gltf_loader/gltf_loader.h"
+#include "runtime/thread_pool.h"
+
+namespace
+{
+namespace fs = std::filesystem;
+
+template <typename T>
+void append( std::vector<std::uint8_t> &out, const T &value )
+{
+	const auto *bytes = reinterpret_cast<const std::uint8_t *>( &value );
+	out.insert( out.end(), bytes, bytes + sizeof( T ) );
+}
+
+// meshCount meshes of one gridSize x gridSize grid each, every mesh with its own positions (offset along Z)
+// and its own material, sharing the normal and index accessors; one root node per mesh
+struct Document
+{
+	std::string json;
+	std::vector<std::uint8_t> binary;
+};
+
+Document makeDocument( std::uint32_t meshCount, std::uint32_t gridSize, const std::string &bufferUri )
+{
+	const std::uint32_t n = gridSize;
+	const std::uint32_t vertexCount = n * n;
+	const std::uint32_t indexCount = ( n - 1 ) * ( n - 1 ) * 6;
+
+	Document document;
+	auto &bin = document.binary;
+	for ( std::uint32_t i = 0; i < vertexCount; ++i )
+	{
+		append( bin, 0.0f );
+		append( bin, 0.0f );
+		append( bin, 1.0f );
+	}
+	for ( std::uint32_t y = 0; y + 1 < n; ++y )
+	{
+		for ( std::uint32_t x = 0; x + 1 < n; ++x )
+		{
+			const std::uint32_t i = y * n + x;
+			for ( const std::uint32_t index : { i, i + 1, i + n, i + 1, i + n + 1, i + n } )
+			{
+				append( bin, index );
+			}
+		}
+	}
+	const std::size_t positionsOffset = bin.size();
+	for ( std::uint32_t mesh = 0; mesh < meshCount; ++mesh )
+	{
+		for ( std::uint32_t y = 0; y < n; ++y )
+		{
+			for ( std::uint32_t x = 0; x < n; ++x )
+			{
+				append( bin, static_cast<float>( x ) );
+				append( bin, static_cast<float>( y ) );
+				append( bin, static_cast<float>( mesh ) + static_cast<float>( ( x * 7 + y * 3 ) % 5 ) * 0.125f );
+			}
+		}
+	}
+
+	const std::size_t attributeBytes = std::size_t( vertexCount ) * 12; // One float3 stream
+	std::string accessors = "{ \"bufferView\": 0, \"componentType\": 5126, \"count\": " + std::to_string( vertexCount ) + ", \"type\": \"VEC3\" },"
+		+ "{ \"bufferView\": 1, \"componentType\": 5125, \"count\": " + std::to_string( indexCount ) + ", \"type\": \"SCALAR\" }";
+	std::string meshes;
+	std::string materials;
+	std::string nodes;
+	std::string roots;
+	for ( std::uint32_t mesh = 0; mesh < meshCount; ++mesh )
+	{
+		const std::string separator = mesh ? "," : "";
+		const std::string index = std::to_string( mesh );
+		accessors += ", { \"bufferView\": 2, \"byteOffset\": " + std::to_string( std::size_t( mesh ) * attributeBytes ) + ", \"componentType\": 5126, \"count\": "
+			+ std::to_string( vertexCount ) + ", \"type\": \"VEC3\" }";
+		meshes += separator + "{ \"primitives\": [{ \"attributes\": { \"POSITION\": " + std::to_string( mesh + 2 ) + ", \"NORMAL\": 0 }, \"indices\": 1, \"material\": " + index + " }] }";
+		materials += separator + "{ \"name\": \"Material" + index + "\", \"pbrMetallicRoughness\": { \"baseColorFactor\": [" + std::to_string( ( mesh % 100 ) / 100.0 )
+			+ ", 0.5, 0.5, 1] } }";
+		nodes += separator + "{ \"mesh\": " + index + ", \"name\": \"Node" + index + "\" }";
+		roots += separator + index;
+	}
+
+	const std::string views = "{ \"buffer\": 0, \"byteOffset\": 0, \"byteLength\": " + std::to_string( attributeBytes ) + " },"
+		+ "{ \"buffer\": 0, \"byteOffset\": " + std::to_string( attributeBytes ) + ", \"byteLength\": " + std::to_string( std::size_t( indexCount ) * 4 ) + " },"
+		+ "{ \"buffer\": 0, \"byteOffset\": " + std::to_string( positionsOffset ) + ", \"byteLength\": " + std::to_string( bin.size() - positionsOffset ) + " }";
+	document.json = std::string( R"({ "asset": { "version": "2.0" }, "scene": 0,)" )
+		+ "\"scenes\": [{ \"nodes\": [" + roots + "] }],"
+		+ "\"nodes\": [" + nodes + "],"
+		+ "\"meshes\": [" + meshes + "],"
+		+ "\"materials\": [" + materials + "],"
+		+ "\"accessors\": [" + accessors + "],"
+		+ "\"bufferViews\": [" + views + "],"
+		+ "\"buffers\": [{ \"byteLength\": " + std::to_string( bin.size() ) + ", \"uri\": \"" + bufferUri + "\" }] }";
+	return document;
+}
+
+void writeFile( const fs::path &path, const void *data, std::size_t size )
+{
+	std::ofstream file( path, std::ios::binary );
+	file.write( static_cast<const char *>( data ), static_cast<std::streamsize>( size ) );
+}
+
+// Temporary directory holding one generated document, removed at scope exit
+struct GeneratedScene
+{
+	fs::path directory = fs::temp_directory_path() / "gltf_parallel_extraction_tests";
+	fs::path path = directory / "scene.gltf";
+
+	GeneratedScene( std::uint32_t meshCount, std::uint32_t gridSize )
+	{
+		fs::create_directories( directory );
+		const auto document = makeDocument( meshCount, gridSize, "scene.bin" );
+		writeFile( path, document.json.data(), document.json.size() );
+		writeFile( directory / "scene.bin", document.binary.data(), document.binary.size() );
+	}
+	~GeneratedScene()
+	{
+		std::error_code error;
+		fs::remove_all( directory, error );
+	}
+};
+
+// Same handles, in the same order, referring to the same contents
+void requireSameScene( const assets::Scene &expected, const assets::Scene &actual )
+{
+	REQUIRE( actual.getMaterials().size() == expected.getMaterials().size() );
+	for ( std::size_t i = 0; i < expected.getMaterials().size(); ++i )
+	{
+		REQUIRE( actual.getMaterials()[i]->getName() == expected.getMaterials()[i]->getName() );
+	}
+
+	REQUIRE( actual.getMeshes().size() == expected.getMeshes().size() );
+	for ( std::size_t i = 0; i < expected.getMeshes().size(); ++i )
+	{
+		const auto &expectedMesh = *expected.getMeshes()[i];
+		const auto &actualMesh = *actual.getMeshes()[i];
+		REQUIRE( actualMesh.getPrimitiveCount() == expectedMesh.getPrimitiveCount() );
+		for ( std::uint32_t p = 0; p < expectedMesh.getPrimitiveCount(); ++p )
+		{
+			const auto &expectedPrimitive = expectedMesh.getPrimitive( p );
+			const auto &actualPrimitive = actualMesh.getPrimitive( p );
+			REQUIRE( actualPrimitive.getMaterialHandle() == expectedPrimitive.getMaterialHandle() );
+			REQUIRE( actualPrimitive.getIndices() == expectedPrimitive.getIndices() );
+			REQUIRE( actualPrimitive.getVertexCount() == expectedPrimitive.getVertexCount() );
+			REQUIRE( actualPrimitive.getBounds().min == expectedPrimitive.getBounds().min );
+			REQUIRE( actualPrimitive.getBounds().max == expectedPrimitive.getBounds().max );
+		}
+	}
+
+	REQUIRE( actual.getRootNodes().size() == expected.getRootNodes().size() );
+	for ( std::size_t i = 0; i < expected.getRootNodes().size(); ++i )
+	{
+		REQUIRE( actual.getRootNodes()[i]->getName() == expected.getRootNodes()[i]->getName() );
+		REQUIRE( actual.getRootNodes()[i]->getMeshHandles() == expected.getRootNodes()[i]->getMeshHandles() );
+	}
+}
+} // namespace
+
+TEST_CASE( "ThreadPool parallelFor visits every index once and rethrows failures", "[thread_pool]" )
+{
+	runtime::ThreadPool pool( 3 );
+	REQUIRE( pool.getThreadCount() == 3 );
+
+	for ( const std::size_t grainSize : { 1u, 7u, 1000u } )
+	{
+		std::vector<std::atomic<int>> visits( 1000 );
+		pool.parallelFor( visits.size(), [&]( std::size_t i ) { visits[i].fetch_add( 1 ); }, grainSize );
+		REQUIRE( std::all_of( visits.begin(), visits.end(), []( const std::atomic<int> &count ) { return count.load() == 1; } ) );
+	}
+
+	// Nested loops complete even though the outer loop occupies every worker
+	std::atomic<int> inner = 0;
+	pool.parallelFor( 8, [&]( std::size_t ) { pool.parallelFor( 16, [&]( std::size_t ) { inner.fetch_add( 1 ); } ); } );
+	REQUIRE( inner.load() == 8 * 16 );
+
+	std::atomic<int> completed = 0;
+	REQUIRE_THROWS_AS( pool.parallelFor( 64,
+						   [&]( std::size_t i ) {
+							   if ( i == 13 )
+							   {
+								   throw std::runtime_error( "failed" );
+							   }
+							   completed.fetch_add( 1 );
+						   } ),
+		std::runtime_error );
+	REQUIRE( completed.load() == 63 );
+
+	auto future = pool.submit( [] { return 42; } );
+	REQUIRE( future.get() == 42 );
+}
+
+TEST_CASE( "Parallel extraction assigns the same handles as serial extraction", "[gltf][loader][parallel]" )
+{
+	const GeneratedScene generated( 200, 6 );
+	runtime::ThreadPool pool( 4 );
+
+	gltf_loader::GLTFLoader loader;
+	loader.setThreadPool( &pool );
+	REQUIRE( loader.isParallelExtractionEnabled() );
+	const auto parallel = loader.loadScene( generated.path.string() );
+	loader.setParallelExtractionEnabled( false );
+	const auto serial = loader.loadScene( generated.path.string() );
+	REQUIRE( parallel );
+	REQUIRE( serial );
+
+	REQUIRE( parallel->getMeshes().size() == 200 );
+	REQUIRE( parallel->getMaterials().size() == 200 );
+	requireSameScene( *serial, *parallel );
+
+	// Handles follow document order: mesh i sits at Z = i and uses material i
+	for ( std::size_t i = 0; i < 200; i += 37 )
+	{
+		const auto &node = parallel->getRootNodes()[i];
+		REQUIRE( node->getName() == "Node" + std::to_string( i ) );
+		const auto mesh = parallel->getMesh( node->getMeshHandle( 0 ) );
+		REQUIRE( mesh->getPrimitive( 0 ).getBounds().min.z == static_cast<float>( i ) );
+		REQUIRE( parallel->getMaterial( mesh->getPrimitive( 0 ).getMaterialHandle() )->getName() == "Material" + std::to_string( i ) );
+	}
+}
+
+TEST_CASE( "Parallel extraction of a 5,000-mesh scene", "[gltf][loader][parallel][performance]" )
+{
+	const GeneratedScene generated( 5000, 16 );
+	const std::uint32_t hardwareThreads = std::max( 1u, std::thread::hardware_concurrency() );
+
+	gltf_loader::GLTFLoader loader;
+	const auto timeLoad = [&]( runtime::ThreadPool *pool ) {
+		loader.setParallelExtractionEnabled( pool != nullptr );
+		loader.setThreadPool( pool );
+		const auto start = std::chrono::steady_clock::now();
+		auto scene = loader.loadScene( generated.path.string() );
+		const double ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+		REQUIRE( scene );
+		REQUIRE( scene->getMeshes().size() == 5000 );
+		return std::make_pair( ms, std::move( scene ) );
+	};
+
+	const auto [serialMs, serialScene] = timeLoad( nullptr );
+	INFO( "Serial: " << serialMs << " ms" );
+
+	// Thread counts include the calling thread, which runs extraction work alongside the pool's workers
+	double fastestMs = serialMs;
+	for ( std::uint32_t threads = 2; threads <= hardwareThreads; threads *= 2 )
+	{
+		runtime::ThreadPool pool( threads - 1 );
+		const auto [ms, scene] = timeLoad( &pool );
+		requireSameScene( *serialScene, *scene );
+		INFO( threads << " threads: " << ms << " ms (" << serialMs / ms << "x)" );
+		fastestMs = std::min( fastestMs, ms );
+	}
+
+	// Timings depend on machine load; a missing speed-up is reported, the scene comparisons above are the test
+	if ( hardwareThreads >= 2 && fastestMs >= serialMs )
+	{
+		WARN( "No parallel speed-up: fastest " << fastestMs << " ms vs serial " << serialMs << " ms" );
+	}
+}
@@ -0,0 +1,253 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/assets/vertex_packing.h"
+#include "engine/gltf_loader/gltf_loader.h"
+#include "engine/gltf_loader/vertex_assembly.h"
+
+using Catch::Approx;
+
+namespace
+{
+template <typename T>
+void append( std::vector<std::uint8_t> &out, const T &value )
+{
+	const auto *bytes = reinterpret_cast<const std::uint8_t *>( &value );
+	out.insert( out.end(), bytes, bytes + sizeof( T ) );
+}
+
+std::string toBase64( const std::vector<std::uint8_t> &bytes )
+{
+	static constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::string out;
+	for ( std::size_t i = 0; i < bytes.size(); i += 3 )
+	{
+		const std::uint32_t chunk = ( std::uint32_t( bytes[i] ) << 16 ) | ( i + 1 < bytes.size() ? std::uint32_t( bytes[i + 1] ) << 8 : 0u ) | ( i + 2 < bytes.size() ? bytes[i + 2] : 0u );
+		out += kAlphabet[( chunk >> 18 ) & 63];
+		out += kAlphabet[( chunk >> 12 ) & 63];
+		out += i + 1 < bytes.size() ? kAlphabet[( chunk >> 6 ) & 63] : '=';
+		out += i + 2 < bytes.size() ? kAlphabet[chunk & 63] : '=';
+	}
+	return out;
+}
+
+// One triangle in KHR_mesh_quantization formats: int16 positions (unnormalized, stride 8), int8 normalized
+// normals (stride 4), uint16 normalized UVs and uint8 normalized RGBA colours. invalidNormal drops the
+// normalization from the normals, which the extension does not allow.
+std::string makeQuantizedTriangle( bool invalidNormal )
+{
+	std::vector<std::uint8_t> bin;
+	const std::int16_t positions[3][3] = { { 0, 0, 0 }, { 100, 0, -50 }, { 0, 200, 25 } };
+	for ( const auto &position : positions )
+	{
+		for ( const std::int16_t component : position )
+		{
+			append( bin, component );
+		}
+		append( bin, std::int16_t( 0 ) );
+	}
+	const std::int8_t normals[3][3] = { { 0, 127, 0 }, { 0, 0, -128 }, { 127, 0, 0 } };
+	for ( const auto &normal : normals )
+	{
+		for ( const std::int8_t component : normal )
+		{
+			append( bin, component );
+		}
+		append( bin, std::int8_t( 0 ) );
+	}
+	for ( const std::uint16_t uv : { 0, 0, 65535, 32768, 0, 65535 } )
+	{
+		append( bin, uv );
+	}
+	for ( const std::uint8_t channel : { 255, 0, 0, 255, 0, 255, 0, 128, 0, 0, 255, 0 } )
+	{
+		append( bin, channel );
+	}
+	for ( const std::uint16_t index : { 0, 1, 2 } )
+	{
+		append( bin, index );
+	}
+	append( bin, std::uint16_t( 0 ) );
+
+	const std::string normalAccessor = invalidNormal ? R"({ "bufferView": 1, "componentType": 5120, "count": 3, "type": "VEC3" })"
+													 : R"({ "bufferView": 1, "componentType": 5120, "normalized": true, "count": 3, "type": "VEC3" })";
+	return std::string( R"({
+		"asset": { "version": "2.0" },
+		"extensionsUsed": ["KHR_mesh_quantization"],
+		"extensionsRequired": ["KHR_mesh_quantization"],
+		"scene": 0,
+		"scenes": [{ "nodes": [0] }],
+		"nodes": [{ "mesh": 0 }],
+		"meshes": [{ "primitives": [{ "attributes": { "POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2, "COLOR_0": 3 }, "indices": 4 }] }],
+		"accessors": [
+			{ "bufferView": 0, "componentType": 5122, "count": 3, "type": "VEC3", "min": [0, 0, -50], "max": [100, 200, 25] },
+			)" ) + normalAccessor
+		+ R"(,
+			{ "bufferView": 2, "componentType": 5123, "normalized": true, "count": 3, "type": "VEC2" },
+			{ "bufferView": 3, "componentType": 5121, "normalized": true, "count": 3, "type": "VEC4" },
+			{ "bufferView": 4, "componentType": 5123, "count": 3, "type": "SCALAR" }
+		],
+		"bufferViews": [
+			{ "buffer": 0, "byteOffset": 0, "byteLength": 24, "byteStride": 8 },
+			{ "buffer": 0, "byteOffset": 24, "byteLength": 12, "byteStride": 4 },
+			{ "buffer": 0, "byteOffset": 36, "byteLength": 12 },
+			{ "buffer": 0, "byteOffset": 48, "byteLength": 12 },
+			{ "buffer": 0, "byteOffset": 60, "byteLength": 6 }
+		],
+		"buffers": [{ "byteLength": )"
+		+ std::to_string( bin.size() ) + R"(, "uri": "data:application/octet-stream;base64,)" + toBase64( bin ) + R"(" }]
+	})";
+}
+
+const assets::Primitive &firstPrimitive( const assets::Scene &scene )
+{
+	return scene.getMeshes().at( 0 )->getPrimitive( 0 );
+}
+
+float length( const math::Vec3f &v )
+{
+	return std::sqrt( v.x * v.x + v.y * v.y + v.z * v.z );
+}
+} // namespace
+
+TEST_CASE( "Vertex packing codecs round-trip within their precision", "[assets][vertex_packing]" )
+{
+	// Octahedral unit vectors: every octant, the axes and the folded lower hemisphere
+	for ( const math::Vec3f direction : { math::Vec3f{ 0, 0, 1 }, math::Vec3f{ 0, 0, -1 }, math::Vec3f{ 1, 0, 0 }, math::Vec3f{ 0, -1, 0 }, math::Vec3f{ 0.48f, -0.6f, -0.64f },
+			  math::Vec3f{ -0.36f, 0.48f, 0.8f }, math::Vec3f{ -0.577f, -0.577f, -0.577f } } )
+	{
+		std::int16_t encoded[2];
+		assets::encodeOctahedral( direction, encoded );
+		const auto decoded = assets::decodeOctahedral( encoded );
+		const float norm = length( direction );
+		REQUIRE( decoded.x == Approx( direction.x / norm ).margin( 1e-4 ) );
+		REQUIRE( decoded.y == Approx( direction.y / norm ).margin( 1e-4 ) );
+		REQUIRE( decoded.z == Approx( direction.z / norm ).margin( 1e-4 ) );
+	}
+
+	// Half floats: exact where representable, round to nearest even, saturate to infinity
+	for ( const float value : { 0.0f, 1.0f, -2.0f, 0.5f, 65504.0f, 0.000061035156f, 0.000000059604645f } )
+	{
+		REQUIRE( assets::halfToFloat( assets::floatToHalf( value ) ) == value );
+	}
+	REQUIRE( assets::floatToHalf( 1.0f + 1.0f / 4096.0f ) == assets::floatToHalf( 1.0f ) );
+	REQUIRE( assets::halfToFloat( assets::floatToHalf( 0.1f ) ) == Approx( 0.1f ).margin( 1e-4 ) );
+	REQUIRE( std::isinf( assets::halfToFloat( assets::floatToHalf( 70000.0f ) ) ) );
+
+	// Positions span the bounds, so the error is at most half a step of the extent
+	const math::BoundingBox3Df bounds{ { -10.0f, 0.0f, 5.0f }, { 30.0f, 0.0f, 6.0f } };
+	const auto quantization = assets::PositionQuantization::fromBounds( bounds );
+	for ( const math::Vec3f position : { bounds.min, bounds.max, math::Vec3f{ 12.345f, 0.0f, 5.5f } } )
+	{
+		std::int16_t encoded[3];
+		assets::quantizePosition( position, quantization, encoded );
+		const auto decoded = assets::dequantizePosition( encoded, quantization );
+		REQUIRE( decoded.x == Approx( position.x ).margin( 20.0f / 32767.0f ) );
+		REQUIRE( decoded.y == position.y ); // Flat axis
+		REQUIRE( decoded.z == Approx( position.z ).margin( 0.5f / 32767.0f ) );
+	}
+
+	// Attributes a packed layout leaves out decode to the Vertex defaults
+	const assets::VertexLayout positionOnly{ static_cast<std::uint32_t>( assets::VertexAttribute::Position ), true };
+	std::byte encodedVertex[8];
+	assets::encodeVertex( assets::Vertex{}, positionOnly, quantization, encodedVertex );
+	const auto defaults = assets::decodeVertex( encodedVertex, positionOnly, quantization );
+	const assets::Vertex reference;
+	REQUIRE( defaults.normal == reference.normal );
+	REQUIRE( defaults.tangent == reference.tangent );
+	REQUIRE( defaults.color == reference.color );
+}
+
+TEST_CASE( "Vertex assembly decodes normalized and integer components", "[gltf][loader][quantization]" )
+{
+	const std::vector<std::int8_t> bytes{ 127, -128, 0, 0, -127, 64, 0, 0 }; // Two int8 vec3 with stride 4
+	const std::vector<std::uint16_t> shorts{ 0, 65535, 32768, 1 };
+	const std::vector<std::int16_t> positions{ -300, 7, 12000 };
+
+	gltf_loader::VertexStreams streams;
+	streams.positions = { reinterpret_cast<const std::uint8_t *>( positions.data() ), 1, 6, gltf_loader::ComponentType::Short, false };
+	std::vector<assets::Vertex> vertices = gltf_loader::assembleVertices( streams );
+	REQUIRE( vertices.size() == 1 );
+	REQUIRE( vertices[0].position == math::Vec3f{ -300.0f, 7.0f, 12000.0f } );
+
+	std::vector<assets::Vertex> block( 2 );
+	gltf_loader::writeAttribute<3>( block, { reinterpret_cast<const std::uint8_t *>( bytes.data() ), 2, 4, gltf_loader::ComponentType::Byte, true }, &assets::Vertex::normal );
+	REQUIRE( block[0].normal.x == 1.0f );
+	REQUIRE( block[0].normal.y == -1.0f ); // -128 clamps to -1
+	REQUIRE( block[1].normal.y == Approx( 64.0f / 127.0f ) );
+
+	gltf_loader::writeAttribute<2>( block, { reinterpret_cast<const std::uint8_t *>( shorts.data() ), 2, 4, gltf_loader::ComponentType::UnsignedShort, true }, &assets::Vertex::texCoord );
+	REQUIRE( block[0].texCoord == math::Vec2f{ 0.0f, 1.0f } );
+	REQUIRE( block[1].texCoord.x == Approx( 32768.0f / 65535.0f ) );
+}
+
+TEST_CASE( "KHR_mesh_quantization primitives load without dropping attributes", "[gltf][loader][quantization]" )
+{
+	const gltf_loader::GLTFLoader loader;
+	const auto scene = loader.loadFromString( makeQuantizedTriangle( false ) );
+	REQUIRE( scene );
+	const auto &primitive = firstPrimitive( *scene );
+	REQUIRE( primitive.getVertexCount() == 3 );
+	REQUIRE( primitive.getIndices() == std::vector<std::uint32_t>{ 0, 1, 2 } );
+
+	const auto &vertices = primitive.getVertices();
+	REQUIRE( vertices[1].position == math::Vec3f{ 100.0f, 0.0f, -50.0f } );
+	REQUIRE( primitive.getBounds().max == math::Vec3f{ 100.0f, 200.0f, 25.0f } );
+	REQUIRE( vertices[0].normal == math::Vec3f{ 0.0f, 1.0f, 0.0f } );
+	REQUIRE( vertices[1].normal == math::Vec3f{ 0.0f, 0.0f, -1.0f } );
+	REQUIRE( vertices[1].texCoord.x == 1.0f );
+	REQUIRE( vertices[1].texCoord.y == Approx( 32768.0f / 65535.0f ) );
+	REQUIRE( vertices[0].color == math::Vec4f{ 1.0f, 0.0f, 0.0f, 1.0f } );
+	REQUIRE( vertices[1].color.w == Approx( 128.0f / 255.0f ) );
+
+	// A format the extension does not allow is dropped, leaving the import default
+	const auto invalid = loader.loadFromString( makeQuantizedTriangle( true ) );
+	REQUIRE( invalid );
+	REQUIRE( firstPrimitive( *invalid ).getVertices()[0].normal == gltf_loader::kDefaultImportNormal );
+	REQUIRE( firstPrimitive( *invalid ).getVertices()[1].texCoord.x == 1.0f );
+}
+
+TEST_CASE( "Packed vertex storage keeps the quantized data at 20 bytes per vertex", "[gltf][loader][quantization]" )
+{
+	gltf_loader::GLTFLoader loader;
+	const auto reference = loader.loadFromString( makeQuantizedTriangle( false ) );
+	loader.setVertexStorage( gltf_loader::VertexStorage::Packed );
+	const auto compact = loader.loadFromString( makeQuantizedTriangle( false ) );
+	REQUIRE( reference );
+	REQUIRE( compact );
+
+	// Position, normal, UV and colour; no tangents in the file
+	const auto &primitive = firstPrimitive( *compact );
+	REQUIRE( primitive.hasCompactVertices() );
+	REQUIRE( primitive.getVertices().empty() );
+	REQUIRE( primitive.getVertexCount() == 3 );
+	REQUIRE( primitive.getVertexLayout().packed );
+	REQUIRE_FALSE( primitive.getVertexLayout().has( assets::VertexAttribute::Tangent ) );
+	REQUIRE( primitive.getVertexData().size() == 3 * 20 );
+	REQUIRE( primitive.getBounds().min == firstPrimitive( *reference ).getBounds().min );
+
+	const auto decoded = primitive.decodeVertices();
+	const auto &expected = firstPrimitive( *reference ).getVertices();
+	REQUIRE( decoded.size() == expected.size() );
+	for ( std::size_t i = 0; i < decoded.size(); ++i )
+	{
+		// Within half a quantization step of the 200-unit extent
+		REQUIRE( decoded[i].position.x == Approx( expected[i].position.x ).margin( 0.01 ) );
+		REQUIRE( decoded[i].position.y == Approx( expected[i].position.y ).margin( 0.01 ) );
+		REQUIRE( decoded[i].position.z == Approx( expected[i].position.z ).margin( 0.01 ) );
+		REQUIRE( decoded[i].normal.x == Approx( expected[i].normal.x ).margin( 1e-4 ) );
+		REQUIRE( decoded[i].normal.y == Approx( expected[i].normal.y ).margin( 1e-4 ) );
+		REQUIRE( decoded[i].normal.z == Approx( expected[i].normal.z ).margin( 1e-4 ) );
+		REQUIRE( decoded[i].texCoord.x == Approx( expected[i].texCoord.x ).margin( 1e-3 ) );
+		REQUIRE( decoded[i].texCoord.y == Approx( expected[i].texCoord.y ).margin( 1e-3 ) );
+		// Source colours were already 8-bit
+		REQUIRE( decoded[i].color.x == Approx( expected[i].color.x ).margin( 1e-6 ) );
+		REQUIRE( decoded[i].color.w == Approx( expected[i].color.w ).margin( 1e-6 ) );
+	}
+}
@@ -0,0 +1,182 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/gltf_loader/gltf_loader.h"
+#include "engine/gltf_loader/vertex_assembly.h"
+
+using gltf_loader::AccessorStream;
+using gltf_loader::ComponentType;
+using gltf_loader::VertexStreams;
+
+namespace
+{
+// Interleaved position/normal/uv/tangent records, as exporters commonly write them
+struct InterleavedVertex
+{
+	float position[3];
+	float normal[3];
+	float uv[2];
+	float tangent[4];
+};
+
+std::vector<InterleavedVertex> makeInterleaved( std::size_t count )
+{
+	std::vector<InterleavedVertex> vertices( count );
+	for ( std::size_t i = 0; i < count; ++i )
+	{
+		const float f = static_cast<float>( i );
+		vertices[i] = { { f, -f * 0.5f, f * 0.25f - 3.0f }, { 0.0f, 1.0f, 0.0f }, { f * 0.1f, 1.0f - f * 0.1f }, { 1.0f, 0.0f, 0.0f, -1.0f } };
+	}
+	return vertices;
+}
+
+template <typename T>
+AccessorStream streamOf( const std::vector<T> &records, std::size_t byteOffset, std::size_t count )
+{
+	return { reinterpret_cast<const std::uint8_t *>( records.data() ) + byteOffset, count, sizeof( T ) };
+}
+} // namespace
+
+TEST_CASE( "Vertex assembly writes interleaved attributes and loader defaults", "[gltf][loader][vertex_assembly]" )
+{
+	const auto source = makeInterleaved( 5 );
+	const std::vector<float> colors{ 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f };
+
+	VertexStreams streams;
+	streams.positions = streamOf( source, offsetof( InterleavedVertex, position ), 5 );
+	streams.texCoords = streamOf( source, offsetof( InterleavedVertex, uv ), 3 ); // Shorter than the positions
+	streams.tangents = streamOf( source, offsetof( InterleavedVertex, tangent ), 5 );
+	streams.colors = { reinterpret_cast<const std::uint8_t *>( colors.data() ), 2, 3 * sizeof( float ) };
+	streams.colorComponents = 3;
+
+	const auto vertices = gltf_loader::assembleVertices( streams );
+	REQUIRE( vertices.size() == 5 );
+	REQUIRE( vertices[3].position == math::Vec3f{ 3.0f, -1.5f, -2.25f } );
+	// No normal stream: the import default, not the Vertex default
+	REQUIRE( vertices[0].normal == gltf_loader::kDefaultImportNormal );
+	REQUIRE( vertices[2].texCoord == math::Vec2f{ source[2].uv[0], source[2].uv[1] } );
+	REQUIRE( vertices[4].texCoord == math::Vec2f{ 0.0f, 0.0f } );
+	REQUIRE( vertices[1].tangent == math::Vec4f{ 1.0f, 0.0f, 0.0f, -1.0f } );
+	// RGB colours keep alpha 1; vertices past the colour stream stay white
+	REQUIRE( vertices[1].color == math::Vec4f{ 0.4f, 0.5f, 0.6f, 1.0f } );
+	REQUIRE( vertices[2].color == math::Vec4f{ 1.0f, 1.0f, 1.0f, 1.0f } );
+
+	streams.normals = streamOf( source, offsetof( InterleavedVertex, normal ), 5 );
+	REQUIRE( gltf_loader::assembleVertices( streams )[0].normal == math::Vec3f{ 0.0f, 1.0f, 0.0f } );
+
+	REQUIRE( gltf_loader::assembleVertices( VertexStreams{} ).empty() );
+}
+
+TEST_CASE( "Bulk position bounds match per-vertex expansion", "[gltf][loader][vertex_assembly]" )
+{
+	for ( const std::size_t count : { 1u, 2u, 7u, 64u } )
+	{
+		const auto source = makeInterleaved( count );
+		VertexStreams streams;
+		streams.positions = streamOf( source, offsetof( InterleavedVertex, position ), count );
+		const auto vertices = gltf_loader::assembleVertices( streams );
+
+		math::BoundingBox3Df expected;
+		for ( const auto &vertex : vertices )
+		{
+			expected.expand( vertex.position );
+		}
+		const auto bounds = gltf_loader::computePositionBounds( vertices );
+		REQUIRE( bounds.min == expected.min );
+		REQUIRE( bounds.max == expected.max );
+	}
+	REQUIRE_FALSE( gltf_loader::computePositionBounds( {} ).isValid() );
+}
+
+TEST_CASE( "Index assembly widens every component type, packed or strided", "[gltf][loader][vertex_assembly]" )
+{
+	const std::vector<std::uint8_t> bytes{ 0, 1, 2, 255 };
+	const std::vector<std::uint16_t> shorts{ 0, 1, 2, 65535 };
+	const std::vector<std::uint32_t> ints{ 0, 1, 2, 70000 };
+
+	REQUIRE( gltf_loader::assembleIndices( streamOf( bytes, 0, 4 ), ComponentType::UnsignedByte ) == std::vector<std::uint32_t>{ 0, 1, 2, 255 } );
+	REQUIRE( gltf_loader::assembleIndices( streamOf( shorts, 0, 4 ), ComponentType::UnsignedShort ) == std::vector<std::uint32_t>{ 0, 1, 2, 65535 } );
+	REQUIRE( gltf_loader::assembleIndices( streamOf( ints, 0, 4 ), ComponentType::UnsignedInt ) == std::vector<std::uint32_t>{ 0, 1, 2, 70000 } );
+
+	// Every other 16-bit index through a 4-byte stride
+	const AccessorStream strided{ reinterpret_cast<const std::uint8_t *>( shorts.data() ), 2, 4 };
+	REQUIRE( gltf_loader::assembleIndices( strided, ComponentType::UnsignedShort ) == std::vector<std::uint32_t>{ 0, 2 } );
+
+	REQUIRE( gltf_loader::assembleIndices( streamOf( ints, 0, 4 ), ComponentType::Float ).empty() );
+}
+
+TEST_CASE( "Vertex assembly of a 10M-vertex primitive", "[gltf][loader][vertex_assembly][performance]" )
+{
+	constexpr std::size_t kVertexCount = 10'000'000;
+	constexpr std::size_t kIndexCount = kVertexCount * 3;
+
+	const auto source = makeInterleaved( kVertexCount );
+	std::vector<std::uint32_t> sourceIndices( kIndexCount );
+	for ( std::size_t i = 0; i < kIndexCount; ++i )
+	{
+		sourceIndices[i] = static_cast<std::uint32_t>( ( i * 7919 ) % kVertexCount );
+	}
+	const auto *bytes = reinterpret_cast<const std::uint8_t *>( source.data() );
+	const auto *base = reinterpret_cast<const float *>( bytes );
+	const std::size_t stride = sizeof( InterleavedVertex );
+	using Clock = std::chrono::steady_clock;
+
+	// Previous path: a temporary vector per attribute, then addVertex/addIndex one element at a time
+	double perVertexMs = 0.0;
+	math::BoundingBox3Df perVertexBounds;
+	{
+		const auto start = Clock::now();
+		const auto positions = gltf_loader::extractFloat3Positions( base, kVertexCount, offsetof( InterleavedVertex, position ), stride );
+		const auto normals = gltf_loader::extractFloat3Normals( base, kVertexCount, offsetof( InterleavedVertex, normal ), stride );
+		const auto uvs = gltf_loader::extractFloat2UVs( base, kVertexCount, offsetof( InterleavedVertex, uv ), stride );
+		const auto tangents = gltf_loader::extractFloat4Tangents( base, kVertexCount, offsetof( InterleavedVertex, tangent ), stride );
+		assets::Primitive primitive;
+		for ( std::size_t i = 0; i < kVertexCount; ++i )
+		{
+			assets::Vertex vertex;
+			vertex.position = positions[i];
+			vertex.normal = normals[i];
+			vertex.texCoord = uvs[i];
+			vertex.tangent = tangents[i];
+			primitive.addVertex( vertex );
+		}
+		const auto indices = gltf_loader::extractIndicesAsUint32( reinterpret_cast<const std::uint8_t *>( sourceIndices.data() ), kIndexCount, ComponentType::UnsignedInt, 0, 0 );
+		for ( const auto index : indices )
+		{
+			primitive.addIndex( index );
+		}
+		perVertexMs = std::chrono::duration<double, std::milli>( Clock::now() - start ).count();
+		perVertexBounds = primitive.getBounds();
+	}
+
+	// Strided passes into a pre-sized array, bulk bounds, compile-time index widening
+	double assembledMs = 0.0;
+	{
+		const auto start = Clock::now();
+		VertexStreams streams;
+		streams.positions = { bytes + offsetof( InterleavedVertex, position ), kVertexCount, stride };
+		streams.normals = { bytes + offsetof( InterleavedVertex, normal ), kVertexCount, stride };
+		streams.texCoords = { bytes + offsetof( InterleavedVertex, uv ), kVertexCount, stride };
+		streams.tangents = { bytes + offsetof( InterleavedVertex, tangent ), kVertexCount, stride };
+		assets::Primitive primitive;
+		auto vertices = gltf_loader::assembleVertices( streams );
+		const auto bounds = gltf_loader::computePositionBounds( vertices );
+		primitive.setVertices( std::move( vertices ), bounds );
+		primitive.setIndices( gltf_loader::assembleIndices( streamOf( sourceIndices, 0, kIndexCount ), ComponentType::UnsignedInt ) );
+		assembledMs = std::chrono::duration<double, std::milli>( Clock::now() - start ).count();
+
+		REQUIRE( primitive.getVertexCount() == kVertexCount );
+		REQUIRE( primitive.getIndexCount() == kIndexCount );
+		REQUIRE( primitive.getBounds().min == perVertexBounds.min );
+		REQUIRE( primitive.getBounds().max == perVertexBounds.max );
+	}
+
+	INFO( kVertexCount << " vertices, " << kIndexCount << " indices: per-vertex " << perVertexMs << " ms, assembled " << assembledMs << " ms ("
+							<< perVertexMs / assembledMs << "x)" );
+	REQUIRE( assembledMs < perVertexMs );
+}
@@ -108,6 +108,53 @@ TEST_CASE( "Mesh maintains per-primitive GPU buffers", "[gpu][mesh][primitive][u
 	REQUIRE( prim1.getIndexBufferView().BufferLocation != prim2.getIndexBufferView().BufferLocation );
 }
 
+TEST_CASE( "GPUResourceManager suballocates mesh primitives from the geometry pool", "[gpu][mesh][geometry_pool][unit]" )
+{
+	dx12::Device device;
+	REQUIRE( device.initializeHeadless() );
+	engine::GPUResourceManager manager( device );
+
+	auto mesh = std::make_shared<assets::Mesh>();
+	for ( int p = 0; p < 2; ++p )
+	{
+		assets::Primitive primitive;
+		primitive.addVertex( assets::Vertex{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } } );
+		primitive.addVertex( assets::Vertex{ { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } } );
+		primitive.addVertex( assets::Vertex{ { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.5f, 1.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } } );
+		primitive.addIndex( 0 );
+		primitive.addIndex( 1 );
+		primitive.addIndex( 2 );
+		mesh->addPrimitive( std::move( primitive ) );
+	}
+
+	auto meshGPU = manager.getMeshGPU( mesh );
+	REQUIRE( meshGPU );
+	const auto &prim1 = meshGPU->getPrimitive( 0 );
+	const auto &prim2 = meshGPU->getPrimitive( 1 );
+	REQUIRE( prim1.isPooled() );
+	REQUIRE( prim2.isPooled() );
+
+	// One vertex and one index buffer; primitives are selected by draw offsets
+	REQUIRE( prim1.getVertexBufferView().BufferLocation == prim2.getVertexBufferView().BufferLocation );
+	REQUIRE( prim1.getIndexBufferView().BufferLocation == prim2.getIndexBufferView().BufferLocation );
+	REQUIRE( prim1.getVertexBufferView().StrideInBytes == sizeof( assets::Vertex ) );
+	REQUIRE( prim1.getBaseVertex() == 0 );
+	REQUIRE( prim2.getBaseVertex() == 3 );
+	REQUIRE( prim2.getStartIndex() == 3 );
+	REQUIRE( manager.getGeometryPool().getStats().allocations == 2 );
+
+	// Releasing the mesh frees its ranges once the frame fence has passed
+	meshGPU.reset();
+	manager.processPendingDeletes();
+	REQUIRE( manager.getGeometryPool().getStats().allocations == 0 );
+	REQUIRE( manager.getGeometryPool().getStats().pendingFrees == 2 );
+
+	// Headless frames never present, so complete the frame explicitly
+	device.waitForFenceValue( device.getCurrentFenceValue() );
+	manager.processPendingDeletes();
+	REQUIRE( manager.getGeometryPool().getStats().pendingFrees == 0 );
+}
+
 TEST_CASE( "PrimitiveGPU handles empty primitive gracefully", "[gpu][primitive][error][unit]" )
 {
 	// Create a headless D3D12 device for testing
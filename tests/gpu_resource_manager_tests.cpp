@@ -305,3 +305,59 @@ TEST_CASE( "configureMaterials assigns default material when primitive has no ma
 	REQUIRE( pbrMaterial.baseColorFactor.z == 1.0f ); // Blue
 	REQUIRE( pbrMaterial.baseColorFactor.w == 1.0f ); // Alpha
 }
+
+TEST_CASE( "GPUResourceManager evicts meshes outside the visible set over budget and re-uploads them", "[gpu_resource_manager][residency][unit]" )
+{
+	// Arrange
+	dx12::Device device;
+	REQUIRE( device.initializeHeadless() );
+	engine::GPUResourceManager manager( device );
+
+	const auto makeTriangleMesh = []() {
+		auto mesh = std::make_shared<assets::Mesh>();
+		assets::Primitive primitive;
+		primitive.addVertex( assets::Vertex{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } } );
+		primitive.addVertex( assets::Vertex{ { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } } );
+		primitive.addVertex( assets::Vertex{ { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.5f, 1.0f }, { 1.0f, 0.0f, 0.0f, 1.0f } } );
+		primitive.addIndex( 0 );
+		primitive.addIndex( 1 );
+		primitive.addIndex( 2 );
+		mesh->addPrimitive( primitive );
+		return mesh;
+	};
+	const auto meshA = makeTriangleMesh();
+	const auto meshB = makeTriangleMesh();
+	const auto gpuA = manager.getMeshGPU( meshA );
+	const auto gpuB = manager.getMeshGPU( meshB );
+	REQUIRE( gpuA != nullptr );
+	REQUIRE( gpuB != nullptr );
+
+	// Exact accounting: pooled primitives own exactly their vertex and index ranges
+	const std::uint64_t meshBytes = 3 * sizeof( assets::Vertex ) + 3 * sizeof( std::uint32_t );
+	REQUIRE( gpuA->getGpuMemoryBytes() == meshBytes );
+	REQUIRE( manager.getStatistics().meshMemoryBytes == 2 * meshBytes );
+
+	// Room for one mesh; both were created this frame, so nothing is evicted yet
+	manager.setMemoryBudget( meshBytes );
+	manager.processPendingDeletes();
+	REQUIRE_FALSE( gpuA->isEvicted() );
+	REQUIRE_FALSE( gpuB->isEvicted() );
+
+	// Act - only A is visible next frame
+	REQUIRE( manager.requestResident( *gpuA ) );
+	manager.processPendingDeletes();
+
+	// Assert - B was evicted and no longer counts against the budget
+	REQUIRE( gpuB->isEvicted() );
+	REQUIRE_FALSE( gpuB->isValid() );
+	REQUIRE( gpuA->isValid() );
+	REQUIRE( manager.getStatistics().evictions == 1 );
+	REQUIRE( manager.getStatistics().meshMemoryBytes == meshBytes );
+
+	// B comes back into view and is re-uploaded on demand
+	REQUIRE( manager.requestResident( *gpuB ) );
+	REQUIRE( gpuB->isValid() );
+	REQUIRE_FALSE( gpuB->isEvicted() );
+	REQUIRE( manager.getStatistics().residencyMisses == 1 );
+	REQUIRE( manager.getResidencyStats().reuploads == 1 );
+}
@@ -0,0 +1,177 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <vector>
+
+#include "engine/render_queue/instance_batcher.h"
+
+namespace
+{
+struct RecordingVisitor
+{
+	std::vector<std::uint32_t> pipelines;
+	std::vector<std::uint32_t> materials;
+	std::vector<std::uint32_t> geometries;
+	std::vector<engine::InstanceBatch> draws;
+
+	void setPipeline( std::uint32_t id ) { pipelines.push_back( id ); }
+	void setMaterial( std::uint32_t id ) { materials.push_back( id ); }
+	void setGeometry( std::uint32_t id ) { geometries.push_back( id ); }
+	void drawInstanced( const engine::InstanceBatch &batch ) { draws.push_back( batch ); }
+};
+
+static_assert( engine::InstanceBatchVisitor<RecordingVisitor> );
+
+std::vector<math::Mat4f> makeTranslations( std::uint32_t count )
+{
+	std::vector<math::Mat4f> matrices;
+	matrices.reserve( count );
+	for ( std::uint32_t i = 0; i < count; ++i )
+	{
+		matrices.push_back( math::Mat4f::translation( static_cast<float>( i ), 0.0f, 0.0f ) );
+	}
+	return matrices;
+}
+} // namespace
+
+TEST_CASE( "InstanceBatcher groups draws sharing pipeline, material and geometry", "[instancing][unit]" )
+{
+	const auto matrices = makeTranslations( 6 );
+
+	engine::RenderQueue queue;
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 0 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 1, 0, 1 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 2 }, 2.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 1, 3 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 4 }, 3.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 1, 0, 5 }, 2.0f );
+	queue.sort();
+
+	engine::InstanceBatcher batcher;
+	batcher.build( queue, matrices );
+
+	// (material 0, geometry 0) x3, (material 0, geometry 1) x1, (material 1, geometry 0) x2
+	REQUIRE( batcher.getDrawCallCount() == 3 );
+	REQUIRE( batcher.getInstanceCount() == 6 );
+
+	const auto &batches = batcher.getBatches();
+	REQUIRE( batches[0].instanceCount == 3 );
+	REQUIRE( batches[0].firstInstance == 0 );
+	REQUIRE( batches[1].geometryId == 1 );
+	REQUIRE( batches[1].instanceCount == 1 );
+	REQUIRE( batches[2].materialId == 1 );
+	REQUIRE( batches[2].firstInstance == 4 );
+	REQUIRE( batches[2].instanceCount == 2 );
+}
+
+TEST_CASE( "InstanceBatcher packs transposed world matrices in front-to-back order", "[instancing][unit]" )
+{
+	const auto matrices = makeTranslations( 3 );
+
+	engine::RenderQueue queue;
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 0 }, 30.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 1 }, 10.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 2 }, 20.0f );
+	queue.sort();
+
+	engine::InstanceBatcher batcher;
+	batcher.build( queue, matrices );
+
+	REQUIRE( batcher.getDrawCallCount() == 1 );
+	const auto &instances = batcher.getInstances();
+	REQUIRE( instances.size() == 3 );
+
+	// Translation lands in the last row once transposed for HLSL
+	REQUIRE( instances[0].worldMatrix.row3.x == 1.0f );
+	REQUIRE( instances[1].worldMatrix.row3.x == 2.0f );
+	REQUIRE( instances[2].worldMatrix.row3.x == 0.0f );
+	REQUIRE( instances[0].worldMatrix.row0.w == 0.0f );
+}
+
+TEST_CASE( "InstanceBatcher splits runs at the instance limit", "[instancing][unit]" )
+{
+	const auto matrices = makeTranslations( 10 );
+
+	engine::RenderQueue queue;
+	for ( std::uint32_t i = 0; i < 10; ++i )
+	{
+		queue.push( engine::RenderPass::Opaque, { 0, 0, 0, i }, 1.0f );
+	}
+	queue.sort();
+
+	engine::InstanceBatcher batcher;
+	batcher.setMaxInstancesPerBatch( 4 );
+	batcher.build( queue, matrices );
+
+	REQUIRE( batcher.getDrawCallCount() == 3 );
+	REQUIRE( batcher.getBatches()[0].instanceCount == 4 );
+	REQUIRE( batcher.getBatches()[1].firstInstance == 4 );
+	REQUIRE( batcher.getBatches()[2].instanceCount == 2 );
+}
+
+TEST_CASE( "InstanceBatcher skips draws with out-of-range object indices", "[instancing][unit]" )
+{
+	const auto matrices = makeTranslations( 1 );
+
+	engine::RenderQueue queue;
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 0 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 7 }, 1.0f );
+
+	engine::InstanceBatcher batcher;
+	batcher.build( queue, matrices );
+
+	REQUIRE( batcher.getInstanceCount() == 1 );
+	REQUIRE( batcher.getDrawCallCount() == 1 );
+}
+
+TEST_CASE( "InstanceBatcher submit elides redundant state between batches", "[instancing][unit]" )
+{
+	const auto matrices = makeTranslations( 4 );
+
+	engine::RenderQueue queue;
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 0 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 1 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 1, 2 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 1, 3 }, 1.0f );
+	queue.sort();
+
+	engine::InstanceBatcher batcher;
+	batcher.build( queue, matrices );
+
+	RecordingVisitor visitor;
+	const auto stats = batcher.submit( visitor );
+
+	REQUIRE( stats.drawCount == 2 );
+	REQUIRE( stats.pipelineChanges == 1 );
+	REQUIRE( stats.materialChanges == 1 );
+	REQUIRE( stats.geometryChanges == 2 );
+	REQUIRE( visitor.draws[1].firstInstance == 2 );
+	REQUIRE( visitor.draws[1].instanceCount == 2 );
+}
+
+TEST_CASE( "InstanceBatcher collapses thousands of prop copies into a few draws", "[instancing][performance]" )
+{
+	// 10k copies spread over 4 distinct props sharing one material
+	constexpr std::uint32_t kCopies = 10000;
+	const auto matrices = makeTranslations( kCopies );
+
+	engine::RenderQueue queue;
+	queue.reserve( kCopies );
+	for ( std::uint32_t i = 0; i < kCopies; ++i )
+	{
+		queue.push( engine::RenderPass::Opaque, { 0, 0, i % 4, i }, static_cast<float>( i ) );
+	}
+
+	engine::InstanceBatcher batcher;
+	const auto start = std::chrono::high_resolution_clock::now();
+	queue.sort();
+	batcher.build( queue, matrices );
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	REQUIRE( batcher.getDrawCallCount() == 4 );
+	REQUIRE( batcher.getInstanceCount() == kCopies );
+
+	// Generous budget (debug builds included)
+	const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>( end - start );
+	REQUIRE( duration.count() < 50 );
+}
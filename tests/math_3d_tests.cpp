@@ -347,3 +347,36 @@ TEST_CASE( "3D Bounding Volumes", "[3d][bounding]" )
 		REQUIRE_FALSE( frustum.intersects( outsideBox ) );
 	}
 }
+
+TEST_CASE( "Frustum extraction from view-projection matrix", "[3d][geometry][frustum]" )
+{
+	// Camera at origin looking down +Y (Z-up), 90 degree vertical FOV, square aspect
+	const auto view = math::Mat4f::lookAt( math::Vec3f( 0.0f, 0.0f, 0.0f ), math::Vec3f( 0.0f, 1.0f, 0.0f ), math::Vec3f( 0.0f, 0.0f, 1.0f ) );
+	const auto projection = math::Mat4f::perspective( math::radians( 90.0f ), 1.0f, 1.0f, 50.0f );
+	const auto frustum = math::Frustum<float>::fromViewProjection( projection * view );
+
+	SECTION( "Planes are normalized" )
+	{
+		for ( const auto &plane : frustum.planes )
+		{
+			REQUIRE( math::length( plane.normal ) == Approx( 1.0f ) );
+		}
+	}
+
+	SECTION( "Near and far planes match the projection" )
+	{
+		REQUIRE( frustum.planes[4].distanceToPoint( math::Vec3f( 0.0f, 1.0f, 0.0f ) ) == Approx( 0.0f ).margin( 1e-4f ) );
+		REQUIRE( frustum.planes[5].distanceToPoint( math::Vec3f( 0.0f, 50.0f, 0.0f ) ) == Approx( 0.0f ).margin( 1e-3f ) );
+	}
+
+	SECTION( "Point containment follows the view direction" )
+	{
+		REQUIRE( frustum.contains( math::Vec3f( 0.0f, 10.0f, 0.0f ) ) );
+		REQUIRE( frustum.contains( math::Vec3f( 9.0f, 10.0f, -9.0f ) ) );
+		REQUIRE_FALSE( frustum.contains( math::Vec3f( 0.0f, -10.0f, 0.0f ) ) ); // Behind
+		REQUIRE_FALSE( frustum.contains( math::Vec3f( 11.0f, 10.0f, 0.0f ) ) ); // Outside right
+		REQUIRE_FALSE( frustum.contains( math::Vec3f( 0.0f, 10.0f, 11.0f ) ) ); // Above
+		REQUIRE_FALSE( frustum.contains( math::Vec3f( 0.0f, 60.0f, 0.0f ) ) );	// Beyond far plane
+		REQUIRE_FALSE( frustum.contains( math::Vec3f( 0.0f, 0.5f, 0.0f ) ) );	// Before near plane
+	}
+}
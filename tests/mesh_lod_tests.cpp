@@ -0,0 +1,285 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/mesh_lod/mesh_lod.h"
+
+namespace
+{
+// Flat grid of cells x cells quads in the XZ plane spanning [0, cells]
+assets::Primitive makeGrid( std::uint32_t cells )
+{
+	assets::Primitive primitive;
+	const std::uint32_t columns = cells + 1;
+	for ( std::uint32_t z = 0; z <= cells; ++z )
+	{
+		for ( std::uint32_t x = 0; x <= cells; ++x )
+		{
+			assets::Vertex vertex;
+			vertex.position = { static_cast<float>( x ), 0.0f, static_cast<float>( z ) };
+			vertex.texCoord = { static_cast<float>( x ) / cells, static_cast<float>( z ) / cells };
+			primitive.addVertex( vertex );
+		}
+	}
+	for ( std::uint32_t z = 0; z < cells; ++z )
+	{
+		for ( std::uint32_t x = 0; x < cells; ++x )
+		{
+			const std::uint32_t i0 = z * columns + x;
+			const std::uint32_t i1 = i0 + 1;
+			const std::uint32_t i2 = i0 + columns;
+			const std::uint32_t i3 = i2 + 1;
+			for ( const std::uint32_t index : { i0, i2, i1, i1, i2, i3 } )
+			{
+				primitive.addIndex( index );
+			}
+		}
+	}
+	return primitive;
+}
+
+// UV sphere; the u = 0 and u = 1 columns duplicate positions with different texture coordinates
+assets::Primitive makeSphere( std::uint32_t stacks, std::uint32_t slices, float radius = 1.0f )
+{
+	constexpr float kPi = 3.14159265358979f;
+	assets::Primitive primitive;
+	for ( std::uint32_t stack = 0; stack <= stacks; ++stack )
+	{
+		const float v = static_cast<float>( stack ) / stacks;
+		const float phi = v * kPi;
+		for ( std::uint32_t slice = 0; slice <= slices; ++slice )
+		{
+			const float u = static_cast<float>( slice ) / slices;
+			const float theta = ( slice == slices ? 0.0f : u ) * 2.0f * kPi;
+			assets::Vertex vertex;
+			vertex.position = { radius * std::sin( phi ) * std::cos( theta ), radius * std::cos( phi ), radius * std::sin( phi ) * std::sin( theta ) };
+			vertex.normal = { vertex.position.x / radius, vertex.position.y / radius, vertex.position.z / radius };
+			vertex.texCoord = { u, v };
+			primitive.addVertex( vertex );
+		}
+	}
+	const std::uint32_t columns = slices + 1;
+	for ( std::uint32_t stack = 0; stack < stacks; ++stack )
+	{
+		for ( std::uint32_t slice = 0; slice < slices; ++slice )
+		{
+			const std::uint32_t i0 = stack * columns + slice;
+			const std::uint32_t i1 = i0 + 1;
+			const std::uint32_t i2 = i0 + columns;
+			const std::uint32_t i3 = i2 + 1;
+			if ( stack != 0 )
+			{
+				for ( const std::uint32_t index : { i0, i1, i2 } )
+					primitive.addIndex( index );
+			}
+			if ( stack != stacks - 1 )
+			{
+				for ( const std::uint32_t index : { i1, i3, i2 } )
+					primitive.addIndex( index );
+			}
+		}
+	}
+	return primitive;
+}
+
+engine::mesh_lod::SimplifyResult simplifyPrimitive( const assets::Primitive &primitive, std::size_t targetIndexCount, float maxError )
+{
+	const auto &vertices = primitive.getVertices();
+	return engine::mesh_lod::simplify( primitive.getIndices(), &vertices[0].position.x, vertices.size(), sizeof( assets::Vertex ), targetIndexCount, maxError );
+}
+
+using PositionKey = std::tuple<float, float, float>;
+
+PositionKey positionKey( const assets::Vertex &vertex )
+{
+	return { vertex.position.x, vertex.position.y, vertex.position.z };
+}
+} // namespace
+
+TEST_CASE( "Simplifying a flat grid reaches the target with no error and keeps its border", "[mesh_lod][unit]" )
+{
+	const auto grid = makeGrid( 16 );
+	const auto result = simplifyPrimitive( grid, grid.getIndexCount() / 4, 0.01f );
+
+	REQUIRE( result.indices.size() % 3 == 0 );
+	REQUIRE( result.indices.size() <= grid.getIndexCount() / 4 );
+	REQUIRE( result.indices.size() > 0 );
+	REQUIRE( result.error == Catch::Approx( 0.0f ).margin( 1e-4f ) );
+
+	// Every border vertex is still referenced, so the outline is unchanged
+	std::set<std::uint32_t> used( result.indices.begin(), result.indices.end() );
+	const auto &vertices = grid.getVertices();
+	for ( std::uint32_t i = 0; i < vertices.size(); ++i )
+	{
+		const auto &p = vertices[i].position;
+		if ( p.x == 0.0f || p.x == 16.0f || p.z == 0.0f || p.z == 16.0f )
+		{
+			REQUIRE( used.count( i ) == 1 );
+		}
+	}
+
+	// Remaining triangles keep the original winding (all face +Y) and cover the same area
+	float area = 0.0f;
+	for ( std::size_t t = 0; t < result.indices.size(); t += 3 )
+	{
+		const auto &a = vertices[result.indices[t]].position;
+		const auto &b = vertices[result.indices[t + 1]].position;
+		const auto &c = vertices[result.indices[t + 2]].position;
+		const float normalY = ( c.x - a.x ) * ( b.z - a.z ) - ( b.x - a.x ) * ( c.z - a.z );
+		REQUIRE( normalY > 0.0f );
+		area += 0.5f * normalY;
+	}
+	REQUIRE( area == Catch::Approx( 256.0f ) );
+}
+
+TEST_CASE( "Simplification is deterministic", "[mesh_lod][unit]" )
+{
+	const auto sphere = makeSphere( 24, 32 );
+	const auto first = simplifyPrimitive( sphere, sphere.getIndexCount() / 3, 0.5f );
+	const auto second = simplifyPrimitive( sphere, sphere.getIndexCount() / 3, 0.5f );
+
+	REQUIRE( first.indices.size() < sphere.getIndexCount() );
+	REQUIRE( first.indices == second.indices );
+	REQUIRE( first.error == second.error );
+}
+
+TEST_CASE( "Simplification respects the error limit", "[mesh_lod][unit]" )
+{
+	const auto sphere = makeSphere( 16, 16 );
+
+	// A curved surface cannot lose any triangle without error
+	const auto exact = simplifyPrimitive( sphere, 0, 0.0f );
+	REQUIRE( exact.indices == sphere.getIndices() );
+	REQUIRE( exact.error == 0.0f );
+
+	const auto loose = simplifyPrimitive( sphere, 0, 0.05f );
+	REQUIRE( loose.indices.size() < sphere.getIndexCount() );
+	REQUIRE( loose.error > 0.0f );
+	REQUIRE( loose.error <= 0.05f );
+}
+
+TEST_CASE( "Attribute seams are never collapsed", "[mesh_lod][unit]" )
+{
+	const auto sphere = makeSphere( 24, 32 );
+	const auto &vertices = sphere.getVertices();
+
+	// Positions shared by vertices on both sides of the u seam. Pole vertices are excluded: each only
+	// touches a single triangle, which may legitimately disappear when the ring below it is reduced.
+	std::map<PositionKey, std::set<std::uint32_t>> vertexSets;
+	for ( std::uint32_t i = 0; i < vertices.size(); ++i )
+	{
+		if ( std::abs( vertices[i].position.y ) < 0.999f )
+		{
+			vertexSets[positionKey( vertices[i] )].insert( i );
+		}
+	}
+
+	const auto result = simplifyPrimitive( sphere, sphere.getIndexCount() / 4, 1.0f );
+	REQUIRE( result.indices.size() < sphere.getIndexCount() / 2 );
+
+	const std::set<std::uint32_t> used( result.indices.begin(), result.indices.end() );
+	for ( const auto &[position, seamVertices] : vertexSets )
+	{
+		if ( seamVertices.size() < 2 )
+		{
+			continue;
+		}
+		for ( const std::uint32_t vertex : seamVertices )
+		{
+			REQUIRE( used.count( vertex ) == 1 );
+		}
+	}
+}
+
+TEST_CASE( "generateLods builds a decreasing chain with non-decreasing error", "[mesh_lod][unit]" )
+{
+	auto sphere = makeSphere( 48, 64 );
+	engine::mesh_lod::LodSettings settings;
+	settings.maxLevels = 4;
+	settings.maxRelativeError = 0.2f;
+
+	const auto report = engine::mesh_lod::generateLods( sphere, settings );
+
+	REQUIRE( report.levelCount() >= 3 );
+	REQUIRE( report.levelCount() == sphere.getLodCount() );
+	REQUIRE( report.triangleCounts[0] == sphere.getIndexCount() / 3 );
+	REQUIRE( report.errors[0] == 0.0f );
+	for ( std::uint32_t level = 1; level < report.levelCount(); ++level )
+	{
+		const auto &lod = sphere.getLods()[level - 1];
+		REQUIRE( lod.indices.size() == report.triangleCounts[level] * 3 );
+		REQUIRE( lod.error == report.errors[level] );
+		REQUIRE( report.triangleCounts[level] < report.triangleCounts[level - 1] );
+		REQUIRE( report.errors[level] >= report.errors[level - 1] );
+		for ( const std::uint32_t index : lod.indices )
+		{
+			REQUIRE( index < sphere.getVertexCount() );
+		}
+	}
+
+	// Regenerating replaces the chain; tiny primitives get no levels
+	engine::mesh_lod::generateLods( sphere, settings );
+	REQUIRE( sphere.getLodCount() == report.levelCount() );
+
+	auto small = makeGrid( 2 );
+	const auto smallReport = engine::mesh_lod::generateLods( small );
+	REQUIRE( smallReport.levelCount() == 1 );
+	REQUIRE( small.getLodCount() == 1 );
+
+	sphere.clearIndices();
+	REQUIRE( sphere.getLodCount() == 1 );
+}
+
+TEST_CASE( "selectLod picks coarser levels with distance and honours lodBias", "[mesh_lod][unit]" )
+{
+	const std::vector<float> errors = { 0.0f, 0.01f, 0.04f, 0.16f };
+	const float projectionScale = 1.0f / std::tan( 0.5f * 1.0472f ); // 60 degree vertical FOV
+	const float threshold = 1.0f / 1080.0f;
+
+	using engine::mesh_lod::selectLod;
+	REQUIRE( selectLod( errors, 1.0f, 1.0f, projectionScale, threshold, 0.0f ) == 0 );
+	REQUIRE( selectLod( errors, 1.0f, 10000.0f, projectionScale, threshold, 0.0f ) == 3 );
+
+	// Selection never gets finer as the object moves away
+	std::uint32_t previous = 0;
+	for ( float depth = 1.0f; depth < 1000.0f; depth *= 1.5f )
+	{
+		const auto level = selectLod( errors, 1.0f, depth, projectionScale, threshold, 0.0f );
+		REQUIRE( level >= previous );
+		previous = level;
+	}
+
+	// Positive bias switches sooner, negative bias later; larger world scale keeps detail
+	const float depth = 20.0f;
+	const auto unbiased = selectLod( errors, 1.0f, depth, projectionScale, threshold, 0.0f );
+	REQUIRE( selectLod( errors, 1.0f, depth, projectionScale, threshold, 2.0f ) > unbiased );
+	REQUIRE( selectLod( errors, 1.0f, depth, projectionScale, threshold, -2.0f ) < unbiased );
+	REQUIRE( selectLod( errors, 8.0f, depth, projectionScale, threshold, 0.0f ) < unbiased );
+
+	// Camera inside the bounds or a single level always draws full detail
+	REQUIRE( selectLod( errors, 1.0f, 0.0f, projectionScale, threshold, 4.0f ) == 0 );
+	REQUIRE( selectLod( errors, 1.0f, -5.0f, projectionScale, threshold, 4.0f ) == 0 );
+	REQUIRE( selectLod( std::vector<float>{ 0.0f }, 1.0f, 1000.0f, projectionScale, threshold, 0.0f ) == 0 );
+
+	REQUIRE( engine::mesh_lod::projectedError( 0.1f, 2.0f, 10.0f, 1.0f ) == Catch::Approx( 0.01f ) );
+}
+
+TEST_CASE( "Simplification performance on a 130k triangle grid", "[mesh_lod][performance]" )
+{
+	const auto grid = makeGrid( 256 );
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	const auto result = simplifyPrimitive( grid, grid.getIndexCount() / 8, 0.01f );
+	const auto elapsed = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+
+	INFO( "Simplified " << grid.getIndexCount() / 3 << " -> " << result.indices.size() / 3 << " triangles in " << elapsed << " ms" );
+	REQUIRE( result.indices.size() <= grid.getIndexCount() / 8 );
+	REQUIRE( elapsed < 5000.0 );
+}
@@ -0,0 +1,321 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/gltf_loader/gltf_loader.h"
+#include "engine/mesh_optimize/mesh_optimize.h"
+
+using Catch::Approx;
+
+namespace
+{
+// Grid of cells x cells quads in the XZ plane, each quad with its own four vertices, so welding has work
+assets::Primitive makeUnweldedGrid( std::uint32_t cells )
+{
+	std::vector<assets::Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	math::BoundingBox3Df bounds;
+	for ( std::uint32_t z = 0; z < cells; ++z )
+	{
+		for ( std::uint32_t x = 0; x < cells; ++x )
+		{
+			const auto base = static_cast<std::uint32_t>( vertices.size() );
+			for ( const auto [dx, dz] : { std::array{ 0u, 0u }, std::array{ 1u, 0u }, std::array{ 0u, 1u }, std::array{ 1u, 1u } } )
+			{
+				assets::Vertex vertex;
+				vertex.position = { static_cast<float>( x + dx ), 0.0f, static_cast<float>( z + dz ) };
+				vertex.texCoord = { static_cast<float>( x + dx ) / cells, static_cast<float>( z + dz ) / cells };
+				bounds.expand( vertex.position );
+				vertices.push_back( vertex );
+			}
+			for ( const std::uint32_t corner : { 0u, 2u, 1u, 1u, 2u, 3u } )
+			{
+				indices.push_back( base + corner );
+			}
+		}
+	}
+	assets::Primitive primitive;
+	primitive.setVertices( std::move( vertices ), bounds );
+	primitive.setIndices( std::move( indices ) );
+	return primitive;
+}
+
+// Welded grid indices with the triangles in a fixed random order, the worst case for the cache
+std::vector<std::uint32_t> makeShuffledGridIndices( std::uint32_t cells )
+{
+	const std::uint32_t columns = cells + 1;
+	std::vector<std::array<std::uint32_t, 3>> triangles;
+	for ( std::uint32_t z = 0; z < cells; ++z )
+	{
+		for ( std::uint32_t x = 0; x < cells; ++x )
+		{
+			const std::uint32_t i0 = z * columns + x;
+			triangles.push_back( { i0, i0 + columns, i0 + 1 } );
+			triangles.push_back( { i0 + 1, i0 + columns, i0 + columns + 1 } );
+		}
+	}
+	std::shuffle( triangles.begin(), triangles.end(), std::mt19937( 1234 ) );
+
+	std::vector<std::uint32_t> indices;
+	for ( const auto &triangle : triangles )
+	{
+		indices.insert( indices.end(), triangle.begin(), triangle.end() );
+	}
+	return indices;
+}
+
+// Triangles as sorted vertex-position triples, independent of triangle order and vertex numbering
+std::vector<std::array<float, 9>> triangleSet( const std::vector<assets::Vertex> &vertices, const std::vector<std::uint32_t> &indices )
+{
+	std::vector<std::array<float, 9>> triangles;
+	for ( std::size_t i = 0; i + 2 < indices.size(); i += 3 )
+	{
+		// Rotate so the smallest corner comes first; keeps the winding
+		std::size_t first = 0;
+		for ( std::size_t corner = 1; corner < 3; ++corner )
+		{
+			const auto &a = vertices[indices[i + corner]].position;
+			const auto &b = vertices[indices[i + first]].position;
+			if ( std::tie( a.x, a.y, a.z ) < std::tie( b.x, b.y, b.z ) )
+			{
+				first = corner;
+			}
+		}
+		std::array<float, 9> triangle;
+		for ( std::size_t corner = 0; corner < 3; ++corner )
+		{
+			const auto &p = vertices[indices[i + ( first + corner ) % 3]].position;
+			triangle[corner * 3] = p.x;
+			triangle[corner * 3 + 1] = p.y;
+			triangle[corner * 3 + 2] = p.z;
+		}
+		triangles.push_back( triangle );
+	}
+	std::sort( triangles.begin(), triangles.end() );
+	return triangles;
+}
+} // namespace
+
+TEST_CASE( "Vertex cache simulation counts FIFO misses", "[mesh_optimize]" )
+{
+	using engine::mesh_optimize::simulateVertexCache;
+
+	// Two triangles sharing an edge: four transforms over four vertices
+	const std::vector<std::uint32_t> quad{ 0, 1, 2, 2, 1, 3 };
+	const auto stats = simulateVertexCache( quad, 4 );
+	REQUIRE( stats.triangleCount == 2 );
+	REQUIRE( stats.vertexCount == 4 );
+	REQUIRE( stats.vertexTransforms == 4 );
+	REQUIRE( stats.acmr() == Approx( 2.0f ) );
+	REQUIRE( stats.atvr() == Approx( 1.0f ) );
+
+	// With three entries vertex 0 is evicted by 3, 4 and 5 before it is used again
+	const std::vector<std::uint32_t> evicting{ 0, 1, 2, 3, 4, 5, 0, 1, 2 };
+	REQUIRE( simulateVertexCache( evicting, 6, 3 ).vertexTransforms == 9 );
+	REQUIRE( simulateVertexCache( evicting, 6, 6 ).vertexTransforms == 6 );
+}
+
+TEST_CASE( "Welding merges bitwise-identical vertices", "[mesh_optimize]" )
+{
+	const auto primitive = makeUnweldedGrid( 4 );
+	std::vector<std::uint32_t> remap;
+	const std::uint32_t unique = engine::mesh_optimize::generateWeldRemap( primitive.getVertices(), remap );
+
+	REQUIRE( remap.size() == primitive.getVertexCount() );
+	REQUIRE( unique == 5 * 5 );
+	std::vector<std::uint32_t> firstOccurrence( unique, engine::mesh_optimize::kUnusedVertex );
+	for ( std::uint32_t i = 0; i < remap.size(); ++i )
+	{
+		REQUIRE( remap[i] <= i );
+		if ( firstOccurrence[remap[i]] == engine::mesh_optimize::kUnusedVertex )
+		{
+			firstOccurrence[remap[i]] = i;
+		}
+		REQUIRE( primitive.getVertices()[i].position == primitive.getVertices()[firstOccurrence[remap[i]]].position );
+	}
+
+	// Any differing attribute keeps vertices apart
+	std::vector<assets::Vertex> vertices( 2 );
+	vertices[1].color.w = 0.5f;
+	REQUIRE( engine::mesh_optimize::generateWeldRemap( vertices, remap ) == 2 );
+}
+
+TEST_CASE( "Cache optimisation lowers the ACMR and keeps every triangle", "[mesh_optimize]" )
+{
+	using namespace engine::mesh_optimize;
+
+	constexpr std::uint32_t cells = 32;
+	constexpr std::size_t vertexCount = ( cells + 1 ) * ( cells + 1 );
+	const auto shuffled = makeShuffledGridIndices( cells );
+	const auto optimized = optimizeVertexCache( shuffled, vertexCount );
+
+	const auto before = simulateVertexCache( shuffled, vertexCount );
+	const auto after = simulateVertexCache( optimized, vertexCount );
+	INFO( "ACMR " << before.acmr() << " -> " << after.acmr() << ", ATVR " << before.atvr() << " -> " << after.atvr() );
+	REQUIRE( after.triangleCount == before.triangleCount );
+	REQUIRE( after.acmr() < 1.0f );
+	REQUIRE( after.acmr() < before.acmr() * 0.5f );
+	REQUIRE( after.atvr() < 1.6f );
+
+	// Same triangles with the same winding, as rotations of the input corners
+	const auto canonical = []( std::vector<std::uint32_t> indices ) {
+		std::vector<std::array<std::uint32_t, 3>> triangles;
+		for ( std::size_t i = 0; i < indices.size(); i += 3 )
+		{
+			std::array<std::uint32_t, 3> triangle{ indices[i], indices[i + 1], indices[i + 2] };
+			std::rotate( triangle.begin(), std::min_element( triangle.begin(), triangle.end() ), triangle.end() );
+			triangles.push_back( triangle );
+		}
+		std::sort( triangles.begin(), triangles.end() );
+		return triangles;
+	};
+	REQUIRE( canonical( optimized ) == canonical( shuffled ) );
+
+	// Deterministic
+	REQUIRE( optimizeVertexCache( shuffled, vertexCount ) == optimized );
+}
+
+TEST_CASE( "Overdraw ordering stays within the cache threshold", "[mesh_optimize]" )
+{
+	using namespace engine::mesh_optimize;
+
+	// Grid wrapped onto a cylinder, so clusters face different ways
+	constexpr std::uint32_t cells = 24;
+	std::vector<assets::Vertex> vertices;
+	for ( std::uint32_t z = 0; z <= cells; ++z )
+	{
+		for ( std::uint32_t x = 0; x <= cells; ++x )
+		{
+			const float angle = 6.2831853f * static_cast<float>( x ) / cells;
+			assets::Vertex vertex;
+			vertex.position = { std::cos( angle ), static_cast<float>( z ) / cells, std::sin( angle ) };
+			vertices.push_back( vertex );
+		}
+	}
+	const auto cached = optimizeVertexCache( makeShuffledGridIndices( cells ), vertices.size() );
+	const auto ordered = optimizeOverdraw( cached, &vertices[0].position.x, vertices.size(), sizeof( assets::Vertex ), 1.05f );
+
+	REQUIRE( ordered.size() == cached.size() );
+	const float cachedAcmr = simulateVertexCache( cached, vertices.size() ).acmr();
+	const float orderedAcmr = simulateVertexCache( ordered, vertices.size() ).acmr();
+	INFO( "ACMR " << cachedAcmr << " -> " << orderedAcmr );
+	REQUIRE( orderedAcmr <= cachedAcmr * 1.05f + 0.05f );
+	REQUIRE( triangleSet( vertices, ordered ) == triangleSet( vertices, cached ) );
+}
+
+TEST_CASE( "Fetch remap numbers vertices by first use", "[mesh_optimize]" )
+{
+	const std::vector<std::uint32_t> indices{ 4, 2, 0, 0, 2, 5 };
+	std::vector<std::uint32_t> remap;
+	REQUIRE( engine::mesh_optimize::generateFetchRemap( indices, 6, remap ) == 4 );
+	REQUIRE( remap == std::vector<std::uint32_t>{ 2, engine::mesh_optimize::kUnusedVertex, 1, engine::mesh_optimize::kUnusedVertex, 0, 3 } );
+}
+
+TEST_CASE( "Primitive optimisation welds, reorders and reports", "[mesh_optimize]" )
+{
+	using namespace engine::mesh_optimize;
+
+	const auto source = makeUnweldedGrid( 16 );
+	auto primitive = source;
+	const auto report = optimizePrimitive( primitive );
+	INFO( "Vertices " << report.verticesBefore << " -> " << report.verticesAfter << ", ACMR " << report.cacheBefore.acmr() << " -> " << report.cacheAfter.acmr() );
+
+	REQUIRE( report.verticesBefore == 16 * 16 * 4 );
+	REQUIRE( report.verticesAfter == 17 * 17 );
+	REQUIRE( primitive.getVertexCount() == report.verticesAfter );
+	REQUIRE( report.cacheAfter.triangleCount == report.cacheBefore.triangleCount );
+	REQUIRE( report.cacheAfter.vertexTransforms * 2 < report.cacheBefore.vertexTransforms );
+	REQUIRE( report.shortIndices );
+	REQUIRE( primitive.fitsShortIndices() );
+	REQUIRE( primitive.getBounds().min == source.getBounds().min );
+	REQUIRE( primitive.getBounds().max == source.getBounds().max );
+	REQUIRE( triangleSet( primitive.getVertices(), primitive.getIndices() ) == triangleSet( source.getVertices(), source.getIndices() ) );
+
+	// Vertices are stored in the order the triangles first use them
+	std::uint32_t nextVertex = 0;
+	for ( const std::uint32_t index : primitive.getIndices() )
+	{
+		REQUIRE( index <= nextVertex );
+		nextVertex = std::max( nextVertex, index + 1 );
+	}
+
+	// Deterministic, and a second pass finds nothing left to weld
+	auto again = source;
+	optimizePrimitive( again );
+	REQUIRE( again.getIndices() == primitive.getIndices() );
+	REQUIRE( again.getVertexData().size() == primitive.getVertexData().size() );
+	REQUIRE( std::equal( again.getVertexData().begin(), again.getVertexData().end(), primitive.getVertexData().begin() ) );
+	REQUIRE( optimizePrimitive( again ).verticesAfter == report.verticesAfter );
+}
+
+TEST_CASE( "Primitive optimisation keeps layouts and LODs", "[mesh_optimize]" )
+{
+	using namespace engine::mesh_optimize;
+
+	auto primitive = makeUnweldedGrid( 8 );
+	primitive.addLod( { { 0, 2, 1, 1, 2, 3 }, 0.25f } );
+	primitive.setVertexLayout( { static_cast<std::uint32_t>( assets::VertexAttribute::Position ) | static_cast<std::uint32_t>( assets::VertexAttribute::Normal ) |
+									 static_cast<std::uint32_t>( assets::VertexAttribute::TexCoord ),
+		false } );
+	const auto layout = primitive.getVertexLayout();
+
+	optimizePrimitive( primitive );
+	REQUIRE( primitive.getVertexLayout() == layout );
+	REQUIRE( primitive.getVertexCount() == 9 * 9 );
+	REQUIRE( primitive.getLodCount() == 2 );
+	const auto &lod = primitive.getLods().front();
+	REQUIRE( lod.indices.size() == 6 );
+	REQUIRE( lod.error == 0.25f );
+	const auto vertices = primitive.decodeVertices();
+	for ( const std::uint32_t index : lod.indices )
+	{
+		REQUIRE( index < vertices.size() );
+		REQUIRE( vertices[index].position.x <= 1.0f );
+		REQUIRE( vertices[index].position.z <= 1.0f );
+	}
+
+	// Non-triangle index data is measured but left alone
+	assets::Primitive invalid;
+	invalid.setVertices( std::vector<assets::Vertex>( 4 ), {} );
+	invalid.setIndices( { 0, 1, 2, 3 } );
+	const auto report = optimizePrimitive( invalid );
+	REQUIRE( report.verticesAfter == 4 );
+	REQUIRE( invalid.getIndices() == std::vector<std::uint32_t>{ 0, 1, 2, 3 } );
+}
+
+TEST_CASE( "The glTF loader reports mesh optimisation per mesh", "[mesh_optimize][gltf][loader]" )
+{
+	gltf_loader::GLTFLoader loader;
+	REQUIRE( loader.isMeshOptimizationEnabled() );
+
+	gltf_loader::LoadStats stats;
+	const auto scene = loader.loadScene( "assets/test/triangle_no_mat.gltf", &stats );
+	REQUIRE( scene );
+	REQUIRE( stats.meshOptimization.size() == 1 );
+	const auto &mesh = stats.meshOptimization.front();
+	REQUIRE( mesh.name == "Triangle" );
+	REQUIRE( mesh.verticesBefore == 3 );
+	REQUIRE( mesh.verticesAfter == 3 );
+	REQUIRE( mesh.cacheAfter.triangleCount == 1 );
+	REQUIRE( mesh.cacheAfter.acmr() == Approx( 3.0f ) );
+	REQUIRE( mesh.shortIndices );
+
+	// Unnamed meshes are numbered; primitives are summed
+	REQUIRE( loader.loadScene( "assets/test/cube.gltf", &stats ) );
+	REQUIRE( stats.meshOptimization.size() == 1 );
+	REQUIRE( stats.meshOptimization.front().name == "mesh 0" );
+	REQUIRE( stats.meshOptimization.front().cacheAfter.triangleCount == 12 );
+	REQUIRE( stats.meshOptimization.front().cacheAfter.vertexTransforms <= stats.meshOptimization.front().cacheBefore.vertexTransforms );
+
+	loader.setMeshOptimizationEnabled( false );
+	REQUIRE( loader.loadScene( "assets/test/cube.gltf", &stats ) );
+	REQUIRE( stats.meshOptimization.empty() );
+}
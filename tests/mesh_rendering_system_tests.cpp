@@ -9,6 +9,9 @@
 #include "engine/camera/camera.h"
 #include "platform/dx12/dx12_device.h"
 #include "engine/shader_manager/shader_manager.h"
+#include "engine/assets/assets.h"
+#include "engine/gpu/mesh_gpu.h"
+#include "engine/render_backend/recording_command_recorder.h"
 
 TEST_CASE( "MeshRenderingSystem can be created with renderer and ShaderManager", "[mesh_rendering_system][unit]" )
 {
@@ -257,4 +260,198 @@ TEST_CASE( "MeshRenderingSystem uses world transforms for parent-child hierarchi
 	REQUIRE( localMatrix.m03() != childWorldTransform.m03() ); // Local != World
 
 	systemManager.shutdown( scene );
-}
\ No newline at end of file
+}
+TEST_CASE( "MeshRenderingSystem visibility stage frustum-culls entities outside the camera view", "[mesh_rendering_system][culling][unit]" )
+{
+	// Arrange
+	dx12::Device device;
+	REQUIRE( device.initializeHeadless() );
+
+	renderer::Renderer renderer( device );
+	auto shaderManager = std::make_shared<shader_manager::ShaderManager>();
+	systems::MeshRenderingSystem system( renderer, shaderManager, nullptr );
+	ecs::Scene scene;
+
+	// Single triangle mesh shared by all entities
+	assets::Mesh mesh;
+	assets::Primitive primitive;
+	primitive.addVertex( assets::Vertex{ { -0.5f, 0.0f, 0.0f } } );
+	primitive.addVertex( assets::Vertex{ { 0.5f, 0.0f, 0.0f } } );
+	primitive.addVertex( assets::Vertex{ { 0.0f, 0.0f, 1.0f } } );
+	primitive.addIndex( 0 );
+	primitive.addIndex( 1 );
+	primitive.addIndex( 2 );
+	mesh.addPrimitive( std::move( primitive ) );
+	const auto gpuMesh = std::make_shared<engine::gpu::MeshGPU>( device, mesh );
+
+	const auto createMeshEntity = [&]( const std::string &name, const math::Vec3f &position ) {
+		const auto entity = scene.createEntity( name );
+		components::Transform transform;
+		transform.position = position;
+		scene.addComponent( entity, transform );
+		components::MeshRenderer meshRenderer;
+		meshRenderer.gpuMesh = gpuMesh;
+		meshRenderer.bounds = mesh.getBounds();
+		scene.addComponent( entity, meshRenderer );
+		return entity;
+	};
+
+	// Default camera sits at (0, -5, 5) looking at the origin
+	const auto inFront = createMeshEntity( "InFront", { 0.0f, 0.0f, 0.0f } );
+	createMeshEntity( "Behind", { 0.0f, -50.0f, 50.0f } );
+	createMeshEntity( "FarAside", { 500.0f, 0.0f, 0.0f } );
+
+	camera::PerspectiveCamera camera;
+	const math::Mat4f viewProjection = camera.getProjectionMatrix( 16.0f / 9.0f ) * camera.getViewMatrix();
+
+	// Act
+	system.buildVisibleList( scene, viewProjection );
+
+	// Assert
+	REQUIRE( system.getCullingStats().tested == 3 );
+	REQUIRE( system.getCullingStats().visible == 1 );
+	const auto visible = system.getVisibleEntities();
+	REQUIRE( visible.size() == 1 );
+	REQUIRE( visible[0] == inFront );
+
+	// Disabling culling keeps every gathered entity
+	system.setFrustumCullingEnabled( false );
+	system.buildVisibleList( scene, viewProjection );
+	REQUIRE( system.getVisibleEntities().size() == 3 );
+	REQUIRE( system.getCullingStats().culled() == 0 );
+}
+
+TEST_CASE( "MeshRenderingSystem occlusion stage culls entities hidden behind an occluder", "[mesh_rendering_system][occlusion][unit]" )
+{
+	// Arrange
+	dx12::Device device;
+	REQUIRE( device.initializeHeadless() );
+
+	renderer::Renderer renderer( device );
+	auto shaderManager = std::make_shared<shader_manager::ShaderManager>();
+	systems::MeshRenderingSystem system( renderer, shaderManager, nullptr );
+	ecs::Scene scene;
+
+	// 20x20 wall in the XZ plane and a small triangle prop
+	assets::Mesh wallMesh;
+	assets::Primitive wallPrimitive;
+	wallPrimitive.addVertex( assets::Vertex{ { -10.0f, 0.0f, -10.0f } } );
+	wallPrimitive.addVertex( assets::Vertex{ { 10.0f, 0.0f, -10.0f } } );
+	wallPrimitive.addVertex( assets::Vertex{ { 10.0f, 0.0f, 10.0f } } );
+	wallPrimitive.addVertex( assets::Vertex{ { -10.0f, 0.0f, 10.0f } } );
+	for ( const std::uint32_t index : { 0u, 1u, 2u, 0u, 2u, 3u } )
+	{
+		wallPrimitive.addIndex( index );
+	}
+	wallMesh.addPrimitive( std::move( wallPrimitive ) );
+
+	assets::Mesh propMesh;
+	assets::Primitive propPrimitive;
+	propPrimitive.addVertex( assets::Vertex{ { -0.5f, 0.0f, 0.0f } } );
+	propPrimitive.addVertex( assets::Vertex{ { 0.5f, 0.0f, 0.0f } } );
+	propPrimitive.addVertex( assets::Vertex{ { 0.0f, 0.0f, 1.0f } } );
+	for ( const std::uint32_t index : { 0u, 1u, 2u } )
+	{
+		propPrimitive.addIndex( index );
+	}
+	propMesh.addPrimitive( std::move( propPrimitive ) );
+
+	const auto wallGpu = std::make_shared<engine::gpu::MeshGPU>( device, wallMesh );
+	const auto propGpu = std::make_shared<engine::gpu::MeshGPU>( device, propMesh );
+	REQUIRE( wallGpu->getOccluderMesh().triangleCount() == 2 );
+
+	const auto createEntity = [&]( const std::string &name, const assets::Mesh &mesh, const std::shared_ptr<engine::gpu::MeshGPU> &gpuMesh, const math::Vec3f &position, bool occluder ) {
+		const auto entity = scene.createEntity( name );
+		components::Transform transform;
+		transform.position = position;
+		scene.addComponent( entity, transform );
+		components::MeshRenderer meshRenderer;
+		meshRenderer.gpuMesh = gpuMesh;
+		meshRenderer.bounds = mesh.getBounds();
+		meshRenderer.occluder = occluder;
+		scene.addComponent( entity, meshRenderer );
+		return entity;
+	};
+
+	// Default camera sits at (0, -5, 5) looking at the origin; the prop is behind the wall on the view ray
+	const auto wall = createEntity( "Wall", wallMesh, wallGpu, { 0.0f, 0.0f, 0.0f }, true );
+	const auto front = createEntity( "Front", propMesh, propGpu, { 0.0f, -2.0f, 2.0f }, false );
+	createEntity( "Hidden", propMesh, propGpu, { 0.0f, 5.0f, -5.0f }, false );
+
+	camera::PerspectiveCamera camera;
+	const math::Mat4f viewProjection = camera.getProjectionMatrix( 16.0f / 9.0f ) * camera.getViewMatrix();
+
+	// Act
+	system.buildVisibleList( scene, viewProjection );
+
+	// Assert
+	REQUIRE( system.isOcclusionCullingEnabled() );
+	REQUIRE( system.getCullingStats().visible == 3 );
+	REQUIRE( system.getOcclusionStats().occluders == 1 );
+	REQUIRE( system.getOcclusionStats().tested == 2 );
+	REQUIRE( system.getOcclusionStats().occluded == 1 );
+	const auto visible = system.getVisibleEntities();
+	REQUIRE( visible == std::vector<ecs::Entity>{ wall, front } );
+
+	// Disabling the stage keeps everything that survived frustum culling
+	system.setOcclusionCullingEnabled( false );
+	system.buildVisibleList( scene, viewProjection );
+	REQUIRE( system.getVisibleEntities().size() == 3 );
+	REQUIRE( system.getOcclusionStats().tested == 0 );
+}
+
+TEST_CASE( "MeshRenderingSystem instancing is enabled by default and frame stats reset per frame", "[mesh_rendering_system][instancing][unit]" )
+{
+	// Arrange
+	dx12::Device device;
+	REQUIRE( device.initializeHeadless() );
+
+	renderer::Renderer renderer( device );
+	auto shaderManager = std::make_shared<shader_manager::ShaderManager>();
+	systems::MeshRenderingSystem system( renderer, shaderManager, nullptr );
+	ecs::Scene scene;
+	camera::PerspectiveCamera camera;
+
+	REQUIRE( system.isInstancingEnabled() );
+
+	// Act: no active command context, so nothing is drawn
+	system.beginFrame();
+	system.render( scene, camera );
+
+	// Assert
+	REQUIRE( system.getFrameStats().drawCalls == 0 );
+	REQUIRE( system.getFrameStats().instances == 0 );
+	REQUIRE( system.getInstanceBatcher().getDrawCallCount() == 0 );
+
+	system.setInstancingEnabled( false );
+	REQUIRE_FALSE( system.isInstancingEnabled() );
+}
+
+TEST_CASE( "MeshRenderingSystem render path records through a null command recorder", "[mesh_rendering_system][render_backend][unit]" )
+{
+	// Arrange
+	dx12::Device device;
+	REQUIRE( device.initializeHeadless() );
+
+	renderer::Renderer renderer( device );
+	auto shaderManager = std::make_shared<shader_manager::ShaderManager>();
+	systems::MeshRenderingSystem system( renderer, shaderManager, nullptr );
+	ecs::Scene scene;
+
+	// Entity without GPU mesh is gathered by nobody and must not produce commands
+	const auto entity = scene.createEntity( "NoGpuMesh" );
+	scene.addComponent( entity, components::Transform{} );
+	scene.addComponent( entity, components::MeshRenderer{} );
+
+	camera::PerspectiveCamera camera;
+	engine::render_backend::RecordingCommandRecorder recorder( true );
+
+	// Act: no command context needed when recording through the null backend
+	system.beginFrame();
+	system.render( scene, camera, systems::MeshRenderingSystem::kDefaultAspectRatio, recorder );
+
+	// Assert
+	REQUIRE( recorder.getStats().drawCalls == 0 );
+	REQUIRE( recorder.getCapture().empty() );
+	REQUIRE( system.getCullingStats().tested == 0 );
+}
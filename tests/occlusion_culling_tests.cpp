@@ -0,0 +1,247 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/culling/occlusion_culling.h"
+#include "math/math.h"
+#include "math/matrix.h"
+
+using engine::culling::OccluderMesh;
+using engine::culling::OcclusionBuffer;
+
+namespace
+{
+// Camera at origin looking down +Y with Z up, matching the frustum culling tests
+math::Mat4f makeViewProjection()
+{
+	const auto view = math::Mat4f::lookAt( { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } );
+	const auto projection = math::Mat4f::perspective( math::radians( 60.0f ), 1.0f, 0.1f, 1000.0f );
+	return projection * view;
+}
+
+// Axis-aligned quad facing the camera at depth y, spanning [-halfSize, halfSize] in X and Z
+OccluderMesh makeWall( float halfSize )
+{
+	OccluderMesh mesh;
+	mesh.positions = { { -halfSize, 0.0f, -halfSize }, { halfSize, 0.0f, -halfSize }, { halfSize, 0.0f, halfSize }, { -halfSize, 0.0f, halfSize } };
+	mesh.indices = { 0, 1, 2, 0, 2, 3 };
+	return mesh;
+}
+
+math::BoundingBox3Df boxAt( const math::Vec3f &center, float halfExtent )
+{
+	const math::Vec3f extent{ halfExtent, halfExtent, halfExtent };
+	return math::BoundingBox3Df( center - extent, center + extent );
+}
+
+OcclusionBuffer makeBufferWithWall( const math::Mat4f &viewProjection )
+{
+	OcclusionBuffer buffer;
+	buffer.beginFrame( viewProjection );
+	buffer.addOccluder( makeWall( 2.0f ), math::Mat4f::translation( 0.0f, 10.0f, 0.0f ) );
+	buffer.rasterize();
+	return buffer;
+}
+} // namespace
+
+TEST_CASE( "Boxes behind an occluder are culled, others stay visible", "[occlusion][unit]" )
+{
+	const auto buffer = makeBufferWithWall( makeViewProjection() );
+
+	REQUIRE( buffer.getStats().occluders == 1 );
+	REQUIRE( buffer.getStats().occluderTriangles == 2 );
+
+	CHECK_FALSE( buffer.isVisible( boxAt( { 0.0f, 30.0f, 0.0f }, 1.0f ) ) );
+	CHECK_FALSE( buffer.isVisible( boxAt( { 0.5f, 12.0f, -0.5f }, 0.5f ) ) );
+
+	// In front of the wall, beside it, straddling its edge, or crossing the near plane
+	CHECK( buffer.isVisible( boxAt( { 0.0f, 5.0f, 0.0f }, 1.0f ) ) );
+	CHECK( buffer.isVisible( boxAt( { 8.0f, 30.0f, 0.0f }, 1.0f ) ) );
+	CHECK( buffer.isVisible( boxAt( { 6.0f, 30.0f, 0.0f }, 1.0f ) ) );
+	CHECK( buffer.isVisible( boxAt( { 0.0f, 0.0f, 0.0f }, 1.0f ) ) );
+
+	// A box bigger than the wall's silhouette
+	CHECK( buffer.isVisible( boxAt( { 0.0f, 30.0f, 0.0f }, 8.0f ) ) );
+
+	// Screen coverage drives automatic occluder selection
+	CHECK( buffer.screenCoverage( boxAt( { 0.0f, 0.0f, 0.0f }, 1.0f ) ) == 1.0f );
+	CHECK( buffer.screenCoverage( boxAt( { 0.0f, -30.0f, 0.0f }, 1.0f ) ) == 0.0f );
+	CHECK( buffer.screenCoverage( boxAt( { 0.0f, 10.0f, 0.0f }, 2.0f ) ) > buffer.screenCoverage( boxAt( { 0.0f, 40.0f, 0.0f }, 2.0f ) ) );
+}
+
+TEST_CASE( "An empty occlusion buffer culls nothing", "[occlusion][unit]" )
+{
+	OcclusionBuffer buffer;
+	buffer.beginFrame( makeViewProjection() );
+	buffer.rasterize();
+
+	REQUIRE( buffer.getDepth( 0, 0 ) == OcclusionBuffer::kEmptyDepth );
+	REQUIRE( buffer.isVisible( boxAt( { 0.0f, 30.0f, 0.0f }, 1.0f ) ) );
+}
+
+TEST_CASE( "Occluders crossing the near plane are clipped", "[occlusion][unit]" )
+{
+	// Floor below the camera that starts behind it
+	OccluderMesh floor;
+	floor.positions = { { -100.0f, -10.0f, -1.0f }, { 100.0f, -10.0f, -1.0f }, { 100.0f, 100.0f, -1.0f }, { -100.0f, 100.0f, -1.0f } };
+	floor.indices = { 0, 1, 2, 0, 2, 3 };
+
+	OcclusionBuffer buffer;
+	buffer.beginFrame( makeViewProjection() );
+	buffer.addOccluder( floor, math::Mat4f::identity() );
+	buffer.rasterize();
+
+	REQUIRE( buffer.getStats().occluderTriangles >= 2 );
+	CHECK_FALSE( buffer.isVisible( boxAt( { 0.0f, 20.0f, -5.0f }, 0.5f ) ) );
+	CHECK( buffer.isVisible( boxAt( { 0.0f, 20.0f, 2.0f }, 0.5f ) ) );
+}
+
+TEST_CASE( "Occlusion works with orthographic projections", "[occlusion][unit]" )
+{
+	const auto view = math::Mat4f::lookAt( { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } );
+	const auto projection = math::Mat4f::orthographic( -10.0f, 10.0f, -10.0f, 10.0f, 0.1f, 100.0f );
+	const auto buffer = makeBufferWithWall( projection * view );
+
+	CHECK_FALSE( buffer.isVisible( boxAt( { 0.0f, 30.0f, 0.0f }, 1.0f ) ) );
+	CHECK( buffer.isVisible( boxAt( { 0.0f, 5.0f, 0.0f }, 1.0f ) ) );
+	CHECK( buffer.isVisible( boxAt( { 5.0f, 30.0f, 0.0f }, 1.0f ) ) );
+}
+
+TEST_CASE( "cullOccluded filters indices, keeps exempt entries and counts", "[occlusion][unit]" )
+{
+	auto buffer = makeBufferWithWall( makeViewProjection() );
+
+	engine::culling::BoundsSoA bounds;
+	bounds.add( boxAt( { 0.0f, 30.0f, 0.0f }, 1.0f ) ); // occluded
+	bounds.add( boxAt( { 8.0f, 30.0f, 0.0f }, 1.0f ) ); // visible
+	bounds.add( boxAt( { 0.0f, 40.0f, 0.0f }, 1.0f ) ); // occluded but exempt
+	bounds.add( boxAt( { 0.0f, 50.0f, 1.0f }, 1.0f ) ); // occluded
+
+	std::vector<std::uint32_t> indices = { 0, 1, 2, 3 };
+	const std::vector<std::uint8_t> exempt = { 0, 0, 1, 0 };
+	buffer.cullOccluded( bounds, indices, exempt );
+
+	REQUIRE( indices == std::vector<std::uint32_t>{ 1, 2 } );
+	REQUIRE( buffer.getStats().tested == 3 );
+	REQUIRE( buffer.getStats().occluded == 2 );
+	REQUIRE( buffer.getStats().visible() == 1 );
+}
+
+TEST_CASE( "Rasterisation is identical for any thread count", "[occlusion][unit]" )
+{
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution<float> position( -20.0f, 20.0f );
+	std::uniform_real_distribution<float> depth( 5.0f, 60.0f );
+
+	OccluderMesh soup;
+	for ( std::uint32_t i = 0; i < 300; ++i )
+	{
+		const float y = depth( rng );
+		for ( int corner = 0; corner < 3; ++corner )
+		{
+			soup.indices.push_back( static_cast<std::uint32_t>( soup.positions.size() ) );
+			soup.positions.push_back( { position( rng ), y + position( rng ) * 0.1f, position( rng ) } );
+		}
+	}
+
+	const auto viewProjection = makeViewProjection();
+	OcclusionBuffer single( 200, 100 );
+	OcclusionBuffer threaded( 200, 100 );
+	threaded.setThreadCount( 4 );
+	for ( auto *buffer : { &single, &threaded } )
+	{
+		buffer->beginFrame( viewProjection );
+		buffer->addOccluder( soup, math::Mat4f::identity() );
+		buffer->rasterize();
+	}
+
+	REQUIRE( single.getWidth() == 200 );
+	REQUIRE( single.getHeight() == 104 );
+	std::uint32_t covered = 0;
+	for ( std::uint32_t y = 0; y < single.getHeight(); ++y )
+	{
+		for ( std::uint32_t x = 0; x < single.getWidth(); ++x )
+		{
+			REQUIRE( single.getDepth( x, y ) == threaded.getDepth( x, y ) );
+			covered += single.getDepth( x, y ) != OcclusionBuffer::kEmptyDepth ? 1 : 0;
+		}
+	}
+	REQUIRE( covered > 0 );
+}
+
+TEST_CASE( "buildOccluderMesh uses a small LOD level and compacts vertices", "[occlusion][unit]" )
+{
+	assets::Primitive primitive;
+	for ( std::uint32_t i = 0; i < 600; ++i )
+	{
+		assets::Vertex vertex;
+		vertex.position = { static_cast<float>( i ), 0.0f, static_cast<float>( i % 2 ) };
+		primitive.addVertex( vertex );
+	}
+	for ( std::uint32_t i = 0; i + 2 < 600; ++i )
+	{
+		primitive.addIndex( i );
+		primitive.addIndex( i + 1 );
+		primitive.addIndex( i + 2 );
+	}
+	primitive.addLod( assets::PrimitiveLod{ { 0, 10, 20, 20, 30, 40 }, 0.5f } );
+
+	assets::Mesh mesh;
+	mesh.addPrimitive( primitive );
+
+	const auto occluder = engine::culling::buildOccluderMesh( mesh, 256 );
+	REQUIRE( occluder.triangleCount() == 2 );
+	REQUIRE( occluder.positions.size() == 5 );
+	REQUIRE( occluder.positions[1].x == 10.0f );
+
+	// Within budget the full-detail triangles are used
+	const auto full = engine::culling::buildOccluderMesh( mesh, 1000 );
+	REQUIRE( full.triangleCount() == 598 );
+}
+
+TEST_CASE( "Occlusion culling performance for an interior-like scene", "[occlusion][performance]" )
+{
+	// A row of walls close to the camera hides a dense field of props behind them
+	OcclusionBuffer buffer;
+	buffer.setThreadCount( 4 );
+	const auto viewProjection = makeViewProjection();
+	const auto wall = makeWall( 1.0f );
+
+	std::mt19937 rng( 42 );
+	std::uniform_real_distribution<float> lateral( -30.0f, 30.0f );
+	std::uniform_real_distribution<float> distance( 40.0f, 200.0f );
+	engine::culling::BoundsSoA bounds;
+	for ( std::uint32_t i = 0; i < 10000; ++i )
+	{
+		const float y = distance( rng );
+		bounds.add( boxAt( { lateral( rng ) * y / 60.0f, y, lateral( rng ) * y / 60.0f }, 0.5f ) );
+	}
+	std::vector<std::uint32_t> indices( bounds.size() );
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	buffer.beginFrame( viewProjection );
+	for ( int x = -8; x <= 8; ++x )
+	{
+		for ( int z = -8; z <= 8; ++z )
+		{
+			buffer.addOccluder( wall, math::Mat4f::translation( x * 2.0f, 10.0f, z * 2.0f ) );
+		}
+	}
+	buffer.rasterize();
+	for ( std::uint32_t i = 0; i < indices.size(); ++i )
+	{
+		indices[i] = i;
+	}
+	buffer.cullOccluded( bounds, indices );
+	const auto elapsed = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+
+	const auto &stats = buffer.getStats();
+	INFO( "Occluders " << stats.occluders << ", tested " << stats.tested << ", occluded " << stats.occluded
+						<< ", raster " << stats.rasterizeMs << " ms, test " << stats.testMs << " ms, total " << elapsed << " ms" );
+	REQUIRE( stats.occluders == 289 );
+	REQUIRE( stats.occluded > stats.tested / 2 );
+	REQUIRE( elapsed < 500.0 );
+}
@@ -0,0 +1,267 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "engine/render_backend/recording_command_recorder.h"
+#include "engine/render_queue/draw_submission.h"
+
+using engine::render_backend::CommandType;
+using engine::render_backend::RecordingCommandRecorder;
+
+namespace
+{
+// Two pipelines, two materials (one without constants), an indexed and a non-indexed geometry
+engine::DrawStateTables makeTables()
+{
+	static const int pipelineA = 0, pipelineB = 0, instancedPipelineA = 0, instancedPipelineB = 0;
+	engine::DrawStateTables tables;
+	tables.pipelines = { &pipelineA, &pipelineB };
+	tables.instancedPipelines = { &instancedPipelineA, &instancedPipelineB };
+	tables.materialConstants = { 0x1000, 0 };
+
+	engine::GeometryBinding indexed;
+	indexed.vertexBuffer = { 0x2000, 240, 60 };
+	indexed.indexBuffer = { 0x3000, 24, engine::render_backend::IndexFormat::UInt32 };
+	indexed.vertexCount = 4;
+	indexed.indexCount = 6;
+
+	engine::GeometryBinding nonIndexed;
+	nonIndexed.vertexBuffer = { 0x4000, 180, 60 };
+	nonIndexed.vertexCount = 3;
+
+	tables.geometries = { indexed, nonIndexed };
+	return tables;
+}
+
+// Pipeline handles bound in capture, in order
+std::vector<engine::render_backend::PipelineHandle> boundPipelines( const std::vector<engine::render_backend::RecordedCommand> &capture )
+{
+	std::vector<engine::render_backend::PipelineHandle> pipelines;
+	for ( const auto &command : capture )
+	{
+		if ( command.type == CommandType::SetPipelineState )
+		{
+			pipelines.push_back( reinterpret_cast<engine::render_backend::PipelineHandle>( static_cast<std::uintptr_t>( command.address ) ) );
+		}
+	}
+	return pipelines;
+}
+
+// Keeps the root constant data it is given and ignores everything else
+struct RootConstantSpy final : engine::render_backend::CommandRecorder
+{
+	std::vector<std::uint32_t> values;
+
+	void setPipelineState( engine::render_backend::PipelineHandle ) override {}
+	void setVertexBuffer( const engine::render_backend::VertexBufferView & ) override {}
+	void setIndexBuffer( const engine::render_backend::IndexBufferView & ) override {}
+	void setRootConstants( std::uint32_t, std::uint32_t num32BitValues, const void *data ) override
+	{
+		const auto *first = static_cast<const std::uint32_t *>( data );
+		values.insert( values.end(), first, first + num32BitValues );
+	}
+	void setRootConstantBuffer( std::uint32_t, engine::render_backend::GpuAddress ) override {}
+	void setRootShaderResource( std::uint32_t, engine::render_backend::GpuAddress ) override {}
+	void drawIndexed( std::uint32_t, std::uint32_t, std::uint32_t, std::int32_t, std::uint32_t ) override {}
+	void draw( std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t ) override {}
+};
+} // namespace
+
+TEST_CASE( "RecordingCommandRecorder counts commands and bytes", "[render_backend][unit]" )
+{
+	RecordingCommandRecorder recorder;
+	const float constants[4] = {};
+
+	recorder.setPipelineState( nullptr );
+	recorder.setVertexBuffer( { 0x10, 64, 16 } );
+	recorder.setIndexBuffer( { 0x20, 12, engine::render_backend::IndexFormat::UInt16 } );
+	recorder.setRootConstants( 1, 4, constants );
+	recorder.setRootConstantBuffer( 2, 0x30 );
+	recorder.setRootShaderResource( 3, 0x40 );
+	recorder.drawIndexed( 6, 10, 0, 0, 0 );
+	recorder.draw( 3, 1, 0, 0 );
+	recorder.notifyUpload( 256 );
+
+	const auto &stats = recorder.getStats();
+	REQUIRE( stats.drawCalls == 2 );
+	REQUIRE( stats.indexedDrawCalls == 1 );
+	REQUIRE( stats.instances == 11 );
+	REQUIRE( stats.indices == 63 );
+	REQUIRE( stats.stateChanges() == 6 );
+	REQUIRE( stats.rootConstantBytes == 16 );
+	REQUIRE( stats.uploadBytes == 256 );
+	REQUIRE( stats.totalBytes() == 272 );
+
+	// Capture is off by default
+	REQUIRE( recorder.getCapture().empty() );
+
+	recorder.reset();
+	REQUIRE( recorder.getStats().drawCalls == 0 );
+}
+
+TEST_CASE( "RecordingCommandRecorder dumps a frame capture", "[render_backend][unit]" )
+{
+	RecordingCommandRecorder recorder( true );
+	recorder.setRootConstantBuffer( 2, 0xABC );
+	recorder.drawIndexed( 36, 2, 0, 5, 7 );
+
+	REQUIRE( recorder.getCapture().size() == 2 );
+	const auto &draw = recorder.getCapture()[1];
+	REQUIRE( draw.type == CommandType::DrawIndexed );
+	REQUIRE( static_cast<std::int32_t>( draw.args[3] ) == 5 );
+	REQUIRE( draw.args[4] == 7 );
+
+	std::ostringstream out;
+	recorder.writeCapture( out );
+	const std::string dump = out.str();
+
+	REQUIRE( dump.find( "# Frame capture: 2 commands" ) != std::string::npos );
+	REQUIRE( dump.find( "SetRootConstantBuffer param=2 address=0xabc" ) != std::string::npos );
+	REQUIRE( dump.find( "DrawIndexed indices=36 instances=2 startIndex=0 baseVertex=5 startInstance=7" ) != std::string::npos );
+	REQUIRE( dump.find( "# draws=1 instances=2" ) != std::string::npos );
+}
+
+TEST_CASE( "RecordingCommandRecorder replays its capture into another recorder", "[render_backend][unit]" )
+{
+	static const int pipeline = 0;
+	const std::uint32_t constants[3] = { 7, 8, 9 };
+
+	RecordingCommandRecorder source( true );
+	source.setPipelineState( &pipeline );
+	source.setVertexBuffer( { 0x10, 64, 16 } );
+	source.setIndexBuffer( { 0x20, 12, engine::render_backend::IndexFormat::UInt16 } );
+	source.setRootConstants( 1, 3, constants );
+	source.setRootConstantBuffer( 2, 0x30 );
+	source.setRootShaderResource( 3, 0x40 );
+	source.drawIndexed( 36, 2, 6, -4, 5 );
+	source.draw( 3, 1, 9, 2 );
+	source.notifyUpload( 256 );
+
+	RecordingCommandRecorder target( true );
+	source.replay( target );
+
+	std::ostringstream expected, replayed;
+	source.writeCapture( expected );
+	target.writeCapture( replayed );
+	REQUIRE( replayed.str() == expected.str() );
+	REQUIRE( target.getStats().totalBytes() == source.getStats().totalBytes() );
+
+	// Root constant data is kept with the capture, not just its size
+	RootConstantSpy spy;
+	source.replay( spy );
+	REQUIRE( spy.values == std::vector<std::uint32_t>{ 7, 8, 9 } );
+}
+
+TEST_CASE( "submitRenderQueue records per-object draws through the recorder", "[render_backend][unit]" )
+{
+	const auto tables = makeTables();
+	const std::vector<math::Mat4f> worldMatrices( 3, math::Mat4f::identity() );
+
+	engine::RenderQueue queue;
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 0 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 1 }, 2.0f );
+	queue.push( engine::RenderPass::Opaque, { 1, 1, 1, 2 }, 1.0f );
+	queue.sort();
+
+	RecordingCommandRecorder recorder( true );
+	const auto queueStats = engine::submitRenderQueue( queue, tables, worldMatrices, recorder );
+	const auto &stats = recorder.getStats();
+
+	REQUIRE( queueStats.drawCount == 3 );
+	REQUIRE( stats.drawCalls == 3 );
+	REQUIRE( stats.indexedDrawCalls == 2 );
+	REQUIRE( stats.pipelineChanges == 2 );
+	// Material 1 has no constant buffer, geometry 1 has no index buffer
+	REQUIRE( stats.constantBufferBinds == 1 );
+	REQUIRE( stats.vertexBufferBinds == 2 );
+	REQUIRE( stats.indexBufferBinds == 1 );
+	REQUIRE( stats.rootConstantUploads == 3 );
+	REQUIRE( stats.rootConstantBytes == 3 * sizeof( engine::InstanceData ) );
+	// Object constants only feed the per-object pipeline variants
+	REQUIRE( boundPipelines( recorder.getCapture() ) == tables.pipelines );
+}
+
+TEST_CASE( "submitInstanceBatches records one instanced draw per batch", "[render_backend][unit]" )
+{
+	const auto tables = makeTables();
+	const std::vector<math::Mat4f> worldMatrices( 5, math::Mat4f::identity() );
+
+	engine::RenderQueue queue;
+	for ( std::uint32_t i = 0; i < 4; ++i )
+	{
+		queue.push( engine::RenderPass::Opaque, { 0, 0, 0, i }, 1.0f );
+	}
+	queue.push( engine::RenderPass::Opaque, { 1, 1, 1, 4 }, 1.0f );
+	queue.sort();
+
+	engine::InstanceBatcher batcher;
+	batcher.build( queue, worldMatrices );
+
+	RecordingCommandRecorder recorder( true );
+	engine::submitInstanceBatches( batcher, tables, 0x9000, 16, recorder );
+	const auto &stats = recorder.getStats();
+
+	REQUIRE( stats.drawCalls == 2 );
+	REQUIRE( stats.instances == 5 );
+	REQUIRE( stats.shaderResourceBinds == 1 );
+	REQUIRE( stats.uploadBytes == 5 * sizeof( engine::InstanceData ) );
+	// One instance offset root constant per batch
+	REQUIRE( stats.rootConstantUploads == 2 );
+
+	const auto &capture = recorder.getCapture();
+	for ( const auto &command : capture )
+	{
+		if ( command.type == CommandType::SetRootConstants )
+		{
+			REQUIRE( command.args[0] == engine::mesh_root_parameter::kInstanceOffset );
+			REQUIRE( command.args[1] == 1 );
+		}
+	}
+	REQUIRE( capture.back().type == CommandType::Draw );
+	REQUIRE( capture.back().args[1] == 1 );
+	// The instance buffer and offset are only read by the instanced variants
+	REQUIRE( boundPipelines( capture ) == tables.instancedPipelines );
+}
+
+TEST_CASE( "Draw submission uploads vertex format constants only for non-standard layouts", "[render_backend][unit]" )
+{
+	auto tables = makeTables();
+	engine::GeometryBinding packed = tables.geometries[0];
+	packed.vertexBuffer = { 0x5000, 96, 24 };
+	packed.vertexFormat.layoutKey = 0x11f;
+	packed.vertexFormat.positionScale = { 2.0f, 2.0f, 2.0f };
+	tables.geometries.push_back( packed );
+	packed.vertexBuffer = { 0x6000, 96, 24 };
+	tables.geometries.push_back( packed );
+
+	const std::vector<math::Mat4f> worldMatrices( 3, math::Mat4f::identity() );
+	engine::RenderQueue queue;
+	for ( std::uint32_t geometry = 0; geometry < 3; ++geometry )
+	{
+		queue.push( engine::RenderPass::Opaque, { 0, 0, geometry == 0 ? 0 : geometry + 1, geometry }, 1.0f );
+	}
+	queue.sort();
+
+	const auto countFormatUploads = [&]() {
+		RecordingCommandRecorder recorder( true );
+		engine::submitRenderQueue( queue, tables, worldMatrices, recorder );
+		std::uint32_t uploads = 0;
+		for ( const auto &command : recorder.getCapture() )
+		{
+			if ( command.type == CommandType::SetRootConstants && command.args[0] == engine::mesh_root_parameter::kVertexFormat )
+			{
+				REQUIRE( command.args[1] == sizeof( engine::VertexFormatConstants ) / 4 );
+				++uploads;
+			}
+		}
+		return uploads;
+	};
+
+	// Both packed geometries share their format, the standard one needs none
+	REQUIRE( countFormatUploads() == 1 );
+
+	tables.geometries[3].vertexFormat.positionOffset = { 1.0f, 0.0f, 0.0f };
+	REQUIRE( countFormatUploads() == 2 );
+}
@@ -0,0 +1,230 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "engine/render_queue/render_queue.h"
+
+namespace
+{
+// Records callbacks so tests can verify which state changes were issued
+struct RecordingVisitor
+{
+	std::vector<std::uint32_t> pipelines;
+	std::vector<std::uint32_t> materials;
+	std::vector<std::uint32_t> geometries;
+	std::vector<std::uint32_t> objects;
+	std::vector<engine::DrawCommand> draws;
+
+	void setPipeline( std::uint32_t id ) { pipelines.push_back( id ); }
+	void setMaterial( std::uint32_t id ) { materials.push_back( id ); }
+	void setGeometry( std::uint32_t id ) { geometries.push_back( id ); }
+	void setObject( std::uint32_t index ) { objects.push_back( index ); }
+	void draw( const engine::DrawCommand &command ) { draws.push_back( command ); }
+};
+
+static_assert( engine::RenderQueueVisitor<RecordingVisitor> );
+} // namespace
+
+TEST_CASE( "Sort key packs and unpacks all fields", "[render_queue][unit]" )
+{
+	const auto key = engine::sort_key::make( engine::RenderPass::Transparent, 7, 300, 4000, 0xBEEF );
+
+	REQUIRE( engine::sort_key::pass( key ) == engine::RenderPass::Transparent );
+	REQUIRE( engine::sort_key::pipeline( key ) == 7 );
+	REQUIRE( engine::sort_key::material( key ) == 300 );
+	REQUIRE( engine::sort_key::geometry( key ) == 4000 );
+	REQUIRE( engine::sort_key::depth( key ) == 0xBEEF );
+}
+
+TEST_CASE( "Sort key orders pass before pipeline before material", "[render_queue][unit]" )
+{
+	using engine::RenderPass;
+	const auto opaqueLate = engine::sort_key::make( RenderPass::Opaque, 5, 9, 9, 0xFFFF );
+	const auto transparentEarly = engine::sort_key::make( RenderPass::Transparent, 0, 0, 0, 0 );
+	REQUIRE( opaqueLate < transparentEarly );
+
+	const auto pipeline0 = engine::sort_key::make( RenderPass::Opaque, 0, 100, 100, 100 );
+	const auto pipeline1 = engine::sort_key::make( RenderPass::Opaque, 1, 0, 0, 0 );
+	REQUIRE( pipeline0 < pipeline1 );
+}
+
+TEST_CASE( "Sort key saturates ids wider than their field", "[render_queue][unit]" )
+{
+	const auto key = engine::sort_key::make( engine::RenderPass::Opaque, 1u << 20, 1u << 20, 1u << 20, 0 );
+
+	REQUIRE( engine::sort_key::pipeline( key ) == ( 1u << engine::sort_key::kPipelineBits ) - 1 );
+	REQUIRE( engine::sort_key::material( key ) == ( 1u << engine::sort_key::kMaterialBits ) - 1 );
+	REQUIRE( engine::sort_key::pass( key ) == engine::RenderPass::Opaque );
+}
+
+TEST_CASE( "quantizeDepth is monotonic and clamps negatives", "[render_queue][unit]" )
+{
+	REQUIRE( engine::sort_key::quantizeDepth( -5.0f ) == 0 );
+	REQUIRE( engine::sort_key::quantizeDepth( 0.0f ) == 0 );
+
+	std::uint16_t previous = 0;
+	for ( float depth = 0.01f; depth < 10000.0f; depth *= 1.5f )
+	{
+		const auto quantized = engine::sort_key::quantizeDepth( depth );
+		REQUIRE( quantized >= previous );
+		previous = quantized;
+	}
+	REQUIRE( engine::sort_key::quantizeDepth( 1.0f ) < engine::sort_key::quantizeDepth( 2.0f ) );
+}
+
+TEST_CASE( "radixSort matches std::stable_sort", "[render_queue][unit]" )
+{
+	std::mt19937_64 rng( 7 );
+	std::vector<engine::SortEntry> entries;
+	for ( std::uint32_t i = 0; i < 5000; ++i )
+	{
+		// Few distinct high bits to exercise digit skipping and stability
+		const std::uint64_t key = ( rng() & 0x0F000000000000FFull );
+		entries.push_back( { key, i } );
+	}
+
+	auto expected = entries;
+	std::stable_sort( expected.begin(), expected.end(), []( const auto &a, const auto &b ) { return a.key < b.key; } );
+
+	std::vector<engine::SortEntry> scratch;
+	engine::radixSort( entries, scratch );
+
+	REQUIRE( entries.size() == expected.size() );
+	for ( std::size_t i = 0; i < entries.size(); ++i )
+	{
+		REQUIRE( entries[i].key == expected[i].key );
+		REQUIRE( entries[i].index == expected[i].index );
+	}
+}
+
+TEST_CASE( "StateIdMap assigns dense stable ids", "[render_queue][unit]" )
+{
+	int a = 0, b = 0;
+	engine::StateIdMap ids;
+
+	REQUIRE( ids.getId( &a ) == 0 );
+	REQUIRE( ids.getId( &b ) == 1 );
+	REQUIRE( ids.getId( &a ) == 0 );
+	REQUIRE( ids.size() == 2 );
+	REQUIRE( ids.getState( 1 ) == &b );
+	REQUIRE( ids.getState( 5 ) == nullptr );
+
+	ids.reset();
+	REQUIRE( ids.size() == 0 );
+	REQUIRE( ids.getId( &b ) == 0 );
+}
+
+TEST_CASE( "RenderQueue keeps saturated ids grouped by comparing full ids", "[render_queue][unit]" )
+{
+	constexpr std::uint32_t kFirstSaturatedGeometry = 1u << engine::sort_key::kGeometryBits;
+	engine::RenderQueue queue;
+
+	// Two geometries past the field width interleave in storage and share a saturated key field
+	queue.push( engine::RenderPass::Opaque, { 0, 0, kFirstSaturatedGeometry + 1, 0 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, kFirstSaturatedGeometry, 1 }, 2.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, kFirstSaturatedGeometry + 1, 2 }, 3.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, kFirstSaturatedGeometry, 3 }, 4.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 5, 4 }, 9.0f );
+	REQUIRE( queue.getSaturatedDrawCount() == 4 );
+
+	queue.sort();
+	RecordingVisitor visitor;
+	const auto stats = queue.submit( visitor );
+
+	REQUIRE( stats.geometryChanges == 3 );
+	REQUIRE( visitor.geometries == std::vector<std::uint32_t>{ 5, kFirstSaturatedGeometry, kFirstSaturatedGeometry + 1 } );
+	// Still front to back inside each bucket
+	REQUIRE( visitor.draws[1].objectIndex == 1 );
+	REQUIRE( visitor.draws[2].objectIndex == 3 );
+	REQUIRE( visitor.draws[3].objectIndex == 0 );
+	REQUIRE( visitor.draws[4].objectIndex == 2 );
+
+	queue.clear();
+	REQUIRE( queue.getSaturatedDrawCount() == 0 );
+}
+
+TEST_CASE( "RenderQueue groups draws by state and elides redundant changes", "[render_queue][unit]" )
+{
+	engine::RenderQueue queue;
+
+	// Interleaved storage order: two pipelines, two materials, object per draw
+	queue.push( engine::RenderPass::Opaque, { 1, 0, 0, 0 }, 5.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 1, 1, 1 }, 5.0f );
+	queue.push( engine::RenderPass::Opaque, { 1, 0, 0, 2 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 1, 1, 3 }, 2.0f );
+	queue.push( engine::RenderPass::Opaque, { 1, 0, 2, 4 }, 3.0f );
+
+	RecordingVisitor unsortedVisitor;
+	const auto unsortedStats = queue.submit( unsortedVisitor );
+	REQUIRE( unsortedStats.pipelineChanges == 5 );
+
+	queue.sort();
+	RecordingVisitor visitor;
+	const auto stats = queue.submit( visitor );
+
+	REQUIRE( stats.drawCount == 5 );
+	REQUIRE( stats.pipelineChanges == 2 );
+	REQUIRE( stats.materialChanges == 2 );
+	REQUIRE( stats.geometryChanges == 3 );
+	REQUIRE( stats.objectConstantUploads == 5 );
+	REQUIRE( visitor.pipelines == std::vector<std::uint32_t>{ 0, 1 } );
+
+	// Within the same state bucket draws go front to back
+	REQUIRE( visitor.draws[0].objectIndex == 3 );
+	REQUIRE( visitor.draws[1].objectIndex == 1 );
+	REQUIRE( visitor.draws[2].objectIndex == 2 );
+	REQUIRE( visitor.draws[3].objectIndex == 0 );
+	REQUIRE( visitor.draws[4].objectIndex == 4 );
+}
+
+TEST_CASE( "RenderQueue shares object constants between consecutive draws of one object", "[render_queue][unit]" )
+{
+	engine::RenderQueue queue;
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 0, 7 }, 1.0f );
+	queue.push( engine::RenderPass::Opaque, { 0, 0, 1, 7 }, 1.0f );
+	queue.sort();
+
+	RecordingVisitor visitor;
+	const auto stats = queue.submit( visitor );
+
+	REQUIRE( stats.drawCount == 2 );
+	REQUIRE( stats.objectConstantUploads == 1 );
+	REQUIRE( stats.geometryChanges == 2 );
+	REQUIRE( stats.totalStateChanges() == 1 + 1 + 2 + 1 );
+}
+
+TEST_CASE( "RenderQueue sorts 100k draws quickly", "[render_queue][performance]" )
+{
+	std::mt19937 rng( 99 );
+	std::uniform_int_distribution<std::uint32_t> pipeline( 0, 3 );
+	std::uniform_int_distribution<std::uint32_t> material( 0, 63 );
+	std::uniform_int_distribution<std::uint32_t> geometry( 0, 255 );
+	std::uniform_real_distribution<float> depth( 0.1f, 1000.0f );
+
+	constexpr std::uint32_t kDrawCount = 100000;
+	engine::RenderQueue queue;
+	queue.reserve( kDrawCount );
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	for ( std::uint32_t i = 0; i < kDrawCount; ++i )
+	{
+		queue.push( engine::RenderPass::Opaque, { pipeline( rng ), material( rng ), geometry( rng ), i }, depth( rng ) );
+	}
+	queue.sort();
+	const auto end = std::chrono::high_resolution_clock::now();
+
+	RecordingVisitor visitor;
+	const auto stats = queue.submit( visitor );
+
+	REQUIRE( stats.drawCount == kDrawCount );
+	// Sorting collapses pipeline switches to one per distinct pipeline
+	REQUIRE( stats.pipelineChanges <= 4 );
+	REQUIRE( stats.materialChanges <= 4 * 64 );
+
+	// Generous budget (debug builds included)
+	const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>( end - start );
+	REQUIRE( duration.count() < 100 );
+}
@@ -374,7 +374,7 @@ TEST_CASE( "Default Shaders", "[renderer]" )
 	}
 }
 
-TEST_CASE( "Dynamic buffer reuse vs growth", "[renderer][buffers]" )
+TEST_CASE( "Transient draws suballocate from the upload ring", "[renderer][buffers]" )
 {
 	platform::Win32Window window;
 	dx12::Device device;
@@ -391,15 +391,24 @@ TEST_CASE( "Dynamic buffer reuse vs growth", "[renderer][buffers]" )
 		{ { 0, 1, 0 }, renderer::Color::blue() }
 	};
 	renderer.drawVertices( tri );
-	ID3D12Resource *firstVB = renderer.getDynamicVertexResource();
-	REQUIRE( renderer.getDynamicVertexCapacity() == 3 );
+	ID3D12Resource *const ring = renderer.getUploadRingResource();
+	REQUIRE( ring != nullptr );
 	tri[1].position.y = 0.2f;
 	renderer.drawVertices( tri );
-	REQUIRE( renderer.getDynamicVertexResource() == firstVB );
 	tri.push_back( { { 0, 0, 1 }, renderer::Color::white() } );
 	renderer.drawVertices( tri );
-	REQUIRE( renderer.getDynamicVertexCapacity() == 4 );
-	REQUIRE( renderer.getDynamicVertexResource() != firstVB );
+
+	// Every draw keeps its own copy in the same buffer; the unchanged matrix is uploaded once
+	const auto &stats = renderer.getUploadRing().getFrameStats();
+	REQUIRE( renderer.getUploadRingResource() == ring );
+	REQUIRE( stats.allocations == 4 );
+	REQUIRE( stats.bytesRequested == 10 * sizeof( renderer::Vertex ) + 256 );
+	REQUIRE( stats.growths == 0 );
+
+	// A new matrix gets a new constant block so earlier draws still see the old one
+	renderer.setViewProjectionMatrix( math::Mat4<>::translation( 1.0f, 0.0f, 0.0f ) );
+	renderer.drawVertices( tri );
+	REQUIRE( stats.allocations == 6 );
 
 	renderer.endFrame();
 	device.endFrame();
@@ -416,8 +425,11 @@ TEST_CASE( "Immediate line draw", "[renderer][immediate]" )
 	device.beginFrame();
 	renderer.beginFrame();
 	renderer.drawLine( { 0, 0, 0 }, { 1, 1, 1 }, renderer::Color::white() );
-	REQUIRE( renderer.getDynamicVertexCapacity() == 2 );
-	REQUIRE( renderer.getDynamicIndexCapacity() == 0 );
+	// Lines are batched until the debug draw list is flushed
+	REQUIRE( renderer.getUploadRing().getFrameStats().allocations == 0 );
+	REQUIRE( renderer.getDebugDraw().pendingLineCount() == 1 );
+	renderer.flushDebugDraw();
+	REQUIRE( renderer.getUploadRing().getFrameStats().bytesRequested == 2 * sizeof( renderer::Vertex ) + 256 );
 	renderer.endFrame();
 	device.endFrame();
 	device.present();
@@ -433,8 +445,9 @@ TEST_CASE( "Immediate cube draw", "[renderer][immediate]" )
 	renderer.beginFrame();
 	device.beginFrame();
 	renderer.drawWireframeCube( { 0, 0, 0 }, { 1, 1, 1 }, renderer::Color::red() );
-	REQUIRE( renderer.getDynamicVertexCapacity() == 8 );
-	REQUIRE( renderer.getDynamicIndexCapacity() == 24 );
+	renderer.flushDebugDraw();
+	// 12 edges as a plain line list
+	REQUIRE( renderer.getUploadRing().getFrameStats().bytesRequested == 24 * sizeof( renderer::Vertex ) + 256 );
 	renderer.endFrame();
 	device.endFrame();
 	device.present();
@@ -451,8 +464,11 @@ TEST_CASE( "Immediate line and cube draw", "[renderer][immediate]" )
 	device.beginFrame();
 	renderer.drawLine( { 0, 0, 0 }, { 1, 1, 1 }, renderer::Color::white() );
 	renderer.drawWireframeCube( { 0, 0, 0 }, { 1, 1, 1 }, renderer::Color::red() );
-	REQUIRE( renderer.getDynamicVertexCapacity() == 8 );
-	REQUIRE( renderer.getDynamicIndexCapacity() == 24 );
+	renderer.flushDebugDraw();
+	// Both shapes share one vertex upload
+	REQUIRE( renderer.getUploadRing().getFrameStats().allocations == 2 );
+	REQUIRE( renderer.getUploadRing().getFrameStats().bytesRequested == 26 * sizeof( renderer::Vertex ) + 256 );
+	REQUIRE( renderer.getDebugDraw().getLastFlushStats().lines == 13 );
 	renderer.endFrame();
 	device.endFrame();
 	device.present();
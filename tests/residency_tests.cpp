@@ -0,0 +1,238 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/residency/residency_manager.h"
+
+using engine::residency::ResidencyManager;
+using engine::residency::ResidencyUploader;
+using engine::residency::ResourceId;
+
+namespace
+{
+// Records every call and reports a fixed size per resource
+class MockUploader : public ResidencyUploader
+{
+public:
+	std::unordered_map<ResourceId, std::uint64_t> sizes;
+	std::vector<ResourceId> uploads;
+	std::vector<ResourceId> evictions;
+	bool failUploads = false;
+
+	std::uint64_t upload( ResourceId id ) override
+	{
+		uploads.push_back( id );
+		return failUploads ? 0 : sizes[id];
+	}
+
+	void evict( ResourceId id ) override { evictions.push_back( id ); }
+};
+} // namespace
+
+TEST_CASE( "Residency manager counts hits and tracks exact resident bytes", "[residency]" )
+{
+	MockUploader uploader;
+	ResidencyManager residency( uploader );
+
+	residency.add( 1, 1000 );
+	residency.add( 2, 24 );
+
+	REQUIRE( residency.request( 1 ) );
+	REQUIRE( residency.request( 2 ) );
+	REQUIRE_FALSE( residency.request( 3 ) ); // Never registered
+
+	const auto &stats = residency.getStats();
+	REQUIRE( stats.hits == 2 );
+	REQUIRE( stats.misses == 0 );
+	REQUIRE( stats.residentBytes == 1024 );
+	REQUIRE( stats.residentCount == 2 );
+	REQUIRE( stats.registeredCount == 2 );
+	REQUIRE( uploader.uploads.empty() );
+
+	residency.updateSize( 1, 2000 );
+	REQUIRE( residency.getStats().residentBytes == 2024 );
+	REQUIRE( residency.getStats().peakResidentBytes == 2024 );
+
+	// Removal forgets the resource without asking the uploader to evict it
+	residency.remove( 1 );
+	REQUIRE( residency.getStats().residentBytes == 24 );
+	REQUIRE( residency.getStats().registeredCount == 1 );
+	REQUIRE( uploader.evictions.empty() );
+}
+
+TEST_CASE( "Residency manager evicts least recently used resources over budget", "[residency]" )
+{
+	MockUploader uploader;
+	ResidencyManager residency( uploader, 300 );
+
+	// Frame 1 uses A, frame 2 uses B, frame 3 uses C
+	residency.add( 1, 100 );
+	residency.advanceFrame();
+	residency.add( 2, 100 );
+	residency.advanceFrame();
+	residency.add( 3, 100 );
+	REQUIRE( residency.enforceBudget() == 0 );
+
+	// Frame 4 sees C and D: A is the oldest and goes first
+	residency.advanceFrame();
+	residency.add( 4, 100 );
+	REQUIRE( residency.request( 3 ) );
+	REQUIRE( residency.enforceBudget() == 1 );
+	REQUIRE( uploader.evictions == std::vector<ResourceId>{ 1 } );
+	REQUIRE_FALSE( residency.isResident( 1 ) );
+	REQUIRE( residency.isResident( 2 ) );
+	REQUIRE( residency.getStats().residentBytes == 300 );
+	REQUIRE( residency.getStats().evictions == 1 );
+	REQUIRE( residency.getStats().bytesEvicted == 100 );
+}
+
+TEST_CASE( "Residency manager never evicts resources used this frame", "[residency]" )
+{
+	MockUploader uploader;
+	ResidencyManager residency( uploader, 150 );
+
+	residency.add( 1, 100 );
+	residency.add( 2, 100 );
+	residency.advanceFrame();
+	residency.add( 3, 100 );
+	REQUIRE( residency.request( 1 ) );
+
+	// Only 2 is outside the visible set; the rest stays over budget
+	REQUIRE( residency.enforceBudget() == 1 );
+	REQUIRE( uploader.evictions == std::vector<ResourceId>{ 2 } );
+	REQUIRE( residency.getStats().residentBytes == 200 );
+	REQUIRE( residency.getStats().overBudgetFrames == 1 );
+}
+
+TEST_CASE( "Residency manager prefers evicting rarely used resources among equally old ones", "[residency]" )
+{
+	MockUploader uploader;
+	ResidencyManager residency( uploader, 250 );
+
+	// 1 is used over three frames, 2 only in the last of them; both leave view together
+	residency.add( 1, 100 );
+	residency.advanceFrame();
+	REQUIRE( residency.request( 1 ) );
+	residency.advanceFrame();
+	REQUIRE( residency.request( 1 ) );
+	residency.add( 2, 100 );
+
+	residency.advanceFrame();
+	residency.add( 3, 100 );
+	REQUIRE( residency.enforceBudget() == 1 );
+	REQUIRE( uploader.evictions == std::vector<ResourceId>{ 2 } );
+	REQUIRE( residency.isResident( 1 ) );
+}
+
+TEST_CASE( "Residency manager re-uploads evicted resources on demand", "[residency]" )
+{
+	MockUploader uploader;
+	uploader.sizes[1] = 128;
+	ResidencyManager residency( uploader, 100 );
+
+	residency.add( 1, 128 );
+	residency.advanceFrame();
+	REQUIRE( residency.enforceBudget() == 1 );
+	REQUIRE( residency.getStats().residentBytes == 0 );
+
+	residency.advanceFrame();
+	residency.setBudget( engine::residency::kUnlimitedBudget );
+	REQUIRE( residency.request( 1 ) );
+	REQUIRE( uploader.uploads == std::vector<ResourceId>{ 1 } );
+	REQUIRE( residency.isResident( 1 ) );
+
+	const auto &stats = residency.getStats();
+	REQUIRE( stats.misses == 1 );
+	REQUIRE( stats.reuploads == 1 );
+	REQUIRE( stats.bytesUploaded == 128 );
+	REQUIRE( stats.residentBytes == 128 );
+
+	// Hits after the re-upload do not call the uploader again
+	REQUIRE( residency.request( 1 ) );
+	REQUIRE( uploader.uploads.size() == 1 );
+	REQUIRE( residency.getStats().hits == 1 );
+}
+
+TEST_CASE( "Residency manager reports failed uploads", "[residency]" )
+{
+	MockUploader uploader;
+	ResidencyManager residency( uploader, 0 );
+
+	residency.add( 1, 64 );
+	residency.advanceFrame();
+	REQUIRE( residency.enforceBudget() == 1 );
+
+	uploader.failUploads = true;
+	REQUIRE_FALSE( residency.request( 1 ) );
+	REQUIRE_FALSE( residency.isResident( 1 ) );
+	REQUIRE( residency.getStats().uploadFailures == 1 );
+	REQUIRE( residency.getStats().residentBytes == 0 );
+
+	uploader.failUploads = false;
+	uploader.sizes[1] = 64;
+	REQUIRE( residency.request( 1 ) );
+	REQUIRE( residency.isResident( 1 ) );
+}
+
+TEST_CASE( "Residency manager counters reset without losing resident state", "[residency]" )
+{
+	MockUploader uploader;
+	ResidencyManager residency( uploader );
+
+	residency.add( 1, 64 );
+	REQUIRE( residency.request( 1 ) );
+	residency.resetCounters();
+
+	const auto &stats = residency.getStats();
+	REQUIRE( stats.hits == 0 );
+	REQUIRE( stats.residentBytes == 64 );
+	REQUIRE( stats.residentCount == 1 );
+	REQUIRE( stats.registeredCount == 1 );
+}
+
+TEST_CASE( "Residency manager keeps a streaming walkthrough within budget", "[residency][performance]" )
+{
+	// 10k equally sized resources; the camera sees a sliding window of 500 and the budget holds 2000
+	constexpr ResourceId kResources = 10000;
+	constexpr ResourceId kVisible = 500;
+	constexpr std::uint64_t kBytes = 64 * 1024;
+	constexpr std::uint64_t kBudget = 2000 * kBytes;
+	constexpr int kFrames = 1000;
+
+	MockUploader uploader;
+	for ( ResourceId id = 1; id <= kResources; ++id )
+	{
+		uploader.sizes[id] = kBytes;
+	}
+	ResidencyManager residency( uploader, kBudget );
+	for ( ResourceId id = 1; id <= kResources; ++id )
+	{
+		residency.add( id, kBytes );
+	}
+	residency.enforceBudget();
+	residency.resetCounters();
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	for ( int frame = 0; frame < kFrames; ++frame )
+	{
+		residency.advanceFrame();
+		const ResourceId first = static_cast<ResourceId>( frame * 5 ) % kResources;
+		for ( ResourceId i = 0; i < kVisible; ++i )
+		{
+			REQUIRE( residency.request( 1 + ( first + i ) % kResources ) );
+		}
+		residency.enforceBudget();
+		REQUIRE( residency.getStats().residentBytes <= kBudget );
+	}
+	const double elapsedMs = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+
+	const auto &stats = residency.getStats();
+	INFO( kFrames << " frames, " << stats.hits << " hits, " << stats.misses << " misses, " << stats.evictions << " evictions in " << elapsedMs << " ms" );
+	REQUIRE( stats.overBudgetFrames == 0 );
+	REQUIRE( stats.uploadFailures == 0 );
+	// The window advances 5 resources per frame, so steady state uploads about 5 per frame
+	REQUIRE( stats.misses <= static_cast<std::uint64_t>( kFrames ) * 5 + kVisible );
+	REQUIRE( elapsedMs < 5000.0 );
+}
@@ -0,0 +1,336 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "engine/assets/asset_manager.h"
+#include "engine/assets/assets.h"
+#include "engine/assets/scene_cache.h"
+#include "engine/gltf_loader/gltf_loader.h"
+
+namespace
+{
+namespace fs = std::filesystem;
+
+struct TempDirectory
+{
+	fs::path path = fs::temp_directory_path() / "scene_cache_tests";
+	TempDirectory()
+	{
+		std::error_code error;
+		fs::remove_all( path, error );
+		fs::create_directories( path );
+	}
+	~TempDirectory()
+	{
+		std::error_code error;
+		fs::remove_all( path, error );
+	}
+};
+
+template <typename T>
+void append( std::vector<std::uint8_t> &out, const T &value )
+{
+	const auto *bytes = reinterpret_cast<const std::uint8_t *>( &value );
+	out.insert( out.end(), bytes, bytes + sizeof( T ) );
+}
+
+void writeFile( const fs::path &path, const void *data, std::size_t size )
+{
+	std::ofstream file( path, std::ios::binary | std::ios::trunc );
+	file.write( static_cast<const char *>( data ), static_cast<std::streamsize>( size ) );
+}
+
+// gridSize x gridSize vertex grid in name.gltf with its positions and indices in the external name.bin
+void writeGridScene( const fs::path &directory, const std::string &name, std::uint32_t gridSize )
+{
+	const std::uint32_t n = gridSize;
+	std::vector<std::uint8_t> bin;
+	for ( std::uint32_t y = 0; y < n; ++y )
+	{
+		for ( std::uint32_t x = 0; x < n; ++x )
+		{
+			append( bin, static_cast<float>( x ) );
+			append( bin, static_cast<float>( ( x * 7 + y * 3 ) % 5 ) * 0.25f );
+			append( bin, static_cast<float>( y ) );
+		}
+	}
+	const std::size_t positionBytes = bin.size();
+	for ( std::uint32_t y = 0; y + 1 < n; ++y )
+	{
+		for ( std::uint32_t x = 0; x + 1 < n; ++x )
+		{
+			const std::uint32_t i = y * n + x;
+			for ( const std::uint32_t index : { i, i + n, i + 1, i + 1, i + n, i + n + 1 } )
+			{
+				append( bin, index );
+			}
+		}
+	}
+	writeFile( directory / ( name + ".bin" ), bin.data(), bin.size() );
+
+	const std::size_t indexCount = std::size_t( n - 1 ) * ( n - 1 ) * 6;
+	const std::string json = std::string( R"({ "asset": { "version": "2.0" }, "scene": 0, "scenes": [{ "nodes": [0] }],)" )
+		+ R"("nodes": [{ "name": "Root", "translation": [1, 2, 3], "children": [1] }, { "mesh": 0, "name": "Grid", "scale": [2, 2, 2] }],)"
+		+ R"("materials": [{ "name": "Ground", "pbrMetallicRoughness": { "baseColorFactor": [0.5, 0.25, 1, 1], "metallicFactor": 0.75 } }],)"
+		+ R"("meshes": [{ "name": "Grid", "primitives": [{ "attributes": { "POSITION": 0 }, "indices": 1, "material": 0 }] }],)"
+		+ R"("accessors": [)"
+		+ "{ \"bufferView\": 0, \"componentType\": 5126, \"count\": " + std::to_string( n * n ) + ", \"type\": \"VEC3\", \"min\": [0, 0, 0], \"max\": [" + std::to_string( n - 1 ) + ", 1, " + std::to_string( n - 1 ) + "] },"
+		+ "{ \"bufferView\": 1, \"componentType\": 5125, \"count\": " + std::to_string( indexCount ) + ", \"type\": \"SCALAR\" }],"
+		+ "\"bufferViews\": [{ \"buffer\": 0, \"byteOffset\": 0, \"byteLength\": " + std::to_string( positionBytes ) + " },"
+		+ "{ \"buffer\": 0, \"byteOffset\": " + std::to_string( positionBytes ) + ", \"byteLength\": " + std::to_string( indexCount * 4 ) + " }],"
+		+ "\"buffers\": [{ \"byteLength\": " + std::to_string( bin.size() ) + ", \"uri\": \"" + name + ".bin\" }] }";
+	writeFile( directory / ( name + ".gltf" ), json.data(), json.size() );
+}
+
+void requireSameNode( const assets::SceneNode &expected, const assets::SceneNode &actual )
+{
+	REQUIRE( actual.getName() == expected.getName() );
+	REQUIRE( actual.hasTransform() == expected.hasTransform() );
+	REQUIRE( actual.getTransform().position == expected.getTransform().position );
+	REQUIRE( actual.getTransform().rotation == expected.getTransform().rotation );
+	REQUIRE( actual.getTransform().scale == expected.getTransform().scale );
+	REQUIRE( actual.getMeshHandles() == expected.getMeshHandles() );
+	REQUIRE( actual.getChildCount() == expected.getChildCount() );
+	for ( std::size_t i = 0; i < expected.getChildCount(); ++i )
+	{
+		requireSameNode( expected.getChild( i ), actual.getChild( i ) );
+	}
+}
+
+void requireSameScene( const assets::Scene &expected, const assets::Scene &actual )
+{
+	REQUIRE( actual.getMaterialCount() == expected.getMaterialCount() );
+	for ( std::size_t i = 0; i < expected.getMaterialCount(); ++i )
+	{
+		const auto &a = expected.getMaterials()[i];
+		const auto &b = actual.getMaterials()[i];
+		REQUIRE( b->getName() == a->getName() );
+		REQUIRE( b->getPBRMaterial().baseColorFactor == a->getPBRMaterial().baseColorFactor );
+		REQUIRE( b->getPBRMaterial().metallicFactor == a->getPBRMaterial().metallicFactor );
+		REQUIRE( b->getPBRMaterial().roughnessFactor == a->getPBRMaterial().roughnessFactor );
+		REQUIRE( b->getPBRMaterial().emissiveFactor == a->getPBRMaterial().emissiveFactor );
+		REQUIRE( b->getPBRMaterial().baseColorTexture == a->getPBRMaterial().baseColorTexture );
+		REQUIRE( b->getPBRMaterial().normalTexture == a->getPBRMaterial().normalTexture );
+	}
+
+	REQUIRE( actual.getMeshCount() == expected.getMeshCount() );
+	for ( std::size_t i = 0; i < expected.getMeshCount(); ++i )
+	{
+		const auto &a = *expected.getMeshes()[i];
+		const auto &b = *actual.getMeshes()[i];
+		REQUIRE( b.getSourceHash() == a.getSourceHash() );
+		REQUIRE( b.getPrimitiveCount() == a.getPrimitiveCount() );
+		REQUIRE( b.getBounds().min == a.getBounds().min );
+		REQUIRE( b.getBounds().max == a.getBounds().max );
+		for ( std::uint32_t j = 0; j < a.getPrimitiveCount(); ++j )
+		{
+			const auto &pa = a.getPrimitive( j );
+			const auto &pb = b.getPrimitive( j );
+			REQUIRE( pb.getVertexLayout() == pa.getVertexLayout() );
+			REQUIRE( pb.getPositionQuantization().offset == pa.getPositionQuantization().offset );
+			REQUIRE( pb.getPositionQuantization().scale == pa.getPositionQuantization().scale );
+			REQUIRE( pb.getMaterialHandle() == pa.getMaterialHandle() );
+			REQUIRE( pb.getVertexCount() == pa.getVertexCount() );
+			REQUIRE( std::ranges::equal( pb.getVertexData(), pa.getVertexData() ) );
+			REQUIRE( pb.getIndices() == pa.getIndices() );
+			REQUIRE( pb.getLodCount() == pa.getLodCount() );
+			for ( std::size_t k = 0; k < pa.getLods().size(); ++k )
+			{
+				REQUIRE( pb.getLods()[k].error == pa.getLods()[k].error );
+				REQUIRE( pb.getLods()[k].indices == pa.getLods()[k].indices );
+			}
+		}
+	}
+
+	REQUIRE( actual.getRootNodes().size() == expected.getRootNodes().size() );
+	for ( std::size_t i = 0; i < expected.getRootNodes().size(); ++i )
+	{
+		requireSameNode( *expected.getRootNodes()[i], *actual.getRootNodes()[i] );
+	}
+}
+} // namespace
+
+TEST_CASE( "Content hashes depend on every byte and the seed", "[assets][scene_cache]" )
+{
+	std::vector<std::uint8_t> bytes( 100 );
+	for ( std::size_t i = 0; i < bytes.size(); ++i )
+	{
+		bytes[i] = static_cast<std::uint8_t>( i * 37 );
+	}
+
+	// Every prefix length exercises a different mix of lane, word and byte tails
+	std::vector<std::uint64_t> hashes;
+	for ( std::size_t length = 0; length <= bytes.size(); ++length )
+	{
+		hashes.push_back( assets::hashContent( { bytes.data(), length } ) );
+		REQUIRE( assets::hashContent( { bytes.data(), length } ) == hashes.back() );
+	}
+	std::sort( hashes.begin(), hashes.end() );
+	REQUIRE( std::adjacent_find( hashes.begin(), hashes.end() ) == hashes.end() );
+
+	const auto original = assets::hashContent( bytes );
+	REQUIRE( assets::hashContent( bytes, 1 ) != original );
+	for ( const std::size_t position : { 0, 31, 32, 63, 99 } )
+	{
+		auto changed = bytes;
+		changed[position] ^= 1;
+		REQUIRE( assets::hashContent( changed ) != original );
+	}
+}
+
+TEST_CASE( "Cooked scenes round-trip the imported scene", "[assets][scene_cache]" )
+{
+	TempDirectory directory;
+	writeGridScene( directory.path, "grid", 24 );
+	const std::string source = ( directory.path / "grid.gltf" ).generic_string();
+
+	for ( const auto storage : { gltf_loader::VertexStorage::Standard, gltf_loader::VertexStorage::Packed } )
+	{
+		gltf_loader::GLTFLoader loader;
+		loader.setVertexStorage( storage );
+		const auto imported = loader.loadScene( source );
+		REQUIRE( imported );
+		REQUIRE( imported->getSourceFiles() == std::vector<std::string>{ ( directory.path / "grid.bin" ).lexically_normal().generic_string() } );
+		REQUIRE( imported->getMeshes().front()->getPrimitive( 0 ).getLodCount() > 1 );
+
+		assets::SceneCache cache( ( directory.path / "cache" ).string(), loader.getImportSettingsHash() );
+		REQUIRE( cache.load( source ) == nullptr );
+		REQUIRE( cache.store( source, *imported ) );
+		REQUIRE( fs::exists( cache.getCookedPath( source ) ) );
+
+		const auto cooked = cache.load( source );
+		REQUIRE( cooked );
+		requireSameScene( *imported, *cooked );
+		REQUIRE( cooked->getSourceFiles() == imported->getSourceFiles() );
+
+		const auto stats = cache.getStats();
+		REQUIRE( stats.hits == 1 );
+		REQUIRE( stats.misses == 1 );
+		REQUIRE( stats.rejected == 0 );
+		REQUIRE( stats.stores == 1 );
+		REQUIRE( stats.bytesWritten == fs::file_size( cache.getCookedPath( source ) ) );
+		REQUIRE( stats.bytesRead == stats.bytesWritten );
+	}
+}
+
+TEST_CASE( "Cooked scenes miss when a source or the settings change", "[assets][scene_cache]" )
+{
+	TempDirectory directory;
+	writeGridScene( directory.path, "grid", 8 );
+	const std::string source = ( directory.path / "grid.gltf" ).generic_string();
+	const std::string cacheDirectory = ( directory.path / "cache" ).string();
+
+	gltf_loader::GLTFLoader loader;
+	const auto imported = loader.loadScene( source );
+	REQUIRE( imported );
+	assets::SceneCache cache( cacheDirectory, loader.getImportSettingsHash() );
+	REQUIRE( cache.store( source, *imported ) );
+	REQUIRE( cache.load( source ) );
+
+	SECTION( "Import settings" )
+	{
+		loader.setVertexStorage( gltf_loader::VertexStorage::Packed );
+		REQUIRE( loader.getImportSettingsHash() != cache.getImportSettingsHash() );
+		assets::SceneCache packedCache( cacheDirectory, loader.getImportSettingsHash() );
+		REQUIRE( packedCache.load( source ) == nullptr );
+		REQUIRE( packedCache.getStats().rejected == 0 );
+	}
+
+	SECTION( "The source file" )
+	{
+		std::ofstream( source, std::ios::app ) << ' ';
+		REQUIRE( cache.load( source ) == nullptr );
+		REQUIRE( cache.getStats().rejected == 0 );
+	}
+
+	SECTION( "An external buffer" )
+	{
+		std::fstream bin( directory.path / "grid.bin", std::ios::in | std::ios::out | std::ios::binary );
+		bin.seekp( 4 );
+		const float height = 9.0f;
+		bin.write( reinterpret_cast<const char *>( &height ), sizeof( height ) );
+		bin.close();
+
+		REQUIRE( cache.load( source ) == nullptr );
+		REQUIRE( cache.getStats().rejected == 1 );
+	}
+
+	SECTION( "A truncated cooked file" )
+	{
+		const auto cookedPath = cache.getCookedPath( source );
+		fs::resize_file( cookedPath, fs::file_size( cookedPath ) - 7 );
+		REQUIRE( cache.load( source ) == nullptr );
+		REQUIRE( cache.getStats().rejected == 1 );
+	}
+}
+
+TEST_CASE( "AssetManager loads scenes through the cooked cache", "[assets][scene_cache][AssetManager]" )
+{
+	TempDirectory directory;
+	writeGridScene( directory.path, "grid", 8 );
+	const std::string source = ( directory.path / "grid.gltf" ).generic_string();
+
+	int imports = 0;
+	assets::AssetManager::setSceneLoaderCallback( [&imports]( const std::string &path ) -> std::shared_ptr<assets::Scene> {
+		++imports;
+		return gltf_loader::GLTFLoader().loadScene( path );
+	} );
+	const auto cache = std::make_shared<assets::SceneCache>( ( directory.path / "cache" ).string(), gltf_loader::GLTFLoader().getImportSettingsHash() );
+
+	assets::AssetManager first;
+	first.setSceneCache( cache );
+	const auto imported = first.load<assets::Scene>( source );
+	REQUIRE( imported );
+	REQUIRE( imports == 1 );
+	REQUIRE( cache->getStats().misses == 1 );
+	REQUIRE( cache->getStats().stores == 1 );
+
+	// A new session reads the cooked copy instead of importing
+	assets::AssetManager second;
+	second.setSceneCache( cache );
+	const auto cooked = second.load<assets::Scene>( source );
+	REQUIRE( cooked );
+	REQUIRE( imports == 1 );
+	REQUIRE( cache->getStats().hits == 1 );
+	REQUIRE( cooked->isLoaded() );
+	REQUIRE( cooked->getPath() == source );
+	requireSameScene( *imported, *cooked );
+
+	assets::AssetManager::clearSceneLoaderCallback();
+}
+
+TEST_CASE( "Cooked loads are faster than importing", "[assets][scene_cache][performance]" )
+{
+	TempDirectory directory;
+	writeGridScene( directory.path, "grid", 192 );
+	const std::string source = ( directory.path / "grid.gltf" ).generic_string();
+
+	gltf_loader::GLTFLoader loader;
+	assets::SceneCache cache( ( directory.path / "cache" ).string(), loader.getImportSettingsHash() );
+
+	const auto importStart = std::chrono::steady_clock::now();
+	const auto imported = loader.loadScene( source );
+	const auto importTime = std::chrono::steady_clock::now() - importStart;
+	REQUIRE( imported );
+	REQUIRE( cache.store( source, *imported ) );
+
+	const auto cookedStart = std::chrono::steady_clock::now();
+	const auto cooked = cache.load( source );
+	const auto cookedTime = std::chrono::steady_clock::now() - cookedStart;
+	REQUIRE( cooked );
+
+	const auto toMs = []( auto duration ) { return std::chrono::duration<double, std::milli>( duration ).count(); };
+	INFO( "Import " << toMs( importTime ) << " ms, cooked " << toMs( cookedTime ) << " ms, " << cache.getStats().bytesRead << " cooked bytes" );
+	requireSameScene( *imported, *cooked );
+	// Only a timing expectation: a busy machine can stall either load
+	if ( cookedTime * 4 >= importTime )
+	{
+		WARN( "Cooked load not 4x faster than import: " << toMs( cookedTime ) << " ms vs " << toMs( importTime ) << " ms" );
+	}
+}
@@ -0,0 +1,318 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "engine/culling/frustum_culling.h"
+#include "engine/render_queue/scene_extract.h"
+#include "math/math.h"
+
+using engine::ExtractedDraw;
+using engine::SceneExtract;
+
+namespace
+{
+const int kPipelineA = 0;
+const int kPipelineB = 0;
+const int kInstancedPipelineA = 0;
+const int kInstancedPipelineB = 0;
+const int kMaterialA = 0;
+const int kMaterialB = 0;
+
+engine::GeometryBinding makeGeometry( std::uint32_t indexCount )
+{
+	engine::GeometryBinding geometry;
+	geometry.vertexCount = 24;
+	geometry.indexCount = indexCount;
+	return geometry;
+}
+
+math::BoundingBox3Df unitBox( const math::Vec3f &center )
+{
+	return math::BoundingBox3Df( center - math::Vec3f{ 0.5f, 0.5f, 0.5f }, center + math::Vec3f{ 0.5f, 0.5f, 0.5f } );
+}
+
+// Camera on the -Y side looking along +Y, matching the editor's Z-up convention
+math::Mat4f makeViewProjection( const math::Vec3f &eye, const math::Vec3f &target )
+{
+	const auto view = math::Mat4f::lookAt( eye, target, { 0.0f, 0.0f, 1.0f } );
+	const auto projection = math::Mat4f::perspective( math::radians( 60.0f ), 16.0f / 9.0f, 0.1f, 500.0f );
+	return projection * view;
+}
+
+// Synthetic level: gridSize^2 props cycling through meshCount meshes with three levels each
+struct Level
+{
+	std::vector<math::Mat4f> worldMatrices;
+	std::vector<math::BoundingBox3Df> worldBounds;
+	std::vector<std::uint32_t> meshIds;
+	std::vector<int> meshKeys;
+	std::vector<int> materialKeys;
+	std::array<float, 3> lodErrors{ 0.0f, 0.05f, 0.2f };
+};
+
+Level makeLevel( std::uint32_t gridSize, std::uint32_t meshCount, std::uint32_t materialCount )
+{
+	Level level;
+	level.meshKeys.resize( meshCount );
+	level.materialKeys.resize( materialCount );
+	const float half = static_cast<float>( gridSize ) * 0.5f;
+	for ( std::uint32_t y = 0; y < gridSize; ++y )
+	{
+		for ( std::uint32_t x = 0; x < gridSize; ++x )
+		{
+			const math::Vec3f position{ static_cast<float>( x ) * 2.0f - half, static_cast<float>( y ) * 2.0f, 0.0f };
+			level.worldMatrices.push_back( math::Mat4f::translation( position.x, position.y, position.z ) );
+			level.worldBounds.push_back( unitBox( position ) );
+			level.meshIds.push_back( ( y * gridSize + x ) % meshCount );
+		}
+	}
+	return level;
+}
+
+// The per-frame gather MeshRenderingSystem::extractScene performs, against synthetic state
+void extractLevel( const Level &level, SceneExtract &extract )
+{
+	extract.clear();
+	extract.reserve( level.worldMatrices.size() );
+	for ( std::size_t i = 0; i < level.worldMatrices.size(); ++i )
+	{
+		extract.addObject( level.worldMatrices[i], level.worldBounds[i], 0.0f );
+
+		const std::uint32_t mesh = level.meshIds[i];
+		ExtractedDraw draw;
+		draw.pipelineId = extract.resolvePipeline( &kPipelineA, &kInstancedPipelineA );
+		draw.materialId = extract.resolveMaterial( &level.materialKeys[mesh % level.materialKeys.size()], 0x10000 + ( mesh % level.materialKeys.size() ) * 256 );
+		draw.lodCount = static_cast<std::uint32_t>( level.lodErrors.size() );
+		draw.lodErrors = level.lodErrors;
+		draw.geometryId = extract.resolveGeometry( &level.meshKeys[mesh], draw.lodCount, []( std::uint32_t lod ) { return makeGeometry( 36u >> lod ); } );
+		extract.addDraw( draw );
+	}
+}
+
+ExtractedDraw drawWithMaterial( std::uint32_t materialId )
+{
+	ExtractedDraw draw;
+	draw.materialId = materialId;
+	return draw;
+}
+
+bool sameQueue( const engine::RenderQueue &a, const engine::RenderQueue &b )
+{
+	if ( a.size() != b.size() )
+	{
+		return false;
+	}
+	for ( std::size_t i = 0; i < a.size(); ++i )
+	{
+		const auto &ca = a.getCommand( i );
+		const auto &cb = b.getCommand( i );
+		if ( ca.pipelineId != cb.pipelineId || ca.materialId != cb.materialId || ca.geometryId != cb.geometryId || ca.objectIndex != cb.objectIndex )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+} // namespace
+
+TEST_CASE( "Scene extract resolves shared state to dense table ids", "[scene_extract][unit]" )
+{
+	SceneExtract extract;
+	int meshA = 0;
+	int meshB = 0;
+	int bindingCalls = 0;
+	const auto binding = [&bindingCalls]( std::uint32_t level ) {
+		++bindingCalls;
+		return makeGeometry( 36 - level * 12 );
+	};
+
+	REQUIRE( extract.resolvePipeline( &kPipelineA, &kInstancedPipelineA ) == 0 );
+	REQUIRE( extract.resolvePipeline( &kPipelineB, &kInstancedPipelineB ) == 1 );
+	REQUIRE( extract.resolvePipeline( &kPipelineA, &kInstancedPipelineA ) == 0 );
+	REQUIRE( extract.resolveMaterial( &kMaterialA, 0x100 ) == 0 );
+	REQUIRE( extract.resolveMaterial( &kMaterialB, 0x200 ) == 1 );
+	REQUIRE( extract.resolveMaterial( &kMaterialA, 0x300 ) == 0 );
+
+	// Levels of one geometry get consecutive ids, and the bindings are only built once
+	REQUIRE( extract.resolveGeometry( &meshA, 3, binding ) == 0 );
+	REQUIRE( extract.resolveGeometry( &meshB, 1, binding ) == 3 );
+	REQUIRE( extract.resolveGeometry( &meshA, 3, binding ) == 0 );
+	REQUIRE( bindingCalls == 4 );
+
+	const auto &tables = extract.getTables();
+	REQUIRE( tables.pipelines == std::vector<engine::render_backend::PipelineHandle>{ &kPipelineA, &kPipelineB } );
+	REQUIRE( tables.instancedPipelines == std::vector<engine::render_backend::PipelineHandle>{ &kInstancedPipelineA, &kInstancedPipelineB } );
+	REQUIRE( tables.materialConstants == std::vector<engine::render_backend::GpuAddress>{ 0x100, 0x200 } );
+	REQUIRE( tables.geometries.size() == 4 );
+	REQUIRE( tables.geometries[1].indexCount == 24 );
+	REQUIRE( tables.geometries[3].indexCount == 36 );
+
+	extract.clear();
+	REQUIRE( extract.getTables().geometries.empty() );
+	REQUIRE( extract.resolveGeometry( &meshB, 1, binding ) == 0 );
+}
+
+TEST_CASE( "Scene extract keeps each object's draws contiguous", "[scene_extract][unit]" )
+{
+	SceneExtract extract;
+	const auto first = extract.addObject( math::Mat4f::scale( 2.0f, 3.0f, 1.0f ), unitBox( { 0.0f, 0.0f, 0.0f } ), 0.5f );
+	extract.addDraw( drawWithMaterial( 0 ) );
+	extract.addDraw( drawWithMaterial( 1 ) );
+	const auto second = extract.addObject( math::Mat4f::translation( 4.0f, 0.0f, 0.0f ), unitBox( { 4.0f, 0.0f, 0.0f } ), 0.0f );
+
+	REQUIRE( first == 0 );
+	REQUIRE( second == 1 );
+	REQUIRE( extract.getObjectCount() == 2 );
+	REQUIRE( extract.getWorldMatrices().size() == 2 );
+	REQUIRE( extract.getBounds().size() == 2 );
+	REQUIRE( extract.getDraws( first ).size() == 2 );
+	REQUIRE( extract.getDraws( second ).empty() );
+	REQUIRE( extract.getObject( first ).worldScale == 3.0f );
+	REQUIRE( extract.getObject( first ).lodBias == 0.5f );
+
+	// Draws resolved late (e.g. after a re-upload) start a new range; the old one is abandoned
+	extract.restartDraws( first );
+	extract.addDraw( drawWithMaterial( 2 ) );
+	REQUIRE( extract.getDraws( first ).size() == 1 );
+	REQUIRE( extract.getDraws( first )[0].materialId == 2 );
+	REQUIRE( extract.getDraws( second ).empty() );
+	REQUIRE( extract.getDrawCount() == 3 );
+}
+
+TEST_CASE( "View queues select levels of detail per view", "[scene_extract][unit]" )
+{
+	SceneExtract extract;
+	int mesh = 0;
+	const std::array<float, 3> errors{ 0.0f, 0.05f, 0.2f };
+	for ( const float y : { 2.0f, 200.0f } )
+	{
+		extract.addObject( math::Mat4f::translation( 0.0f, y, 0.0f ), unitBox( { 0.0f, y, 0.0f } ), 0.0f );
+		ExtractedDraw draw;
+		draw.lodCount = 3;
+		draw.lodErrors = errors;
+		draw.geometryId = extract.resolveGeometry( &mesh, 3, []( std::uint32_t level ) { return makeGeometry( 300u >> level ); } );
+		extract.addDraw( draw );
+	}
+
+	const std::vector<std::uint32_t> visible{ 0, 1 };
+	const auto viewProjection = makeViewProjection( { 0.0f, -2.0f, 0.0f }, { 0.0f, 10.0f, 0.0f } );
+	const float projectionScale = 1.0f / std::tan( math::radians( 60.0f ) * 0.5f );
+	engine::RenderQueue queue;
+
+	// Without a projection scale every draw uses full detail
+	auto stats = engine::buildViewQueue( extract, visible, viewProjection, {}, queue );
+	REQUIRE( queue.size() == 2 );
+	REQUIRE( stats.queuedDraws == 2 );
+	REQUIRE( stats.reducedDraws == 0 );
+	REQUIRE( stats.submittedTriangles == 200 );
+	REQUIRE( stats.submittedTriangles == stats.fullDetailTriangles );
+
+	// The distant object drops to a coarser level; the near one keeps full detail
+	stats = engine::buildViewQueue( extract, visible, viewProjection, { projectionScale, 1.0f / 1080.0f }, queue );
+	REQUIRE( queue.size() == 2 );
+	REQUIRE( stats.reducedDraws == 1 );
+	REQUIRE( stats.submittedTriangles < stats.fullDetailTriangles );
+	std::uint32_t nearGeometry = ~0u;
+	std::uint32_t farGeometry = ~0u;
+	for ( std::size_t i = 0; i < queue.size(); ++i )
+	{
+		const auto &command = queue.getCommand( i );
+		( command.objectIndex == 0 ? nearGeometry : farGeometry ) = command.geometryId;
+	}
+	REQUIRE( nearGeometry == 0 );
+	REQUIRE( farGeometry > 0 );
+
+	// Only visible objects are queued, and the queue is rebuilt rather than appended to
+	stats = engine::buildViewQueue( extract, std::vector<std::uint32_t>{ 1 }, viewProjection, {}, queue );
+	REQUIRE( queue.size() == 1 );
+	REQUIRE( queue.getCommand( 0 ).objectIndex == 1 );
+}
+
+TEST_CASE( "Views sharing one extract match per-view extraction", "[scene_extract][unit]" )
+{
+	const auto level = makeLevel( 32, 5, 3 );
+	const std::array<math::Mat4f, 2> views{ makeViewProjection( { 0.0f, -10.0f, 10.0f }, { 0.0f, 40.0f, 0.0f } ),
+		makeViewProjection( { 20.0f, 70.0f, 5.0f }, { 0.0f, 0.0f, 0.0f } ) };
+	const float projectionScale = 1.0f / std::tan( math::radians( 60.0f ) * 0.5f );
+
+	SceneExtract shared;
+	extractLevel( level, shared );
+	for ( const auto &viewProjection : views )
+	{
+		SceneExtract own;
+		extractLevel( level, own );
+
+		std::vector<std::uint32_t> visible;
+		engine::culling::cullBounds( math::Frustum<float>::fromViewProjection( viewProjection ), shared.getBounds(), visible );
+		REQUIRE_FALSE( visible.empty() );
+
+		engine::RenderQueue sharedQueue;
+		engine::RenderQueue ownQueue;
+		const auto sharedStats = engine::buildViewQueue( shared, visible, viewProjection, { projectionScale, 1.0f / 1080.0f }, sharedQueue );
+		const auto ownStats = engine::buildViewQueue( own, visible, viewProjection, { projectionScale, 1.0f / 1080.0f }, ownQueue );
+		REQUIRE( sameQueue( sharedQueue, ownQueue ) );
+		REQUIRE( sharedStats.submittedTriangles == ownStats.submittedTriangles );
+	}
+}
+
+TEST_CASE( "Scene extract: four views of a 40k prop level", "[scene_extract][performance]" )
+{
+	const auto level = makeLevel( 200, 8, 4 );
+	const std::array<math::Mat4f, 4> views{ makeViewProjection( { 0.0f, -10.0f, 10.0f }, { 0.0f, 40.0f, 0.0f } ),
+		makeViewProjection( { -100.0f, 200.0f, 20.0f }, { 0.0f, 200.0f, 0.0f } ),
+		makeViewProjection( { 100.0f, 400.0f, 20.0f }, { 0.0f, 200.0f, 0.0f } ),
+		makeViewProjection( { 0.0f, 200.0f, 150.0f }, { 0.0f, 201.0f, 0.0f } ) };
+	const float projectionScale = 1.0f / std::tan( math::radians( 60.0f ) * 0.5f );
+
+	SceneExtract extract;
+	std::vector<std::uint32_t> visible;
+	engine::RenderQueue queue;
+	const auto renderView = [&]( const math::Mat4f &viewProjection ) {
+		engine::culling::cullBounds( math::Frustum<float>::fromViewProjection( viewProjection ), extract.getBounds(), visible );
+		return engine::buildViewQueue( extract, visible, viewProjection, { projectionScale, 1.0f / 1080.0f }, queue ).queuedDraws;
+	};
+
+	constexpr int kFrames = 5;
+	std::uint64_t perViewDraws = 0;
+	const auto perViewStart = std::chrono::high_resolution_clock::now();
+	for ( int frame = 0; frame < kFrames; ++frame )
+	{
+		for ( const auto &viewProjection : views )
+		{
+			extractLevel( level, extract );
+			perViewDraws += renderView( viewProjection );
+		}
+	}
+	const auto perViewEnd = std::chrono::high_resolution_clock::now();
+
+	std::uint64_t sharedDraws = 0;
+	for ( int frame = 0; frame < kFrames; ++frame )
+	{
+		extractLevel( level, extract );
+		for ( const auto &viewProjection : views )
+		{
+			sharedDraws += renderView( viewProjection );
+		}
+	}
+	const auto sharedEnd = std::chrono::high_resolution_clock::now();
+
+	const double perViewMs = std::chrono::duration<double, std::milli>( perViewEnd - perViewStart ).count() / kFrames;
+	const double sharedMs = std::chrono::duration<double, std::milli>( sharedEnd - perViewEnd ).count() / kFrames;
+	INFO( "Per-view extract: " << perViewMs << " ms/frame, shared extract: " << sharedMs << " ms/frame, " << sharedDraws / kFrames << " draws/frame" );
+
+	REQUIRE( sharedDraws > 0 );
+	REQUIRE( sharedDraws == perViewDraws );
+	// The extract is paid once instead of once per view. Wall-clock numbers vary with load, so they are
+	// reported; the draw counts above are what must hold
+	if ( sharedMs >= perViewMs )
+	{
+		WARN( "Shared extract not faster: " << sharedMs << " ms vs " << perViewMs << " ms per-view" );
+	}
+	if ( sharedMs >= 400.0 )
+	{
+		WARN( "Shared extract over the 400 ms/frame budget: " << sharedMs << " ms" );
+	}
+}
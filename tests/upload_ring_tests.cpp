@@ -0,0 +1,233 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "engine/render_backend/upload_ring.h"
+
+using engine::render_backend::CpuUploadBackend;
+using engine::render_backend::UploadRingAllocator;
+
+TEST_CASE( "Upload ring suballocates aligned ranges from one buffer", "[upload_ring][unit]" )
+{
+	CpuUploadBackend backend;
+	UploadRingAllocator ring( backend, 4096 );
+	REQUIRE( backend.getCreatedBufferCount() == 1 );
+
+	ring.beginFrame();
+	const auto a = ring.allocate( 10 );
+	const auto b = ring.allocate( 64, UploadRingAllocator::kConstantBufferAlignment );
+	const auto c = ring.allocate( 3, 4 );
+	const auto d = ring.allocate( 8, 3 ); // Rounded up to a power of two
+
+	REQUIRE( a.isValid() );
+	REQUIRE( a.offset == 0 );
+	REQUIRE( b.offset == 256 );
+	REQUIRE( c.offset == 320 );
+	REQUIRE( d.offset == 324 );
+	REQUIRE( b.gpuAddress == ring.getBuffer().gpuAddress + 256 );
+	REQUIRE( b.gpuAddress % 256 == 0 );
+	REQUIRE( b.cpuAddress == ring.getBuffer().cpuAddress + 256 );
+
+	const float values[3] = { 1.0f, 2.0f, 3.0f };
+	const auto uploaded = ring.upload( std::span<const float>( values ) );
+	REQUIRE( uploaded.offset == 336 );
+	REQUIRE( std::memcmp( uploaded.cpuAddress, values, sizeof( values ) ) == 0 );
+
+	// Zero-sized requests are rejected without counting as failures
+	REQUIRE_FALSE( ring.allocate( 0 ).isValid() );
+
+	const auto &stats = ring.getFrameStats();
+	REQUIRE( stats.allocations == 5 );
+	REQUIRE( stats.bytesRequested == 10 + 64 + 3 + 8 + 12 );
+	REQUIRE( stats.bytesConsumed == 348 );
+	REQUIRE( stats.failures == 0 );
+	REQUIRE( backend.getCreatedBufferCount() == 1 );
+}
+
+TEST_CASE( "Frames are reclaimed when their fence completes and the ring wraps", "[upload_ring][unit]" )
+{
+	CpuUploadBackend backend;
+	UploadRingAllocator ring( backend, 1024 );
+	ring.setMaxCapacity( 1024 );
+
+	std::uint64_t fence = 1;
+	for ( int frame = 0; frame < 2; ++frame )
+	{
+		ring.beginFrame();
+		REQUIRE( ring.allocate( 400 ).isValid() );
+		ring.endFrame( fence++ );
+	}
+	REQUIRE( ring.getInFlightFrameCount() == 2 );
+	REQUIRE( ring.getUsedBytes() == 800 );
+	REQUIRE( ring.getLastFrameStats().allocations == 1 );
+	REQUIRE( ring.getFrameStats().allocations == 0 );
+
+	// GPU finished frame 1: its 400 bytes are reused by wrapping to the start
+	backend.completeFenceValue( 1 );
+	ring.beginFrame();
+	REQUIRE( ring.getInFlightFrameCount() == 1 );
+	const auto wrapped = ring.allocate( 300 );
+	REQUIRE( wrapped.offset == 0 );
+	// The 224 bytes skipped at the end of the buffer are charged to this frame
+	REQUIRE( ring.getFrameStats().bytesConsumed == 224 + 300 );
+	ring.endFrame( fence++ );
+
+	REQUIRE( ring.getFrameStats().stalls == 0 );
+	REQUIRE( ring.getLastFrameStats().stalls == 0 );
+	REQUIRE( backend.getWaitCount() == 0 );
+	REQUIRE( backend.getCreatedBufferCount() == 1 );
+
+	// Everything completes: the ring empties and restarts at offset 0
+	backend.completeFenceValue( fence );
+	ring.beginFrame();
+	REQUIRE( ring.getUsedBytes() == 0 );
+	REQUIRE( ring.allocate( 1000 ).offset == 0 );
+}
+
+TEST_CASE( "A full ring at its maximum capacity stalls on the oldest frame", "[upload_ring][unit]" )
+{
+	CpuUploadBackend backend;
+	UploadRingAllocator ring( backend, 1024 );
+	ring.setMaxCapacity( 1024 );
+
+	for ( std::uint64_t fence = 1; fence <= 2; ++fence )
+	{
+		ring.beginFrame();
+		REQUIRE( ring.allocate( 500 ).isValid() );
+		ring.endFrame( fence );
+	}
+
+	// Nothing has completed, so the third frame must wait for frame 1
+	ring.beginFrame();
+	const auto allocation = ring.allocate( 500 );
+	REQUIRE( allocation.isValid() );
+	REQUIRE( ring.getFrameStats().stalls == 1 );
+	REQUIRE( backend.getWaitCount() == 1 );
+	REQUIRE( backend.getCompletedFenceValue() == 1 );
+	REQUIRE( ring.getCapacity() == 1024 );
+
+	// Larger than the maximum capacity can never be served
+	REQUIRE_FALSE( ring.allocate( 2048 ).isValid() );
+	REQUIRE( ring.getFrameStats().failures == 1 );
+}
+
+TEST_CASE( "The ring grows instead of stalling and releases the old buffer after its fence", "[upload_ring][unit]" )
+{
+	CpuUploadBackend backend;
+	UploadRingAllocator ring( backend, 256 );
+
+	ring.beginFrame();
+	const auto first = ring.allocate( 200 );
+	std::memset( first.cpuAddress, 0xAB, 200 );
+	const auto second = ring.allocate( 200 );
+	REQUIRE( second.isValid() );
+	REQUIRE( ring.getCapacity() == 512 );
+	REQUIRE( ring.getFrameStats().growths == 1 );
+	REQUIRE( ring.getFrameStats().stalls == 0 );
+
+	// Data written before the growth stays valid while the frame is in flight
+	REQUIRE( backend.getLiveBufferCount() == 2 );
+	REQUIRE( first.cpuAddress[199] == 0xAB );
+	ring.endFrame( 7 );
+
+	ring.beginFrame();
+	REQUIRE( backend.getLiveBufferCount() == 2 );
+	backend.completeFenceValue( 7 );
+	ring.beginFrame();
+	REQUIRE( backend.getLiveBufferCount() == 1 );
+
+	// A single oversized request grows straight to a fitting power of two
+	REQUIRE( ring.allocate( 5000 ).isValid() );
+	REQUIRE( ring.getCapacity() == 8192 );
+}
+
+TEST_CASE( "Randomised frames never hand out overlapping live ranges", "[upload_ring][unit]" )
+{
+	struct LiveRange
+	{
+		std::uint64_t buffer;
+		std::uint64_t begin;
+		std::uint64_t end;
+		std::uint64_t fence;
+	};
+
+	CpuUploadBackend backend;
+	UploadRingAllocator ring( backend, 8192 );
+	ring.setMaxCapacity( 16384 );
+
+	std::mt19937 rng( 99 );
+	std::uniform_int_distribution<int> allocationsPerFrame( 1, 16 );
+	std::uniform_int_distribution<std::uint64_t> size( 1, 200 );
+	std::uniform_int_distribution<int> alignmentShift( 0, 8 );
+	std::uniform_int_distribution<int> gpuLag( 0, 3 );
+
+	std::vector<LiveRange> live;
+	std::uint64_t stalls = 0;
+	for ( std::uint64_t fence = 1; fence <= 500; ++fence )
+	{
+		// The simulated GPU lags a random number of frames behind
+		const std::uint64_t lag = static_cast<std::uint64_t>( gpuLag( rng ) );
+		if ( fence > lag + 1 )
+		{
+			backend.completeFenceValue( fence - lag - 1 );
+		}
+		ring.beginFrame();
+
+		const int count = allocationsPerFrame( rng );
+		for ( int i = 0; i < count; ++i )
+		{
+			const std::uint64_t alignment = 1ull << alignmentShift( rng );
+			const auto allocation = ring.allocate( size( rng ), alignment );
+			REQUIRE( allocation.isValid() );
+			REQUIRE( allocation.offset % alignment == 0 );
+			REQUIRE( allocation.offset + allocation.size <= ring.getCapacity() );
+
+			const std::uint64_t completed = backend.getCompletedFenceValue();
+			std::erase_if( live, [&]( const LiveRange &range ) { return range.fence <= completed; } );
+			for ( const LiveRange &range : live )
+			{
+				const bool overlaps = range.buffer == ring.getBuffer().handle && allocation.offset < range.end && range.begin < allocation.offset + allocation.size;
+				REQUIRE_FALSE( overlaps );
+			}
+			live.push_back( { ring.getBuffer().handle, allocation.offset, allocation.offset + allocation.size, fence } );
+		}
+		stalls += ring.getFrameStats().stalls;
+		ring.endFrame( fence );
+	}
+
+	INFO( "Stalls " << stalls << ", peak frame bytes " << ring.getPeakFrameBytes() << ", capacity " << ring.getCapacity() );
+	REQUIRE( ring.getCapacity() <= 16384 );
+}
+
+TEST_CASE( "Upload ring allocation throughput", "[upload_ring][performance]" )
+{
+	constexpr int kAllocationsPerFrame = 100000;
+
+	CpuUploadBackend backend;
+	UploadRingAllocator ring( backend, 1024 * 1024 );
+	const float constants[16] = {};
+
+	double elapsed = 0.0;
+	for ( std::uint64_t fence = 1; fence <= 3; ++fence )
+	{
+		backend.completeFenceValue( fence - 1 );
+		ring.beginFrame();
+		const auto start = std::chrono::high_resolution_clock::now();
+		for ( int i = 0; i < kAllocationsPerFrame; ++i )
+		{
+			ring.upload( constants, sizeof( constants ), 64 );
+		}
+		elapsed = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+		ring.endFrame( fence );
+	}
+
+	// The first frame grew the ring to fit; later frames reuse it without creating resources
+	INFO( kAllocationsPerFrame << " uploads: " << elapsed << " ms, capacity " << ring.getCapacity() << ", buffers created " << backend.getCreatedBufferCount() );
+	REQUIRE( ring.getLastFrameStats().growths == 0 );
+	REQUIRE( ring.getLastFrameStats().stalls == 0 );
+	REQUIRE( ring.getLastFrameStats().bytesRequested == kAllocationsPerFrame * sizeof( constants ) );
+	REQUIRE( elapsed < 50.0 );
+}
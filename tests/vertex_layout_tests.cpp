@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine/assets/assets.h"
+#include "engine/assets/vertex_layout.h"
+#include "engine/gltf_loader/gltf_loader.h"
+
+using Catch::Approx;
+
+namespace
+{
+constexpr std::uint32_t bit( assets::VertexAttribute attribute )
+{
+	return static_cast<std::uint32_t>( attribute );
+}
+
+// Triangle with every attribute set away from the Vertex defaults, plus one reduced LOD
+assets::Primitive makeTrianglePrimitive()
+{
+	std::vector<assets::Vertex> vertices( 3 );
+	for ( std::size_t i = 0; i < vertices.size(); ++i )
+	{
+		const float t = static_cast<float>( i );
+		vertices[i].position = { -4.0f + 3.0f * t, 2.0f * t, 10.0f - t };
+		vertices[i].normal = math::normalize( math::Vec3f{ 0.3f, -0.5f + t * 0.4f, 0.8f } );
+		vertices[i].texCoord = { 0.25f * t, 1.0f - 0.5f * t };
+		const auto tangent = math::normalize( math::Vec3f{ 1.0f, 0.2f * t, -0.1f } );
+		vertices[i].tangent = { tangent.x, tangent.y, tangent.z, i == 1 ? -1.0f : 1.0f };
+		vertices[i].color = { 0.2f * t, 0.4f, 1.0f - 0.3f * t, 0.5f };
+	}
+	math::BoundingBox3Df bounds;
+	for ( const auto &vertex : vertices )
+	{
+		bounds.expand( vertex.position );
+	}
+
+	assets::Primitive primitive;
+	primitive.setVertices( vertices, bounds );
+	primitive.setIndices( { 0, 1, 2 } );
+	primitive.addLod( { { 0, 1, 2 }, 0.5f } );
+	return primitive;
+}
+
+std::uint64_t sceneVertexBytes( const assets::Scene &scene )
+{
+	std::uint64_t bytes = 0;
+	for ( const auto &mesh : scene.getMeshes() )
+	{
+		for ( const auto &primitive : mesh->getPrimitives() )
+		{
+			bytes += primitive.getVertexData().size();
+		}
+	}
+	return bytes;
+}
+} // namespace
+
+TEST_CASE( "Vertex layouts interleave the present attributes", "[assets][vertex_layout]" )
+{
+	const assets::VertexLayout standard;
+	REQUIRE( standard.isStandard() );
+	REQUIRE( standard.getKey() == 0 );
+	REQUIRE( standard.getStride() == sizeof( assets::Vertex ) );
+
+	// Trimmed float layout: position, normal, colour
+	const assets::VertexLayout trimmed{ bit( assets::VertexAttribute::Position ) | bit( assets::VertexAttribute::Normal ) | bit( assets::VertexAttribute::Color ), false };
+	REQUIRE_FALSE( trimmed.isStandard() );
+	REQUIRE( trimmed.getOffset( assets::VertexAttribute::Normal ) == 12 );
+	REQUIRE( trimmed.getOffset( assets::VertexAttribute::Color ) == 24 );
+	REQUIRE( trimmed.getStride() == 40 );
+
+	const assets::VertexLayout packed{ assets::kAllVertexAttributes, true };
+	REQUIRE( packed.getOffset( assets::VertexAttribute::Normal ) == 8 );
+	REQUIRE( packed.getOffset( assets::VertexAttribute::Color ) == 20 );
+	REQUIRE( packed.getStride() == 24 );
+
+	// Keys tell every non-standard layout apart
+	REQUIRE( trimmed.getKey() != 0 );
+	REQUIRE( packed.getKey() != 0 );
+	REQUIRE( packed.getKey() != assets::VertexLayout{ assets::kAllVertexAttributes, false }.getKey() );
+	REQUIRE( trimmed.getKey() != assets::VertexLayout{ trimmed.attributes, true }.getKey() );
+}
+
+TEST_CASE( "Primitives re-encode their vertices between layouts", "[assets][vertex_layout]" )
+{
+	const auto reference = makeTrianglePrimitive();
+	const auto &expected = reference.getVertices();
+
+	SECTION( "Trimmed float layouts keep the present attributes exactly" )
+	{
+		auto primitive = makeTrianglePrimitive();
+		const assets::VertexLayout layout{ bit( assets::VertexAttribute::Position ) | bit( assets::VertexAttribute::Normal ) | bit( assets::VertexAttribute::TexCoord ), false };
+		primitive.setVertexLayout( layout );
+
+		REQUIRE( primitive.hasCompactVertices() );
+		REQUIRE( primitive.getVertices().empty() );
+		REQUIRE( primitive.getVertexCount() == 3 );
+		REQUIRE( primitive.getVertexData().size() == 3 * 32 );
+		REQUIRE( primitive.getLodCount() == 2 );
+		REQUIRE( primitive.getIndices() == reference.getIndices() );
+
+		const auto decoded = primitive.decodeVertices();
+		const assets::Vertex defaults;
+		for ( std::size_t i = 0; i < decoded.size(); ++i )
+		{
+			REQUIRE( decoded[i].position == expected[i].position );
+			REQUIRE( decoded[i].normal == expected[i].normal );
+			REQUIRE( decoded[i].texCoord == expected[i].texCoord );
+			REQUIRE( decoded[i].tangent == defaults.tangent );
+			REQUIRE( decoded[i].color == defaults.color );
+		}
+	}
+
+	SECTION( "Packed layouts stay within the encoding precision" )
+	{
+		auto primitive = makeTrianglePrimitive();
+		primitive.setVertexLayout( { assets::kAllVertexAttributes, true } );
+		REQUIRE( primitive.getVertexData().size() == 3 * 24 );
+
+		const auto decoded = primitive.decodeVertices();
+		for ( std::size_t i = 0; i < decoded.size(); ++i )
+		{
+			REQUIRE( decoded[i].position.x == Approx( expected[i].position.x ).margin( 1e-3 ) );
+			REQUIRE( decoded[i].position.y == Approx( expected[i].position.y ).margin( 1e-3 ) );
+			REQUIRE( decoded[i].position.z == Approx( expected[i].position.z ).margin( 1e-3 ) );
+			REQUIRE( decoded[i].normal.x == Approx( expected[i].normal.x ).margin( 1e-4 ) );
+			REQUIRE( decoded[i].normal.y == Approx( expected[i].normal.y ).margin( 1e-4 ) );
+			REQUIRE( decoded[i].normal.z == Approx( expected[i].normal.z ).margin( 1e-4 ) );
+			REQUIRE( decoded[i].tangent.x == Approx( expected[i].tangent.x ).margin( 1e-4 ) );
+			REQUIRE( decoded[i].tangent.w == expected[i].tangent.w );
+			REQUIRE( decoded[i].texCoord.x == Approx( expected[i].texCoord.x ).margin( 1e-3 ) );
+			REQUIRE( decoded[i].texCoord.y == Approx( expected[i].texCoord.y ).margin( 1e-3 ) );
+			// unorm8 rounds to the nearest step; half a step decoded back can land just over 0.5 / 255 in float
+			REQUIRE( decoded[i].color.x == Approx( expected[i].color.x ).margin( 1.0 / 255.0 ) );
+			REQUIRE( decoded[i].color.w == Approx( expected[i].color.w ).margin( 1.0 / 255.0 ) );
+		}
+	}
+
+	SECTION( "Returning to the standard layout restores the Vertex array" )
+	{
+		auto primitive = makeTrianglePrimitive();
+		primitive.setVertexLayout( { bit( assets::VertexAttribute::Position ) | bit( assets::VertexAttribute::Normal ) | bit( assets::VertexAttribute::TexCoord ) |
+										 bit( assets::VertexAttribute::Tangent ) | bit( assets::VertexAttribute::Color ),
+			false } );
+		REQUIRE_FALSE( primitive.hasCompactVertices() );
+
+		primitive.setVertexLayout( { bit( assets::VertexAttribute::Position ), false } );
+		primitive.setVertexLayout( {} );
+		REQUIRE_FALSE( primitive.hasCompactVertices() );
+		REQUIRE( primitive.getVertexData().size() == 3 * sizeof( assets::Vertex ) );
+		REQUIRE( primitive.getVertices()[2].position == expected[2].position );
+		REQUIRE( primitive.getVertices()[2].color == assets::Vertex{}.color );
+	}
+}
+
+TEST_CASE( "Vertex storage modes shrink the test assets", "[gltf][loader][vertex_layout]" )
+{
+	const std::vector<std::string> files{ "assets/test/cube.gltf", "assets/test/cube-vert-col.gltf", "assets/test/triangle_no_mat.gltf",
+		"assets/test/triangle_vertex_colors.gltf", "assets/test/triangle_yellow.gltf" };
+
+	gltf_loader::GLTFLoader loader;
+	std::uint64_t bytes[3] = {};
+	const gltf_loader::VertexStorage storages[3] = { gltf_loader::VertexStorage::Standard, gltf_loader::VertexStorage::Trimmed, gltf_loader::VertexStorage::Packed };
+	for ( std::size_t mode = 0; mode < 3; ++mode )
+	{
+		loader.setVertexStorage( storages[mode] );
+		for ( const auto &file : files )
+		{
+			const auto scene = loader.loadScene( file );
+			REQUIRE( scene );
+			bytes[mode] += sceneVertexBytes( *scene );
+		}
+	}
+	INFO( "Vertex bytes: standard " << bytes[0] << ", trimmed " << bytes[1] << ", packed " << bytes[2] );
+
+	REQUIRE( bytes[0] > 0 );
+	REQUIRE( bytes[1] < bytes[0] ); // None of the files has tangents
+	REQUIRE( bytes[2] * 2 < bytes[1] );
+
+	// Trimmed storage decodes to exactly what the standard import produced
+	loader.setVertexStorage( gltf_loader::VertexStorage::Standard );
+	const auto standard = loader.loadScene( "assets/test/cube-vert-col.gltf" );
+	loader.setVertexStorage( gltf_loader::VertexStorage::Trimmed );
+	const auto trimmed = loader.loadScene( "assets/test/cube-vert-col.gltf" );
+	REQUIRE( standard );
+	REQUIRE( trimmed );
+	const auto &expected = standard->getMeshes().front()->getPrimitives().front();
+	const auto &actual = trimmed->getMeshes().front()->getPrimitives().front();
+	REQUIRE( actual.hasCompactVertices() );
+	const auto decoded = actual.decodeVertices();
+	REQUIRE( decoded.size() == expected.getVertices().size() );
+	for ( std::size_t i = 0; i < decoded.size(); ++i )
+	{
+		REQUIRE( decoded[i].position == expected.getVertices()[i].position );
+		REQUIRE( decoded[i].normal == expected.getVertices()[i].normal );
+		REQUIRE( decoded[i].color == expected.getVertices()[i].color );
+	}
+}